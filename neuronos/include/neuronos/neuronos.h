@@ -32,6 +32,8 @@ typedef struct neuronos_model neuronos_model_t;
 typedef struct neuronos_agent neuronos_agent_t;
 typedef struct neuronos_tool_reg neuronos_tool_registry_t;
 typedef struct neuronos_memory neuronos_memory_t;
+typedef struct neuronos_scheduler neuronos_scheduler_t;
+typedef struct neuronos_model_pool neuronos_model_pool_t;
 
 /* ---- Status codes ---- */
 typedef enum {
@@ -46,6 +48,7 @@ typedef enum {
     NEURONOS_ERROR_MAX_STEPS = -8,
     NEURONOS_ERROR_CONTEXT_FULL = -9,
     NEURONOS_ERROR_INVALID_PARAM = -10,
+    NEURONOS_ERROR_CANCELLED = -11,
 } neuronos_status_t;
 
 /* ============================================================
@@ -69,10 +72,25 @@ const char * neuronos_version(void);
 /* ============================================================
  * MODEL: Load / Free / Info
  * ============================================================ */
+/* KV cache precision. Quantized V requires flash attention;
+ * without it only K is quantized. */
+typedef enum {
+    NEURONOS_KV_F16 = 0,  /* 2 bytes/elem (default)          */
+    NEURONOS_KV_Q8_0 = 1, /* ~1.06 bytes/elem, near-lossless */
+    NEURONOS_KV_Q4_0 = 2, /* ~0.56 bytes/elem, low-RAM tiers */
+} neuronos_kv_type_t;
+
 typedef struct {
     const char * model_path; /* path to GGUF file                    */
     int context_size;        /* 0 = auto (min of n_ctx_train, 8192)  */
     bool use_mmap;           /* memory-map model (default: true)     */
+    bool use_mlock;          /* lock weights in RAM (default: false) */
+    int n_batch;             /* prompt batch size (0 = 512)          */
+    int n_ubatch;            /* physical micro-batch (0 = n_batch)   */
+    int n_threads;           /* decode threads (0 = engine default)  */
+    int n_threads_batch;     /* prefill threads (0 = n_threads)      */
+    int flash_attn;          /* 0 = auto, 1 = on, -1 = off           */
+    neuronos_kv_type_t kv_type; /* KV cache precision (F16)          */
 } neuronos_model_params_t;
 
 neuronos_model_t * neuronos_model_load(neuronos_engine_t * engine, neuronos_model_params_t params);
@@ -94,6 +112,73 @@ neuronos_model_info_t neuronos_model_info(const neuronos_model_t * model);
 /* Get the active context size (number of tokens allocated) */
 int neuronos_model_context_size(const neuronos_model_t * model);
 
+/* ---- Session snapshots: persist prefilled prompt state ----
+ *
+ * A snapshot holds the KV state and token list currently cached by
+ * the model. After a restore, neuronos_generate() reuses it as a
+ * prompt prefix and only prefills the new suffix. */
+
+/* Save the model's cached prompt state to a file */
+neuronos_status_t neuronos_session_save(neuronos_model_t * model, const char * path);
+
+/* Restore a snapshot written for this model (same file + KV layout) */
+neuronos_status_t neuronos_session_load(neuronos_model_t * model, const char * path);
+
+/* Make `prefix` resident in the KV cache: restore the snapshot keyed by
+ * model hash + prompt hash from cache_dir, or prefill and save one.
+ * cache_dir NULL = ~/.neuronos/sessions */
+neuronos_status_t neuronos_session_warm(neuronos_model_t * model, const char * prefix, const char * cache_dir);
+
+/* ============================================================
+ * MODEL POOL: Shared weights, many contexts
+ *
+ * Hands out model handles whose contexts share one mmap'd
+ * llama_model per GGUF path, so two agents (or a server and an
+ * MCP-side generator) on the same file map the weights once.
+ * Released handles stay warm (KV prefix, grammar cache) and are
+ * reused by the next acquire with the same context settings.
+ * Idle contexts, then weights no context uses, are evicted in
+ * least-recently-used order to stay within budget_mb.
+ *
+ * acquire, release, stats and eviction are serialized by a pool
+ * lock, so a server thread and an MCP-side generator can share one
+ * pool. A loading acquire holds the lock while it loads. Each handle
+ * is still used by one thread at a time, like any neuronos_model_t.
+ * neuronos_pool_free() must not race with other pool calls.
+ * ============================================================ */
+#define NEURONOS_POOL_MAX_MODELS   8
+#define NEURONOS_POOL_MAX_CONTEXTS 16
+
+typedef struct {
+    int64_t budget_mb; /* RAM for weights + KV (default: hw model_budget_mb) */
+} neuronos_pool_params_t;
+
+typedef struct {
+    int n_models;      /* resident weights                 */
+    int n_contexts;    /* contexts (in use + idle)         */
+    int n_in_use;      /* handles currently acquired       */
+    int64_t used_mb;   /* estimated weights + KV resident  */
+    int64_t budget_mb;
+} neuronos_pool_stats_t;
+
+neuronos_model_pool_t * neuronos_pool_create(neuronos_engine_t * engine, neuronos_pool_params_t params);
+
+/* Free the pool and every context and model it holds. Outstanding
+ * handles become invalid. */
+void neuronos_pool_free(neuronos_model_pool_t * pool);
+
+/* Get a handle for params.model_path: an idle context with the same
+ * settings if one exists, else a new context on the shared weights
+ * (loading them if not resident). Returns NULL when the budget or the
+ * slot table is exhausted by handles in use. */
+neuronos_model_t * neuronos_pool_acquire(neuronos_model_pool_t * pool, neuronos_model_params_t params);
+
+/* Return a handle to the pool (it stays resident until evicted).
+ * neuronos_model_free() on a pooled handle does the same. */
+void neuronos_pool_release(neuronos_model_pool_t * pool, neuronos_model_t * model);
+
+neuronos_pool_stats_t neuronos_pool_stats(const neuronos_model_pool_t * pool);
+
 /* ============================================================
  * GENERATE: Text generation (inference)
  * ============================================================ */
@@ -102,6 +187,28 @@ int neuronos_model_context_size(const neuronos_model_t * model);
  * Return false to stop generation early. */
 typedef bool (*neuronos_token_cb)(const char * token_text, void * user_data);
 
+/* Coalesced streaming callback: called with a run of token ids and the
+ * text they decoded to. `text` points into the generation's output
+ * buffer — it is not NUL-terminated and is only valid during the call.
+ * Spans always end on a UTF-8 character boundary.
+ * Return false to stop generation early. */
+typedef bool (*neuronos_stream_cb)(const int32_t * token_ids, int n_tokens, const char * text, size_t text_len,
+                                   void * user_data);
+
+/* Cancellation poll, called between decode steps (and prompt chunks)
+ * with the generation's user_data. Return true to abandon the call;
+ * it ends with NEURONOS_ERROR_CANCELLED and the text so far. */
+typedef bool (*neuronos_cancel_cb)(void * user_data);
+
+/* When on_stream fires. Any enabled condition triggers a flush; the
+ * remainder is always flushed when generation ends. All zero = every
+ * token (still held back while a UTF-8 character is incomplete). */
+typedef struct {
+    int every_n_tokens; /* flush after N buffered tokens (0 = off)     */
+    int every_ms;       /* flush when M ms passed since last (0 = off) */
+    bool on_word;       /* flush after whitespace / punctuation        */
+} neuronos_flush_policy_t;
+
 typedef struct {
     const char * prompt;        /* input text                   */
     int max_tokens;             /* max tokens to generate (256) */
@@ -115,6 +222,17 @@ typedef struct {
     neuronos_token_cb on_token; /* stream callback or NULL      */
     void * user_data;           /* passed to callback           */
     uint32_t seed;              /* RNG seed; 0 = random         */
+    neuronos_model_t * draft_model; /* speculative draft or NULL */
+    int n_draft;                /* draft tokens per step (5)    */
+    neuronos_stream_cb on_stream;   /* coalesced stream or NULL  */
+    neuronos_flush_policy_t flush;  /* when on_stream fires      */
+    neuronos_cancel_cb is_cancelled; /* cancellation poll or NULL */
+    bool scratch_seq;           /* decode on a side KV sequence that
+                                 * forks from the cached prefix and is
+                                 * dropped afterwards; the cache that
+                                 * later prompts reuse is left intact.
+                                 * A failed decode is an error, never
+                                 * a truncated text */
 } neuronos_gen_params_t;
 
 typedef struct {
@@ -123,6 +241,19 @@ typedef struct {
     double elapsed_ms;        /* total generation time             */
     double tokens_per_s;      /* tokens/second                     */
     neuronos_status_t status; /* NEURONOS_OK or error              */
+    int n_drafted;            /* speculative: tokens proposed      */
+    int n_accepted;           /* speculative: tokens accepted      */
+    double acceptance_rate;   /* n_accepted / n_drafted            */
+
+    /* Per-phase breakdown (ms unless noted) */
+    double ttft_ms;              /* call start → first token sampled     */
+    double prefill_ms;           /* prompt evaluation (uncached part)    */
+    double decode_ms;            /* llama_decode of generated tokens     */
+    double sample_ms;            /* sampler chain incl. grammar          */
+    double prefill_tokens_per_s; /* evaluated prompt tokens / prefill    */
+    double decode_tokens_per_s;  /* generated tokens / time after TTFT   */
+    int n_prompt_tokens;         /* prompt length in tokens              */
+    int n_reused_tokens;         /* prompt tokens served from KV cache   */
 } neuronos_gen_result_t;
 
 /* Generate text from a prompt */
@@ -131,6 +262,186 @@ neuronos_gen_result_t neuronos_generate(neuronos_model_t * model, neuronos_gen_p
 /* Free a generation result */
 void neuronos_gen_result_free(neuronos_gen_result_t * result);
 
+/* Grammar sampler chains are compiled once per model and keyed by the
+ * grammar text + sampling params. Drop all cached chains, e.g. when a
+ * grammar built from the tool list goes stale. Safe from any thread. */
+void neuronos_sampler_cache_invalidate(void);
+
+/* Embed texts[0..n) as mean-pooled, L2-normalized hidden states into
+ * out[n * n_embd] (n_embd from neuronos_model_info()). Works with the
+ * chat model or a dedicated embedding GGUF. Runs on a separate context
+ * created on first use, so the cached prompt is untouched; texts over
+ * 256 tokens are truncated. Not thread-safe against other
+ * neuronos_embed() calls on the same model. */
+neuronos_status_t neuronos_embed(neuronos_model_t * model, const char * const * texts, int n, float * out);
+
+/* ============================================================
+ * SCHEDULER: Continuous batching of concurrent generations
+ *
+ * Holds N sequence slots in one dedicated llama_context that
+ * shares the model's weights. Every step packs one pending token
+ * per decoding slot plus chunked prefill for newly admitted
+ * requests into a single llama_decode() batch.
+ *
+ * Finished slots keep their KV cells. A new request goes to the
+ * free slot whose cached tokens share the longest prefix with its
+ * prompt, so a client that resends the whole conversation each turn
+ * only prefills the new messages. When a conversation is pushed out
+ * of its slot, its KV state is kept in host memory (LRU, cache_mb)
+ * and restored if the conversation comes back.
+ *
+ * The slots' KV lives in addition to the model's own context. By
+ * default slot_ctx is the model context divided by n_slots (at least
+ * 512), reduced further when model_budget_mb can't hold it next to
+ * the weights and the model's own KV.
+ *
+ * The scheduler is not thread-safe: submit/step/take from one
+ * thread. New requests may be submitted between any two steps.
+ * The model must outlive the scheduler.
+ * ============================================================ */
+typedef struct {
+    int n_slots;  /* concurrent sequences (default: 4)             */
+    int slot_ctx; /* context per slot (default: see below)         */
+    int n_batch;  /* max tokens per decode step (default: n_batch) */
+    int cache_mb; /* evicted-slot KV snapshots (0 = 256, -1 = off) */
+} neuronos_scheduler_params_t;
+
+/* The default slot_ctx for n_slots slots on this model (see above),
+ * for callers that size their limits to it. 0 if model is NULL. */
+int neuronos_scheduler_slot_ctx(const neuronos_model_t * model, int n_slots);
+
+neuronos_scheduler_t * neuronos_scheduler_create(neuronos_model_t * model, neuronos_scheduler_params_t params);
+
+void neuronos_scheduler_free(neuronos_scheduler_t * sched);
+
+/* Admit a request. The prompt and grammar are copied; on_token and
+ * user_data must stay valid until the request finishes.
+ * Returns a request id (>= 0), or -1 if every slot is busy or the
+ * prompt does not fit in a slot. */
+int neuronos_scheduler_submit(neuronos_scheduler_t * sched, neuronos_gen_params_t params);
+
+/* Run one batched decode step.
+ * Returns the number of requests still in flight, or negative status on error. */
+int neuronos_scheduler_step(neuronos_scheduler_t * sched);
+
+/* Step until every submitted request has finished. */
+neuronos_status_t neuronos_scheduler_run(neuronos_scheduler_t * sched);
+
+/* Collect a finished request. Returns false if the request is still
+ * running or the id is unknown. Frees its slot on success; the caller
+ * owns result->text (free with neuronos_gen_result_free). */
+bool neuronos_scheduler_take(neuronos_scheduler_t * sched, int request_id, neuronos_gen_result_t * result);
+
+/* Number of requests submitted but not yet finished */
+int neuronos_scheduler_active(const neuronos_scheduler_t * sched);
+
+/* ============================================================
+ * METRICS: Process-wide telemetry
+ *
+ * neuronos_generate() and the scheduler record every call here,
+ * so the server and CLI can report percentiles without plumbing
+ * per-call results. Buckets are fixed (ms upper bounds, last one
+ * unbounded).
+ *
+ * Recording is lock-free: each thread writes its own shard and
+ * readers merge all shards, so an idle registry costs a few
+ * thread-local increments per event. Gauges are single process-
+ * wide values.
+ * ============================================================ */
+typedef enum {
+    NEURONOS_METRIC_TTFT = 0,   /* time to first token per call        */
+    NEURONOS_METRIC_PREFILL,    /* prompt evaluation per call          */
+    NEURONOS_METRIC_TPOT,       /* time per output token after TTFT    */
+    NEURONOS_METRIC_SAMPLE,     /* sampler time per sampled token      */
+    NEURONOS_METRIC_GENERATE,   /* whole neuronos_generate() call      */
+    NEURONOS_METRIC_QUEUE_WAIT, /* server: queued until admitted       */
+    NEURONOS_METRIC_TOOL,       /* neuronos_tool_execute(), per tool   */
+    NEURONOS_METRIC_MEMORY,     /* SQLite statement, per SQL verb      */
+    NEURONOS_METRIC_COUNT,
+} neuronos_metric_t;
+
+typedef enum {
+    NEURONOS_COUNTER_HTTP_REQUESTS = 0, /* requests parsed by the server  */
+    NEURONOS_COUNTER_GENERATIONS,       /* finished generations           */
+    NEURONOS_COUNTER_PROMPT_TOKENS,     /* prompt tokens of those calls   */
+    NEURONOS_COUNTER_REUSED_TOKENS,     /* ... served from the KV cache   */
+    NEURONOS_COUNTER_GENERATED_TOKENS,  /* tokens produced                */
+    NEURONOS_COUNTER_TOOL_ERRORS,       /* tool calls that failed         */
+    NEURONOS_COUNTER_CANCELLED,         /* server: client hung up         */
+    NEURONOS_COUNTER_REJECTED,          /* server: shed with 429 / 503    */
+    NEURONOS_COUNTER_TOOL_CACHE_HITS,   /* tool results served from cache */
+    NEURONOS_COUNTER_TOOL_CACHE_MISSES, /* cacheable calls that ran       */
+    NEURONOS_COUNTER_COUNT,
+} neuronos_counter_t;
+
+typedef enum {
+    NEURONOS_GAUGE_IN_FLIGHT = 0,     /* generations / agent runs executing */
+    NEURONOS_GAUGE_QUEUED,            /* generations waiting for a slot     */
+    NEURONOS_GAUGE_KV_USED,           /* scheduler KV cells holding tokens  */
+    NEURONOS_GAUGE_KV_SIZE,           /* scheduler KV cells in total        */
+    NEURONOS_GAUGE_KV_SNAPSHOT_BYTES, /* evicted-slot snapshots in RAM      */
+    NEURONOS_GAUGE_COUNT,
+} neuronos_gauge_t;
+
+#define NEURONOS_HIST_BUCKETS 16
+
+typedef struct {
+    uint64_t count;
+    double sum_ms;
+    double min_ms;
+    double max_ms;
+    uint64_t buckets[NEURONOS_HIST_BUCKETS];
+} neuronos_histogram_t;
+
+/* Add one observation */
+void neuronos_metrics_record(neuronos_metric_t metric, double ms);
+
+/* Add one observation to `metric` and to its series for `label`
+ * (e.g. the tool name). Up to 64 distinct series are kept; further
+ * labels only count towards the unlabelled total. */
+void neuronos_metrics_record_label(neuronos_metric_t metric, const char * label, double ms);
+
+/* Counters only go up; gauges are set or moved by a delta */
+void neuronos_metrics_add(neuronos_counter_t counter, uint64_t n);
+uint64_t neuronos_metrics_counter(neuronos_counter_t counter);
+void neuronos_metrics_gauge_set(neuronos_gauge_t gauge, int64_t value);
+void neuronos_metrics_gauge_add(neuronos_gauge_t gauge, int64_t delta);
+int64_t neuronos_metrics_gauge(neuronos_gauge_t gauge);
+
+/* Monotonic clock (ms) for timing observations */
+double neuronos_metrics_now_ms(void);
+
+/* Snapshot of one histogram (zeroed for an unknown metric) */
+neuronos_histogram_t neuronos_metrics_get(neuronos_metric_t metric);
+
+/* Estimate the p-quantile (0.0–1.0) by interpolating inside buckets */
+double neuronos_histogram_percentile(const neuronos_histogram_t * hist, double p);
+
+/* Upper bound (ms) of bucket i; the last bucket returns INFINITY */
+double neuronos_histogram_bucket_le(int i);
+
+/* Short name, e.g. "ttft" */
+const char * neuronos_metric_name(neuronos_metric_t metric);
+
+/* All histograms as a JSON object:
+ * {"ttft":{"count":..,"mean_ms":..,"p50_ms":..,"p95_ms":..,"p99_ms":..,"max_ms":..},...}
+ * Caller must free(). */
+char * neuronos_metrics_json(void);
+
+/* Everything in the Prometheus text exposition format (0.0.4):
+ * histograms in seconds, labelled series, counters and gauges.
+ * Caller must free(). */
+char * neuronos_metrics_prometheus(void);
+
+/* Per-thread recording shards allocated so far. Shards of exited
+ * threads are reused, so this tracks the peak number of threads that
+ * recorded at once, not the number ever started. */
+int neuronos_metrics_shard_count(void);
+
+/* Clear histograms and counters (gauges keep their level). Exact
+ * only while no other thread is recording. */
+void neuronos_metrics_reset(void);
+
 /* ============================================================
  * CHAT TEMPLATE: Format messages using model's chat template
  *
@@ -184,6 +495,15 @@ typedef neuronos_tool_result_t (*neuronos_tool_fn_t)(const char * args_json, voi
 #define NEURONOS_CAP_GPIO (1u << 5)
 #define NEURONOS_CAP_ALL (0xFFFFFFFFu)
 
+/* Result cache policy (see neuronos_tool_cache_enable) */
+typedef enum {
+    NEURONOS_TOOL_CACHE_NONE = 0, /* never reuse results (default)          */
+    NEURONOS_TOOL_CACHE_PATH,     /* reuse while the "path" (or "directory",
+                                     default ".") argument's mtime, size and
+                                     inode are unchanged                    */
+    NEURONOS_TOOL_CACHE_TTL,      /* reuse for cache_ttl_s seconds          */
+} neuronos_tool_cache_t;
+
 /* Tool descriptor */
 typedef struct {
     const char * name;             /* e.g. "shell", "read_file"    */
@@ -192,8 +512,17 @@ typedef struct {
     neuronos_tool_fn_t execute;    /* function pointer             */
     void * user_data;              /* passed to execute()          */
     uint32_t required_caps;        /* NEURONOS_CAP_* flags         */
+    bool thread_safe;              /* may run alongside other calls */
+    neuronos_tool_cache_t cache;   /* result reuse policy          */
+    int cache_ttl_s;               /* TTL; with CACHE_PATH an upper bound (0 = none) */
 } neuronos_tool_desc_t;
 
+/* One call of a batch (see neuronos_tool_execute_batch) */
+typedef struct {
+    const char * name;      /* tool name                      */
+    const char * args_json; /* arguments object (NULL = "{}") */
+} neuronos_tool_call_t;
+
 /* Create/free tool registry */
 neuronos_tool_registry_t * neuronos_tool_registry_create(void);
 void neuronos_tool_registry_free(neuronos_tool_registry_t * reg);
@@ -213,6 +542,29 @@ int neuronos_tool_register_memory(neuronos_tool_registry_t * reg, void * memory_
 neuronos_tool_result_t neuronos_tool_execute(neuronos_tool_registry_t * reg, const char * tool_name,
                                              const char * args_json);
 
+/* Execute n independent calls. Calls to thread_safe tools run concurrently
+ * on up to max_workers threads (0 = 4): the caller plus helper threads the
+ * registry starts on first use and keeps until it is freed. The others
+ * then run one at a time on the caller. results[i] always belongs to calls[i]. */
+void neuronos_tool_execute_batch(neuronos_tool_registry_t * reg, const neuronos_tool_call_t * calls, int n,
+                                 neuronos_tool_result_t * results, int max_workers);
+
+/* Tool result cache. Off by default; enabling it lets neuronos_tool_execute()
+ * reuse successful results of cacheable tools, keyed by tool name plus the
+ * canonical arguments (nj_canonical), evicting least recently used entries
+ * beyond max_bytes. max_bytes == 0 disables the cache and drops it. */
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;    /* cacheable calls that ran the tool */
+    int entries;
+    size_t bytes;       /* keys + outputs held */
+    size_t max_bytes;
+} neuronos_tool_cache_stats_t;
+
+void neuronos_tool_cache_enable(neuronos_tool_registry_t * reg, size_t max_bytes);
+void neuronos_tool_cache_clear(neuronos_tool_registry_t * reg);
+neuronos_tool_cache_stats_t neuronos_tool_cache_stats(neuronos_tool_registry_t * reg);
+
 /* Free tool result strings */
 void neuronos_tool_result_free(neuronos_tool_result_t * result);
 
@@ -228,12 +580,24 @@ const char * neuronos_tool_description(const neuronos_tool_registry_t * reg, int
 /* Get tool JSON schema by index (for MCP) */
 const char * neuronos_tool_schema(const neuronos_tool_registry_t * reg, int index);
 
+/* Whether the named tool may run alongside other calls (false if unknown) */
+bool neuronos_tool_thread_safe(const neuronos_tool_registry_t * reg, const char * name);
+
 /* Generate GBNF grammar rule for registered tool names */
 char * neuronos_tool_grammar_names(const neuronos_tool_registry_t * reg);
 
 /* Generate tool descriptions for injection into system prompt */
 char * neuronos_tool_prompt_description(const neuronos_tool_registry_t * reg);
 
+/* Rank tools by relevance to query (BM25 over name + description words)
+ * and store up to k tool indices in out_idx, best first. Tools sharing
+ * no word with the query are left out. Returns the number stored. */
+int neuronos_tool_select(const neuronos_tool_registry_t * reg, const char * query, int k, int * out_idx);
+
+/* Grammar rule / prompt descriptions for tools idx[0..n) only */
+char * neuronos_tool_grammar_names_subset(const neuronos_tool_registry_t * reg, const int * idx, int n);
+char * neuronos_tool_prompt_description_subset(const neuronos_tool_registry_t * reg, const int * idx, int n);
+
 /* ============================================================
  * AGENT: ReAct agent loop
  * ============================================================ */
@@ -244,6 +608,9 @@ typedef struct {
     float temperature;       /* sampling temperature (0.7)        */
     int context_budget;      /* max context tokens before compress */
     bool verbose;            /* print steps to stderr             */
+    int max_parallel_tools;  /* tool workers per multi-call step (4) */
+    int max_prompt_tools;    /* tools offered per query (16); -1 = all */
+    uint32_t seed;           /* sampling seed; 0 = random per step  */
 } neuronos_agent_params_t;
 
 /* Step callback: called after each think-act-observe cycle */
@@ -291,8 +658,19 @@ neuronos_agent_result_t neuronos_agent_chat(neuronos_agent_t * agent, const char
 /* Clear the agent's conversation history (reset multi-turn state) */
 void neuronos_agent_clear_history(neuronos_agent_t * agent);
 
+/* Prefill the interactive system prompt via a session snapshot so the
+ * first neuronos_agent_chat() only evaluates the user turn.
+ * cache_dir NULL = ~/.neuronos/sessions */
+neuronos_status_t neuronos_agent_warm_cache(neuronos_agent_t * agent, const char * cache_dir);
+
 void neuronos_agent_result_free(neuronos_agent_result_t * result);
 
+/* Poll cb(user_data) before every agent step and during generation;
+ * once it returns true the running call ends with
+ * NEURONOS_ERROR_CANCELLED and the unanswered turn is dropped from
+ * the history. NULL cb clears it. */
+void neuronos_agent_set_cancel(neuronos_agent_t * agent, neuronos_cancel_cb cb, void * user_data);
+
 /* Set system prompt (default is built-in ReAct prompt) */
 void neuronos_agent_set_system_prompt(neuronos_agent_t * agent, const char * system_prompt);
 
@@ -312,6 +690,25 @@ void neuronos_agent_set_system_prompt(neuronos_agent_t * agent, const char * sys
 neuronos_memory_t * neuronos_memory_open(const char * db_path);
 void neuronos_memory_close(neuronos_memory_t * mem);
 
+/* Group writes into one transaction (e.g. bulk recall logging or an
+ * archival import). Calls nest; only the outermost commit writes.
+ * commit returns -1 without a matching begin or if the write fails.
+ * With write-behind on they only track nesting (the writer batches). */
+int neuronos_memory_begin(neuronos_memory_t * mem);
+int neuronos_memory_commit(neuronos_memory_t * mem);
+
+/* Write-behind: queue recall messages, recall GC and archival access
+ * counts (capacity entries, rounded up to a power of 2) for a background
+ * writer with its own connection, which commits whatever is queued in
+ * one transaction and folds repeated access-count bumps. Queued calls
+ * return 0 instead of a row id / deleted count. Recall reads first wait
+ * for queued writes; close flushes. capacity 0 turns it off. File
+ * databases only; not inside begin/commit. Returns 0 on success. */
+int neuronos_memory_set_write_behind(neuronos_memory_t * mem, int capacity);
+
+/* Wait until all queued writes are committed. Returns 0 on success. */
+int neuronos_memory_flush(neuronos_memory_t * mem);
+
 /* ---- Core Memory (in-prompt blocks) ---- */
 
 /* Set/get a core memory block (e.g. "persona", "human", "instructions").
@@ -324,6 +721,10 @@ int neuronos_memory_core_append(neuronos_memory_t * mem, const char * label, con
  * Format: "<label>:\n<content>\n---\n..." Caller must free. */
 char * neuronos_memory_core_dump(neuronos_memory_t * mem);
 
+/* Counter bumped by every core memory write through this handle, so
+ * callers can cache text built from core_dump(). */
+uint64_t neuronos_memory_core_generation(neuronos_memory_t * mem);
+
 /* ---- Recall Memory (conversation log) ---- */
 
 typedef struct {
@@ -336,16 +737,24 @@ typedef struct {
     int64_t summary_of;    /* id of message this summarizes (0 = original) */
 } neuronos_recall_entry_t;
 
-/* Log a message to recall memory. Returns row id or -1 on error. */
+/* Log a message to recall memory. Returns row id or -1 on error. With
+ * write-behind the id is reserved when the row is queued (0 if no id
+ * could be reserved); the row itself appears once the writer commits. */
 int64_t neuronos_memory_recall_add(neuronos_memory_t * mem, int64_t session_id,
                                    const char * role, const char * content, int token_count);
 
+/* Log a summary of the session's messages up to and including row
+ * summary_of (role "system"). Returns row id as recall_add does. */
+int64_t neuronos_memory_recall_add_summary(neuronos_memory_t * mem, int64_t session_id, const char * content,
+                                           int token_count, int64_t summary_of);
+
 /* Get recent messages from current session (ordered by timestamp DESC).
  * Caller must free with neuronos_memory_recall_free(). */
 int neuronos_memory_recall_recent(neuronos_memory_t * mem, int64_t session_id,
                                   int limit, neuronos_recall_entry_t ** out_entries, int * out_count);
 
-/* Full-text search on recall memory. Caller frees with neuronos_memory_recall_free(). */
+/* Full-text search on recall memory (hybrid with an embedder attached).
+ * Caller frees with neuronos_memory_recall_free(). */
 int neuronos_memory_recall_search(neuronos_memory_t * mem, const char * query,
                                   int max_results, neuronos_recall_entry_t ** out_entries, int * out_count);
 
@@ -358,7 +767,7 @@ int neuronos_memory_recall_stats(neuronos_memory_t * mem, int64_t session_id,
 /* Garbage-collect recall memory for a session.
  * max_messages: keep only the N newest messages (0 = no limit).
  * max_age_seconds: delete messages older than this (0 = no limit).
- * Returns number of deleted rows, or -1 on error. */
+ * Returns number of deleted rows (0 if queued), or -1 on error. */
 int neuronos_memory_recall_gc(neuronos_memory_t * mem, int64_t session_id,
                               int max_messages, int max_age_seconds);
 
@@ -382,7 +791,8 @@ int64_t neuronos_memory_archival_store(neuronos_memory_t * mem, const char * key
 /* Recall a fact by key. Caller must free the returned string. Returns NULL if not found. */
 char * neuronos_memory_archival_recall(neuronos_memory_t * mem, const char * key);
 
-/* Full-text search on archival memory. Caller frees with neuronos_memory_archival_free(). */
+/* Full-text search on archival memory (hybrid with an embedder attached).
+ * Caller frees with neuronos_memory_archival_free(). */
 int neuronos_memory_archival_search(neuronos_memory_t * mem, const char * query,
                                     int max_results, neuronos_archival_entry_t ** out_entries, int * out_count);
 
@@ -391,6 +801,26 @@ void neuronos_memory_archival_free(neuronos_archival_entry_t * entries, int coun
 /* Get archival stats for prompt injection (A/R stats like MemGPT). */
 int neuronos_memory_archival_stats(neuronos_memory_t * mem, int * out_fact_count);
 
+/* ---- Embeddings: hybrid search ----
+ * With an embedder attached, archival facts and recall messages are
+ * embedded in batches as they are written and kept in sqlite-vec
+ * tables. Archival and recall search then fuse the FTS5 (BM25) and
+ * nearest-neighbour rankings by reciprocal rank fusion, so paraphrased
+ * queries still find their rows. File databases embed on a background
+ * thread with its own connection; ":memory:" ones catch up at search. */
+
+/* Write n dim-sized vectors for texts[0..n) into out. Returns 0 on success. */
+typedef int (*neuronos_embed_fn)(void * user_data, const char * const * texts, int n, float * out);
+
+/* Attach an embedder (fn NULL detaches it). name identifies the model:
+ * when name or dim differ from the stored vectors, all rows are
+ * re-embedded. Returns 0 on success. */
+int neuronos_memory_set_embedder(neuronos_memory_t * mem, const char * name, int dim, neuronos_embed_fn fn,
+                                 void * user_data);
+
+/* Embed all pending rows now. Returns the number embedded, or -1. */
+int neuronos_memory_embed_flush(neuronos_memory_t * mem);
+
 /* ---- Session management ---- */
 
 /* Create a new session. Returns session_id. */
@@ -448,7 +878,8 @@ void neuronos_hw_print_info(const neuronos_hw_info_t * hw);
  * MODEL SCANNER & AUTO-SELECTION
  * ============================================================ */
 
-/* Quantization type detected from filename heuristics */
+/* Quantization of the bulk of the weights: from the GGUF tensor types,
+ * or filename heuristics when the header can't be read */
 typedef enum {
     NEURONOS_QUANT_UNKNOWN = 0,
     NEURONOS_QUANT_I2_S,       /* BitNet ternary 1.58-bit           */
@@ -467,15 +898,22 @@ typedef struct {
     char path[512];              /* Absolute path to .gguf file        */
     char name[128];              /* Model name (from filename)         */
     int64_t file_size_mb;        /* File size in MB                    */
-    int64_t est_ram_mb;          /* Estimated RAM needed (file + ctx)  */
-    int64_t n_params_est;        /* Estimated params (from file size)  */
+    int64_t est_ram_mb;          /* Weights + KV at 2K ctx + overhead  */
+    int64_t n_params_est;        /* Params (exact from GGUF header)    */
     float score;                 /* Auto-computed suitability score     */
     bool fits_in_ram;            /* Can load with available RAM?       */
     neuronos_quant_type_t quant; /* Detected quantization type         */
     bool is_ternary;             /* True if I2_S / TL1 / 1.58-bit     */
+    /* From GGUF metadata; 0 when the header could not be read */
+    int n_layer;                 /* Transformer blocks                 */
+    int n_embd;                  /* Hidden size                        */
+    int n_ctx_train;             /* Trained context length             */
+    int64_t kv_bytes_per_tok;    /* f16 K+V bytes per token, all layers */
 } neuronos_model_entry_t;
 
 /* Scan a directory recursively for .gguf model files.
+ * Only each file's GGUF header is read (via mmap); results are cached in
+ * ~/.neuronos/models.idx keyed by path, size and mtime.
  * Returns array of entries sorted by score (best first).
  * Caller must free with neuronos_model_scan_free(). */
 neuronos_model_entry_t * neuronos_model_scan(const char * dir_path, const neuronos_hw_info_t * hw, int * out_count);
@@ -487,6 +925,33 @@ void neuronos_model_scan_free(neuronos_model_entry_t * entries, int count);
  * Returns NULL if no model fits. */
 const neuronos_model_entry_t * neuronos_model_select_best(const neuronos_model_entry_t * entries, int count);
 
+/* ---- Model conversion: float GGUF → I2_S ---- */
+
+typedef struct {
+    int qk;              /* I2_S block: 128 (x86), 64 (ARM); 0 = this build's kernels */
+    int n_threads;       /* HAL pool size while converting; 0 = keep current */
+    bool keep_embd_type; /* leave token_embd/output as-is instead of F16  */
+    /* Progress over input bytes; return false to cancel. NULL = none. */
+    bool (*on_progress)(int64_t done_bytes, int64_t total_bytes, void * user_data);
+    void * user_data;
+} neuronos_quantize_params_t;
+
+/* Quantize an F32/F16/BF16 GGUF (as written by convert-hf-to-gguf-bitnet.py)
+ * to I2_S. The input is memory-mapped and streamed through in row chunks,
+ * packed on the HAL pool and written straight to <dst_path>.part, then
+ * renamed into place; no tensor is ever held whole in memory.
+ *
+ * 2D blk.*.weight tensors whose rows are a multiple of qk become I2_S,
+ * token_embd/output become F16, everything else is copied unchanged.
+ * Metadata is copied with general.file_type set to MOSTLY_I2_S.
+ *
+ * @return NEURONOS_OK, NEURONOS_ERROR_MODEL_LOAD (unreadable or not a
+ *         GGUF), NEURONOS_ERROR_INIT (cannot write the output),
+ *         NEURONOS_ERROR_MEMORY, NEURONOS_ERROR_INVALID_PARAM or
+ *         NEURONOS_ERROR_CANCELLED */
+neuronos_status_t neuronos_model_quantize_i2(const char * src_path, const char * dst_path,
+                                             neuronos_quantize_params_t params);
+
 /* ============================================================
  * CONTEXT COMPACTION (inspired by Claude Code / OpenClaw)
  *
@@ -499,9 +964,22 @@ typedef struct {
     float trigger_ratio;    /* Compact when ctx usage > ratio (0.85)  */
     int retention_window;   /* Keep last N exchanges verbatim (6)     */
     int max_summary_tokens; /* Max tokens for the summary (256)       */
-    bool auto_compact;      /* Auto-trigger during agent_run (true)   */
+    bool auto_compact;      /* Auto-trigger after agent_chat (true)   */
 } neuronos_compact_params_t;
 
+/* Configure conversation compaction for neuronos_agent_chat().
+ * Zero numeric fields keep their defaults; auto_compact is taken as
+ * given.
+ *
+ * With auto_compact, a turn that ends with usage above trigger_ratio
+ * of context_budget starts a background summary of all but the last
+ * retention_window exchanges. It runs on the model's scratch KV
+ * sequence while the session is idle. The next turn swaps the summary
+ * in before building its prompt. If that turn arrives first and the
+ * history still fits the budget, the summary is cancelled rather than
+ * waited for. */
+void neuronos_agent_set_compact(neuronos_agent_t * agent, neuronos_compact_params_t params);
+
 /* Get current context token usage */
 int neuronos_context_token_count(const neuronos_agent_t * agent);
 
@@ -514,9 +992,16 @@ float neuronos_context_usage_ratio(const neuronos_agent_t * agent);
 /* Compact context: summarize oldest messages, shift KV cache.
  * Uses the model itself to generate a summary of old context.
  * Saves summary to recall memory if memory is attached.
- * Returns the number of tokens freed, or negative on error. */
+ * Finishes a background compaction if one is running, else runs one
+ * and waits for it. Returns the number of tokens freed, or negative
+ * on error. */
 int neuronos_context_compact(neuronos_agent_t * agent);
 
+/* Settle a background compaction before the agent's model is used
+ * from outside the agent: cancel it, or wait for it and swap its
+ * summary in. No-op when none is running. */
+void neuronos_context_compact_wait(neuronos_agent_t * agent, bool cancel);
+
 /* ============================================================
  * AUTO-TUNING: Optimal parameters for maximum performance
  *
@@ -525,13 +1010,16 @@ int neuronos_context_compact(neuronos_agent_t * agent);
  * ============================================================ */
 
 typedef struct {
-    int n_threads;    /* Optimal thread count (physical cores)    */
-    int n_batch;      /* Batch size for prompt processing          */
-    int n_ctx;        /* Context size (max tokens in conversation) */
-    bool flash_attn;  /* Enable flash attention if supported       */
-    bool use_mmap;    /* Memory-map model file (always true)       */
-    bool use_mlock;   /* Lock model in RAM (if enough headroom)    */
-    int n_gpu_layers; /* GPU layers to offload (0 = CPU only)      */
+    int n_threads;       /* Decode threads (bandwidth bound)          */
+    int n_threads_batch; /* Prefill threads (compute bound)           */
+    int n_batch;         /* Batch size for prompt processing          */
+    int n_ubatch;        /* Physical micro-batch per decode           */
+    int n_ctx;           /* Context size (max tokens in conversation) */
+    bool flash_attn;     /* Enable flash attention if supported       */
+    bool use_mmap;       /* Memory-map model file (always true)       */
+    bool use_mlock;      /* Lock model in RAM (if enough headroom)    */
+    int n_gpu_layers;    /* GPU layers to offload (0 = CPU only)      */
+    neuronos_kv_type_t kv_type; /* KV precision used for the n_ctx budget */
 } neuronos_tuned_params_t;
 
 /* Auto-compute optimal parameters for a given model+hardware combo */
@@ -540,6 +1028,12 @@ neuronos_tuned_params_t neuronos_auto_tune(const neuronos_hw_info_t * hw, const
 /* Print tuned parameters to stderr */
 void neuronos_tune_print(const neuronos_tuned_params_t * params);
 
+/* Approximate KV cache cost in MB per 1K context tokens for a ~2B model */
+int neuronos_kv_mb_per_1k(neuronos_kv_type_t kv_type);
+
+/* Model load params carrying every tuned knob for model_path */
+neuronos_model_params_t neuronos_tuned_model_params(const neuronos_tuned_params_t * params, const char * model_path);
+
 /* ============================================================
  * ZERO-ARG LAUNCHER: Full auto-config pipeline
  *
@@ -597,12 +1091,36 @@ typedef struct {
      * and interactive agent endpoint at POST /api/chat with SSE streaming
      * of thinking steps + tool use + final response. */
     neuronos_agent_t * agent; /* NULL = raw inference only          */
+
+    /* Concurrent OpenAI/Anthropic generations, batched by the scheduler
+     * on the inference thread (0 = 4). Health, metrics and model list
+     * are answered by the event loop and never wait on them. */
+    int n_slots;
+
+    /* Host memory for KV snapshots of conversations that lost their
+     * scheduler slot (0 = 256 MB, -1 = off). */
+    int cache_mb;
+
+    /* Admission control. Inference requests beyond n_slots + max_queue
+     * get 503, and a client address with max_per_client requests
+     * already running or queued gets 429; both carry Retry-After.
+     * max_queue: 0 = 4 per slot, -1 = unbounded.
+     * max_per_client: 0 = unlimited. */
+    int max_queue;
+    int max_per_client;
 } neuronos_server_params_t;
 
-/* Start HTTP server (blocking). Returns status on exit. */
+/* Start HTTP server (blocking until SIGINT/SIGTERM or
+ * neuronos_server_stop()). HTTP/1.1 keep-alive; one event-loop thread
+ * plus one inference thread that owns the model.
+ * Returns status on exit. */
 neuronos_status_t neuronos_server_start(neuronos_model_t * model, neuronos_tool_registry_t * tools,
                                         neuronos_server_params_t params);
 
+/* Ask a running server to shut down, as SIGINT does. Callable from any
+ * thread; neuronos_server_start() returns once streams have ended. */
+void neuronos_server_stop(void);
+
 /* ============================================================
  * MCP SERVER (Model Context Protocol — STDIO transport)
  *
@@ -619,7 +1137,11 @@ neuronos_status_t neuronos_server_start(neuronos_model_t * model, neuronos_tool_
 
 /* Start MCP server on STDIO (blocking). Reads JSON-RPC from stdin,
  * writes responses to stdout. Logging goes to stderr.
- * Returns NEURONOS_OK when stdin is closed. */
+ * tools/call requests run on a small worker pool and may be answered out
+ * of order; tools not marked thread_safe still run one at a time.
+ * notifications/cancelled drops a queued call, or suppresses the reply
+ * of a running one. Returns NEURONOS_OK when stdin is closed, after the
+ * calls already running have been answered. */
 neuronos_status_t neuronos_mcp_serve_stdio(neuronos_tool_registry_t * tools);
 
 /* ============================================================
@@ -631,7 +1153,9 @@ neuronos_status_t neuronos_mcp_serve_stdio(neuronos_tool_registry_t * tools);
  *   - Any MCP server published as npm/pip/binary
  *
  * Config: ~/.neuronos/mcp.json (Claude Desktop format)
- * Transport: STDIO (fork+exec child process, pipe JSON-RPC)
+ * Transport: STDIO (fork+exec child process, pipe JSON-RPC) or
+ *            Streamable HTTP (keep-alive POST, JSON or SSE replies;
+ *            https:// when built with OpenSSL)
  *
  * First MCP client in pure C. Zero dependencies.
  * ============================================================ */
@@ -641,7 +1165,7 @@ typedef struct neuronos_mcp_client neuronos_mcp_client_t;
 /* Transport types for MCP server connections */
 typedef enum {
     NEURONOS_MCP_TRANSPORT_STDIO = 0, /* Spawn process, pipe stdin/stdout   */
-    NEURONOS_MCP_TRANSPORT_HTTP,      /* Streamable HTTP (future)           */
+    NEURONOS_MCP_TRANSPORT_HTTP,      /* Streamable HTTP (POST + SSE)       */
 } neuronos_mcp_transport_t;
 
 /* Configuration for a single MCP server connection */
@@ -651,9 +1175,12 @@ typedef struct {
     const char * command;               /* STDIO: program to execute        */
     const char ** args;                 /* STDIO: program arguments         */
     int n_args;                         /* Number of arguments              */
-    const char * url;                   /* HTTP: server URL (future)        */
+    const char * url;                   /* HTTP: endpoint, http[s]://...    */
     const char ** env;                  /* Env vars ("KEY=VALUE" pairs)     */
     int n_env;                          /* Number of env vars               */
+    int timeout_ms;                     /* Per-call timeout (0 = 30 s)      */
+    const char ** headers;              /* HTTP: extra "Name: value" headers */
+    int n_headers;                      /* Number of headers                */
 } neuronos_mcp_server_config_t;
 
 /* Create an MCP client instance */
@@ -664,27 +1191,59 @@ int neuronos_mcp_client_add_server(neuronos_mcp_client_t * client,
                                    const neuronos_mcp_server_config_t * config);
 
 /* Connect to all configured servers (fork+exec, initialize handshake).
+ * Servers start concurrently; this waits for all of them.
  * Returns 0 on success, negative on total failure.
  * Individual server failures are logged but don't block others. */
 int neuronos_mcp_client_connect(neuronos_mcp_client_t * client);
 
+/* Start connecting to all configured servers and return immediately.
+ * Tools from the discovery cache are available at once; tools found
+ * later are picked up by the next neuronos_mcp_client_register_tools().
+ * Returns the number of servers starting, or -1 on error. */
+int neuronos_mcp_client_connect_async(neuronos_mcp_client_t * client);
+
+/* Wait up to timeout_ms (-1 = forever) for servers still starting.
+ * Returns how many are still starting. */
+int neuronos_mcp_client_wait(neuronos_mcp_client_t * client, int timeout_ms);
+
+/* Directory for the tool discovery cache (default ~/.neuronos/mcp_cache;
+ * NULL or "" disables it). One file per server command line records the
+ * server's version and tools/list result; a server reporting the same
+ * version on the next start skips tools/list. Call before connecting. */
+void neuronos_mcp_client_set_cache_dir(neuronos_mcp_client_t * client, const char * dir);
+
 /* Get total number of discovered tools across all connected servers */
 int neuronos_mcp_client_tool_count(const neuronos_mcp_client_t * client);
 
-/* Register all discovered MCP tools into a tool registry.
+/* Register discovered MCP tools into a tool registry.
  * Creates wrapper functions that bridge tool_registry → MCP server calls.
+ * The tools are registered thread_safe: parallel tool batches keep several
+ * calls in flight, on one server or many.
+ * Only tools not registered by an earlier call are added, so after
+ * connect_async it can be called between agent turns (from the thread
+ * that owns the registry) to hot-add late servers' tools.
  * Returns number of tools registered, or negative on error. */
 int neuronos_mcp_client_register_tools(neuronos_mcp_client_t * client,
                                        neuronos_tool_registry_t * registry);
 
 /* Call a specific MCP tool by name. Returns JSON result string.
+ * Safe to call from several threads at once; requests are correlated by
+ * JSON-RPC id, so a slow call does not hold up others on the same server.
  * Caller must free the returned string with neuronos_free(). */
 char * neuronos_mcp_client_call_tool(neuronos_mcp_client_t * client,
                                      const char * tool_name,
                                      const char * args_json);
 
+/* Same, waiting at most timeout_ms for the response (0 = the server's
+ * configured timeout). Returns NULL on timeout; a late response is dropped. */
+char * neuronos_mcp_client_call_tool_timeout(neuronos_mcp_client_t * client,
+                                             const char * tool_name,
+                                             const char * args_json,
+                                             int timeout_ms);
+
 /* Load MCP server configs from a JSON file.
  * Format: { "mcpServers": { "name": { "command": "...", "args": [...] } } }
+ * Remote servers: { "name": { "url": "https://...", "headers": {...} } }
  * Compatible with Claude Desktop / VS Code MCP config format.
  * Returns number of servers loaded, or negative on error. */
 int neuronos_mcp_client_load_config(neuronos_mcp_client_t * client,
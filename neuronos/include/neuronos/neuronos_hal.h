@@ -40,7 +40,7 @@ extern "C" {
 /**
  * Runtime profile determines which features are available.
  *   FULL    — Desktop/Server: mmap, threads, KV-cache, server
- *   LITE    — Browser/Mobile: fetch+buffer, web workers, limited cache
+ *   LITE    — Browser/Mobile: streamed OPFS loads, web workers, limited cache
  *   MINIMAL — MCU/Embedded: static alloc, no heap, single-thread
  *
  * Selected at compile time via -DNEURONOS_RUNTIME_PROFILE=FULL|LITE|MINIMAL
@@ -90,6 +90,7 @@ typedef enum {
     NEURONOS_HAL_ERR_NO_BACKEND = -2,  /* No suitable backend found */
     NEURONOS_HAL_ERR_INVALID = -3,     /* Invalid parameter */
     NEURONOS_HAL_ERR_UNSUPPORTED = -4, /* Operation not supported by backend */
+    NEURONOS_HAL_ERR_NOMEM = -5,       /* Allocation failed */
 } neuronos_hal_status_t;
 
 /* ──────────────────────────── Hardware features ─────────────────── */
@@ -117,6 +118,7 @@ typedef enum {
 
     /* WASM features */
     NEURONOS_FEAT_WASM_SIMD = (1 << 20),
+    NEURONOS_FEAT_WASM_RELAXED_SIMD = (1 << 21), /* relaxed-simd proposal (i8x16 dot) */
 
     /* GPU features */
     NEURONOS_FEAT_CUDA = (1 << 24),
@@ -129,15 +131,19 @@ typedef enum {
 
 typedef enum {
     NEURONOS_BACKEND_SCALAR = 0,    /* Portable C fallback */
+    NEURONOS_BACKEND_LUT = 1,       /* Portable table-lookup kernels (TL1-style, any shape) */
     NEURONOS_BACKEND_X86_AVX2 = 10, /* x86-64 with AVX2 */
     NEURONOS_BACKEND_X86_AVXVNNI = 11, /* x86-64 with AVX-VNNI (Alder Lake+) */
     NEURONOS_BACKEND_X86_AVX512 = 12,
     NEURONOS_BACKEND_ARM_NEON = 20, /* ARM with NEON */
     NEURONOS_BACKEND_ARM_SVE = 21,
+    NEURONOS_BACKEND_ARM_SVE_I8MM = 22, /* SVE + int8 matmul (SMMLA prefill GEMM) */
     NEURONOS_BACKEND_WASM = 30,   /* WebAssembly SIMD */
+    NEURONOS_BACKEND_WASM_RELAXED = 31, /* WebAssembly relaxed-SIMD (i8x16 dot) */
     NEURONOS_BACKEND_CUDA = 40,   /* NVIDIA CUDA */
     NEURONOS_BACKEND_VULKAN = 41, /* Vulkan compute */
     NEURONOS_BACKEND_METAL = 42,  /* Apple Metal */
+    NEURONOS_BACKEND_RISCV_RVV = 50, /* RISC-V Vector 1.0 */
 } neuronos_backend_type_t;
 
 /* ──────────────────────────── Kernel configuration ──────────────── */
@@ -151,6 +157,7 @@ typedef struct {
     int col_block_size; /* Number of columns processed per inner loop */
     int parallel_size;  /* SIMD parallelism factor */
     int qk_i2_s;        /* Quantization block size (128 for x86, 64 for ARM) */
+    int gemm_panel_kb;  /* Blocked gemm: unpacked weight panel kept in L2 (0 = not tunable) */
 } neuronos_kernel_config_t;
 
 /* ──────────────────────────── Kernel function types ─────────────── */
@@ -192,6 +199,10 @@ typedef void (*neuronos_gemv_i2_i8_fn)(int n, float * s, size_t bs, const void *
 /**
  * GEMM: matrix-matrix product for ternary weights.
  * C = W * A  where W is I2_S, A is I8_S
+ *
+ * W is nr contiguous packed rows of n/4 bytes; A is nc contiguous
+ * activation vectors of n int8. The result for weight row r and
+ * activation column c is written to ((float *)((char *)s + c * bs))[r].
  */
 typedef void (*neuronos_gemm_i2_i8_fn)(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc);
 
@@ -272,6 +283,14 @@ const neuronos_backend_t * neuronos_hal_get_active_backend(void);
  */
 neuronos_hal_status_t neuronos_hal_select_backend(neuronos_backend_type_t type);
 
+/**
+ * Activate the highest-priority feasible CPU backend, dropping GPU
+ * offload (the engine calls this when n_gpu_layers == 0).
+ *
+ * @return NEURONOS_HAL_OK on success
+ */
+neuronos_hal_status_t neuronos_hal_select_cpu_backend(void);
+
 /**
  * Get the number of registered backends.
  */
@@ -300,6 +319,23 @@ void neuronos_vec_dot_i2_i8(int n, float * s, size_t bs, const void * vx, size_t
 size_t neuronos_quantize_i2(const float * src, void * dst, int64_t nrow, int64_t n_per_row,
                             const float * quant_weights);
 
+/**
+ * Pack rows of f32 weights into I2_S blocks on the thread pool, without
+ * the trailing scale, so a tensor can be quantized in row chunks.
+ *
+ * Codes do not depend on the scale: *absmax is raised to the largest
+ * |w| seen and carried across calls. After the last chunk the caller
+ * stores it as a float right after the packed data, as
+ * neuronos_quantize_i2() does in one call.
+ *
+ * @param qk      Block size: 128 (x86 / HAL layout) or 64 (ggml ARM NEON)
+ * @param absmax  Running max |w| (start at 0)
+ * @return        Bytes written (nrow * n_per_row / 4), or 0 when
+ *                n_per_row is not a multiple of qk
+ */
+size_t neuronos_quantize_i2_rows(const float * src, void * dst, int64_t nrow, int64_t n_per_row, int qk,
+                                 float * absmax);
+
 /**
  * Dispatch gemv to the active backend.
  */
@@ -310,12 +346,105 @@ void neuronos_gemv_i2_i8(int n, float * s, size_t bs, const void * vx, const voi
  */
 void neuronos_gemm_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc);
 
+/**
+ * Backend that neuronos_vec_dot_i2_i8() / neuronos_gemv_i2_i8() use for
+ * an nr × n weight matrix: the active backend, or the LUT backend for
+ * shapes where neuronos_hal_autotune() measured it faster.
+ *
+ * @return Backend pointer, or NULL if not initialized
+ */
+const neuronos_backend_t * neuronos_hal_get_backend_for_shape(int n, int nr);
+
 /**
  * Get the kernel config of the active backend.
  * Useful for ggml integration (e.g., setting ncols, nrows in type_traits).
  */
 const neuronos_kernel_config_t * neuronos_hal_get_kernel_config(void);
 
+/**
+ * Replace the kernel config of the active backend (e.g. a tuned one).
+ * qk_i2_s is a packing property and must not change.
+ *
+ * @return NEURONOS_HAL_OK, ERR_NO_BACKEND, or ERR_INVALID
+ */
+neuronos_hal_status_t neuronos_hal_set_kernel_config(const neuronos_kernel_config_t * config);
+
+/**
+ * CPU model string used to key tuning results
+ * (x86 brand string, ARM MIDR, or "unknown").
+ */
+const char * neuronos_hal_get_cpu_model(void);
+
+/* ──────── Runtime kernel autotuning ──────── */
+
+/** One weight matrix shape to tune for: nr rows of n elements (n % 128 == 0). */
+typedef struct {
+    int n;
+    int nr;
+} neuronos_hal_shape_t;
+
+/**
+ * Micro-benchmark candidate kernel configs of the active backend on the
+ * given shapes, apply the fastest and persist it in
+ * ~/.neuronos/hal_tune.conf keyed by CPU model + backend name.
+ * Each decode shape (one activation column) is also timed on the LUT
+ * backend; shapes where it wins are routed to it by dispatch.
+ * neuronos_hal_init() and neuronos_hal_select_backend() re-apply the
+ * persisted result. If nothing was persisted, the first
+ * neuronos_gemm_i2_i8() call runs this on its own shape.
+ * Backends with nothing tunable return OK at once.
+ *
+ * @return NEURONOS_HAL_OK, ERR_NO_BACKEND, ERR_INVALID, or ERR_NOMEM
+ */
+neuronos_hal_status_t neuronos_hal_autotune(const neuronos_hal_shape_t * shapes, int n_shapes);
+
+/**
+ * True if the active backend's config came from a tuning run (this
+ * process or a persisted one), or the backend has nothing to tune.
+ */
+bool neuronos_hal_config_is_tuned(void);
+
+/* ──────── CPU topology and kernel thread pool ──────── */
+
+#define NEURONOS_HAL_MAX_CPUS 256
+
+typedef struct {
+    int n_cpus;   /* Logical CPUs in the process affinity mask */
+    int n_cores;  /* Physical cores among them */
+    int n_nodes;  /* NUMA nodes they span */
+    int n_big;    /* Logical CPUs on performance (P / big) cores */
+    int n_little; /* Logical CPUs on efficiency (E / LITTLE) cores; 0 = symmetric */
+} neuronos_hal_topology_t;
+
+/** CPU topology detected at neuronos_hal_init(). */
+const neuronos_hal_topology_t * neuronos_hal_get_topology(void);
+
+/**
+ * Size the persistent worker pool used by neuronos_vec_dot_i2_i8(),
+ * neuronos_gemv_i2_i8() and neuronos_gemm_i2_i8(). Workers are pinned
+ * one per physical core (P-cores first, spread across NUMA nodes); row
+ * blocks are split by core capacity and rebalanced by work stealing.
+ * The calling thread is counted as one of n_threads. Default: 1.
+ *
+ * @return NEURONOS_HAL_OK, ERR_INVALID, or ERR_UNSUPPORTED if fewer
+ *         threads could be started (the pool keeps those that did)
+ */
+neuronos_hal_status_t neuronos_hal_set_n_threads(int n_threads);
+
+/** Current pool size, including the calling thread. */
+int neuronos_hal_get_n_threads(void);
+
+/**
+ * Move the pages of a packed weight matrix (nr rows of row_bytes) to
+ * the NUMA nodes of the workers that will read them, using the same
+ * row split as dispatch with the given row grain (the backend's
+ * row_block_size). Call after neuronos_hal_set_n_threads().
+ *
+ * @return NEURONOS_HAL_OK (also when there is a single node),
+ *         ERR_INVALID, or ERR_UNSUPPORTED (no NUMA policy on this OS)
+ */
+neuronos_hal_status_t neuronos_hal_place_weights(const void * data, size_t row_bytes, int nr, int grain);
+
 /**
  * Print detected hardware capabilities to stdout.
  * Useful for diagnostics and benchmarking.
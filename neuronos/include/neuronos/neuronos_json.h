@@ -15,6 +15,10 @@
  *   - Extracts: strings, ints, objects, arrays
  *   - JSON string escaping for output
  *   - Zero dependencies (pure C11, no malloc for read-only ops)
+ *   - nj_doc: parse once into an offset tape, then look up many values
+ *     without rescanning (use it when a handler reads more than a couple
+ *     of fields from a large body)
+ *   - nj_writer: streaming JSON writer (commas and escaping handled)
  *
  * Copyright (c) 2025 NeuronOS Project
  * SPDX-License-Identifier: MIT
@@ -24,6 +28,7 @@
 #define NEURONOS_JSON_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -136,7 +141,8 @@ char * nj_escape(const char * s);
 
 /**
  * Escape up to `max_len` characters of a string for JSON.
- * Useful when you want to truncate before escaping.
+ * Useful when you want to truncate before escaping, or to escape a
+ * span that is not NUL-terminated (never reads past max_len).
  *
  * Caller must free() the returned pointer.
  */
@@ -148,6 +154,18 @@ char * nj_escape_n(const char * s, size_t max_len);
  */
 char * nj_unescape(const char * s);
 
+/**
+ * Canonical form of a JSON value: insignificant whitespace dropped and
+ * object members sorted by key (bytewise), recursively. Strings and
+ * numbers are copied as written. Two argument objects that differ only
+ * in member order or spacing canonicalize to the same text.
+ *
+ * Caller must free() the returned pointer.
+ *
+ * @return Newly allocated string, or NULL on malformed input / OOM
+ */
+char * nj_canonical(const char * json);
+
 /* ──────────────────────────────────────────────────────────────
  * SCAN — Low-level helpers for iterating JSON structures
  * ────────────────────────────────────────────────────────────── */
@@ -164,6 +182,183 @@ const char * nj_skip_ws(const char * p);
  */
 const char * nj_skip_value(const char * p);
 
+/* ──────────────────────────────────────────────────────────────
+ * DOC — Parse once, look up many times
+ *
+ * nj_parse() tokenizes a document in one pass into a flat tape of
+ * nj_tok_t. Each token records where its text lies in the source and
+ * the tape index just past its subtree, so skipping a value is O(1)
+ * and a lookup only walks the members of one object. Strings are
+ * views into the source, unescaped only when copied out; the source
+ * must outlive the doc.
+ *
+ * An object's children are key, value, key, value, ... (the key of
+ * member value v is node v - 1); an array's children are its
+ * elements. Node 0 is the root. Every accessor accepts node -1 (the
+ * "not found" result of nj_get/nj_first/nj_next) and then returns its
+ * fallback, NULL or -1.
+ *
+ *   nj_doc_t doc;
+ *   if (nj_parse(&doc, body, strlen(body)) == 0) {
+ *       int max_tokens = (int)nj_int(&doc, nj_get(&doc, 0, "max_tokens"), 256);
+ *       int msgs = nj_get(&doc, 0, "messages");
+ *       for (int m = nj_first(&doc, msgs); m >= 0; m = nj_next(&doc, msgs, m))
+ *           ...
+ *       nj_doc_free(&doc);
+ *   }
+ * ────────────────────────────────────────────────────────────── */
+
+typedef enum {
+    NJ_NULL = 0,
+    NJ_FALSE,
+    NJ_TRUE,
+    NJ_NUMBER,
+    NJ_STRING,
+    NJ_ARRAY,
+    NJ_OBJECT,
+} nj_type_t;
+
+typedef struct {
+    uint32_t start;  /* offset of the value; strings: first byte inside the quotes */
+    uint32_t len;    /* bytes of source text; strings: excluding the quotes */
+    uint32_t next;   /* tape index just past this value and its children */
+    uint8_t type;    /* nj_type_t */
+    uint8_t escaped; /* string contains backslash escapes */
+} nj_tok_t;
+
+typedef struct {
+    const char * json;
+    nj_tok_t * tok;
+    int n;
+    int cap;
+} nj_doc_t;
+
+/**
+ * Parse `len` bytes of JSON (one value, optionally surrounded by
+ * whitespace). The text need not be NUL-terminated.
+ *
+ * @return 0 on success, -1 on malformed input or OOM (doc is then empty;
+ *         nj_doc_free is still safe to call)
+ */
+int nj_parse(nj_doc_t * doc, const char * json, size_t len);
+
+/** Release the tape (not the source text). */
+void nj_doc_free(nj_doc_t * doc);
+
+/** Type of a node (NJ_NULL for -1). */
+nj_type_t nj_type(const nj_doc_t * doc, int node);
+
+/** Value of `key` in object `obj` (first match), or -1. */
+int nj_get(const nj_doc_t * doc, int obj, const char * key);
+
+/** First element (array) or member value (object), or -1. */
+int nj_first(const nj_doc_t * doc, int node);
+
+/** Sibling after `child` within container `node`, or -1. */
+int nj_next(const nj_doc_t * doc, int node, int child);
+
+/** Number of elements or members of a container (0 otherwise). */
+int nj_count(const nj_doc_t * doc, int node);
+
+/**
+ * Zero-copy view of a string node: points into the source, still
+ * escaped. *out_len gets the byte length (can be NULL).
+ * @return NULL if the node is not a string
+ */
+const char * nj_str(const nj_doc_t * doc, int node, int * out_len);
+
+/** Unescaped copy of a string node (\uXXXX decoded to UTF-8). Caller frees. */
+char * nj_str_dup(const nj_doc_t * doc, int node);
+
+/**
+ * Unescape a string node into buf (truncated to bufsize - 1 bytes).
+ * @return Bytes written (excluding NUL), or -1 if not a string
+ */
+int nj_str_copy(const nj_doc_t * doc, int node, char * buf, size_t bufsize);
+
+/** Whether a string node equals `s` once unescaped. */
+int nj_str_eq(const nj_doc_t * doc, int node, const char * s);
+
+/** Number node as an integer (truncated), or fallback. */
+long long nj_int(const nj_doc_t * doc, int node, long long fallback);
+
+/** Number node as a double, or fallback. */
+double nj_num(const nj_doc_t * doc, int node, double fallback);
+
+/** true/false node as 1/0, or fallback. */
+int nj_bool(const nj_doc_t * doc, int node, int fallback);
+
+/**
+ * Source text of any node (strings include their quotes), zero-copy.
+ * @return NULL for -1
+ */
+const char * nj_raw(const nj_doc_t * doc, int node, size_t * out_len);
+
+/** NUL-terminated copy of nj_raw(). Caller frees. */
+char * nj_raw_dup(const nj_doc_t * doc, int node);
+
+/* ──────────────────────────────────────────────────────────────
+ * WRITER — Build JSON text without snprintf bookkeeping
+ *
+ * Commas, key quoting and string escaping are handled by the writer;
+ * values are appended in document order. Start from a zeroed struct.
+ * An allocation failure (or nesting deeper than 64) is sticky and
+ * makes nj_w_finish return NULL.
+ *
+ *   nj_writer_t w = {0};
+ *   nj_w_obj(&w);
+ *   nj_w_key(&w, "id");
+ *   nj_w_int(&w, 7);
+ *   nj_w_key(&w, "text");
+ *   nj_w_str(&w, output);
+ *   nj_w_obj_end(&w);
+ *   char * json = nj_w_finish(&w);
+ * ────────────────────────────────────────────────────────────── */
+
+typedef struct {
+    char * s;
+    size_t len;
+    size_t cap;
+    uint64_t has_items; /* bit d: the container at depth d has a value */
+    int depth;
+    int after_key;
+    int failed;
+} nj_writer_t;
+
+void nj_w_obj(nj_writer_t * w);
+void nj_w_obj_end(nj_writer_t * w);
+void nj_w_arr(nj_writer_t * w);
+void nj_w_arr_end(nj_writer_t * w);
+
+/** Member key (escaped); the next value call supplies its value. */
+void nj_w_key(nj_writer_t * w, const char * key);
+
+/** String value, escaped (NULL writes null). */
+void nj_w_str(nj_writer_t * w, const char * s);
+
+/** String value from the first n bytes of s (stops early at NUL). */
+void nj_w_str_n(nj_writer_t * w, const char * s, size_t n);
+
+void nj_w_int(nj_writer_t * w, long long v);
+
+/** Number value; shortest form that round-trips, null if not finite. */
+void nj_w_num(nj_writer_t * w, double v);
+
+void nj_w_bool(nj_writer_t * w, int v);
+void nj_w_null(nj_writer_t * w);
+
+/** Pre-serialized JSON value, copied verbatim (NULL writes null). */
+void nj_w_raw(nj_writer_t * w, const char * json);
+
+/**
+ * Take the finished text. Caller frees.
+ * @return The text, or NULL after an error (the writer is reset either way)
+ */
+char * nj_w_finish(nj_writer_t * w);
+
+/** Discard the writer's buffer. */
+void nj_w_free(nj_writer_t * w);
+
 #ifdef __cplusplus
 }
 #endif
@@ -35,7 +35,7 @@ typedef struct {
     const char * hf_repo;      /* "microsoft/bitnet-b1.58-2B-4T-gguf"       */
     const char * filename;     /* "ggml-model-i2_s.gguf"                    */
     const char * url;          /* Full download URL                          */
-    const char * sha256;       /* SHA256 of the file (NULL if unknown)       */
+    const char * sha256;       /* SHA256 of the file (NULL: server's etag)   */
     int64_t size_mb;           /* Download size in MB                        */
     int64_t min_ram_mb;        /* Absolute minimum RAM to run                */
     int64_t rec_ram_mb;        /* Recommended RAM for good performance       */
@@ -46,6 +46,8 @@ typedef struct {
     const char * family;       /* "bitnet", "falcon3", "falcon-e"            */
     const char * languages;    /* "en", "en,fr,es,pt", etc.                  */
     int quality_stars;         /* 1-5 quality rating for display             */
+    int n_embd;                /* Hidden size (layer shapes for bench_hal)   */
+    int n_ff;                  /* FFN intermediate size                      */
 } neuronos_registry_entry_t;
 
 /* ---- Registry API ---- */
@@ -76,7 +78,13 @@ const neuronos_registry_entry_t * neuronos_registry_best_for_ram(int64_t availab
 typedef bool (*neuronos_download_progress_cb)(int64_t downloaded_bytes, int64_t total_bytes, void * user_data);
 
 /* Download a model from the registry to ~/.neuronos/models/.
- * Uses curl (must be in PATH). Shows progress bar in TTY.
+ * Fetches 64 MB byte ranges over parallel curl (or wget) streams
+ * into a preallocated <file>.part (NEURONOS_DL_CONNECTIONS, default 4).
+ * Each chunk's SHA-256 is journaled so an interrupted download resumes
+ * per chunk; the file is renamed into place only once complete, after
+ * its SHA-256 matches entry->sha256 or, when that is NULL, the digest
+ * in the server's X-Linked-Etag (a warning is printed if neither).
+ * Shows progress bar in TTY when on_progress is NULL.
  *
  * @param entry      Registry entry to download
  * @param dest_dir   Destination directory (NULL = ~/.neuronos/models/)
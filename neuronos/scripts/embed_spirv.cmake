@@ -0,0 +1,36 @@
+##
+## NeuronOS — Embed SPIR-V binaries into a C header
+##
+## Each input becomes a `static const uint32_t <name>[]` array, so the
+## Vulkan HAL backend can pass it straight to vkCreateShaderModule().
+##
+## Usage (called by CMake at build time):
+##   cmake -DOUTPUT=<header.h> -DINPUTS="<name>=<file.spv>|<name>=<file.spv>" -P embed_spirv.cmake
+##
+
+if(NOT OUTPUT OR NOT INPUTS)
+    message(FATAL_ERROR "embed_spirv.cmake: OUTPUT and INPUTS are required")
+endif()
+
+set(HEADER "/* Generated by scripts/embed_spirv.cmake — do not edit */\n#pragma once\n#include <stdint.h>\n")
+string(REPLACE "|" ";" INPUT_LIST "${INPUTS}")
+foreach(ENTRY ${INPUT_LIST})
+    string(REGEX MATCH "^([A-Za-z_][A-Za-z0-9_]*)=(.+)$" _ "${ENTRY}")
+    set(NAME "${CMAKE_MATCH_1}")
+    set(FILE "${CMAKE_MATCH_2}")
+    if(NOT NAME OR NOT EXISTS "${FILE}")
+        message(FATAL_ERROR "embed_spirv.cmake: bad input '${ENTRY}'")
+    endif()
+
+    # SPIR-V is a little-endian word stream: regroup bytes into uint32 literals
+    file(READ "${FILE}" HEX HEX)
+    string(LENGTH "${HEX}" HEX_LEN)
+    math(EXPR REM "${HEX_LEN} % 8")
+    if(NOT REM EQUAL 0)
+        message(FATAL_ERROR "embed_spirv.cmake: ${FILE} is not a whole number of words")
+    endif()
+    string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1u, " WORDS "${HEX}")
+    string(APPEND HEADER "\nstatic const uint32_t ${NAME}[] = {\n    ${WORDS}\n};\n")
+endforeach()
+
+file(WRITE "${OUTPUT}" "${HEADER}")
@@ -2,11 +2,14 @@
 """
 NeuronOS — Embed Web UI into C header
 
-Reads webui/index.html, optionally gzips it, and generates a C header
-with the data as an unsigned char array.
+Reads webui/index.html and generates a C header with the page as
+unsigned char arrays: the raw bytes plus precompressed variants, so the
+server never compresses at request time.
 
 Usage:
-  python3 embed_webui.py [--gzip] <input.html> <output.h>
+  python3 embed_webui.py [--gzip] [--brotli] <input.html> <output.h>
+
+--brotli needs the `brotli` module; without it the variant is skipped.
 
 The generated header can be included directly by neuronos_server.c.
 This script is called by CMake at build time, but the generated output
@@ -17,14 +20,25 @@ import sys
 import os
 import gzip as gz
 
+def c_array(lines, name, data):
+    lines.append(f'static const unsigned char {name}[] = {{')
+    # Write data as hex bytes, 16 per line
+    for i in range(0, len(data), 16):
+        chunk = data[i:i+16]
+        hex_vals = ','.join(f'0x{b:02x}' for b in chunk)
+        lines.append(f'  {hex_vals},')
+    lines.append('};')
+    lines.append(f'static const unsigned int {name}_len = {len(data)};')
+    lines.append('')
+
+
 def main():
-    use_gzip = False
     args = [a for a in sys.argv[1:] if not a.startswith('-')]
-    if '--gzip' in sys.argv:
-        use_gzip = True
+    use_gzip = '--gzip' in sys.argv
+    use_brotli = '--brotli' in sys.argv
 
     if len(args) < 2:
-        print(f"Usage: {sys.argv[0]} [--gzip] <input.html> <output.h>", file=sys.stderr)
+        print(f"Usage: {sys.argv[0]} [--gzip] [--brotli] <input.html> <output.h>", file=sys.stderr)
         sys.exit(1)
 
     input_path = args[0]
@@ -36,39 +50,39 @@ def main():
 
     raw_size = len(data)
 
-    # Optionally gzip
-    if use_gzip:
-        data = gz.compress(data, compresslevel=9)
+    # Precompressed variants; mtime=0 keeps the output reproducible
+    gz_data = gz.compress(data, compresslevel=9, mtime=0) if use_gzip else None
+    br_data = None
+    if use_brotli:
+        try:
+            import brotli
+            br_data = brotli.compress(data, quality=11)
+        except ImportError:
+            print("brotli module not found — skipping the .br variant", file=sys.stderr)
+
+    sizes = [f'{raw_size} bytes raw']
+    if gz_data is not None:
+        sizes.append(f'{len(gz_data)} bytes gzipped')
+    if br_data is not None:
+        sizes.append(f'{len(br_data)} bytes brotli')
 
     # Generate C header
-    var_suffix = '_gz' if use_gzip else ''
-    var_name = f'neuronos_chat_ui_html{var_suffix}'
-
     lines = []
     lines.append('/* Auto-generated by embed_webui.py — DO NOT EDIT */')
-    lines.append(f'/* Source: {os.path.basename(input_path)} ({raw_size} bytes raw'
-                 f'{f", {len(data)} bytes gzipped" if use_gzip else ""}) */')
+    lines.append(f'/* Source: {os.path.basename(input_path)} ({", ".join(sizes)}) */')
     lines.append('')
     lines.append('#ifndef NEURONOS_CHAT_UI_DATA_H')
     lines.append('#define NEURONOS_CHAT_UI_DATA_H')
     lines.append('')
-    lines.append(f'static const unsigned char {var_name}[] = {{')
-
-    # Write data as hex bytes, 16 per line
-    for i in range(0, len(data), 16):
-        chunk = data[i:i+16]
-        hex_vals = ','.join(f'0x{b:02x}' for b in chunk)
-        lines.append(f'  {hex_vals},')
 
-    lines.append('};')
-    lines.append(f'static const unsigned int {var_name}_len = {len(data)};')
-
-    if use_gzip:
-        lines.append(f'static const unsigned int neuronos_chat_ui_html_raw_len = {raw_size};')
-        lines.append(f'#define NEURONOS_CHAT_UI_IS_GZIPPED 1')
-    else:
-        lines.append(f'#define NEURONOS_CHAT_UI_IS_GZIPPED 0')
+    c_array(lines, 'neuronos_chat_ui_html', data)
+    if gz_data is not None:
+        c_array(lines, 'neuronos_chat_ui_html_gz', gz_data)
+    if br_data is not None:
+        c_array(lines, 'neuronos_chat_ui_html_br', br_data)
 
+    lines.append(f'#define NEURONOS_CHAT_UI_IS_GZIPPED {1 if gz_data is not None else 0}')
+    lines.append(f'#define NEURONOS_CHAT_UI_HAS_BROTLI {1 if br_data is not None else 0}')
     lines.append('')
     lines.append('#endif /* NEURONOS_CHAT_UI_DATA_H */')
     lines.append('')
@@ -78,8 +92,8 @@ def main():
     with open(output_path, 'w') as f:
         f.write('\n'.join(lines))
 
-    print(f"Embedded {os.path.basename(input_path)} -> {os.path.basename(output_path)} "
-          f"({raw_size} -> {len(data)} bytes{' gzipped' if use_gzip else ''})")
+    print(f"Embedded {os.path.basename(input_path)} -> {os.path.basename(output_path)} ({', '.join(sizes)})")
+
 
 if __name__ == '__main__':
     main()
@@ -16,15 +16,29 @@
 
 #ifdef _WIN32
 #include <windows.h>
+typedef HANDLE compact_thread_t;
+#define compact_load(p) InterlockedCompareExchange((volatile LONG *)(p), 0, 0)
+#define compact_store(p, v) InterlockedExchange((volatile LONG *)(p), (v))
+#else
+#include <pthread.h>
+typedef pthread_t compact_thread_t;
+#define compact_load(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define compact_store(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
 #endif
 
-/* ---- Built-in GBNF grammar for tool_call/final_answer (one-shot mode) ---- */
+/* ---- Built-in GBNF grammar for tool_call/final_answer (one-shot mode) ----
+ * The tool-name rule is appended per agent from the tools it currently
+ * offers (agent_build_tools), so the model cannot call one it was not shown. */
 static const char TOOL_CALL_GRAMMAR[] =
     "root ::= ws \"{\" ws step ws \"}\" ws\n"
-    "step ::= tool-call | final-answer\n"
+    "step ::= tool-call | multi-call | final-answer\n"
     "tool-call ::= \"\\\"thought\\\"\" ws \":\" ws string ws \",\" ws "
-    "\"\\\"action\\\"\" ws \":\" ws string ws \",\" ws "
+    "\"\\\"action\\\"\" ws \":\" ws tool-name ws \",\" ws "
     "\"\\\"args\\\"\" ws \":\" ws object\n"
+    "multi-call ::= \"\\\"thought\\\"\" ws \":\" ws string ws \",\" ws "
+    "\"\\\"calls\\\"\" ws \":\" ws \"[\" ws call ( ws \",\" ws call )* ws \"]\"\n"
+    "call ::= \"{\" ws \"\\\"action\\\"\" ws \":\" ws tool-name ws \",\" ws "
+    "\"\\\"args\\\"\" ws \":\" ws object ws \"}\"\n"
     "final-answer ::= \"\\\"thought\\\"\" ws \":\" ws string ws \",\" ws "
     "\"\\\"answer\\\"\" ws \":\" ws string\n"
     "object ::= \"{\" ws \"}\" | \"{\" ws members ws \"}\"\n"
@@ -46,11 +60,15 @@ static const char TOOL_CALL_GRAMMAR[] =
 /* ---- Interactive GBNF grammar: reply OR tool_call OR final_answer ---- */
 static const char INTERACTIVE_GRAMMAR[] =
     "root ::= ws \"{\" ws content ws \"}\" ws\n"
-    "content ::= reply-content | tool-content | answer-content\n"
+    "content ::= reply-content | tool-content | multi-content | answer-content\n"
     "reply-content ::= \"\\\"reply\\\"\" ws \":\" ws string\n"
     "tool-content ::= \"\\\"thought\\\"\" ws \":\" ws string ws \",\" ws "
-    "\"\\\"action\\\"\" ws \":\" ws string ws \",\" ws "
+    "\"\\\"action\\\"\" ws \":\" ws tool-name ws \",\" ws "
     "\"\\\"args\\\"\" ws \":\" ws object\n"
+    "multi-content ::= \"\\\"thought\\\"\" ws \":\" ws string ws \",\" ws "
+    "\"\\\"calls\\\"\" ws \":\" ws \"[\" ws call ( ws \",\" ws call )* ws \"]\"\n"
+    "call ::= \"{\" ws \"\\\"action\\\"\" ws \":\" ws tool-name ws \",\" ws "
+    "\"\\\"args\\\"\" ws \":\" ws object ws \"}\"\n"
     "answer-content ::= \"\\\"thought\\\"\" ws \":\" ws string ws \",\" ws "
     "\"\\\"answer\\\"\" ws \":\" ws string\n"
     "object ::= \"{\" ws \"}\" | \"{\" ws members ws \"}\"\n"
@@ -72,10 +90,13 @@ static const char INTERACTIVE_GRAMMAR[] =
 /* ---- Default system prompt template (one-shot mode, backward compat) ---- */
 static const char DEFAULT_SYSTEM_PROMPT_TEMPLATE[] =
     "You are a helpful AI assistant with access to tools.\n"
-    "You MUST respond with a JSON object in one of two formats:\n\n"
+    "You MUST respond with a JSON object in one of three formats:\n\n"
     "1. To use a tool:\n"
     "{\"thought\": \"your reasoning\", \"action\": \"tool_name\", \"args\": {\"arg1\": \"value1\"}}\n\n"
-    "2. To give a final answer:\n"
+    "2. To use several tools whose inputs do not depend on each other:\n"
+    "{\"thought\": \"your reasoning\", \"calls\": [{\"action\": \"tool_a\", \"args\": {}}, "
+    "{\"action\": \"tool_b\", \"args\": {}}]}\n\n"
+    "3. To give a final answer:\n"
     "{\"thought\": \"your reasoning\", \"answer\": \"your final answer\"}\n\n"
     "%s\n" /* tool descriptions injected here */
     "Rules:\n"
@@ -91,10 +112,14 @@ static const char SYSTEM_PROMPT_SMALL[] =
     "You are an AI assistant with tools. Respond with JSON ONLY.\n\n"
     "FORMAT 1 - Use a tool:\n"
     "{\"thought\": \"I need to check...\", \"action\": \"tool_name\", \"args\": {\"key\": \"val\"}}\n\n"
-    "FORMAT 2 - Final answer:\n"
+    "FORMAT 2 - Several independent tools:\n"
+    "{\"thought\": \"I need both\", \"calls\": [{\"action\": \"tool_a\", \"args\": {}}, "
+    "{\"action\": \"tool_b\", \"args\": {}}]}\n\n"
+    "FORMAT 3 - Final answer:\n"
     "{\"thought\": \"I know the answer\", \"answer\": \"my answer\"}\n\n"
     "%s\n"
-    "RULES: Think step by step. Use tools when needed. Answer when ready. JSON only.\n";
+    "RULES: Think step by step. Use tools when needed. Put independent tools in one \"calls\" step. "
+    "Answer when ready. JSON only.\n";
 
 /* Large models (>=7B params): detailed instructions */
 static const char SYSTEM_PROMPT_LARGE[] =
@@ -103,6 +128,9 @@ static const char SYSTEM_PROMPT_LARGE[] =
     "## To use a tool:\n"
     "{\"thought\": \"step-by-step reasoning about what to do\", \"action\": \"tool_name\", "
     "\"args\": {\"param\": \"value\"}}\n\n"
+    "## To use several independent tools at once:\n"
+    "{\"thought\": \"reasoning\", \"calls\": [{\"action\": \"tool_a\", \"args\": {}}, "
+    "{\"action\": \"tool_b\", \"args\": {}}]}\n\n"
     "## To provide your final answer:\n"
     "{\"thought\": \"reasoning about why you have enough information\", "
     "\"answer\": \"your comprehensive answer\"}\n\n"
@@ -111,6 +139,7 @@ static const char SYSTEM_PROMPT_LARGE[] =
     "## Guidelines\n"
     "- Reason carefully before each action.\n"
     "- Use tools to gather information -- do not guess.\n"
+    "- Batch lookups that do not depend on each other into one \"calls\" step.\n"
     "- If a tool errors, try a different approach.\n"
     "- Give a final answer when you have sufficient information.\n"
     "- Be thorough but concise in your answers.\n"
@@ -125,12 +154,16 @@ static const char INTERACTIVE_PROMPT_SMALL[] =
     "{\"reply\": \"your response\"}\n\n"
     "FORMAT 2 - Use a tool (when you need to do something or get information):\n"
     "{\"thought\": \"why I need this tool\", \"action\": \"tool_name\", \"args\": {\"key\": \"val\"}}\n\n"
-    "FORMAT 3 - Answer after tools (when you have results from tools):\n"
+    "FORMAT 3 - Several independent tools (when no call needs another's result):\n"
+    "{\"thought\": \"I need both\", \"calls\": [{\"action\": \"tool_a\", \"args\": {}}, "
+    "{\"action\": \"tool_b\", \"args\": {}}]}\n\n"
+    "FORMAT 4 - Answer after tools (when you have results from tools):\n"
     "{\"thought\": \"what I learned\", \"answer\": \"my answer based on tool results\"}\n\n"
     "%s\n"
     "RULES:\n"
     "- Reply directly if you can answer from your knowledge.\n"
     "- Use tools when you need files, system info, time, calculations, etc.\n"
+    "- Put tools that do not depend on each other in one \"calls\" step.\n"
     "- After tools, give a final answer with your findings.\n"
     "- JSON only. No other text.\n";
 
@@ -144,6 +177,9 @@ static const char INTERACTIVE_PROMPT_LARGE[] =
     "### Tool Use (when you need to take action or gather information):\n"
     "{\"thought\": \"step-by-step reasoning\", \"action\": \"tool_name\", "
     "\"args\": {\"param\": \"value\"}}\n\n"
+    "### Several Tools (when the calls do not depend on each other's results):\n"
+    "{\"thought\": \"reasoning\", \"calls\": [{\"action\": \"tool_a\", \"args\": {}}, "
+    "{\"action\": \"tool_b\", \"args\": {}}]}\n\n"
     "### Final Answer (after using tools, when you have enough information):\n"
     "{\"thought\": \"reasoning about results\", \"answer\": \"your comprehensive answer\"}\n\n"
     "## Available Tools\n"
@@ -212,6 +248,28 @@ static char * compact_step_summary(const char ** step_actions, const char ** ste
     return summary;
 }
 
+/* ---- Background conversation compaction ---- */
+
+/* Instruction appended after the history being summarized */
+static const char COMPACT_INSTRUCTION[] =
+    "Summarize the conversation so far, including any earlier summary in the system message, "
+    "in at most %d words. Keep names, facts the user shared, decisions, open tasks and tool "
+    "results that may matter later. Reply with the summary text only.";
+
+/* One summary in flight. The worker touches only the model and the
+ * fields below; the agent and its memory stay on the caller's thread. */
+typedef struct {
+    neuronos_model_t * model;
+    char * prompt;      /* formatted summarization prompt            */
+    int max_tokens;
+    size_t n_msgs;      /* leading history messages it replaces      */
+    char * summary;     /* model output, NULL if it failed           */
+    int cancel;         /* set by the caller, polled by the worker   */
+    int done;           /* set by the worker when summary is final   */
+    bool threaded;      /* runs on `thread`, join before freeing     */
+    compact_thread_t thread;
+} compact_job_t;
+
 /* ---- Internal agent struct ---- */
 struct neuronos_agent {
     neuronos_model_t * model;
@@ -225,8 +283,31 @@ struct neuronos_agent {
     /* Conversation history for multi-turn interactive mode */
     char ** conv_roles;             /* role strings (owned copies) */
     char ** conv_contents;          /* content strings (owned copies) */
+    int64_t * conv_recall_ids;      /* recall memory row per message (0 = none) */
     size_t conv_len;                /* number of messages stored */
     size_t conv_cap;                /* allocated capacity */
+
+    /* Conversation compaction (neuronos_agent_set_compact) */
+    neuronos_compact_params_t compact;
+    char * conv_summary;            /* summary of messages no longer in conv_* */
+    char * chat_system;             /* system message of the last chat prompt */
+    char * memory_prompt;           /* base prompt + core memory (memory_stable_prompt) */
+    size_t memory_prompt_base;      /* length of the base it was built from */
+    uint64_t memory_prompt_gen;     /* core memory generation it was built from */
+    compact_job_t * compact_job;    /* background summary in flight, or NULL */
+
+    /* Tools offered in prompts and grammars (agent_select_tools) */
+    const char * oneshot_template;
+    const char * interactive_template;
+    bool custom_prompt;             /* set_system_prompt() replaced the one-shot prompt */
+    int * tool_subset;              /* registry indices, ascending; NULL = all tools */
+    int n_subset;
+    int n_tools_seen;               /* registry size the prompts were built for */
+    char * tool_grammar;            /* TOOL_CALL_GRAMMAR + tool-name rule */
+    char * chat_grammar;            /* INTERACTIVE_GRAMMAR + tool-name rule */
+
+    neuronos_cancel_cb cancel;      /* neuronos_agent_set_cancel() */
+    void * cancel_data;
 };
 
 /* ---- Helpers ---- */
@@ -243,6 +324,124 @@ static double get_time_ms(void) {
 #endif
 }
 
+static bool agent_cancelled(const neuronos_agent_t * agent) {
+    return agent->cancel && agent->cancel(agent->cancel_data);
+}
+
+/* ---- Tool dispatch ---- */
+
+#define AGENT_MAX_CALLS 8 /* calls honoured per "calls" step */
+
+/*
+ * Run the tool call(s) of one step: either a single "action"/"args" pair
+ * or a "calls" array, whose independent calls go through
+ * neuronos_tool_execute_batch(). on_step fires per call, in call order;
+ * with announce it also fires before the calls start (observation NULL).
+ * *out_action / *out_obs receive the step's tool names and observations,
+ * joined for multi-call steps. Returns false if the step names no tool.
+ */
+static bool agent_run_tools(neuronos_agent_t * agent, const char * text, int step, const char * thought,
+                            bool announce, neuronos_agent_step_cb on_step, void * user_data,
+                            const char ** out_action, const char ** out_obs) {
+    char * names[AGENT_MAX_CALLS];
+    char * args[AGENT_MAX_CALLS];
+    int n = 0;
+    if (!text)
+        return false;
+
+    char * list = nj_extract_array(text, "calls");
+    if (list) {
+        const char * p = nj_skip_ws(list + 1);
+        while (*p == '{' && n < AGENT_MAX_CALLS) {
+            const char * end = nj_skip_value(p);
+            if (!end)
+                break;
+            size_t len = (size_t)(end - p);
+            char * elem = malloc(len + 1);
+            if (!elem)
+                break;
+            memcpy(elem, p, len);
+            elem[len] = '\0';
+            names[n] = nj_alloc_str(elem, "action");
+            if (names[n])
+                args[n++] = nj_extract_object(elem, "args");
+            free(elem);
+            p = nj_skip_ws(end);
+            if (*p == ',')
+                p = nj_skip_ws(p + 1);
+        }
+        if (*p == '{' && agent->params.verbose)
+            fprintf(stderr, "[neuronos] Step lists more than %d calls, ignoring the rest\n", AGENT_MAX_CALLS);
+        free(list);
+    } else {
+        names[0] = nj_alloc_str(text, "action");
+        if (names[0]) {
+            args[0] = nj_extract_object(text, "args");
+            n = 1;
+        }
+    }
+    if (n == 0)
+        return false;
+
+    neuronos_tool_call_t calls[AGENT_MAX_CALLS];
+    for (int i = 0; i < n; i++) {
+        calls[i].name = names[i];
+        calls[i].args_json = args[i] ? args[i] : "{}";
+        if (announce && on_step)
+            on_step(step, i == 0 ? thought : NULL, names[i], NULL, user_data);
+        if (agent->params.verbose)
+            fprintf(stderr, "[neuronos] Tool: %s(%s)\n", names[i], calls[i].args_json);
+    }
+
+    neuronos_tool_result_t results[AGENT_MAX_CALLS];
+    neuronos_tool_execute_batch(agent->tools, calls, n, results, agent->params.max_parallel_tools);
+
+    const char * obs[AGENT_MAX_CALLS];
+    size_t act_len = 1, obs_len = 1;
+    for (int i = 0; i < n; i++) {
+        if (results[i].success)
+            obs[i] = results[i].output ? results[i].output : "";
+        else
+            obs[i] = results[i].error ? results[i].error : "Tool execution failed";
+        act_len += strlen(names[i]) + 2;
+        obs_len += strlen(names[i]) + strlen(obs[i]) + 4;
+
+        if (on_step)
+            on_step(step, announce || i > 0 ? NULL : thought, names[i], obs[i], user_data);
+        if (agent->params.verbose)
+            fprintf(stderr, "[neuronos] Observation: %.200s%s\n", obs[i], strlen(obs[i]) > 200 ? "..." : "");
+    }
+
+    /* Single call: observation verbatim. Several: "[tool] result" lines. */
+    if (n == 1) {
+        *out_action = strdup(names[0]);
+        *out_obs = strdup(obs[0]);
+    } else {
+        char * a = malloc(act_len);
+        char * o = malloc(obs_len);
+        if (a && o) {
+            size_t ap = 0, op = 0;
+            for (int i = 0; i < n; i++) {
+                ap += (size_t)snprintf(a + ap, act_len - ap, "%s%s", i ? ", " : "", names[i]);
+                op += (size_t)snprintf(o + op, obs_len - op, "%s[%s] %s", i ? "\n" : "", names[i], obs[i]);
+            }
+        } else {
+            free(a);
+            free(o);
+            a = o = NULL;
+        }
+        *out_action = a;
+        *out_obs = o;
+    }
+
+    for (int i = 0; i < n; i++) {
+        neuronos_tool_result_free(&results[i]);
+        free(names[i]);
+        free(args[i]);
+    }
+    return true;
+}
+
 /* JSON parsing: use nj_alloc_str/nj_extract_object from neuronos_json.h */
 
 /*
@@ -382,6 +581,179 @@ static char * build_prompt(const neuronos_agent_t * agent, const char * user_inp
     return prompt;
 }
 
+/* ============================================================
+ * TOOL SUBSET (prompts + grammars)
+ * ============================================================ */
+
+/* Fill "<template with %s>" into a new string. */
+static char * fill_template(const char * tmpl, const char * tool_desc) {
+    size_t size = strlen(tmpl) + strlen(tool_desc) + 64;
+    char * out = malloc(size);
+    if (out)
+        snprintf(out, size, tmpl, tool_desc);
+    return out;
+}
+
+/* Concatenate a base grammar with a trailing tool-name rule. */
+static char * grammar_with_names(const char * base, const char * names) {
+    size_t blen = strlen(base), nlen = strlen(names);
+    char * out = malloc(blen + nlen + 2);
+    if (!out)
+        return NULL;
+    memcpy(out, base, blen);
+    memcpy(out + blen, names, nlen);
+    out[blen + nlen] = '\n';
+    out[blen + nlen + 1] = '\0';
+    return out;
+}
+
+/*
+ * Rebuild the prompts and grammars from the current tool subset.
+ * Leaves the agent untouched on OOM.
+ */
+static bool agent_build_tools(neuronos_agent_t * agent) {
+    char * tool_desc;
+    char * names;
+    if (agent->tools) {
+        tool_desc = neuronos_tool_prompt_description_subset(agent->tools, agent->tool_subset, agent->n_subset);
+        names = agent->tool_subset
+                    ? neuronos_tool_grammar_names_subset(agent->tools, agent->tool_subset, agent->n_subset)
+                    : neuronos_tool_grammar_names(agent->tools);
+    } else {
+        tool_desc = strdup("No tools available.\n");
+        names = neuronos_tool_grammar_names(NULL);
+    }
+
+    char * system_prompt = NULL;
+    char * interactive_prompt = NULL;
+    char * tool_grammar = NULL;
+    char * chat_grammar = NULL;
+    bool ok = tool_desc && names;
+    if (ok && !agent->custom_prompt)
+        ok = (system_prompt = fill_template(agent->oneshot_template, tool_desc)) != NULL;
+    if (ok)
+        ok = (interactive_prompt = fill_template(agent->interactive_template, tool_desc)) != NULL;
+    if (ok)
+        ok = (tool_grammar = grammar_with_names(TOOL_CALL_GRAMMAR, names)) != NULL;
+    if (ok)
+        ok = (chat_grammar = grammar_with_names(INTERACTIVE_GRAMMAR, names)) != NULL;
+    free(tool_desc);
+    free(names);
+
+    if (!ok) {
+        free(system_prompt);
+        free(interactive_prompt);
+        free(tool_grammar);
+        free(chat_grammar);
+        return false;
+    }
+
+    if (!agent->custom_prompt) {
+        free(agent->system_prompt);
+        agent->system_prompt = system_prompt;
+    }
+    free(agent->interactive_prompt);
+    agent->interactive_prompt = interactive_prompt;
+    free(agent->chat_system); /* stale: it lists the old tools */
+    agent->chat_system = NULL;
+    free(agent->tool_grammar);
+    agent->tool_grammar = tool_grammar;
+    free(agent->chat_grammar);
+    agent->chat_grammar = chat_grammar;
+    return true;
+}
+
+static int cmp_int(const void * a, const void * b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static bool subset_has(const int * set, int n, int t) {
+    for (int i = 0; i < n; i++)
+        if (set[i] == t)
+            return true;
+    return false;
+}
+
+/*
+ * Choose which tools the next prompt offers. Registries that fit in
+ * max_prompt_tools are offered whole; larger ones (MCP servers) get the
+ * tools most relevant to `query`. The current subset is kept while it
+ * still covers every match, so the prompt -- and the KV prefix and
+ * compiled grammar behind it -- stays the same across related turns.
+ * Returns false only on OOM while building the first prompts.
+ */
+static bool agent_select_tools(neuronos_agent_t * agent, const char * query) {
+    int total = agent->tools ? neuronos_tool_count(agent->tools) : 0;
+    int k = agent->params.max_prompt_tools;
+    bool stale = !agent->interactive_prompt || total != agent->n_tools_seen;
+
+    if (k < 0 || total <= k) {
+        if (agent->tool_subset) {
+            free(agent->tool_subset);
+            agent->tool_subset = NULL;
+            agent->n_subset = 0;
+            stale = true;
+        }
+        if (!stale)
+            return true;
+        if (!agent_build_tools(agent))
+            return agent->interactive_prompt != NULL;
+        agent->n_tools_seen = total;
+        return true;
+    }
+
+    int * ranked = malloc((size_t)k * sizeof(int));
+    int * subset = malloc((size_t)k * sizeof(int));
+    if (!ranked || !subset) {
+        free(ranked);
+        free(subset);
+        return agent->interactive_prompt != NULL;
+    }
+    int n_ranked = neuronos_tool_select(agent->tools, query ? query : "", k, ranked);
+    if (n_ranked < 0)
+        n_ranked = 0;
+
+    bool covered = agent->tool_subset && !stale;
+    for (int i = 0; covered && i < n_ranked; i++)
+        covered = subset_has(agent->tool_subset, agent->n_subset, ranked[i]);
+    if (covered) {
+        free(ranked);
+        free(subset);
+        return true;
+    }
+
+    /* Matches first, topped up with the current subset, then registry order */
+    int m = 0;
+    for (int i = 0; i < n_ranked && m < k; i++)
+        subset[m++] = ranked[i];
+    for (int i = 0; i < agent->n_subset && m < k; i++)
+        if (agent->tool_subset[i] < total && !subset_has(subset, m, agent->tool_subset[i]))
+            subset[m++] = agent->tool_subset[i];
+    for (int t = 0; t < total && m < k; t++)
+        if (!subset_has(subset, m, t))
+            subset[m++] = t;
+    qsort(subset, (size_t)m, sizeof(int), cmp_int);
+    free(ranked);
+
+    int * old_subset = agent->tool_subset;
+    int old_n = agent->n_subset;
+    agent->tool_subset = subset;
+    agent->n_subset = m;
+    if (!agent_build_tools(agent)) {
+        agent->tool_subset = old_subset;
+        agent->n_subset = old_n;
+        free(subset);
+        return agent->interactive_prompt != NULL;
+    }
+    free(old_subset);
+    agent->n_tools_seen = total;
+
+    if (agent->params.verbose)
+        fprintf(stderr, "[neuronos] Offering %d of %d tools (%d matched the query)\n", m, total, n_ranked);
+    return true;
+}
+
 /* ============================================================
  * AGENT LIFECYCLE
  * ============================================================ */
@@ -408,6 +780,9 @@ neuronos_agent_t * neuronos_agent_create(neuronos_model_t * model, neuronos_tool
     if (auto_budget < 1536) auto_budget = 1536;
     agent->params.context_budget = params.context_budget > 0 ? params.context_budget : auto_budget;
     agent->params.verbose = params.verbose;
+    agent->params.max_parallel_tools = params.max_parallel_tools > 0 ? params.max_parallel_tools : 4;
+    agent->params.max_prompt_tools = params.max_prompt_tools != 0 ? params.max_prompt_tools : 16;
+    agent->params.seed = params.seed;
     agent->memory = NULL;
     agent->session_id = 1;
 
@@ -415,58 +790,40 @@ neuronos_agent_t * neuronos_agent_create(neuronos_model_t * model, neuronos_tool
     agent->conv_cap = 32;
     agent->conv_roles = calloc(agent->conv_cap, sizeof(char *));
     agent->conv_contents = calloc(agent->conv_cap, sizeof(char *));
-    if (!agent->conv_roles || !agent->conv_contents) {
+    agent->conv_recall_ids = calloc(agent->conv_cap, sizeof(int64_t));
+    if (!agent->conv_roles || !agent->conv_contents || !agent->conv_recall_ids) {
         free(agent->conv_roles);
         free(agent->conv_contents);
+        free(agent->conv_recall_ids);
         free(agent);
         return NULL;
     }
     agent->conv_len = 0;
+    agent->compact = (neuronos_compact_params_t){
+        .trigger_ratio = 0.85f,
+        .retention_window = 6,
+        .max_summary_tokens = 256,
+        .auto_compact = true,
+    };
 
     /* Select system prompt based on model size */
     neuronos_model_info_t minfo = neuronos_model_info(model);
-    const char * oneshot_template;
-    const char * interactive_template;
     if (minfo.n_params > 0 && minfo.n_params <= 4000000000LL) {
-        oneshot_template = SYSTEM_PROMPT_SMALL;
-        interactive_template = INTERACTIVE_PROMPT_SMALL;
+        agent->oneshot_template = SYSTEM_PROMPT_SMALL;
+        agent->interactive_template = INTERACTIVE_PROMPT_SMALL;
     } else if (minfo.n_params > 4000000000LL) {
-        oneshot_template = SYSTEM_PROMPT_LARGE;
-        interactive_template = INTERACTIVE_PROMPT_LARGE;
+        agent->oneshot_template = SYSTEM_PROMPT_LARGE;
+        agent->interactive_template = INTERACTIVE_PROMPT_LARGE;
     } else {
-        oneshot_template = DEFAULT_SYSTEM_PROMPT_TEMPLATE;
-        interactive_template = INTERACTIVE_PROMPT_SMALL;
-    }
-
-    /* Build system prompts with tool descriptions */
-    char * tool_desc;
-    if (tools) {
-        tool_desc = neuronos_tool_prompt_description(tools);
-    } else {
-        tool_desc = strdup("No tools available.\n");
-    }
-
-    /* One-shot prompt (for agent_run) */
-    size_t prompt_size = strlen(oneshot_template) + strlen(tool_desc) + 64;
-    agent->system_prompt = malloc(prompt_size);
-    if (!agent->system_prompt) {
-        free(tool_desc);
-        neuronos_agent_free(agent);
-        return NULL;
+        agent->oneshot_template = DEFAULT_SYSTEM_PROMPT_TEMPLATE;
+        agent->interactive_template = INTERACTIVE_PROMPT_SMALL;
     }
-    snprintf(agent->system_prompt, prompt_size, oneshot_template, tool_desc);
 
-    /* Interactive prompt (for agent_chat) */
-    size_t iprompt_size = strlen(interactive_template) + strlen(tool_desc) + 64;
-    agent->interactive_prompt = malloc(iprompt_size);
-    if (!agent->interactive_prompt) {
-        free(tool_desc);
+    /* Build system prompts and grammars with tool descriptions */
+    if (!agent_select_tools(agent, "")) {
         neuronos_agent_free(agent);
         return NULL;
     }
-    snprintf(agent->interactive_prompt, iprompt_size, interactive_template, tool_desc);
-
-    free(tool_desc);
 
     if (params.verbose) {
         const char * size_label = minfo.n_params <= 4000000000LL ? "small" : "large";
@@ -477,11 +834,17 @@ neuronos_agent_t * neuronos_agent_create(neuronos_model_t * model, neuronos_tool
     return agent;
 }
 
+static void compact_join(neuronos_agent_t * agent, bool wait, bool apply);
+
 void neuronos_agent_free(neuronos_agent_t * agent) {
     if (!agent)
         return;
+    compact_join(agent, false, false);
     free(agent->system_prompt);
     free(agent->interactive_prompt);
+    free(agent->tool_subset);
+    free(agent->tool_grammar);
+    free(agent->chat_grammar);
     /* Free conversation history */
     for (size_t i = 0; i < agent->conv_len; i++) {
         free(agent->conv_roles[i]);
@@ -489,6 +852,10 @@ void neuronos_agent_free(neuronos_agent_t * agent) {
     }
     free(agent->conv_roles);
     free(agent->conv_contents);
+    free(agent->conv_recall_ids);
+    free(agent->conv_summary);
+    free(agent->chat_system);
+    free(agent->memory_prompt);
     free(agent);
 }
 
@@ -497,52 +864,94 @@ void neuronos_agent_set_system_prompt(neuronos_agent_t * agent, const char * sys
         return;
     free(agent->system_prompt);
     agent->system_prompt = strdup(system_prompt);
+    agent->custom_prompt = true;
+}
+
+void neuronos_agent_set_cancel(neuronos_agent_t * agent, neuronos_cancel_cb cb, void * user_data) {
+    if (!agent) return;
+    agent->cancel = cb;
+    agent->cancel_data = cb ? user_data : NULL;
 }
 
 void neuronos_agent_set_memory(neuronos_agent_t * agent, neuronos_memory_t * mem) {
     if (!agent) return;
     agent->memory = mem;
+    free(agent->memory_prompt);
+    agent->memory_prompt = NULL;
+    free(agent->chat_system);
+    agent->chat_system = NULL;
     if (mem) {
         agent->session_id = neuronos_memory_session_create(mem);
     }
 }
 
 /*
- * Build enriched system prompt with core memory blocks and A/R stats.
- * Called when memory is attached and before each agent run.
+ * Stable part of a memory-enriched prompt: base prompt (persona + tools)
+ * and core memory. Rebuilt only when core memory or the base changes,
+ * so it stays byte-identical across turns and the KV prefix stays warm.
+ * Returns a string owned by the agent (base without memory), or NULL on
+ * allocation failure. *changed tells whether it was rebuilt.
  */
-static char * build_memory_enriched_prompt(const neuronos_agent_t * agent, const char * base_prompt) {
-    if (!agent->memory) return strdup(base_prompt);
-
-    char * core_dump = neuronos_memory_core_dump(agent->memory);
-    int recall_msgs = 0, recall_tokens = 0;
-    int archival_facts = 0;
+static const char * memory_stable_prompt(neuronos_agent_t * agent, const char * base, bool * changed) {
+    if (changed) *changed = false;
+    if (!agent->memory) return base;
 
-    neuronos_memory_recall_stats(agent->memory, agent->session_id, &recall_msgs, &recall_tokens);
-    neuronos_memory_archival_stats(agent->memory, &archival_facts);
+    uint64_t gen = neuronos_memory_core_generation(agent->memory);
+    size_t base_len = strlen(base);
+    if (agent->memory_prompt && agent->memory_prompt_gen == gen && agent->memory_prompt_base == base_len &&
+        strncmp(agent->memory_prompt, base, base_len) == 0)
+        return agent->memory_prompt;
 
-    /* Build enriched prompt */
-    size_t len = strlen(base_prompt) + (core_dump ? strlen(core_dump) : 0) + 512;
-    char * enriched = malloc(len);
-    if (!enriched) {
+    char * core_dump = neuronos_memory_core_dump(agent->memory);
+    size_t len = base_len + (core_dump ? strlen(core_dump) : 0) + 256;
+    char * prompt = malloc(len);
+    if (!prompt) {
         free(core_dump);
         return NULL;
     }
-    snprintf(enriched, len,
+    snprintf(prompt, len,
         "%s\n"
         "### Core Memory ###\n"
         "%s"
         "\n"
-        "### Memory Stats ###\n"
-        "Recall memory: %d messages (%d tokens) in this session.\n"
-        "Archival memory: %d facts stored.\n"
         "You can use memory_store to save important facts, memory_search to find them, "
         "and memory_core_update to update your core memory blocks.\n",
-        base_prompt,
-        core_dump ? core_dump : "(empty)\n",
+        base,
+        core_dump ? core_dump : "(empty)\n");
+    free(core_dump);
+
+    free(agent->memory_prompt);
+    agent->memory_prompt = prompt;
+    agent->memory_prompt_base = base_len;
+    agent->memory_prompt_gen = gen;
+    if (changed) *changed = true;
+    return prompt;
+}
+
+/* Live counters: they change every turn, so they trail the prompt */
+static void memory_stats_section(const neuronos_agent_t * agent, char * buf, size_t size) {
+    int recall_msgs = 0, recall_tokens = 0;
+    int archival_facts = 0;
+    neuronos_memory_recall_stats(agent->memory, agent->session_id, &recall_msgs, &recall_tokens);
+    neuronos_memory_archival_stats(agent->memory, &archival_facts);
+    snprintf(buf, size,
+        "### Memory Stats ###\n"
+        "Recall memory: %d messages (%d tokens) in this session.\n"
+        "Archival memory: %d facts stored.\n",
         recall_msgs, recall_tokens, archival_facts);
+}
 
-    free(core_dump);
+/* Stable prompt followed by fresh memory stats. Returns newly allocated string. */
+static char * build_memory_enriched_prompt(neuronos_agent_t * agent, const char * base_prompt) {
+    const char * stable = memory_stable_prompt(agent, base_prompt, NULL);
+    if (!stable) return NULL;
+    if (!agent->memory) return strdup(stable);
+
+    char stats[256];
+    memory_stats_section(agent, stats, sizeof(stats));
+    size_t len = strlen(stable) + strlen(stats) + 2;
+    char * enriched = malloc(len);
+    if (enriched) snprintf(enriched, len, "%s\n%s", stable, stats);
     return enriched;
 }
 
@@ -559,6 +968,8 @@ neuronos_agent_result_t neuronos_agent_run(neuronos_agent_t * agent, const char
         result.status = NEURONOS_ERROR_INVALID_PARAM;
         return result;
     }
+    compact_join(agent, false, true);
+    agent_select_tools(agent, user_input);
 
     /* If memory is attached, enrich system prompt with core blocks + stats */
     char * original_prompt = NULL;
@@ -594,6 +1005,11 @@ neuronos_agent_result_t neuronos_agent_run(neuronos_agent_t * agent, const char
     int steps_taken = 0;
 
     for (int step = 0; step < max_steps; step++) {
+        if (agent_cancelled(agent)) {
+            result.status = NEURONOS_ERROR_CANCELLED;
+            break;
+        }
+
         if (agent->params.verbose) {
             fprintf(stderr, "\n[neuronos] ── Step %d/%d ──\n", step + 1, max_steps);
         }
@@ -645,6 +1061,7 @@ neuronos_agent_result_t neuronos_agent_run(neuronos_agent_t * agent, const char
 
                     /* Store compacted steps to recall memory if available */
                     if (agent->memory) {
+                        neuronos_memory_begin(agent->memory);
                         for (int i = first_active_step; i < compact_end; i++) {
                             if (step_outputs[i]) {
                                 neuronos_memory_recall_add(agent->memory, agent->session_id,
@@ -652,6 +1069,7 @@ neuronos_agent_result_t neuronos_agent_run(neuronos_agent_t * agent, const char
                                     estimate_tokens(step_outputs[i]));
                             }
                         }
+                        neuronos_memory_commit(agent->memory);
                     }
 
                     first_active_step = compact_end;
@@ -681,11 +1099,12 @@ neuronos_agent_result_t neuronos_agent_run(neuronos_agent_t * agent, const char
             .temperature = agent->params.temperature,
             .top_p = 0.95f,
             .top_k = 40,
-            .grammar = TOOL_CALL_GRAMMAR,
+            .grammar = agent->tool_grammar,
             .grammar_root = "root",
             .on_token = NULL,
-            .user_data = NULL,
-            .seed = 0,
+            .user_data = agent->cancel_data,
+            .seed = agent->params.seed,
+            .is_cancelled = agent->cancel,
         };
 
         neuronos_gen_result_t gen = neuronos_generate(agent->model, gen_params);
@@ -693,7 +1112,7 @@ neuronos_agent_result_t neuronos_agent_run(neuronos_agent_t * agent, const char
 
         if (gen.status != NEURONOS_OK || !gen.text) {
             neuronos_gen_result_free(&gen);
-            result.status = NEURONOS_ERROR_GENERATE;
+            result.status = gen.status == NEURONOS_ERROR_CANCELLED ? NEURONOS_ERROR_CANCELLED : NEURONOS_ERROR_GENERATE;
             break;
         }
 
@@ -708,8 +1127,6 @@ neuronos_agent_result_t neuronos_agent_run(neuronos_agent_t * agent, const char
         /* Parse the JSON response */
         char * thought = nj_alloc_str(gen.text, "thought");
         char * answer = nj_alloc_str(gen.text, "answer");
-        char * action = nj_alloc_str(gen.text, "action");
-        char * args = nj_extract_object(gen.text, "args");
 
         neuronos_gen_result_free(&gen);
 
@@ -728,36 +1145,12 @@ neuronos_agent_result_t neuronos_agent_run(neuronos_agent_t * agent, const char
             result.status = NEURONOS_OK;
 
             free(thought);
-            free(action);
-            free(args);
             goto cleanup;
         }
 
-        /* ---- Tool call path ---- */
-        if (action && agent->tools) {
-            step_actions[step] = strdup(action);
-
-            if (agent->params.verbose) {
-                fprintf(stderr, "[neuronos] Tool: %s(%s)\n", action, args ? args : "{}");
-            }
-
-            neuronos_tool_result_t tool_result = neuronos_tool_execute(agent->tools, action, args ? args : "{}");
-
-            const char * obs = tool_result.success ? tool_result.output
-                                                   : (tool_result.error ? tool_result.error : "Tool execution failed");
-
-            step_observations[step] = strdup(obs);
-
-            if (on_step) {
-                on_step(step, thought, action, obs, user_data);
-            }
-
-            if (agent->params.verbose) {
-                fprintf(stderr, "[neuronos] Observation: %.200s%s\n", obs, strlen(obs) > 200 ? "..." : "");
-            }
-
-            neuronos_tool_result_free(&tool_result);
-        } else {
+        /* ---- Tool call path (one call or a "calls" batch) ---- */
+        if (!agent->tools || !agent_run_tools(agent, step_outputs[step], step, thought, false, on_step, user_data,
+                                              &step_actions[step], &step_observations[step])) {
             /* No action and no answer — model confused, try to continue */
             step_observations[step] = strdup("Error: You must provide either \"action\" with \"args\" to use a tool, "
                                              "or \"answer\" to give a final answer. Please try again.");
@@ -765,8 +1158,6 @@ neuronos_agent_result_t neuronos_agent_run(neuronos_agent_t * agent, const char
         }
 
         free(thought);
-        free(action);
-        free(args);
     }
 
     /* If we get here, max steps reached without final answer */
@@ -816,10 +1207,21 @@ void neuronos_agent_result_free(neuronos_agent_result_t * result) {
  * CONTEXT API: Token counting and usage tracking
  * ============================================================ */
 
+/* Estimated prompt tokens of the next chat turn, before its user input */
+static int chat_tokens(const neuronos_agent_t * agent) {
+    int n = estimate_tokens(agent->interactive_prompt) + estimate_tokens(agent->conv_summary);
+    for (size_t i = 0; i < agent->conv_len; i++)
+        n += estimate_tokens(agent->conv_contents[i]) + 8; /* role tags */
+    return n;
+}
+
 int neuronos_context_token_count(const neuronos_agent_t * agent) {
     if (!agent || !agent->model) return 0;
-    /* Returns estimated tokens used by system prompt + core memory.
-     * During agent_run, actual token count is tracked per-step internally. */
+    /* With a conversation: interactive prompt + summary + history.
+     * Otherwise the system prompt; during agent_run, actual token
+     * count is tracked per-step internally. */
+    if (agent->conv_len > 0 || agent->conv_summary)
+        return chat_tokens(agent);
     return estimate_tokens(agent->system_prompt);
 }
 
@@ -834,15 +1236,6 @@ float neuronos_context_usage_ratio(const neuronos_agent_t * agent) {
     return (float)neuronos_context_token_count(agent) / (float)cap;
 }
 
-int neuronos_context_compact(neuronos_agent_t * agent) {
-    /* Context compaction is performed automatically during agent_run()
-     * when the prompt exceeds 80% of context capacity.
-     * This function is a no-op outside of an active agent run.
-     * Returns 0 (no tokens freed outside of a run). */
-    (void)agent;
-    return 0;
-}
-
 /* ============================================================
  * CONVERSATION HISTORY HELPERS (for interactive mode)
  * ============================================================ */
@@ -850,17 +1243,20 @@ int neuronos_context_compact(neuronos_agent_t * agent) {
 static void conv_history_push(neuronos_agent_t * agent, const char * role, const char * content) {
     if (!agent || !role || !content) return;
 
-    /* Grow if needed */
+    /* Grow if needed (each array keeps whatever realloc gave it) */
     if (agent->conv_len >= agent->conv_cap) {
         size_t new_cap = agent->conv_cap * 2;
         char ** new_roles = realloc(agent->conv_roles, new_cap * sizeof(char *));
+        if (new_roles) agent->conv_roles = new_roles;
         char ** new_contents = realloc(agent->conv_contents, new_cap * sizeof(char *));
-        if (!new_roles || !new_contents) return;
-        agent->conv_roles = new_roles;
-        agent->conv_contents = new_contents;
+        if (new_contents) agent->conv_contents = new_contents;
+        int64_t * new_ids = realloc(agent->conv_recall_ids, new_cap * sizeof(int64_t));
+        if (new_ids) agent->conv_recall_ids = new_ids;
+        if (!new_roles || !new_contents || !new_ids) return;
         agent->conv_cap = new_cap;
     }
 
+    agent->conv_recall_ids[agent->conv_len] = 0;
     agent->conv_roles[agent->conv_len] = strdup(role);
     agent->conv_contents[agent->conv_len] = strdup(content);
     if (!agent->conv_roles[agent->conv_len] || !agent->conv_contents[agent->conv_len]) {
@@ -873,13 +1269,373 @@ static void conv_history_push(neuronos_agent_t * agent, const char * role, const
     agent->conv_len++;
 }
 
+/* Drop every message from index len on */
+static void conv_history_truncate(neuronos_agent_t * agent, size_t len) {
+    if (!agent) return;
+    while (agent->conv_len > len) {
+        agent->conv_len--;
+        free(agent->conv_roles[agent->conv_len]);
+        free(agent->conv_contents[agent->conv_len]);
+        agent->conv_roles[agent->conv_len] = NULL;
+        agent->conv_contents[agent->conv_len] = NULL;
+    }
+}
+
 void neuronos_agent_clear_history(neuronos_agent_t * agent) {
     if (!agent) return;
+    compact_join(agent, false, false);
     for (size_t i = 0; i < agent->conv_len; i++) {
         free(agent->conv_roles[i]);
         free(agent->conv_contents[i]);
     }
     agent->conv_len = 0;
+    free(agent->conv_summary);
+    agent->conv_summary = NULL;
+    free(agent->chat_system);
+    agent->chat_system = NULL;
+}
+
+/* ============================================================
+ * CONVERSATION COMPACTION
+ *
+ * The oldest exchanges of the chat history are replaced by a
+ * summary that rides in the system message. The summary is
+ * generated on the model's scratch KV sequence, forked from the
+ * cached chat prompt, so only the instruction is prefilled and
+ * the cache the next turn reuses stays intact.
+ * ============================================================ */
+
+/* System message of a chat prompt: base prompt plus the running summary */
+static char * chat_system_message(const neuronos_agent_t * agent, const char * base) {
+    if (!agent->conv_summary)
+        return strdup(base);
+    size_t len = strlen(base) + strlen(agent->conv_summary) + 64;
+    char * msg = malloc(len);
+    if (msg)
+        snprintf(msg, len, "%s\n### Conversation Summary ###\n%s\n", base, agent->conv_summary);
+    return msg;
+}
+
+/*
+ * System message for the next chat prompt: stable prompt, running
+ * summary, then memory stats. It is reused byte for byte until the
+ * stable prompt changes or compaction drops it (new summary), so the
+ * stats refresh only then. Returns agent->chat_system, or NULL.
+ */
+static const char * chat_system_current(neuronos_agent_t * agent) {
+    bool changed = false;
+    const char * stable = memory_stable_prompt(agent, agent->interactive_prompt, &changed);
+    if (!stable)
+        return NULL;
+    if (agent->chat_system && !changed)
+        return agent->chat_system;
+
+    char * msg = chat_system_message(agent, stable);
+    if (msg && agent->memory) {
+        char stats[256];
+        memory_stats_section(agent, stats, sizeof(stats));
+        size_t len = strlen(msg) + strlen(stats) + 2;
+        char * with_stats = malloc(len);
+        if (with_stats)
+            snprintf(with_stats, len, "%s\n%s", msg, stats);
+        free(msg);
+        msg = with_stats;
+    }
+    free(agent->chat_system);
+    agent->chat_system = msg;
+    return msg;
+}
+
+/* Share of context_budget the next chat turn needs before its input */
+static float chat_usage(const neuronos_agent_t * agent) {
+    int budget = agent->params.context_budget > 0 ? agent->params.context_budget : 1;
+    return (float)(chat_tokens(agent) + agent->params.max_tokens_per_step) / (float)budget;
+}
+
+/* Index of the first message kept verbatim: the user message that
+ * opens the last `keep` exchanges. 0 = nothing to compact. */
+static size_t compact_split(const neuronos_agent_t * agent, int keep) {
+    for (size_t i = agent->conv_len; i > 0; i--) {
+        if (strcmp(agent->conv_roles[i - 1], "user") == 0 && --keep <= 0)
+            return i - 1;
+    }
+    return 0;
+}
+
+/*
+ * Extractive summary of messages [0..n), appended to the running one.
+ * Used when the model could not produce a summary.
+ * Returns newly allocated string. Caller must free.
+ */
+static char * compact_conv_summary(const neuronos_agent_t * agent, size_t n) {
+    size_t cap = 32 + (agent->conv_summary ? strlen(agent->conv_summary) + 1 : 0);
+    for (size_t i = 0; i < n; i++)
+        cap += strlen(agent->conv_roles[i]) + 96;
+    char * summary = malloc(cap);
+    if (!summary) return NULL;
+
+    size_t len = 0;
+    if (agent->conv_summary)
+        len += (size_t)snprintf(summary + len, cap - len, "%s ", agent->conv_summary);
+    len += (size_t)snprintf(summary + len, cap - len, "[Earlier conversation: ");
+    for (size_t i = 0; i < n; i++) {
+        const char * text = agent->conv_contents[i];
+        len += (size_t)snprintf(summary + len, cap - len, "%s: %.80s%s ", agent->conv_roles[i], text,
+                                strlen(text) > 80 ? "..." : ".");
+    }
+    snprintf(summary + len, cap - len, "]");
+    return summary;
+}
+
+/*
+ * Replace history messages [0..n) with `text` (the model's summary,
+ * or NULL for the extractive fallback) and log it to recall memory.
+ */
+static void compact_apply(neuronos_agent_t * agent, size_t n, const char * text) {
+    if (n == 0 || n > agent->conv_len)
+        return;
+
+    char * summary = NULL;
+    if (text) {
+        /* The chat prompt asks for JSON; accept a {"reply": ...} summary */
+        char * reply = nj_alloc_str(text, "reply");
+        if (reply) {
+            summary = nj_unescape(reply);
+            free(reply);
+        } else {
+            summary = strdup(text);
+        }
+    } else {
+        summary = compact_conv_summary(agent, n);
+    }
+    if (!summary)
+        return;
+
+    if (agent->memory) {
+        int64_t last = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (agent->conv_recall_ids[i] > 0)
+                last = agent->conv_recall_ids[i];
+        }
+        neuronos_memory_recall_add_summary(agent->memory, agent->session_id, summary,
+                                           estimate_tokens(summary), last);
+    }
+
+    int before = chat_tokens(agent);
+    for (size_t i = 0; i < n; i++) {
+        free(agent->conv_roles[i]);
+        free(agent->conv_contents[i]);
+    }
+    size_t rest = agent->conv_len - n;
+    memmove(agent->conv_roles, agent->conv_roles + n, rest * sizeof(char *));
+    memmove(agent->conv_contents, agent->conv_contents + n, rest * sizeof(char *));
+    memmove(agent->conv_recall_ids, agent->conv_recall_ids + n, rest * sizeof(int64_t));
+    agent->conv_len = rest;
+
+    free(agent->conv_summary);
+    agent->conv_summary = summary;
+    free(agent->chat_system); /* stale: it carries the old summary */
+    agent->chat_system = NULL;
+
+    if (agent->params.verbose) {
+        fprintf(stderr, "[neuronos] Context compaction: %zu messages -> %s summary (~%d -> ~%d tokens)\n", n,
+                text ? "model" : "extractive", before, chat_tokens(agent));
+    }
+}
+
+static bool compact_job_cancelled(void * data) {
+    return compact_load(&((compact_job_t *)data)->cancel) != 0;
+}
+
+static void compact_job_run(compact_job_t * job) {
+    neuronos_gen_params_t gen_params = {
+        .prompt = job->prompt,
+        .max_tokens = job->max_tokens,
+        .temperature = 0.0f, /* greedy */
+        .top_p = 0.95f,
+        .top_k = 40,
+        .user_data = job,
+        .is_cancelled = compact_job_cancelled,
+        .scratch_seq = true,
+    };
+    neuronos_gen_result_t gen = neuronos_generate(job->model, gen_params);
+    if (gen.status == NEURONOS_OK && gen.text && gen.text[0]) {
+        job->summary = gen.text;
+        gen.text = NULL;
+    }
+    neuronos_gen_result_free(&gen);
+    compact_store(&job->done, 1);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI compact_worker(LPVOID arg) {
+    compact_job_run((compact_job_t *)arg);
+    return 0;
+}
+#else
+static void * compact_worker(void * arg) {
+    compact_job_run((compact_job_t *)arg);
+    return NULL;
+}
+#endif
+
+/*
+ * Summarize all but the last `keep` exchanges. The prompt repeats the
+ * last chat prompt's system message and history, so the generation
+ * forks from the prefix already in the KV cache. With background the
+ * summary runs on its own thread; otherwise it is done on return.
+ * Returns false if there is nothing to compact or it could not start.
+ */
+static bool compact_start(neuronos_agent_t * agent, int keep, bool background) {
+    if (agent->compact_job)
+        return true;
+    size_t n = compact_split(agent, keep);
+    if (n == 0)
+        return false;
+
+    compact_job_t * job = calloc(1, sizeof(compact_job_t));
+    neuronos_chat_msg_t * msgs = calloc(n + 2, sizeof(neuronos_chat_msg_t));
+    const char * current = chat_system_current(agent);
+    char * system = current ? strdup(current) : NULL;
+    if (!job || !msgs || !system) {
+        free(job);
+        free(msgs);
+        free(system);
+        return false;
+    }
+
+    char instruction[sizeof(COMPACT_INSTRUCTION) + 16];
+    snprintf(instruction, sizeof(instruction), COMPACT_INSTRUCTION, agent->compact.max_summary_tokens * 3 / 4);
+    msgs[0].role = "system";
+    msgs[0].content = system;
+    for (size_t i = 0; i < n; i++) {
+        msgs[i + 1].role = agent->conv_roles[i];
+        msgs[i + 1].content = agent->conv_contents[i];
+    }
+    msgs[n + 1].role = "user";
+    msgs[n + 1].content = instruction;
+
+    neuronos_status_t st = neuronos_chat_format(agent->model, NULL, msgs, n + 2, true, &job->prompt);
+    free(msgs);
+    free(system);
+    if (st != NEURONOS_OK || !job->prompt) {
+        neuronos_free(job->prompt);
+        free(job);
+        return false;
+    }
+
+    job->model = agent->model;
+    job->max_tokens = agent->compact.max_summary_tokens;
+    job->n_msgs = n;
+    agent->compact_job = job;
+
+    if (!background) {
+        compact_job_run(job);
+        return true;
+    }
+#ifdef _WIN32
+    job->thread = CreateThread(NULL, 0, compact_worker, job, 0, NULL);
+    job->threaded = job->thread != NULL;
+#else
+    job->threaded = pthread_create(&job->thread, NULL, compact_worker, job) == 0;
+#endif
+    if (!job->threaded) {
+        agent->compact_job = NULL;
+        neuronos_free(job->prompt);
+        free(job);
+        return false;
+    }
+    if (agent->params.verbose) {
+        fprintf(stderr, "[neuronos] Context at %.0f%% of budget, summarizing %zu messages in the background\n",
+                chat_usage(agent) * 100.0f, n);
+    }
+    return true;
+}
+
+/*
+ * Finish the compaction in flight, if any. Unless wait is set, a
+ * summary still being generated is cancelled. With apply, a finished
+ * summary replaces the messages it covers; if the model failed (not
+ * cancelled) an extractive summary is used instead.
+ */
+static void compact_join(neuronos_agent_t * agent, bool wait, bool apply) {
+    compact_job_t * job = agent->compact_job;
+    if (!job)
+        return;
+    if (!wait && !compact_load(&job->done))
+        compact_store(&job->cancel, 1);
+    if (job->threaded) {
+#ifdef _WIN32
+        WaitForSingleObject(job->thread, INFINITE);
+        CloseHandle(job->thread);
+#else
+        pthread_join(job->thread, NULL);
+#endif
+    }
+    agent->compact_job = NULL;
+
+    if (apply && (job->summary || !compact_load(&job->cancel)))
+        compact_apply(agent, job->n_msgs, job->summary);
+    else if (agent->params.verbose)
+        fprintf(stderr, "[neuronos] Background compaction cancelled\n");
+
+    free(job->summary);
+    neuronos_free(job->prompt);
+    free(job);
+}
+
+void neuronos_agent_set_compact(neuronos_agent_t * agent, neuronos_compact_params_t params) {
+    if (!agent) return;
+    if (params.trigger_ratio > 0.0f)
+        agent->compact.trigger_ratio = params.trigger_ratio;
+    if (params.retention_window > 0)
+        agent->compact.retention_window = params.retention_window;
+    if (params.max_summary_tokens > 0)
+        agent->compact.max_summary_tokens = params.max_summary_tokens;
+    agent->compact.auto_compact = params.auto_compact;
+}
+
+int neuronos_context_compact(neuronos_agent_t * agent) {
+    if (!agent)
+        return NEURONOS_ERROR_INVALID_PARAM;
+    int before = chat_tokens(agent);
+    if (!agent->compact_job && !compact_start(agent, agent->compact.retention_window, false))
+        return 0;
+    compact_join(agent, true, true);
+    int freed = before - chat_tokens(agent);
+    return freed > 0 ? freed : 0;
+}
+
+void neuronos_context_compact_wait(neuronos_agent_t * agent, bool cancel) {
+    if (agent)
+        compact_join(agent, !cancel, true);
+}
+
+neuronos_status_t neuronos_agent_warm_cache(neuronos_agent_t * agent, const char * cache_dir) {
+    if (!agent)
+        return NEURONOS_ERROR_INVALID_PARAM;
+    compact_join(agent, false, true);
+
+    /* Same system message agent_chat() starts every prompt with */
+    const char * system = chat_system_current(agent);
+    if (!system)
+        return NEURONOS_ERROR_MEMORY;
+
+    neuronos_chat_msg_t sys = {.role = "system", .content = system};
+    char * prefix = NULL;
+    neuronos_status_t st = neuronos_chat_format(agent->model, NULL, &sys, 1, false, &prefix);
+    if (st != NEURONOS_OK || !prefix)
+        return st != NEURONOS_OK ? st : NEURONOS_ERROR_GENERATE;
+
+    double t0 = get_time_ms();
+    st = neuronos_session_warm(agent->model, prefix, cache_dir);
+    neuronos_free(prefix);
+
+    if (agent->params.verbose) {
+        fprintf(stderr, "[neuronos] System prompt warm-up: %s in %.1f ms\n",
+                st == NEURONOS_OK ? "ok" : "failed", get_time_ms() - t0);
+    }
+    return st;
 }
 
 /* JSON unescape: use nj_unescape() from neuronos_json.h */
@@ -984,19 +1740,34 @@ neuronos_agent_result_t neuronos_agent_chat(neuronos_agent_t * agent, const char
         result.status = NEURONOS_ERROR_INVALID_PARAM;
         return result;
     }
+    agent_select_tools(agent, user_input);
+
+    /* A summary started after the last turn is swapped in if it is done
+     * or the history no longer fits without it; otherwise it is
+     * cancelled so this turn does not wait. Over budget with none
+     * ready, compact here. */
+    bool over_budget = chat_usage(agent) + (float)estimate_tokens(user_input) /
+                                               (float)agent->params.context_budget > 1.0f;
+    if (agent->compact_job) {
+        compact_join(agent, over_budget, true);
+    } else if (over_budget && agent->compact.auto_compact && compact_start(agent, 1, false)) {
+        compact_join(agent, true, true);
+    }
 
     /* Add user message to conversation history */
+    size_t turn_start = agent->conv_len;
     conv_history_push(agent, "user", user_input);
 
-    /* Enrich system prompt with memory if attached */
-    char * enriched_prompt = NULL;
+    /* System message (persona, tools, core memory, summary, stats): the
+     * same bytes as last turn unless one of those changed */
+    const char * system = chat_system_current(agent);
+    char * enriched_prompt = system ? strdup(system) : NULL;
     if (agent->memory) {
-        enriched_prompt = build_memory_enriched_prompt(agent, agent->interactive_prompt);
         /* Log user input to recall memory */
-        neuronos_memory_recall_add(agent->memory, agent->session_id,
-                                   "user", user_input, (int)(strlen(user_input) / 4));
-    } else {
-        enriched_prompt = strdup(agent->interactive_prompt);
+        int64_t id = neuronos_memory_recall_add(agent->memory, agent->session_id,
+                                                "user", user_input, (int)(strlen(user_input) / 4));
+        if (id > 0 && agent->conv_len > turn_start)
+            agent->conv_recall_ids[turn_start] = id;
     }
 
     int max_steps = agent->params.max_steps;
@@ -1018,6 +1789,11 @@ neuronos_agent_result_t neuronos_agent_chat(neuronos_agent_t * agent, const char
     int steps_taken = 0;
 
     for (int step = 0; step < max_steps; step++) {
+        if (agent_cancelled(agent)) {
+            result.status = NEURONOS_ERROR_CANCELLED;
+            break;
+        }
+
         if (agent->params.verbose) {
             fprintf(stderr, "\n[neuronos] ── Turn step %d/%d ──\n", step + 1, max_steps);
         }
@@ -1043,11 +1819,12 @@ neuronos_agent_result_t neuronos_agent_chat(neuronos_agent_t * agent, const char
             .temperature = agent->params.temperature,
             .top_p = 0.95f,
             .top_k = 40,
-            .grammar = INTERACTIVE_GRAMMAR,
+            .grammar = agent->chat_grammar,
             .grammar_root = "root",
             .on_token = NULL,
-            .user_data = NULL,
-            .seed = 0,
+            .user_data = agent->cancel_data,
+            .seed = agent->params.seed,
+            .is_cancelled = agent->cancel,
         };
 
         neuronos_gen_result_t gen = neuronos_generate(agent->model, gen_params);
@@ -1055,7 +1832,7 @@ neuronos_agent_result_t neuronos_agent_chat(neuronos_agent_t * agent, const char
 
         if (gen.status != NEURONOS_OK || !gen.text) {
             neuronos_gen_result_free(&gen);
-            result.status = NEURONOS_ERROR_GENERATE;
+            result.status = gen.status == NEURONOS_ERROR_CANCELLED ? NEURONOS_ERROR_CANCELLED : NEURONOS_ERROR_GENERATE;
             break;
         }
 
@@ -1069,8 +1846,6 @@ neuronos_agent_result_t neuronos_agent_chat(neuronos_agent_t * agent, const char
         char * reply = nj_alloc_str(gen.text, "reply");
         char * thought = nj_alloc_str(gen.text, "thought");
         char * answer = nj_alloc_str(gen.text, "answer");
-        char * action = nj_alloc_str(gen.text, "action");
-        char * args = nj_extract_object(gen.text, "args");
 
         /* ---- Direct reply path (new: conversational response) ---- */
         if (reply) {
@@ -1090,8 +1865,6 @@ neuronos_agent_result_t neuronos_agent_chat(neuronos_agent_t * agent, const char
 
             free(thought);
             free(answer);
-            free(action);
-            free(args);
             neuronos_gen_result_free(&gen);
             goto cleanup;
         }
@@ -1115,47 +1888,15 @@ neuronos_agent_result_t neuronos_agent_chat(neuronos_agent_t * agent, const char
 
             free(reply);
             free(thought);
-            free(action);
-            free(args);
             neuronos_gen_result_free(&gen);
             goto cleanup;
         }
 
-        /* ---- Tool call path ---- */
-        if (action && agent->tools) {
-            step_outputs[step] = strdup(gen.text);
-            step_actions[step] = strdup(action);
-
-            if (on_step) {
-                on_step(step, thought, action, NULL, user_data);
-            }
-
-            if (agent->params.verbose) {
-                fprintf(stderr, "[neuronos] Tool: %s(%s)\n", action, args ? args : "{}");
-            }
-
-            neuronos_tool_result_t tool_result = neuronos_tool_execute(
-                agent->tools, action, args ? args : "{}");
-
-            const char * obs = tool_result.success
-                ? tool_result.output
-                : (tool_result.error ? tool_result.error : "Tool execution failed");
-
-            step_observations[step] = strdup(obs);
-
-            if (on_step) {
-                on_step(step, NULL, action, obs, user_data);
-            }
-
-            if (agent->params.verbose) {
-                fprintf(stderr, "[neuronos] Observation: %.200s%s\n",
-                        obs, strlen(obs) > 200 ? "..." : "");
-            }
-
-            neuronos_tool_result_free(&tool_result);
-        } else {
+        /* ---- Tool call path (one call or a "calls" batch) ---- */
+        step_outputs[step] = strdup(gen.text);
+        if (!agent->tools || !agent_run_tools(agent, gen.text, step, thought, true, on_step, user_data,
+                                              &step_actions[step], &step_observations[step])) {
             /* No reply, no answer, no action — model confused */
-            step_outputs[step] = strdup(gen.text);
             step_observations[step] = strdup(
                 "Error: respond with {\"reply\": \"...\"} to chat, "
                 "or {\"thought\": \"...\", \"action\": \"...\", \"args\": {...}} to use a tool.");
@@ -1165,11 +1906,17 @@ neuronos_agent_result_t neuronos_agent_chat(neuronos_agent_t * agent, const char
         free(reply);
         free(thought);
         free(answer);
-        free(action);
-        free(args);
         neuronos_gen_result_free(&gen);
     }
 
+    /* Cancelled: nobody is waiting for a reply, so forget the turn */
+    if (result.status == NEURONOS_ERROR_CANCELLED) {
+        conv_history_truncate(agent, turn_start);
+        result.steps_taken = steps_taken;
+        result.total_ms = get_time_ms() - t_start;
+        goto cleanup;
+    }
+
     /* Max steps reached without final response */
     if (result.status != NEURONOS_OK) {
         if (steps_taken >= max_steps) {
@@ -1186,10 +1933,20 @@ neuronos_agent_result_t neuronos_agent_chat(neuronos_agent_t * agent, const char
 cleanup:
     /* Log final response to recall memory */
     if (agent->memory && result.text) {
-        neuronos_memory_recall_add(agent->memory, agent->session_id,
-                                   "assistant", result.text, (int)(strlen(result.text) / 4));
+        neuronos_memory_begin(agent->memory);
+        int64_t id = neuronos_memory_recall_add(agent->memory, agent->session_id,
+                                                "assistant", result.text, (int)(strlen(result.text) / 4));
+        if (id > 0 && agent->conv_len > turn_start + 1)
+            agent->conv_recall_ids[agent->conv_len - 1] = id;
         /* Periodic GC: keep last 500 messages, discard older than 7 days */
         neuronos_memory_recall_gc(agent->memory, agent->session_id, 500, 7 * 86400);
+        neuronos_memory_commit(agent->memory);
+    }
+
+    /* The session is idle until the next turn: summarize meanwhile */
+    if (result.status != NEURONOS_ERROR_CANCELLED && agent->compact.auto_compact &&
+        chat_usage(agent) > agent->compact.trigger_ratio) {
+        compact_start(agent, agent->compact.retention_window, true);
     }
 
     /* Free turn-local step history */
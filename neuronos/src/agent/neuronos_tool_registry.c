@@ -5,10 +5,14 @@
  * Phase 2C: tool registration and dispatch.
  * ============================================================ */
 #include "neuronos/neuronos.h"
+#include "neuronos/neuronos_json.h"
 
+#include <math.h>
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <time.h>
 
 #ifdef _WIN32
@@ -16,17 +20,109 @@
 #include <io.h>
 #define popen _popen
 #define pclose _pclose
+typedef HANDLE tool_thread_t;
+typedef SRWLOCK tool_mutex_t;
+#define tool_mutex_init(m) InitializeSRWLock(m)
+#define tool_mutex_destroy(m) ((void)(m))
+#define tool_mutex_lock(m) AcquireSRWLockExclusive(m)
+#define tool_mutex_unlock(m) ReleaseSRWLockExclusive(m)
+typedef CONDITION_VARIABLE tool_cond_t;
+#define tool_cond_init(c) InitializeConditionVariable(c)
+#define tool_cond_destroy(c) ((void)(c))
+#define tool_cond_wait(c, m) SleepConditionVariableSRW((c), (m), INFINITE, 0)
+#define tool_cond_broadcast(c) WakeAllConditionVariable(c)
+#define tool_fetch_add(p) (InterlockedIncrement((volatile LONG *)(p)) - 1)
 #else
 #include <dirent.h>
+#include <pthread.h>
+typedef pthread_t tool_thread_t;
+typedef pthread_mutex_t tool_mutex_t;
+#define tool_mutex_init(m) pthread_mutex_init(m, NULL)
+#define tool_mutex_destroy(m) pthread_mutex_destroy(m)
+#define tool_mutex_lock(m) pthread_mutex_lock(m)
+#define tool_mutex_unlock(m) pthread_mutex_unlock(m)
+typedef pthread_cond_t tool_cond_t;
+#define tool_cond_init(c) pthread_cond_init(c, NULL)
+#define tool_cond_destroy(c) pthread_cond_destroy(c)
+#define tool_cond_wait(c, m) pthread_cond_wait((c), (m))
+#define tool_cond_broadcast(c) pthread_cond_broadcast(c)
+#define tool_fetch_add(p) __atomic_fetch_add((p), 1, __ATOMIC_RELAXED)
 #endif
 
 /* ---- Constants ---- */
-#define NEURONOS_MAX_TOOLS 64
+#define TOOL_INITIAL_CAP 16
+#define TOOL_BATCH_WORKERS 4  /* default concurrent calls per batch */
+#define TOOL_BATCH_MAX_WORKERS 16
+#define TOOL_CACHE_MAX_SHARE 4 /* one entry may use at most 1/4 of the cache */
 
 /* ---- Internal struct ---- */
+
+/* What a cached PATH-policy result was computed from */
+typedef struct {
+    uint64_t dev;
+    uint64_t ino;
+    uint64_t size;
+    int64_t mtime_ns;
+} tool_stamp_t;
+
+typedef struct tool_cache_entry {
+    struct tool_cache_entry * prev; /* LRU list, most recent first */
+    struct tool_cache_entry * next;
+    uint64_t hash;
+    char * key; /* "<tool>\n<canonical args>" */
+    char * output;
+    size_t bytes;
+    double expires_ms;  /* 0 = no TTL */
+    tool_stamp_t stamp; /* CACHE_PATH only */
+} tool_cache_entry_t;
+
+struct tool_batch;
+
+/* Bag of terms of one tool's name + description, for BM25 ranking */
+typedef struct {
+    uint64_t * terms; /* distinct term hashes, ascending */
+    int * tf;         /* occurrences of terms[i]         */
+    int n_terms;
+    int len;          /* total terms (document length)   */
+} tool_doc_t;
+
 struct neuronos_tool_reg {
-    neuronos_tool_desc_t tools[NEURONOS_MAX_TOOLS];
+    neuronos_tool_desc_t * tools; /* registration order */
+    tool_doc_t * docs;            /* docs[i] describes tools[i] */
     int count;
+    int cap;
+
+    /* Name index: open addressing, slot = tool index + 1 (0 = empty) */
+    int * index;
+    int index_cap; /* power of two, > 2 * count */
+
+    /* Document frequency per term, open addressing on the term hash */
+    uint64_t * df_terms;
+    int * df;
+    int df_count;
+    int df_cap;      /* power of two, > 2 * df_count */
+    int64_t doc_len; /* sum of docs[i].len */
+
+    /* Result cache, guarded by cache_mu (batches execute concurrently) */
+    tool_mutex_t cache_mu;
+    tool_cache_entry_t * lru_head;
+    tool_cache_entry_t * lru_tail;
+    int cache_entries;
+    size_t cache_bytes;
+    size_t cache_max; /* 0 = disabled */
+    uint64_t cache_hits;
+    uint64_t cache_misses;
+
+    /* Batch helpers: started on demand, kept until the registry is freed */
+    tool_mutex_t pool_mu;
+    tool_cond_t pool_work;     /* a batch was posted, or pool_stop */
+    tool_cond_t pool_left;     /* a helper finished with its batch */
+    struct tool_batch * queue; /* batches still wanting helpers, FIFO */
+    int pool_wanted;           /* helpers the queued batches still want */
+    int pool_idle;             /* helpers not draining a batch */
+    int pool_n;
+    bool pool_stop;
+    tool_thread_t pool[TOOL_BATCH_MAX_WORKERS];
 };
 
 /* ============================================================
@@ -35,13 +131,222 @@ struct neuronos_tool_reg {
 
 neuronos_tool_registry_t * neuronos_tool_registry_create(void) {
     neuronos_tool_registry_t * reg = calloc(1, sizeof(neuronos_tool_registry_t));
+    if (reg) {
+        tool_mutex_init(&reg->cache_mu);
+        tool_mutex_init(&reg->pool_mu);
+        tool_cond_init(&reg->pool_work);
+        tool_cond_init(&reg->pool_left);
+    }
     return reg;
 }
 
+static void tool_pool_stop(neuronos_tool_registry_t * reg);
+
 void neuronos_tool_registry_free(neuronos_tool_registry_t * reg) {
+    if (!reg)
+        return;
+    tool_pool_stop(reg);
+    neuronos_tool_cache_clear(reg);
+    tool_mutex_destroy(&reg->cache_mu);
+    for (int i = 0; i < reg->count; i++) {
+        free(reg->docs[i].terms);
+        free(reg->docs[i].tf);
+    }
+    free(reg->tools);
+    free(reg->docs);
+    free(reg->index);
+    free(reg->df_terms);
+    free(reg->df);
     free(reg);
 }
 
+static uint64_t tool_hash(const char * s) {
+    uint64_t h = 1469598103934665603ull; /* FNV-1a */
+    for (; *s; s++)
+        h = (h ^ (unsigned char)*s) * 1099511628211ull;
+    return h;
+}
+
+/* ---- Name index ---- */
+
+static int index_slot(const neuronos_tool_registry_t * reg, const char * name) {
+    int mask = reg->index_cap - 1;
+    int slot = (int)(tool_hash(name) & (uint64_t)mask);
+    while (reg->index[slot] && strcmp(reg->tools[reg->index[slot] - 1].name, name) != 0)
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+static const neuronos_tool_desc_t * tool_find(const neuronos_tool_registry_t * reg, const char * name) {
+    if (!name || !reg->index)
+        return NULL;
+    int i = reg->index[index_slot(reg, name)];
+    return i ? &reg->tools[i - 1] : NULL;
+}
+
+/* Rebuild the name index with room for `count` tools */
+static bool index_grow(neuronos_tool_registry_t * reg, int count) {
+    int cap = reg->index_cap ? reg->index_cap : TOOL_INITIAL_CAP * 2;
+    while (cap <= count * 2)
+        cap *= 2;
+    if (cap == reg->index_cap)
+        return true;
+    int * index = calloc((size_t)cap, sizeof(int));
+    if (!index)
+        return false;
+    free(reg->index);
+    reg->index = index;
+    reg->index_cap = cap;
+    for (int i = 0; i < reg->count; i++)
+        reg->index[index_slot(reg, reg->tools[i].name)] = i + 1;
+    return true;
+}
+
+/* ---- Relevance index (BM25 over name + description) ---- */
+
+#define TOOL_BM25_K1 1.2
+#define TOOL_BM25_B  0.75
+
+static bool tool_stopword(const char * w, size_t n) {
+    static const char * const stop[] = {"a",    "an",   "and",  "are", "as",   "at",  "be",   "by",
+                                        "can",  "do",   "for",  "from", "how", "i",   "if",   "in",
+                                        "is",   "it",   "me",   "my",  "of",   "on",  "or",   "please",
+                                        "that", "the",  "this", "to",  "what", "with", "you", "your"};
+    for (size_t i = 0; i < sizeof(stop) / sizeof(stop[0]); i++) {
+        if (strlen(stop[i]) == n && memcmp(stop[i], w, n) == 0)
+            return true;
+    }
+    return false;
+}
+
+/*
+ * Split text into lowercase alphanumeric words ("read_file" -> read,
+ * file), drop stopwords and a plural "s", and store up to max term
+ * hashes in out. Returns the number stored.
+ */
+static int tool_terms(const char * text, uint64_t * out, int max) {
+    int n = 0;
+    char word[64];
+    for (const char * p = text; p && *p && n < max;) {
+        size_t len = 0;
+        while (*p && (((unsigned char)*p >= '0' && (unsigned char)*p <= '9') ||
+                      ((*p | 0x20) >= 'a' && (*p | 0x20) <= 'z'))) {
+            if (len < sizeof(word) - 1)
+                word[len++] = (char)(*p >= 'A' && *p <= 'Z' ? *p | 0x20 : *p);
+            p++;
+        }
+        if (len == 0) {
+            p++;
+            continue;
+        }
+        if (len > 3 && word[len - 1] == 's' && word[len - 2] != 's')
+            len--;
+        if (tool_stopword(word, len))
+            continue;
+        word[len] = '\0';
+        out[n++] = tool_hash(word);
+    }
+    return n;
+}
+
+static int cmp_u64(const void * a, const void * b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static int df_slot(const neuronos_tool_registry_t * reg, uint64_t term) {
+    int mask = reg->df_cap - 1;
+    int slot = (int)(term & (uint64_t)mask);
+    while (reg->df[slot] && reg->df_terms[slot] != term)
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+static int df_get(const neuronos_tool_registry_t * reg, uint64_t term) {
+    return reg->df_cap ? reg->df[df_slot(reg, term)] : 0;
+}
+
+static bool df_add(neuronos_tool_registry_t * reg, const uint64_t * terms, int n) {
+    if ((reg->df_count + n) * 2 >= reg->df_cap) {
+        int cap = reg->df_cap ? reg->df_cap : 256;
+        while ((reg->df_count + n) * 2 >= cap)
+            cap *= 2;
+        uint64_t * keys = calloc((size_t)cap, sizeof(uint64_t));
+        int * vals = calloc((size_t)cap, sizeof(int));
+        if (!keys || !vals) {
+            free(keys);
+            free(vals);
+            return false;
+        }
+        uint64_t * old_keys = reg->df_terms;
+        int * old_vals = reg->df;
+        int old_cap = reg->df_cap;
+        reg->df_terms = keys;
+        reg->df = vals;
+        reg->df_cap = cap;
+        for (int i = 0; i < old_cap; i++) {
+            if (old_vals[i]) {
+                int slot = df_slot(reg, old_keys[i]);
+                reg->df_terms[slot] = old_keys[i];
+                reg->df[slot] = old_vals[i];
+            }
+        }
+        free(old_keys);
+        free(old_vals);
+    }
+    for (int i = 0; i < n; i++) {
+        int slot = df_slot(reg, terms[i]);
+        if (!reg->df[slot]) {
+            reg->df_terms[slot] = terms[i];
+            reg->df_count++;
+        }
+        reg->df[slot]++;
+    }
+    return true;
+}
+
+/* Index a tool: name words count twice, then the description */
+static bool doc_build(neuronos_tool_registry_t * reg, const neuronos_tool_desc_t * desc, tool_doc_t * doc) {
+    memset(doc, 0, sizeof(*doc));
+    const char * text = desc->description ? desc->description : "";
+    int max = (int)(strlen(desc->name) + strlen(text)) / 2 + 2;
+    uint64_t * all = malloc((size_t)max * 2 * sizeof(uint64_t));
+    if (!all)
+        return false;
+    int n = tool_terms(desc->name, all, max);
+    memcpy(all + n, all, (size_t)n * sizeof(uint64_t));
+    n *= 2;
+    n += tool_terms(text, all + n, 2 * max - n);
+    qsort(all, (size_t)n, sizeof(uint64_t), cmp_u64);
+
+    doc->terms = malloc((size_t)(n ? n : 1) * sizeof(uint64_t));
+    doc->tf = malloc((size_t)(n ? n : 1) * sizeof(int));
+    if (!doc->terms || !doc->tf) {
+        free(doc->terms);
+        free(doc->tf);
+        free(all);
+        return false;
+    }
+    for (int i = 0; i < n; i++) {
+        if (doc->n_terms && doc->terms[doc->n_terms - 1] == all[i]) {
+            doc->tf[doc->n_terms - 1]++;
+        } else {
+            doc->terms[doc->n_terms] = all[i];
+            doc->tf[doc->n_terms++] = 1;
+        }
+    }
+    doc->len = n;
+    free(all);
+
+    if (!df_add(reg, doc->terms, doc->n_terms)) {
+        free(doc->terms);
+        free(doc->tf);
+        return false;
+    }
+    reg->doc_len += n;
+    return true;
+}
+
 /* ============================================================
  * REGISTER
  * ============================================================ */
@@ -49,18 +354,28 @@ void neuronos_tool_registry_free(neuronos_tool_registry_t * reg) {
 int neuronos_tool_register(neuronos_tool_registry_t * reg, const neuronos_tool_desc_t * desc) {
     if (!reg || !desc || !desc->name || !desc->execute)
         return -1;
-    if (reg->count >= NEURONOS_MAX_TOOLS)
+    if (tool_find(reg, desc->name))
+        return -1; /* duplicate */
+
+    if (reg->count == reg->cap) {
+        int cap = reg->cap ? reg->cap * 2 : TOOL_INITIAL_CAP;
+        neuronos_tool_desc_t * tools = realloc(reg->tools, (size_t)cap * sizeof(neuronos_tool_desc_t));
+        if (!tools)
+            return -1;
+        reg->tools = tools;
+        tool_doc_t * docs = realloc(reg->docs, (size_t)cap * sizeof(tool_doc_t));
+        if (!docs)
+            return -1;
+        reg->docs = docs;
+        reg->cap = cap;
+    }
+    if (!index_grow(reg, reg->count + 1) || !doc_build(reg, desc, &reg->docs[reg->count]))
         return -1;
 
-    /* Check for duplicate name */
-    for (int i = 0; i < reg->count; i++) {
-        if (strcmp(reg->tools[i].name, desc->name) == 0) {
-            return -1; /* duplicate */
-        }
-    }
-
     reg->tools[reg->count] = *desc;
     reg->count++;
+    reg->index[index_slot(reg, desc->name)] = reg->count;
+    neuronos_sampler_cache_invalidate(); /* tool-call grammars may list tool names */
     return 0;
 }
 
@@ -68,6 +383,220 @@ int neuronos_tool_register(neuronos_tool_registry_t * reg, const neuronos_tool_d
  * EXECUTE
  * ============================================================ */
 
+/* ---- Result cache ---- */
+
+/* Stat the file or directory a PATH-policy call reads */
+static bool tool_stamp(const char * args_json, tool_stamp_t * out) {
+    char * path = nj_alloc_str(args_json, "path");
+    if (!path)
+        path = nj_alloc_str(args_json, "directory");
+    const char * p = path && path[0] ? path : ".";
+
+    memset(out, 0, sizeof(*out));
+#ifdef _WIN32
+    struct _stat64 st;
+    bool ok = _stat64(p, &st) == 0;
+    if (ok)
+        out->mtime_ns = (int64_t)st.st_mtime * 1000000000;
+#else
+    struct stat st;
+    bool ok = stat(p, &st) == 0;
+    if (ok) {
+#if defined(__APPLE__)
+        out->mtime_ns = (int64_t)st.st_mtimespec.tv_sec * 1000000000 + st.st_mtimespec.tv_nsec;
+#elif defined(__linux__)
+        out->mtime_ns = (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+#else
+        out->mtime_ns = (int64_t)st.st_mtime * 1000000000;
+#endif
+    }
+#endif
+    if (ok) {
+        out->dev = (uint64_t)st.st_dev;
+        out->ino = (uint64_t)st.st_ino;
+        out->size = (uint64_t)st.st_size;
+    }
+    free(path);
+    return ok;
+}
+
+static void cache_unlink(neuronos_tool_registry_t * reg, tool_cache_entry_t * e) {
+    if (e->prev)
+        e->prev->next = e->next;
+    else
+        reg->lru_head = e->next;
+    if (e->next)
+        e->next->prev = e->prev;
+    else
+        reg->lru_tail = e->prev;
+    e->prev = e->next = NULL;
+}
+
+static void cache_push_front(neuronos_tool_registry_t * reg, tool_cache_entry_t * e) {
+    e->prev = NULL;
+    e->next = reg->lru_head;
+    if (reg->lru_head)
+        reg->lru_head->prev = e;
+    reg->lru_head = e;
+    if (!reg->lru_tail)
+        reg->lru_tail = e;
+}
+
+static void cache_drop(neuronos_tool_registry_t * reg, tool_cache_entry_t * e) {
+    cache_unlink(reg, e);
+    reg->cache_entries--;
+    reg->cache_bytes -= e->bytes;
+    free(e->key);
+    free(e->output);
+    free(e);
+}
+
+/* Evict LRU entries until `need` more bytes fit. Caller holds cache_mu. */
+static void cache_evict(neuronos_tool_registry_t * reg, size_t need) {
+    while (reg->lru_tail && reg->cache_bytes + need > reg->cache_max)
+        cache_drop(reg, reg->lru_tail);
+}
+
+static tool_cache_entry_t * cache_find(neuronos_tool_registry_t * reg, const char * key, uint64_t hash) {
+    for (tool_cache_entry_t * e = reg->lru_head; e; e = e->next) {
+        if (e->hash == hash && strcmp(e->key, key) == 0)
+            return e;
+    }
+    return NULL;
+}
+
+/*
+ * Cache key for a call, or NULL if the call must run: cache disabled,
+ * tool not cacheable, unparsable args or (CACHE_PATH) nothing to stat.
+ */
+static char * cache_key(neuronos_tool_registry_t * reg, const neuronos_tool_desc_t * t, const char * args_json,
+                        tool_stamp_t * stamp) {
+    tool_mutex_lock(&reg->cache_mu);
+    bool enabled = reg->cache_max > 0;
+    tool_mutex_unlock(&reg->cache_mu);
+    if (!enabled || t->cache == NEURONOS_TOOL_CACHE_NONE)
+        return NULL;
+    if (t->cache == NEURONOS_TOOL_CACHE_PATH && !tool_stamp(args_json, stamp))
+        return NULL;
+
+    char * canon = nj_canonical(args_json);
+    if (!canon)
+        return NULL;
+    size_t len = strlen(t->name) + 1 + strlen(canon) + 1;
+    char * key = malloc(len);
+    if (key)
+        snprintf(key, len, "%s\n%s", t->name, canon);
+    free(canon);
+    return key;
+}
+
+static bool cache_get(neuronos_tool_registry_t * reg, const neuronos_tool_desc_t * t, const char * key,
+                      const tool_stamp_t * stamp, neuronos_tool_result_t * out) {
+    uint64_t hash = tool_hash(key);
+    bool hit = false;
+
+    tool_mutex_lock(&reg->cache_mu);
+    tool_cache_entry_t * e = cache_find(reg, key, hash);
+    if (e) {
+        bool stale = (e->expires_ms > 0 && neuronos_metrics_now_ms() >= e->expires_ms) ||
+                     (t->cache == NEURONOS_TOOL_CACHE_PATH && memcmp(&e->stamp, stamp, sizeof(*stamp)) != 0);
+        if (stale) {
+            cache_drop(reg, e);
+        } else {
+            out->output = strdup(e->output);
+            out->success = out->output != NULL;
+            hit = out->success;
+            if (hit) {
+                cache_unlink(reg, e);
+                cache_push_front(reg, e);
+            }
+        }
+    }
+    if (hit)
+        reg->cache_hits++;
+    else
+        reg->cache_misses++;
+    tool_mutex_unlock(&reg->cache_mu);
+
+    neuronos_metrics_add(hit ? NEURONOS_COUNTER_TOOL_CACHE_HITS : NEURONOS_COUNTER_TOOL_CACHE_MISSES, 1);
+    return hit;
+}
+
+/* Store a successful result; takes ownership of key */
+static void cache_put(neuronos_tool_registry_t * reg, const neuronos_tool_desc_t * t, char * key,
+                      const tool_stamp_t * stamp, const char * output) {
+    size_t out_len = strlen(output);
+    size_t bytes = sizeof(tool_cache_entry_t) + strlen(key) + 1 + out_len + 1;
+    uint64_t hash = tool_hash(key);
+
+    tool_mutex_lock(&reg->cache_mu);
+    if (bytes > reg->cache_max / TOOL_CACHE_MAX_SHARE) {
+        tool_mutex_unlock(&reg->cache_mu);
+        free(key);
+        return;
+    }
+    tool_cache_entry_t * old = cache_find(reg, key, hash); /* raced with another worker */
+    if (old)
+        cache_drop(reg, old);
+    cache_evict(reg, bytes);
+
+    tool_cache_entry_t * e = calloc(1, sizeof(*e));
+    char * copy = malloc(out_len + 1);
+    if (!e || !copy) {
+        tool_mutex_unlock(&reg->cache_mu);
+        free(e);
+        free(copy);
+        free(key);
+        return;
+    }
+    memcpy(copy, output, out_len + 1);
+    e->hash = hash;
+    e->key = key;
+    e->output = copy;
+    e->bytes = bytes;
+    e->expires_ms = t->cache_ttl_s > 0 ? neuronos_metrics_now_ms() + t->cache_ttl_s * 1000.0 : 0;
+    if (t->cache == NEURONOS_TOOL_CACHE_PATH)
+        e->stamp = *stamp;
+    cache_push_front(reg, e);
+    reg->cache_entries++;
+    reg->cache_bytes += bytes;
+    tool_mutex_unlock(&reg->cache_mu);
+}
+
+void neuronos_tool_cache_enable(neuronos_tool_registry_t * reg, size_t max_bytes) {
+    if (!reg)
+        return;
+    tool_mutex_lock(&reg->cache_mu);
+    reg->cache_max = max_bytes;
+    cache_evict(reg, 0);
+    tool_mutex_unlock(&reg->cache_mu);
+}
+
+void neuronos_tool_cache_clear(neuronos_tool_registry_t * reg) {
+    if (!reg)
+        return;
+    tool_mutex_lock(&reg->cache_mu);
+    while (reg->lru_head)
+        cache_drop(reg, reg->lru_head);
+    tool_mutex_unlock(&reg->cache_mu);
+}
+
+neuronos_tool_cache_stats_t neuronos_tool_cache_stats(neuronos_tool_registry_t * reg) {
+    neuronos_tool_cache_stats_t st = {0};
+    if (!reg)
+        return st;
+    tool_mutex_lock(&reg->cache_mu);
+    st.hits = reg->cache_hits;
+    st.misses = reg->cache_misses;
+    st.entries = reg->cache_entries;
+    st.bytes = reg->cache_bytes;
+    st.max_bytes = reg->cache_max;
+    tool_mutex_unlock(&reg->cache_mu);
+    return st;
+}
+
+/* ---- Dispatch ---- */
+
 neuronos_tool_result_t neuronos_tool_execute(neuronos_tool_registry_t * reg, const char * tool_name,
                                              const char * args_json) {
     neuronos_tool_result_t result = {0};
@@ -78,18 +607,203 @@ neuronos_tool_result_t neuronos_tool_execute(neuronos_tool_registry_t * reg, con
         return result;
     }
 
-    /* Find tool */
-    for (int i = 0; i < reg->count; i++) {
-        if (strcmp(reg->tools[i].name, tool_name) == 0) {
-            return reg->tools[i].execute(args_json ? args_json : "{}", reg->tools[i].user_data);
-        }
+    const neuronos_tool_desc_t * t = tool_find(reg, tool_name);
+    if (!t) {
+        result.success = false;
+        result.error = strdup("Tool not found");
+        return result;
     }
+    const char * args = args_json ? args_json : "{}";
 
-    result.success = false;
-    result.error = strdup("Tool not found");
+    /* The stamp is taken before the tool runs, so a file that changes
+     * while it is being read never matches a later lookup */
+    tool_stamp_t stamp;
+    char * key = cache_key(reg, t, args, &stamp);
+    if (key && cache_get(reg, t, key, &stamp, &result)) {
+        free(key);
+        return result;
+    }
+
+    double t0 = neuronos_metrics_now_ms();
+    result = t->execute(args, t->user_data);
+    neuronos_metrics_record_label(NEURONOS_METRIC_TOOL, tool_name, neuronos_metrics_now_ms() - t0);
+    if (!result.success)
+        neuronos_metrics_add(NEURONOS_COUNTER_TOOL_ERRORS, 1);
+
+    if (key && result.success && result.output)
+        cache_put(reg, t, key, &stamp, result.output);
+    else
+        free(key);
     return result;
 }
 
+/* ---- Batch execution ---- */
+
+/* Batches are drained by the caller plus helpers from the registry's
+ * pool. Helpers only speed a batch up: the caller keeps draining until
+ * the cursor runs out, so a batch finishes even when no helper is free
+ * (or a tool itself runs a nested batch). */
+typedef struct tool_batch {
+    neuronos_tool_registry_t * reg;
+    const neuronos_tool_call_t * calls;
+    neuronos_tool_result_t * results;
+    const int * order; /* indices of the thread-safe calls */
+    int n_order;
+    int next;          /* shared cursor into order[] */
+
+    /* Guarded by reg->pool_mu */
+    int helpers;       /* helpers still wanted (> 0 while queued) */
+    int active;        /* helpers draining it right now */
+    struct tool_batch * next_batch;
+} tool_batch_t;
+
+static void tool_batch_drain(tool_batch_t * b) {
+    int k;
+    while ((k = (int)tool_fetch_add(&b->next)) < b->n_order) {
+        const neuronos_tool_call_t * c = &b->calls[b->order[k]];
+        b->results[b->order[k]] = neuronos_tool_execute(b->reg, c->name, c->args_json);
+    }
+}
+
+static void tool_pool_loop(neuronos_tool_registry_t * reg) {
+    tool_mutex_lock(&reg->pool_mu);
+    for (;;) {
+        while (!reg->pool_stop && !reg->queue)
+            tool_cond_wait(&reg->pool_work, &reg->pool_mu);
+        if (reg->pool_stop)
+            break;
+        tool_batch_t * b = reg->queue;
+        if (--b->helpers == 0)
+            reg->queue = b->next_batch;
+        reg->pool_wanted--;
+        reg->pool_idle--;
+        b->active++;
+        tool_mutex_unlock(&reg->pool_mu);
+
+        tool_batch_drain(b);
+
+        tool_mutex_lock(&reg->pool_mu);
+        reg->pool_idle++;
+        if (--b->active == 0)
+            tool_cond_broadcast(&reg->pool_left);
+    }
+    tool_mutex_unlock(&reg->pool_mu);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI tool_pool_worker(LPVOID arg) {
+    tool_pool_loop((neuronos_tool_registry_t *)arg);
+    return 0;
+}
+#else
+static void * tool_pool_worker(void * arg) {
+    tool_pool_loop((neuronos_tool_registry_t *)arg);
+    return NULL;
+}
+#endif
+
+/* Queue b for n_helpers pool threads, starting threads while the idle
+ * ones can't cover what the queue wants. Called with pool_mu held. */
+static void tool_pool_post(neuronos_tool_registry_t * reg, tool_batch_t * b, int n_helpers) {
+    b->helpers = n_helpers;
+    tool_batch_t ** tail = &reg->queue;
+    while (*tail)
+        tail = &(*tail)->next_batch;
+    *tail = b;
+    reg->pool_wanted += n_helpers;
+
+    while (reg->pool_idle < reg->pool_wanted && reg->pool_n < TOOL_BATCH_MAX_WORKERS) {
+#ifdef _WIN32
+        reg->pool[reg->pool_n] = CreateThread(NULL, 0, tool_pool_worker, reg, 0, NULL);
+        if (!reg->pool[reg->pool_n])
+            break;
+#else
+        if (pthread_create(&reg->pool[reg->pool_n], NULL, tool_pool_worker, reg) != 0)
+            break;
+#endif
+        reg->pool_n++;
+        reg->pool_idle++;
+    }
+    tool_cond_broadcast(&reg->pool_work);
+}
+
+/* Withdraw b from the queue and wait until no helper touches it. */
+static void tool_pool_finish(neuronos_tool_registry_t * reg, tool_batch_t * b) {
+    if (b->helpers > 0) {
+        tool_batch_t ** p = &reg->queue;
+        while (*p != b)
+            p = &(*p)->next_batch;
+        *p = b->next_batch;
+        reg->pool_wanted -= b->helpers;
+        b->helpers = 0;
+    }
+    while (b->active > 0)
+        tool_cond_wait(&reg->pool_left, &reg->pool_mu);
+}
+
+static void tool_pool_stop(neuronos_tool_registry_t * reg) {
+    tool_mutex_lock(&reg->pool_mu);
+    reg->pool_stop = true;
+    tool_cond_broadcast(&reg->pool_work);
+    tool_mutex_unlock(&reg->pool_mu);
+    for (int i = 0; i < reg->pool_n; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(reg->pool[i], INFINITE);
+        CloseHandle(reg->pool[i]);
+#else
+        pthread_join(reg->pool[i], NULL);
+#endif
+    }
+    reg->pool_n = 0;
+    tool_cond_destroy(&reg->pool_work);
+    tool_cond_destroy(&reg->pool_left);
+    tool_mutex_destroy(&reg->pool_mu);
+}
+
+void neuronos_tool_execute_batch(neuronos_tool_registry_t * reg, const neuronos_tool_call_t * calls, int n,
+                                 neuronos_tool_result_t * results, int max_workers) {
+    if (!calls || !results || n <= 0)
+        return;
+
+    int * order = reg ? malloc((size_t)n * sizeof(int)) : NULL;
+    tool_batch_t b = {.reg = reg, .calls = calls, .results = results, .order = order};
+    if (order) {
+        for (int i = 0; i < n; i++) {
+            const neuronos_tool_desc_t * t = tool_find(reg, calls[i].name);
+            if (t && t->thread_safe)
+                order[b.n_order++] = i;
+        }
+    }
+
+    /* Thread-safe calls: the caller drains alongside n_helpers pool threads */
+    if (max_workers <= 0)
+        max_workers = TOOL_BATCH_WORKERS;
+    if (max_workers > TOOL_BATCH_MAX_WORKERS)
+        max_workers = TOOL_BATCH_MAX_WORKERS;
+    int n_helpers = (b.n_order < max_workers ? b.n_order : max_workers) - 1;
+    if (n_helpers > 0) {
+        tool_mutex_lock(&reg->pool_mu);
+        tool_pool_post(reg, &b, n_helpers);
+        tool_mutex_unlock(&reg->pool_mu);
+    }
+    tool_batch_drain(&b);
+    if (n_helpers > 0) {
+        tool_mutex_lock(&reg->pool_mu);
+        tool_pool_finish(reg, &b);
+        tool_mutex_unlock(&reg->pool_mu);
+    }
+
+    /* Everything else, in call order, on this thread */
+    for (int i = 0, k = 0; i < n; i++) {
+        if (k < b.n_order && order[k] == i) {
+            k++;
+            continue;
+        }
+        results[i] = neuronos_tool_execute(reg, calls[i].name, calls[i].args_json);
+    }
+    free(order);
+}
+
 void neuronos_tool_result_free(neuronos_tool_result_t * result) {
     if (!result)
         return;
@@ -125,72 +839,189 @@ const char * neuronos_tool_schema(const neuronos_tool_registry_t * reg, int inde
     return reg->tools[index].args_schema_json;
 }
 
+bool neuronos_tool_thread_safe(const neuronos_tool_registry_t * reg, const char * name) {
+    if (!reg)
+        return false;
+    const neuronos_tool_desc_t * t = tool_find(reg, name);
+    return t && t->thread_safe;
+}
+
+/* ============================================================
+ * RELEVANCE RANKING
+ * ============================================================ */
+
+int neuronos_tool_select(const neuronos_tool_registry_t * reg, const char * query, int k, int * out_idx) {
+    if (!reg || !query || k <= 0 || !out_idx || reg->count == 0)
+        return 0;
+
+    int max_q = (int)strlen(query) / 2 + 1;
+    uint64_t * q = malloc((size_t)max_q * sizeof(uint64_t));
+    double * best = malloc((size_t)k * sizeof(double));
+    if (!q || !best) {
+        free(q);
+        free(best);
+        return 0;
+    }
+    int nq = tool_terms(query, q, max_q);
+    qsort(q, (size_t)nq, sizeof(uint64_t), cmp_u64);
+
+    /* idf per distinct query term (repeats in the query count once) */
+    double n_docs = (double)reg->count;
+    double avg_len = reg->doc_len > 0 ? (double)reg->doc_len / n_docs : 1.0;
+    int n = 0;
+    for (int i = 0; i < reg->count; i++) {
+        const tool_doc_t * d = &reg->docs[i];
+        double score = 0.0;
+        for (int j = 0; j < nq; j++) {
+            if (j > 0 && q[j] == q[j - 1])
+                continue;
+            const uint64_t * hit = bsearch(&q[j], d->terms, (size_t)d->n_terms, sizeof(uint64_t), cmp_u64);
+            if (!hit)
+                continue;
+            double tf = (double)d->tf[hit - d->terms];
+            double df = (double)df_get(reg, q[j]);
+            double idf = log(1.0 + (n_docs - df + 0.5) / (df + 0.5));
+            score += idf * tf * (TOOL_BM25_K1 + 1.0) /
+                     (tf + TOOL_BM25_K1 * (1.0 - TOOL_BM25_B + TOOL_BM25_B * (double)d->len / avg_len));
+        }
+        if (score <= 0.0 || (n == k && score <= best[k - 1]))
+            continue;
+
+        /* Insert into the top-k, best first; ties keep registration order */
+        int pos = n < k ? n++ : k - 1;
+        while (pos > 0 && best[pos - 1] < score) {
+            best[pos] = best[pos - 1];
+            out_idx[pos] = out_idx[pos - 1];
+            pos--;
+        }
+        best[pos] = score;
+        out_idx[pos] = i;
+    }
+
+    free(q);
+    free(best);
+    return n;
+}
+
 /* ============================================================
  * GBNF GRAMMAR GENERATION
  * ============================================================ */
 
+/* Append printf output to a growable buffer. Returns false on OOM. */
+static bool buf_appendf(char ** buf, size_t * len, size_t * cap, const char * fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(NULL, 0, fmt, ap);
+    va_end(ap);
+    if (n < 0)
+        return false;
+    if (*len + (size_t)n + 1 > *cap) {
+        size_t new_cap = *cap * 2 > *len + (size_t)n + 1 ? *cap * 2 : *len + (size_t)n + 1;
+        char * tmp = realloc(*buf, new_cap);
+        if (!tmp)
+            return false;
+        *buf = tmp;
+        *cap = new_cap;
+    }
+    va_start(ap, fmt);
+    vsnprintf(*buf + *len, *cap - *len, fmt, ap);
+    va_end(ap);
+    *len += (size_t)n;
+    return true;
+}
+
 /*
  * Generate GBNF rule for tool names:
  *   tool-name ::= "\"shell\"" | "\"read_file\"" | ...
+ * Covers tools idx[0..n), or all tools when idx is NULL. Names that
+ * cannot appear in a GBNF literal as-is are left out.
  */
-char * neuronos_tool_grammar_names(const neuronos_tool_registry_t * reg) {
-    if (!reg || reg->count == 0)
-        return strdup("tool-name ::= \"\\\"noop\\\"\"");
-
-    /* Estimate buffer size: each tool adds ~30 chars */
-    size_t cap = 256 + (size_t)reg->count * 40;
-    char * buf = malloc(cap);
-    if (!buf)
+char * neuronos_tool_grammar_names_subset(const neuronos_tool_registry_t * reg, const int * idx, int n) {
+    if (!reg)
         return NULL;
+    if (!idx)
+        n = reg->count;
 
+    size_t cap = 256 + (size_t)n * 40;
     size_t len = 0;
-    len += (size_t)snprintf(buf + len, cap - len, "tool-name ::= ");
+    char * buf = malloc(cap);
+    if (!buf || !buf_appendf(&buf, &len, &cap, "tool-name ::= ")) {
+        free(buf);
+        return NULL;
+    }
 
-    for (int i = 0; i < reg->count; i++) {
-        if (i > 0) {
-            len += (size_t)snprintf(buf + len, cap - len, " | ");
+    int listed = 0;
+    for (int i = 0; i < n; i++) {
+        int t = idx ? idx[i] : i;
+        if (t < 0 || t >= reg->count || strpbrk(reg->tools[t].name, "\"\\\n"))
+            continue;
+        if (!buf_appendf(&buf, &len, &cap, "%s\"\\\"%s\\\"\"", listed++ ? " | " : "", reg->tools[t].name)) {
+            free(buf);
+            return NULL;
         }
-        len += (size_t)snprintf(buf + len, cap - len, "\"\\\"");
-        len += (size_t)snprintf(buf + len, cap - len, "%s", reg->tools[i].name);
-        len += (size_t)snprintf(buf + len, cap - len, "\\\"\"");
     }
-
+    if (listed == 0 && !buf_appendf(&buf, &len, &cap, "\"\\\"noop\\\"\"")) {
+        free(buf);
+        return NULL;
+    }
     return buf;
 }
 
+char * neuronos_tool_grammar_names(const neuronos_tool_registry_t * reg) {
+    if (!reg || reg->count == 0)
+        return strdup("tool-name ::= \"\\\"noop\\\"\"");
+    return neuronos_tool_grammar_names_subset(reg, NULL, 0);
+}
+
 /*
  * Generate tool descriptions for the system prompt:
  * Available tools:
  * - shell: Execute a shell command. Args: {"command": "<string>"}
  * - read_file: Read a file. Args: {"path": "<string>"}
  * ...
+ * Covers tools idx[0..n), or all tools when idx is NULL.
  */
-char * neuronos_tool_prompt_description(const neuronos_tool_registry_t * reg) {
-    if (!reg || reg->count == 0) {
+char * neuronos_tool_prompt_description_subset(const neuronos_tool_registry_t * reg, const int * idx, int n) {
+    if (!reg)
+        return NULL;
+    if (!idx)
+        n = reg->count;
+    if (n <= 0)
         return strdup("No tools available.\n");
-    }
 
-    size_t cap = 512 + (size_t)reg->count * 256;
+    size_t cap = 512 + (size_t)n * 256;
+    size_t len = 0;
     char * buf = malloc(cap);
-    if (!buf)
+    if (!buf || !buf_appendf(&buf, &len, &cap, "Available tools:\n")) {
+        free(buf);
         return NULL;
+    }
 
-    size_t len = 0;
-    len += (size_t)snprintf(buf + len, cap - len, "Available tools:\n");
-
-    for (int i = 0; i < reg->count; i++) {
-        len += (size_t)snprintf(buf + len, cap - len, "- %s: %s", reg->tools[i].name,
-                                reg->tools[i].description ? reg->tools[i].description : "No description");
-
-        if (reg->tools[i].args_schema_json) {
-            len += (size_t)snprintf(buf + len, cap - len, " Args schema: %s", reg->tools[i].args_schema_json);
+    for (int i = 0; i < n; i++) {
+        int t = idx ? idx[i] : i;
+        if (t < 0 || t >= reg->count)
+            continue;
+        const neuronos_tool_desc_t * d = &reg->tools[t];
+        bool ok = buf_appendf(&buf, &len, &cap, "- %s: %s", d->name,
+                              d->description ? d->description : "No description");
+        if (ok && d->args_schema_json)
+            ok = buf_appendf(&buf, &len, &cap, " Args schema: %s", d->args_schema_json);
+        if (!ok || !buf_appendf(&buf, &len, &cap, "\n")) {
+            free(buf);
+            return NULL;
         }
-        len += (size_t)snprintf(buf + len, cap - len, "\n");
     }
 
     return buf;
 }
 
+char * neuronos_tool_prompt_description(const neuronos_tool_registry_t * reg) {
+    if (!reg || reg->count == 0) {
+        return strdup("No tools available.\n");
+    }
+    return neuronos_tool_prompt_description_subset(reg, NULL, 0);
+}
+
 /* ============================================================
  * BUILT-IN TOOLS
  * ============================================================ */
@@ -510,9 +1341,14 @@ static neuronos_tool_result_t tool_get_time(const char * args_json, void * user_
     neuronos_tool_result_t result = {0};
 
     time_t now = time(NULL);
-    struct tm * tm_info = localtime(&now);
+    struct tm tm_info;
+#ifdef _WIN32
+    localtime_s(&tm_info, &now);
+#else
+    localtime_r(&now, &tm_info);
+#endif
     char buf[128];
-    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S %Z", tm_info);
+    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S %Z", &tm_info);
 
     result.success = true;
     result.output = strdup(buf);
@@ -1510,6 +2346,8 @@ int neuronos_tool_register_defaults(neuronos_tool_registry_t * reg, uint32_t all
             .execute = tool_read_file,
             .user_data = NULL,
             .required_caps = NEURONOS_CAP_FILESYSTEM,
+            .thread_safe = true,
+            .cache = NEURONOS_TOOL_CACHE_PATH,
         };
         if (neuronos_tool_register(reg, &desc_read) == 0)
             registered++;
@@ -1534,6 +2372,8 @@ int neuronos_tool_register_defaults(neuronos_tool_registry_t * reg, uint32_t all
             .execute = tool_list_dir,
             .user_data = NULL,
             .required_caps = NEURONOS_CAP_FILESYSTEM,
+            .thread_safe = true,
+            .cache = NEURONOS_TOOL_CACHE_PATH,
         };
         if (neuronos_tool_register(reg, &desc_list_dir) == 0)
             registered++;
@@ -1548,6 +2388,9 @@ int neuronos_tool_register_defaults(neuronos_tool_registry_t * reg, uint32_t all
             .execute = tool_search_files,
             .user_data = NULL,
             .required_caps = NEURONOS_CAP_FILESYSTEM,
+            .thread_safe = true,
+            .cache = NEURONOS_TOOL_CACHE_PATH,
+            .cache_ttl_s = 30, /* the mtime only covers the root directory */
         };
         if (neuronos_tool_register(reg, &desc_search) == 0)
             registered++;
@@ -1565,6 +2408,8 @@ int neuronos_tool_register_defaults(neuronos_tool_registry_t * reg, uint32_t all
             .execute = tool_read_pdf,
             .user_data = NULL,
             .required_caps = NEURONOS_CAP_FILESYSTEM,
+            .thread_safe = true,
+            .cache = NEURONOS_TOOL_CACHE_PATH,
         };
         if (neuronos_tool_register(reg, &desc_read_pdf) == 0)
             registered++;
@@ -1579,6 +2424,9 @@ int neuronos_tool_register_defaults(neuronos_tool_registry_t * reg, uint32_t all
             .execute = tool_http_get,
             .user_data = NULL,
             .required_caps = NEURONOS_CAP_NETWORK,
+            .thread_safe = true,
+            .cache = NEURONOS_TOOL_CACHE_TTL,
+            .cache_ttl_s = 60,
         };
         if (neuronos_tool_register(reg, &desc_http) == 0)
             registered++;
@@ -1594,6 +2442,7 @@ int neuronos_tool_register_defaults(neuronos_tool_registry_t * reg, uint32_t all
             .execute = tool_calculate,
             .user_data = NULL,
             .required_caps = 0, /* no special capabilities needed */
+            .thread_safe = true,
         };
         if (neuronos_tool_register(reg, &desc_calc) == 0)
             registered++;
@@ -1607,6 +2456,7 @@ int neuronos_tool_register_defaults(neuronos_tool_registry_t * reg, uint32_t all
             .execute = tool_get_time,
             .user_data = NULL,
             .required_caps = 0,
+            .thread_safe = true,
         };
         if (neuronos_tool_register(reg, &desc_time) == 0)
             registered++;
@@ -0,0 +1,1128 @@
+/* ============================================================
+ * NeuronOS — Benchmark suite (`neuronos bench`)
+ *
+ * Three phases on one loaded model:
+ *   gen    — prefill and decode sweep over prompt lengths; every
+ *            run gets a distinct prompt so nothing is served from
+ *            the KV cache
+ *   agent  — fixed multi-step tasks against deterministic mock
+ *            tools (no filesystem, network or shell access)
+ *   server — the HTTP server in-process, driven by 1..N client
+ *            threads holding multi-turn /v1/chat/completions SSE
+ *            conversations; TTFT/TPOT are taken at the client
+ *
+ * Prompt text comes from a seeded PRNG and sampling is greedy (the
+ * agent samples with a fixed seed), so the token streams repeat run
+ * to run. The report has a fixed key order, one value per line, and
+ * timings rounded to 0.01: a plain `diff` of two builds' reports
+ * shows what moved.
+ * ============================================================ */
+#include "neuronos_bench.h"
+#include "neuronos/neuronos_json.h"
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #include <windows.h>
+    #include <psapi.h>
+typedef SOCKET bench_sock_t;
+typedef HANDLE bench_thread_t;
+    #define BENCH_BAD_SOCK INVALID_SOCKET
+    #define bench_sock_close(s) closesocket(s)
+    #define bench_sleep_ms(ms) Sleep(ms)
+    #define bench_thread_join(t) (WaitForSingleObject((t), INFINITE), CloseHandle(t))
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <pthread.h>
+    #include <sys/resource.h>
+    #include <sys/socket.h>
+    #include <sys/time.h>
+    #include <unistd.h>
+typedef int bench_sock_t;
+typedef pthread_t bench_thread_t;
+    #define BENCH_BAD_SOCK (-1)
+    #define bench_sock_close(s) close(s)
+    #define bench_sleep_ms(ms) usleep((useconds_t)(ms) * 1000)
+    #define bench_thread_join(t) pthread_join((t), NULL)
+#endif
+
+/* ---- Suite definition: changing any of these changes the report ---- */
+#define BENCH_SCHEMA "neuronos-bench/1"
+#define BENCH_SEED 42u
+#define BENCH_REPS 5            /* measured runs per sweep point     */
+#define BENCH_DECODE_TOKENS 64  /* tokens generated per sweep run    */
+#define BENCH_CTX_MARGIN 64     /* headroom kept free in the context */
+static const int BENCH_PROMPT_LENS[] = {128, 512, 2048, 8192};
+#define BENCH_N_LENS ((int)(sizeof(BENCH_PROMPT_LENS) / sizeof(BENCH_PROMPT_LENS[0])))
+
+#define BENCH_AGENT_STEPS 6
+#define BENCH_AGENT_STEP_TOKENS 256
+
+static const int BENCH_CLIENTS[] = {1, 4, 8};
+#define BENCH_N_LEVELS ((int)(sizeof(BENCH_CLIENTS) / sizeof(BENCH_CLIENTS[0])))
+#define BENCH_MAX_CLIENTS 8
+#define BENCH_TURNS 3         /* chat turns per client conversation */
+#define BENCH_REPLY_TOKENS 48 /* max_tokens per chat turn            */
+#define BENCH_SERVER_SLOTS 4
+#define BENCH_SYSTEM_WORDS 160
+#define BENCH_USER_WORDS 24
+
+#define BENCH_SERVER_WAIT_MS 10000 /* server startup */
+#define BENCH_IO_TIMEOUT_S 300     /* per socket read */
+
+/* ============================================================
+ * HELPERS
+ * ============================================================ */
+
+typedef struct {
+    char * s;
+    size_t len;
+    size_t cap;
+} bench_str_t;
+
+static void bench_str_cat(bench_str_t * b, const char * s, size_t n) {
+    if (b->len + n + 1 > b->cap) {
+        size_t cap = b->cap ? b->cap * 2 : 256;
+        while (cap < b->len + n + 1)
+            cap *= 2;
+        char * p = realloc(b->s, cap);
+        if (!p)
+            return;
+        b->s = p;
+        b->cap = cap;
+    }
+    memcpy(b->s + b->len, s, n);
+    b->len += n;
+    b->s[b->len] = '\0';
+}
+
+static void bench_str_printf(bench_str_t * b, const char * fmt, ...) {
+    char buf[256];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    if (n > 0)
+        bench_str_cat(b, buf, (size_t)n < sizeof(buf) ? (size_t)n : sizeof(buf) - 1);
+}
+
+static uint32_t bench_rand(uint32_t * state) {
+    uint32_t x = *state ? *state : BENCH_SEED; /* xorshift32 */
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static const char * const BENCH_WORDS[] = {
+    "the",     "system",  "model",   "river",   "light",   "memory",  "signal",  "garden",  "engine",  "quiet",
+    "number",  "stone",   "window",  "market",  "winter",  "paper",   "circuit", "forest",  "answer",  "bridge",
+    "simple",  "travel",  "energy",  "history", "planet",  "orange",  "mirror",  "silver",  "network", "harbor",
+    "morning", "village", "careful", "distant", "library", "thunder", "measure", "balance", "journey", "pattern",
+    "and",     "of",      "with",    "under",   "before",  "across",  "through", "between",
+};
+#define BENCH_N_WORDS ((int)(sizeof(BENCH_WORDS) / sizeof(BENCH_WORDS[0])))
+
+/* Append n_words pseudo-random words (seeded), a sentence every ~12 */
+static void bench_words(bench_str_t * b, uint32_t seed, int n_words) {
+    uint32_t st = seed;
+    for (int i = 0; i < n_words; i++) {
+        const char * w = BENCH_WORDS[bench_rand(&st) % BENCH_N_WORDS];
+        bench_str_cat(b, w, strlen(w));
+        bench_str_cat(b, (i % 12 == 11 || i == n_words - 1) ? ". " : " ", (i % 12 == 11 || i == n_words - 1) ? 2 : 1);
+    }
+}
+
+static int bench_cmp_double(const void * a, const void * b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* p-quantile of sorted v[0..n), interpolating between samples */
+static double bench_pct(const double * v, int n, double p) {
+    if (n <= 0)
+        return NAN; /* written as null */
+    double pos = p * (double)(n - 1);
+    int i = (int)pos;
+    return i + 1 < n ? v[i] + (v[i + 1] - v[i]) * (pos - (double)i) : v[i];
+}
+
+static double bench_round(double v) {
+    return round(v * 100.0) / 100.0;
+}
+
+static void bench_w_num(nj_writer_t * w, const char * key, double v) {
+    nj_w_key(w, key);
+    nj_w_num(w, bench_round(v));
+}
+
+/* {"p50":..,"p90":..,"p99":..} of v[0..n); sorts v */
+static void bench_w_dist(nj_writer_t * w, const char * key, double * v, int n) {
+    qsort(v, (size_t)n, sizeof(double), bench_cmp_double);
+    nj_w_key(w, key);
+    nj_w_obj(w);
+    bench_w_num(w, "p50", bench_pct(v, n, 0.50));
+    bench_w_num(w, "p90", bench_pct(v, n, 0.90));
+    bench_w_num(w, "p99", bench_pct(v, n, 0.99));
+    nj_w_obj_end(w);
+}
+
+static void bench_w_ratio(nj_writer_t * w, const char * key, double num, double den) {
+    nj_w_key(w, key);
+    nj_w_num(w, den > 0.0 ? round(num / den * 1000.0) / 1000.0 : 0.0);
+}
+
+/* High-water resident set of this process so far */
+static double bench_peak_rss_mb(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return 0.0;
+    return (double)pmc.PeakWorkingSetSize / (1024.0 * 1024.0);
+#else
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0)
+        return 0.0;
+    #ifdef __APPLE__
+    return (double)ru.ru_maxrss / (1024.0 * 1024.0); /* bytes */
+    #else
+    return (double)ru.ru_maxrss / 1024.0; /* KiB */
+    #endif
+#endif
+}
+
+static bool bench_ieq(const char * a, const char * b) {
+    for (; *a && *b; a++, b++) {
+        if ((*a | 0x20) != (*b | 0x20))
+            return false;
+    }
+    return *a == *b;
+}
+
+static bool bench_icontains(const char * hay, const char * needle) {
+    size_t n = strlen(needle);
+    for (; hay && *hay; hay++) {
+        size_t i = 0;
+        while (i < n && hay[i] && (hay[i] | 0x20) == (needle[i] | 0x20))
+            i++;
+        if (i == n)
+            return true;
+    }
+    return false;
+}
+
+static void bench_indent(FILE * out, int depth) {
+    fputc('\n', out);
+    for (int i = 0; i < depth; i++)
+        fputs("  ", out);
+}
+
+/* Write compact JSON one value per line, indented by two spaces */
+static void bench_json_pretty(const char * s, FILE * out) {
+    int depth = 0;
+    bool in_str = false;
+    for (const char * p = s; *p; p++) {
+        char c = *p;
+        if (in_str) {
+            fputc(c, out);
+            if (c == '\\' && p[1])
+                fputc(*++p, out);
+            else if (c == '"')
+                in_str = false;
+            continue;
+        }
+        switch (c) {
+        case '"':
+            in_str = true;
+            fputc(c, out);
+            break;
+        case '{':
+        case '[':
+            fputc(c, out);
+            if (p[1] == (c == '{' ? '}' : ']')) {
+                fputc(*++p, out);
+                break;
+            }
+            bench_indent(out, ++depth);
+            break;
+        case '}':
+        case ']':
+            bench_indent(out, --depth);
+            fputc(c, out);
+            break;
+        case ',':
+            fputc(c, out);
+            bench_indent(out, depth);
+            break;
+        case ':':
+            fputs(": ", out);
+            break;
+        default:
+            fputc(c, out);
+        }
+    }
+    fputc('\n', out);
+}
+
+/* ============================================================
+ * PHASE 1: PREFILL / DECODE SWEEP
+ * ============================================================ */
+
+static bool bench_gen(neuronos_model_t * model, nj_writer_t * w, bool verbose) {
+    int n_ctx = neuronos_model_context_size(model);
+    bool ok = true;
+
+    neuronos_gen_params_t gp = {
+        .max_tokens = BENCH_DECODE_TOKENS,
+        .temperature = 0.0f, /* greedy */
+        .seed = BENCH_SEED,
+    };
+
+    /* Warm-up: page in the weights and build the sampler (not recorded) */
+    gp.prompt = "Warm-up.";
+    gp.max_tokens = 8;
+    neuronos_gen_result_t warm = neuronos_generate(model, gp);
+    neuronos_gen_result_free(&warm);
+    gp.max_tokens = BENCH_DECODE_TOKENS;
+
+    nj_w_key(w, "generation");
+    nj_w_obj(w);
+    nj_w_key(w, "points");
+    nj_w_arr(w);
+
+    for (int l = 0; l < BENCH_N_LENS; l++) {
+        int target = BENCH_PROMPT_LENS[l];
+        nj_w_obj(w);
+        nj_w_key(w, "target_prompt_tokens");
+        nj_w_int(w, target);
+        if (target + BENCH_DECODE_TOKENS + BENCH_CTX_MARGIN > n_ctx) {
+            nj_w_key(w, "skipped");
+            nj_w_str(w, "exceeds context");
+            nj_w_obj_end(w);
+            continue;
+        }
+        fprintf(stderr, "bench: gen %d-token prompts x%d\n", target, BENCH_REPS);
+
+        double ttft[BENCH_REPS], tpot[BENCH_REPS], pp[BENCH_REPS], tg[BENCH_REPS];
+        int n = 0, n_tpot = 0, errors = 0;
+        long long prompt_tokens = 0, reused = 0, generated = 0;
+
+        for (int rep = 0; rep < BENCH_REPS; rep++) {
+            /* The run tag leads the prompt, so no prefix is shared with
+             * the previous run and the whole prompt is evaluated */
+            bench_str_t prompt = {0};
+            bench_str_printf(&prompt, "Run %d-%d. ", target, rep);
+            bench_words(&prompt, BENCH_SEED + (uint32_t)(target * 31 + rep), target * 3 / 4);
+            bench_str_cat(&prompt, "\n\nContinue the text:", 19);
+            if (!prompt.s) {
+                errors++;
+                continue;
+            }
+            gp.prompt = prompt.s;
+
+            neuronos_gen_result_t r = neuronos_generate(model, gp);
+            free(prompt.s);
+            if (r.status != NEURONOS_OK) {
+                errors++;
+                neuronos_gen_result_free(&r);
+                continue;
+            }
+            ttft[n] = r.ttft_ms;
+            pp[n] = r.prefill_tokens_per_s;
+            tg[n] = r.decode_tokens_per_s;
+            n++;
+            if (r.decode_tokens_per_s > 0.0)
+                tpot[n_tpot++] = 1000.0 / r.decode_tokens_per_s;
+            prompt_tokens += r.n_prompt_tokens;
+            reused += r.n_reused_tokens;
+            generated += r.n_tokens;
+            if (verbose)
+                fprintf(stderr, "  run %d: %d prompt tokens, ttft %.1f ms, %.1f tok/s decode\n", rep,
+                        r.n_prompt_tokens, r.ttft_ms, r.decode_tokens_per_s);
+            neuronos_gen_result_free(&r);
+        }
+        if (errors > 0)
+            ok = false;
+
+        nj_w_key(w, "prompt_tokens");
+        nj_w_int(w, n > 0 ? prompt_tokens / n : 0);
+        nj_w_key(w, "generated_tokens");
+        nj_w_int(w, n > 0 ? generated / n : 0);
+        nj_w_key(w, "reused_tokens");
+        nj_w_int(w, reused);
+        nj_w_key(w, "errors");
+        nj_w_int(w, errors);
+        bench_w_dist(w, "ttft_ms", ttft, n);
+        bench_w_dist(w, "tpot_ms", tpot, n_tpot);
+        bench_w_dist(w, "prefill_tokens_per_s", pp, n);
+        bench_w_dist(w, "decode_tokens_per_s", tg, n);
+        nj_w_obj_end(w);
+    }
+    nj_w_arr_end(w);
+
+    bench_w_num(w, "peak_rss_mb", bench_peak_rss_mb());
+    nj_w_obj_end(w);
+    return ok;
+}
+
+/* ============================================================
+ * PHASE 2: AGENT TASKS (mock tools)
+ * ============================================================ */
+
+/* A lookup tool answering from a fixed table, keyed by one argument */
+typedef struct {
+    const char * name;
+    const char * description;
+    const char * schema;
+    const char * arg;
+    const char * const (*rows)[2];
+    int n_rows;
+    int calls; /* tools are not thread_safe: calls run one at a time */
+} bench_mock_t;
+
+static const char * const BENCH_PRICES[][2] = {
+    {"apple", "apple: 3 USD each"},
+    {"bread", "bread: 5 USD per loaf"},
+    {"milk", "milk: 4 USD per liter"},
+    {"coffee", "coffee: 12 USD per bag"},
+};
+
+static const char * const BENCH_WEATHER[][2] = {
+    {"paris", "Paris: 18 C, cloudy"},
+    {"tokyo", "Tokyo: 24 C, sunny"},
+    {"oslo", "Oslo: -3 C, snow"},
+};
+
+static const char * const BENCH_RATES[][2] = {
+    {"eur", "1 USD = 0.92 EUR"},
+    {"jpy", "1 USD = 151 JPY"},
+    {"gbp", "1 USD = 0.79 GBP"},
+};
+
+#define BENCH_ROWS(t) (t), (int)(sizeof(t) / sizeof((t)[0]))
+
+static bench_mock_t g_bench_mocks[] = {
+    {"get_price", "Look up the price of a grocery item in US dollars.",
+     "{\"type\":\"object\",\"properties\":{\"item\":{\"type\":\"string\",\"description\":\"Item name, e.g. milk\"}},"
+     "\"required\":[\"item\"]}",
+     "item", BENCH_ROWS(BENCH_PRICES), 0},
+    {"get_weather", "Get the current weather for a city.",
+     "{\"type\":\"object\",\"properties\":{\"city\":{\"type\":\"string\",\"description\":\"City name, e.g. Paris\"}},"
+     "\"required\":[\"city\"]}",
+     "city", BENCH_ROWS(BENCH_WEATHER), 0},
+    {"get_exchange_rate", "Get the exchange rate from US dollars to another currency.",
+     "{\"type\":\"object\",\"properties\":{\"currency\":{\"type\":\"string\",\"description\":\"ISO code, e.g. EUR\"}},"
+     "\"required\":[\"currency\"]}",
+     "currency", BENCH_ROWS(BENCH_RATES), 0},
+};
+#define BENCH_N_MOCKS ((int)(sizeof(g_bench_mocks) / sizeof(g_bench_mocks[0])))
+
+static const struct {
+    const char * name;
+    const char * prompt;
+    const char * expect; /* must appear in the final answer */
+} BENCH_TASKS[] = {
+    {"price", "How much does a bag of coffee cost?", "12"},
+    {"weather_compare", "Is it warmer in Paris or in Tokyo right now?", "Tokyo"},
+    {"exchange_rate", "How many Japanese yen do I get for one US dollar?", "151"},
+    {"multi_lookup", "What does a loaf of bread cost, and what is the weather in Oslo?", "snow"},
+};
+#define BENCH_N_TASKS ((int)(sizeof(BENCH_TASKS) / sizeof(BENCH_TASKS[0])))
+
+static neuronos_tool_result_t bench_mock_lookup(const char * args_json, void * user_data) {
+    bench_mock_t * mock = (bench_mock_t *)user_data;
+    neuronos_tool_result_t result = {0};
+    mock->calls++;
+
+    char key[64] = "";
+    nj_doc_t doc;
+    if (args_json && nj_parse(&doc, args_json, strlen(args_json)) == 0)
+        nj_str_copy(&doc, nj_get(&doc, 0, mock->arg), key, sizeof(key));
+    nj_doc_free(&doc);
+
+    for (int i = 0; i < mock->n_rows; i++) {
+        if (bench_ieq(key, mock->rows[i][0])) {
+            result.success = true;
+            result.output = strdup(mock->rows[i][1]);
+            return result;
+        }
+    }
+    char msg[128];
+    snprintf(msg, sizeof(msg), "No data for '%s'", key);
+    result.success = false;
+    result.error = strdup(msg);
+    return result;
+}
+
+#define BENCH_MAX_STEP_SAMPLES (BENCH_N_TASKS * BENCH_AGENT_STEPS)
+
+typedef struct {
+    double t_last;
+    double step_ms[BENCH_MAX_STEP_SAMPLES];
+    int n;
+    int steps; /* this task */
+} bench_steps_t;
+
+static void bench_agent_step(int step, const char * thought, const char * action, const char * observation,
+                             void * user_data) {
+    (void)step;
+    (void)thought;
+    (void)action;
+    (void)observation;
+    bench_steps_t * st = (bench_steps_t *)user_data;
+    double now = neuronos_metrics_now_ms();
+    if (st->n < BENCH_MAX_STEP_SAMPLES)
+        st->step_ms[st->n++] = now - st->t_last;
+    st->t_last = now;
+    st->steps++;
+}
+
+static bool bench_agent(neuronos_model_t * model, nj_writer_t * w, bool verbose) {
+    neuronos_tool_registry_t * tools = neuronos_tool_registry_create();
+    if (!tools)
+        return false;
+    for (int i = 0; i < BENCH_N_MOCKS; i++) {
+        bench_mock_t * m = &g_bench_mocks[i];
+        m->calls = 0;
+        neuronos_tool_desc_t desc = {
+            .name = m->name,
+            .description = m->description,
+            .args_schema_json = m->schema,
+            .execute = bench_mock_lookup,
+            .user_data = m,
+            .required_caps = 0,
+        };
+        neuronos_tool_register(tools, &desc);
+    }
+
+    neuronos_agent_params_t ap = {
+        .max_steps = BENCH_AGENT_STEPS,
+        .max_tokens_per_step = BENCH_AGENT_STEP_TOKENS,
+        .seed = BENCH_SEED,
+    };
+    neuronos_agent_t * agent = neuronos_agent_create(model, tools, ap);
+    if (!agent) {
+        neuronos_tool_registry_free(tools);
+        return false;
+    }
+
+    uint64_t prompt0 = neuronos_metrics_counter(NEURONOS_COUNTER_PROMPT_TOKENS);
+    uint64_t reused0 = neuronos_metrics_counter(NEURONOS_COUNTER_REUSED_TOKENS);
+    bench_steps_t st = {0};
+    int total_steps = 0, total_calls = 0, passed = 0, errors = 0;
+    double total_ms = 0.0;
+
+    nj_w_key(w, "agent");
+    nj_w_obj(w);
+    nj_w_key(w, "tasks");
+    nj_w_arr(w);
+    for (int t = 0; t < BENCH_N_TASKS; t++) {
+        fprintf(stderr, "bench: agent task %s\n", BENCH_TASKS[t].name);
+        int calls0 = 0;
+        for (int i = 0; i < BENCH_N_MOCKS; i++)
+            calls0 += g_bench_mocks[i].calls;
+
+        st.steps = 0;
+        st.t_last = neuronos_metrics_now_ms();
+        double t0 = st.t_last;
+        neuronos_agent_result_t r = neuronos_agent_run(agent, BENCH_TASKS[t].prompt, bench_agent_step, &st);
+        double ms = neuronos_metrics_now_ms() - t0;
+
+        int calls = -calls0;
+        for (int i = 0; i < BENCH_N_MOCKS; i++)
+            calls += g_bench_mocks[i].calls;
+        bool ok = r.status == NEURONOS_OK && r.text && bench_icontains(r.text, BENCH_TASKS[t].expect);
+        if (r.status != NEURONOS_OK)
+            errors++;
+        if (verbose)
+            fprintf(stderr, "  %d steps, %d tool calls, %.0f ms: %.120s\n", r.steps_taken, calls, ms,
+                    r.text ? r.text : "(no answer)");
+
+        nj_w_obj(w);
+        nj_w_key(w, "name");
+        nj_w_str(w, BENCH_TASKS[t].name);
+        nj_w_key(w, "steps");
+        nj_w_int(w, r.steps_taken);
+        nj_w_key(w, "tool_calls");
+        nj_w_int(w, calls);
+        nj_w_key(w, "passed");
+        nj_w_bool(w, ok);
+        bench_w_num(w, "ms", ms);
+        nj_w_obj_end(w);
+
+        total_steps += r.steps_taken;
+        total_calls += calls;
+        total_ms += ms;
+        passed += ok;
+        neuronos_agent_result_free(&r);
+    }
+    nj_w_arr_end(w);
+
+    nj_w_key(w, "steps");
+    nj_w_int(w, total_steps);
+    nj_w_key(w, "tool_calls");
+    nj_w_int(w, total_calls);
+    nj_w_key(w, "passed");
+    nj_w_int(w, passed);
+    nj_w_key(w, "errors");
+    nj_w_int(w, errors);
+    bench_w_num(w, "steps_per_s", total_ms > 0.0 ? total_steps / (total_ms / 1000.0) : 0.0);
+    bench_w_dist(w, "step_ms", st.step_ms, st.n);
+    bench_w_ratio(w, "prefix_cache_hit_rate",
+                  (double)(neuronos_metrics_counter(NEURONOS_COUNTER_REUSED_TOKENS) - reused0),
+                  (double)(neuronos_metrics_counter(NEURONOS_COUNTER_PROMPT_TOKENS) - prompt0));
+    bench_w_num(w, "peak_rss_mb", bench_peak_rss_mb());
+    nj_w_obj_end(w);
+
+    neuronos_agent_free(agent);
+    neuronos_tool_registry_free(tools);
+    return errors == 0;
+}
+
+/* ============================================================
+ * PHASE 3: CONCURRENT SSE CLIENTS
+ * ============================================================ */
+
+typedef struct {
+    neuronos_model_t * model;
+    neuronos_server_params_t params;
+    volatile int done;
+    neuronos_status_t status;
+} bench_server_t;
+
+typedef struct {
+    const char * host;
+    int port;
+    const char * system; /* shared by every client */
+    uint32_t seed;       /* this conversation */
+
+    /* Results, one entry per answered turn */
+    double ttft_ms[BENCH_TURNS];
+    double tpot_ms[BENCH_TURNS];
+    int n_ttft;
+    int n_tpot;
+    int requests;
+    int errors;
+    long long prompt_tokens;
+    long long cached_tokens;
+    long long completion_tokens;
+} bench_client_t;
+
+/* One streamed reply as seen by the client */
+typedef struct {
+    bench_str_t text;
+    double ttft_ms;  /* request sent → first content frame */
+    double tpot_ms;  /* first → last content frame per token (-1 = n/a) */
+    long long prompt_tokens;
+    long long cached_tokens;
+    long long completion_tokens;
+} bench_reply_t;
+
+static bench_sock_t bench_connect(const char * host, int port) {
+    bench_sock_t s = socket(AF_INET, SOCK_STREAM, 0);
+    if (s == BENCH_BAD_SOCK)
+        return s;
+
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    if (strcmp(host, "0.0.0.0") == 0 || inet_pton(AF_INET, host, &addr.sin_addr) != 1)
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+#ifdef _WIN32
+    DWORD tv = BENCH_IO_TIMEOUT_S * 1000;
+#else
+    struct timeval tv = {BENCH_IO_TIMEOUT_S, 0};
+#endif
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, (const char *)&tv, sizeof(tv));
+
+    if (connect(s, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        bench_sock_close(s);
+        return BENCH_BAD_SOCK;
+    }
+    return s;
+}
+
+static bool bench_send_all(bench_sock_t s, const char * buf, size_t len) {
+    while (len > 0) {
+        int n = (int)send(s, buf, (int)len, 0);
+        if (n <= 0)
+            return false;
+        buf += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/* Handle one SSE "data:" payload. Returns true at [DONE]. */
+static bool bench_sse_data(const char * data, size_t len, double t0, double * t_first, double * t_last,
+                           bench_reply_t * reply) {
+    if (len == 6 && memcmp(data, "[DONE]", 6) == 0)
+        return true;
+
+    nj_doc_t doc;
+    if (nj_parse(&doc, data, len) != 0) {
+        nj_doc_free(&doc);
+        return false;
+    }
+    int choice = nj_first(&doc, nj_get(&doc, 0, "choices"));
+    int content = nj_get(&doc, nj_get(&doc, choice, "delta"), "content");
+    int clen = 0;
+    if (nj_str(&doc, content, &clen) && clen > 0) {
+        double now = neuronos_metrics_now_ms();
+        if (*t_first < 0.0) {
+            *t_first = now;
+            reply->ttft_ms = now - t0;
+        }
+        *t_last = now;
+        char * text = nj_str_dup(&doc, content);
+        if (text) {
+            bench_str_cat(&reply->text, text, strlen(text));
+            free(text);
+        }
+    }
+
+    int usage = nj_get(&doc, 0, "usage");
+    if (usage >= 0) {
+        reply->prompt_tokens = nj_int(&doc, nj_get(&doc, usage, "prompt_tokens"), 0);
+        reply->completion_tokens = nj_int(&doc, nj_get(&doc, usage, "completion_tokens"), 0);
+        reply->cached_tokens =
+            nj_int(&doc, nj_get(&doc, nj_get(&doc, usage, "prompt_tokens_details"), "cached_tokens"), 0);
+    }
+    nj_doc_free(&doc);
+    return false;
+}
+
+/* POST one streaming chat completion and read the SSE reply.
+ * Frames are coalesced by the server (16 tokens / 50 ms), so TPOT is
+ * the average over the stream after the first content frame. */
+static bool bench_chat_request(const char * host, int port, const char * body, bench_reply_t * reply) {
+    bench_sock_t s = bench_connect(host, port);
+    if (s == BENCH_BAD_SOCK)
+        return false;
+
+    char head[256];
+    int hlen = snprintf(head, sizeof(head),
+                        "POST /v1/chat/completions HTTP/1.1\r\n"
+                        "Host: %s:%d\r\n"
+                        "Content-Type: application/json\r\n"
+                        "Content-Length: %zu\r\n"
+                        "Connection: close\r\n\r\n",
+                        host, port, strlen(body));
+    double t0 = neuronos_metrics_now_ms();
+    if (!bench_send_all(s, head, (size_t)hlen) || !bench_send_all(s, body, strlen(body))) {
+        bench_sock_close(s);
+        return false;
+    }
+
+    bench_str_t in = {0};
+    size_t pos = 0; /* start of the next unparsed event */
+    bool headers = false, ok = false, done = false;
+    double t_first = -1.0, t_last = -1.0;
+    char buf[4096];
+
+    while (!done) {
+        int n = (int)recv(s, buf, sizeof(buf), 0);
+        if (n <= 0)
+            break;
+        bench_str_cat(&in, buf, (size_t)n);
+        if (!in.s)
+            break;
+
+        if (!headers) {
+            char * end = strstr(in.s, "\r\n\r\n");
+            if (!end)
+                continue;
+            headers = true;
+            ok = strncmp(in.s, "HTTP/1.1 200", 12) == 0;
+            if (!ok)
+                break;
+            pos = (size_t)(end - in.s) + 4;
+        }
+
+        char * ev;
+        while (!done && (ev = strstr(in.s + pos, "\n\n")) != NULL) {
+            /* One event: "data: ..." lines */
+            for (char * line = in.s + pos; line < ev;) {
+                char * eol = memchr(line, '\n', (size_t)(ev - line));
+                if (!eol)
+                    eol = ev;
+                if (strncmp(line, "data: ", 6) == 0 &&
+                    bench_sse_data(line + 6, (size_t)(eol - line - 6), t0, &t_first, &t_last, reply))
+                    done = true;
+                line = eol + 1;
+            }
+            pos = (size_t)(ev - in.s) + 2;
+        }
+    }
+    bench_sock_close(s);
+    free(in.s);
+
+    reply->tpot_ms = reply->completion_tokens > 1 && t_last > t_first
+                         ? (t_last - t_first) / (double)(reply->completion_tokens - 1)
+                         : -1.0;
+    return ok && done && t_first >= 0.0;
+}
+
+/* Request body for turn t: shared system prompt, then t answered turns */
+static char * bench_chat_body(const char * system, char * const * users, char * const * replies, int t) {
+    nj_writer_t w = {0};
+    nj_w_obj(&w);
+    nj_w_key(&w, "model");
+    nj_w_str(&w, "neuronos-local");
+    nj_w_key(&w, "messages");
+    nj_w_arr(&w);
+    nj_w_obj(&w);
+    nj_w_key(&w, "role");
+    nj_w_str(&w, "system");
+    nj_w_key(&w, "content");
+    nj_w_str(&w, system);
+    nj_w_obj_end(&w);
+    for (int i = 0; i <= t; i++) {
+        nj_w_obj(&w);
+        nj_w_key(&w, "role");
+        nj_w_str(&w, "user");
+        nj_w_key(&w, "content");
+        nj_w_str(&w, users[i]);
+        nj_w_obj_end(&w);
+        if (i == t)
+            break;
+        nj_w_obj(&w);
+        nj_w_key(&w, "role");
+        nj_w_str(&w, "assistant");
+        nj_w_key(&w, "content");
+        nj_w_str(&w, replies[i]);
+        nj_w_obj_end(&w);
+    }
+    nj_w_arr_end(&w);
+    nj_w_key(&w, "max_tokens");
+    nj_w_int(&w, BENCH_REPLY_TOKENS);
+    nj_w_key(&w, "temperature");
+    nj_w_int(&w, 0);
+    nj_w_key(&w, "stream");
+    nj_w_bool(&w, 1);
+    nj_w_key(&w, "stream_options");
+    nj_w_obj(&w);
+    nj_w_key(&w, "include_usage");
+    nj_w_bool(&w, 1);
+    nj_w_obj_end(&w);
+    nj_w_obj_end(&w);
+    return nj_w_finish(&w);
+}
+
+/* One client: a BENCH_TURNS-turn conversation, resent in full each turn */
+static void bench_client_run(bench_client_t * c) {
+    char * users[BENCH_TURNS] = {0};
+    char * replies[BENCH_TURNS] = {0};
+
+    for (int t = 0; t < BENCH_TURNS; t++) {
+        bench_str_t u = {0};
+        bench_str_printf(&u, "Question %d: ", t + 1);
+        bench_words(&u, c->seed + (uint32_t)t, BENCH_USER_WORDS);
+        bench_str_cat(&u, "What does this describe?", 24);
+        users[t] = u.s;
+
+        char * body = users[t] ? bench_chat_body(c->system, users, replies, t) : NULL;
+        bench_reply_t reply = {0};
+        bool ok = body && bench_chat_request(c->host, c->port, body, &reply);
+        free(body);
+
+        c->requests++;
+        if (!ok) {
+            c->errors++;
+            free(reply.text.s);
+            break; /* the conversation can't continue */
+        }
+        c->ttft_ms[c->n_ttft++] = reply.ttft_ms;
+        if (reply.tpot_ms >= 0.0)
+            c->tpot_ms[c->n_tpot++] = reply.tpot_ms;
+        c->prompt_tokens += reply.prompt_tokens;
+        c->cached_tokens += reply.cached_tokens;
+        c->completion_tokens += reply.completion_tokens;
+        replies[t] = reply.text.s ? reply.text.s : strdup("");
+    }
+    for (int t = 0; t < BENCH_TURNS; t++) {
+        free(users[t]);
+        free(replies[t]);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI bench_client_main(LPVOID arg) {
+    bench_client_run((bench_client_t *)arg);
+    return 0;
+}
+
+static DWORD WINAPI bench_server_main(LPVOID arg) {
+    bench_server_t * srv = (bench_server_t *)arg;
+    srv->status = neuronos_server_start(srv->model, NULL, srv->params);
+    srv->done = 1;
+    return 0;
+}
+#else
+static void * bench_client_main(void * arg) {
+    bench_client_run((bench_client_t *)arg);
+    return NULL;
+}
+
+static void * bench_server_main(void * arg) {
+    bench_server_t * srv = (bench_server_t *)arg;
+    srv->status = neuronos_server_start(srv->model, NULL, srv->params);
+    srv->done = 1;
+    return NULL;
+}
+#endif
+
+static bool bench_thread_start(bench_thread_t * t,
+#ifdef _WIN32
+                               LPTHREAD_START_ROUTINE fn,
+#else
+                               void * (*fn)(void *),
+#endif
+                               void * arg) {
+#ifdef _WIN32
+    *t = CreateThread(NULL, 0, fn, arg, 0, NULL);
+    return *t != NULL;
+#else
+    return pthread_create(t, NULL, fn, arg) == 0;
+#endif
+}
+
+/* Wait until the server accepts connections (or gave up starting) */
+static bool bench_server_ready(const bench_server_t * srv) {
+    for (int waited = 0; waited < BENCH_SERVER_WAIT_MS && !srv->done; waited += 100) {
+        bench_sock_t s = bench_connect(srv->params.host, srv->params.port);
+        if (s != BENCH_BAD_SOCK) {
+            bench_sock_close(s);
+            return true;
+        }
+        bench_sleep_ms(100);
+    }
+    return false;
+}
+
+/* One concurrency level: n clients started together */
+static bool bench_server_level(const bench_server_t * srv, const char * system, int n_clients, nj_writer_t * w,
+                               bool verbose) {
+    fprintf(stderr, "bench: server %d concurrent client%s x%d turns\n", n_clients, n_clients == 1 ? "" : "s",
+            BENCH_TURNS);
+
+    bench_client_t clients[BENCH_MAX_CLIENTS];
+    bench_thread_t threads[BENCH_MAX_CLIENTS];
+    bool started[BENCH_MAX_CLIENTS] = {0};
+    memset(clients, 0, sizeof(clients));
+
+    double t0 = neuronos_metrics_now_ms();
+    for (int i = 0; i < n_clients; i++) {
+        clients[i].host = srv->params.host;
+        clients[i].port = srv->params.port;
+        clients[i].system = system;
+        /* Distinct conversations per level, so no level inherits
+         * another's cached turns (the system prompt stays shared) */
+        clients[i].seed = BENCH_SEED * 7919u + (uint32_t)(n_clients * 101 + i) * 1013u;
+        started[i] = bench_thread_start(&threads[i], bench_client_main, &clients[i]);
+        if (!started[i])
+            clients[i].errors++;
+    }
+    for (int i = 0; i < n_clients; i++) {
+        if (started[i])
+            bench_thread_join(threads[i]);
+    }
+    double wall_ms = neuronos_metrics_now_ms() - t0;
+
+    double ttft[BENCH_MAX_CLIENTS * BENCH_TURNS], tpot[BENCH_MAX_CLIENTS * BENCH_TURNS];
+    int n_ttft = 0, n_tpot = 0, requests = 0, errors = 0;
+    long long prompt_tokens = 0, cached_tokens = 0, completion_tokens = 0;
+    for (int i = 0; i < n_clients; i++) {
+        const bench_client_t * c = &clients[i];
+        memcpy(ttft + n_ttft, c->ttft_ms, (size_t)c->n_ttft * sizeof(double));
+        memcpy(tpot + n_tpot, c->tpot_ms, (size_t)c->n_tpot * sizeof(double));
+        n_ttft += c->n_ttft;
+        n_tpot += c->n_tpot;
+        requests += c->requests;
+        errors += c->errors;
+        prompt_tokens += c->prompt_tokens;
+        cached_tokens += c->cached_tokens;
+        completion_tokens += c->completion_tokens;
+    }
+    if (verbose)
+        fprintf(stderr, "  %d requests, %d errors, %lld completion tokens in %.0f ms\n", requests, errors,
+                completion_tokens, wall_ms);
+
+    nj_w_obj(w);
+    nj_w_key(w, "clients");
+    nj_w_int(w, n_clients);
+    nj_w_key(w, "requests");
+    nj_w_int(w, requests);
+    nj_w_key(w, "errors");
+    nj_w_int(w, errors);
+    bench_w_dist(w, "ttft_ms", ttft, n_ttft);
+    bench_w_dist(w, "tpot_ms", tpot, n_tpot);
+    bench_w_num(w, "requests_per_s", wall_ms > 0.0 ? (requests - errors) / (wall_ms / 1000.0) : 0.0);
+    bench_w_num(w, "tokens_per_s", wall_ms > 0.0 ? (double)completion_tokens / (wall_ms / 1000.0) : 0.0);
+    nj_w_key(w, "prompt_tokens");
+    nj_w_int(w, prompt_tokens);
+    nj_w_key(w, "cached_tokens");
+    nj_w_int(w, cached_tokens);
+    bench_w_ratio(w, "prefix_cache_hit_rate", (double)cached_tokens, (double)prompt_tokens);
+    nj_w_obj_end(w);
+    return errors == 0;
+}
+
+static bool bench_server(neuronos_model_t * model, const char * host, int port, nj_writer_t * w, bool verbose) {
+    bench_server_t srv = {
+        .model = model,
+        .params = {.host = host, .port = port, .n_slots = BENCH_SERVER_SLOTS},
+    };
+
+    nj_w_key(w, "server");
+    nj_w_obj(w);
+    nj_w_key(w, "n_slots");
+    nj_w_int(w, BENCH_SERVER_SLOTS);
+
+    bench_thread_t thread;
+    if (!bench_thread_start(&thread, bench_server_main, &srv)) {
+        nj_w_key(w, "error");
+        nj_w_str(w, "cannot start server thread");
+        nj_w_obj_end(w);
+        return false;
+    }
+    if (!bench_server_ready(&srv)) {
+        neuronos_server_stop();
+        bench_thread_join(thread);
+        fprintf(stderr, "bench: server did not come up on %s:%d\n", host, port);
+        nj_w_key(w, "error");
+        nj_w_str(w, "server did not start (port in use?)");
+        nj_w_obj_end(w);
+        return false;
+    }
+
+    bench_str_t system = {0};
+    bench_str_cat(&system, "You are a concise assistant. Reference notes: ", 46);
+    bench_words(&system, BENCH_SEED, BENCH_SYSTEM_WORDS);
+
+    bool ok = system.s != NULL;
+    nj_w_key(w, "levels");
+    nj_w_arr(w);
+    /* A failing level does not end the phase: every level keeps its
+     * place in the report, so two reports still line up */
+    for (int l = 0; system.s && l < BENCH_N_LEVELS; l++) {
+        if (!bench_server_level(&srv, system.s, BENCH_CLIENTS[l], w, verbose))
+            ok = false;
+    }
+    nj_w_arr_end(w);
+    free(system.s);
+
+    neuronos_server_stop();
+    bench_thread_join(thread);
+
+    bench_w_num(w, "peak_rss_mb", bench_peak_rss_mb());
+    nj_w_obj_end(w);
+    return ok;
+}
+
+/* ============================================================
+ * REPORT
+ * ============================================================ */
+
+static void bench_w_suite(nj_writer_t * w) {
+    nj_w_key(w, "suite");
+    nj_w_obj(w);
+    nj_w_key(w, "seed");
+    nj_w_int(w, BENCH_SEED);
+    nj_w_key(w, "reps");
+    nj_w_int(w, BENCH_REPS);
+    nj_w_key(w, "decode_tokens");
+    nj_w_int(w, BENCH_DECODE_TOKENS);
+    nj_w_key(w, "prompt_lengths");
+    nj_w_arr(w);
+    for (int i = 0; i < BENCH_N_LENS; i++)
+        nj_w_int(w, BENCH_PROMPT_LENS[i]);
+    nj_w_arr_end(w);
+    nj_w_key(w, "agent_tasks");
+    nj_w_int(w, BENCH_N_TASKS);
+    nj_w_key(w, "agent_max_steps");
+    nj_w_int(w, BENCH_AGENT_STEPS);
+    nj_w_key(w, "clients");
+    nj_w_arr(w);
+    for (int i = 0; i < BENCH_N_LEVELS; i++)
+        nj_w_int(w, BENCH_CLIENTS[i]);
+    nj_w_arr_end(w);
+    nj_w_key(w, "turns_per_client");
+    nj_w_int(w, BENCH_TURNS);
+    nj_w_key(w, "reply_tokens");
+    nj_w_int(w, BENCH_REPLY_TOKENS);
+    nj_w_obj_end(w);
+}
+
+int neuronos_bench_run(neuronos_model_t * model, neuronos_bench_params_t params, FILE * out) {
+    if (!model || !out)
+        return -1;
+    unsigned phases = params.phases ? params.phases : NEURONOS_BENCH_ALL;
+    const char * host = params.host ? params.host : "127.0.0.1";
+    int port = params.port > 0 ? params.port : 8384;
+
+    neuronos_model_info_t info = neuronos_model_info(model);
+    neuronos_hw_info_t hw = neuronos_detect_hardware();
+    bool ok = true;
+
+    nj_writer_t w = {0};
+    nj_w_obj(&w);
+    nj_w_key(&w, "schema");
+    nj_w_str(&w, BENCH_SCHEMA);
+    nj_w_key(&w, "neuronos_version");
+    nj_w_str(&w, neuronos_version());
+
+    nj_w_key(&w, "model");
+    nj_w_obj(&w);
+    nj_w_key(&w, "description");
+    nj_w_str(&w, info.description);
+    nj_w_key(&w, "n_params");
+    nj_w_int(&w, (long long)info.n_params);
+    bench_w_num(&w, "size_mb", (double)info.model_size / (1024.0 * 1024.0));
+    nj_w_key(&w, "n_ctx");
+    nj_w_int(&w, neuronos_model_context_size(model));
+    nj_w_obj_end(&w);
+
+    nj_w_key(&w, "hardware");
+    nj_w_obj(&w);
+    nj_w_key(&w, "cpu");
+    nj_w_str(&w, hw.cpu_name);
+    nj_w_key(&w, "arch");
+    nj_w_str(&w, hw.arch);
+    nj_w_key(&w, "cores_physical");
+    nj_w_int(&w, hw.n_cores_physical);
+    nj_w_key(&w, "cores_logical");
+    nj_w_int(&w, hw.n_cores_logical);
+    nj_w_key(&w, "ram_mb");
+    nj_w_int(&w, (long long)hw.ram_total_mb);
+    nj_w_obj_end(&w);
+
+    bench_w_suite(&w);
+    bench_w_num(&w, "rss_after_load_mb", bench_peak_rss_mb());
+
+    if (phases & NEURONOS_BENCH_GEN)
+        ok &= bench_gen(model, &w, params.verbose);
+    if (phases & NEURONOS_BENCH_AGENT)
+        ok &= bench_agent(model, &w, params.verbose);
+    if (phases & NEURONOS_BENCH_SERVER)
+        ok &= bench_server(model, host, port, &w, params.verbose);
+
+    bench_w_num(&w, "peak_rss_mb", bench_peak_rss_mb());
+    nj_w_obj_end(&w);
+
+    char * json = nj_w_finish(&w);
+    if (!json) {
+        fprintf(stderr, "bench: out of memory building the report\n");
+        return -1;
+    }
+    bench_json_pretty(json, out);
+    free(json);
+    return ok ? 0 : 1;
+}
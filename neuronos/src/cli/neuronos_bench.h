@@ -0,0 +1,33 @@
+/* ============================================================
+ * NeuronOS — `neuronos bench`
+ *
+ * Fixed end-to-end benchmark suite. Every input (prompt text,
+ * sampling, sweep points, agent tasks, client conversations) is
+ * derived from constants, so two builds on the same machine and
+ * model produce reports that can be diffed key by key.
+ * ============================================================ */
+#ifndef NEURONOS_BENCH_H
+#define NEURONOS_BENCH_H
+
+#include "neuronos/neuronos.h"
+
+#include <stdio.h>
+
+/* Suite phases */
+#define NEURONOS_BENCH_GEN (1u << 0)    /* prefill / decode sweep over context lengths */
+#define NEURONOS_BENCH_AGENT (1u << 1)  /* multi-step agent tasks against mock tools   */
+#define NEURONOS_BENCH_SERVER (1u << 2) /* concurrent /v1/chat/completions SSE clients */
+#define NEURONOS_BENCH_ALL (NEURONOS_BENCH_GEN | NEURONOS_BENCH_AGENT | NEURONOS_BENCH_SERVER)
+
+typedef struct {
+    unsigned phases;   /* NEURONOS_BENCH_* (0 = all)                     */
+    const char * host; /* server phase bind address (127.0.0.1)          */
+    int port;          /* server phase port (8384)                       */
+    bool verbose;      /* progress per measurement on stderr             */
+} neuronos_bench_params_t;
+
+/* Run the suite on model and write the JSON report to out.
+ * Progress goes to stderr. Returns 0 when every phase ran. */
+int neuronos_bench_run(neuronos_model_t * model, neuronos_bench_params_t params, FILE * out);
+
+#endif /* NEURONOS_BENCH_H */
@@ -14,12 +14,15 @@
  *   neuronos mcp                    MCP server (STDIO transport)
  *   neuronos hwinfo                 Show hardware capabilities
  *   neuronos scan [dir]             Scan for GGUF models
+ *   neuronos bench [phase]          Fixed benchmark suite (JSON report)
+ *   neuronos quantize <in> <out>    Float GGUF → I2_S (streaming)
  *   neuronos <model.gguf> generate  Legacy mode
  *   neuronos <model.gguf> agent     Legacy mode
  * ============================================================ */
 #include "neuronos/neuronos.h"
 #include "neuronos/neuronos_hal.h"
 #include "neuronos/neuronos_model_registry.h"
+#include "neuronos_bench.h"
 
 #include <signal.h>
 #include <stdio.h>
@@ -34,6 +37,32 @@
     #include <unistd.h>
 #endif
 
+/* ---- --tool-cache: tool result cache per registry, in MB (0 = off) ---- */
+static size_t g_tool_cache_mb = 0;
+
+/* ---- --embed: hybrid memory search on the chat model's embeddings ---- */
+static bool g_memory_embed = false;
+
+static int memory_embed(void * user_data, const char * const * texts, int n, float * out) {
+    return neuronos_embed((neuronos_model_t *)user_data, texts, n, out) == NEURONOS_OK ? 0 : -1;
+}
+
+/* ---- --memory-sync: write memory inline instead of on the write-behind thread ---- */
+#define MEMORY_QUEUE_SIZE 256
+static bool g_memory_sync = false;
+
+static void memory_setup(neuronos_memory_t * mem, neuronos_model_t * model) {
+    if (!mem)
+        return;
+    if (!g_memory_sync)
+        neuronos_memory_set_write_behind(mem, MEMORY_QUEUE_SIZE);
+    if (!g_memory_embed)
+        return;
+    neuronos_model_info_t info = neuronos_model_info(model);
+    if (neuronos_memory_set_embedder(mem, info.description, info.n_embd, memory_embed, model) != 0)
+        fprintf(stderr, "Memory: embeddings unavailable (continuing with full-text search)\n");
+}
+
 /* ---- Streaming callback: print tokens as they arrive ---- */
 static bool stream_token(const char * text, void * user_data) {
     (void)user_data;
@@ -85,6 +114,8 @@ static void print_usage(const char * prog) {
             "  %s model remove <id>             Delete a downloaded model\n"
             "  %s hwinfo                        Show hardware capabilities\n"
             "  %s scan [dir]                    Scan for GGUF models\n"
+            "  %s bench [gen|agent|server]      Benchmark suite, JSON report on stdout\n"
+            "  %s quantize <in.gguf> <out.gguf> Convert an F32/F16/BF16 GGUF to I2_S\n"
             "\n"
             "Options:\n"
             "  -t <threads>     Number of threads (default: auto)\n"
@@ -96,6 +127,9 @@ static void print_usage(const char * prog) {
             "  --host <addr>    Server bind address (default: 127.0.0.1)\n"
             "  --port <port>    Server port (default: 8384)\n"
             "  --mcp <file>     MCP client config (default: ~/.neuronos/mcp.json)\n"
+            "  --tool-cache <MB> Reuse read-only tool results (file reads, listings, HTTP)\n"
+            "  --embed          Embed memories for semantic (hybrid) memory search\n"
+            "  --memory-sync    Write memory inline (default: background writer)\n"
             "  --verbose        Show debug info\n"
             "\n"
             "GPU Options:\n"
@@ -104,7 +138,7 @@ static void print_usage(const char * prog) {
             "  --no-gpu         Force CPU-only execution (same as --gpu-layers 0)\n"
             "\n"
             "  --help           Show this help\n",
-            NEURONOS_VERSION_STRING, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog);
+            NEURONOS_VERSION_STRING, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog);
 }
 
 /* ---- Auto-download model: registry-based smart selection ---- */
@@ -421,10 +455,12 @@ static int cmd_ui_with_model(neuronos_model_t * model, int max_tokens, int max_s
 
     /* Open persistent memory */
     neuronos_memory_t * mem = neuronos_memory_open(NULL);
+    memory_setup(mem, model);
 
     /* Tool registry */
     neuronos_tool_registry_t * tools = neuronos_tool_registry_create();
     neuronos_tool_register_defaults(tools, NEURONOS_CAP_FILESYSTEM | NEURONOS_CAP_NETWORK | NEURONOS_CAP_SHELL);
+    neuronos_tool_cache_enable(tools, g_tool_cache_mb * 1024 * 1024);
     if (mem) {
         neuronos_tool_register_memory(tools, mem);
     }
@@ -514,6 +550,61 @@ static int cmd_ui_with_model(neuronos_model_t * model, int max_tokens, int max_s
 }
 
 /* ---- Run generate command ---- */
+/* ---- Bench: fixed suite, report on stdout (phase NULL = all) ---- */
+static int cmd_bench(neuronos_model_t * model, const char * phase, const char * host, int port, bool verbose) {
+    neuronos_bench_params_t params = {.host = host, .port = port, .verbose = verbose};
+    if (!phase || strcmp(phase, "all") == 0)
+        params.phases = NEURONOS_BENCH_ALL;
+    else if (strcmp(phase, "gen") == 0)
+        params.phases = NEURONOS_BENCH_GEN;
+    else if (strcmp(phase, "agent") == 0)
+        params.phases = NEURONOS_BENCH_AGENT;
+    else if (strcmp(phase, "server") == 0)
+        params.phases = NEURONOS_BENCH_SERVER;
+    else {
+        fprintf(stderr, "Unknown bench phase: %s (expected gen, agent, server or all)\n", phase);
+        return 1;
+    }
+    return neuronos_bench_run(model, params, stdout) == 0 ? 0 : 1;
+}
+
+/* ---- Quantize: float GGUF → I2_S on all cores ---- */
+static bool quantize_progress(int64_t done, int64_t total, void * user_data) {
+    int * last = (int *)user_data;
+    int pct = total > 0 ? (int)(done * 100 / total) : 0;
+    if (pct != *last) {
+        fprintf(stderr, "\r  Quantizing... %3d%%", pct);
+        *last = pct;
+    }
+    return true;
+}
+
+static int cmd_quantize(const char * src, const char * dst, int n_threads) {
+    if (!src || !dst) {
+        fprintf(stderr, "Usage: neuronos quantize <in.gguf> <out.gguf> [-t threads]\n");
+        return 1;
+    }
+    neuronos_hal_init();
+    const neuronos_hal_topology_t * topo = neuronos_hal_get_topology();
+    int last = -1;
+    neuronos_quantize_params_t params = {
+        .n_threads = n_threads > 0 ? n_threads : (topo && topo->n_cores > 0 ? topo->n_cores : 1),
+        .on_progress = isatty(fileno(stderr)) ? quantize_progress : NULL,
+        .user_data = &last,
+    };
+    double t0 = neuronos_metrics_now_ms();
+    neuronos_status_t st = neuronos_model_quantize_i2(src, dst, params);
+    if (last >= 0)
+        fprintf(stderr, "\n");
+    if (st != NEURONOS_OK) {
+        fprintf(stderr, "Error: quantizing %s failed (status %d)\n", src, (int)st);
+        return 1;
+    }
+    fprintf(stderr, "  %s → %s (I2_S) in %.1f s on %d threads\n", src, dst,
+            (neuronos_metrics_now_ms() - t0) / 1000.0, params.n_threads);
+    return 0;
+}
+
 static int cmd_generate(neuronos_model_t * model, const char * prompt, int max_tokens, float temperature,
                         const char * grammar_file, bool verbose) {
     if (!prompt) {
@@ -558,6 +649,9 @@ static int cmd_generate(neuronos_model_t * model, const char * prompt, int max_t
 
     if (verbose) {
         fprintf(stderr, "[%d tokens, %.1f ms, %.2f t/s]\n", result.n_tokens, result.elapsed_ms, result.tokens_per_s);
+        fprintf(stderr, "[ttft %.1f ms | prefill %.1f t/s (%d/%d cached) | decode %.2f t/s | sample %.1f ms]\n",
+                result.ttft_ms, result.prefill_tokens_per_s, result.n_reused_tokens, result.n_prompt_tokens,
+                result.decode_tokens_per_s, result.sample_ms);
     }
 
     int rc = (result.status == NEURONOS_OK) ? 0 : 1;
@@ -577,6 +671,7 @@ static int cmd_agent(neuronos_model_t * model, const char * prompt, int max_toke
 
     neuronos_tool_registry_t * tools = neuronos_tool_registry_create();
     neuronos_tool_register_defaults(tools, NEURONOS_CAP_FILESYSTEM | NEURONOS_CAP_NETWORK | NEURONOS_CAP_SHELL);
+    neuronos_tool_cache_enable(tools, g_tool_cache_mb * 1024 * 1024);
 
     /* Register memory tools if memory is available */
     if (mem) {
@@ -712,6 +807,7 @@ static int cmd_repl_model(neuronos_model_t * model, int max_tokens, int max_step
 
     /* Open persistent memory */
     neuronos_memory_t * mem = neuronos_memory_open(NULL); /* default: ~/.neuronos/mem.db */
+    memory_setup(mem, model);
     if (mem) {
         int fact_count = 0;
         neuronos_memory_archival_stats(mem, &fact_count);
@@ -723,6 +819,7 @@ static int cmd_repl_model(neuronos_model_t * model, int max_tokens, int max_step
     /* Tool registry */
     neuronos_tool_registry_t * tools = neuronos_tool_registry_create();
     neuronos_tool_register_defaults(tools, NEURONOS_CAP_FILESYSTEM | NEURONOS_CAP_NETWORK | NEURONOS_CAP_SHELL);
+    neuronos_tool_cache_enable(tools, g_tool_cache_mb * 1024 * 1024);
     if (mem) {
         neuronos_tool_register_memory(tools, mem);
     }
@@ -751,9 +848,11 @@ static int cmd_repl_model(neuronos_model_t * model, int max_tokens, int max_step
             if (mcp_client) {
                 int loaded = neuronos_mcp_client_load_config(mcp_client, cfg);
                 if (loaded > 0) {
-                    neuronos_mcp_client_connect(mcp_client);
+                    /* Servers start in the background; late tools are added between turns */
+                    neuronos_mcp_client_connect_async(mcp_client);
                     int mcp_tools = neuronos_mcp_client_register_tools(mcp_client, tools);
-                    fprintf(stderr, "MCP: %d external tools from %d server(s)\n", mcp_tools, loaded);
+                    fprintf(stderr, "MCP: %d external tools ready, %d server(s) starting\n", mcp_tools,
+                            neuronos_mcp_client_wait(mcp_client, 0));
                 } else {
                     neuronos_mcp_client_free(mcp_client);
                     mcp_client = NULL;
@@ -784,6 +883,9 @@ static int cmd_repl_model(neuronos_model_t * model, int max_tokens, int max_step
         neuronos_agent_set_memory(agent, mem);
     }
 
+    /* Restore (or prefill and snapshot) the system prompt KV state */
+    neuronos_agent_warm_cache(agent, NULL);
+
     fprintf(stderr, "Tools: %d registered%s\n", neuronos_tool_count(tools),
             mem ? " | Memory: active" : "");
     fprintf(stderr, "Just talk naturally. I can use tools when needed.\n\n");
@@ -810,6 +912,13 @@ static int cmd_repl_model(neuronos_model_t * model, int max_tokens, int max_step
         if (len == 0)
             continue;
 
+        /* Pick up tools from MCP servers that finished starting */
+        if (mcp_client) {
+            int added = neuronos_mcp_client_register_tools(mcp_client, tools);
+            if (added > 0 && verbose)
+                fprintf(stderr, "MCP: %d more tools available\n", added);
+        }
+
         /* ---- REPL commands ---- */
         if (strcmp(line, "/quit") == 0 || strcmp(line, "/exit") == 0 || strcmp(line, "/q") == 0) {
             fprintf(stderr, "Goodbye.\n");
@@ -823,8 +932,10 @@ static int cmd_repl_model(neuronos_model_t * model, int max_tokens, int max_step
                 "Just type naturally — I'll use tools when needed.\n"
                 "\n"
                 "  /clear             Clear conversation history\n"
+                "  /compact           Summarize older turns now\n"
                 "  /tools             List available tools\n"
                 "  /status            Show system & model info\n"
+                "  /stats             Show latency percentiles\n"
                 "  /memory            Show memory stats\n"
                 "  /remember <text>   Store a fact in long-term memory\n"
                 "  /recall <query>    Search long-term memory\n"
@@ -843,6 +954,15 @@ static int cmd_repl_model(neuronos_model_t * model, int max_tokens, int max_step
             continue;
         }
 
+        if (strcmp(line, "/compact") == 0) {
+            int freed = neuronos_context_compact(agent);
+            if (freed > 0)
+                fprintf(stderr, "Compacted: ~%d tokens freed.\n", freed);
+            else
+                fprintf(stderr, "Nothing to compact.\n");
+            continue;
+        }
+
         if (strcmp(line, "/status") == 0) {
             neuronos_model_info_t info = neuronos_model_info(model);
             neuronos_hal_print_info();
@@ -853,6 +973,24 @@ static int cmd_repl_model(neuronos_model_t * model, int max_tokens, int max_step
             continue;
         }
 
+        if (strcmp(line, "/stats") == 0) {
+            fprintf(stderr, "%-9s %7s %10s %10s %10s %10s\n", "phase", "count", "mean ms", "p50 ms", "p95 ms",
+                    "p99 ms");
+            for (int m = 0; m < NEURONOS_METRIC_COUNT; m++) {
+                neuronos_histogram_t h = neuronos_metrics_get((neuronos_metric_t)m);
+                fprintf(stderr, "%-9s %7llu %10.2f %10.2f %10.2f %10.2f\n", neuronos_metric_name((neuronos_metric_t)m),
+                        (unsigned long long)h.count, h.count ? h.sum_ms / (double)h.count : 0.0,
+                        neuronos_histogram_percentile(&h, 0.50), neuronos_histogram_percentile(&h, 0.95),
+                        neuronos_histogram_percentile(&h, 0.99));
+            }
+            neuronos_tool_cache_stats_t cs = neuronos_tool_cache_stats(tools);
+            if (cs.max_bytes)
+                fprintf(stderr, "tool cache: %llu hits, %llu misses, %d entries, %zu/%zu KB\n",
+                        (unsigned long long)cs.hits, (unsigned long long)cs.misses, cs.entries, cs.bytes / 1024,
+                        cs.max_bytes / 1024);
+            continue;
+        }
+
         if (strcmp(line, "/tools") == 0) {
             int tc = neuronos_tool_count(tools);
             fprintf(stderr, "Registered tools (%d):\n", tc);
@@ -1062,6 +1200,13 @@ int main(int argc, char * argv[]) {
             verbose = true;
         } else if (strcmp(argv[i], "--mcp") == 0 && i + 1 < argc) {
             mcp_config = argv[++i];
+        } else if (strcmp(argv[i], "--tool-cache") == 0 && i + 1 < argc) {
+            int mb = atoi(argv[++i]);
+            g_tool_cache_mb = mb > 0 ? (size_t)mb : 0;
+        } else if (strcmp(argv[i], "--embed") == 0) {
+            g_memory_embed = true;
+        } else if (strcmp(argv[i], "--memory-sync") == 0) {
+            g_memory_sync = true;
         } else if (strcmp(argv[i], "--gpu-layers") == 0 && i + 1 < argc) {
             gpu_layers = atoi(argv[++i]);
             if (gpu_layers < 0) gpu_layers = 0;  /* clamp negative to 0 */
@@ -1085,7 +1230,8 @@ int main(int argc, char * argv[]) {
             if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "-s") == 0 ||
                 strcmp(argv[i], "--temp") == 0 || strcmp(argv[i], "--grammar") == 0 ||
                 strcmp(argv[i], "--models") == 0 || strcmp(argv[i], "--host") == 0 || strcmp(argv[i], "--port") == 0 ||
-                strcmp(argv[i], "--mcp") == 0 || strcmp(argv[i], "--gpu-layers") == 0) {
+                strcmp(argv[i], "--mcp") == 0 || strcmp(argv[i], "--gpu-layers") == 0 ||
+                strcmp(argv[i], "--tool-cache") == 0) {
                 i++; /* skip value */
             }
             continue;
@@ -1158,6 +1304,13 @@ int main(int argc, char * argv[]) {
         return 0;
     }
 
+    /* ════════════════════════════════════════════════════════
+     * QUANTIZE — Float GGUF → I2_S (no model load)
+     * ════════════════════════════════════════════════════════ */
+    if (command && strcmp(command, "quantize") == 0) {
+        return cmd_quantize(positional2, positional3, n_threads);
+    }
+
     /* ════════════════════════════════════════════════════════
      * SCAN — Scan models directory
      * ════════════════════════════════════════════════════════ */
@@ -1213,7 +1366,7 @@ int main(int argc, char * argv[]) {
                 if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "-s") == 0 ||
                     strcmp(argv[i], "--temp") == 0 || strcmp(argv[i], "--grammar") == 0 ||
                     strcmp(argv[i], "--models") == 0 || strcmp(argv[i], "--host") == 0 ||
-                    strcmp(argv[i], "--port") == 0) {
+                    strcmp(argv[i], "--port") == 0 || strcmp(argv[i], "--tool-cache") == 0) {
                     i++;
                 }
                 continue;
@@ -1335,6 +1488,8 @@ int main(int argc, char * argv[]) {
             rc = (status == NEURONOS_OK) ? 0 : 1;
         } else if (strcmp(sub_cmd, "repl") == 0 || strcmp(sub_cmd, "chat") == 0) {
             rc = cmd_repl_model(model, max_tokens, max_steps, temperature, grammar_file, verbose, mcp_config);
+        } else if (strcmp(sub_cmd, "bench") == 0) {
+            rc = cmd_bench(model, prompt, host, port, verbose);
         } else
             fprintf(stderr, "Unknown command: %s\n", sub_cmd);
 
@@ -1424,6 +1579,10 @@ int main(int argc, char * argv[]) {
         neuronos_tool_registry_free(mcp_tools);
         rc = (status == NEURONOS_OK) ? 0 : 1;
     }
+    /* ── BENCH: fixed benchmark suite ── */
+    else if (command && strcmp(command, "bench") == 0) {
+        rc = cmd_bench(ctx.model, positional2, host, port, verbose);
+    }
     /* ── AUTO (legacy compat): auto generate/agent ── */
     else if (command && strcmp(command, "auto") == 0) {
         if (positional2) {
@@ -1435,7 +1594,7 @@ int main(int argc, char * argv[]) {
                     if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "-s") == 0 ||
                         strcmp(argv[i], "--temp") == 0 || strcmp(argv[i], "--grammar") == 0 ||
                         strcmp(argv[i], "--models") == 0 || strcmp(argv[i], "--host") == 0 ||
-                        strcmp(argv[i], "--port") == 0) {
+                        strcmp(argv[i], "--port") == 0 || strcmp(argv[i], "--tool-cache") == 0) {
                         i++;
                     }
                     continue;
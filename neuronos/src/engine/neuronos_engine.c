@@ -7,21 +7,64 @@
 #include "neuronos/neuronos.h"
 #include "neuronos/neuronos_hal.h"
 
+#include <ctype.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <time.h>
 
 #ifdef _WIN32
+#include <direct.h> /* _mkdir */
 #include <windows.h>
+#define neuronos_mkdir(path) _mkdir(path)
+typedef SRWLOCK eng_mutex_t;
+#define eng_mutex_init(m)    InitializeSRWLock(m)
+#define eng_mutex_destroy(m) ((void)(m))
+#define eng_mutex_lock(m)    AcquireSRWLockExclusive(m)
+#define eng_mutex_unlock(m)  ReleaseSRWLockExclusive(m)
+#define eng_atomic_load64(p) ((uint64_t)InterlockedCompareExchange64((volatile LONG64 *)(p), 0, 0))
+#define eng_atomic_inc64(p)  InterlockedIncrement64((volatile LONG64 *)(p))
 #else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
 #include <unistd.h>
+#define neuronos_mkdir(path) mkdir(path, 0755)
+typedef pthread_mutex_t eng_mutex_t;
+#define eng_mutex_init(m)    pthread_mutex_init(m, NULL)
+#define eng_mutex_destroy(m) pthread_mutex_destroy(m)
+#define eng_mutex_lock(m)    pthread_mutex_lock(m)
+#define eng_mutex_unlock(m)  pthread_mutex_unlock(m)
+#define eng_atomic_load64(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define eng_atomic_inc64(p)  __atomic_add_fetch((p), 1, __ATOMIC_RELEASE)
 #endif
 
 /* llama.cpp public C API */
 #include "llama.h"
 
 /* ---- Internal structs ---- */
+#define SAMPLER_CACHE_SIZE 4
+#define SCRATCH_SEQ        1 /* neuronos_gen_params_t.scratch_seq */
+
+/* Pristine (never sampled) grammar chain plus the exact inputs it was
+ * built from. Generations run on clones of it. */
+typedef struct {
+    uint64_t key;
+    uint64_t epoch;
+    uint64_t last_used;
+    char * grammar;
+    char * grammar_root;
+    float temperature;
+    float top_p;
+    int top_k;
+    float repeat_penalty;
+    int repeat_last_n;
+    uint32_t seed;
+    struct llama_sampler * chain;
+} sampler_cache_entry_t;
+
 struct neuronos_engine {
     int n_threads;
     int n_gpu_layers;
@@ -31,13 +74,43 @@ struct neuronos_engine {
 
 struct neuronos_model {
     neuronos_engine_t * engine;
+    neuronos_model_pool_t * pool; /* owner of llama_model, or NULL */
     struct llama_model * llama_model;
     struct llama_context * llama_ctx;
     int context_size;
+    struct llama_context_params cparams; /* params the context was created with */
+    uint64_t model_hash;                 /* identity of weights + KV layout      */
     char desc_buf[256];
+
+    /* Token sequence currently resident in the KV cache (seq 0).
+     * Used by neuronos_generate() to reuse the longest common prefix
+     * between consecutive prompts instead of re-prefilling. */
+    llama_token * cache_tokens;
+    int n_cache_tokens;
+
+    /* Compiled grammar sampler chains, LRU by last_used */
+    sampler_cache_entry_t sampler_cache[SAMPLER_CACHE_SIZE];
+    uint64_t sampler_clock;
+
+    /* Pooled-embedding context for neuronos_embed(), created on first use */
+    struct llama_context * embd_ctx;
 };
 
+static void sampler_cache_clear(sampler_cache_entry_t * e);
+
 /* ---- Helpers ---- */
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME  0x100000001b3ULL
+
+static uint64_t fnv1a(uint64_t h, const void * data, size_t len) {
+    const unsigned char * p = data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
 static double get_time_ms(void) {
 #ifdef _WIN32
     LARGE_INTEGER freq, count;
@@ -51,6 +124,17 @@ static double get_time_ms(void) {
 #endif
 }
 
+/* Append one token to a batch allocated with llama_batch_init(). */
+static void batch_add(struct llama_batch * batch, llama_token id, llama_pos pos, llama_seq_id seq_id, bool logits) {
+    int n = batch->n_tokens;
+    batch->token[n] = id;
+    batch->pos[n] = pos;
+    batch->n_seq_id[n] = 1;
+    batch->seq_id[n][0] = seq_id;
+    batch->logits[n] = logits;
+    batch->n_tokens++;
+}
+
 static int detect_n_threads(void) {
 #ifdef _WIN32
     SYSTEM_INFO si;
@@ -95,6 +179,14 @@ neuronos_engine_t * neuronos_init(neuronos_engine_params_t params) {
 
     /* Initialize NeuronOS HAL */
     neuronos_hal_init();
+    neuronos_hal_set_n_threads(engine->n_threads);
+
+    /* Multi-socket: let ggml spread its threads and weights over the
+     * nodes instead of decoding from one socket's memory controllers */
+    const neuronos_hal_topology_t * topo = neuronos_hal_get_topology();
+    if (topo->n_nodes > 1) {
+        llama_numa_init(GGML_NUMA_STRATEGY_DISTRIBUTE);
+    }
 
 #ifdef NEURONOS_HAS_VULKAN
     /* Check if Vulkan GPU is available */
@@ -106,11 +198,23 @@ neuronos_engine_t * neuronos_init(neuronos_engine_params_t params) {
     }
 #endif
 
+    /* The HAL's Vulkan I2_S kernels follow the GPU offload request:
+     * n_gpu_layers == 0 keeps ternary matmuls on the best CPU backend */
+    const neuronos_backend_t * hal_backend = neuronos_hal_get_active_backend();
+    if (hal_backend && hal_backend->type == NEURONOS_BACKEND_VULKAN) {
+        if (engine->n_gpu_layers == 0) {
+            neuronos_hal_select_cpu_backend();
+        } else if (engine->verbose) {
+            fprintf(stderr, "[neuronos] I2_S kernels offloaded to the Vulkan GPU (gpu_layers=%d)\n",
+                    engine->n_gpu_layers);
+        }
+    }
+
     engine->initialized = true;
 
     if (engine->verbose) {
-        fprintf(stderr, "[neuronos] Engine initialized (v%s, threads=%d, gpu_layers=%d)\n", NEURONOS_VERSION_STRING,
-                engine->n_threads, engine->n_gpu_layers);
+        fprintf(stderr, "[neuronos] Engine initialized (v%s, threads=%d, gpu_layers=%d, numa_nodes=%d)\n",
+                NEURONOS_VERSION_STRING, engine->n_threads, engine->n_gpu_layers, topo->n_nodes);
     }
 
     return engine;
@@ -135,38 +239,37 @@ const char * neuronos_version(void) {
  * MODEL
  * ============================================================ */
 
-neuronos_model_t * neuronos_model_load(neuronos_engine_t * engine, neuronos_model_params_t params) {
-    if (!engine || !params.model_path)
-        return NULL;
-
-    neuronos_model_t * model = calloc(1, sizeof(neuronos_model_t));
-    if (!model)
-        return NULL;
-    model->engine = engine;
-
-    /* --- Load model --- */
+static struct llama_model * load_weights(neuronos_engine_t * engine, const neuronos_model_params_t * params) {
     struct llama_model_params mparams = llama_model_default_params();
     /* GPU layers: if n_gpu_layers > 0, llama.cpp will automatically use:
      *   - Vulkan backend (if compiled with GGML_VULKAN and Vulkan GPU detected)
      *   - CUDA backend (if compiled with GGML_CUDA and NVIDIA GPU detected)
      *   - Metal backend (if on macOS with Apple Silicon)
      * Vulkan prioritizes universal GPU support (NVIDIA/AMD/Intel).
-     * For ternary models (BitNet 1.58-bit), n_gpu_layers should be 0 (CPU-only MAD kernels). */
+     * ggml has no GPU I2_S kernels: for ternary models (BitNet 1.58-bit) n_gpu_layers > 0
+     * instead enables the HAL's Vulkan I2_S backend (see neuronos_init). */
     mparams.n_gpu_layers = engine->n_gpu_layers;
-    mparams.use_mmap = params.use_mmap;
+    mparams.use_mmap = params->use_mmap;
+    mparams.use_mlock = params->use_mlock;
 
     if (engine->verbose) {
-        fprintf(stderr, "[neuronos] Loading model: %s\n", params.model_path);
+        fprintf(stderr, "[neuronos] Loading model: %s\n", params->model_path);
     }
 
-    model->llama_model = llama_load_model_from_file(params.model_path, mparams);
-    if (!model->llama_model) {
+    struct llama_model * lmodel = llama_load_model_from_file(params->model_path, mparams);
+    if (!lmodel) {
         if (engine->verbose) {
             fprintf(stderr, "[neuronos] ERROR: Failed to load model\n");
         }
-        free(model);
         return NULL;
     }
+    return lmodel;
+}
+
+/* Create the context and per-context caches for model->llama_model.
+ * On failure nothing but the weights is left allocated. */
+static bool model_init_context(neuronos_model_t * model, neuronos_model_params_t params) {
+    neuronos_engine_t * engine = model->engine;
 
     /* --- Create context --- */
     /* Auto-detect optimal context size:
@@ -189,42 +292,125 @@ neuronos_model_t * neuronos_model_load(neuronos_engine_t * engine, neuronos_mode
 #ifdef __EMSCRIPTEN__
     /* WASM: smaller batch to reduce compute buffer allocations,
      * and disable flash_attn which causes OOB in linear memory. */
-    cparams.n_batch = 128;
-    cparams.flash_attn = false;
+    int n_batch = params.n_batch > 0 ? params.n_batch : 128;
+    bool flash_attn = params.flash_attn > 0;
 #else
-    cparams.n_batch = 512;
-    cparams.flash_attn = true;
+    int n_batch = params.n_batch > 0 ? params.n_batch : 512;
+    bool flash_attn = params.flash_attn >= 0;
 #endif
-    cparams.n_threads = engine->n_threads;
-    cparams.n_threads_batch = engine->n_threads;
+    int n_ubatch = params.n_ubatch > 0 ? params.n_ubatch : n_batch;
+    if (n_ubatch > n_batch)
+        n_ubatch = n_batch;
+    int n_threads = params.n_threads > 0 ? params.n_threads : engine->n_threads;
+    cparams.n_batch = (uint32_t)n_batch;
+    cparams.n_ubatch = (uint32_t)n_ubatch;
+    cparams.flash_attn = flash_attn;
+    cparams.n_threads = n_threads;
+    cparams.n_threads_batch = params.n_threads_batch > 0 ? params.n_threads_batch : n_threads;
+    cparams.n_seq_max = SCRATCH_SEQ + 1; /* seq 0 = cached prompt, seq 1 = scratch */
+
+    /* KV cache precision (quantized V needs flash attention) */
+    enum ggml_type kv_type = params.kv_type == NEURONOS_KV_Q8_0   ? GGML_TYPE_Q8_0
+                             : params.kv_type == NEURONOS_KV_Q4_0 ? GGML_TYPE_Q4_0
+                                                                  : GGML_TYPE_F16;
+    cparams.type_k = kv_type;
+    cparams.type_v = flash_attn ? kv_type : GGML_TYPE_F16;
+    if (!flash_attn && kv_type != GGML_TYPE_F16 && engine->verbose) {
+        fprintf(stderr, "[neuronos] flash_attn off: quantizing K cache only, V stays f16\n");
+    }
 
+    model->cparams = cparams;
     model->llama_ctx = llama_new_context_with_model(model->llama_model, cparams);
     if (!model->llama_ctx) {
         if (engine->verbose) {
             fprintf(stderr, "[neuronos] ERROR: Failed to create context\n");
         }
-        llama_free_model(model->llama_model);
-        free(model);
-        return NULL;
+        return false;
     }
 
+    model->cache_tokens = malloc((size_t)ctx_size * sizeof(llama_token));
+    if (!model->cache_tokens) {
+        llama_free(model->llama_ctx);
+        model->llama_ctx = NULL;
+        return false;
+    }
+    model->n_cache_tokens = 0;
+
     /* Store description */
     llama_model_desc(model->llama_model, model->desc_buf, sizeof(model->desc_buf));
 
+    /* Identity used to key session snapshots: file + size + mtime + KV layout */
+    uint64_t h = fnv1a(FNV_OFFSET, params.model_path, strlen(params.model_path));
+    struct stat st;
+    if (stat(params.model_path, &st) == 0) {
+        int64_t sz = (int64_t)st.st_size, mt = (int64_t)st.st_mtime;
+        h = fnv1a(h, &sz, sizeof(sz));
+        h = fnv1a(h, &mt, sizeof(mt));
+    }
+    int32_t kv_types[2] = {(int32_t)cparams.type_k, (int32_t)cparams.type_v};
+    h = fnv1a(h, kv_types, sizeof(kv_types));
+    h = fnv1a(h, model->desc_buf, strlen(model->desc_buf));
+    model->model_hash = h;
+
     if (engine->verbose) {
         fprintf(stderr, "[neuronos] Model loaded: %s (ctx=%d, params=%lldM)\n", model->desc_buf, ctx_size,
                 (long long)(llama_model_n_params(model->llama_model) / 1000000));
+        static const char * kv_names[] = {"f16", "q8_0", "q4_0"};
+        int kv_idx = (params.kv_type >= NEURONOS_KV_F16 && params.kv_type <= NEURONOS_KV_Q4_0) ? params.kv_type : 0;
+        fprintf(stderr, "[neuronos]   batch=%u ubatch=%u threads=%d/%d flash_attn=%s mlock=%s kv=%s\n",
+                cparams.n_batch, cparams.n_ubatch, cparams.n_threads, cparams.n_threads_batch,
+                cparams.flash_attn ? "on" : "off", params.use_mlock ? "on" : "off", kv_names[kv_idx]);
+    }
+
+    return true;
+}
+
+/* Free the context and caches, keeping the weights */
+static void model_free_context(neuronos_model_t * model) {
+    if (model->llama_ctx) {
+        llama_free(model->llama_ctx);
+        model->llama_ctx = NULL;
+    }
+    if (model->embd_ctx) {
+        llama_free(model->embd_ctx);
+        model->embd_ctx = NULL;
     }
+    free(model->cache_tokens);
+    model->cache_tokens = NULL;
+    for (int i = 0; i < SAMPLER_CACHE_SIZE; i++)
+        sampler_cache_clear(&model->sampler_cache[i]);
+}
+
+neuronos_model_t * neuronos_model_load(neuronos_engine_t * engine, neuronos_model_params_t params) {
+    if (!engine || !params.model_path)
+        return NULL;
+
+    neuronos_model_t * model = calloc(1, sizeof(neuronos_model_t));
+    if (!model)
+        return NULL;
+    model->engine = engine;
 
+    model->llama_model = load_weights(engine, &params);
+    if (!model->llama_model) {
+        free(model);
+        return NULL;
+    }
+    if (!model_init_context(model, params)) {
+        llama_free_model(model->llama_model);
+        free(model);
+        return NULL;
+    }
     return model;
 }
 
 void neuronos_model_free(neuronos_model_t * model) {
     if (!model)
         return;
-    if (model->llama_ctx) {
-        llama_free(model->llama_ctx);
+    if (model->pool) {
+        neuronos_pool_release(model->pool, model);
+        return;
     }
+    model_free_context(model);
     if (model->llama_model) {
         llama_free_model(model->llama_model);
     }
@@ -251,212 +437,2093 @@ int neuronos_model_context_size(const neuronos_model_t * model) {
 }
 
 /* ============================================================
- * GENERATE
+ * MODEL POOL
+ *
+ * Weights are keyed by file path; contexts by weights + context
+ * settings. Usage is estimated as weight file size plus the KV
+ * cache size from the auto-tuner's per-1K heuristic.
  * ============================================================ */
 
-neuronos_gen_result_t neuronos_generate(neuronos_model_t * model, neuronos_gen_params_t params) {
-    neuronos_gen_result_t result = {0};
+typedef struct {
+    char * path;
+    struct llama_model * llama_model;
+    int64_t size_mb;
+    int n_contexts; /* pool contexts on these weights (in use + idle) */
+    uint64_t last_used;
+} pool_weights_t;
+
+typedef struct {
+    neuronos_model_t * model;
+    int weights;                   /* index into pool->weights */
+    neuronos_model_params_t params; /* as acquired; model_path unused */
+    int64_t size_mb;
+    bool in_use;
+    uint64_t last_used;
+} pool_ctx_t;
+
+struct neuronos_model_pool {
+    neuronos_engine_t * engine;
+    eng_mutex_t lock; /* guards everything below; held across loads */
+    int64_t budget_mb;
+    pool_weights_t weights[NEURONOS_POOL_MAX_MODELS];
+    pool_ctx_t ctxs[NEURONOS_POOL_MAX_CONTEXTS];
+    uint64_t clock;
+};
 
-    if (!model || !params.prompt) {
-        result.status = NEURONOS_ERROR_INVALID_PARAM;
-        return result;
-    }
+static int64_t pool_used_mb(const neuronos_model_pool_t * pool) {
+    int64_t used = 0;
+    for (int i = 0; i < NEURONOS_POOL_MAX_MODELS; i++)
+        if (pool->weights[i].llama_model)
+            used += pool->weights[i].size_mb;
+    for (int i = 0; i < NEURONOS_POOL_MAX_CONTEXTS; i++)
+        if (pool->ctxs[i].model)
+            used += pool->ctxs[i].size_mb;
+    return used;
+}
 
-    double t_start = get_time_ms();
-    struct llama_model * lmodel = model->llama_model;
-    struct llama_context * ctx = model->llama_ctx;
+static bool pool_params_match(const neuronos_model_params_t * a, const neuronos_model_params_t * b) {
+    return a->context_size == b->context_size && a->n_batch == b->n_batch && a->n_ubatch == b->n_ubatch &&
+           a->n_threads == b->n_threads && a->n_threads_batch == b->n_threads_batch &&
+           a->flash_attn == b->flash_attn && a->kv_type == b->kv_type;
+}
 
-    /* --- Defaults --- */
-    int max_tokens = params.max_tokens > 0 ? params.max_tokens : 256;
-    float temp = params.temperature >= 0.0f ? params.temperature : 0.7f;
-    float top_p = params.top_p > 0.0f ? params.top_p : 0.95f;
-    int top_k = params.top_k > 0 ? params.top_k : 40;
-    float repeat_penalty = params.repeat_penalty > 0.0f ? params.repeat_penalty : 1.1f;
-    int repeat_last_n = params.repeat_last_n > 0 ? params.repeat_last_n : 64;
-    uint32_t seed = params.seed > 0 ? params.seed : (uint32_t)time(NULL);
-    const char * grammar_root = params.grammar_root ? params.grammar_root : "root";
+static void pool_drop_ctx(neuronos_model_pool_t * pool, pool_ctx_t * c) {
+    pool->weights[c->weights].n_contexts--;
+    model_free_context(c->model);
+    free(c->model);
+    memset(c, 0, sizeof(*c));
+}
 
-    /* --- Tokenize prompt --- */
-    int prompt_len = (int)strlen(params.prompt);
-    int n_prompt = -llama_tokenize(lmodel, params.prompt, prompt_len, NULL, 0, true, true);
-    if (n_prompt <= 0) {
-        result.status = NEURONOS_ERROR_GENERATE;
-        return result;
+static void pool_drop_weights(neuronos_model_pool_t * pool, pool_weights_t * w) {
+    if (pool->engine->verbose) {
+        fprintf(stderr, "[neuronos] Pool: evicting model %s (%lld MB)\n", w->path, (long long)w->size_mb);
     }
+    llama_free_model(w->llama_model);
+    free(w->path);
+    memset(w, 0, sizeof(*w));
+}
 
-    llama_token * prompt_tokens = malloc((size_t)n_prompt * sizeof(llama_token));
-    if (!prompt_tokens) {
-        result.status = NEURONOS_ERROR_GENERATE;
-        return result;
+/* Evict LRU idle contexts and unreferenced weights until need_mb more
+ * fits in the budget. Returns false if what remains is all in use. */
+static bool pool_evict(neuronos_model_pool_t * pool, int64_t need_mb) {
+    while (pool_used_mb(pool) + need_mb > pool->budget_mb) {
+        pool_ctx_t * lru_ctx = NULL;
+        pool_weights_t * lru_w = NULL;
+        for (int i = 0; i < NEURONOS_POOL_MAX_CONTEXTS; i++) {
+            pool_ctx_t * c = &pool->ctxs[i];
+            if (c->model && !c->in_use && (!lru_ctx || c->last_used < lru_ctx->last_used))
+                lru_ctx = c;
+        }
+        for (int i = 0; i < NEURONOS_POOL_MAX_MODELS; i++) {
+            pool_weights_t * w = &pool->weights[i];
+            if (w->llama_model && w->n_contexts == 0 && (!lru_w || w->last_used < lru_w->last_used))
+                lru_w = w;
+        }
+        if (lru_w && (!lru_ctx || lru_w->last_used <= lru_ctx->last_used))
+            pool_drop_weights(pool, lru_w);
+        else if (lru_ctx)
+            pool_drop_ctx(pool, lru_ctx);
+        else
+            return false;
     }
-    llama_tokenize(lmodel, params.prompt, prompt_len, prompt_tokens, n_prompt, true, true);
+    return true;
+}
 
-    /* --- Check context size --- */
-    if (n_prompt + max_tokens > model->context_size) {
-        max_tokens = model->context_size - n_prompt;
-        if (max_tokens <= 0) {
-            free(prompt_tokens);
-            result.status = NEURONOS_ERROR_CONTEXT_FULL;
-            return result;
-        }
+neuronos_model_pool_t * neuronos_pool_create(neuronos_engine_t * engine, neuronos_pool_params_t params) {
+    if (!engine)
+        return NULL;
+    neuronos_model_pool_t * pool = calloc(1, sizeof(neuronos_model_pool_t));
+    if (!pool)
+        return NULL;
+    pool->engine = engine;
+    eng_mutex_init(&pool->lock);
+    pool->budget_mb = params.budget_mb > 0 ? params.budget_mb : neuronos_detect_hardware().model_budget_mb;
+
+    if (engine->verbose) {
+        fprintf(stderr, "[neuronos] Model pool: budget %lld MB\n", (long long)pool->budget_mb);
     }
+    return pool;
+}
 
-    /* --- Clear KV cache for fresh generation --- */
-    llama_kv_cache_clear(ctx);
+void neuronos_pool_free(neuronos_model_pool_t * pool) {
+    if (!pool)
+        return;
+    for (int i = 0; i < NEURONOS_POOL_MAX_CONTEXTS; i++)
+        if (pool->ctxs[i].model)
+            pool_drop_ctx(pool, &pool->ctxs[i]);
+    for (int i = 0; i < NEURONOS_POOL_MAX_MODELS; i++)
+        if (pool->weights[i].llama_model)
+            pool_drop_weights(pool, &pool->weights[i]);
+    eng_mutex_destroy(&pool->lock);
+    free(pool);
+}
 
-    /* --- Create sampler chain --- */
-    struct llama_sampler * smpl = llama_sampler_chain_init(llama_sampler_chain_default_params());
+static neuronos_pool_stats_t pool_stats_locked(const neuronos_model_pool_t * pool);
 
-    /* Add grammar sampler if grammar provided */
-    if (params.grammar && params.grammar[0]) {
-        struct llama_sampler * grammar_smpl = llama_sampler_init_grammar(lmodel, params.grammar, grammar_root);
-        if (grammar_smpl) {
-            llama_sampler_chain_add(smpl, grammar_smpl);
+/* neuronos_pool_acquire() body; caller holds pool->lock */
+static neuronos_model_t * pool_acquire_locked(neuronos_model_pool_t * pool, neuronos_model_params_t params) {
+
+    /* 1. Resident weights for this path? */
+    int wi = -1;
+    for (int i = 0; i < NEURONOS_POOL_MAX_MODELS; i++) {
+        if (pool->weights[i].llama_model && strcmp(pool->weights[i].path, params.model_path) == 0) {
+            wi = i;
+            break;
         }
     }
 
-    /* Standard sampling: penalties → top-k → top-p → temperature → dist */
-    if (repeat_penalty != 1.0f) {
-        int32_t n_vocab = llama_n_vocab(lmodel);
-        llama_token eos_id = llama_token_eos(lmodel);
-        llama_token nl_id  = llama_token_nl(lmodel);
-        llama_sampler_chain_add(smpl,
-            llama_sampler_init_penalties(n_vocab, eos_id, nl_id,
-                                        repeat_last_n, repeat_penalty,
-                                        0.0f, 0.0f,   /* freq_penalty, presence_penalty */
-                                        false, false)); /* penalize_nl, ignore_eos */
+    /* 2. Idle context with the same settings: hand it out warm */
+    if (wi >= 0) {
+        for (int i = 0; i < NEURONOS_POOL_MAX_CONTEXTS; i++) {
+            pool_ctx_t * c = &pool->ctxs[i];
+            if (c->model && !c->in_use && c->weights == wi && pool_params_match(&c->params, &params)) {
+                c->in_use = true;
+                c->last_used = pool->weights[wi].last_used = ++pool->clock;
+                return c->model;
+            }
+        }
     }
-    llama_sampler_chain_add(smpl, llama_sampler_init_top_k(top_k));
-    llama_sampler_chain_add(smpl, llama_sampler_init_top_p(top_p, 1));
 
-    if (temp > 0.0f) {
-        llama_sampler_chain_add(smpl, llama_sampler_init_temp(temp));
-        llama_sampler_chain_add(smpl, llama_sampler_init_dist(seed));
-    } else {
-        llama_sampler_chain_add(smpl, llama_sampler_init_greedy());
-    }
+    /* 3. Load the weights if needed */
+    if (wi < 0) {
+        struct stat st;
+        int64_t size_mb = stat(params.model_path, &st) == 0 ? (int64_t)(st.st_size / (1024 * 1024)) : 0;
+        if (!pool_evict(pool, size_mb))
+            return NULL;
+        for (int i = 0; i < NEURONOS_POOL_MAX_MODELS && wi < 0; i++)
+            if (!pool->weights[i].llama_model)
+                wi = i;
+        if (wi < 0) {
+            /* Table full: drop the LRU weights no context uses */
+            pool_weights_t * lru = NULL;
+            for (int i = 0; i < NEURONOS_POOL_MAX_MODELS; i++) {
+                pool_weights_t * cand = &pool->weights[i];
+                if (cand->n_contexts == 0 && (!lru || cand->last_used < lru->last_used))
+                    lru = cand;
+            }
+            if (!lru)
+                return NULL;
+            pool_drop_weights(pool, lru);
+            wi = (int)(lru - pool->weights);
+        }
 
-    /* --- Evaluate prompt (chunked to fit n_batch) --- */
-#ifdef __EMSCRIPTEN__
-    const int n_batch = 128; /* matches cparams.n_batch for WASM */
-#else
-    const int n_batch = 512; /* matches cparams.n_batch */
-#endif
-    struct llama_batch batch;
-    int rc = 0;
-    for (int i = 0; i < n_prompt; i += n_batch) {
-        int n_eval = n_prompt - i;
-        if (n_eval > n_batch) n_eval = n_batch;
-        batch = llama_batch_get_one(prompt_tokens + i, n_eval, i, 0);
-        rc = llama_decode(ctx, batch);
-        if (rc != 0) break;
+        pool_weights_t * w = &pool->weights[wi];
+        w->path = strdup(params.model_path);
+        w->llama_model = w->path ? load_weights(pool->engine, &params) : NULL;
+        if (!w->llama_model) {
+            free(w->path);
+            memset(w, 0, sizeof(*w));
+            return NULL;
+        }
+        w->size_mb = (int64_t)(llama_model_size(w->llama_model) / (1024 * 1024));
+        w->last_used = ++pool->clock;
     }
-    if (rc != 0) {
-        free(prompt_tokens);
-        llama_sampler_free(smpl);
-        result.status = NEURONOS_ERROR_GENERATE;
-        return result;
+
+    /* 4. New context on the shared weights */
+    pool_weights_t * w = &pool->weights[wi];
+    int ci = -1;
+    for (int i = 0; i < NEURONOS_POOL_MAX_CONTEXTS && ci < 0; i++)
+        if (!pool->ctxs[i].model)
+            ci = i;
+    if (ci < 0) {
+        /* Table full: recycle the LRU idle context */
+        pool_ctx_t * lru = NULL;
+        for (int i = 0; i < NEURONOS_POOL_MAX_CONTEXTS; i++) {
+            pool_ctx_t * c = &pool->ctxs[i];
+            if (!c->in_use && (!lru || c->last_used < lru->last_used))
+                lru = c;
+        }
+        if (!lru)
+            return NULL;
+        pool_drop_ctx(pool, lru);
+        ci = (int)(lru - pool->ctxs);
     }
 
-    /* --- Generation loop --- */
-    /* Output buffer: start with 4KB, grow as needed */
-    size_t out_cap = 4096;
-    size_t out_len = 0;
-    char * out_buf = malloc(out_cap);
-    if (!out_buf) {
-        free(prompt_tokens);
-        llama_sampler_free(smpl);
-        result.status = NEURONOS_ERROR_GENERATE;
-        return result;
+    neuronos_model_t * model = calloc(1, sizeof(neuronos_model_t));
+    if (!model)
+        return NULL;
+    model->engine = pool->engine;
+    model->llama_model = w->llama_model;
+    params.model_path = w->path; /* stable copy for the session hash */
+    if (!model_init_context(model, params)) {
+        free(model);
+        return NULL;
+    }
+    model->pool = pool;
+    w->n_contexts++;
+
+    pool_ctx_t * c = &pool->ctxs[ci];
+    c->model = model;
+    c->weights = wi;
+    c->params = params;
+    c->size_mb = (int64_t)model->context_size * neuronos_kv_mb_per_1k(params.kv_type) / 1024;
+    c->in_use = true;
+    c->last_used = w->last_used = ++pool->clock;
+
+    /* Make room for the new context (never evicts in-use handles) */
+    pool_evict(pool, 0);
+
+    if (pool->engine->verbose) {
+        neuronos_pool_stats_t ps = pool_stats_locked(pool);
+        fprintf(stderr, "[neuronos] Pool: %d models, %d contexts (%d in use), %lld/%lld MB\n", ps.n_models,
+                ps.n_contexts, ps.n_in_use, (long long)ps.used_mb, (long long)ps.budget_mb);
     }
+    return model;
+}
 
-    char piece_buf[256];
-    int n_generated = 0;
-    bool stop_requested = false;
+neuronos_model_t * neuronos_pool_acquire(neuronos_model_pool_t * pool, neuronos_model_params_t params) {
+    if (!pool || !params.model_path)
+        return NULL;
+    eng_mutex_lock(&pool->lock);
+    neuronos_model_t * model = pool_acquire_locked(pool, params);
+    eng_mutex_unlock(&pool->lock);
+    return model;
+}
 
-    for (int i = 0; i < max_tokens && !stop_requested; i++) {
-        /* Sample next token */
-        llama_token id = llama_sampler_sample(smpl, ctx, -1);
+void neuronos_pool_release(neuronos_model_pool_t * pool, neuronos_model_t * model) {
+    if (!pool || !model)
+        return;
+    eng_mutex_lock(&pool->lock);
+    for (int i = 0; i < NEURONOS_POOL_MAX_CONTEXTS; i++) {
+        pool_ctx_t * c = &pool->ctxs[i];
+        if (c->model != model)
+            continue;
+        c->in_use = false;
+        c->last_used = pool->weights[c->weights].last_used = ++pool->clock;
+        break;
+    }
+    pool_evict(pool, 0);
+    eng_mutex_unlock(&pool->lock);
+}
 
-        /* Check end of generation */
-        if (llama_token_is_eog(lmodel, id)) {
-            break;
-        }
+static neuronos_pool_stats_t pool_stats_locked(const neuronos_model_pool_t * pool) {
+    neuronos_pool_stats_t ps = {0};
+    for (int i = 0; i < NEURONOS_POOL_MAX_MODELS; i++)
+        if (pool->weights[i].llama_model)
+            ps.n_models++;
+    for (int i = 0; i < NEURONOS_POOL_MAX_CONTEXTS; i++) {
+        if (!pool->ctxs[i].model)
+            continue;
+        ps.n_contexts++;
+        if (pool->ctxs[i].in_use)
+            ps.n_in_use++;
+    }
+    ps.used_mb = pool_used_mb(pool);
+    ps.budget_mb = pool->budget_mb;
+    return ps;
+}
 
-        /* Detokenize */
-        int piece_len = llama_token_to_piece(lmodel, id, piece_buf, (int)sizeof(piece_buf) - 1, 0, true);
-        if (piece_len < 0)
-            piece_len = 0;
-        piece_buf[piece_len] = '\0';
-
-        /* Append to output buffer (grow if needed) */
-        while (out_len + (size_t)piece_len + 1 > out_cap) {
-            out_cap *= 2;
-            char * new_buf = realloc(out_buf, out_cap);
-            if (!new_buf) {
-                free(out_buf);
-                free(prompt_tokens);
-                llama_sampler_free(smpl);
-                result.status = NEURONOS_ERROR_GENERATE;
-                return result;
-            }
-            out_buf = new_buf;
-        }
-        memcpy(out_buf + out_len, piece_buf, (size_t)piece_len);
-        out_len += (size_t)piece_len;
+neuronos_pool_stats_t neuronos_pool_stats(const neuronos_model_pool_t * pool) {
+    if (!pool)
+        return (neuronos_pool_stats_t){0};
+    neuronos_model_pool_t * p = (neuronos_model_pool_t *)pool; /* the lock is not logical state */
+    eng_mutex_lock(&p->lock);
+    neuronos_pool_stats_t ps = pool_stats_locked(pool);
+    eng_mutex_unlock(&p->lock);
+    return ps;
+}
 
-        n_generated++;
+/* ============================================================
+ * KV CACHE REUSE
+ * ============================================================ */
 
-        /* Streaming callback */
-        if (params.on_token) {
-            if (!params.on_token(piece_buf, params.user_data)) {
-                stop_requested = true;
-                break;
-            }
-        }
+/* Forget everything in the KV cache. */
+static void kv_cache_reset(neuronos_model_t * model) {
+    llama_kv_cache_clear(model->llama_ctx);
+    model->n_cache_tokens = 0;
+}
 
-        /* Prepare next batch (single token) */
-        batch = llama_batch_get_one(&id, 1, n_prompt + i, 0);
-        rc = llama_decode(ctx, batch);
-        if (rc != 0) {
-            break;
-        }
+/* Keep the longest prefix of the cached sequence that matches `tokens`,
+ * drop the rest from the KV cache, and return the number of positions kept.
+ *
+ * At least one prompt token is always left to decode so the context
+ * has fresh logits for the first sampled token. */
+static int kv_cache_reuse_prefix(neuronos_model_t * model, const llama_token * tokens, int n_tokens) {
+    int n_keep = 0;
+    while (n_keep < model->n_cache_tokens && n_keep < n_tokens &&
+           model->cache_tokens[n_keep] == tokens[n_keep]) {
+        n_keep++;
     }
+    if (n_keep >= n_tokens)
+        n_keep = n_tokens - 1;
 
-    /* Null-terminate output */
-    out_buf[out_len] = '\0';
+    if (n_keep <= 0) {
+        kv_cache_reset(model);
+        return 0;
+    }
 
-    double t_end = get_time_ms();
-    double elapsed = t_end - t_start;
+    if (!llama_kv_cache_seq_rm(model->llama_ctx, 0, n_keep, -1)) {
+        /* Partial removal unsupported (e.g. recurrent state) — start over */
+        kv_cache_reset(model);
+        return 0;
+    }
+    model->n_cache_tokens = n_keep;
+    return n_keep;
+}
 
-    /* --- Build result --- */
-    result.text = out_buf;
-    result.n_tokens = n_generated;
-    result.elapsed_ms = elapsed;
-    result.tokens_per_s = elapsed > 0.0 ? (double)n_generated / (elapsed / 1000.0) : 0.0;
-    result.status = NEURONOS_OK;
+/* Drop cached positions [n, end) from seq 0. */
+static void kv_cache_truncate(neuronos_model_t * model, int n) {
+    if (n >= model->n_cache_tokens)
+        return;
+    llama_kv_cache_seq_rm(model->llama_ctx, 0, n, -1);
+    model->n_cache_tokens = n;
+}
 
-    if (model->engine->verbose) {
-        fprintf(stderr, "[neuronos] Generated %d tokens in %.1f ms (%.2f t/s)\n", n_generated, elapsed,
-                result.tokens_per_s);
+/* Start the scratch sequence on the longest cached prefix of `tokens`:
+ * seq 0's cells are shared, not copied, and seq 0 is left untouched.
+ * Returns the number of positions the scratch sequence starts with,
+ * or -1 if its own n_tokens - n_keep + max_tokens cells would not fit
+ * next to seq 0. */
+static int kv_scratch_fork(neuronos_model_t * model, const llama_token * tokens, int n_tokens, int max_tokens) {
+    llama_kv_cache_seq_rm(model->llama_ctx, SCRATCH_SEQ, -1, -1);
+    int n_keep = 0;
+    while (n_keep < model->n_cache_tokens && n_keep < n_tokens - 1 &&
+           model->cache_tokens[n_keep] == tokens[n_keep]) {
+        n_keep++;
     }
+    if (n_tokens - n_keep + max_tokens > model->context_size - model->n_cache_tokens)
+        return -1;
+    if (n_keep > 0)
+        llama_kv_cache_seq_cp(model->llama_ctx, 0, SCRATCH_SEQ, 0, n_keep);
+    return n_keep;
+}
 
-    /* --- Cleanup --- */
-    free(prompt_tokens);
-    llama_sampler_free(smpl);
+/* Record a token that has just been decoded at the end of seq 0. */
+static void kv_cache_push(neuronos_model_t * model, llama_token id) {
+    if (model->n_cache_tokens < model->context_size)
+        model->cache_tokens[model->n_cache_tokens++] = id;
+}
 
-    return result;
+/* Tokenize `text` (with BOS, parsing special tokens).
+ * Returns a malloc'd array and stores its length in *n_out, or NULL. */
+static llama_token * tokenize_prompt(const struct llama_model * lmodel, const char * text, int * n_out) {
+    int text_len = (int)strlen(text);
+    int n = -llama_tokenize(lmodel, text, text_len, NULL, 0, true, true);
+    if (n <= 0)
+        return NULL;
+
+    llama_token * tokens = malloc((size_t)n * sizeof(llama_token));
+    if (!tokens)
+        return NULL;
+    llama_tokenize(lmodel, text, text_len, tokens, n, true, true);
+    *n_out = n;
+    return tokens;
 }
 
-void neuronos_gen_result_free(neuronos_gen_result_t * result) {
-    if (!result)
-        return;
-    free(result->text);
-    result->text = NULL;
+/* ============================================================
+ * SESSION SNAPSHOTS
+ *
+ * File layout: session_header_t | llama_token[n_tokens] | state.
+ * The state blob is llama_state_seq_get_data() for seq 0. On load
+ * the file is memory-mapped and handed straight to llama.cpp.
+ * ============================================================ */
+
+#define SESSION_MAGIC   0x5345534eu /* "NSES" */
+#define SESSION_VERSION 1
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t model_hash;
+    uint64_t prompt_hash;
+    uint32_t n_tokens;
+    uint32_t reserved;
+    uint64_t state_size;
+} session_header_t;
+
+static uint64_t hash_tokens(const llama_token * tokens, int n) {
+    return fnv1a(FNV_OFFSET, tokens, (size_t)n * sizeof(llama_token));
 }
 
-void neuronos_free(void * ptr) {
-    free(ptr);
+neuronos_status_t neuronos_session_save(neuronos_model_t * model, const char * path) {
+    if (!model || !path || model->n_cache_tokens <= 0)
+        return NEURONOS_ERROR_INVALID_PARAM;
+
+    size_t state_size = llama_state_seq_get_size(model->llama_ctx, 0);
+    uint8_t * state = malloc(state_size);
+    if (!state)
+        return NEURONOS_ERROR_MEMORY;
+    state_size = llama_state_seq_get_data(model->llama_ctx, state, state_size, 0);
+    if (state_size == 0) {
+        free(state);
+        return NEURONOS_ERROR_GENERATE;
+    }
+
+    session_header_t hdr = {
+        .magic = SESSION_MAGIC,
+        .version = SESSION_VERSION,
+        .model_hash = model->model_hash,
+        .prompt_hash = hash_tokens(model->cache_tokens, model->n_cache_tokens),
+        .n_tokens = (uint32_t)model->n_cache_tokens,
+        .state_size = state_size,
+    };
+
+    /* Write to a temp file and rename so readers never see a partial snapshot */
+    size_t tmp_len = strlen(path) + 8;
+    char * tmp_path = malloc(tmp_len);
+    if (!tmp_path) {
+        free(state);
+        return NEURONOS_ERROR_MEMORY;
+    }
+    snprintf(tmp_path, tmp_len, "%s.tmp", path);
+
+    FILE * f = fopen(tmp_path, "wb");
+    bool ok = f != NULL;
+    if (ok) {
+        ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1 &&
+             fwrite(model->cache_tokens, sizeof(llama_token), (size_t)model->n_cache_tokens, f) ==
+                 (size_t)model->n_cache_tokens &&
+             fwrite(state, 1, state_size, f) == state_size;
+        ok = (fclose(f) == 0) && ok;
+    }
+    free(state);
+
+#ifdef _WIN32
+    if (ok)
+        remove(path); /* rename() does not overwrite on Windows */
+#endif
+    if (ok)
+        ok = rename(tmp_path, path) == 0;
+    if (!ok)
+        remove(tmp_path);
+    free(tmp_path);
+
+    if (model->engine->verbose) {
+        fprintf(stderr, "[neuronos] Session %s: %s (%d tokens, %.1f MB)\n", ok ? "saved" : "save FAILED", path,
+                model->n_cache_tokens, (double)state_size / (1024.0 * 1024.0));
+    }
+    return ok ? NEURONOS_OK : NEURONOS_ERROR_GENERATE;
+}
+
+/* Map (or read) a whole file. Returns NULL on failure. */
+static const uint8_t * session_map(const char * path, size_t * size_out) {
+#ifdef _WIN32
+    FILE * f = fopen(path, "rb");
+    if (!f)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    long sz = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t * buf = sz > 0 ? malloc((size_t)sz) : NULL;
+    if (!buf || fread(buf, 1, (size_t)sz, f) != (size_t)sz) {
+        free(buf);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+    *size_out = (size_t)sz;
+    return buf;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+    void * addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+        return NULL;
+    *size_out = (size_t)st.st_size;
+    return addr;
+#endif
+}
+
+static void session_unmap(const uint8_t * data, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    free((void *)data);
+#else
+    munmap((void *)data, size);
+#endif
+}
+
+/* Restore a snapshot. If expect_hash is non-zero the prompt hash must match. */
+static neuronos_status_t session_load(neuronos_model_t * model, const char * path, uint64_t expect_hash) {
+    size_t size = 0;
+    const uint8_t * data = session_map(path, &size);
+    if (!data)
+        return NEURONOS_ERROR_INVALID_PARAM;
+
+    neuronos_status_t status = NEURONOS_ERROR_INVALID_PARAM;
+    session_header_t hdr;
+    if (size < sizeof(hdr))
+        goto done;
+    memcpy(&hdr, data, sizeof(hdr));
+
+    size_t tokens_size = (size_t)hdr.n_tokens * sizeof(llama_token);
+    if (hdr.magic != SESSION_MAGIC || hdr.version != SESSION_VERSION || hdr.model_hash != model->model_hash ||
+        hdr.n_tokens == 0 || (int)hdr.n_tokens > model->context_size ||
+        size != sizeof(hdr) + tokens_size + hdr.state_size)
+        goto done;
+    if (expect_hash != 0 && hdr.prompt_hash != expect_hash)
+        goto done;
+
+    const llama_token * tokens = (const llama_token *)(data + sizeof(hdr));
+    if (hash_tokens(tokens, (int)hdr.n_tokens) != hdr.prompt_hash)
+        goto done;
+
+    kv_cache_reset(model);
+    if (llama_state_seq_set_data(model->llama_ctx, data + sizeof(hdr) + tokens_size, (size_t)hdr.state_size, 0) ==
+        0) {
+        kv_cache_reset(model);
+        status = NEURONOS_ERROR_GENERATE;
+        goto done;
+    }
+    memcpy(model->cache_tokens, tokens, tokens_size);
+    model->n_cache_tokens = (int)hdr.n_tokens;
+    status = NEURONOS_OK;
+
+    if (model->engine->verbose) {
+        fprintf(stderr, "[neuronos] Session restored: %s (%d tokens)\n", path, model->n_cache_tokens);
+    }
+
+done:
+    session_unmap(data, size);
+    return status;
+}
+
+neuronos_status_t neuronos_session_load(neuronos_model_t * model, const char * path) {
+    if (!model || !path)
+        return NEURONOS_ERROR_INVALID_PARAM;
+    return session_load(model, path, 0);
+}
+
+/* Prefill tokens[n_cache_tokens..n) onto seq 0. */
+static neuronos_status_t prefill_tokens(neuronos_model_t * model, llama_token * tokens, int n) {
+    const int n_batch = (int)model->cparams.n_batch;
+    for (int i = model->n_cache_tokens; i < n; i += n_batch) {
+        int n_eval = n - i;
+        if (n_eval > n_batch) n_eval = n_batch;
+        if (llama_decode(model->llama_ctx, llama_batch_get_one(tokens + i, n_eval, i, 0)) != 0) {
+            kv_cache_reset(model);
+            return NEURONOS_ERROR_GENERATE;
+        }
+        for (int j = 0; j < n_eval; j++)
+            kv_cache_push(model, tokens[i + j]);
+    }
+    return NEURONOS_OK;
+}
+
+neuronos_status_t neuronos_session_warm(neuronos_model_t * model, const char * prefix, const char * cache_dir) {
+    if (!model || !prefix || !prefix[0])
+        return NEURONOS_ERROR_INVALID_PARAM;
+
+    int n_tokens = 0;
+    llama_token * tokens = tokenize_prompt(model->llama_model, prefix, &n_tokens);
+    if (!tokens)
+        return NEURONOS_ERROR_GENERATE;
+    if (n_tokens >= model->context_size) {
+        free(tokens);
+        return NEURONOS_ERROR_CONTEXT_FULL;
+    }
+
+    /* Already resident (e.g. a previous warm in this process)? */
+    if (model->n_cache_tokens >= n_tokens &&
+        memcmp(model->cache_tokens, tokens, (size_t)n_tokens * sizeof(llama_token)) == 0) {
+        free(tokens);
+        return NEURONOS_OK;
+    }
+
+    /* Resolve <cache_dir>/<model_hash>-<prompt_hash>.session, default ~/.neuronos/sessions */
+    char dir[512];
+    if (cache_dir && cache_dir[0]) {
+        snprintf(dir, sizeof(dir), "%s", cache_dir);
+    } else {
+        const char * home = getenv("HOME");
+#ifdef _WIN32
+        if (!home) home = getenv("USERPROFILE");
+#endif
+        if (!home) home = "/tmp";
+        snprintf(dir, sizeof(dir), "%s/.neuronos", home);
+        neuronos_mkdir(dir);
+        snprintf(dir, sizeof(dir), "%s/.neuronos/sessions", home);
+    }
+    neuronos_mkdir(dir);
+
+    uint64_t prompt_hash = hash_tokens(tokens, n_tokens);
+    char path[640];
+    snprintf(path, sizeof(path), "%s/%016llx-%016llx.session", dir, (unsigned long long)model->model_hash,
+             (unsigned long long)prompt_hash);
+
+    if (session_load(model, path, prompt_hash) == NEURONOS_OK) {
+        free(tokens);
+        return NEURONOS_OK;
+    }
+
+    /* Miss: prefill the prefix (reusing whatever matches) and snapshot it */
+    kv_cache_reuse_prefix(model, tokens, n_tokens);
+    neuronos_status_t status = prefill_tokens(model, tokens, n_tokens);
+    free(tokens);
+    if (status != NEURONOS_OK)
+        return status;
+
+    /* Snapshot failures are not fatal: the prefix is in the KV cache either way */
+    neuronos_session_save(model, path);
+    return NEURONOS_OK;
+}
+
+/* ============================================================
+ * SAMPLING
+ * ============================================================ */
+
+/* Bumped by neuronos_sampler_cache_invalidate(), from any thread (e.g.
+ * a tool registry change); older entries are dropped */
+static volatile uint64_t g_sampler_epoch = 0;
+
+void neuronos_sampler_cache_invalidate(void) {
+    eng_atomic_inc64(&g_sampler_epoch);
+}
+
+static void sampler_cache_clear(sampler_cache_entry_t * e) {
+    if (e->chain)
+        llama_sampler_free(e->chain);
+    free(e->grammar);
+    free(e->grammar_root);
+    memset(e, 0, sizeof(*e));
+}
+
+/* Build the sampler chain for one generation request:
+ * grammar → penalties → top-k → top-p → temperature → dist (or greedy). */
+static struct llama_sampler * new_sampler(const struct llama_model * lmodel, const sampler_cache_entry_t * p) {
+    struct llama_sampler * smpl = llama_sampler_chain_init(llama_sampler_chain_default_params());
+
+    /* Add grammar sampler if grammar provided */
+    if (p->grammar && p->grammar[0]) {
+        struct llama_sampler * grammar_smpl = llama_sampler_init_grammar(lmodel, p->grammar, p->grammar_root);
+        if (grammar_smpl) {
+            llama_sampler_chain_add(smpl, grammar_smpl);
+        }
+    }
+
+    /* Standard sampling: penalties → top-k → top-p → temperature → dist */
+    if (p->repeat_penalty != 1.0f) {
+        int32_t n_vocab = llama_n_vocab(lmodel);
+        llama_token eos_id = llama_token_eos(lmodel);
+        llama_token nl_id  = llama_token_nl(lmodel);
+        llama_sampler_chain_add(smpl,
+            llama_sampler_init_penalties(n_vocab, eos_id, nl_id,
+                                        p->repeat_last_n, p->repeat_penalty,
+                                        0.0f, 0.0f,   /* freq_penalty, presence_penalty */
+                                        false, false)); /* penalize_nl, ignore_eos */
+    }
+    llama_sampler_chain_add(smpl, llama_sampler_init_top_k(p->top_k));
+    llama_sampler_chain_add(smpl, llama_sampler_init_top_p(p->top_p, 1));
+
+    if (p->temperature > 0.0f) {
+        /* seed 0: llama.cpp draws a fresh random seed on every reset */
+        llama_sampler_chain_add(smpl, llama_sampler_init_temp(p->temperature));
+        llama_sampler_chain_add(smpl, llama_sampler_init_dist(p->seed > 0 ? p->seed : LLAMA_DEFAULT_SEED));
+    } else {
+        llama_sampler_chain_add(smpl, llama_sampler_init_greedy());
+    }
+
+    return smpl;
+}
+
+/* Return a fresh chain for params; the caller frees it.
+ * Grammar chains are compiled once per (grammar, sampling params) and
+ * handed out as clones: cloning copies the parsed rules, whereas
+ * llama_sampler_init_grammar (and reset) parse the GBNF again. */
+static struct llama_sampler * build_sampler(neuronos_model_t * model, const neuronos_gen_params_t * params) {
+    sampler_cache_entry_t want = {
+        .grammar = (char *)params->grammar,
+        .grammar_root = (char *)(params->grammar_root ? params->grammar_root : "root"),
+        .temperature = params->temperature >= 0.0f ? params->temperature : 0.7f,
+        .top_p = params->top_p > 0.0f ? params->top_p : 0.95f,
+        .top_k = params->top_k > 0 ? params->top_k : 40,
+        .repeat_penalty = params->repeat_penalty > 0.0f ? params->repeat_penalty : 1.1f,
+        .repeat_last_n = params->repeat_last_n > 0 ? params->repeat_last_n : 64,
+        .seed = params->seed,
+    };
+
+    /* Chains without grammar are cheap to build and not worth a slot */
+    if (!want.grammar || !want.grammar[0])
+        return new_sampler(model->llama_model, &want);
+
+    uint64_t key = fnv1a(FNV_OFFSET, want.grammar, strlen(want.grammar));
+    key = fnv1a(key, want.grammar_root, strlen(want.grammar_root));
+    key = fnv1a(key, &want.temperature, sizeof(want.temperature));
+    key = fnv1a(key, &want.top_p, sizeof(want.top_p));
+    key = fnv1a(key, &want.top_k, sizeof(want.top_k));
+    key = fnv1a(key, &want.repeat_penalty, sizeof(want.repeat_penalty));
+    key = fnv1a(key, &want.repeat_last_n, sizeof(want.repeat_last_n));
+    key = fnv1a(key, &want.seed, sizeof(want.seed));
+
+    /* Read once: an entry built while the epoch moves is stamped stale */
+    const uint64_t epoch = eng_atomic_load64(&g_sampler_epoch);
+    sampler_cache_entry_t * hit = NULL;
+    sampler_cache_entry_t * victim = &model->sampler_cache[0];
+    for (int i = 0; i < SAMPLER_CACHE_SIZE; i++) {
+        sampler_cache_entry_t * e = &model->sampler_cache[i];
+        if (e->chain && e->epoch != epoch)
+            sampler_cache_clear(e);
+        if (e->chain && e->key == key && strcmp(e->grammar, want.grammar) == 0 &&
+            strcmp(e->grammar_root, want.grammar_root) == 0 && e->temperature == want.temperature &&
+            e->top_p == want.top_p && e->top_k == want.top_k && e->repeat_penalty == want.repeat_penalty &&
+            e->repeat_last_n == want.repeat_last_n && e->seed == want.seed) {
+            hit = e;
+            break;
+        }
+        if (!e->chain || (victim->chain && e->last_used < victim->last_used))
+            victim = e;
+    }
+
+    if (!hit) {
+        double t0 = get_time_ms();
+        struct llama_sampler * chain = new_sampler(model->llama_model, &want);
+        char * grammar = strdup(want.grammar);
+        char * grammar_root = strdup(want.grammar_root);
+        if (!grammar || !grammar_root) {
+            free(grammar);
+            free(grammar_root);
+            return chain; /* uncached, still usable */
+        }
+        sampler_cache_clear(victim);
+        hit = victim;
+        *hit = want;
+        hit->key = key;
+        hit->epoch = epoch;
+        hit->grammar = grammar;
+        hit->grammar_root = grammar_root;
+        hit->chain = chain;
+        if (model->engine->verbose) {
+            fprintf(stderr, "[neuronos] Grammar sampler compiled in %.1f ms (cached)\n", get_time_ms() - t0);
+        }
+    }
+    hit->last_used = ++model->sampler_clock;
+
+    struct llama_sampler * smpl = llama_sampler_clone(hit->chain);
+    if (smpl && want.temperature > 0.0f && want.seed == 0) {
+        /* The clone copies the template's RNG state; reseed dist (last in chain) */
+        llama_sampler_reset(llama_sampler_chain_get(smpl, llama_sampler_chain_n(smpl) - 1));
+    }
+    return smpl;
+}
+
+/* Detokenize `id` and append it to a growable, NUL-terminated buffer.
+ * The piece is also written to `piece_buf` (NUL-terminated).
+ * Returns false on allocation failure. */
+static bool append_piece(const struct llama_model * lmodel, llama_token id, char * piece_buf, size_t piece_cap,
+                         char ** out_buf, size_t * out_len, size_t * out_cap) {
+    int piece_len = llama_token_to_piece(lmodel, id, piece_buf, (int)piece_cap - 1, 0, true);
+    if (piece_len < 0)
+        piece_len = 0;
+    piece_buf[piece_len] = '\0';
+
+    while (*out_len + (size_t)piece_len + 1 > *out_cap) {
+        size_t new_cap = *out_cap * 2;
+        char * new_buf = realloc(*out_buf, new_cap);
+        if (!new_buf)
+            return false;
+        *out_buf = new_buf;
+        *out_cap = new_cap;
+    }
+    memcpy(*out_buf + *out_len, piece_buf, (size_t)piece_len);
+    *out_len += (size_t)piece_len;
+    (*out_buf)[*out_len] = '\0';
+    return true;
+}
+
+/* is_cancelled poll, once per decode step */
+static bool gen_cancelled(const neuronos_gen_params_t * params) {
+    return params->is_cancelled && params->is_cancelled(params->user_data);
+}
+
+/* ---- Coalesced streaming (on_stream + flush policy) ---- */
+typedef struct {
+    neuronos_stream_cb cb;
+    void * user_data;
+    neuronos_flush_policy_t policy;
+    llama_token * ids; /* tokens since the last flush */
+    int n_ids;
+    int cap;
+    size_t text_start; /* first unflushed byte of the output buffer */
+    double t_last;
+    bool stopped; /* callback returned false */
+} token_stream_t;
+
+static bool stream_init(token_stream_t * st, const neuronos_gen_params_t * params, int max_tokens) {
+    memset(st, 0, sizeof(*st));
+    if (!params->on_stream)
+        return true;
+    st->ids = malloc((size_t)(max_tokens > 0 ? max_tokens : 1) * sizeof(llama_token));
+    if (!st->ids)
+        return false;
+    st->cb = params->on_stream;
+    st->user_data = params->user_data;
+    st->policy = params->flush;
+    st->cap = max_tokens > 0 ? max_tokens : 1;
+    st->t_last = get_time_ms();
+    return true;
+}
+
+static void stream_free(token_stream_t * st) {
+    free(st->ids);
+    st->ids = NULL;
+    st->cb = NULL;
+}
+
+/* Bytes at the end of buf that start a UTF-8 character not yet complete */
+static size_t utf8_incomplete_tail(const char * buf, size_t len) {
+    size_t n = 0;
+    while (n < len && n < 4) {
+        unsigned char c = (unsigned char)buf[len - 1 - n];
+        n++;
+        if ((c & 0xC0) == 0x80)
+            continue; /* continuation byte */
+        size_t need = c < 0x80 ? 1 : (c & 0xE0) == 0xC0 ? 2 : (c & 0xF0) == 0xE0 ? 3 : (c & 0xF8) == 0xF0 ? 4 : 1;
+        return n < need ? n : 0;
+    }
+    return 0;
+}
+
+static bool stream_flush(token_stream_t * st, const char * buf, size_t end) {
+    if (st->stopped || (st->n_ids == 0 && end == st->text_start))
+        return !st->stopped;
+    bool ok = st->cb(st->ids, st->n_ids, buf + st->text_start, end - st->text_start, st->user_data);
+    st->text_start = end;
+    st->n_ids = 0;
+    st->t_last = get_time_ms();
+    st->stopped = !ok;
+    return ok;
+}
+
+/* Record one emitted token (already appended to buf). Returns false if
+ * the callback asked to stop. */
+static bool stream_push(token_stream_t * st, llama_token id, const char * buf, size_t len) {
+    if (!st->cb)
+        return true;
+    if (st->n_ids == st->cap && !stream_flush(st, buf, len))
+        return false;
+    st->ids[st->n_ids++] = id;
+
+    if (utf8_incomplete_tail(buf, len) > 0)
+        return true; /* never split a character */
+
+    const neuronos_flush_policy_t * p = &st->policy;
+    bool any = p->every_n_tokens > 0 || p->every_ms > 0 || p->on_word;
+    bool flush = !any || (p->every_n_tokens > 0 && st->n_ids >= p->every_n_tokens);
+    if (!flush && p->every_ms > 0 && get_time_ms() - st->t_last >= (double)p->every_ms)
+        flush = true;
+    if (!flush && p->on_word && len > st->text_start) {
+        unsigned char c = (unsigned char)buf[len - 1];
+        flush = c < 0x80 && (isspace(c) || ispunct(c));
+    }
+    return flush ? stream_flush(st, buf, len) : true;
+}
+
+/* Deliver whatever is still buffered once generation has ended */
+static void stream_finish(token_stream_t * st, const char * buf, size_t len) {
+    if (st->cb)
+        stream_flush(st, buf, len);
+    stream_free(st);
+}
+
+/* Derive rates from the phase timings and feed the process-wide
+ * histograms. n_prefilled = prompt tokens actually evaluated,
+ * n_sampled = sampler calls (generated tokens + the final EOG). */
+static void finish_gen_timings(neuronos_gen_result_t * r, int n_prefilled, int n_sampled, double t_first,
+                               double t_end) {
+    r->prefill_tokens_per_s = r->prefill_ms > 0.0 ? (double)n_prefilled / (r->prefill_ms / 1000.0) : 0.0;
+    double t_after_first = t_end - t_first;
+    if (r->n_tokens > 1 && t_after_first > 0.0) {
+        r->decode_tokens_per_s = (double)(r->n_tokens - 1) / (t_after_first / 1000.0);
+        neuronos_metrics_record(NEURONOS_METRIC_TPOT, t_after_first / (double)(r->n_tokens - 1));
+    }
+    if (n_sampled > 0) {
+        neuronos_metrics_record(NEURONOS_METRIC_TTFT, r->ttft_ms);
+        neuronos_metrics_record(NEURONOS_METRIC_SAMPLE, r->sample_ms / (double)n_sampled);
+    }
+    if (n_prefilled > 0)
+        neuronos_metrics_record(NEURONOS_METRIC_PREFILL, r->prefill_ms);
+    neuronos_metrics_record(NEURONOS_METRIC_GENERATE, r->elapsed_ms);
+
+    neuronos_metrics_add(NEURONOS_COUNTER_GENERATIONS, 1);
+    neuronos_metrics_add(NEURONOS_COUNTER_PROMPT_TOKENS, (uint64_t)r->n_prompt_tokens);
+    neuronos_metrics_add(NEURONOS_COUNTER_REUSED_TOKENS, (uint64_t)r->n_reused_tokens);
+    neuronos_metrics_add(NEURONOS_COUNTER_GENERATED_TOKENS, (uint64_t)r->n_tokens);
+}
+
+/* ============================================================
+ * SPECULATIVE DECODING
+ *
+ * The draft model proposes up to n_draft tokens greedily; the target
+ * evaluates the pending token plus all drafts in one llama_decode and
+ * samples with its own chain at every position. Drafts are accepted
+ * while they equal the target's sample; the first mismatch is replaced
+ * by the target's token. Every emitted token is therefore drawn from
+ * the target distribution (for any temperature and grammar) — the
+ * draft only decides how many positions are verified per decode.
+ * ============================================================ */
+
+static bool draft_compatible(const neuronos_model_t * model, const neuronos_model_t * draft) {
+    return draft && draft != model && draft->llama_model &&
+           llama_n_vocab(draft->llama_model) == llama_n_vocab(model->llama_model) &&
+           llama_token_eos(draft->llama_model) == llama_token_eos(model->llama_model);
+}
+
+static neuronos_gen_result_t generate_speculative(neuronos_model_t * model, neuronos_model_t * draft,
+                                                  const neuronos_gen_params_t * params, llama_token * prompt_tokens,
+                                                  int n_prompt, int max_tokens, double t_start) {
+    neuronos_gen_result_t result = {0};
+    struct llama_model * lmodel = model->llama_model;
+    int n_draft = params->n_draft > 0 ? params->n_draft : 5;
+
+    /* Full token sequence (prompt + generated); the last entry is pending */
+    int seq_cap = n_prompt + max_tokens + 1;
+    llama_token * seq = malloc((size_t)seq_cap * sizeof(llama_token));
+    size_t out_cap = 4096;
+    size_t out_len = 0;
+    char * out_buf = malloc(out_cap);
+    struct llama_batch batch = llama_batch_init(n_draft + 1, 0, 1);
+    struct llama_sampler * smpl = build_sampler(model, params);
+    struct llama_sampler * dsmpl = llama_sampler_chain_init(llama_sampler_chain_default_params());
+    llama_sampler_chain_add(dsmpl, llama_sampler_init_greedy());
+    llama_token * drafts = malloc((size_t)n_draft * sizeof(llama_token));
+    token_stream_t stream;
+    bool stream_ok = stream_init(&stream, params, max_tokens);
+
+    if (!seq || !out_buf || !drafts || !stream_ok) {
+        result.status = NEURONOS_ERROR_GENERATE;
+        goto cleanup;
+    }
+    memcpy(seq, prompt_tokens, (size_t)n_prompt * sizeof(llama_token));
+    int n_cur = n_prompt;
+    out_buf[0] = '\0';
+
+    /* Prefill everything but the last prompt token on both models */
+    int n_reused = kv_cache_reuse_prefix(model, prompt_tokens, n_prompt);
+    kv_cache_reuse_prefix(draft, prompt_tokens, n_prompt);
+    double t_phase = get_time_ms();
+    if (prefill_tokens(model, prompt_tokens, n_prompt - 1) != NEURONOS_OK ||
+        prefill_tokens(draft, prompt_tokens, n_prompt - 1) != NEURONOS_OK) {
+        result.status = NEURONOS_ERROR_GENERATE;
+        goto cleanup;
+    }
+    result.prefill_ms = get_time_ms() - t_phase;
+
+    char piece_buf[256];
+    int n_generated = 0;
+    int n_sampled = 0;
+    double t_first = 0.0;
+    bool done = false;
+    bool cancelled = false;
+    neuronos_status_t status = NEURONOS_OK;
+
+    while (!done && n_generated < max_tokens) {
+        if (gen_cancelled(params)) {
+            cancelled = true;
+            break;
+        }
+
+        /* --- 1. Draft: catch up on seq, then propose k tokens --- */
+        int k = n_draft;
+        if (k > max_tokens - n_generated - 1)
+            k = max_tokens - n_generated - 1;
+        if (n_cur + k + 1 > draft->context_size)
+            k = draft->context_size - n_cur - 1;
+        if (k < 0)
+            k = 0;
+
+        int n_drafted = 0;
+        t_phase = get_time_ms();
+        if (k > 0 && prefill_tokens(draft, seq, n_cur) == NEURONOS_OK) {
+            for (; n_drafted < k; n_drafted++) {
+                llama_token d = llama_sampler_sample(dsmpl, draft->llama_ctx, -1);
+                drafts[n_drafted] = d;
+                if (llama_token_is_eog(lmodel, d) || n_drafted + 1 == k) {
+                    n_drafted++;
+                    break;
+                }
+                if (llama_decode(draft->llama_ctx, llama_batch_get_one(&drafts[n_drafted], 1, n_cur + n_drafted, 0)) !=
+                    0) {
+                    kv_cache_reset(draft);
+                    n_drafted++;
+                    break;
+                }
+                kv_cache_push(draft, d);
+            }
+        }
+
+        /* --- 2. Target: pending token + drafts in one batch --- */
+        if (prefill_tokens(model, seq, n_cur - 1) != NEURONOS_OK) {
+            status = NEURONOS_ERROR_GENERATE;
+            break;
+        }
+        batch.n_tokens = 0;
+        batch_add(&batch, seq[n_cur - 1], n_cur - 1, 0, true);
+        for (int i = 0; i < n_drafted; i++)
+            batch_add(&batch, drafts[i], n_cur + i, 0, true);
+        if (llama_decode(model->llama_ctx, batch) != 0) {
+            kv_cache_reset(model);
+            status = NEURONOS_ERROR_GENERATE;
+            break;
+        }
+        result.decode_ms += get_time_ms() - t_phase;
+        kv_cache_push(model, seq[n_cur - 1]);
+        for (int i = 0; i < n_drafted; i++)
+            kv_cache_push(model, drafts[i]);
+
+        /* --- 3. Verify: sample the target at each position --- */
+        int n_ok = 0;
+        for (int i = 0; i <= n_drafted; i++) {
+            t_phase = get_time_ms();
+            llama_token id = llama_sampler_sample(smpl, model->llama_ctx, i);
+            double t_sampled = get_time_ms();
+            result.sample_ms += t_sampled - t_phase;
+            if (n_sampled++ == 0) {
+                t_first = t_sampled;
+                result.ttft_ms = t_first - t_start;
+            }
+            if (llama_token_is_eog(lmodel, id)) {
+                done = true;
+                break;
+            }
+            if (!append_piece(lmodel, id, piece_buf, sizeof(piece_buf), &out_buf, &out_len, &out_cap)) {
+                status = NEURONOS_ERROR_GENERATE;
+                done = true;
+                break;
+            }
+            seq[n_cur++] = id;
+            n_generated++;
+
+            if (params->on_token && !params->on_token(piece_buf, params->user_data)) {
+                done = true;
+                break;
+            }
+            if (!stream_push(&stream, id, out_buf, out_len)) {
+                done = true;
+                break;
+            }
+            if (n_generated >= max_tokens || i == n_drafted || id != drafts[i])
+                break;
+            n_ok++;
+        }
+
+        result.n_drafted += n_drafted;
+        result.n_accepted += n_ok;
+
+        /* Keep only KV entries that match seq; the newest token stays pending */
+        kv_cache_truncate(model, n_cur - 1);
+        kv_cache_truncate(draft, n_cur - 1);
+    }
+
+    if (status != NEURONOS_OK) {
+        result.status = status;
+        goto cleanup;
+    }
+
+    stream_finish(&stream, out_buf, out_len);
+
+    double t_end = get_time_ms();
+    double elapsed = t_end - t_start;
+    result.text = out_buf;
+    out_buf = NULL;
+    result.n_tokens = n_generated;
+    result.elapsed_ms = elapsed;
+    result.tokens_per_s = elapsed > 0.0 ? (double)n_generated / (elapsed / 1000.0) : 0.0;
+    result.acceptance_rate = result.n_drafted > 0 ? (double)result.n_accepted / (double)result.n_drafted : 0.0;
+    result.n_prompt_tokens = n_prompt;
+    result.n_reused_tokens = n_reused;
+    result.status = cancelled ? NEURONOS_ERROR_CANCELLED : NEURONOS_OK;
+    /* The pending token (last prompt token) is evaluated with the first verify batch */
+    finish_gen_timings(&result, n_prompt - 1 - n_reused, n_sampled, t_first, t_end);
+
+    if (model->engine->verbose) {
+        fprintf(stderr,
+                "[neuronos] Generated %d tokens in %.1f ms (%.2f t/s, %d/%d prompt tokens reused, "
+                "draft accepted %d/%d = %.0f%%)\n",
+                n_generated, elapsed, result.tokens_per_s, n_reused, n_prompt, result.n_accepted, result.n_drafted,
+                result.acceptance_rate * 100.0);
+    }
+
+cleanup:
+    stream_free(&stream);
+    free(drafts);
+    llama_sampler_free(dsmpl);
+    llama_sampler_free(smpl);
+    llama_batch_free(batch);
+    free(out_buf);
+    free(seq);
+    return result;
+}
+
+/* ============================================================
+ * GENERATE
+ * ============================================================ */
+
+neuronos_gen_result_t neuronos_generate(neuronos_model_t * model, neuronos_gen_params_t params) {
+    neuronos_gen_result_t result = {0};
+
+    if (!model || !params.prompt) {
+        result.status = NEURONOS_ERROR_INVALID_PARAM;
+        return result;
+    }
+
+    double t_start = get_time_ms();
+    struct llama_model * lmodel = model->llama_model;
+    struct llama_context * ctx = model->llama_ctx;
+
+    /* --- Defaults --- */
+    int max_tokens = params.max_tokens > 0 ? params.max_tokens : 256;
+
+    /* --- Tokenize prompt --- */
+    int n_prompt = 0;
+    llama_token * prompt_tokens = tokenize_prompt(lmodel, params.prompt, &n_prompt);
+    if (!prompt_tokens) {
+        result.status = NEURONOS_ERROR_GENERATE;
+        return result;
+    }
+
+    /* --- Check context size --- */
+    if (n_prompt + max_tokens > model->context_size) {
+        max_tokens = model->context_size - n_prompt;
+        if (max_tokens <= 0) {
+            free(prompt_tokens);
+            result.status = NEURONOS_ERROR_CONTEXT_FULL;
+            return result;
+        }
+    }
+
+    /* --- Speculative path (draft model proposes, target verifies) --- */
+    if (params.draft_model && !params.scratch_seq) {
+        if (draft_compatible(model, params.draft_model)) {
+            result = generate_speculative(model, params.draft_model, &params, prompt_tokens, n_prompt, max_tokens,
+                                          t_start);
+            free(prompt_tokens);
+            return result;
+        }
+        if (model->engine->verbose) {
+            fprintf(stderr, "[neuronos] Draft model vocabulary mismatch — speculative decoding disabled\n");
+        }
+    }
+
+    /* --- Reuse the cached prefix, drop the stale tail --- */
+    const bool scratch = params.scratch_seq;
+    const llama_seq_id seq = scratch ? SCRATCH_SEQ : 0;
+    int n_reused = scratch ? kv_scratch_fork(model, prompt_tokens, n_prompt, max_tokens)
+                           : kv_cache_reuse_prefix(model, prompt_tokens, n_prompt);
+    if (n_reused < 0) {
+        free(prompt_tokens);
+        result.status = NEURONOS_ERROR_CONTEXT_FULL;
+        return result;
+    }
+
+    /* --- Create sampler chain --- */
+    struct llama_sampler * smpl = build_sampler(model, &params);
+
+    /* --- Evaluate prompt (chunked to fit n_batch) --- */
+    const int n_batch = (int)model->cparams.n_batch;
+    struct llama_batch batch;
+    int rc = 0;
+    bool cancelled = false;
+    double t_phase = get_time_ms();
+    for (int i = n_reused; i < n_prompt; i += n_batch) {
+        if (gen_cancelled(&params)) {
+            cancelled = true;
+            break;
+        }
+        int n_eval = n_prompt - i;
+        if (n_eval > n_batch) n_eval = n_batch;
+        batch = llama_batch_get_one(prompt_tokens + i, n_eval, i, seq);
+        rc = llama_decode(ctx, batch);
+        if (rc != 0) break;
+        for (int j = 0; !scratch && j < n_eval; j++)
+            kv_cache_push(model, prompt_tokens[i + j]);
+    }
+    result.prefill_ms = get_time_ms() - t_phase;
+    if (rc != 0 || cancelled) {
+        if (scratch)
+            llama_kv_cache_seq_rm(ctx, SCRATCH_SEQ, -1, -1);
+        else if (rc != 0)
+            kv_cache_reset(model);
+        free(prompt_tokens);
+        llama_sampler_free(smpl);
+        result.status = cancelled ? NEURONOS_ERROR_CANCELLED : NEURONOS_ERROR_GENERATE;
+        return result;
+    }
+
+    /* --- Generation loop --- */
+    /* Output buffer: start with 4KB, grow as needed */
+    size_t out_cap = 4096;
+    size_t out_len = 0;
+    char * out_buf = malloc(out_cap);
+    token_stream_t stream;
+    if (!out_buf || !stream_init(&stream, &params, max_tokens)) {
+        if (scratch)
+            llama_kv_cache_seq_rm(ctx, SCRATCH_SEQ, -1, -1);
+        free(out_buf);
+        free(prompt_tokens);
+        llama_sampler_free(smpl);
+        result.status = NEURONOS_ERROR_GENERATE;
+        return result;
+    }
+
+    char piece_buf[256];
+    int n_generated = 0;
+    int n_sampled = 0;
+    double t_first = 0.0;
+    bool stop_requested = false;
+    bool truncated = false;
+
+    for (int i = 0; i < max_tokens && !stop_requested; i++) {
+        if (gen_cancelled(&params)) {
+            cancelled = true;
+            break;
+        }
+
+        /* Sample next token */
+        t_phase = get_time_ms();
+        llama_token id = llama_sampler_sample(smpl, ctx, -1);
+        double t_sampled = get_time_ms();
+        result.sample_ms += t_sampled - t_phase;
+        if (n_sampled++ == 0) {
+            t_first = t_sampled;
+            result.ttft_ms = t_first - t_start;
+        }
+
+        /* Check end of generation */
+        if (llama_token_is_eog(lmodel, id)) {
+            break;
+        }
+
+        /* Detokenize and append to output buffer (grows as needed) */
+        if (!append_piece(lmodel, id, piece_buf, sizeof(piece_buf), &out_buf, &out_len, &out_cap)) {
+            if (scratch)
+                llama_kv_cache_seq_rm(ctx, SCRATCH_SEQ, -1, -1);
+            stream_free(&stream);
+            free(out_buf);
+            free(prompt_tokens);
+            llama_sampler_free(smpl);
+            result.status = NEURONOS_ERROR_GENERATE;
+            return result;
+        }
+
+        n_generated++;
+
+        /* Streaming callbacks */
+        if (params.on_token) {
+            if (!params.on_token(piece_buf, params.user_data)) {
+                stop_requested = true;
+                break;
+            }
+        }
+        if (!stream_push(&stream, id, out_buf, out_len)) {
+            stop_requested = true;
+            break;
+        }
+
+        /* Prepare next batch (single token) */
+        batch = llama_batch_get_one(&id, 1, n_prompt + i, seq);
+        t_phase = get_time_ms();
+        rc = llama_decode(ctx, batch);
+        result.decode_ms += get_time_ms() - t_phase;
+        if (rc != 0) {
+            if (!scratch)
+                kv_cache_reset(model);
+            truncated = true;
+            break;
+        }
+        if (!scratch)
+            kv_cache_push(model, id);
+    }
+    /* Scratch generations leave nothing behind, and a cut-off one is
+     * an error: its caller (e.g. compaction) would keep the fragment */
+    if (scratch)
+        llama_kv_cache_seq_rm(ctx, SCRATCH_SEQ, -1, -1);
+    if (scratch && truncated) {
+        stream_free(&stream);
+        free(out_buf);
+        free(prompt_tokens);
+        llama_sampler_free(smpl);
+        result.status = NEURONOS_ERROR_GENERATE;
+        return result;
+    }
+
+    /* Null-terminate output */
+    out_buf[out_len] = '\0';
+    stream_finish(&stream, out_buf, out_len);
+
+    double t_end = get_time_ms();
+    double elapsed = t_end - t_start;
+
+    /* --- Build result --- */
+    result.text = out_buf;
+    result.n_tokens = n_generated;
+    result.elapsed_ms = elapsed;
+    result.tokens_per_s = elapsed > 0.0 ? (double)n_generated / (elapsed / 1000.0) : 0.0;
+    result.n_prompt_tokens = n_prompt;
+    result.n_reused_tokens = n_reused;
+    result.status = cancelled ? NEURONOS_ERROR_CANCELLED : NEURONOS_OK;
+    finish_gen_timings(&result, n_prompt - n_reused, n_sampled, t_first, t_end);
+
+    if (model->engine->verbose) {
+        fprintf(stderr,
+                "[neuronos] Generated %d tokens in %.1f ms (%.2f t/s, %d/%d prompt tokens reused)\n"
+                "[neuronos]   ttft %.1f ms | prefill %.1f ms (%.1f t/s) | decode %.1f ms (%.2f t/s) | "
+                "sample %.1f ms\n",
+                n_generated, elapsed, result.tokens_per_s, n_reused, n_prompt, result.ttft_ms, result.prefill_ms,
+                result.prefill_tokens_per_s, result.decode_ms, result.decode_tokens_per_s, result.sample_ms);
+    }
+
+    /* --- Cleanup --- */
+    free(prompt_tokens);
+    llama_sampler_free(smpl);
+
+    return result;
+}
+
+void neuronos_gen_result_free(neuronos_gen_result_t * result) {
+    if (!result)
+        return;
+    free(result->text);
+    result->text = NULL;
+}
+
+void neuronos_free(void * ptr) {
+    free(ptr);
+}
+
+/* ============================================================
+ * SCHEDULER (continuous batching)
+ *
+ * One llama_context with n_slots sequences. Each step decodes the
+ * pending token of every generating slot and spends the remaining
+ * batch budget on prompt chunks of newly admitted slots.
+ *
+ * A slot's tokens[] mirror its KV cells and survive take(), so the
+ * next request can resume from the longest common prefix. Slots
+ * that are reassigned are first copied out with
+ * llama_state_seq_get_data() into an LRU list of snapshots.
+ * ============================================================ */
+
+#define SCHED_CACHE_MB_DEFAULT  256
+#define SCHED_SLOT_CTX_MIN      512 /* smallest default slot context */
+#define SCHED_SNAPSHOT_MIN_KEEP 64 /* don't snapshot shorter tails */
+
+typedef enum {
+    SLOT_FREE = 0,
+    SLOT_PREFILL, /* prompt partially evaluated          */
+    SLOT_DECODE,  /* generating, one token per step      */
+    SLOT_DONE,    /* finished, result waiting for take() */
+} sched_slot_state_t;
+
+typedef struct {
+    sched_slot_state_t state;
+    int request_id;
+    llama_seq_id seq_id;
+
+    /* Token at every position submitted to the KV cache (slot_ctx);
+     * kept across requests, valid up to n_past. */
+    llama_token * tokens;
+    int n_prompt;
+    int n_past;         /* positions already submitted to the KV cache */
+    uint64_t last_used; /* sched->clock at the last submit             */
+    int max_tokens;
+    int n_generated;
+
+    llama_token pending; /* sampled token awaiting decode          */
+    int i_batch;         /* logits row in current batch, -1 = none */
+    bool in_batch;
+    int batch_from;      /* n_past before this step's batch was built */
+
+    struct llama_sampler * smpl;
+    neuronos_token_cb on_token;
+    neuronos_cancel_cb is_cancelled;
+    void * user_data;
+    token_stream_t stream;
+
+    char * out_buf;
+    size_t out_len;
+    size_t out_cap;
+
+    double t_start;
+    double t_first; /* first token sampled */
+    int n_sampled;
+    neuronos_gen_result_t stats; /* timings handed out by take() */
+    neuronos_status_t status;
+} sched_slot_t;
+
+typedef struct sched_snapshot {
+    llama_token * tokens;
+    int n_tokens;
+    uint8_t * state; /* llama_state_seq_get_data() blob */
+    size_t state_size;
+    uint64_t last_used;
+    struct sched_snapshot * next;
+} sched_snapshot_t;
+
+struct neuronos_scheduler {
+    neuronos_model_t * model;
+    struct llama_context * ctx;
+    struct llama_batch batch;
+    int n_batch;
+    int n_slots;
+    int slot_ctx;
+    sched_slot_t * slots;
+    int next_request_id;
+    uint64_t clock;
+
+    /* KV state of conversations evicted from their slot, LRU by last_used */
+    sched_snapshot_t * snapshots;
+    size_t cache_bytes;
+    size_t cache_budget;
+};
+
+/* KV occupancy for /metrics. The server runs one scheduler. */
+static void sched_publish_gauges(const neuronos_scheduler_t * sched) {
+    int64_t used = 0;
+    for (int i = 0; i < sched->n_slots; i++)
+        used += sched->slots[i].n_past;
+    neuronos_metrics_gauge_set(NEURONOS_GAUGE_KV_USED, used);
+    neuronos_metrics_gauge_set(NEURONOS_GAUGE_KV_SIZE, (int64_t)sched->n_slots * sched->slot_ctx);
+    neuronos_metrics_gauge_set(NEURONOS_GAUGE_KV_SNAPSHOT_BYTES, (int64_t)sched->cache_bytes);
+}
+
+static void sched_snapshot_free(sched_snapshot_t * snap) {
+    free(snap->tokens);
+    free(snap->state);
+    free(snap);
+}
+
+/* Drop least recently used snapshots until `need` more bytes fit. */
+static void sched_cache_evict(neuronos_scheduler_t * sched, size_t need) {
+    while (sched->snapshots && sched->cache_bytes + need > sched->cache_budget) {
+        sched_snapshot_t ** lru = &sched->snapshots;
+        for (sched_snapshot_t ** it = &sched->snapshots; *it; it = &(*it)->next) {
+            if ((*it)->last_used < (*lru)->last_used)
+                lru = it;
+        }
+        sched_snapshot_t * victim = *lru;
+        *lru = victim->next;
+        sched->cache_bytes -= victim->state_size;
+        sched_snapshot_free(victim);
+    }
+}
+
+static int common_prefix(const llama_token * a, int n_a, const llama_token * b, int n_b) {
+    int n = 0;
+    while (n < n_a && n < n_b && a[n] == b[n])
+        n++;
+    return n;
+}
+
+/* Copy a free slot's KV state into the snapshot cache before the slot
+ * is reused. Snapshots that are a prefix of it are superseded. */
+static void sched_snapshot_store(neuronos_scheduler_t * sched, sched_slot_t * slot) {
+    if (sched->cache_budget == 0 || slot->n_past < SCHED_SNAPSHOT_MIN_KEEP)
+        return;
+
+    size_t size = llama_state_seq_get_size(sched->ctx, slot->seq_id);
+    if (size == 0 || size > sched->cache_budget)
+        return;
+
+    for (sched_snapshot_t ** it = &sched->snapshots; *it;) {
+        sched_snapshot_t * snap = *it;
+        if (snap->n_tokens <= slot->n_past &&
+            common_prefix(snap->tokens, snap->n_tokens, slot->tokens, slot->n_past) == snap->n_tokens) {
+            *it = snap->next;
+            sched->cache_bytes -= snap->state_size;
+            sched_snapshot_free(snap);
+        } else {
+            it = &snap->next;
+        }
+    }
+    sched_cache_evict(sched, size);
+
+    sched_snapshot_t * snap = calloc(1, sizeof(sched_snapshot_t));
+    if (!snap)
+        return;
+    snap->tokens = malloc((size_t)slot->n_past * sizeof(llama_token));
+    snap->state = malloc(size);
+    if (!snap->tokens || !snap->state) {
+        sched_snapshot_free(snap);
+        return;
+    }
+    snap->state_size = llama_state_seq_get_data(sched->ctx, snap->state, size, slot->seq_id);
+    if (snap->state_size == 0) {
+        sched_snapshot_free(snap);
+        return;
+    }
+    memcpy(snap->tokens, slot->tokens, (size_t)slot->n_past * sizeof(llama_token));
+    snap->n_tokens = slot->n_past;
+    snap->last_used = slot->last_used;
+    snap->next = sched->snapshots;
+    sched->snapshots = snap;
+    sched->cache_bytes += snap->state_size;
+}
+
+/*
+ * Point a free slot at `prompt`: pick the cached prefix that matches
+ * best (a warm slot or a snapshot), make it resident and drop the
+ * stale tail. Returns the slot with n_past set to the reused length
+ * (always < n_prompt, so the last prompt token yields fresh logits),
+ * or NULL if every slot is busy.
+ */
+static sched_slot_t * sched_slot_acquire(neuronos_scheduler_t * sched, const llama_token * prompt, int n_prompt) {
+    sched_slot_t * best = NULL;
+    sched_slot_t * lru = NULL;
+    int best_keep = 0;
+    for (int i = 0; i < sched->n_slots; i++) {
+        sched_slot_t * slot = &sched->slots[i];
+        if (slot->state != SLOT_FREE)
+            continue;
+        int keep = common_prefix(slot->tokens, slot->n_past, prompt, n_prompt);
+        if (!best || keep > best_keep || (keep == best_keep && slot->last_used < best->last_used)) {
+            best = slot;
+            best_keep = keep;
+        }
+        if (!lru || slot->last_used < lru->last_used)
+            lru = slot;
+    }
+    if (!best)
+        return NULL;
+
+    sched_snapshot_t ** snap_it = NULL;
+    int snap_keep = best_keep;
+    for (sched_snapshot_t ** it = &sched->snapshots; *it; it = &(*it)->next) {
+        int keep = common_prefix((*it)->tokens, (*it)->n_tokens, prompt, n_prompt);
+        if (keep > snap_keep) {
+            snap_it = it;
+            snap_keep = keep;
+        }
+    }
+
+    sched_slot_t * slot = best;
+    int keep = best_keep;
+    if (snap_it) {
+        /* Restore into the coldest slot; the snapshot becomes live again */
+        sched_snapshot_t * snap = *snap_it;
+        *snap_it = snap->next;
+        sched->cache_bytes -= snap->state_size;
+
+        slot = lru;
+        sched_snapshot_store(sched, slot);
+        llama_kv_cache_seq_rm(sched->ctx, slot->seq_id, -1, -1);
+        slot->n_past = 0;
+        keep = 0;
+        if (llama_state_seq_set_data(sched->ctx, snap->state, snap->state_size, slot->seq_id) != 0) {
+            memcpy(slot->tokens, snap->tokens, (size_t)snap->n_tokens * sizeof(llama_token));
+            slot->n_past = snap->n_tokens;
+            keep = snap_keep;
+        }
+        sched_snapshot_free(snap);
+    } else if (slot->n_past - keep >= SCHED_SNAPSHOT_MIN_KEEP) {
+        sched_snapshot_store(sched, slot); /* another conversation's history */
+    }
+
+    if (keep >= n_prompt)
+        keep = n_prompt - 1;
+    if (keep <= 0 || !llama_kv_cache_seq_rm(sched->ctx, slot->seq_id, keep, -1)) {
+        llama_kv_cache_seq_rm(sched->ctx, slot->seq_id, -1, -1);
+        keep = 0;
+    }
+    slot->n_past = keep;
+    return slot;
+}
+
+/* Move a slot to DONE and release its sampler. The KV cells stay
+ * for the next request unless decoding failed (a cancelled slot's
+ * cells are all valid). */
+static void sched_slot_finish(neuronos_scheduler_t * sched, sched_slot_t * slot, neuronos_status_t status) {
+    stream_finish(&slot->stream, slot->out_buf, slot->out_len);
+    llama_sampler_free(slot->smpl);
+    slot->smpl = NULL;
+    if (status != NEURONOS_OK && status != NEURONOS_ERROR_CANCELLED) {
+        llama_kv_cache_seq_rm(sched->ctx, slot->seq_id, -1, -1);
+        slot->n_past = 0;
+    }
+
+    double t_end = get_time_ms();
+    slot->state = SLOT_DONE;
+    slot->status = status;
+    slot->stats.n_tokens = slot->n_generated;
+    slot->stats.elapsed_ms = t_end - slot->t_start;
+    slot->stats.tokens_per_s =
+        slot->stats.elapsed_ms > 0.0 ? (double)slot->n_generated / (slot->stats.elapsed_ms / 1000.0) : 0.0;
+    slot->stats.n_prompt_tokens = slot->n_prompt;
+    /* Prefill shares decode batches with other slots, so it is folded into TTFT */
+    if (status == NEURONOS_OK)
+        finish_gen_timings(&slot->stats, 0, slot->n_sampled, slot->t_first, t_end);
+
+    if (sched->model->engine->verbose) {
+        fprintf(stderr, "[neuronos] Request %d (seq %d): %d tokens in %.1f ms (ttft %.1f ms, %d/%d prompt tokens reused)\n",
+                slot->request_id, (int)slot->seq_id, slot->n_generated, slot->stats.elapsed_ms, slot->stats.ttft_ms,
+                slot->stats.n_reused_tokens, slot->n_prompt);
+    }
+}
+
+/* Reset a slot to FREE, keeping its cached tokens */
+static void sched_slot_clear(sched_slot_t * slot) {
+    sched_slot_t keep = *slot;
+    stream_free(&slot->stream);
+    llama_sampler_free(slot->smpl);
+    free(slot->out_buf);
+    memset(slot, 0, sizeof(*slot));
+    slot->seq_id = keep.seq_id;
+    slot->tokens = keep.tokens;
+    slot->n_past = keep.n_past;
+    slot->last_used = keep.last_used;
+}
+
+/* Default per-slot context. The scheduler's KV cache is allocated next to
+ * the model's own context, which auto-tuning already sized to the RAM
+ * budget: split that context across the slots, then shrink further if
+ * the budget left after the weights and the model's KV can't hold it. */
+int neuronos_scheduler_slot_ctx(const neuronos_model_t * model, int n_slots) {
+    if (!model || !model->llama_model)
+        return 0;
+    if (n_slots <= 0)
+        n_slots = 4;
+    const int floor_ctx = model->context_size < SCHED_SLOT_CTX_MIN ? model->context_size : SCHED_SLOT_CTX_MIN;
+    int slot_ctx = model->context_size / n_slots;
+
+    neuronos_kv_type_t kv_type = model->cparams.type_k == GGML_TYPE_Q8_0   ? NEURONOS_KV_Q8_0
+                                 : model->cparams.type_k == GGML_TYPE_Q4_0 ? NEURONOS_KV_Q4_0
+                                                                           : NEURONOS_KV_F16;
+    const int64_t kv_mb_per_1k = neuronos_kv_mb_per_1k(kv_type);
+    const int64_t used_mb = (int64_t)(llama_model_size(model->llama_model) / (1024 * 1024)) +
+                            (int64_t)model->context_size * kv_mb_per_1k / 1024;
+    const int64_t left_mb = neuronos_detect_hardware().model_budget_mb - used_mb;
+    const int64_t fit = left_mb > 0 ? left_mb * 1024 / kv_mb_per_1k / n_slots : 0;
+    if (fit < slot_ctx)
+        slot_ctx = (int)fit;
+
+    return slot_ctx < floor_ctx ? floor_ctx : slot_ctx;
+}
+
+neuronos_scheduler_t * neuronos_scheduler_create(neuronos_model_t * model, neuronos_scheduler_params_t params) {
+    if (!model || !model->llama_model)
+        return NULL;
+
+    neuronos_scheduler_t * sched = calloc(1, sizeof(neuronos_scheduler_t));
+    if (!sched)
+        return NULL;
+
+    sched->model = model;
+    sched->n_slots = params.n_slots > 0 ? params.n_slots : 4;
+    sched->slot_ctx = params.slot_ctx > 0 ? params.slot_ctx : neuronos_scheduler_slot_ctx(model, sched->n_slots);
+    sched->n_batch = params.n_batch > 0 ? params.n_batch : (int)model->cparams.n_batch;
+    int cache_mb = params.cache_mb == 0 ? SCHED_CACHE_MB_DEFAULT : params.cache_mb;
+    sched->cache_budget = cache_mb > 0 ? (size_t)cache_mb * 1024 * 1024 : 0;
+    if (sched->n_batch < sched->n_slots)
+        sched->n_batch = sched->n_slots; /* room for one token per slot */
+
+    /* Same settings as the model's own context, sized for n_slots sequences */
+    struct llama_context_params cparams = model->cparams;
+    cparams.n_ctx = (uint32_t)(sched->slot_ctx * sched->n_slots);
+    cparams.n_batch = (uint32_t)sched->n_batch;
+    cparams.n_seq_max = (uint32_t)sched->n_slots;
+
+    sched->ctx = llama_new_context_with_model(model->llama_model, cparams);
+    if (!sched->ctx) {
+        if (model->engine->verbose) {
+            fprintf(stderr, "[neuronos] ERROR: Failed to create scheduler context\n");
+        }
+        free(sched);
+        return NULL;
+    }
+
+    sched->slots = calloc((size_t)sched->n_slots, sizeof(sched_slot_t));
+    if (!sched->slots) {
+        llama_free(sched->ctx);
+        free(sched);
+        return NULL;
+    }
+    for (int i = 0; i < sched->n_slots; i++) {
+        sched->slots[i].seq_id = (llama_seq_id)i;
+        sched->slots[i].tokens = malloc((size_t)sched->slot_ctx * sizeof(llama_token));
+        if (!sched->slots[i].tokens) {
+            neuronos_scheduler_free(sched);
+            return NULL;
+        }
+    }
+
+    sched->batch = llama_batch_init(sched->n_batch, 0, 1);
+    sched_publish_gauges(sched);
+
+    if (model->engine->verbose) {
+        fprintf(stderr, "[neuronos] Scheduler: %d slots x %d ctx, n_batch=%d\n", sched->n_slots, sched->slot_ctx,
+                sched->n_batch);
+    }
+
+    return sched;
+}
+
+void neuronos_scheduler_free(neuronos_scheduler_t * sched) {
+    if (!sched)
+        return;
+    for (int i = 0; i < sched->n_slots && sched->slots; i++) {
+        sched_slot_clear(&sched->slots[i]);
+        free(sched->slots[i].tokens);
+    }
+    while (sched->snapshots) {
+        sched_snapshot_t * snap = sched->snapshots;
+        sched->snapshots = snap->next;
+        sched_snapshot_free(snap);
+    }
+    free(sched->slots);
+    llama_batch_free(sched->batch);
+    neuronos_metrics_gauge_set(NEURONOS_GAUGE_KV_USED, 0);
+    neuronos_metrics_gauge_set(NEURONOS_GAUGE_KV_SIZE, 0);
+    neuronos_metrics_gauge_set(NEURONOS_GAUGE_KV_SNAPSHOT_BYTES, 0);
+    llama_free(sched->ctx);
+    free(sched);
+}
+
+int neuronos_scheduler_submit(neuronos_scheduler_t * sched, neuronos_gen_params_t params) {
+    if (!sched || !params.prompt)
+        return -1;
+
+    bool any_free = false;
+    for (int i = 0; i < sched->n_slots && !any_free; i++)
+        any_free = sched->slots[i].state == SLOT_FREE;
+    if (!any_free)
+        return -1;
+
+    const struct llama_model * lmodel = sched->model->llama_model;
+
+    int n_prompt = 0;
+    llama_token * tokens = tokenize_prompt(lmodel, params.prompt, &n_prompt);
+    if (!tokens)
+        return -1;
+
+    int max_tokens = params.max_tokens > 0 ? params.max_tokens : 256;
+    if (n_prompt + max_tokens > sched->slot_ctx) {
+        max_tokens = sched->slot_ctx - n_prompt;
+        if (max_tokens <= 0) {
+            free(tokens);
+            return -1;
+        }
+    }
+
+    sched_slot_t * slot = sched_slot_acquire(sched, tokens, n_prompt);
+    memcpy(slot->tokens + slot->n_past, tokens + slot->n_past, (size_t)(n_prompt - slot->n_past) * sizeof(llama_token));
+    free(tokens);
+    slot->last_used = ++sched->clock;
+
+    slot->out_cap = 4096;
+    slot->out_buf = malloc(slot->out_cap);
+    if (!slot->out_buf || !stream_init(&slot->stream, &params, max_tokens)) {
+        free(slot->out_buf);
+        slot->out_buf = NULL;
+        sched_publish_gauges(sched);
+        return -1;
+    }
+    slot->out_buf[0] = '\0';
+    slot->out_len = 0;
+
+    slot->n_prompt = n_prompt;
+    slot->stats.n_reused_tokens = slot->n_past;
+    slot->max_tokens = max_tokens;
+    slot->n_generated = 0;
+    slot->i_batch = -1;
+    slot->smpl = build_sampler(sched->model, &params);
+    slot->on_token = params.on_token;
+    slot->is_cancelled = params.is_cancelled;
+    slot->user_data = params.user_data;
+    slot->t_start = get_time_ms();
+    slot->status = NEURONOS_OK;
+
+    if (sched->next_request_id < 0)
+        sched->next_request_id = 0;
+    slot->request_id = sched->next_request_id++;
+
+    slot->state = SLOT_PREFILL;
+    sched_publish_gauges(sched);
+
+    return slot->request_id;
+}
+
+int neuronos_scheduler_active(const neuronos_scheduler_t * sched) {
+    if (!sched)
+        return 0;
+    int n = 0;
+    for (int i = 0; i < sched->n_slots; i++) {
+        if (sched->slots[i].state == SLOT_PREFILL || sched->slots[i].state == SLOT_DECODE)
+            n++;
+    }
+    return n;
+}
+
+/* Fill sched->batch with at most `budget` tokens: first one pending
+ * token per generating slot, then prompt chunks. Slots left out wait
+ * for the next step. */
+static void sched_batch_fill(neuronos_scheduler_t * sched, int budget) {
+    struct llama_batch * batch = &sched->batch;
+    batch->n_tokens = 0;
+
+    for (int i = 0; i < sched->n_slots; i++) {
+        sched_slot_t * slot = &sched->slots[i];
+        slot->i_batch = -1;
+        slot->in_batch = false;
+        slot->batch_from = slot->n_past;
+        if (slot->state != SLOT_DECODE || batch->n_tokens >= budget)
+            continue;
+        batch_add(batch, slot->pending, slot->n_past, slot->seq_id, true);
+        slot->i_batch = batch->n_tokens - 1;
+        slot->in_batch = true;
+        slot->tokens[slot->n_past++] = slot->pending;
+    }
+
+    for (int i = 0; i < sched->n_slots && batch->n_tokens < budget; i++) {
+        sched_slot_t * slot = &sched->slots[i];
+        if (slot->state != SLOT_PREFILL)
+            continue;
+
+        int n_eval = slot->n_prompt - slot->n_past;
+        if (n_eval > budget - batch->n_tokens)
+            n_eval = budget - batch->n_tokens;
+
+        for (int j = 0; j < n_eval; j++) {
+            int pos = slot->n_past + j;
+            bool last = (pos == slot->n_prompt - 1);
+            batch_add(batch, slot->tokens[pos], pos, slot->seq_id, last);
+            if (last)
+                slot->i_batch = batch->n_tokens - 1;
+        }
+        slot->n_past += n_eval;
+        slot->in_batch = true;
+    }
+}
+
+/* Take back a batch llama_decode could not place: drop whatever cells
+ * earlier ubatches already filled and rewind the slots, so the same
+ * tokens can be submitted again. */
+static void sched_batch_undo(neuronos_scheduler_t * sched) {
+    for (int i = 0; i < sched->n_slots; i++) {
+        sched_slot_t * slot = &sched->slots[i];
+        if (!slot->in_batch)
+            continue;
+        llama_kv_cache_seq_rm(sched->ctx, slot->seq_id, slot->batch_from, -1);
+        slot->n_past = slot->batch_from;
+        slot->i_batch = -1;
+        slot->in_batch = false;
+    }
+}
+
+int neuronos_scheduler_step(neuronos_scheduler_t * sched) {
+    if (!sched)
+        return NEURONOS_ERROR_INVALID_PARAM;
+
+    struct llama_batch * batch = &sched->batch;
+
+    /* 0. Drop requests whose caller gave up */
+    for (int i = 0; i < sched->n_slots; i++) {
+        sched_slot_t * slot = &sched->slots[i];
+        if ((slot->state == SLOT_PREFILL || slot->state == SLOT_DECODE) && slot->is_cancelled &&
+            slot->is_cancelled(slot->user_data))
+            sched_slot_finish(sched, slot, NEURONOS_ERROR_CANCELLED);
+    }
+
+    /* 1. One pending token per generating slot, 2. prompt chunks with
+     * the rest of the budget. When the KV cache has no room for the
+     * batch (rc 1), retry with half of it; what is left out runs next
+     * step. Only a hard error or a single token that doesn't fit
+     * fails slots. */
+    int budget = sched->n_batch;
+    for (;;) {
+        sched_batch_fill(sched, budget);
+        if (batch->n_tokens == 0)
+            return neuronos_scheduler_active(sched);
+
+        int rc = llama_decode(sched->ctx, *batch);
+        if (rc == 0)
+            break;
+        if (rc > 0 && batch->n_tokens > 1) {
+            budget = batch->n_tokens / 2;
+            sched_batch_undo(sched);
+            continue;
+        }
+        if (sched->model->engine->verbose)
+            fprintf(stderr, "[neuronos] Scheduler decode failed (rc=%d, %d tokens)\n", rc, batch->n_tokens);
+        for (int i = 0; i < sched->n_slots; i++) {
+            if (sched->slots[i].in_batch)
+                sched_slot_finish(sched, &sched->slots[i], NEURONOS_ERROR_GENERATE);
+        }
+        return NEURONOS_ERROR_GENERATE;
+    }
+
+    /* 3. Sample for every slot that produced logits */
+    const struct llama_model * lmodel = sched->model->llama_model;
+    char piece_buf[256];
+
+    for (int i = 0; i < sched->n_slots; i++) {
+        sched_slot_t * slot = &sched->slots[i];
+        if (slot->i_batch < 0)
+            continue;
+
+        double t_phase = get_time_ms();
+        llama_token id = llama_sampler_sample(slot->smpl, sched->ctx, slot->i_batch);
+        double t_sampled = get_time_ms();
+        slot->stats.sample_ms += t_sampled - t_phase;
+        if (slot->n_sampled++ == 0) {
+            slot->t_first = t_sampled;
+            slot->stats.ttft_ms = t_sampled - slot->t_start;
+        }
+
+        if (llama_token_is_eog(lmodel, id)) {
+            sched_slot_finish(sched, slot, NEURONOS_OK);
+            continue;
+        }
+
+        if (!append_piece(lmodel, id, piece_buf, sizeof(piece_buf), &slot->out_buf, &slot->out_len,
+                          &slot->out_cap)) {
+            sched_slot_finish(sched, slot, NEURONOS_ERROR_GENERATE);
+            continue;
+        }
+        slot->n_generated++;
+
+        if (slot->on_token && !slot->on_token(piece_buf, slot->user_data)) {
+            sched_slot_finish(sched, slot, NEURONOS_OK);
+            continue;
+        }
+        if (!stream_push(&slot->stream, id, slot->out_buf, slot->out_len)) {
+            sched_slot_finish(sched, slot, NEURONOS_OK);
+            continue;
+        }
+        if (slot->n_generated >= slot->max_tokens) {
+            sched_slot_finish(sched, slot, NEURONOS_OK);
+            continue;
+        }
+
+        slot->pending = id;
+        slot->state = SLOT_DECODE;
+    }
+
+    sched_publish_gauges(sched);
+    return neuronos_scheduler_active(sched);
+}
+
+neuronos_status_t neuronos_scheduler_run(neuronos_scheduler_t * sched) {
+    if (!sched)
+        return NEURONOS_ERROR_INVALID_PARAM;
+
+    neuronos_status_t status = NEURONOS_OK;
+    while (neuronos_scheduler_active(sched) > 0) {
+        int rc = neuronos_scheduler_step(sched);
+        if (rc < 0)
+            status = (neuronos_status_t)rc; /* failed slots are already DONE */
+    }
+    return status;
+}
+
+bool neuronos_scheduler_take(neuronos_scheduler_t * sched, int request_id, neuronos_gen_result_t * result) {
+    if (!sched || !result || request_id < 0)
+        return false;
+
+    for (int i = 0; i < sched->n_slots; i++) {
+        sched_slot_t * slot = &sched->slots[i];
+        if (slot->state != SLOT_DONE || slot->request_id != request_id)
+            continue;
+
+        *result = slot->stats;
+        result->text = slot->out_buf;
+        result->status = slot->status;
+
+        slot->out_buf = NULL; /* ownership moves to the caller */
+        sched_slot_clear(slot);
+        return true;
+    }
+    return false;
+}
+
+/* ============================================================
+ * EMBEDDINGS
+ * ============================================================ */
+
+#define EMBED_SEQ_TOKENS 256 /* longer texts are truncated */
+#define EMBED_SEQS       8   /* texts per decode */
+
+/* Same settings as the model's context, with mean pooling and room for
+ * EMBED_SEQS sequences. Each sequence must fit in one ubatch to pool. */
+static bool embed_ctx_init(neuronos_model_t * model) {
+    if (model->embd_ctx)
+        return true;
+    struct llama_context_params cparams = model->cparams;
+    cparams.n_ctx = EMBED_SEQ_TOKENS * EMBED_SEQS;
+    cparams.n_batch = cparams.n_ctx;
+    cparams.n_ubatch = cparams.n_ctx;
+    cparams.n_seq_max = EMBED_SEQS;
+    cparams.embeddings = true;
+    cparams.pooling_type = LLAMA_POOLING_TYPE_MEAN;
+    model->embd_ctx = llama_new_context_with_model(model->llama_model, cparams);
+    if (!model->embd_ctx && model->engine->verbose) {
+        fprintf(stderr, "[neuronos] ERROR: Failed to create embedding context\n");
+    }
+    return model->embd_ctx != NULL;
+}
+
+neuronos_status_t neuronos_embed(neuronos_model_t * model, const char * const * texts, int n, float * out) {
+    if (!model || !model->llama_model || !texts || n < 0 || !out)
+        return NEURONOS_ERROR_INVALID_PARAM;
+    if (n == 0)
+        return NEURONOS_OK;
+    if (!embed_ctx_init(model))
+        return NEURONOS_ERROR_INIT;
+
+    const int n_embd = llama_n_embd(model->llama_model);
+    struct llama_batch batch = llama_batch_init(EMBED_SEQ_TOKENS * EMBED_SEQS, 0, 1);
+    llama_token * tokens = NULL;
+    int tokens_cap = 0;
+    neuronos_status_t status = NEURONOS_OK;
+
+    for (int i = 0; i < n && status == NEURONOS_OK; i += EMBED_SEQS) {
+        int m = n - i < EMBED_SEQS ? n - i : EMBED_SEQS;
+        llama_kv_cache_clear(model->embd_ctx);
+        batch.n_tokens = 0;
+
+        bool empty[EMBED_SEQS] = {false};
+        for (int s = 0; s < m; s++) {
+            const char * text = texts[i + s] ? texts[i + s] : "";
+            int text_len = (int)strlen(text);
+            int nt = -llama_tokenize(model->llama_model, text, text_len, NULL, 0, true, false);
+            if (nt > tokens_cap) {
+                llama_token * tmp = realloc(tokens, (size_t)nt * sizeof(llama_token));
+                if (!tmp) {
+                    status = NEURONOS_ERROR_GENERATE;
+                    break;
+                }
+                tokens = tmp;
+                tokens_cap = nt;
+            }
+            if (nt > 0)
+                llama_tokenize(model->llama_model, text, text_len, tokens, nt, true, false);
+            if (nt > EMBED_SEQ_TOKENS)
+                nt = EMBED_SEQ_TOKENS;
+            empty[s] = nt <= 0;
+            for (int t = 0; t < nt; t++)
+                batch_add(&batch, tokens[t], t, s, true);
+        }
+        if (status != NEURONOS_OK)
+            break;
+        if (batch.n_tokens > 0 && llama_decode(model->embd_ctx, batch) != 0) {
+            status = NEURONOS_ERROR_GENERATE;
+            break;
+        }
+
+        for (int s = 0; s < m; s++) {
+            float * dst = out + (size_t)(i + s) * (size_t)n_embd;
+            const float * e = empty[s] ? NULL : llama_get_embeddings_seq(model->embd_ctx, s);
+            if (!e) {
+                memset(dst, 0, (size_t)n_embd * sizeof(float));
+                continue;
+            }
+            double norm = 0.0;
+            for (int d = 0; d < n_embd; d++)
+                norm += (double)e[d] * e[d];
+            float scale = norm > 0.0 ? (float)(1.0 / sqrt(norm)) : 0.0f;
+            for (int d = 0; d < n_embd; d++)
+                dst[d] = e[d] * scale;
+        }
+    }
+
+    free(tokens);
+    llama_batch_free(batch);
+    return status;
 }
 
 /* ============================================================
@@ -0,0 +1,569 @@
+/* ============================================================
+ * NeuronOS — Metrics Registry
+ *
+ * Fixed-bucket histograms, counters and gauges shared by the whole
+ * process. The engine records per-phase timings of every generation,
+ * the server its queueing, tools and memory their latency; the
+ * server and CLI read them back as percentiles or Prometheus text.
+ *
+ * Every thread records into its own shard, so the hot path is a
+ * handful of relaxed stores with no shared cache lines. Readers walk
+ * the shard list and merge. A thread's shard is handed back when the
+ * thread exits and the next new thread adopts it, totals included,
+ * so short-lived workers don't grow the list.
+ * ============================================================ */
+#include "neuronos/neuronos.h"
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #define METRICS_TLS __declspec(thread)
+    /* Aligned 64-bit accesses are atomic on the 64-bit targets we build */
+    #define metrics_load(p) (*(volatile uint64_t *)(p))
+    #define metrics_store(p, v) (*(volatile uint64_t *)(p) = (v))
+    #define metrics_load_acq(p) InterlockedCompareExchange((volatile LONG *)(p), 0, 0)
+    #define metrics_store_rel(p, v) InterlockedExchange((volatile LONG *)(p), (LONG)(v))
+    #define metrics_gauge_load(p) InterlockedCompareExchange64((p), 0, 0)
+    #define metrics_gauge_store(p, v) InterlockedExchange64((p), (v))
+    #define metrics_gauge_add(p, v) InterlockedExchangeAdd64((p), (v))
+    #define metrics_cas_ptr(p, expected, desired) \
+        (InterlockedCompareExchangePointer((PVOID volatile *)(p), (desired), (expected)) == (expected))
+    #define metrics_try_lock(p) (InterlockedExchange((volatile LONG *)(p), 1) == 0)
+    #define metrics_unlock(p) InterlockedExchange((volatile LONG *)(p), 0)
+    #define metrics_load_ptr(p) InterlockedCompareExchangePointer((PVOID volatile *)(p), NULL, NULL)
+#else
+    #include <pthread.h>
+    #define METRICS_TLS __thread
+    #define metrics_load(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+    #define metrics_store(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+    #define metrics_load_acq(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define metrics_store_rel(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+    #define metrics_gauge_load(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+    #define metrics_gauge_store(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+    #define metrics_gauge_add(p, v) __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+    #define metrics_cas_ptr(p, expected, desired) \
+        __atomic_compare_exchange_n((p), &(expected), (desired), false, __ATOMIC_RELEASE, __ATOMIC_RELAXED)
+    #define metrics_try_lock(p) (__atomic_exchange_n((p), 1, __ATOMIC_ACQUIRE) == 0)
+    #define metrics_unlock(p) __atomic_store_n((p), 0, __ATOMIC_RELEASE)
+    #define metrics_load_ptr(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#endif
+
+#define METRICS_MAX_SERIES 64
+#define METRICS_LABEL_MAX  32
+
+/* Bucket upper bounds (ms). Roughly 1-2-5 steps from sub-ms sampler
+ * calls up to multi-second prefills of long prompts. */
+static const double BUCKET_LE[NEURONOS_HIST_BUCKETS - 1] = {
+    0.1, 0.25, 0.5, 1, 2.5, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 10000,
+};
+
+static const char * METRIC_NAMES[NEURONOS_METRIC_COUNT] = {
+    "ttft", "prefill", "tpot", "sample", "generate", "queue_wait", "tool", "memory",
+};
+
+/* Prometheus metadata. Labelled families export only their series. */
+static const struct {
+    const char * name;
+    const char * label; /* label key, or NULL */
+    const char * help;
+} METRIC_PROM[NEURONOS_METRIC_COUNT] = {
+    {"neuronos_ttft_seconds", NULL, "Time from request start to the first sampled token"},
+    {"neuronos_prefill_seconds", NULL, "Prompt evaluation time of the uncached prompt part"},
+    {"neuronos_tpot_seconds", NULL, "Time per output token after the first"},
+    {"neuronos_sample_seconds", NULL, "Sampler chain time per sampled token"},
+    {"neuronos_generate_seconds", NULL, "Whole generation time"},
+    {"neuronos_queue_wait_seconds", NULL, "Time a generation waited for a scheduler slot"},
+    {"neuronos_tool_seconds", "tool", "Tool execution time"},
+    {"neuronos_memory_op_seconds", "op", "SQLite statement time in the memory store"},
+};
+
+static const struct {
+    const char * name;
+    const char * help;
+} COUNTER_PROM[NEURONOS_COUNTER_COUNT] = {
+    {"neuronos_http_requests_total", "HTTP requests received"},
+    {"neuronos_generations_total", "Finished generations"},
+    {"neuronos_prompt_tokens_total", "Prompt tokens of finished generations"},
+    {"neuronos_prompt_tokens_reused_total", "Prompt tokens served from the KV cache instead of prefilled"},
+    {"neuronos_generated_tokens_total", "Tokens generated"},
+    {"neuronos_tool_errors_total", "Tool executions that returned an error"},
+    {"neuronos_cancelled_total", "Generations stopped because the client disconnected"},
+    {"neuronos_rejected_total", "Inference requests refused with 429 / 503"},
+    {"neuronos_tool_cache_hits_total", "Tool calls answered from the result cache"},
+    {"neuronos_tool_cache_misses_total", "Cacheable tool calls that ran the tool"},
+};
+
+static const struct {
+    const char * name;
+    const char * help;
+} GAUGE_PROM[NEURONOS_GAUGE_COUNT] = {
+    {"neuronos_generations_in_flight", "Generations and agent runs currently executing"},
+    {"neuronos_generations_queued", "Generations waiting for a scheduler slot"},
+    {"neuronos_kv_cells_used", "Scheduler KV cache cells holding tokens"},
+    {"neuronos_kv_cells_total", "Scheduler KV cache cells"},
+    {"neuronos_kv_snapshot_bytes", "Host memory held by KV snapshots of evicted slots"},
+};
+
+/* Integer form of neuronos_histogram_t so readers never see torn doubles */
+typedef struct {
+    uint64_t count;
+    uint64_t sum_ns;
+    uint64_t min_ns;
+    uint64_t max_ns;
+    uint64_t buckets[NEURONOS_HIST_BUCKETS];
+} shard_hist_t;
+
+typedef struct metrics_shard {
+    shard_hist_t hist[NEURONOS_METRIC_COUNT];
+    shard_hist_t series[METRICS_MAX_SERIES];
+    uint64_t counters[NEURONOS_COUNTER_COUNT];
+    volatile long owned; /* 1 while a live thread records into it */
+    struct metrics_shard * next;
+} metrics_shard_t;
+
+static metrics_shard_t * g_shards = NULL; /* push-only list */
+static METRICS_TLS metrics_shard_t * t_shard = NULL;
+
+/* Series table: entries are written once, then published by g_n_series */
+static struct {
+    int metric;
+    char label[METRICS_LABEL_MAX];
+} g_series[METRICS_MAX_SERIES];
+static volatile long g_n_series = 0;
+static volatile long g_series_lock = 0;
+
+static int64_t g_gauges[NEURONOS_GAUGE_COUNT];
+
+/* Thread-exit hook: the shard keeps its totals but becomes free for
+ * the next thread. The release pairs with the claim in shard_get, so
+ * the adopter sees every store the old owner made. */
+static void shard_release(void * p) {
+    metrics_shard_t * shard = p;
+    t_shard = NULL;
+    if (shard)
+        metrics_unlock(&shard->owned);
+}
+
+#ifdef _WIN32
+static DWORD g_shard_key = FLS_OUT_OF_INDEXES;
+static INIT_ONCE g_shard_key_once = INIT_ONCE_STATIC_INIT;
+
+static VOID WINAPI shard_release_fls(PVOID p) {
+    shard_release(p);
+}
+
+static BOOL CALLBACK shard_key_init(PINIT_ONCE once, PVOID param, PVOID * ctx) {
+    (void)once;
+    (void)param;
+    (void)ctx;
+    g_shard_key = FlsAlloc(shard_release_fls);
+    return TRUE;
+}
+
+/* Arm the exit hook. Without a key the shard just stays owned. */
+static void shard_key_set(metrics_shard_t * shard) {
+    InitOnceExecuteOnce(&g_shard_key_once, shard_key_init, NULL, NULL);
+    if (g_shard_key != FLS_OUT_OF_INDEXES)
+        FlsSetValue(g_shard_key, shard);
+}
+#else
+static pthread_key_t g_shard_key;
+static bool g_shard_key_ok = false;
+static pthread_once_t g_shard_key_once = PTHREAD_ONCE_INIT;
+
+static void shard_key_init(void) {
+    g_shard_key_ok = pthread_key_create(&g_shard_key, shard_release) == 0;
+}
+
+static void shard_key_set(metrics_shard_t * shard) {
+    pthread_once(&g_shard_key_once, shard_key_init);
+    if (g_shard_key_ok)
+        pthread_setspecific(g_shard_key, shard);
+}
+#endif
+
+static metrics_shard_t * shard_get(void) {
+    metrics_shard_t * shard = t_shard;
+    if (shard)
+        return shard;
+
+    /* Adopt a shard left behind by an exited thread */
+    for (shard = metrics_load_ptr(&g_shards); shard; shard = shard->next)
+        if (!metrics_load_acq(&shard->owned) && metrics_try_lock(&shard->owned))
+            break;
+
+    if (!shard) {
+        shard = calloc(1, sizeof(metrics_shard_t));
+        if (!shard)
+            return NULL;
+        shard->owned = 1;
+        for (;;) {
+            metrics_shard_t * head = metrics_load_ptr(&g_shards);
+            shard->next = head;
+            if (metrics_cas_ptr(&g_shards, head, shard))
+                break;
+        }
+    }
+    shard_key_set(shard);
+    t_shard = shard;
+    return shard;
+}
+
+/* Single writer: plain read-modify, atomic store for the readers */
+static void hist_add(shard_hist_t * h, double ms) {
+    int b = 0;
+    while (b < NEURONOS_HIST_BUCKETS - 1 && ms > BUCKET_LE[b])
+        b++;
+    uint64_t ns = (uint64_t)(ms * 1e6);
+    uint64_t count = metrics_load(&h->count);
+
+    metrics_store(&h->buckets[b], metrics_load(&h->buckets[b]) + 1);
+    if (count == 0 || ns < metrics_load(&h->min_ns))
+        metrics_store(&h->min_ns, ns);
+    if (ns > metrics_load(&h->max_ns))
+        metrics_store(&h->max_ns, ns);
+    metrics_store(&h->sum_ns, metrics_load(&h->sum_ns) + ns);
+    metrics_store(&h->count, count + 1);
+}
+
+static void hist_merge(neuronos_histogram_t * out, const shard_hist_t * h) {
+    uint64_t count = metrics_load(&h->count);
+    if (count == 0)
+        return;
+    double min_ms = (double)metrics_load(&h->min_ns) / 1e6;
+    double max_ms = (double)metrics_load(&h->max_ns) / 1e6;
+    if (out->count == 0 || min_ms < out->min_ms)
+        out->min_ms = min_ms;
+    if (max_ms > out->max_ms)
+        out->max_ms = max_ms;
+    out->sum_ms += (double)metrics_load(&h->sum_ns) / 1e6;
+    out->count += count;
+    for (int b = 0; b < NEURONOS_HIST_BUCKETS; b++)
+        out->buckets[b] += metrics_load(&h->buckets[b]);
+}
+
+static void hist_clear(shard_hist_t * h) {
+    metrics_store(&h->count, 0);
+    metrics_store(&h->sum_ns, 0);
+    metrics_store(&h->min_ns, 0);
+    metrics_store(&h->max_ns, 0);
+    for (int b = 0; b < NEURONOS_HIST_BUCKETS; b++)
+        metrics_store(&h->buckets[b], 0);
+}
+
+/* Index of the (metric, label) series, registering it on first use.
+ * Lookups are lock-free; only a new label takes the spin lock. */
+static int series_find(int metric, const char * label) {
+    long n = metrics_load_acq(&g_n_series);
+    for (long i = 0; i < n; i++) {
+        if (g_series[i].metric == metric && strncmp(g_series[i].label, label, METRICS_LABEL_MAX - 1) == 0)
+            return (int)i;
+    }
+    if (n >= METRICS_MAX_SERIES)
+        return -1;
+
+    while (!metrics_try_lock(&g_series_lock)) {
+    }
+    int idx = -1;
+    n = g_n_series;
+    for (long i = 0; i < n && idx < 0; i++) {
+        if (g_series[i].metric == metric && strncmp(g_series[i].label, label, METRICS_LABEL_MAX - 1) == 0)
+            idx = (int)i;
+    }
+    if (idx < 0 && n < METRICS_MAX_SERIES) {
+        g_series[n].metric = metric;
+        snprintf(g_series[n].label, METRICS_LABEL_MAX, "%s", label);
+        metrics_store_rel(&g_n_series, n + 1);
+        idx = (int)n;
+    }
+    metrics_unlock(&g_series_lock);
+    return idx;
+}
+
+double neuronos_metrics_now_ms(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart * 1000.0 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+#endif
+}
+
+void neuronos_metrics_record(neuronos_metric_t metric, double ms) {
+    if ((unsigned)metric >= NEURONOS_METRIC_COUNT || !(ms >= 0.0))
+        return;
+    metrics_shard_t * shard = shard_get();
+    if (shard)
+        hist_add(&shard->hist[metric], ms);
+}
+
+void neuronos_metrics_record_label(neuronos_metric_t metric, const char * label, double ms) {
+    if ((unsigned)metric >= NEURONOS_METRIC_COUNT || !(ms >= 0.0))
+        return;
+    metrics_shard_t * shard = shard_get();
+    if (!shard)
+        return;
+    hist_add(&shard->hist[metric], ms);
+    int idx = label ? series_find((int)metric, label) : -1;
+    if (idx >= 0)
+        hist_add(&shard->series[idx], ms);
+}
+
+void neuronos_metrics_add(neuronos_counter_t counter, uint64_t n) {
+    if ((unsigned)counter >= NEURONOS_COUNTER_COUNT)
+        return;
+    metrics_shard_t * shard = shard_get();
+    if (shard)
+        metrics_store(&shard->counters[counter], metrics_load(&shard->counters[counter]) + n);
+}
+
+uint64_t neuronos_metrics_counter(neuronos_counter_t counter) {
+    if ((unsigned)counter >= NEURONOS_COUNTER_COUNT)
+        return 0;
+    uint64_t total = 0;
+    for (metrics_shard_t * s = metrics_load_ptr(&g_shards); s; s = s->next)
+        total += metrics_load(&s->counters[counter]);
+    return total;
+}
+
+void neuronos_metrics_gauge_set(neuronos_gauge_t gauge, int64_t value) {
+    if ((unsigned)gauge < NEURONOS_GAUGE_COUNT)
+        metrics_gauge_store(&g_gauges[gauge], value);
+}
+
+void neuronos_metrics_gauge_add(neuronos_gauge_t gauge, int64_t delta) {
+    if ((unsigned)gauge < NEURONOS_GAUGE_COUNT)
+        metrics_gauge_add(&g_gauges[gauge], delta);
+}
+
+int64_t neuronos_metrics_gauge(neuronos_gauge_t gauge) {
+    if ((unsigned)gauge >= NEURONOS_GAUGE_COUNT)
+        return 0;
+    return metrics_gauge_load(&g_gauges[gauge]);
+}
+
+neuronos_histogram_t neuronos_metrics_get(neuronos_metric_t metric) {
+    neuronos_histogram_t h = {0};
+    if ((unsigned)metric >= NEURONOS_METRIC_COUNT)
+        return h;
+    for (metrics_shard_t * s = metrics_load_ptr(&g_shards); s; s = s->next)
+        hist_merge(&h, &s->hist[metric]);
+    return h;
+}
+
+double neuronos_histogram_bucket_le(int i) {
+    if (i < 0)
+        return 0.0;
+    return i < NEURONOS_HIST_BUCKETS - 1 ? BUCKET_LE[i] : INFINITY;
+}
+
+double neuronos_histogram_percentile(const neuronos_histogram_t * hist, double p) {
+    if (!hist || hist->count == 0)
+        return 0.0;
+    if (p < 0.0)
+        p = 0.0;
+    if (p > 1.0)
+        p = 1.0;
+
+    double rank = p * (double)hist->count;
+    uint64_t seen = 0;
+    for (int b = 0; b < NEURONOS_HIST_BUCKETS; b++) {
+        uint64_t n = hist->buckets[b];
+        if (n == 0 || (double)(seen + n) < rank) {
+            seen += n;
+            continue;
+        }
+        /* Linear interpolation inside the bucket, clamped to observed range */
+        double lo = b > 0 ? BUCKET_LE[b - 1] : 0.0;
+        double hi = b < NEURONOS_HIST_BUCKETS - 1 ? BUCKET_LE[b] : hist->max_ms;
+        if (lo < hist->min_ms)
+            lo = hist->min_ms;
+        if (hi > hist->max_ms)
+            hi = hist->max_ms;
+        double v = lo + (hi - lo) * ((rank - (double)seen) / (double)n);
+        return v < lo ? lo : v;
+    }
+    return hist->max_ms;
+}
+
+const char * neuronos_metric_name(neuronos_metric_t metric) {
+    if ((unsigned)metric >= NEURONOS_METRIC_COUNT)
+        return "unknown";
+    return METRIC_NAMES[metric];
+}
+
+char * neuronos_metrics_json(void) {
+    size_t cap = 256 * NEURONOS_METRIC_COUNT;
+    char * buf = malloc(cap);
+    if (!buf)
+        return NULL;
+
+    size_t len = (size_t)snprintf(buf, cap, "{");
+    for (int m = 0; m < NEURONOS_METRIC_COUNT; m++) {
+        neuronos_histogram_t hm = neuronos_metrics_get((neuronos_metric_t)m);
+        const neuronos_histogram_t * h = &hm;
+        len += (size_t)snprintf(buf + len, cap - len,
+                                "%s\"%s\":{\"count\":%llu,\"mean_ms\":%.3f,\"p50_ms\":%.3f,\"p95_ms\":%.3f,"
+                                "\"p99_ms\":%.3f,\"max_ms\":%.3f}",
+                                m > 0 ? "," : "", METRIC_NAMES[m], (unsigned long long)h->count,
+                                h->count ? h->sum_ms / (double)h->count : 0.0,
+                                neuronos_histogram_percentile(h, 0.50), neuronos_histogram_percentile(h, 0.95),
+                                neuronos_histogram_percentile(h, 0.99), h->max_ms);
+    }
+    snprintf(buf + len, cap - len, "}");
+    return buf;
+}
+
+/* ---- Prometheus text format ---- */
+
+typedef struct {
+    char * data;
+    size_t len;
+    size_t cap;
+    bool failed;
+} prom_buf_t;
+
+static void prom_printf(prom_buf_t * b, const char * fmt, ...) {
+    if (b->failed)
+        return;
+    for (;;) {
+        va_list ap;
+        va_start(ap, fmt);
+        int n = vsnprintf(b->data + b->len, b->cap - b->len, fmt, ap);
+        va_end(ap);
+        if (n < 0) {
+            b->failed = true;
+            return;
+        }
+        if ((size_t)n < b->cap - b->len) {
+            b->len += (size_t)n;
+            return;
+        }
+        size_t cap = b->cap * 2 + (size_t)n;
+        char * data = realloc(b->data, cap);
+        if (!data) {
+            b->failed = true;
+            return;
+        }
+        b->data = data;
+        b->cap = cap;
+    }
+}
+
+/* One histogram's _bucket / _sum / _count lines. `labels` is either
+ * empty or `key="value",` (trailing comma, merged with le). */
+static void prom_histogram(prom_buf_t * b, const char * name, const char * labels, const neuronos_histogram_t * h) {
+    uint64_t cum = 0;
+    for (int i = 0; i < NEURONOS_HIST_BUCKETS; i++) {
+        cum += h->buckets[i];
+        if (i < NEURONOS_HIST_BUCKETS - 1)
+            prom_printf(b, "%s_bucket{%sle=\"%g\"} %llu\n", name, labels, BUCKET_LE[i] / 1000.0,
+                        (unsigned long long)cum);
+        else
+            prom_printf(b, "%s_bucket{%sle=\"+Inf\"} %llu\n", name, labels, (unsigned long long)cum);
+    }
+    size_t n = strlen(labels);
+    if (n > 0) /* drop the trailing comma */
+        prom_printf(b, "%s_sum{%.*s} %.9g\n%s_count{%.*s} %llu\n", name, (int)(n - 1), labels, h->sum_ms / 1000.0,
+                    name, (int)(n - 1), labels, (unsigned long long)h->count);
+    else
+        prom_printf(b, "%s_sum %.9g\n%s_count %llu\n", name, h->sum_ms / 1000.0, name,
+                    (unsigned long long)h->count);
+}
+
+/* Label values are tool names and SQL verbs; escape anyway */
+static void prom_escape(char * out, size_t out_len, const char * in) {
+    size_t j = 0;
+    for (size_t i = 0; in[i] && j + 3 < out_len; i++) {
+        char c = in[i];
+        if (c == '\\' || c == '"') {
+            out[j++] = '\\';
+            out[j++] = c;
+        } else if (c == '\n') {
+            out[j++] = '\\';
+            out[j++] = 'n';
+        } else {
+            out[j++] = c;
+        }
+    }
+    out[j] = '\0';
+}
+
+char * neuronos_metrics_prometheus(void) {
+    prom_buf_t b = {.cap = 16384};
+    b.data = malloc(b.cap);
+    if (!b.data)
+        return NULL;
+    b.data[0] = '\0';
+
+    long n_series = metrics_load_acq(&g_n_series);
+
+    for (int m = 0; m < NEURONOS_METRIC_COUNT; m++) {
+        const char * name = METRIC_PROM[m].name;
+        prom_printf(&b, "# HELP %s %s\n# TYPE %s histogram\n", name, METRIC_PROM[m].help, name);
+
+        if (!METRIC_PROM[m].label) {
+            neuronos_histogram_t h = neuronos_metrics_get((neuronos_metric_t)m);
+            prom_histogram(&b, name, "", &h);
+            continue;
+        }
+        for (long i = 0; i < n_series; i++) {
+            if (g_series[i].metric != m)
+                continue;
+            neuronos_histogram_t h = {0};
+            for (metrics_shard_t * s = metrics_load_ptr(&g_shards); s; s = s->next)
+                hist_merge(&h, &s->series[i]);
+
+            char value[2 * METRICS_LABEL_MAX];
+            char labels[3 * METRICS_LABEL_MAX];
+            prom_escape(value, sizeof(value), g_series[i].label);
+            snprintf(labels, sizeof(labels), "%s=\"%s\",", METRIC_PROM[m].label, value);
+            prom_histogram(&b, name, labels, &h);
+        }
+    }
+
+    for (int c = 0; c < NEURONOS_COUNTER_COUNT; c++) {
+        const char * name = COUNTER_PROM[c].name;
+        prom_printf(&b, "# HELP %s %s\n# TYPE %s counter\n%s %llu\n", name, COUNTER_PROM[c].help, name, name,
+                    (unsigned long long)neuronos_metrics_counter((neuronos_counter_t)c));
+    }
+    for (int g = 0; g < NEURONOS_GAUGE_COUNT; g++) {
+        const char * name = GAUGE_PROM[g].name;
+        prom_printf(&b, "# HELP %s %s\n# TYPE %s gauge\n%s %lld\n", name, GAUGE_PROM[g].help, name, name,
+                    (long long)neuronos_metrics_gauge((neuronos_gauge_t)g));
+    }
+
+    if (b.failed) {
+        free(b.data);
+        return NULL;
+    }
+    return b.data;
+}
+
+int neuronos_metrics_shard_count(void) {
+    int n = 0;
+    for (metrics_shard_t * s = metrics_load_ptr(&g_shards); s; s = s->next)
+        n++;
+    return n;
+}
+
+void neuronos_metrics_reset(void) {
+    for (metrics_shard_t * s = metrics_load_ptr(&g_shards); s; s = s->next) {
+        for (int m = 0; m < NEURONOS_METRIC_COUNT; m++)
+            hist_clear(&s->hist[m]);
+        for (int i = 0; i < METRICS_MAX_SERIES; i++)
+            hist_clear(&s->series[i]);
+        for (int c = 0; c < NEURONOS_COUNTER_COUNT; c++)
+            metrics_store(&s->counters[c], 0);
+    }
+}
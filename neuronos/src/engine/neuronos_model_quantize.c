@@ -0,0 +1,663 @@
+/* ============================================================
+ * NeuronOS — Streaming I2_S model conversion
+ *
+ * Stands in for the `llama-quantize <f32.gguf> <out.gguf> I2_S` step of
+ * the conversion pipeline. That step loads each f32 tensor whole and
+ * packs it on one thread; an 8B checkpoint needs ~32 GB of f32 in
+ * flight and spends most of its time in the scalar loop.
+ *
+ * Here the input GGUF is memory-mapped and every tensor streams through
+ * in row chunks of at most QZ_CHUNK_ELEMS weights:
+ *   - ternary codes depend only on sign and |w| < 1e-6, so each chunk
+ *     is packed on the HAL pool (neuronos_quantize_i2_rows) as soon as
+ *     it is read, and the tensor's max-abs scale is kept as a running
+ *     max and written once after its last row
+ *   - output offsets are known from the header alone, so the output is
+ *     written front to back, with no seek back and no staging buffer
+ *   - consumed input pages are dropped (MADV_DONTNEED), so resident
+ *     memory stays at about one chunk however big the model is
+ * The result goes to <dst>.part and is renamed into place when complete.
+ * ============================================================ */
+#include "neuronos/neuronos.h"
+#include "neuronos/neuronos_hal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/* ggml tensor types involved (36 is the BitNet fork's I2_S) */
+#define QZ_TYPE_F32 0
+#define QZ_TYPE_F16 1
+#define QZ_TYPE_BF16 30
+#define QZ_TYPE_I2_S 36
+#define QZ_FTYPE_MOSTLY_I2_S 40 /* llama_ftype in the BitNet fork */
+
+#define QZ_CHUNK_ELEMS ((size_t)16 << 20) /* weights per chunk: 64 MB as f32 */
+#define QZ_I2S_TAIL 32                    /* after packed data: f32 scale + padding */
+#define QZ_MAX_TENSORS 65536
+#define QZ_DEFAULT_ALIGN 32
+
+/* ggml-bitnet-mad.cpp packs 64-weight blocks on ARM NEON, 128 elsewhere */
+#if defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+    #define QZ_QK_NATIVE 64
+#else
+    #define QZ_QK_NATIVE 128
+#endif
+
+/* GGUF metadata value types */
+enum {
+    QZ_GGUF_U8, QZ_GGUF_I8, QZ_GGUF_U16, QZ_GGUF_I16, QZ_GGUF_U32, QZ_GGUF_I32, QZ_GGUF_F32,
+    QZ_GGUF_BOOL, QZ_GGUF_STR, QZ_GGUF_ARR, QZ_GGUF_U64, QZ_GGUF_I64, QZ_GGUF_F64, QZ_GGUF_N_TYPES
+};
+static const uint8_t QZ_GGUF_SIZE[QZ_GGUF_N_TYPES] = {1, 1, 2, 2, 4, 4, 4, 1, 0, 0, 8, 8, 8};
+
+/* ---- Input mapping ---- */
+
+typedef struct {
+    const uint8_t * base;
+    uint64_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE map;
+#else
+    int fd;
+#endif
+} qz_map_t;
+
+static bool qz_map_open(qz_map_t * m, const char * path) {
+    memset(m, 0, sizeof(*m));
+#ifdef _WIN32
+    m->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (m->file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(m->file, &sz) || sz.QuadPart <= 0) {
+        CloseHandle(m->file);
+        return false;
+    }
+    m->size = (uint64_t)sz.QuadPart;
+    m->map = CreateFileMappingA(m->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    m->base = m->map ? (const uint8_t *)MapViewOfFile(m->map, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!m->base) {
+        if (m->map)
+            CloseHandle(m->map);
+        CloseHandle(m->file);
+        return false;
+    }
+#else
+    m->fd = open(path, O_RDONLY);
+    if (m->fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(m->fd, &st) != 0 || st.st_size <= 0) {
+        close(m->fd);
+        return false;
+    }
+    m->size = (uint64_t)st.st_size;
+    void * p = mmap(NULL, (size_t)m->size, PROT_READ, MAP_PRIVATE, m->fd, 0);
+    if (p == MAP_FAILED) {
+        close(m->fd);
+        return false;
+    }
+    m->base = (const uint8_t *)p;
+    #ifdef MADV_SEQUENTIAL
+    madvise(p, (size_t)m->size, MADV_SEQUENTIAL);
+    #endif
+#endif
+    return true;
+}
+
+static void qz_map_close(qz_map_t * m) {
+#ifdef _WIN32
+    UnmapViewOfFile(m->base);
+    CloseHandle(m->map);
+    CloseHandle(m->file);
+#else
+    munmap((void *)m->base, (size_t)m->size);
+    close(m->fd);
+#endif
+}
+
+/* Drop the pages of [off, off + len) once consumed: clean file-backed
+ * pages refault from disk if needed again, so this only bounds RSS */
+static void qz_map_release(const qz_map_t * m, uint64_t off, uint64_t len) {
+#if !defined(_WIN32) && defined(MADV_DONTNEED)
+    const uint64_t page = (uint64_t)sysconf(_SC_PAGESIZE);
+    const uint64_t start = off / page * page;
+    const uint64_t end = (off + len) / page * page;
+    if (end > start)
+        madvise((void *)(m->base + start), (size_t)(end - start), MADV_DONTNEED);
+#else
+    (void)m;
+    (void)off;
+    (void)len;
+#endif
+}
+
+/* ---- Header parsing ---- */
+
+typedef struct {
+    const uint8_t * p;
+    const uint8_t * end;
+    bool ok;
+} qz_cur_t;
+
+static bool qz_need(qz_cur_t * c, uint64_t n) {
+    if (c->ok && (uint64_t)(c->end - c->p) >= n)
+        return true;
+    c->ok = false;
+    return false;
+}
+
+static uint32_t qz_u32(qz_cur_t * c) {
+    uint32_t v = 0;
+    if (qz_need(c, 4)) {
+        memcpy(&v, c->p, 4);
+        c->p += 4;
+    }
+    return v;
+}
+
+static uint64_t qz_u64(qz_cur_t * c) {
+    uint64_t v = 0;
+    if (qz_need(c, 8)) {
+        memcpy(&v, c->p, 8);
+        c->p += 8;
+    }
+    return v;
+}
+
+static const char * qz_str(qz_cur_t * c, size_t * len) {
+    uint64_t n = qz_u64(c);
+    *len = 0;
+    if (!qz_need(c, n))
+        return "";
+    const char * s = (const char *)c->p;
+    c->p += n;
+    *len = (size_t)n;
+    return s;
+}
+
+static void qz_skip_value(qz_cur_t * c, uint32_t type, int depth) {
+    if (type >= QZ_GGUF_N_TYPES || depth > 2) {
+        c->ok = false;
+    } else if (type == QZ_GGUF_STR) {
+        size_t len;
+        qz_str(c, &len);
+    } else if (type == QZ_GGUF_ARR) {
+        uint32_t elem = qz_u32(c);
+        uint64_t n = qz_u64(c);
+        if (elem >= QZ_GGUF_N_TYPES) {
+            c->ok = false;
+        } else if (QZ_GGUF_SIZE[elem]) {
+            if (n <= UINT64_MAX / QZ_GGUF_SIZE[elem] && qz_need(c, n * QZ_GGUF_SIZE[elem]))
+                c->p += n * QZ_GGUF_SIZE[elem];
+        } else {
+            for (uint64_t i = 0; i < n && c->ok; i++)
+                qz_skip_value(c, elem, depth + 1);
+        }
+    } else if (qz_need(c, QZ_GGUF_SIZE[type])) {
+        c->p += QZ_GGUF_SIZE[type];
+    }
+}
+
+static bool qz_key_is(const char * key, size_t len, const char * want) {
+    return len == strlen(want) && memcmp(key, want, len) == 0;
+}
+
+typedef struct {
+    const char * name;
+    size_t name_len;
+    uint32_t n_dims;
+    uint64_t ne[4];
+    uint64_t n_elem;
+    uint32_t type;
+    uint64_t offset;   /* in the input data section */
+    uint64_t size;     /* input bytes */
+    uint32_t out_type;
+    uint64_t out_offset;
+    uint64_t out_size;
+} qz_tensor_t;
+
+typedef struct {
+    uint32_t version;
+    uint64_t n_kv;
+    const uint8_t * kv_begin; /* metadata copied verbatim ... */
+    const uint8_t * kv_end;
+    const uint8_t * ftype_begin; /* ... except general.file_type (NULL if absent) */
+    const uint8_t * ftype_end;
+    uint64_t align;
+    uint64_t data_start; /* file offset of the input data section */
+    qz_tensor_t * tensors;
+    uint64_t n_tensors;
+} qz_gguf_t;
+
+static uint64_t qz_align(uint64_t v, uint64_t a) {
+    return (v + a - 1) / a * a;
+}
+
+/* Input byte size of a tensor: from its type when known, else the gap
+ * to the next tensor's data (or the end of the file) */
+static uint64_t qz_input_size(const qz_gguf_t * g, const qz_tensor_t * t, uint64_t data_len) {
+    switch (t->type) {
+    case QZ_TYPE_F32: case 26 /* I32 */: return t->n_elem * 4;
+    case QZ_TYPE_F16: case QZ_TYPE_BF16: case 25 /* I16 */: return t->n_elem * 2;
+    case 24 /* I8 */: return t->n_elem;
+    case 27 /* I64 */: case 28 /* F64 */: return t->n_elem * 8;
+    case QZ_TYPE_I2_S: return t->n_elem / 4 + QZ_I2S_TAIL;
+    default: break;
+    }
+    uint64_t next = data_len;
+    for (uint64_t i = 0; i < g->n_tensors; i++) {
+        if (g->tensors[i].offset > t->offset && g->tensors[i].offset < next)
+            next = g->tensors[i].offset;
+    }
+    return next - t->offset;
+}
+
+static bool qz_parse(const qz_map_t * m, qz_gguf_t * g) {
+    qz_cur_t c = {m->base, m->base + m->size, true};
+    if (m->size < 24 || memcmp(m->base, "GGUF", 4) != 0)
+        return false;
+    c.p += 4;
+    g->version = qz_u32(&c);
+    g->n_tensors = qz_u64(&c);
+    g->n_kv = qz_u64(&c);
+    if (g->version < 2 || g->n_tensors > QZ_MAX_TENSORS)
+        return false;
+
+    g->align = QZ_DEFAULT_ALIGN;
+    g->kv_begin = c.p;
+    for (uint64_t i = 0; i < g->n_kv && c.ok; i++) {
+        const uint8_t * kv = c.p;
+        size_t klen;
+        const char * key = qz_str(&c, &klen);
+        uint32_t type = qz_u32(&c);
+        if (qz_key_is(key, klen, "general.alignment") && type == QZ_GGUF_U32 && qz_need(&c, 4)) {
+            uint32_t a;
+            memcpy(&a, c.p, 4);
+            g->align = a;
+        }
+        qz_skip_value(&c, type, 0);
+        if (qz_key_is(key, klen, "general.file_type")) {
+            g->ftype_begin = kv;
+            g->ftype_end = c.p;
+        }
+    }
+    g->kv_end = c.p;
+    if (!c.ok || g->align == 0 || (g->align & (g->align - 1)) != 0)
+        return false;
+
+    g->tensors = (qz_tensor_t *)calloc(g->n_tensors ? g->n_tensors : 1, sizeof(qz_tensor_t));
+    if (!g->tensors)
+        return false;
+    for (uint64_t i = 0; i < g->n_tensors && c.ok; i++) {
+        qz_tensor_t * t = &g->tensors[i];
+        t->name = qz_str(&c, &t->name_len);
+        t->n_dims = qz_u32(&c);
+        if (t->n_dims < 1 || t->n_dims > 4) {
+            c.ok = false;
+            break;
+        }
+        t->n_elem = 1;
+        for (uint32_t d = 0; d < t->n_dims; d++) {
+            t->ne[d] = qz_u64(&c);
+            if (t->ne[d] && t->n_elem > (UINT64_MAX / 8) / t->ne[d])
+                c.ok = false;
+            else
+                t->n_elem *= t->ne[d];
+        }
+        t->type = qz_u32(&c);
+        t->offset = qz_u64(&c);
+    }
+    if (!c.ok)
+        return false;
+
+    g->data_start = qz_align((uint64_t)(c.p - m->base), g->align);
+    if (g->data_start > m->size)
+        return false;
+    const uint64_t data_len = m->size - g->data_start;
+    for (uint64_t i = 0; i < g->n_tensors; i++) {
+        qz_tensor_t * t = &g->tensors[i];
+        if (t->offset > data_len)
+            return false;
+        t->size = qz_input_size(g, t, data_len);
+        if (t->size > data_len - t->offset)
+            return false;
+    }
+    return true;
+}
+
+/* ---- Output plan ---- */
+
+static bool qz_name_is(const qz_tensor_t * t, const char * want) {
+    return qz_key_is(t->name, t->name_len, want);
+}
+
+static bool qz_is_float(uint32_t type) {
+    return type == QZ_TYPE_F32 || type == QZ_TYPE_F16 || type == QZ_TYPE_BF16;
+}
+
+static void qz_plan(qz_gguf_t * g, int qk, bool keep_embd_type) {
+    uint64_t off = 0;
+    for (uint64_t i = 0; i < g->n_tensors; i++) {
+        qz_tensor_t * t = &g->tensors[i];
+        const bool layer_weight = t->name_len > 11 && memcmp(t->name, "blk.", 4) == 0 &&
+                                  memcmp(t->name + t->name_len - 7, ".weight", 7) == 0;
+        t->out_type = t->type;
+        t->out_size = t->size;
+        if (qz_is_float(t->type) && t->n_dims == 2 && layer_weight && t->ne[0] % (uint64_t)qk == 0) {
+            t->out_type = QZ_TYPE_I2_S;
+            t->out_size = t->n_elem / 4 + QZ_I2S_TAIL;
+        } else if (!keep_embd_type && (t->type == QZ_TYPE_F32 || t->type == QZ_TYPE_BF16) &&
+                   (qz_name_is(t, "token_embd.weight") || qz_name_is(t, "output.weight"))) {
+            t->out_type = QZ_TYPE_F16;
+            t->out_size = t->n_elem * 2;
+        }
+        t->out_offset = off;
+        off = qz_align(off + t->out_size, g->align);
+    }
+}
+
+/* ---- Element conversion ---- */
+
+static float qz_f16_to_f32(uint16_t h) {
+    const uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+    uint32_t exp = (h >> 10) & 0x1F, mant = h & 0x3FF, bits;
+    if (exp == 0x1F) {
+        bits = sign | 0x7F800000u | (mant << 13);
+    } else if (exp != 0) {
+        bits = sign | ((exp + 112) << 23) | (mant << 13);
+    } else if (mant == 0) {
+        bits = sign;
+    } else { /* subnormal: renormalize */
+        exp = 113;
+        while (!(mant & 0x400)) {
+            mant <<= 1;
+            exp--;
+        }
+        bits = sign | (exp << 23) | ((mant & 0x3FF) << 13);
+    }
+    float f;
+    memcpy(&f, &bits, 4);
+    return f;
+}
+
+/* Round to nearest even, overflow to inf, NaN stays NaN */
+static uint16_t qz_f32_to_f16(float f) {
+    uint32_t x;
+    memcpy(&x, &f, 4);
+    const uint16_t sign = (uint16_t)((x >> 16) & 0x8000);
+    const uint32_t ax = x & 0x7FFFFFFFu;
+    if (ax >= 0x7F800000u)
+        return (uint16_t)(sign | 0x7C00 | (ax > 0x7F800000u ? 0x200 : 0));
+    if (ax >= 0x477FF000u) /* rounds past 65504 */
+        return (uint16_t)(sign | 0x7C00);
+    if (ax < 0x38800000u) { /* below the smallest normal half */
+        if (ax < 0x33000000u)
+            return sign;
+        const uint32_t e = ax >> 23;
+        const uint32_t m = (ax & 0x7FFFFFu) | 0x800000u;
+        const uint32_t shift = 126 - e;
+        uint32_t h = m >> shift;
+        const uint32_t rem = m & ((1u << shift) - 1), half = 1u << (shift - 1);
+        if (rem > half || (rem == half && (h & 1)))
+            h++;
+        return (uint16_t)(sign | h);
+    }
+    uint32_t h = ((ax - 0x38000000u) >> 13);
+    const uint32_t rem = ax & 0x1FFFu;
+    if (rem > 0x1000u || (rem == 0x1000u && (h & 1)))
+        h++;
+    return (uint16_t)(sign | h);
+}
+
+/* n elements of a float tensor as f32 */
+static void qz_to_f32(const uint8_t * src, uint32_t type, float * dst, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        uint16_t h;
+        memcpy(&h, src + i * 2, 2);
+        if (type == QZ_TYPE_BF16) {
+            const uint32_t bits = (uint32_t)h << 16;
+            memcpy(&dst[i], &bits, 4);
+        } else {
+            dst[i] = qz_f16_to_f32(h);
+        }
+    }
+}
+
+/* ---- Streaming writer ---- */
+
+typedef struct {
+    const qz_map_t * in;
+    FILE * out;
+    uint64_t written; /* bytes of the output data section so far */
+    uint64_t done;    /* input bytes consumed, for progress */
+    float * scratch;  /* QZ_CHUNK_ELEMS f32, for non-f32 sources */
+    uint8_t * buf;    /* QZ_CHUNK_ELEMS * 2 bytes of output */
+    neuronos_quantize_params_t params;
+    neuronos_status_t status;
+} qz_writer_t;
+
+static bool qz_write(qz_writer_t * w, const void * p, size_t n) {
+    if (w->status == NEURONOS_OK && n > 0 && fwrite(p, 1, n, w->out) != n)
+        w->status = NEURONOS_ERROR_INIT;
+    w->written += n;
+    return w->status == NEURONOS_OK;
+}
+
+static bool qz_pad(qz_writer_t * w, uint64_t to) {
+    static const uint8_t zeros[64] = {0};
+    while (w->status == NEURONOS_OK && w->written < to) {
+        const uint64_t n = to - w->written < sizeof(zeros) ? to - w->written : sizeof(zeros);
+        qz_write(w, zeros, (size_t)n);
+    }
+    return w->status == NEURONOS_OK;
+}
+
+/* Account for consumed input; false once cancelled or failed */
+static bool qz_consumed(qz_writer_t * w, uint64_t in_off, uint64_t len) {
+    qz_map_release(w->in, in_off, len);
+    w->done += len;
+    if (w->status == NEURONOS_OK && w->params.on_progress &&
+        !w->params.on_progress((int64_t)w->done, (int64_t)w->in->size, w->params.user_data))
+        w->status = NEURONOS_ERROR_CANCELLED;
+    return w->status == NEURONOS_OK;
+}
+
+static void qz_tensor_i2s(qz_writer_t * w, const qz_tensor_t * t, uint64_t in_off, int qk) {
+    const uint64_t n_per_row = t->ne[0];
+    const uint64_t nrow = t->n_elem / n_per_row;
+    const size_t esize = t->type == QZ_TYPE_F32 ? 4 : 2;
+    uint64_t rows_per_chunk = QZ_CHUNK_ELEMS / n_per_row;
+    if (rows_per_chunk == 0)
+        rows_per_chunk = 1;
+    float amax = 0.0f;
+
+    for (uint64_t r0 = 0; r0 < nrow && w->status == NEURONOS_OK; r0 += rows_per_chunk) {
+        const uint64_t nr = nrow - r0 < rows_per_chunk ? nrow - r0 : rows_per_chunk;
+        const uint64_t off = in_off + r0 * n_per_row * esize;
+        const uint8_t * src = w->in->base + off;
+        const size_t n = (size_t)(nr * n_per_row);
+
+        /* Chunks are whole rows: only a row wider than a chunk needs its own buffers */
+        const bool wide = n > QZ_CHUNK_ELEMS;
+        uint8_t * packed = wide ? (uint8_t *)malloc(n / 4) : w->buf;
+        float * conv = NULL;
+        if (packed && t->type != QZ_TYPE_F32) {
+            conv = wide ? (float *)malloc(n * sizeof(float)) : w->scratch;
+            if (conv)
+                qz_to_f32(src, t->type, conv, n);
+        }
+        if (!packed || (t->type != QZ_TYPE_F32 && !conv)) {
+            if (wide) {
+                free(packed);
+                free(conv);
+            }
+            w->status = NEURONOS_ERROR_MEMORY;
+            break;
+        }
+        const float * f32 = conv ? conv : (const float *)src;
+        neuronos_quantize_i2_rows(f32, packed, (int64_t)nr, (int64_t)n_per_row, qk, &amax);
+        qz_write(w, packed, n / 4);
+        if (wide) {
+            free(packed);
+            free(conv);
+        }
+        qz_consumed(w, off, n * esize);
+    }
+
+    uint8_t tail[QZ_I2S_TAIL] = {0};
+    memcpy(tail, &amax, sizeof(amax));
+    qz_write(w, tail, sizeof(tail));
+}
+
+static void qz_tensor_f16(qz_writer_t * w, const qz_tensor_t * t, uint64_t in_off) {
+    const size_t esize = t->type == QZ_TYPE_F32 ? 4 : 2;
+    uint16_t * out = (uint16_t *)w->buf;
+    for (uint64_t i = 0; i < t->n_elem && w->status == NEURONOS_OK; i += QZ_CHUNK_ELEMS) {
+        const size_t n = (size_t)(t->n_elem - i < QZ_CHUNK_ELEMS ? t->n_elem - i : QZ_CHUNK_ELEMS);
+        const uint64_t off = in_off + i * esize;
+        const uint8_t * src = w->in->base + off;
+        for (size_t k = 0; k < n; k++) {
+            float f;
+            if (t->type == QZ_TYPE_F32) {
+                memcpy(&f, src + k * 4, 4);
+            } else {
+                uint16_t h;
+                memcpy(&h, src + k * 2, 2);
+                const uint32_t bits = (uint32_t)h << 16; /* BF16 */
+                memcpy(&f, &bits, 4);
+            }
+            out[k] = qz_f32_to_f16(f);
+        }
+        qz_write(w, out, n * 2);
+        qz_consumed(w, off, n * esize);
+    }
+}
+
+static void qz_tensor_copy(qz_writer_t * w, const qz_tensor_t * t, uint64_t in_off) {
+    const uint64_t step = QZ_CHUNK_ELEMS * 4;
+    for (uint64_t i = 0; i < t->size && w->status == NEURONOS_OK; i += step) {
+        const uint64_t n = t->size - i < step ? t->size - i : step;
+        qz_write(w, w->in->base + in_off + i, (size_t)n);
+        qz_consumed(w, in_off + i, n);
+    }
+}
+
+/* Header: magic, counts, metadata (file_type replaced), tensor infos */
+static bool qz_write_header(FILE * out, const qz_gguf_t * g) {
+    const uint32_t version = 3;
+    const uint64_t n_kv = g->n_kv + (g->ftype_begin ? 0 : 1);
+    bool ok = fwrite("GGUF", 1, 4, out) == 4 && fwrite(&version, 4, 1, out) == 1 &&
+              fwrite(&g->n_tensors, 8, 1, out) == 1 && fwrite(&n_kv, 8, 1, out) == 1;
+
+    const uint8_t * kv_split = g->ftype_begin ? g->ftype_begin : g->kv_end;
+    const uint8_t * kv_rest = g->ftype_begin ? g->ftype_end : g->kv_end;
+    ok = ok && fwrite(g->kv_begin, 1, (size_t)(kv_split - g->kv_begin), out) == (size_t)(kv_split - g->kv_begin);
+
+    const char key[] = "general.file_type";
+    const uint64_t klen = sizeof(key) - 1;
+    const uint32_t type = QZ_GGUF_U32, ftype = QZ_FTYPE_MOSTLY_I2_S;
+    ok = ok && fwrite(&klen, 8, 1, out) == 1 && fwrite(key, 1, klen, out) == klen && fwrite(&type, 4, 1, out) == 1 &&
+         fwrite(&ftype, 4, 1, out) == 1;
+    ok = ok && fwrite(kv_rest, 1, (size_t)(g->kv_end - kv_rest), out) == (size_t)(g->kv_end - kv_rest);
+
+    uint64_t pos = 24 + (uint64_t)(g->kv_end - g->kv_begin) - (uint64_t)(kv_rest - kv_split) + 8 + klen + 8;
+    for (uint64_t i = 0; i < g->n_tensors && ok; i++) {
+        const qz_tensor_t * t = &g->tensors[i];
+        const uint64_t name_len = t->name_len;
+        ok = fwrite(&name_len, 8, 1, out) == 1 && fwrite(t->name, 1, t->name_len, out) == t->name_len &&
+             fwrite(&t->n_dims, 4, 1, out) == 1 && fwrite(t->ne, 8, t->n_dims, out) == t->n_dims &&
+             fwrite(&t->out_type, 4, 1, out) == 1 && fwrite(&t->out_offset, 8, 1, out) == 1;
+        pos += 8 + name_len + 4 + 8ull * t->n_dims + 4 + 8;
+    }
+    static const uint8_t zeros[256] = {0};
+    const uint64_t pad = qz_align(pos, g->align) - pos;
+    for (uint64_t left = pad; left > 0 && ok;) {
+        const size_t n = (size_t)(left < sizeof(zeros) ? left : sizeof(zeros));
+        ok = fwrite(zeros, 1, n, out) == n;
+        left -= n;
+    }
+    return ok;
+}
+
+neuronos_status_t neuronos_model_quantize_i2(const char * src_path, const char * dst_path,
+                                             neuronos_quantize_params_t params) {
+    const int qk = params.qk ? params.qk : QZ_QK_NATIVE;
+    if (!src_path || !dst_path || (qk != 64 && qk != 128) || params.n_threads < 0)
+        return NEURONOS_ERROR_INVALID_PARAM;
+
+    qz_map_t in;
+    if (!qz_map_open(&in, src_path))
+        return NEURONOS_ERROR_MODEL_LOAD;
+
+    qz_gguf_t g = {0};
+    if (!qz_parse(&in, &g)) {
+        free(g.tensors);
+        qz_map_close(&in);
+        return NEURONOS_ERROR_MODEL_LOAD;
+    }
+    qz_plan(&g, qk, params.keep_embd_type);
+
+    char part_path[1024];
+    snprintf(part_path, sizeof(part_path), "%s.part", dst_path);
+    qz_writer_t w = {.in = &in, .params = params, .status = NEURONOS_OK};
+    w.scratch = (float *)malloc(QZ_CHUNK_ELEMS * sizeof(float));
+    w.buf = (uint8_t *)malloc(QZ_CHUNK_ELEMS * 2);
+    w.out = fopen(part_path, "wb");
+    if (!w.scratch || !w.buf)
+        w.status = NEURONOS_ERROR_MEMORY;
+    else if (!w.out || !qz_write_header(w.out, &g))
+        w.status = NEURONOS_ERROR_INIT;
+
+    int prev_threads = 0;
+    if (w.status == NEURONOS_OK && params.n_threads > 0) {
+        neuronos_hal_init();
+        prev_threads = neuronos_hal_get_n_threads();
+        neuronos_hal_set_n_threads(params.n_threads);
+    }
+
+    for (uint64_t i = 0; i < g.n_tensors && w.status == NEURONOS_OK; i++) {
+        const qz_tensor_t * t = &g.tensors[i];
+        const uint64_t in_off = g.data_start + t->offset;
+        qz_pad(&w, t->out_offset);
+        if (t->out_type == QZ_TYPE_I2_S && t->type != QZ_TYPE_I2_S)
+            qz_tensor_i2s(&w, t, in_off, qk);
+        else if (t->out_type == QZ_TYPE_F16 && t->type != QZ_TYPE_F16)
+            qz_tensor_f16(&w, t, in_off);
+        else
+            qz_tensor_copy(&w, t, in_off);
+    }
+    if (g.n_tensors > 0) {
+        const qz_tensor_t * last = &g.tensors[g.n_tensors - 1];
+        qz_pad(&w, qz_align(last->out_offset + last->out_size, g.align));
+    }
+
+    if (prev_threads > 0)
+        neuronos_hal_set_n_threads(prev_threads);
+    if (w.out && fclose(w.out) != 0 && w.status == NEURONOS_OK)
+        w.status = NEURONOS_ERROR_INIT;
+    if (w.status == NEURONOS_OK) {
+        remove(dst_path); /* rename() does not replace on Windows */
+        if (rename(part_path, dst_path) != 0)
+            w.status = NEURONOS_ERROR_INIT;
+    }
+    if (w.status != NEURONOS_OK)
+        remove(part_path);
+
+    free(w.scratch);
+    free(w.buf);
+    free(g.tensors);
+    qz_map_close(&in);
+    return w.status;
+}
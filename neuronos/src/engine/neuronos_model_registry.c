@@ -2,7 +2,7 @@
  * NeuronOS — Model Registry & Auto-Download Implementation
  *
  * Static catalog of ternary GGUF models + download engine.
- * Zero runtime dependencies: uses curl subprocess for HTTP.
+ * Zero runtime dependencies: ranged curl subprocesses for HTTP.
  *
  * Model selection algorithm:
  *   score = fits_in_ram * 1000
@@ -26,15 +26,47 @@
 #include <sys/stat.h>
 
 #include <errno.h>
+#include <time.h>
 
 #ifdef _WIN32
+    #include <windows.h>
     #include <direct.h>
     #include <io.h>
     #define isatty _isatty
     #define fileno _fileno
     #define mkdir(p, m) _mkdir(p)
+    #define strcasecmp _stricmp
+    #define strncasecmp _strnicmp
+    #define DL_POPEN_MODE "rb"
+typedef SRWLOCK dl_mutex_t;
+typedef HANDLE dl_thread_t;
+    #define dl_mutex_init(m) InitializeSRWLock(m)
+    #define dl_mutex_destroy(m) ((void)(m))
+    #define dl_mutex_lock(m) AcquireSRWLockExclusive(m)
+    #define dl_mutex_unlock(m) ReleaseSRWLockExclusive(m)
+    #define dl_fetch_add(p) (InterlockedIncrement((volatile LONG *)(p)) - 1)
+    #define dl_fetch_sub(p) InterlockedDecrement((volatile LONG *)(p))
+    #define dl_atomic_load(p) InterlockedCompareExchange((volatile LONG *)(p), 0, 0)
+    #define dl_atomic_store(p, v) InterlockedExchange((volatile LONG *)(p), (v))
+    #define dl_atomic_add64(p, v) InterlockedExchangeAdd64((volatile LONG64 *)(p), (v))
+    #define dl_atomic_load64(p) InterlockedCompareExchange64((volatile LONG64 *)(p), 0, 0)
 #else
+    #include <pthread.h>
+    #include <strings.h>
     #include <unistd.h>
+    #define DL_POPEN_MODE "r"
+typedef pthread_mutex_t dl_mutex_t;
+typedef pthread_t dl_thread_t;
+    #define dl_mutex_init(m) pthread_mutex_init(m, NULL)
+    #define dl_mutex_destroy(m) pthread_mutex_destroy(m)
+    #define dl_mutex_lock(m) pthread_mutex_lock(m)
+    #define dl_mutex_unlock(m) pthread_mutex_unlock(m)
+    #define dl_fetch_add(p) __atomic_fetch_add((p), 1, __ATOMIC_RELAXED)
+    #define dl_fetch_sub(p) __atomic_sub_fetch((p), 1, __ATOMIC_ACQ_REL)
+    #define dl_atomic_load(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define dl_atomic_store(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+    #define dl_atomic_add64(p, v) __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+    #define dl_atomic_load64(p) __atomic_load_n((p), __ATOMIC_RELAXED)
 #endif
 
 /* ============================================================
@@ -44,7 +76,8 @@
  * URLs are direct HuggingFace resolve links (no API needed).
  *
  * Size estimates based on HuggingFace file listings.
- * SHA256 set to NULL — will be populated as we verify them.
+ * SHA256 NULL: the download takes the digest HuggingFace serves
+ * for the LFS object (X-Linked-Etag) instead.
  * ============================================================ */
 
 static const neuronos_registry_entry_t REGISTRY[] = {
@@ -66,6 +99,8 @@ static const neuronos_registry_entry_t REGISTRY[] = {
         .family       = "bitnet",
         .languages    = "en",
         .quality_stars = 3,
+        .n_embd       = 2560,
+        .n_ff         = 6912,
     },
 
     /* ── Falcon3 1B (TII) ── */
@@ -86,6 +121,8 @@ static const neuronos_registry_entry_t REGISTRY[] = {
         .family       = "falcon3",
         .languages    = "en,fr,es,pt",
         .quality_stars = 2,
+        .n_embd       = 2048,
+        .n_ff         = 8192,
     },
 
     /* ── Falcon3 3B (TII) ── */
@@ -106,6 +143,8 @@ static const neuronos_registry_entry_t REGISTRY[] = {
         .family       = "falcon3",
         .languages    = "en,fr,es,pt",
         .quality_stars = 3,
+        .n_embd       = 3072,
+        .n_ff         = 9216,
     },
 
     /* ── Falcon3 7B (TII) ── */
@@ -126,6 +165,8 @@ static const neuronos_registry_entry_t REGISTRY[] = {
         .family       = "falcon3",
         .languages    = "en,fr,es,pt",
         .quality_stars = 4,
+        .n_embd       = 3072,
+        .n_ff         = 23040,
     },
 
     /* ── Falcon3 10B (TII) ── */
@@ -146,6 +187,8 @@ static const neuronos_registry_entry_t REGISTRY[] = {
         .family       = "falcon3",
         .languages    = "en,fr,es,pt",
         .quality_stars = 5,
+        .n_embd       = 3072,
+        .n_ff         = 23040,
     },
 
     /* ── Falcon-E 1B (TII, newer architecture) ── */
@@ -166,6 +209,8 @@ static const neuronos_registry_entry_t REGISTRY[] = {
         .family       = "falcon-e",
         .languages    = "en",
         .quality_stars = 3,
+        .n_embd       = 2048,
+        .n_ff         = 8192,
     },
 
     /* ── Falcon-E 3B (TII, newer architecture) ── */
@@ -186,6 +231,8 @@ static const neuronos_registry_entry_t REGISTRY[] = {
         .family       = "falcon-e",
         .languages    = "en",
         .quality_stars = 4,
+        .n_embd       = 2304,
+        .n_ff         = 6144,
     },
 };
 
@@ -337,22 +384,36 @@ static int ensure_dir(const char * path) {
     return mkdir(tmp, 0755) == 0 || errno == EEXIST ? 0 : -1;
 }
 
-/* errno.h already included at top */
-
 /* ============================================================
  * DOWNLOAD ENGINE
  *
- * Strategy: Use curl subprocess (available on 99.9% of systems).
- * This avoids adding libcurl as a dependency while providing:
- *   - HTTPS support
- *   - Redirect following (-L)
- *   - Resume support (-C -)
- *   - Progress bar (--progress-bar)
- *   - Timeout handling
+ * Strategy: parallel ranged fetches, integrity-checked in-process.
+ *   - HEAD request for size + Accept-Ranges
+ *   - <file>.part preallocated (sparse) to the final size
+ *   - DL_CHUNK_MB chunks pulled by a worker pool; each worker runs a
+ *     ranged curl subprocess (HTTPS + redirects without linking
+ *     libcurl) and writes its stream at the chunk offset
+ *   - SHA-256 of every chunk computed while it streams, recorded in
+ *     <file>.part.chunks after the data is synced: a restarted
+ *     download re-verifies and keeps completed chunks
+ *   - Whole-file SHA256 checked against the registry digest, or the
+ *     LFS sha256 HuggingFace reports as X-Linked-Etag, then an
+ *     atomic rename: the final path only ever holds a complete,
+ *     mmap-ready file
  *
- * Fallback: wget if curl not found.
+ * Fallback: wget if curl not found. Servers without range support
+ * get a single stream (no chunk resume).
  * ============================================================ */
 
+#ifndef DL_CHUNK_MB
+#define DL_CHUNK_MB 64        /* resume + verification granularity (tests shrink it) */
+#endif
+#define DL_CONNECTIONS 4      /* default; NEURONOS_DL_CONNECTIONS overrides */
+#define DL_MAX_CONNECTIONS 16
+#define DL_RETRIES 3          /* attempts per chunk */
+#define DL_BUF_SIZE (256 * 1024)
+#define DL_JOURNAL_MAGIC "neuronos-dl 1"
+
 /* Check if a command exists */
 static bool cmd_exists(const char * cmd) {
     char check[256];
@@ -360,6 +421,410 @@ static bool cmd_exists(const char * cmd) {
     return system(check) == 0;
 }
 
+/* ---- SHA-256 (FIPS 180-4) ---- */
+
+typedef struct {
+    uint32_t h[8];
+    uint64_t len;
+    uint8_t buf[64];
+    size_t n;
+} dl_sha256_t;
+
+static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define SHA256_ROR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void sha256_block(uint32_t h[8], const uint8_t * p) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++)
+        w[i] = (uint32_t)p[4 * i] << 24 | (uint32_t)p[4 * i + 1] << 16 | (uint32_t)p[4 * i + 2] << 8 | p[4 * i + 3];
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = SHA256_ROR(w[i - 15], 7) ^ SHA256_ROR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = SHA256_ROR(w[i - 2], 17) ^ SHA256_ROR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], k = h[7];
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = k + (SHA256_ROR(e, 6) ^ SHA256_ROR(e, 11) ^ SHA256_ROR(e, 25)) + ((e & f) ^ (~e & g)) +
+                      SHA256_K[i] + w[i];
+        uint32_t t2 = (SHA256_ROR(a, 2) ^ SHA256_ROR(a, 13) ^ SHA256_ROR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        k = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+    h[4] += e; h[5] += f; h[6] += g; h[7] += k;
+}
+
+static void sha256_init(dl_sha256_t * s) {
+    static const uint32_t H0[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                   0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    memcpy(s->h, H0, sizeof(H0));
+    s->len = 0;
+    s->n = 0;
+}
+
+static void sha256_update(dl_sha256_t * s, const uint8_t * p, size_t len) {
+    s->len += len;
+    if (s->n) {
+        size_t take = 64 - s->n < len ? 64 - s->n : len;
+        memcpy(s->buf + s->n, p, take);
+        s->n += take;
+        p += take;
+        len -= take;
+        if (s->n < 64)
+            return;
+        sha256_block(s->h, s->buf);
+        s->n = 0;
+    }
+    for (; len >= 64; p += 64, len -= 64)
+        sha256_block(s->h, p);
+    memcpy(s->buf, p, len);
+    s->n = len;
+}
+
+/* Lowercase hex digest into out[65] */
+static void sha256_final_hex(dl_sha256_t * s, char * out) {
+    uint64_t bits = s->len * 8;
+    uint8_t pad = 0x80;
+    sha256_update(s, &pad, 1);
+    pad = 0;
+    while (s->n != 56)
+        sha256_update(s, &pad, 1);
+    uint8_t len_be[8];
+    for (int i = 0; i < 8; i++)
+        len_be[i] = (uint8_t)(bits >> (56 - 8 * i));
+    sha256_update(s, len_be, 8);
+    for (int i = 0; i < 8; i++)
+        snprintf(out + 8 * i, 9, "%08x", s->h[i]);
+}
+
+/* ---- Download state ---- */
+
+typedef struct {
+    int64_t off;
+    int64_t len;             /* -1: unknown (single stream) */
+    char expect[65];         /* journaled digest, "" if none */
+} dl_chunk_t;
+
+typedef struct {
+    const char * url;
+    const char * part_path;
+    bool use_curl;
+    bool ranged;
+    int64_t total;           /* 0 if unknown */
+    dl_chunk_t * chunks;
+    int n_chunks;
+    int next;                /* shared cursor into chunks[] */
+    int64_t done_bytes;      /* verified + in-flight bytes, for progress */
+    int n_running;           /* workers still draining */
+    int failed;
+    int cancelled;
+    FILE * journal;
+    dl_mutex_t journal_lock;
+} dl_job_t;
+
+static void dl_seek(FILE * f, int64_t off) {
+#ifdef _WIN32
+    _fseeki64(f, off, SEEK_SET);
+#else
+    fseeko(f, (off_t)off, SEEK_SET);
+#endif
+}
+
+/* Push written pages to disk before the journal claims them */
+static void dl_sync(FILE * f) {
+    fflush(f);
+#ifdef _WIN32
+    _commit(_fileno(f));
+#else
+    fsync(fileno(f));
+#endif
+}
+
+/* SHA-256 of [off, off+len) of an open file; false on short read */
+static bool dl_hash_range(FILE * f, int64_t off, int64_t len, uint8_t * buf, char * hex) {
+    dl_sha256_t s;
+    sha256_init(&s);
+    dl_seek(f, off);
+    while (len > 0) {
+        size_t want = len < DL_BUF_SIZE ? (size_t)len : DL_BUF_SIZE;
+        size_t got = fread(buf, 1, want, f);
+        if (got == 0)
+            return false;
+        sha256_update(&s, buf, got);
+        len -= (int64_t)got;
+    }
+    sha256_final_hex(&s, hex);
+    return true;
+}
+
+/* Stream one chunk from a ranged subprocess into the .part file */
+static bool dl_fetch_chunk(dl_job_t * job, dl_chunk_t * c, FILE * out, uint8_t * buf, char * hex) {
+    /* wget rejects a 206 for a Range header it did not choose itself, so
+     * it streams from --start-pos to EOF and is cut off after len bytes */
+    char cmd[4096];
+    char range[64] = "";
+    if (job->ranged && job->use_curl)
+        snprintf(range, sizeof(range), " -r %lld-%lld", (long long)c->off, (long long)(c->off + c->len - 1));
+    else if (job->ranged)
+        snprintf(range, sizeof(range), " --start-pos=%lld", (long long)c->off);
+    if (job->use_curl)
+        snprintf(cmd, sizeof(cmd), "curl -fsL%s \"%s\"", range, job->url);
+    else
+        snprintf(cmd, sizeof(cmd), "wget -q -O -%s \"%s\"", range, job->url);
+
+    FILE * in = popen(cmd, DL_POPEN_MODE);
+    if (!in)
+        return false;
+
+    dl_sha256_t s;
+    sha256_init(&s);
+    dl_seek(out, c->off);
+    int64_t got = 0;
+    bool ok = true;
+    size_t want, n;
+    while ((want = c->len >= 0 && c->len - got < DL_BUF_SIZE ? (size_t)(c->len - got) : DL_BUF_SIZE) > 0 &&
+           (n = fread(buf, 1, want, in)) > 0) {
+        if (dl_atomic_load(&job->cancelled) || fwrite(buf, 1, n, out) != n) {
+            ok = false;
+            break;
+        }
+        sha256_update(&s, buf, n);
+        got += (int64_t)n;
+        dl_atomic_add64(&job->done_bytes, (int64_t)n);
+    }
+    /* curl must exit cleanly: surplus bytes (a server ignoring -r) make
+     * it fail on the closed pipe. wget is always cut off mid-stream. */
+    if (pclose(in) != 0 && (job->use_curl || !job->ranged))
+        ok = false;
+    if (ok && c->len >= 0 && got != c->len)
+        ok = false;
+    if (!ok) {
+        dl_atomic_add64(&job->done_bytes, -got);
+        return false;
+    }
+    dl_sync(out);
+    sha256_final_hex(&s, hex);
+    return true;
+}
+
+static void dl_drain(dl_job_t * job) {
+    uint8_t * buf = malloc(DL_BUF_SIZE);
+    FILE * out = fopen(job->part_path, "r+b");
+    if (!buf || !out) {
+        dl_atomic_store(&job->failed, 1);
+        goto out;
+    }
+
+    int k;
+    while ((k = (int)dl_fetch_add(&job->next)) < job->n_chunks) {
+        if (dl_atomic_load(&job->failed) || dl_atomic_load(&job->cancelled))
+            break;
+        dl_chunk_t * c = &job->chunks[k];
+        char hex[65];
+
+        /* Journaled on a previous run: keep it if the bytes still match */
+        if (c->expect[0]) {
+            fflush(out);
+            if (dl_hash_range(out, c->off, c->len, buf, hex) && strcmp(hex, c->expect) == 0) {
+                dl_atomic_add64(&job->done_bytes, c->len);
+                continue;
+            }
+        }
+
+        bool ok = false;
+        for (int attempt = 0; attempt < DL_RETRIES && !ok && !dl_atomic_load(&job->cancelled); attempt++)
+            ok = dl_fetch_chunk(job, c, out, buf, hex);
+        if (!ok) {
+            dl_atomic_store(&job->failed, 1);
+            break;
+        }
+        if (job->ranged) {
+            dl_mutex_lock(&job->journal_lock);
+            fprintf(job->journal, "%d %s\n", k, hex);
+            dl_sync(job->journal);
+            dl_mutex_unlock(&job->journal_lock);
+        }
+    }
+
+out:
+    if (out)
+        fclose(out);
+    free(buf);
+    dl_fetch_sub(&job->n_running);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI dl_worker(LPVOID arg) {
+    dl_drain((dl_job_t *)arg);
+    return 0;
+}
+#else
+static void * dl_worker(void * arg) {
+    dl_drain((dl_job_t *)arg);
+    return NULL;
+}
+#endif
+
+/* X-Linked-Etag value as a lowercase sha256 hex digest; false if it is
+ * not one (git blob ids of non-LFS files are 40 hex digits) */
+static bool dl_parse_sha256(const char * v, char * hex) {
+    while (*v == ' ' || *v == '"')
+        v++;
+    if (strncmp(v, "W/", 2) == 0)
+        return false;
+    int n = 0;
+    for (; n < 64; n++) {
+        char ch = v[n];
+        if (ch >= 'A' && ch <= 'F')
+            ch = (char)(ch - 'A' + 'a');
+        if (!((ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'f')))
+            return false;
+        hex[n] = ch;
+    }
+    if (v[64] != '"' && v[64] != '\r' && v[64] != '\n' && v[64] != ' ' && v[64] != '\0')
+        return false;
+    hex[64] = '\0';
+    return true;
+}
+
+/* HEAD request through the redirect chain: size and range support of
+ * the final response, and the sha256 from any X-Linked-Etag on the way
+ * (HuggingFace sends it on the /resolve redirect; "" if none).
+ * Returns false if the server could not be asked. */
+static bool dl_probe(const char * url, bool use_curl, int64_t * size, bool * ranged, char * sha256) {
+    char cmd[4096];
+    if (use_curl)
+        snprintf(cmd, sizeof(cmd), "curl -fsIL \"%s\"", url);
+    else
+        snprintf(cmd, sizeof(cmd), "wget -q -S --spider \"%s\" 2>&1", url);
+    FILE * fp = popen(cmd, "r");
+    if (!fp)
+        return false;
+
+    *size = 0;
+    *ranged = false;
+    sha256[0] = '\0';
+    char line[1024];
+    while (fgets(line, sizeof(line), fp)) {
+        char * p = line;
+        while (*p == ' ')
+            p++;
+        if (strncmp(p, "HTTP/", 5) == 0) { /* next response in the redirect chain */
+            *size = 0;
+            *ranged = false;
+        } else if (strncasecmp(p, "content-length:", 15) == 0) {
+            *size = atoll(p + 15);
+        } else if (strncasecmp(p, "accept-ranges:", 14) == 0) {
+            *ranged = strstr(p + 14, "bytes") != NULL;
+        } else if (strncasecmp(p, "x-linked-etag:", 14) == 0 && !dl_parse_sha256(p + 14, sha256)) {
+            sha256[0] = '\0';
+        }
+    }
+    return pclose(fp) == 0;
+}
+
+/* Chunk journal: header line, then "<index> <sha256>" per completed chunk */
+static void dl_load_journal(const char * path, dl_job_t * job, int64_t chunk_bytes) {
+    FILE * f = fopen(path, "r");
+    if (!f)
+        return;
+    char line[256];
+    long long total = 0, chunk = 0;
+    if (fgets(line, sizeof(line), f) &&
+        sscanf(line, DL_JOURNAL_MAGIC " %lld %lld", &total, &chunk) == 2 && total == job->total &&
+        chunk == chunk_bytes) {
+        int k;
+        char hex[65];
+        while (fgets(line, sizeof(line), f)) {
+            if (sscanf(line, "%d %64s", &k, hex) == 2 && k >= 0 && k < job->n_chunks && strlen(hex) == 64)
+                memcpy(job->chunks[k].expect, hex, sizeof(hex));
+        }
+    }
+    fclose(f);
+}
+
+/* Size the .part file; a mismatched earlier attempt starts from zero */
+static bool dl_prepare_part(const char * path, int64_t size, bool keep) {
+    FILE * f = fopen(path, keep ? "ab" : "wb");
+    if (!f)
+        return false;
+    bool ok = true;
+    if (size > 0) {
+#ifdef _WIN32
+        ok = _chsize_s(_fileno(f), size) == 0;
+#else
+        ok = ftruncate(fileno(f), (off_t)size) == 0; /* sparse until written */
+#endif
+    }
+    return fclose(f) == 0 && ok;
+}
+
+/* Whole-file SHA-256 against the registry digest */
+static bool dl_verify_file(const char * path, const char * expected, char * actual) {
+    FILE * f = fopen(path, "rb");
+    uint8_t * buf = malloc(DL_BUF_SIZE);
+    bool ok = false;
+    if (f && buf) {
+        dl_sha256_t s;
+        sha256_init(&s);
+        size_t n;
+        while ((n = fread(buf, 1, DL_BUF_SIZE, f)) > 0)
+            sha256_update(&s, buf, n);
+        sha256_final_hex(&s, actual);
+        ok = strcasecmp(actual, expected) == 0;
+    }
+    if (f)
+        fclose(f);
+    free(buf);
+    return ok;
+}
+
+static void dl_sleep_ms(int ms) {
+#ifdef _WIN32
+    Sleep((DWORD)ms);
+#else
+    usleep((useconds_t)ms * 1000);
+#endif
+}
+
+static void dl_print_progress(int64_t done, int64_t total, double mb_s) {
+    if (total > 0) {
+        int pct = (int)(done * 100 / total);
+        int bars = pct * 30 / 100;
+        fprintf(stderr, "\r  [%.*s%*s] %3d%%  %lld/%lld MB  %.1f MB/s ", bars,
+                "##############################", 30 - bars, "", pct, (long long)(done >> 20),
+                (long long)(total >> 20), mb_s);
+    } else {
+        fprintf(stderr, "\r  %lld MB  %.1f MB/s ", (long long)(done >> 20), mb_s);
+    }
+}
+
+static double dl_now_ms(void) {
+#ifdef _WIN32
+    return (double)GetTickCount64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+#endif
+}
+
 char * neuronos_model_find_downloaded(const neuronos_registry_entry_t * entry) {
     if (!entry)
         return NULL;
@@ -390,9 +855,6 @@ int neuronos_model_download(const neuronos_registry_entry_t * entry,
                             const char * dest_dir,
                             neuronos_download_progress_cb on_progress,
                             void * user_data) {
-    (void)on_progress;
-    (void)user_data;
-
     if (!entry || !entry->url)
         return -1;
 
@@ -412,9 +874,11 @@ int neuronos_model_download(const neuronos_registry_entry_t * entry,
     snprintf(model_dir, sizeof(model_dir), "%s/%s", dir, entry->id);
     ensure_dir(model_dir);
 
-    /* Full path for the model file */
-    char dest_path[1024];
+    /* Full path for the model file, plus the in-progress file and its chunk journal */
+    char dest_path[1024], part_path[1040], journal_path[1060];
     snprintf(dest_path, sizeof(dest_path), "%s/%s", model_dir, entry->filename);
+    snprintf(part_path, sizeof(part_path), "%s.part", dest_path);
+    snprintf(journal_path, sizeof(journal_path), "%s.chunks", part_path);
 
     /* Check if already downloaded */
     struct stat st;
@@ -425,7 +889,8 @@ int neuronos_model_download(const neuronos_registry_entry_t * entry,
             fprintf(stderr, "  Model already downloaded: %s\n", dest_path);
             return 0;
         }
-        /* Partial download — will resume */
+        /* Truncated file from the old in-place downloader: start over */
+        remove(dest_path);
     }
 
     /* Display download banner */
@@ -442,28 +907,9 @@ int neuronos_model_download(const neuronos_registry_entry_t * entry,
             (long long)entry->size_mb,
             entry->id);
 
-    /* Build download command */
-    char cmd[4096];
     bool is_tty = isatty(fileno(stderr));
-
-    if (cmd_exists("curl")) {
-        if (is_tty) {
-            snprintf(cmd, sizeof(cmd),
-                     "curl -fL --progress-bar -C - "
-                     "-o \"%s\" \"%s\"",
-                     dest_path, entry->url);
-        } else {
-            snprintf(cmd, sizeof(cmd),
-                     "curl -fL -s -C - "
-                     "-o \"%s\" \"%s\"",
-                     dest_path, entry->url);
-        }
-    } else if (cmd_exists("wget")) {
-        snprintf(cmd, sizeof(cmd),
-                 "wget -c -q --show-progress "
-                 "-O \"%s\" \"%s\"",
-                 dest_path, entry->url);
-    } else {
+    bool use_curl = cmd_exists("curl");
+    if (!use_curl && !cmd_exists("wget")) {
         fprintf(stderr,
                 "\033[31mError: Neither curl nor wget found.\033[0m\n"
                 "Please install curl:  sudo apt install curl\n"
@@ -472,67 +918,153 @@ int neuronos_model_download(const neuronos_registry_entry_t * entry,
         return -1;
     }
 
-    /* Execute download */
-    int ret = system(cmd);
-    if (ret != 0) {
+    /* Plan chunks: ranged when the server reports a size and byte ranges */
+    dl_job_t job = {.url = entry->url, .part_path = part_path, .use_curl = use_curl};
+    int64_t size = 0;
+    bool ranged = false;
+    char linked_sha256[65];
+    dl_probe(entry->url, use_curl, &size, &ranged, linked_sha256);
+    const char * expected = entry->sha256 ? entry->sha256 : linked_sha256[0] ? linked_sha256 : NULL;
+    if (!expected)
         fprintf(stderr,
-                "\n\033[31mDownload failed.\033[0m\n"
-                "Try manually:\n"
-                "  curl -L -o \"%s\" \"%s\"\n",
-                dest_path, entry->url);
-        /* Clean up partial file on failure (not resume-related) */
+                "\033[33m  WARNING: no SHA-256 known for %s: the download cannot be verified.\033[0m\n"
+                "  Chunks are still checked on resume, but corruption in transit goes unnoticed.\n",
+                entry->filename);
+    job.total = size;
+    job.ranged = ranged && size > 0;
+
+    const int64_t chunk_bytes = (int64_t)DL_CHUNK_MB << 20;
+    job.n_chunks = job.ranged ? (int)((size + chunk_bytes - 1) / chunk_bytes) : 1;
+    job.chunks = calloc((size_t)job.n_chunks, sizeof(dl_chunk_t));
+    if (!job.chunks)
         return -1;
+    for (int i = 0; i < job.n_chunks; i++) {
+        job.chunks[i].off = (int64_t)i * chunk_bytes;
+        job.chunks[i].len = !job.ranged ? (size > 0 ? size : -1)
+                            : (size - job.chunks[i].off < chunk_bytes ? size - job.chunks[i].off : chunk_bytes);
+    }
+
+    bool resume = false;
+    if (job.ranged) {
+        dl_load_journal(journal_path, &job, chunk_bytes);
+        for (int i = 0; i < job.n_chunks && !resume; i++)
+            resume = job.chunks[i].expect[0] != '\0';
     }
+    if (resume)
+        fprintf(stderr, "  Resuming: verifying chunks already on disk\n");
 
-    /* Verify file was written */
-    if (stat(dest_path, &st) != 0 || st.st_size == 0) {
-        fprintf(stderr, "\033[31mError: Downloaded file is empty or missing.\033[0m\n");
+    if (!dl_prepare_part(part_path, job.ranged ? size : 0, resume)) {
+        fprintf(stderr, "\033[31mError: cannot create %s\033[0m\n", part_path);
+        free(job.chunks);
         return -1;
     }
+    if (job.ranged) {
+        job.journal = fopen(journal_path, resume ? "a" : "w");
+        if (!job.journal) {
+            free(job.chunks);
+            return -1;
+        }
+        if (!resume) {
+            fprintf(job.journal, DL_JOURNAL_MAGIC " %lld %lld\n", (long long)size, (long long)chunk_bytes);
+            dl_sync(job.journal);
+        }
+    }
+
+    /* Worker pool; this thread only reports progress */
+    int n_conn = DL_CONNECTIONS;
+    const char * env_conn = getenv("NEURONOS_DL_CONNECTIONS");
+    if (env_conn && atoi(env_conn) > 0)
+        n_conn = atoi(env_conn);
+    if (n_conn > DL_MAX_CONNECTIONS)
+        n_conn = DL_MAX_CONNECTIONS;
+    if (n_conn > job.n_chunks)
+        n_conn = job.n_chunks;
+
+    dl_mutex_init(&job.journal_lock);
+    dl_thread_t threads[DL_MAX_CONNECTIONS];
+    job.n_running = n_conn;
+    int started = 0;
+    for (; started < n_conn; started++) {
+#ifdef _WIN32
+        threads[started] = CreateThread(NULL, 0, dl_worker, &job, 0, NULL);
+        if (!threads[started])
+            break;
+#else
+        if (pthread_create(&threads[started], NULL, dl_worker, &job) != 0)
+            break;
+#endif
+    }
+    for (int i = started; i < n_conn; i++)
+        dl_fetch_sub(&job.n_running);
+    if (started == 0) {
+        job.n_running = 1;
+        dl_drain(&job); /* no threads (e.g. WASM): one stream inline */
+    }
 
-    /* SHA256 verification (if checksum known) */
-    if (entry->sha256) {
-        char sha_cmd[2048];
-        char expected_line[256];
-        snprintf(expected_line, sizeof(expected_line), "%s", entry->sha256);
-
-        if (cmd_exists("sha256sum")) {
-            snprintf(sha_cmd, sizeof(sha_cmd),
-                     "sha256sum \"%s\" | cut -d' ' -f1", dest_path);
-        } else if (cmd_exists("shasum")) {
-            snprintf(sha_cmd, sizeof(sha_cmd),
-                     "shasum -a 256 \"%s\" | cut -d' ' -f1", dest_path);
-        } else {
-            fprintf(stderr, "  [skipping SHA256 check: no sha256sum/shasum found]\n");
-            goto done;
+    double t0 = dl_now_ms();
+    while (dl_atomic_load(&job.n_running) > 0) {
+        dl_sleep_ms(200);
+        int64_t done = dl_atomic_load64(&job.done_bytes);
+        if (on_progress) {
+            if (!on_progress(done, size, user_data))
+                dl_atomic_store(&job.cancelled, 1);
+        } else if (is_tty) {
+            double secs = (dl_now_ms() - t0) / 1000.0;
+            dl_print_progress(done, size, secs > 0 ? (double)done / (1 << 20) / secs : 0.0);
         }
+    }
+    for (int i = 0; i < started; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#else
+        pthread_join(threads[i], NULL);
+#endif
+    }
+    if (is_tty && !on_progress)
+        fputc('\n', stderr);
 
-        FILE * fp = popen(sha_cmd, "r");
-        if (fp) {
-            char actual[128] = {0};
-            if (fgets(actual, sizeof(actual), fp)) {
-                /* Trim newline */
-                size_t len = strlen(actual);
-                while (len > 0 && (actual[len - 1] == '\n' || actual[len - 1] == '\r'))
-                    actual[--len] = '\0';
-
-                if (strcmp(actual, expected_line) != 0) {
-                    fprintf(stderr,
-                            "\033[31mSHA256 mismatch!\033[0m\n"
-                            "  Expected: %s\n"
-                            "  Got:      %s\n"
-                            "  File may be corrupt. Delete and retry.\n",
-                            expected_line, actual);
-                    pclose(fp);
-                    return -2;
-                }
-            }
-            pclose(fp);
+    if (job.journal)
+        fclose(job.journal);
+    dl_mutex_destroy(&job.journal_lock);
+    free(job.chunks);
+
+    if (job.cancelled || job.failed) {
+        fprintf(stderr,
+                "\n\033[31mDownload %s.\033[0m\n"
+                "%s",
+                job.cancelled ? "cancelled" : "failed",
+                job.ranged ? "Completed chunks are kept: run the same command again to resume.\n" : "");
+        return -1;
+    }
+
+    /* SHA256 verification: registry digest, else the server's LFS digest */
+    if (expected) {
+        char actual[65] = {0};
+        if (!dl_verify_file(part_path, expected, actual)) {
+            fprintf(stderr,
+                    "\033[31mSHA256 mismatch!\033[0m\n"
+                    "  Expected: %s\n"
+                    "  Got:      %s\n"
+                    "  Corrupt download removed. Retry.\n",
+                    expected, actual);
+            remove(part_path);
+            remove(journal_path);
+            return -2;
         }
-        fprintf(stderr, "  \033[32m✓ SHA256 verified\033[0m\n");
+        fprintf(stderr, "  \033[32m✓ SHA256 verified%s\033[0m\n", entry->sha256 ? "" : " (X-Linked-Etag)");
+    }
+
+    /* Publish: the final name only ever refers to a complete file */
+#ifdef _WIN32
+    remove(dest_path); /* rename() does not replace on Windows */
+#endif
+    if (rename(part_path, dest_path) != 0) {
+        fprintf(stderr, "\033[31mError: cannot rename %s\033[0m\n", part_path);
+        return -1;
     }
+    remove(journal_path);
 
-done:
     fprintf(stderr, "  \033[32m✓ Model ready: %s\033[0m\n\n", dest_path);
     return 0;
 }
@@ -41,6 +41,11 @@
     #include <unistd.h>
 #endif
 
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+#endif
+
 /* ============================================================
  * HARDWARE DETECTION
  * ============================================================ */
@@ -421,13 +426,38 @@ void neuronos_hw_print_info(const neuronos_hw_info_t * hw) {
 /* Maximum models we'll scan */
 #define MAX_SCAN_MODELS 128
 
-/* Get file size in MB */
-static int64_t file_size_mb(const char * path) {
-    struct stat st;
-    if (stat(path, &st) == 0) {
-        return (int64_t)(st.st_size / (1024 * 1024));
-    }
-    return 0;
+#define MIB (1024LL * 1024LL)
+
+/* est_ram_mb budgets weights + KV for this many tokens + fixed overhead */
+#define SCAN_CTX 2048
+#define SCAN_OVERHEAD_MB 100
+
+/* Only this much of the file is mapped: metadata + tensor table of any
+ * real model (even a 256K-token vocab) is a few tens of MB. */
+#define GGUF_MAP_MAX (256LL * MIB)
+#define GGUF_MAX_TENSORS (1u << 20)
+
+#define MODEL_IDX_FILE_NAME "models.idx"
+#define MODEL_IDX_MAGIC "neuronos-models-idx 1"
+
+#ifdef _WIN32
+typedef struct _stat64 scan_stat_t;
+    #define scan_stat _stat64
+    #define scan_mkdir(path) _mkdir(path)
+#else
+typedef struct stat scan_stat_t;
+    #define scan_stat stat
+    #define scan_mkdir(path) mkdir(path, 0755)
+#endif
+
+/* Size and mtime of a regular file; false if missing or not a file */
+static bool file_stat(const char * path, int64_t * size, int64_t * mtime) {
+    scan_stat_t st;
+    if (scan_stat(path, &st) != 0 || !(st.st_mode & S_IFREG))
+        return false;
+    *size = (int64_t)st.st_size;
+    *mtime = (int64_t)st.st_mtime;
+    return true;
 }
 
 /* Extract model name from file path (just the filename without .gguf) */
@@ -506,6 +536,445 @@ static int64_t estimate_params_from_quant(int64_t file_size_mb_val, neuronos_qua
     return (int64_t)((double)(file_size_mb_val) * 1024.0 * 1024.0 / (double)bpp);
 }
 
+/* ---- GGUF header reader ----
+ * Reads the metadata KVs and the tensor table straight out of a read-only
+ * mapping. The weight pages behind them are never touched, so a scan
+ * costs a few page faults per model instead of a file read. */
+
+/* What the scanner needs from one GGUF file (also the models.idx record) */
+typedef struct {
+    bool valid;               /* header parsed; otherwise use filename heuristics */
+    int64_t n_params;         /* exact: sum of tensor element counts */
+    int64_t weight_bytes;     /* tensor data section size */
+    neuronos_quant_type_t quant;
+    int n_layer;
+    int n_embd;
+    int n_ctx_train;
+    int64_t kv_bytes_per_tok; /* f16 K+V across all layers, 0 if unknown */
+} gguf_meta_t;
+
+/* GGUF metadata value types */
+enum {
+    GGUF_U8, GGUF_I8, GGUF_U16, GGUF_I16, GGUF_U32, GGUF_I32, GGUF_F32,
+    GGUF_BOOL, GGUF_STR, GGUF_ARR, GGUF_U64, GGUF_I64, GGUF_F64, GGUF_N_TYPES
+};
+static const uint8_t GGUF_TYPE_SIZE[GGUF_N_TYPES] = {1, 1, 2, 2, 4, 4, 4, 1, 0, 0, 8, 8, 8};
+
+typedef struct {
+    const uint8_t * p;
+    const uint8_t * end;
+    bool ok;
+} gguf_cur_t;
+
+static bool gguf_need(gguf_cur_t * c, uint64_t n) {
+    if (c->ok && (uint64_t)(c->end - c->p) >= n)
+        return true;
+    c->ok = false;
+    return false;
+}
+
+static uint32_t gguf_u32(gguf_cur_t * c) {
+    uint32_t v = 0;
+    if (gguf_need(c, 4)) {
+        memcpy(&v, c->p, 4);
+        c->p += 4;
+    }
+    return v;
+}
+
+static uint64_t gguf_u64(gguf_cur_t * c) {
+    uint64_t v = 0;
+    if (gguf_need(c, 8)) {
+        memcpy(&v, c->p, 8);
+        c->p += 8;
+    }
+    return v;
+}
+
+/* Length-prefixed, not NUL-terminated */
+static const char * gguf_str(gguf_cur_t * c, size_t * len) {
+    uint64_t n = gguf_u64(c);
+    *len = 0;
+    if (!gguf_need(c, n))
+        return "";
+    const char * s = (const char *)c->p;
+    c->p += n;
+    *len = (size_t)n;
+    return s;
+}
+
+/* Read or skip one value. With out set, integers (and the max of an
+ * integer array, e.g. per-layer head_count_kv) are stored there;
+ * returns true when *out was written. */
+static bool gguf_value(gguf_cur_t * c, uint32_t type, int64_t * out, int depth) {
+    if (type >= GGUF_N_TYPES) {
+        c->ok = false;
+        return false;
+    }
+    if (type == GGUF_STR) {
+        size_t len;
+        gguf_str(c, &len);
+        return false;
+    }
+    if (type == GGUF_ARR) {
+        uint32_t elem = gguf_u32(c);
+        uint64_t n = gguf_u64(c);
+        if (!c->ok || depth > 2 || elem >= GGUF_N_TYPES) {
+            c->ok = false;
+            return false;
+        }
+        if (!out && GGUF_TYPE_SIZE[elem]) {
+            /* Fixed-size elements nobody asked for (token scores, types): one skip */
+            if (n > UINT64_MAX / GGUF_TYPE_SIZE[elem] || !gguf_need(c, n * GGUF_TYPE_SIZE[elem]))
+                return false;
+            c->p += n * GGUF_TYPE_SIZE[elem];
+            return false;
+        }
+        bool found = false;
+        for (uint64_t i = 0; i < n && c->ok; i++) {
+            int64_t v = 0;
+            if (gguf_value(c, elem, out ? &v : NULL, depth + 1) && (!found || v > *out)) {
+                *out = v;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    const uint8_t * p = c->p;
+    if (!gguf_need(c, GGUF_TYPE_SIZE[type]))
+        return false;
+    c->p += GGUF_TYPE_SIZE[type];
+    if (!out)
+        return false;
+    switch (type) {
+    case GGUF_U8: *out = *p; return true;
+    case GGUF_I8: *out = (int8_t)*p; return true;
+    case GGUF_U16: { uint16_t v; memcpy(&v, p, 2); *out = v; return true; }
+    case GGUF_I16: { int16_t v; memcpy(&v, p, 2); *out = v; return true; }
+    case GGUF_U32: { uint32_t v; memcpy(&v, p, 4); *out = v; return true; }
+    case GGUF_I32: { int32_t v; memcpy(&v, p, 4); *out = v; return true; }
+    case GGUF_U64: { uint64_t v; memcpy(&v, p, 8); *out = v > INT64_MAX ? INT64_MAX : (int64_t)v; return true; }
+    case GGUF_I64: { int64_t v; memcpy(&v, p, 8); *out = v; return true; }
+    default: return false; /* floats, bool */
+    }
+}
+
+/* "<arch><suffix>" with arch a single dotted component */
+static bool gguf_key_is(const char * key, size_t len, const char * suffix) {
+    const char * dot = memchr(key, '.', len);
+    size_t slen = strlen(suffix);
+    return dot && (size_t)(key + len - dot) == slen && memcmp(dot, suffix, slen) == 0;
+}
+
+/* Map the dominant ggml tensor type onto the scanner's quant classes.
+ * 36-38 are the BitNet fork's I2_S / TL1 / TL2. */
+static neuronos_quant_type_t gguf_quant_of(uint32_t ggml_type) {
+    switch (ggml_type) {
+    case 0: case 1: case 30: return NEURONOS_QUANT_F16;                 /* F32, F16, BF16 */
+    case 2: case 3: case 20: case 31: case 32: case 33:
+        return NEURONOS_QUANT_Q4_0;                                     /* Q4_0/1, IQ4_NL, Q4_0_x_y */
+    case 12: case 23: return NEURONOS_QUANT_Q4_K_M;                     /* Q4_K, IQ4_XS */
+    case 6: case 7: case 13: return NEURONOS_QUANT_Q5_K_M;              /* Q5_0/1, Q5_K */
+    case 14: return NEURONOS_QUANT_Q6_K;
+    case 8: case 9: case 15: return NEURONOS_QUANT_Q8_0;                /* Q8_0/1, Q8_K */
+    case 11: case 18: case 21: return NEURONOS_QUANT_Q3_K;              /* Q3_K, IQ3_* */
+    case 10: case 16: case 17: case 19: case 22: case 29: case 34: case 35:
+        return NEURONOS_QUANT_Q2_K;                                     /* Q2_K, IQ2_*, IQ1_*, TQ* */
+    case 36: return NEURONOS_QUANT_I2_S;
+    case 37: case 38: return NEURONOS_QUANT_TL1;
+    default: return NEURONOS_QUANT_UNKNOWN;
+    }
+}
+
+static bool gguf_parse(const uint8_t * base, size_t len, int64_t file_size, gguf_meta_t * m) {
+    gguf_cur_t c = {base, base + len, true};
+    if (len < 24 || memcmp(base, "GGUF", 4) != 0)
+        return false;
+    c.p += 4;
+    if (gguf_u32(&c) < 2) /* v1 used 32-bit counts; long obsolete */
+        return false;
+    uint64_t n_tensors = gguf_u64(&c);
+    uint64_t n_kv = gguf_u64(&c);
+    if (n_tensors > GGUF_MAX_TENSORS)
+        return false;
+
+    int64_t n_layer = 0, n_embd = 0, n_ctx = 0, n_head = 0, n_head_kv = 0, k_len = 0, v_len = 0;
+    int64_t align = 32;
+    for (uint64_t i = 0; i < n_kv && c.ok; i++) {
+        size_t klen;
+        const char * key = gguf_str(&c, &klen);
+        uint32_t type = gguf_u32(&c);
+        int64_t * dst = NULL;
+        if (gguf_key_is(key, klen, ".block_count"))
+            dst = &n_layer;
+        else if (gguf_key_is(key, klen, ".embedding_length"))
+            dst = &n_embd;
+        else if (gguf_key_is(key, klen, ".context_length"))
+            dst = &n_ctx;
+        else if (gguf_key_is(key, klen, ".attention.head_count"))
+            dst = &n_head;
+        else if (gguf_key_is(key, klen, ".attention.head_count_kv"))
+            dst = &n_head_kv;
+        else if (gguf_key_is(key, klen, ".attention.key_length"))
+            dst = &k_len;
+        else if (gguf_key_is(key, klen, ".attention.value_length"))
+            dst = &v_len;
+        else if (klen == 17 && memcmp(key, "general.alignment", 17) == 0)
+            dst = &align;
+        gguf_value(&c, type, dst, 0);
+    }
+
+    /* Tensor table: exact parameter count and the type holding most weights */
+    int64_t by_type[64] = {0};
+    int64_t n_params = 0;
+    for (uint64_t i = 0; i < n_tensors && c.ok; i++) {
+        size_t nlen;
+        gguf_str(&c, &nlen);
+        uint32_t n_dims = gguf_u32(&c);
+        if (n_dims > 4) {
+            c.ok = false;
+            break;
+        }
+        int64_t ne = 1;
+        for (uint32_t d = 0; d < n_dims; d++) {
+            uint64_t dim = gguf_u64(&c);
+            if (dim && (uint64_t)ne > (uint64_t)INT64_MAX / dim)
+                c.ok = false;
+            else
+                ne *= (int64_t)dim;
+        }
+        uint32_t ggml_type = gguf_u32(&c);
+        gguf_u64(&c); /* data offset */
+        n_params += ne;
+        if (n_dims >= 2 && ggml_type < 64)
+            by_type[ggml_type] += ne;
+    }
+    if (!c.ok || align <= 0)
+        return false;
+
+    uint32_t dominant = 0;
+    for (uint32_t t = 1; t < 64; t++)
+        if (by_type[t] > by_type[dominant])
+            dominant = t;
+
+    int64_t data_off = ((int64_t)(c.p - base) + align - 1) / align * align;
+    m->n_params = n_params;
+    m->weight_bytes = file_size > data_off ? file_size - data_off : 0;
+    m->quant = gguf_quant_of(dominant);
+    m->n_layer = (int)n_layer;
+    m->n_embd = (int)n_embd;
+    m->n_ctx_train = n_ctx > INT32_MAX ? INT32_MAX : (int)n_ctx;
+
+    /* Per token each layer caches n_head_kv K and V heads (GQA-aware) */
+    if (n_layer > 0 && n_head > 0 && n_embd > 0) {
+        if (n_head_kv <= 0)
+            n_head_kv = n_head;
+        if (k_len <= 0)
+            k_len = n_embd / n_head;
+        if (v_len <= 0)
+            v_len = n_embd / n_head;
+        m->kv_bytes_per_tok = n_layer * n_head_kv * (k_len + v_len) * 2;
+    }
+    return true;
+}
+
+/* Parse the GGUF header of path (size bytes) through a read-only mapping */
+static void gguf_read_meta(const char * path, int64_t size, gguf_meta_t * m) {
+    memset(m, 0, sizeof(*m));
+    if (size < 24)
+        return;
+    size_t map_len = (size_t)(size < GGUF_MAP_MAX ? size : GGUF_MAP_MAX);
+#ifdef _WIN32
+    HANDLE f = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (f == INVALID_HANDLE_VALUE)
+        return;
+    HANDLE map = CreateFileMappingA(f, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (map) {
+        const uint8_t * base = (const uint8_t *)MapViewOfFile(map, FILE_MAP_READ, 0, 0, map_len);
+        if (base) {
+            m->valid = gguf_parse(base, map_len, size, m);
+            UnmapViewOfFile(base);
+        }
+        CloseHandle(map);
+    }
+    CloseHandle(f);
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return;
+    void * base = mmap(NULL, map_len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (base != MAP_FAILED) {
+        m->valid = gguf_parse((const uint8_t *)base, map_len, size, m);
+        munmap(base, map_len);
+    }
+    close(fd);
+#endif
+}
+
+/* ---- Scan cache: ~/.neuronos/models.idx ----
+ * One line per file: "<path>\t<size> <mtime> <meta fields>". A record is
+ * reused only while size and mtime match, so replaced files are re-read.
+ * Scores are not cached: they depend on the current hardware. */
+
+typedef struct {
+    char path[512];
+    int64_t size;
+    int64_t mtime;
+    bool seen; /* looked up by this scan */
+    gguf_meta_t meta;
+} model_idx_rec_t;
+
+typedef struct {
+    model_idx_rec_t * recs;
+    int n;
+    int cap;
+    bool dirty;
+} model_idx_t;
+
+/* ~/.neuronos/models.idx; creates ~/.neuronos when mkdir_parent */
+static bool model_idx_path(char * buf, size_t len, bool mkdir_parent) {
+    const char * home = getenv("HOME");
+#ifdef _WIN32
+    if (!home)
+        home = getenv("USERPROFILE");
+#endif
+    if (!home)
+        return false;
+    snprintf(buf, len, "%s/.neuronos", home);
+    if (mkdir_parent)
+        scan_mkdir(buf);
+    snprintf(buf, len, "%s/.neuronos/" MODEL_IDX_FILE_NAME, home);
+    return true;
+}
+
+static model_idx_rec_t * model_idx_add(model_idx_t * idx) {
+    if (idx->n == idx->cap) {
+        int cap = idx->cap ? idx->cap * 2 : 32;
+        model_idx_rec_t * r = realloc(idx->recs, (size_t)cap * sizeof(*r));
+        if (!r)
+            return NULL;
+        idx->recs = r;
+        idx->cap = cap;
+    }
+    model_idx_rec_t * rec = &idx->recs[idx->n++];
+    memset(rec, 0, sizeof(*rec));
+    return rec;
+}
+
+static void model_idx_load(model_idx_t * idx) {
+    memset(idx, 0, sizeof(*idx));
+    char path[512];
+    if (!model_idx_path(path, sizeof(path), false))
+        return;
+    FILE * f = fopen(path, "r");
+    if (!f)
+        return;
+
+    char line[1024];
+    if (!fgets(line, sizeof(line), f) || strncmp(line, MODEL_IDX_MAGIC, strlen(MODEL_IDX_MAGIC)) != 0) {
+        fclose(f); /* other format version: rebuild */
+        return;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        char * tab = strchr(line, '\t');
+        if (!tab || (size_t)(tab - line) >= sizeof(idx->recs[0].path))
+            continue;
+        *tab = '\0';
+        long long size, mtime, n_params, weight_bytes, kv;
+        int valid, quant, n_layer, n_embd, n_ctx;
+        if (sscanf(tab + 1, "%lld %lld %d %lld %lld %d %d %d %d %lld", &size, &mtime, &valid, &n_params,
+                   &weight_bytes, &quant, &n_layer, &n_embd, &n_ctx, &kv) != 10)
+            continue;
+        model_idx_rec_t * rec = model_idx_add(idx);
+        if (!rec)
+            break;
+        memcpy(rec->path, line, (size_t)(tab - line) + 1);
+        rec->size = size;
+        rec->mtime = mtime;
+        rec->meta.valid = valid != 0;
+        rec->meta.n_params = n_params;
+        rec->meta.weight_bytes = weight_bytes;
+        rec->meta.quant = (quant >= NEURONOS_QUANT_UNKNOWN && quant <= NEURONOS_QUANT_F16)
+                              ? (neuronos_quant_type_t)quant
+                              : NEURONOS_QUANT_UNKNOWN;
+        rec->meta.n_layer = n_layer;
+        rec->meta.n_embd = n_embd;
+        rec->meta.n_ctx_train = n_ctx;
+        rec->meta.kv_bytes_per_tok = kv;
+    }
+    fclose(f);
+}
+
+/* Header facts for path: from the index while size/mtime match, else
+ * parsed from the file and recorded */
+static void model_idx_get(model_idx_t * idx, const char * path, int64_t size, int64_t mtime, gguf_meta_t * m) {
+    model_idx_rec_t * rec = NULL;
+    for (int i = 0; i < idx->n; i++) {
+        if (strcmp(idx->recs[i].path, path) == 0) {
+            rec = &idx->recs[i];
+            break;
+        }
+    }
+    if (rec && rec->size == size && rec->mtime == mtime) {
+        rec->seen = true;
+        *m = rec->meta;
+        return;
+    }
+
+    gguf_read_meta(path, size, m);
+    /* Tabs or newlines would break the line format; such paths just aren't cached */
+    if (strlen(path) >= sizeof(rec->path) || strpbrk(path, "\t\r\n"))
+        return;
+    if (!rec) {
+        rec = model_idx_add(idx);
+        if (!rec)
+            return;
+        snprintf(rec->path, sizeof(rec->path), "%s", path);
+    }
+    rec->size = size;
+    rec->mtime = mtime;
+    rec->seen = true;
+    rec->meta = *m;
+    idx->dirty = true;
+}
+
+/* Rewrite the index if this scan changed it, dropping files that are gone */
+static void model_idx_save(model_idx_t * idx) {
+    char path[512], tmp[520];
+    if (!idx->dirty || !model_idx_path(path, sizeof(path), true))
+        return;
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE * out = fopen(tmp, "w");
+    if (!out)
+        return;
+
+    fprintf(out, "%s\n", MODEL_IDX_MAGIC);
+    for (int i = 0; i < idx->n; i++) {
+        const model_idx_rec_t * r = &idx->recs[i];
+        int64_t size, mtime;
+        if (!r->seen && (!file_stat(r->path, &size, &mtime) || size != r->size || mtime != r->mtime))
+            continue;
+        fprintf(out, "%s\t%lld %lld %d %lld %lld %d %d %d %d %lld\n", r->path, (long long)r->size,
+                (long long)r->mtime, r->meta.valid ? 1 : 0, (long long)r->meta.n_params,
+                (long long)r->meta.weight_bytes, (int)r->meta.quant, r->meta.n_layer, r->meta.n_embd,
+                r->meta.n_ctx_train, (long long)r->meta.kv_bytes_per_tok);
+    }
+
+    bool ok = fclose(out) == 0;
+#ifdef _WIN32
+    remove(path); /* rename() does not replace on Windows */
+#endif
+    if (!ok || rename(tmp, path) != 0)
+        remove(tmp);
+    idx->dirty = false;
+}
+
+static void model_idx_free(model_idx_t * idx) {
+    free(idx->recs);
+    memset(idx, 0, sizeof(*idx));
+}
+
 /* Score a model based on hardware fit */
 static float score_model(const neuronos_model_entry_t * entry, const neuronos_hw_info_t * hw) {
     float score = 0.0f;
@@ -578,9 +1047,43 @@ static float score_model(const neuronos_model_entry_t * entry, const neuronos_hw
     return score;
 }
 
+/* Fill one entry: header facts (cached), then RAM estimate and score */
+static void fill_model_entry(neuronos_model_entry_t * e, const char * path, const neuronos_hw_info_t * hw,
+                             model_idx_t * idx) {
+    int64_t size = 0, mtime = 0;
+    file_stat(path, &size, &mtime);
+
+    snprintf(e->path, sizeof(e->path), "%s", path);
+    extract_model_name(path, e->name, sizeof(e->name));
+    e->file_size_mb = size / MIB;
+
+    gguf_meta_t m;
+    model_idx_get(idx, path, size, mtime, &m);
+    if (m.valid) {
+        int n_ctx = m.n_ctx_train > 0 && m.n_ctx_train < SCAN_CTX ? m.n_ctx_train : SCAN_CTX;
+        int64_t weights_mb = m.weight_bytes / MIB;
+        int64_t kv_mb = m.kv_bytes_per_tok > 0 ? m.kv_bytes_per_tok * n_ctx / MIB : weights_mb * 30 / 100;
+        e->est_ram_mb = weights_mb + kv_mb + SCAN_OVERHEAD_MB;
+        e->quant = m.quant != NEURONOS_QUANT_UNKNOWN ? m.quant : detect_quant_type(e->name);
+        e->n_params_est = m.n_params;
+        e->n_layer = m.n_layer;
+        e->n_embd = m.n_embd;
+        e->n_ctx_train = m.n_ctx_train;
+        e->kv_bytes_per_tok = m.kv_bytes_per_tok;
+    } else {
+        /* Unreadable header: fall back to filename heuristics */
+        e->est_ram_mb = estimate_ram_needed(e->file_size_mb);
+        e->quant = detect_quant_type(e->name);
+        e->n_params_est = estimate_params_from_quant(e->file_size_mb, e->quant);
+    }
+    e->is_ternary = (e->quant == NEURONOS_QUANT_I2_S || e->quant == NEURONOS_QUANT_TL1);
+    e->fits_in_ram = (e->est_ram_mb <= hw->model_budget_mb);
+    e->score = score_model(e, hw);
+}
+
 /* Recursive directory walker for .gguf files */
-static int scan_dir_recursive(const char * dir_path, const neuronos_hw_info_t * hw, neuronos_model_entry_t * entries,
-                              int max_entries, int current_count) {
+static int scan_dir_recursive(const char * dir_path, const neuronos_hw_info_t * hw, model_idx_t * idx,
+                              neuronos_model_entry_t * entries, int max_entries, int current_count) {
 #ifdef _WIN32
     char search_path[1024];
     snprintf(search_path, sizeof(search_path), "%s\\*", dir_path);
@@ -598,20 +1101,11 @@ static int scan_dir_recursive(const char * dir_path, const neuronos_hw_info_t *
         snprintf(full_path, sizeof(full_path), "%s\\%s", dir_path, fdata.cFileName);
 
         if (fdata.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
-            current_count = scan_dir_recursive(full_path, hw, entries, max_entries, current_count);
+            current_count = scan_dir_recursive(full_path, hw, idx, entries, max_entries, current_count);
         } else if (current_count < max_entries) {
             size_t name_len = strlen(fdata.cFileName);
             if (name_len > 5 && strcmp(fdata.cFileName + name_len - 5, ".gguf") == 0) {
-                neuronos_model_entry_t * e = &entries[current_count];
-                snprintf(e->path, sizeof(e->path), "%s", full_path);
-                extract_model_name(full_path, e->name, sizeof(e->name));
-                e->file_size_mb = file_size_mb(full_path);
-                e->est_ram_mb = estimate_ram_needed(e->file_size_mb);
-                e->quant = detect_quant_type(e->name);
-                e->is_ternary = (e->quant == NEURONOS_QUANT_I2_S || e->quant == NEURONOS_QUANT_TL1);
-                e->n_params_est = estimate_params_from_quant(e->file_size_mb, e->quant);
-                e->fits_in_ram = (e->est_ram_mb <= hw->model_budget_mb);
-                e->score = score_model(e, hw);
+                fill_model_entry(&entries[current_count], full_path, hw, idx);
                 current_count++;
             }
         }
@@ -637,23 +1131,12 @@ static int scan_dir_recursive(const char * dir_path, const neuronos_hw_info_t *
 
         if (S_ISDIR(st.st_mode)) {
             /* Recurse into subdirectory */
-            current_count = scan_dir_recursive(full_path, hw, entries, max_entries, current_count);
+            current_count = scan_dir_recursive(full_path, hw, idx, entries, max_entries, current_count);
         } else if (S_ISREG(st.st_mode)) {
             /* Check for .gguf extension */
             size_t name_len = strlen(ent->d_name);
             if (name_len > 5 && strcmp(ent->d_name + name_len - 5, ".gguf") == 0) {
-                neuronos_model_entry_t * e = &entries[current_count];
-
-                snprintf(e->path, sizeof(e->path), "%s", full_path);
-                extract_model_name(full_path, e->name, sizeof(e->name));
-                e->file_size_mb = file_size_mb(full_path);
-                e->est_ram_mb = estimate_ram_needed(e->file_size_mb);
-                e->quant = detect_quant_type(e->name);
-                e->is_ternary = (e->quant == NEURONOS_QUANT_I2_S || e->quant == NEURONOS_QUANT_TL1);
-                e->n_params_est = estimate_params_from_quant(e->file_size_mb, e->quant);
-                e->fits_in_ram = (e->est_ram_mb <= hw->model_budget_mb);
-                e->score = score_model(e, hw);
-
+                fill_model_entry(&entries[current_count], full_path, hw, idx);
                 current_count++;
             }
         }
@@ -675,16 +1158,14 @@ static int compare_models_desc(const void * a, const void * b) {
     return 0;
 }
 
-neuronos_model_entry_t * neuronos_model_scan(const char * dir_path, const neuronos_hw_info_t * hw, int * out_count) {
-    if (!dir_path || !hw || !out_count)
-        return NULL;
-
+static neuronos_model_entry_t * model_scan_idx(const char * dir_path, const neuronos_hw_info_t * hw,
+                                               model_idx_t * idx, int * out_count) {
     /* Allocate temporary buffer */
     neuronos_model_entry_t * entries = calloc(MAX_SCAN_MODELS, sizeof(neuronos_model_entry_t));
     if (!entries)
         return NULL;
 
-    int count = scan_dir_recursive(dir_path, hw, entries, MAX_SCAN_MODELS, 0);
+    int count = scan_dir_recursive(dir_path, hw, idx, entries, MAX_SCAN_MODELS, 0);
 
     if (count == 0) {
         free(entries);
@@ -699,6 +1180,18 @@ neuronos_model_entry_t * neuronos_model_scan(const char * dir_path, const neuron
     return entries;
 }
 
+neuronos_model_entry_t * neuronos_model_scan(const char * dir_path, const neuronos_hw_info_t * hw, int * out_count) {
+    if (!dir_path || !hw || !out_count)
+        return NULL;
+
+    model_idx_t idx;
+    model_idx_load(&idx);
+    neuronos_model_entry_t * entries = model_scan_idx(dir_path, hw, &idx, out_count);
+    model_idx_save(&idx);
+    model_idx_free(&idx);
+    return entries;
+}
+
 void neuronos_model_scan_free(neuronos_model_entry_t * entries, int count) {
     (void)count;
     free(entries);
@@ -736,13 +1229,46 @@ const neuronos_model_entry_t * neuronos_model_select_best(const neuronos_model_e
  *   - mmap always, mlock when headroom available
  * ============================================================ */
 
+/* Heuristic for a 2B model: each 1K context costs ~75MB at f16.
+ * q8_0 stores 34 bytes per 32 elements, q4_0 stores 18. */
+int neuronos_kv_mb_per_1k(neuronos_kv_type_t kv_type) {
+    switch (kv_type) {
+    case NEURONOS_KV_Q8_0:
+        return 40; /* 75 × 34/64 */
+    case NEURONOS_KV_Q4_0:
+        return 21; /* 75 × 18/64 */
+    default:
+        return 75;
+    }
+}
+
+/* KV cost for this model: exact from its GGUF header when the scanner read
+ * one, else the 2B heuristic above */
+static int model_kv_mb_per_1k(const neuronos_model_entry_t * model, neuronos_kv_type_t kv_type) {
+    if (model->kv_bytes_per_tok <= 0)
+        return neuronos_kv_mb_per_1k(kv_type);
+    int64_t bytes = model->kv_bytes_per_tok * 1024;
+    if (kv_type == NEURONOS_KV_Q8_0)
+        bytes = bytes * 34 / 64;
+    else if (kv_type == NEURONOS_KV_Q4_0)
+        bytes = bytes * 18 / 64;
+    int64_t mb = (bytes + MIB - 1) / MIB;
+    return mb > 0 ? (int)mb : 1;
+}
+
 neuronos_tuned_params_t neuronos_auto_tune(const neuronos_hw_info_t * hw, const neuronos_model_entry_t * model) {
     neuronos_tuned_params_t t = {0};
 
-    /* Threads: physical cores only (HT hurts matmul throughput) */
-    t.n_threads = hw->n_cores_physical;
-    if (t.n_threads <= 0)
-        t.n_threads = 4;
+    /* Prefill threads: physical cores only (HT hurts matmul throughput) */
+    int n_phys = hw->n_cores_physical;
+    if (n_phys <= 0)
+        n_phys = 4;
+    t.n_threads_batch = n_phys;
+
+    /* Decode threads: single-token decode is memory-bandwidth bound and
+     * saturates DRAM long before it runs out of cores; past ~8 threads
+     * the extra barrier sync costs more than it returns. */
+    t.n_threads = n_phys > 8 ? 8 : n_phys;
 
     /* Batch size: scales with available RAM
      * ≤4GB: 512, ≤16GB: 1024, >16GB: 2048 */
@@ -753,25 +1279,48 @@ neuronos_tuned_params_t neuronos_auto_tune(const neuronos_hw_info_t * hw, const
     else
         t.n_batch = 2048;
 
+    /* Micro-batch: compute buffers scale with n_ubatch, not n_batch.
+     * 512 keeps the matmul tiles hot in L2 while bounding scratch RAM;
+     * low-RAM devices drop to 256. */
+    t.n_ubatch = hw->ram_available_mb <= 2048 ? 256 : 512;
+    if (t.n_ubatch > t.n_batch)
+        t.n_ubatch = t.n_batch;
+
+    /* Flash attention: the CPU build always supports it and it avoids
+     * materializing the n_ctx × n_ctx score matrix. WASM linear memory
+     * overflows with it, so keep it off there. */
+#ifdef __EMSCRIPTEN__
+    t.flash_attn = false;
+#else
+    t.flash_attn = true;
+#endif
+
     /* Context size: max tokens we can afford after model is loaded
-     * KV cache ≈ 2 × n_layers × d_model × sizeof(f16) × n_ctx / 1024²
-     * Rough estimate: 1 token ≈ 0.1MB for a 2B model */
+     * KV cache ≈ 2 × n_layers × d_model × bytes_per_elem × n_ctx / 1024² */
     int64_t free_after_model = hw->model_budget_mb - model->est_ram_mb;
     if (free_after_model < 256)
         free_after_model = 256;
 
-    /* Heuristic: each 1K context costs ~75MB for a 2B model */
-    int ctx_capacity = (int)(free_after_model * 1024 / 75);
+    /* KV precision: stay f16 while it affords a 4K context; otherwise
+     * q8_0 (near-lossless), and q4_0 if even q8_0 can't reach 2K.
+     * Quantized V needs flash attention, so without it stay f16. */
+    t.kv_type = NEURONOS_KV_F16;
+    if (t.flash_attn && free_after_model * 1024 / model_kv_mb_per_1k(model, NEURONOS_KV_F16) < 4096) {
+        t.kv_type = NEURONOS_KV_Q8_0;
+        if (free_after_model * 1024 / model_kv_mb_per_1k(model, NEURONOS_KV_Q8_0) < 2048)
+            t.kv_type = NEURONOS_KV_Q4_0;
+    }
+
+    int ctx_capacity = (int)(free_after_model * 1024 / model_kv_mb_per_1k(model, t.kv_type));
     if (ctx_capacity > 8192)
         ctx_capacity = 8192; /* cap at 8K for now */
+    if (model->n_ctx_train > 0 && ctx_capacity > model->n_ctx_train)
+        ctx_capacity = model->n_ctx_train; /* no point past the trained window */
     if (ctx_capacity < 512)
         ctx_capacity = 512;
     /* Round to nearest 512 */
     t.n_ctx = (ctx_capacity / 512) * 512;
 
-    /* Flash attention: enable if we're on a capable build */
-    t.flash_attn = false; /* TODO: detect from llama.cpp build flags */
-
     /* mmap: always true (lazy page loading, reduces RSS) */
     t.use_mmap = true;
 
@@ -802,8 +1351,15 @@ neuronos_tuned_params_t neuronos_auto_tune(const neuronos_hw_info_t * hw, const
          * - Context cache: ~(n_ctx * n_layers * 0.15 MB) for 7B models
          * - Overhead: ~512 MB for buffers, temporaries, driver
          */
+        int n_layers = model->n_layer > 0 ? model->n_layer : 35; /* ~35 for a typical 7B */
         int64_t est_model_vram = model->file_size_mb;
-        int64_t est_context_vram = (t.n_ctx * 35 * 15) / (100 * 1024);  // ~35 layers, 0.15MB/tok/layer
+        int64_t est_context_vram;
+        if (model->kv_bytes_per_tok > 0) {
+            est_context_vram = (int64_t)t.n_ctx * model_kv_mb_per_1k(model, t.kv_type) / 1024;
+        } else {
+            est_context_vram = (t.n_ctx * 35 * 15) / (100 * 1024);  // ~35 layers, 0.15MB/tok/layer (f16)
+            est_context_vram = est_context_vram * neuronos_kv_mb_per_1k(t.kv_type) / neuronos_kv_mb_per_1k(NEURONOS_KV_F16);
+        }
         int64_t est_overhead = 512;
         int64_t total_vram_needed = est_model_vram + est_context_vram + est_overhead;
 
@@ -812,7 +1368,7 @@ neuronos_tuned_params_t neuronos_auto_tune(const neuronos_hw_info_t * hw, const
             t.n_gpu_layers = 999; /* all layers */
         } else if (hw->gpu_vram_mb >= est_model_vram) {
             /* Model fits, but tight on context cache - offload most layers */
-            t.n_gpu_layers = (int)(35 * 0.8);  /* ~28 layers for 7B model */
+            t.n_gpu_layers = (int)(n_layers * 0.8);
         } else {
             /* Partial offload: proportion that fits
              * Conservative estimate to avoid OOM */
@@ -821,8 +1377,8 @@ neuronos_tuned_params_t neuronos_auto_tune(const neuronos_hw_info_t * hw, const
                 /* <30% fit: CPU-only likely faster (avoid PCIe overhead) */
                 t.n_gpu_layers = 0;
             } else {
-                /* Scale layers proportionally, assume ~35 layers for typical 7B model */
-                t.n_gpu_layers = (int)(35 * fit_ratio * 0.9f);  /* 90% safety margin */
+                /* Scale layers proportionally */
+                t.n_gpu_layers = (int)(n_layers * fit_ratio * 0.9f);  /* 90% safety margin */
             }
         }
     } else if (hw->gpu_vram_mb > 0 && is_ternary) {
@@ -842,16 +1398,37 @@ void neuronos_tune_print(const neuronos_tuned_params_t * params) {
     fprintf(stderr, "╔══════════════════════════════════════════╗\n");
     fprintf(stderr, "║  NeuronOS Auto-Tuning                    ║\n");
     fprintf(stderr, "╠══════════════════════════════════════════╣\n");
-    fprintf(stderr, "║  Threads:     %-4d (physical cores only)  ║\n", params->n_threads);
-    fprintf(stderr, "║  Batch size:  %-4d                        ║\n", params->n_batch);
+    fprintf(stderr, "║  Threads:     %-3d decode / %-3d prefill   ║\n", params->n_threads, params->n_threads_batch);
+    fprintf(stderr, "║  Batch size:  %-4d (ubatch %-4d)         ║\n", params->n_batch, params->n_ubatch);
     fprintf(stderr, "║  Context:     %-4d tokens                 ║\n", params->n_ctx);
     fprintf(stderr, "║  Flash attn:  %-3s                         ║\n", params->flash_attn ? "yes" : "no");
+    fprintf(stderr, "║  KV cache:    %-4s                        ║\n",
+            params->kv_type == NEURONOS_KV_Q8_0 ? "q8_0" : params->kv_type == NEURONOS_KV_Q4_0 ? "q4_0" : "f16");
     fprintf(stderr, "║  Memory map:  %-3s                         ║\n", params->use_mmap ? "yes" : "no");
     fprintf(stderr, "║  Memory lock: %-3s                         ║\n", params->use_mlock ? "yes" : "no");
     fprintf(stderr, "║  GPU layers:  %-4d                        ║\n", params->n_gpu_layers);
     fprintf(stderr, "╚══════════════════════════════════════════╝\n");
 }
 
+neuronos_model_params_t neuronos_tuned_model_params(const neuronos_tuned_params_t * params, const char * model_path) {
+    neuronos_model_params_t mp = {0};
+    mp.model_path = model_path;
+    mp.use_mmap = true;
+    if (!params)
+        return mp;
+
+    mp.context_size = params->n_ctx;
+    mp.use_mmap = params->use_mmap;
+    mp.use_mlock = params->use_mlock;
+    mp.n_batch = params->n_batch;
+    mp.n_ubatch = params->n_ubatch;
+    mp.n_threads = params->n_threads;
+    mp.n_threads_batch = params->n_threads_batch;
+    mp.flash_attn = params->flash_attn ? 1 : -1;
+    mp.kv_type = params->kv_type;
+    return mp;
+}
+
 /* ============================================================
  * ZERO-ARG LAUNCHER
  *
@@ -909,14 +1486,17 @@ neuronos_auto_ctx_t neuronos_auto_launch(const char ** extra_model_dirs, bool ve
         search_paths[sp++] = env_models;
     }
 
-    /* Step 3: Scan all paths for models */
+    /* Step 3: Scan all paths for models. One models.idx load/save for the
+     * whole sweep: unchanged files cost a stat(), not a header read. */
     neuronos_model_entry_t * best_overall = NULL;
     neuronos_model_entry_t * all_models = NULL;
     int best_count = 0;
+    model_idx_t idx;
+    model_idx_load(&idx);
 
     for (int i = 0; i < sp; i++) {
         int count = 0;
-        neuronos_model_entry_t * models = neuronos_model_scan(search_paths[i], &ctx.hw, &count);
+        neuronos_model_entry_t * models = model_scan_idx(search_paths[i], &ctx.hw, &idx, &count);
         if (models && count > 0) {
             const neuronos_model_entry_t * best = neuronos_model_select_best(models, count);
             if (best && (!best_overall || best->score > best_overall->score)) {
@@ -931,6 +1511,9 @@ neuronos_auto_ctx_t neuronos_auto_launch(const char ** extra_model_dirs, bool ve
         }
     }
 
+    model_idx_save(&idx);
+    model_idx_free(&idx);
+
     if (!best_overall) {
         ctx.status = NEURONOS_ERROR_MODEL_LOAD;
         if (verbose) {
@@ -964,12 +1547,8 @@ neuronos_auto_ctx_t neuronos_auto_launch(const char ** extra_model_dirs, bool ve
         return ctx;
     }
 
-    /* Step 6: Load model with optimal context */
-    neuronos_model_params_t mparams = {
-        .model_path = best_overall->path,
-        .context_size = ctx.tuning.n_ctx,
-        .use_mmap = ctx.tuning.use_mmap,
-    };
+    /* Step 6: Load model with the full tuned parameter set */
+    neuronos_model_params_t mparams = neuronos_tuned_model_params(&ctx.tuning, best_overall->path);
     ctx.model = neuronos_model_load(ctx.engine, mparams);
     if (!ctx.model) {
         ctx.status = NEURONOS_ERROR_MODEL_LOAD;
@@ -0,0 +1,308 @@
+/**
+ * @file hal_arm_sve.c
+ * @brief NeuronOS HAL — ARM SVE / SVE2 backend with I8MM prefill GEMM
+ *
+ * Vector-length-agnostic I2_S kernels: nothing here assumes a register
+ * width, so the same code uses the full 256-bit datapath on Graviton 3
+ * and the 128-bit one on Graviton 4 / Ampere. Two descriptors:
+ *
+ *   arm_sve       — SDOT vec_dot / gemv; gemm loops over columns
+ *   arm_sve_i8mm  — same vec_dot, gemm on SMMLA 2x2 tiles (prefill)
+ *
+ * Uses the x86 ACT_PARALLEL packing of hal_scalar.c (QK_I2_S = 128,
+ * 32 bytes per block) and returns the same raw u2 × s8 sums. Weight
+ * codes {0,1,2} fit in int8, so the signed SDOT/SMMLA forms are exact.
+ *
+ * Requirements: SVE (SVE2 adds nothing these kernels need);
+ *               I8MM for the arm_sve_i8mm descriptor
+ *
+ * Compile with: -march=armv8.2-a+sve+i8mm (gcc/clang on ARM)
+ */
+
+#if defined(__ARM_FEATURE_SVE)
+
+    #include "neuronos/neuronos_hal.h"
+
+    #include <arm_sve.h>
+    #include <stdint.h>
+    #include <stdlib.h>
+    #include <string.h>
+
+    #define SVE_QK_I2_S 128
+
+extern size_t quantize_i2_s(const float * src, void * dst, int64_t nrow, int64_t n_per_row,
+                            const float * quant_weights);
+
+/* ──────── SDOT kernels ─────────────────────────────────────────── */
+
+    #define SVE_SLICE(B, SHIFT) svreinterpret_s8_u8(svand_n_u8_x(pg, svlsr_n_u8_x(pg, B, SHIFT), 3))
+
+/**
+ * Dot nrows packed rows (row_bytes apart) with one activation vector.
+ * Row r is written to (char *)s + r * bs. Four rows share each
+ * activation load; each 32-byte block slice is covered in svcntb()
+ * chunks, so VL = 128..2048 bits all take the same path.
+ */
+static void sve_dot_rows(int n, float * s, size_t bs, const uint8_t * x, size_t row_bytes, const int8_t * y,
+                         int nrows) {
+    const int nb = n / SVE_QK_I2_S;
+    const int vl = (int)svcntb();
+
+    int row = 0;
+    for (; row + 4 <= nrows; row += 4) {
+        svint32_t acc0 = svdup_n_s32(0);
+        svint32_t acc1 = svdup_n_s32(0);
+        svint32_t acc2 = svdup_n_s32(0);
+        svint32_t acc3 = svdup_n_s32(0);
+        const uint8_t * x0 = x + (size_t)row * row_bytes;
+
+        for (int i = 0; i < nb; i++) {
+            const int8_t * py = y + i * SVE_QK_I2_S;
+            for (int j = 0; j < 32; j += vl) {
+                /* Zeroing loads: inactive lanes contribute nothing */
+                const svbool_t pg = svwhilelt_b8_s32(j, 32);
+                const svint8_t v0 = svld1_s8(pg, py + j);
+                const svint8_t v1 = svld1_s8(pg, py + 32 + j);
+                const svint8_t v2 = svld1_s8(pg, py + 64 + j);
+                const svint8_t v3 = svld1_s8(pg, py + 96 + j);
+
+    #define PROC_ROW(IDX, ACC)                                                                 \
+        {                                                                                      \
+            const svuint8_t b = svld1_u8(pg, x0 + (IDX) * row_bytes + (size_t)i * 32 + j);    \
+            ACC = svdot_s32(ACC, SVE_SLICE(b, 6), v0);                                       \
+            ACC = svdot_s32(ACC, SVE_SLICE(b, 4), v1);                                       \
+            ACC = svdot_s32(ACC, SVE_SLICE(b, 2), v2);                                       \
+            ACC = svdot_s32(ACC, SVE_SLICE(b, 0), v3);                                       \
+        }
+
+                PROC_ROW(0, acc0);
+                PROC_ROW(1, acc1);
+                PROC_ROW(2, acc2);
+                PROC_ROW(3, acc3);
+    #undef PROC_ROW
+            }
+        }
+
+        const svbool_t all = svptrue_b32();
+        *(float *)((char *)s + (row + 0) * bs) = (float)svaddv_s32(all, acc0);
+        *(float *)((char *)s + (row + 1) * bs) = (float)svaddv_s32(all, acc1);
+        *(float *)((char *)s + (row + 2) * bs) = (float)svaddv_s32(all, acc2);
+        *(float *)((char *)s + (row + 3) * bs) = (float)svaddv_s32(all, acc3);
+    }
+
+    /* Remaining rows */
+    for (; row < nrows; row++) {
+        svint32_t acc = svdup_n_s32(0);
+        const uint8_t * xr = x + (size_t)row * row_bytes;
+        for (int i = 0; i < nb; i++) {
+            const int8_t * py = y + i * SVE_QK_I2_S;
+            for (int j = 0; j < 32; j += vl) {
+                const svbool_t pg = svwhilelt_b8_s32(j, 32);
+                const svuint8_t b = svld1_u8(pg, xr + (size_t)i * 32 + j);
+                acc = svdot_s32(acc, SVE_SLICE(b, 6), svld1_s8(pg, py + j));
+                acc = svdot_s32(acc, SVE_SLICE(b, 4), svld1_s8(pg, py + 32 + j));
+                acc = svdot_s32(acc, SVE_SLICE(b, 2), svld1_s8(pg, py + 64 + j));
+                acc = svdot_s32(acc, SVE_SLICE(b, 0), svld1_s8(pg, py + 96 + j));
+            }
+        }
+        *(float *)((char *)s + row * bs) = (float)svaddv_s32(svptrue_b32(), acc);
+    }
+}
+
+/**
+ * SVE vec_dot: same row addressing as the scalar reference
+ * (row stride bx / 4 bytes, results packed in s[0..nrc)).
+ */
+static void sve_vec_dot_i2_i8(int n, float * s, size_t bs, const void * vx, size_t bx, const void * vy, size_t by,
+                              int nrc) {
+    sve_dot_rows(n, s, sizeof(float), (const uint8_t *)vx, bx / 4, (const int8_t *)vy, nrc);
+}
+
+/**
+ * SVE gemv: nr contiguous rows of n/4 bytes, output stride bs.
+ */
+static void sve_gemv_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
+    (void)nc;
+    sve_dot_rows(n, s, bs, (const uint8_t *)vx, (size_t)(n / 4), (const int8_t *)vy, nr);
+}
+
+/**
+ * SVE gemm: one SDOT pass per activation column.
+ */
+static void sve_gemm_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
+    const int8_t * y = (const int8_t *)vy;
+    for (int c = 0; c < nc; c++) {
+        sve_dot_rows(n, (float *)((char *)s + c * bs), sizeof(float), (const uint8_t *)vx, (size_t)(n / 4),
+                     y + (size_t)c * n, nr);
+    }
+}
+
+/* ──────── I8MM (SMMLA) prefill GEMM ─────────────────────────────── */
+
+    #if defined(__ARM_FEATURE_SVE_MATMUL_INT8)
+
+/*
+ * SMMLA multiplies, per 128-bit segment, a 2x8 int8 tile by the
+ * transpose of another 2x8 tile into a 2x2 int32 tile. Operands are
+ * laid out as [row0 k..k+8 | row1 k..k+8] for consecutive k.
+ */
+
+/* Interleave two int8 vectors of length n in 8-byte groups */
+static void interleave8(int8_t * dst, const int8_t * a, const int8_t * b, int n) {
+    for (int g = 0; g < n / 8; g++) {
+        memcpy(dst + g * 16, a + g * 8, 8);
+        memcpy(dst + g * 16 + 8, b + g * 8, 8);
+    }
+}
+
+/* Unpack one I2_S row to int8 codes {0,1,2} in element order */
+static void unpack_row_i2(int8_t * dst, const uint8_t * x, int n) {
+    const int nb = n / SVE_QK_I2_S;
+    const int vl = (int)svcntb();
+    for (int i = 0; i < nb; i++) {
+        int8_t * out = dst + i * SVE_QK_I2_S;
+        for (int j = 0; j < 32; j += vl) {
+            const svbool_t pg = svwhilelt_b8_s32(j, 32);
+            const svuint8_t b = svld1_u8(pg, x + (size_t)i * 32 + j);
+            svst1_s8(pg, out + j, SVE_SLICE(b, 6));
+            svst1_s8(pg, out + 32 + j, SVE_SLICE(b, 4));
+            svst1_s8(pg, out + 64 + j, SVE_SLICE(b, 2));
+            svst1_s8(pg, out + 96 + j, SVE_SLICE(b, 0));
+        }
+    }
+}
+
+/**
+ * I8MM gemm: rows and columns are taken two at a time. Each weight row
+ * pair is unpacked once and reused for every column pair, and the
+ * activation pairs are interleaved once up front, so the inner loop is
+ * nothing but loads and SMMLA. Odd counts pair with a zero vector.
+ */
+static void sve_i8mm_gemm_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
+    if (nc < 2) {
+        sve_gemm_i2_i8(n, s, bs, vx, vy, nr, nc); /* decode: nothing to pair */
+        return;
+    }
+
+    const uint8_t * x = (const uint8_t *)vx;
+    const int8_t * y = (const int8_t *)vy;
+    const size_t row_bytes = (size_t)(n / 4);
+    const int n_cpairs = (nc + 1) / 2;
+
+    int8_t * apack = (int8_t *)malloc((size_t)n_cpairs * 2 * n);
+    int8_t * wpack = (int8_t *)malloc((size_t)2 * n);
+    int8_t * w0 = (int8_t *)malloc((size_t)2 * n);
+    if (!apack || !wpack || !w0) {
+        free(apack);
+        free(wpack);
+        free(w0);
+        sve_gemm_i2_i8(n, s, bs, vx, vy, nr, nc);
+        return;
+    }
+    int8_t * w1 = w0 + n;
+
+    for (int cp = 0; cp < n_cpairs; cp++) {
+        const int8_t * c0 = y + (size_t)(2 * cp) * n;
+        if (2 * cp + 1 < nc) {
+            interleave8(apack + (size_t)cp * 2 * n, c0, c0 + n, n);
+        } else {
+            memset(w1, 0, (size_t)n);
+            interleave8(apack + (size_t)cp * 2 * n, c0, w1, n);
+        }
+    }
+
+    /* Lane m of each 2x2 result tile: 0=(r0,c0) 1=(r0,c1) 2=(r1,c0) 3=(r1,c1) */
+    const svbool_t all32 = svptrue_b32();
+    const svuint32_t lane = svand_n_u32_x(all32, svindex_u32(0, 1), 3);
+    svbool_t tile_lane[4];
+    for (int m = 0; m < 4; m++)
+        tile_lane[m] = svcmpeq_n_u32(all32, lane, (uint32_t)m);
+
+    const int len = 2 * n;
+    const int vl = (int)svcntb();
+
+    for (int r = 0; r < nr; r += 2) {
+        const bool has_r1 = r + 1 < nr;
+        unpack_row_i2(w0, x + (size_t)r * row_bytes, n);
+        if (has_r1)
+            unpack_row_i2(w1, x + (size_t)(r + 1) * row_bytes, n);
+        else
+            memset(w1, 0, (size_t)n);
+        interleave8(wpack, w0, w1, n);
+
+        for (int cp = 0; cp < n_cpairs; cp++) {
+            const int8_t * ap = apack + (size_t)cp * len;
+            svint32_t acc = svdup_n_s32(0);
+            for (int k = 0; k < len; k += vl) {
+                const svbool_t pg = svwhilelt_b8_s32(k, len);
+                acc = svmmla_s32(acc, svld1_s8(pg, wpack + k), svld1_s8(pg, ap + k));
+            }
+
+            const int c = 2 * cp;
+            float * out0 = (float *)((char *)s + c * bs);
+            out0[r] = (float)svaddv_s32(tile_lane[0], acc);
+            if (has_r1)
+                out0[r + 1] = (float)svaddv_s32(tile_lane[2], acc);
+            if (c + 1 < nc) {
+                float * out1 = (float *)((char *)s + (c + 1) * bs);
+                out1[r] = (float)svaddv_s32(tile_lane[1], acc);
+                if (has_r1)
+                    out1[r + 1] = (float)svaddv_s32(tile_lane[3], acc);
+            }
+        }
+    }
+
+    free(apack);
+    free(wpack);
+    free(w0);
+}
+
+    #endif /* __ARM_FEATURE_SVE_MATMUL_INT8 */
+
+    #undef SVE_SLICE
+
+/* ──────── Backend descriptors ──────────────────────────────────── */
+
+const neuronos_backend_t neuronos_backend_arm_sve = {
+    .name = "arm_sve",
+    .type = NEURONOS_BACKEND_ARM_SVE,
+    .priority = 60, /* Above NEON (50): full SVE width, same layout */
+    .required_features = NEURONOS_FEAT_NEON | NEURONOS_FEAT_SVE,
+    .config =
+        {
+            .row_block_size = 4,
+            .col_block_size = 128,
+            .parallel_size = 4,
+            .qk_i2_s = SVE_QK_I2_S,
+        },
+    .vec_dot_i2_i8 = sve_vec_dot_i2_i8,
+    .quantize_i2 = quantize_i2_s,
+    .gemv_i2_i8 = sve_gemv_i2_i8,
+    .gemm_i2_i8 = sve_gemm_i2_i8,
+    .init = NULL,
+    .shutdown = NULL,
+};
+
+    #if defined(__ARM_FEATURE_SVE_MATMUL_INT8)
+const neuronos_backend_t neuronos_backend_arm_sve_i8mm = {
+    .name = "arm_sve_i8mm",
+    .type = NEURONOS_BACKEND_ARM_SVE_I8MM,
+    .priority = 65, /* Above plain SVE: SMMLA doubles prefill MACs per instruction */
+    .required_features = NEURONOS_FEAT_NEON | NEURONOS_FEAT_SVE | NEURONOS_FEAT_I8MM,
+    .config =
+        {
+            .row_block_size = 2, /* SMMLA tile: 2 weight rows × 2 activation columns */
+            .col_block_size = 128,
+            .parallel_size = 2,
+            .qk_i2_s = SVE_QK_I2_S,
+        },
+    .vec_dot_i2_i8 = sve_vec_dot_i2_i8,
+    .quantize_i2 = quantize_i2_s,
+    .gemv_i2_i8 = sve_gemv_i2_i8,
+    .gemm_i2_i8 = sve_i8mm_gemm_i2_i8,
+    .init = NULL,
+    .shutdown = NULL,
+};
+    #endif
+
+#endif /* __ARM_FEATURE_SVE */
@@ -0,0 +1,418 @@
+/**
+ * @file hal_autotune.c
+ * @brief NeuronOS HAL — Runtime kernel autotuner
+ *
+ * gemm-config.h fixes block sizes per ISA at compile time, which is
+ * wrong for most of the CPU SKUs one binary ships to. Instead, the
+ * tunable fields of the active backend's neuronos_kernel_config_t are
+ * micro-benchmarked on the model's own matrix shapes, and the winner
+ * is persisted per (CPU model, backend):
+ *
+ *   ~/.neuronos/hal_tune.conf
+ *     <cpu model> \t <backend name> \t gemm_panel_kb=<KB> [lut=<n>x<nr>,...]
+ *
+ * Decode shapes (one activation column) are also raced against the
+ * portable LUT backend (hal_lut.c); the shapes it wins are listed in
+ * lut= and routed to it by the registry's vec_dot / gemv dispatch.
+ *
+ * neuronos_hal_init() / neuronos_hal_select_backend() re-apply it, so
+ * only the first run on a machine pays for the search. With nothing
+ * persisted, the first neuronos_gemm_i2_i8() call tunes on its own
+ * shape, so processes that never dispatch through the HAL never tune.
+ */
+
+#include "neuronos/neuronos_hal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <direct.h>
+    #include <windows.h>
+    #define hal_mkdir(path) _mkdir(path)
+typedef SRWLOCK tune_mutex_t;
+    #define TUNE_MUTEX_INIT SRWLOCK_INIT
+    #define tune_mutex_lock(m) AcquireSRWLockExclusive(m)
+    #define tune_mutex_unlock(m) ReleaseSRWLockExclusive(m)
+    #define tune_load_acquire(p) InterlockedCompareExchange((volatile LONG *)(p), 0, 0)
+    #define tune_store_release(p, v) InterlockedExchange((volatile LONG *)(p), (v))
+#else
+    #include <pthread.h>
+    #include <sys/stat.h>
+    #include <time.h>
+    #define hal_mkdir(path) mkdir(path, 0755)
+typedef pthread_mutex_t tune_mutex_t;
+    #define TUNE_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+    #define tune_mutex_lock(m) pthread_mutex_lock(m)
+    #define tune_mutex_unlock(m) pthread_mutex_unlock(m)
+    #define tune_load_acquire(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define tune_store_release(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#endif
+
+/* ──────────────────────────── Constants ─────────────────────────── */
+
+#define TUNE_FILE_NAME "hal_tune.conf"
+#define TUNE_MAX_ROWS 4096 /* rows per shape actually timed: panel fit depends on n, not nr */
+#define TUNE_COLS 32       /* prefill columns per timed gemm */
+#define TUNE_REPS 3        /* best-of */
+#define TUNE_MAX_LUT 16    /* decode shapes routed to the LUT backend */
+
+/* Candidate L2 panels: from small Atom/Cortex-A L2 slices to 2 MB server L2 */
+static const int PANEL_KB_CANDIDATES[] = {64, 128, 256, 512, 1024, 2048};
+
+/* True once the active config is tuned (loaded or measured) */
+static bool g_tuned = false;
+
+/* Set once the first dispatched gemm has had its chance to tune;
+ * cleared when the active backend changes */
+static tune_mutex_t g_lazy_lock = TUNE_MUTEX_INIT;
+static long g_lazy_done = 0;
+
+/* Decode shapes where the LUT backend beat the active one */
+static const neuronos_backend_t * g_lut = NULL;
+static neuronos_hal_shape_t g_lut_shapes[TUNE_MAX_LUT];
+static int g_n_lut_shapes = 0;
+
+/* ──────────────────────────── Helpers ───────────────────────────── */
+
+static double tune_time_ms(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart * 1000.0 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+#endif
+}
+
+/* ~/.neuronos/hal_tune.conf; creates ~/.neuronos when mkdir_parent */
+static void tune_file_path(char * buf, size_t len, bool mkdir_parent) {
+    const char * home = getenv("HOME");
+#ifdef _WIN32
+    if (!home)
+        home = getenv("USERPROFILE");
+#endif
+    if (!home)
+        home = "/tmp";
+    snprintf(buf, len, "%s/.neuronos", home);
+    if (mkdir_parent)
+        hal_mkdir(buf);
+    snprintf(buf, len, "%s/.neuronos/" TUNE_FILE_NAME, home);
+}
+
+static bool tune_panel_tunable(const neuronos_backend_t * b) {
+    return b->gemm_i2_i8 && b->config.gemm_panel_kb > 0;
+}
+
+/* Registered LUT backend to race the active one against, or NULL */
+static const neuronos_backend_t * tune_lut_backend(const neuronos_backend_t * active) {
+    if (active->type == NEURONOS_BACKEND_LUT)
+        return NULL;
+    for (int i = 0; i < neuronos_hal_get_backend_count(); i++) {
+        const neuronos_backend_t * b = neuronos_hal_get_backend(i);
+        if (b->type == NEURONOS_BACKEND_LUT && b->gemv_i2_i8)
+            return b;
+    }
+    return NULL;
+}
+
+/* One decode step of shape sh on backend b: gemv, or row-wise vec_dot */
+static void tune_decode(const neuronos_backend_t * b, const neuronos_hal_shape_t * sh, float * out,
+                        const uint8_t * w, const int8_t * a) {
+    if (b->gemv_i2_i8)
+        b->gemv_i2_i8(sh->n, out, sizeof(float), w, a, sh->nr, 1);
+    else
+        b->vec_dot_i2_i8(sh->n, out, sizeof(float), w, (size_t)sh->n, a, (size_t)sh->n, sh->nr);
+}
+
+/* Split "<cpu>\t<backend>\t<fields>" in place; false if malformed */
+static bool tune_parse_line(char * line, char ** cpu, char ** backend, char ** fields) {
+    line[strcspn(line, "\r\n")] = '\0';
+    char * t1 = strchr(line, '\t');
+    char * t2 = t1 ? strchr(t1 + 1, '\t') : NULL;
+    if (!t2)
+        return false;
+    *t1 = *t2 = '\0';
+    *cpu = line;
+    *backend = t1 + 1;
+    *fields = t2 + 1;
+    return true;
+}
+
+/* "lut=2560x2560,2560x6912" -> shapes; returns the count */
+static int tune_parse_lut(const char * fields, neuronos_hal_shape_t * shapes, int max) {
+    const char * p = strstr(fields, "lut=");
+    int count = 0;
+    if (!p)
+        return 0;
+    p += 4;
+    while (count < max) {
+        int n = 0, nr = 0, used = 0;
+        if (sscanf(p, "%dx%d%n", &n, &nr, &used) != 2 || n <= 0 || nr <= 0)
+            break;
+        shapes[count].n = n;
+        shapes[count].nr = nr;
+        count++;
+        p += used;
+        if (*p != ',')
+            break;
+        p++;
+    }
+    return count;
+}
+
+/* Entry for (cpu, backend); panel_kb is 0 when the line has none */
+static bool tune_load(const char * cpu, const char * backend, int * panel_kb, neuronos_hal_shape_t * lut,
+                      int * n_lut) {
+    char path[512];
+    tune_file_path(path, sizeof(path), false);
+    FILE * f = fopen(path, "r");
+    if (!f)
+        return false;
+
+    bool found = false;
+    char line[1024];
+    while (!found && fgets(line, sizeof(line), f)) {
+        char *c, *b, *fields;
+        if (!tune_parse_line(line, &c, &b, &fields) || strcmp(c, cpu) != 0 || strcmp(b, backend) != 0)
+            continue;
+        int kb = 0;
+        if (sscanf(fields, "gemm_panel_kb=%d", &kb) == 1 && kb >= 0) {
+            *panel_kb = kb;
+            *n_lut = tune_parse_lut(fields, lut, TUNE_MAX_LUT);
+            found = true;
+        }
+    }
+    fclose(f);
+    return found;
+}
+
+/* Rewrite the file with this (cpu, backend) entry replaced */
+static bool tune_save(const char * cpu, const char * backend, int panel_kb, const neuronos_hal_shape_t * lut,
+                      int n_lut) {
+    char path[512], tmp[520];
+    tune_file_path(path, sizeof(path), true);
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+
+    FILE * out = fopen(tmp, "w");
+    if (!out)
+        return false;
+
+    FILE * in = fopen(path, "r");
+    if (in) {
+        char line[1024], copy[1024];
+        while (fgets(line, sizeof(line), in)) {
+            char *c, *b, *fields;
+            snprintf(copy, sizeof(copy), "%s", line);
+            if (tune_parse_line(copy, &c, &b, &fields) && strcmp(c, cpu) == 0 && strcmp(b, backend) == 0)
+                continue;
+            fputs(line, out);
+        }
+        fclose(in);
+    }
+    fprintf(out, "%s\t%s\tgemm_panel_kb=%d", cpu, backend, panel_kb);
+    for (int i = 0; i < n_lut; i++)
+        fprintf(out, "%s%dx%d", i == 0 ? " lut=" : ",", lut[i].n, lut[i].nr);
+    fputc('\n', out);
+
+    bool ok = fclose(out) == 0;
+#ifdef _WIN32
+    remove(path); /* rename() does not replace on Windows */
+#endif
+    return ok && rename(tmp, path) == 0;
+}
+
+/* ──────────────────────────── Internal API ──────────────────────── */
+
+/* Called by the registry whenever the active backend changes */
+void hal_tune_apply(void) {
+    const neuronos_backend_t * b = neuronos_hal_get_active_backend();
+    tune_store_release(&g_lazy_done, 0);
+    g_tuned = false;
+    g_lut = NULL;
+    g_n_lut_shapes = 0;
+    if (!b)
+        return;
+    const neuronos_backend_t * lut = tune_lut_backend(b);
+    const bool panel = tune_panel_tunable(b);
+    if (!panel && !lut) {
+        g_tuned = true; /* nothing to tune */
+        return;
+    }
+
+    neuronos_kernel_config_t cfg = b->config;
+    int kb = 0, n_lut = 0;
+    if (!tune_load(neuronos_hal_get_cpu_model(), b->name, &kb, g_lut_shapes, &n_lut))
+        return;
+    if (panel) {
+        cfg.gemm_panel_kb = kb;
+        if (kb <= 0 || neuronos_hal_set_kernel_config(&cfg) != NEURONOS_HAL_OK)
+            return;
+    }
+    g_lut = lut;
+    g_n_lut_shapes = lut ? n_lut : 0;
+    g_tuned = true;
+    printf("[HAL] Applied tuned config for %s: gemm_panel=%d KB, %d LUT shape(s)\n", b->name, cfg.gemm_panel_kb,
+           g_n_lut_shapes);
+}
+
+/* Called by neuronos_gemm_i2_i8() before every dispatch. The first
+ * call tunes on its own shape if nothing was persisted; concurrent
+ * callers wait for it rather than run on a config being changed. */
+void hal_tune_first_gemm(int n, int nr) {
+    if (tune_load_acquire(&g_lazy_done))
+        return;
+    tune_mutex_lock(&g_lazy_lock);
+    if (!g_lazy_done) {
+        if (!g_tuned && n >= 128 && n % 128 == 0 && nr > 0) {
+            neuronos_hal_shape_t shape = {n, nr};
+            neuronos_hal_autotune(&shape, 1);
+        }
+        tune_store_release(&g_lazy_done, 1);
+    }
+    tune_mutex_unlock(&g_lazy_lock);
+}
+
+/* LUT backend if (n, nr) was measured faster on it, else NULL */
+const neuronos_backend_t * hal_tune_lut_backend(int n, int nr) {
+    for (int i = 0; i < g_n_lut_shapes; i++) {
+        if (g_lut_shapes[i].n == n && g_lut_shapes[i].nr == nr)
+            return g_lut;
+    }
+    return NULL;
+}
+
+/* ──────────────────────────── Public API ────────────────────────── */
+
+bool neuronos_hal_config_is_tuned(void) {
+    return g_tuned;
+}
+
+neuronos_hal_status_t neuronos_hal_autotune(const neuronos_hal_shape_t * shapes, int n_shapes) {
+    const neuronos_backend_t * b = neuronos_hal_get_active_backend();
+    if (!b)
+        return NEURONOS_HAL_ERR_NO_BACKEND;
+    if (!shapes || n_shapes <= 0)
+        return NEURONOS_HAL_ERR_INVALID;
+    const neuronos_backend_t * lut = tune_lut_backend(b);
+    const bool panel = tune_panel_tunable(b);
+    if (!panel && !lut) {
+        g_tuned = true;
+        return NEURONOS_HAL_OK;
+    }
+
+    /* Synthetic weights / activations per shape (values don't affect timing) */
+    int n_valid = 0;
+    uint8_t * w[8] = {0};
+    int8_t * a[8] = {0};
+    float * out = NULL;
+    size_t out_len = 0;
+    neuronos_hal_shape_t sh[8];
+    int full_nr[8]; /* untruncated nr: the key dispatch matches on */
+    neuronos_hal_status_t st = NEURONOS_HAL_OK;
+
+    for (int i = 0; i < n_shapes && n_valid < 8; i++) {
+        if (shapes[i].n < 128 || shapes[i].n % 128 != 0 || shapes[i].nr <= 0)
+            continue;
+        neuronos_hal_shape_t s = shapes[i];
+        full_nr[n_valid] = s.nr;
+        if (s.nr > TUNE_MAX_ROWS)
+            s.nr = TUNE_MAX_ROWS;
+        w[n_valid] = (uint8_t *)malloc((size_t)s.nr * (size_t)(s.n / 4));
+        a[n_valid] = (int8_t *)malloc((size_t)TUNE_COLS * (size_t)s.n);
+        if (!w[n_valid] || !a[n_valid]) {
+            st = NEURONOS_HAL_ERR_NOMEM;
+            n_valid++;
+            goto cleanup;
+        }
+        for (size_t k = 0; k < (size_t)s.nr * (size_t)(s.n / 4); k++)
+            w[n_valid][k] = (uint8_t)(0x55 ^ (k * 131)); /* fixed pattern; codes 0..3 */
+        memset(a[n_valid], 1, (size_t)TUNE_COLS * (size_t)s.n);
+        if ((size_t)s.nr * TUNE_COLS > out_len)
+            out_len = (size_t)s.nr * TUNE_COLS;
+        sh[n_valid++] = s;
+    }
+    if (n_valid == 0)
+        return NEURONOS_HAL_ERR_INVALID;
+
+    out = (float *)malloc(out_len * sizeof(float));
+    if (!out) {
+        st = NEURONOS_HAL_ERR_NOMEM;
+        goto cleanup;
+    }
+
+    neuronos_kernel_config_t best = b->config;
+    if (panel) {
+        neuronos_kernel_config_t base = b->config;
+        double best_ms = -1.0;
+        double gops = 0.0;
+        for (int i = 0; i < n_valid; i++)
+            gops += 2.0 * sh[i].n * (double)sh[i].nr * TUNE_COLS / 1e9;
+
+        for (size_t c = 0; c < sizeof(PANEL_KB_CANDIDATES) / sizeof(PANEL_KB_CANDIDATES[0]); c++) {
+            neuronos_kernel_config_t cfg = base;
+            cfg.gemm_panel_kb = PANEL_KB_CANDIDATES[c];
+            neuronos_hal_set_kernel_config(&cfg);
+
+            double ms = -1.0;
+            for (int rep = 0; rep < TUNE_REPS; rep++) {
+                double t0 = tune_time_ms();
+                for (int i = 0; i < n_valid; i++)
+                    b->gemm_i2_i8(sh[i].n, out, (size_t)sh[i].nr * sizeof(float), w[i], a[i], sh[i].nr, TUNE_COLS);
+                double dt = tune_time_ms() - t0;
+                if (ms < 0.0 || dt < ms)
+                    ms = dt;
+            }
+            if (best_ms < 0.0 || ms < best_ms) {
+                best_ms = ms;
+                best = cfg;
+            }
+        }
+
+        neuronos_hal_set_kernel_config(&best);
+        printf("[HAL] Autotune %s: gemm_panel=%d KB (%.1f GOPS)\n", b->name, best.gemm_panel_kb,
+               best_ms > 0.0 ? gops / (best_ms / 1000.0) : 0.0);
+    }
+
+    /* Decode race: best-of gemv per shape, active backend vs LUT */
+    g_lut = lut;
+    g_n_lut_shapes = 0;
+    if (lut) {
+        for (int i = 0; i < n_valid && g_n_lut_shapes < TUNE_MAX_LUT; i++) {
+            double ms[2] = {-1.0, -1.0};
+            const neuronos_backend_t * cand[2] = {b, lut};
+            for (int k = 0; k < 2; k++) {
+                for (int rep = 0; rep < TUNE_REPS; rep++) {
+                    double t0 = tune_time_ms();
+                    tune_decode(cand[k], &sh[i], out, w[i], a[i]);
+                    double dt = tune_time_ms() - t0;
+                    if (ms[k] < 0.0 || dt < ms[k])
+                        ms[k] = dt;
+                }
+            }
+            if (ms[1] < ms[0]) {
+                g_lut_shapes[g_n_lut_shapes].n = sh[i].n;
+                g_lut_shapes[g_n_lut_shapes].nr = full_nr[i];
+                g_n_lut_shapes++;
+            }
+        }
+        printf("[HAL] Autotune %s: LUT kernels for %d/%d decode shapes\n", b->name, g_n_lut_shapes, n_valid);
+    }
+
+    g_tuned = true;
+    if (!tune_save(neuronos_hal_get_cpu_model(), b->name, panel ? best.gemm_panel_kb : 0, g_lut_shapes,
+                   g_n_lut_shapes))
+        printf("[HAL] Warning: could not persist tuning results\n");
+
+cleanup:
+    for (int i = 0; i < n_valid; i++) {
+        free(w[i]);
+        free(a[i]);
+    }
+    free(out);
+    return st;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file hal_lut.c
+ * @brief NeuronOS HAL — Portable table-lookup (TL1-style) backend
+ *
+ * BitNet's TL1/TL2 kernels (src/ggml-bitnet-lut.cpp) need weights
+ * converted offline into a per-shape tiled layout plus code-generated
+ * headers from preset_kernels/<model>/, so one binary serves one model
+ * family. This backend applies the same idea to plain I2_S weights, for
+ * any shape, at runtime:
+ *
+ *   Each nibble of an I2_S byte holds two 2-bit codes (j, j+32) or
+ *   (j+64, j+96) of a block. For one activation vector, a 16-entry
+ *   int16 table per nibble position holds c_hi·y[a] + c_lo·y[b] for all
+ *   code pairs, so a row costs one lookup + add per two weights instead
+ *   of unpack + multiply-add per weight.
+ *
+ * Tables are built once per activation vector in L1-sized chunks of
+ * LUT_CHUNK_BLOCKS blocks and shared by every row, so the build cost is
+ * amortized over nr. Results are the same raw u2 × s8 sums as the
+ * scalar reference (entries <= 2·3·128 fit int16, row sums are int32).
+ *
+ * Needs no ISA extension: it is the default where no SIMD backend
+ * exists, and neuronos_hal_autotune() routes individual decode shapes
+ * to it wherever it measures faster than the active backend.
+ */
+
+#include "neuronos/neuronos_hal.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Portable reference packing (hal_scalar.c): no ggml on LUT-only targets */
+extern const neuronos_backend_t neuronos_backend_scalar;
+
+/* ──────────────────────────── Constants ─────────────────────────── */
+
+#define LUT_QK_I2_S 128
+#define LUT_CHUNK_BLOCKS 16 /* 16 blocks × 64 tables × 16 × int16 = 32 KB */
+#define LUT_TABLES_PER_BLOCK 64
+#define LUT_MIN_ROWS 16 /* below this the table build costs more than it saves */
+
+/* ──────────────────────────── Table build ───────────────────────── */
+
+/*
+ * Tables for one block: t[2j] covers the high nibble of byte j (codes
+ * of elements j, j+32), t[2j+1] the low nibble (elements j+64, j+96).
+ */
+static void lut_build_block(int16_t * t, const int8_t * y) {
+    for (int j = 0; j < 32; j++) {
+        int16_t * th = t + (size_t)(2 * j) * 16;
+        int16_t * tl = th + 16;
+        const int a0 = y[j], a1 = y[j + 32], a2 = y[j + 64], a3 = y[j + 96];
+        for (int h = 0; h < 4; h++) {
+            for (int l = 0; l < 4; l++) {
+                th[h * 4 + l] = (int16_t)(h * a0 + l * a1);
+                tl[h * 4 + l] = (int16_t)(h * a2 + l * a3);
+            }
+        }
+    }
+}
+
+/* ──────────────────────────── Kernels ───────────────────────────── */
+
+/* Direct multiply-add for row counts too small to amortize the tables */
+static void lut_dot_rows_direct(int n, float * s, size_t bs, const uint8_t * x, size_t row_bytes,
+                                const int8_t * y, int nrows) {
+    const int nb = n / LUT_QK_I2_S;
+    for (int r = 0; r < nrows; r++) {
+        const uint8_t * xr = x + (size_t)r * row_bytes;
+        int32_t sum = 0;
+        for (int i = 0; i < nb; i++) {
+            const uint8_t * p = xr + (size_t)i * 32;
+            const int8_t * yb = y + i * LUT_QK_I2_S;
+            for (int j = 0; j < 32; j++) {
+                const uint8_t v = p[j];
+                sum += (v >> 6) * yb[j] + ((v >> 4) & 3) * yb[j + 32] + ((v >> 2) & 3) * yb[j + 64] +
+                       (v & 3) * yb[j + 96];
+            }
+        }
+        *(float *)((char *)s + (size_t)r * bs) = (float)sum;
+    }
+}
+
+/**
+ * Dot nrows packed rows (row_bytes apart) with one activation vector.
+ * Row r is written to (char *)s + r * bs.
+ */
+static void lut_dot_rows(int n, float * s, size_t bs, const uint8_t * x, size_t row_bytes, const int8_t * y,
+                         int nrows) {
+    const int nb = n / LUT_QK_I2_S;
+    if (nrows < LUT_MIN_ROWS || nb == 0) {
+        lut_dot_rows_direct(n, s, bs, x, row_bytes, y, nrows);
+        return;
+    }
+
+    int16_t * tables = (int16_t *)malloc((size_t)LUT_CHUNK_BLOCKS * LUT_TABLES_PER_BLOCK * 16 * sizeof(int16_t));
+    int32_t * acc = (int32_t *)calloc((size_t)nrows, sizeof(int32_t));
+    if (!tables || !acc) {
+        free(tables);
+        free(acc);
+        lut_dot_rows_direct(n, s, bs, x, row_bytes, y, nrows);
+        return;
+    }
+
+    for (int i0 = 0; i0 < nb; i0 += LUT_CHUNK_BLOCKS) {
+        const int i1 = i0 + LUT_CHUNK_BLOCKS < nb ? i0 + LUT_CHUNK_BLOCKS : nb;
+        for (int i = i0; i < i1; i++)
+            lut_build_block(tables + (size_t)(i - i0) * LUT_TABLES_PER_BLOCK * 16, y + i * LUT_QK_I2_S);
+
+        /* Byte k of the chunk indexes tables 2k (high nibble) and 2k+1 (low nibble) */
+        const int nbytes = (i1 - i0) * 32;
+        for (int r = 0; r < nrows; r++) {
+            const uint8_t * xr = x + (size_t)r * row_bytes + (size_t)i0 * 32;
+            const int16_t * t = tables;
+            int32_t sum = 0;
+            for (int k = 0; k < nbytes; k++, t += 32) {
+                const uint8_t v = xr[k];
+                sum += t[v >> 4] + t[16 + (v & 15)];
+            }
+            acc[r] += sum;
+        }
+    }
+
+    for (int r = 0; r < nrows; r++)
+        *(float *)((char *)s + (size_t)r * bs) = (float)acc[r];
+
+    free(tables);
+    free(acc);
+}
+
+/**
+ * LUT vec_dot: same row addressing as the scalar reference
+ * (row stride bx / 4 bytes, results packed in s[0..nrc)).
+ */
+static void lut_vec_dot_i2_i8(int n, float * s, size_t bs, const void * vx, size_t bx, const void * vy, size_t by,
+                              int nrc) {
+    lut_dot_rows(n, s, sizeof(float), (const uint8_t *)vx, bx / 4, (const int8_t *)vy, nrc);
+}
+
+/**
+ * LUT gemv: nr contiguous rows of n/4 bytes, output stride bs.
+ */
+static void lut_gemv_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
+    (void)nc;
+    lut_dot_rows(n, s, bs, (const uint8_t *)vx, (size_t)(n / 4), (const int8_t *)vy, nr);
+}
+
+/**
+ * LUT gemm: one table set and pass per activation column.
+ */
+static void lut_gemm_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
+    const int8_t * y = (const int8_t *)vy;
+    for (int c = 0; c < nc; c++) {
+        lut_dot_rows(n, (float *)((char *)s + c * bs), sizeof(float), (const uint8_t *)vx, (size_t)(n / 4),
+                     y + (size_t)c * n, nr);
+    }
+}
+
+static size_t lut_quantize_i2(const float * src, void * dst, int64_t nrow, int64_t n_per_row,
+                              const float * quant_weights) {
+    return neuronos_backend_scalar.quantize_i2(src, dst, nrow, n_per_row, quant_weights);
+}
+
+/* ──────────────────────────── Backend descriptor ────────────────── */
+
+const neuronos_backend_t neuronos_backend_lut = {
+    .name = "lut",
+    .type = NEURONOS_BACKEND_LUT,
+    .priority = 5, /* Above scalar (0), below every SIMD backend; autotune routes shapes */
+    .required_features = 0,
+    .config =
+        {
+            .row_block_size = LUT_MIN_ROWS, /* keep pool shards large enough for the tables */
+            .col_block_size = LUT_QK_I2_S * LUT_CHUNK_BLOCKS,
+            .parallel_size = 1,
+            .qk_i2_s = LUT_QK_I2_S,
+        },
+    .vec_dot_i2_i8 = lut_vec_dot_i2_i8,
+    .quantize_i2 = lut_quantize_i2,
+    .gemv_i2_i8 = lut_gemv_i2_i8,
+    .gemm_i2_i8 = lut_gemm_i2_i8,
+    .init = NULL,
+    .shutdown = NULL,
+};
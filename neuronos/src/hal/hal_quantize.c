@@ -0,0 +1,179 @@
+/**
+ * @file hal_quantize.c
+ * @brief NeuronOS HAL — row-parallel, streaming I2_S quantization
+ *
+ * A weight's ternary code depends only on its sign and on |w| < 1e-6;
+ * the tensor-wide max-abs scale is stored after the packed data but
+ * never feeds back into the codes. So rows pack independently, in any
+ * order and in any number of pieces: the pool splits each call by rows,
+ * and a converter can stream a tensor through in row chunks, carrying
+ * the running max between calls and writing the scale once at the end.
+ *
+ * Block layout (qk weights → qk/4 bytes, g = qk/4):
+ *   weight j of a block goes to byte j % g, bits 6 - 2 * (j / g)
+ * qk = 128 is the x86 ACT_PARALLEL packing shared by every HAL kernel;
+ * qk = 64 is the ggml-bitnet ARM NEON packing.
+ */
+
+#include "neuronos/neuronos_hal.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define HALQ_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define HALQ_NEON 1
+#endif
+
+/* |x| < 1e-6 (double) is exactly |x| <= 1e-6f: (float)1e-6 rounds down */
+#define HALQ_ZERO_THRESH 1e-6f
+#define HALQ_ROW_GRAIN 4           /* rows per work-stealing unit */
+#define HALQ_MAX_ROWS (1 << 30)    /* pool row counts are int */
+
+/* Internal: thread pool (hal_threadpool.c) */
+extern void hal_pool_parallel_rows(int nr, int grain, size_t work, void (*fn)(void * ctx, int r0, int r1),
+                                   void * ctx);
+
+/* ──────── Codes: 1 if |x| <= thresh, else 2 if x > 0, else 0 (NaN → 0) ──────── */
+
+static inline uint8_t halq_code(float x, float * amax) {
+    const float a = fabsf(x);
+    if (a > *amax) /* false for NaN, like the scalar quantizer's compare */
+        *amax = a;
+    if (a <= HALQ_ZERO_THRESH)
+        return 1;
+    return x > 0.0f ? 2 : 0;
+}
+
+#if defined(HALQ_SSE2)
+/* Codes of 4 floats as int32 lanes, pre-shifted left by shift */
+static inline __m128i halq_codes4(const float * x, int shift, __m128 * amax) {
+    const __m128 v = _mm_loadu_ps(x);
+    const __m128 a = _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+    *amax = _mm_max_ps(a, *amax); /* keeps *amax where a is NaN */
+    const __m128 zero = _mm_cmple_ps(a, _mm_set1_ps(HALQ_ZERO_THRESH));
+    const __m128 pos = _mm_cmpgt_ps(v, _mm_setzero_ps());
+    const __m128i two = _mm_and_si128(_mm_castps_si128(pos), _mm_set1_epi32(2));
+    const __m128i code = _mm_or_si128(_mm_andnot_si128(_mm_castps_si128(zero), two),
+                                      _mm_and_si128(_mm_castps_si128(zero), _mm_set1_epi32(1)));
+    return _mm_sll_epi32(code, _mm_cvtsi32_si128(shift));
+}
+
+/* 16 bytes of a block: weights x[j], x[g + j], x[2g + j], x[3g + j] */
+static inline __m128i halq_pack16(const float * x, int g, __m128 * amax) {
+    __m128i acc = _mm_setzero_si128();
+    for (int k = 0; k < 4; k++) {
+        const float * xk = x + k * g;
+        const int shift = 6 - 2 * k;
+        const __m128i lo = _mm_packs_epi32(halq_codes4(xk, shift, amax), halq_codes4(xk + 4, shift, amax));
+        const __m128i hi = _mm_packs_epi32(halq_codes4(xk + 8, shift, amax), halq_codes4(xk + 12, shift, amax));
+        acc = _mm_or_si128(acc, _mm_packus_epi16(lo, hi));
+    }
+    return acc;
+}
+#elif defined(HALQ_NEON)
+static inline uint32x4_t halq_codes4(const float * x, float32x4_t * amax) {
+    const float32x4_t v = vld1q_f32(x);
+    const float32x4_t a = vabsq_f32(v);
+    *amax = vmaxnmq_f32(*amax, a); /* maxNum: NaN lanes keep *amax */
+    const uint32x4_t zero = vcleq_f32(a, vdupq_n_f32(HALQ_ZERO_THRESH));
+    const uint32x4_t two = vandq_u32(vcgtq_f32(v, vdupq_n_f32(0.0f)), vdupq_n_u32(2));
+    return vbslq_u32(zero, vdupq_n_u32(1), two);
+}
+
+static inline uint8x16_t halq_pack16(const float * x, int g, float32x4_t * amax) {
+    uint8x16_t acc = vdupq_n_u8(0);
+    for (int k = 0; k < 4; k++) {
+        const float * xk = x + k * g;
+        const uint16x8_t lo = vcombine_u16(vmovn_u32(halq_codes4(xk, amax)), vmovn_u32(halq_codes4(xk + 4, amax)));
+        const uint16x8_t hi =
+            vcombine_u16(vmovn_u32(halq_codes4(xk + 8, amax)), vmovn_u32(halq_codes4(xk + 12, amax)));
+        const uint8x16_t c = vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+        acc = vorrq_u8(acc, vshlq_u8(c, vdupq_n_s8((int8_t)(6 - 2 * k))));
+    }
+    return acc;
+}
+#endif
+
+/* Pack one row of n weights (n % qk == 0); returns its max |x| */
+static float halq_row(const float * x, uint8_t * out, int64_t n, int qk) {
+    const int g = qk / 4;
+    float amax = 0.0f;
+    int64_t blk = 0;
+
+#if defined(HALQ_SSE2)
+    __m128 vmax = _mm_setzero_ps();
+    for (; blk + qk <= n; blk += qk) {
+        for (int j = 0; j < g; j += 16)
+            _mm_storeu_si128((__m128i *)(out + blk / 4 + j), halq_pack16(x + blk + j, g, &vmax));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, vmax);
+    for (int i = 0; i < 4; i++)
+        amax = lanes[i] > amax ? lanes[i] : amax;
+#elif defined(HALQ_NEON)
+    float32x4_t vmax = vdupq_n_f32(0.0f);
+    for (; blk + qk <= n; blk += qk) {
+        for (int j = 0; j < g; j += 16)
+            vst1q_u8(out + blk / 4 + j, halq_pack16(x + blk + j, g, &vmax));
+    }
+    amax = vmaxnmvq_f32(vmax);
+#endif
+
+    for (; blk + qk <= n; blk += qk) {
+        uint8_t * ob = out + blk / 4;
+        for (int j = 0; j < g; j++) {
+            const float * xj = x + blk + j;
+            ob[j] = (uint8_t)((halq_code(xj[0], &amax) << 6) | (halq_code(xj[g], &amax) << 4) |
+                              (halq_code(xj[2 * g], &amax) << 2) | halq_code(xj[3 * g], &amax));
+        }
+    }
+    return amax;
+}
+
+typedef struct {
+    const float * src;
+    uint8_t * dst;
+    int64_t n_per_row;
+    int qk;
+    float * row_max; /* one slot per row: workers never share a write */
+} halq_job_t;
+
+static void halq_rows(void * ctx, int r0, int r1) {
+    const halq_job_t * j = (const halq_job_t *)ctx;
+    for (int r = r0; r < r1; r++) {
+        j->row_max[r] = halq_row(j->src + (size_t)r * (size_t)j->n_per_row,
+                                 j->dst + (size_t)r * (size_t)(j->n_per_row / 4), j->n_per_row, j->qk);
+    }
+}
+
+size_t neuronos_quantize_i2_rows(const float * src, void * dst, int64_t nrow, int64_t n_per_row, int qk,
+                                 float * absmax) {
+    if (!src || !dst || !absmax || nrow < 0 || (qk != 64 && qk != 128) || n_per_row <= 0 || n_per_row % qk != 0)
+        return 0;
+
+    const int slice = (int)(nrow < HALQ_MAX_ROWS ? nrow : HALQ_MAX_ROWS);
+    float * row_max = (float *)malloc((size_t)(slice > 0 ? slice : 1) * sizeof(float));
+    if (!row_max)
+        return 0;
+
+    for (int64_t r0 = 0; r0 < nrow; r0 += slice) {
+        const int nr = (int)(nrow - r0 < slice ? nrow - r0 : slice);
+        halq_job_t j = {
+            src + (size_t)r0 * (size_t)n_per_row,
+            (uint8_t *)dst + (size_t)r0 * (size_t)(n_per_row / 4),
+            n_per_row,
+            qk,
+            row_max,
+        };
+        hal_pool_parallel_rows(nr, HALQ_ROW_GRAIN, (size_t)nr * (size_t)n_per_row, halq_rows, &j);
+        for (int r = 0; r < nr; r++)
+            *absmax = row_max[r] > *absmax ? row_max[r] : *absmax;
+    }
+    free(row_max);
+    return (size_t)nrow * (size_t)(n_per_row / 4);
+}
@@ -23,6 +23,7 @@ static struct {
     int count;
     int active_index;     /* -1 = none selected */
     uint32_t hw_features; /* Detected hardware features */
+    char cpu_model[64];   /* Key for persisted tuning results */
     bool initialized;
 } g_hal = {
     .count = 0,
@@ -129,12 +130,34 @@ static uint32_t detect_arm_features(void) {
     return features;
 }
 
+#elif defined(__riscv)
+
+    #ifdef __linux__
+        #include <sys/auxv.h>
+    #endif
+
+static uint32_t detect_riscv_features(void) {
+    uint32_t features = 0;
+
+    #ifdef __linux__
+    /* Single-letter extensions are bits 'A'..'Z' of AT_HWCAP; the kernel
+     * only reports V for RVV 1.0 (not the T-Head 0.7.1 draft) */
+    if (getauxval(AT_HWCAP) & (1UL << ('V' - 'A')))
+        features |= NEURONOS_FEAT_RVV;
+    #elif defined(__riscv_vector)
+    features |= NEURONOS_FEAT_RVV;
+    #endif
+
+    return features;
+}
+
 #else
 
 static uint32_t detect_generic_features(void) {
-    /* RISC-V, WASM, or unknown — just scalar for now */
-    #if defined(__riscv_vector)
-    return NEURONOS_FEAT_RVV;
+    /* WASM features are fixed at compile time: a module built with them
+     * does not validate on an engine that lacks them */
+    #if defined(__wasm_relaxed_simd__)
+    return NEURONOS_FEAT_WASM_SIMD | NEURONOS_FEAT_WASM_RELAXED_SIMD;
     #elif defined(__wasm_simd128__)
     return NEURONOS_FEAT_WASM_SIMD;
     #else
@@ -149,27 +172,135 @@ static uint32_t detect_hardware_features(void) {
     return detect_x86_features();
 #elif defined(__aarch64__) || defined(_M_ARM64)
     return detect_arm_features();
+#elif defined(__riscv)
+    return detect_riscv_features();
 #else
     return detect_generic_features();
 #endif
 }
 
+/* CPU model string: x86 brand string, ARM MIDR_EL1 / Apple brand, else "unknown" */
+static void detect_cpu_model(char * buf, size_t len) {
+    snprintf(buf, len, "unknown");
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    int info[4];
+    cpuid(info, (int)0x80000000);
+    if ((unsigned)info[0] >= 0x80000004u) {
+        char brand[49] = {0};
+        for (int i = 0; i < 3; i++) {
+            cpuid(info, (int)(0x80000002u + (unsigned)i));
+            memcpy(brand + 16 * i, info, 16);
+        }
+        /* Trim the padding Intel parts put around the brand string */
+        char * p = brand;
+        while (*p == ' ')
+            p++;
+        size_t n = strlen(p);
+        while (n > 0 && p[n - 1] == ' ')
+            p[--n] = '\0';
+        if (n > 0)
+            snprintf(buf, len, "%s", p);
+    }
+#elif defined(__APPLE__)
+    size_t n = len;
+    if (sysctlbyname("machdep.cpu.brand_string", buf, &n, NULL, 0) != 0)
+        snprintf(buf, len, "unknown");
+#elif defined(__linux__) && (defined(__aarch64__) || defined(__arm__))
+    FILE * f = fopen("/sys/devices/system/cpu/cpu0/regs/identification/midr_el1", "r");
+    if (f) {
+        char midr[32] = {0};
+        if (fgets(midr, sizeof(midr), f)) {
+            midr[strcspn(midr, "\r\n")] = '\0';
+            snprintf(buf, len, "midr %s", midr);
+        }
+        fclose(f);
+    }
+#endif
+    /* Tabs and newlines delimit the tuning file */
+    for (char * p = buf; *p; p++)
+        if (*p == '\t' || *p == '\n')
+            *p = ' ';
+}
+
 /* ──────────── Built-in backend declarations ────────────────────── */
 
 /* These are defined in the per-ISA source files */
 extern const neuronos_backend_t neuronos_backend_scalar;
+extern const neuronos_backend_t neuronos_backend_lut;
 
 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
 extern const neuronos_backend_t neuronos_backend_x86_avx2;
 extern const neuronos_backend_t neuronos_backend_x86_avxvnni;
+extern const neuronos_backend_t neuronos_backend_x86_avx512;
 #endif
 #if defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
 extern const neuronos_backend_t neuronos_backend_arm_neon;
 #endif
+#ifdef NEURONOS_HAS_SVE
+extern const neuronos_backend_t neuronos_backend_arm_sve;
+extern const neuronos_backend_t neuronos_backend_arm_sve_i8mm;
+#endif
+#ifdef NEURONOS_HAS_RVV
+extern const neuronos_backend_t neuronos_backend_riscv_rvv;
+#endif
+#if defined(__wasm_simd128__)
+extern const neuronos_backend_t neuronos_backend_wasm_simd128;
+#endif
+#if defined(__wasm_relaxed_simd__)
+extern const neuronos_backend_t neuronos_backend_wasm_relaxed_simd;
+#endif
+#ifdef NEURONOS_HAS_VULKAN_COMPUTE
+extern const neuronos_backend_t neuronos_backend_vulkan;
+#endif
+
+/* Persisted tuning results (from hal_autotune.c) */
+extern void hal_tune_apply(void);
+extern void hal_tune_first_gemm(int n, int nr);
+extern const neuronos_backend_t * hal_tune_lut_backend(int n, int nr);
+
+/* Topology and worker pool (from hal_threadpool.c) */
+extern void hal_topology_detect(void);
+extern void hal_pool_shutdown(void);
+extern void hal_pool_parallel_rows(int nr, int grain, size_t work, void (*fn)(void * ctx, int r0, int r1),
+                                   void * ctx);
 
 /* Vulkan GPU detection (from hal_vulkan.c) */
 extern neuronos_hal_status_t neuronos_hal_vulkan_init(void);
 extern void neuronos_hal_vulkan_print_info(void);
+extern void neuronos_hal_vulkan_shutdown(void);
+#ifdef NEURONOS_HAS_VULKAN
+extern bool hal_vulkan_available(void);
+#endif
+
+/* GPU backends take a whole matrix per call instead of pool row shards */
+static bool hal_backend_is_gpu(const neuronos_backend_t * b) {
+    return b->type == NEURONOS_BACKEND_CUDA || b->type == NEURONOS_BACKEND_VULKAN ||
+           b->type == NEURONOS_BACKEND_METAL;
+}
+
+/* Highest-priority feasible backend; CPU backends only when cpu_only */
+static int hal_best_backend_index(bool cpu_only) {
+    int best_index = -1;
+    int best_priority = -1;
+
+    for (int i = 0; i < g_hal.count; i++) {
+        const neuronos_backend_t * b = &g_hal.backends[i];
+
+        /* Check if all required features are available */
+        if ((b->required_features & g_hal.hw_features) != b->required_features) {
+            continue;
+        }
+        if (cpu_only && hal_backend_is_gpu(b)) {
+            continue;
+        }
+
+        if (b->priority > best_priority) {
+            best_priority = b->priority;
+            best_index = i;
+        }
+    }
+    return best_index;
+}
 
 
 /* ──────────────────────────── HAL API implementation ────────────── */
@@ -182,43 +313,51 @@ neuronos_hal_status_t neuronos_hal_init(void) {
     g_hal.count = 0;
     g_hal.active_index = -1;
     g_hal.hw_features = detect_hardware_features();
+    detect_cpu_model(g_hal.cpu_model, sizeof(g_hal.cpu_model));
+    hal_topology_detect();
     printf("[HAL] Detected features: 0x%08X\n", g_hal.hw_features);
 
     /* Register built-in backends */
     printf("[HAL] Registering backends...\n");
     neuronos_hal_register_backend(&neuronos_backend_scalar);
+    neuronos_hal_register_backend(&neuronos_backend_lut);
 
 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
     neuronos_hal_register_backend(&neuronos_backend_x86_avx2);
     neuronos_hal_register_backend(&neuronos_backend_x86_avxvnni);
+    neuronos_hal_register_backend(&neuronos_backend_x86_avx512);
 #endif
 
 #if defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
     neuronos_hal_register_backend(&neuronos_backend_arm_neon);
 #endif
+#ifdef NEURONOS_HAS_SVE
+    neuronos_hal_register_backend(&neuronos_backend_arm_sve);
+    neuronos_hal_register_backend(&neuronos_backend_arm_sve_i8mm);
+#endif
+#ifdef NEURONOS_HAS_RVV
+    neuronos_hal_register_backend(&neuronos_backend_riscv_rvv);
+#endif
+#if defined(__wasm_simd128__)
+    neuronos_hal_register_backend(&neuronos_backend_wasm_simd128);
+#endif
+#if defined(__wasm_relaxed_simd__)
+    neuronos_hal_register_backend(&neuronos_backend_wasm_relaxed_simd);
+#endif
+
+#ifdef NEURONOS_HAS_VULKAN_COMPUTE
+    neuronos_hal_register_backend(&neuronos_backend_vulkan);
+#endif
 
     /* Initialize Vulkan GPU detection (independent of CPU backends) */
 #ifdef NEURONOS_HAS_VULKAN
     neuronos_hal_vulkan_init();
+    if (hal_vulkan_available())
+        g_hal.hw_features |= NEURONOS_FEAT_VULKAN;
 #endif
 
     /* Select best backend: highest priority that satisfies feature requirements */
-    int best_index = -1;
-    int best_priority = -1;
-
-    for (int i = 0; i < g_hal.count; i++) {
-        const neuronos_backend_t * b = &g_hal.backends[i];
-
-        /* Check if all required features are available */
-        if ((b->required_features & g_hal.hw_features) != b->required_features) {
-            continue;
-        }
-
-        if (b->priority > best_priority) {
-            best_priority = b->priority;
-            best_index = i;
-        }
-    }
+    int best_index = hal_best_backend_index(false);
 
     if (best_index < 0) {
         printf("[HAL] Error: No suitable backend found (features 0x%X)\n", g_hal.hw_features);
@@ -239,15 +378,18 @@ neuronos_hal_status_t neuronos_hal_init(void) {
     }
 
     g_hal.initialized = true;
+    hal_tune_apply();
     return NEURONOS_HAL_OK;
 }
 
 void neuronos_hal_shutdown(void) {
+    hal_pool_shutdown();
     for (int i = 0; i < g_hal.count; i++) {
         if (g_hal.backends[i].shutdown) {
             g_hal.backends[i].shutdown();
         }
     }
+    neuronos_hal_vulkan_shutdown();
     g_hal.count = 0;
     g_hal.active_index = -1;
     g_hal.hw_features = 0;
@@ -301,12 +443,28 @@ neuronos_hal_status_t neuronos_hal_select_backend(neuronos_backend_type_t type)
             }
 
             g_hal.active_index = i;
+            hal_tune_apply();
             return NEURONOS_HAL_OK;
         }
     }
     return NEURONOS_HAL_ERR_NO_BACKEND;
 }
 
+neuronos_hal_status_t neuronos_hal_select_cpu_backend(void) {
+    int i = hal_best_backend_index(true);
+    if (i < 0)
+        return NEURONOS_HAL_ERR_NO_BACKEND;
+    if (i == g_hal.active_index)
+        return NEURONOS_HAL_OK;
+    return neuronos_hal_select_backend(g_hal.backends[i].type);
+}
+
+/* Internal: CPU backend the GPU backends fall back to (used by hal_vulkan_i2s.c) */
+const neuronos_backend_t * hal_best_cpu_backend(void) {
+    int i = hal_best_backend_index(true);
+    return i < 0 ? NULL : &g_hal.backends[i];
+}
+
 int neuronos_hal_get_backend_count(void) {
     return g_hal.count;
 }
@@ -317,13 +475,84 @@ const neuronos_backend_t * neuronos_hal_get_backend(int index) {
     return &g_hal.backends[index];
 }
 
+const neuronos_backend_t * neuronos_hal_get_backend_for_shape(int n, int nr) {
+    const neuronos_backend_t * b = neuronos_hal_get_active_backend();
+    if (!b)
+        return NULL;
+    const neuronos_backend_t * lut = hal_tune_lut_backend(n, nr);
+    return lut ? lut : b;
+}
+
 /* ──────────── Dispatch functions (hot path) ─────────────────────── */
 
+/* Arguments of one dispatched kernel; workers get row ranges of it */
+typedef struct {
+    const neuronos_backend_t * b;
+    int n;
+    float * s;
+    size_t bs;
+    const uint8_t * x;
+    size_t bx;
+    size_t row_bytes; /* packed bytes between weight rows */
+    const void * vy;
+    size_t by;
+    int nc;
+} hal_rows_job_t;
+
+static void vec_dot_rows(void * ctx, int r0, int r1) {
+    const hal_rows_job_t * j = (const hal_rows_job_t *)ctx;
+    j->b->vec_dot_i2_i8(j->n, j->s + r0, j->bs, j->x + (size_t)r0 * j->row_bytes, j->bx, j->vy, j->by, r1 - r0);
+}
+
+static void gemv_rows(void * ctx, int r0, int r1) {
+    const hal_rows_job_t * j = (const hal_rows_job_t *)ctx;
+    j->b->gemv_i2_i8(j->n, j->s + r0, j->bs, j->x + (size_t)r0 * j->row_bytes, j->vy, r1 - r0, j->nc);
+}
+
+/* Row r of column c lives at ((char *)s + c * bs)[r]: offsetting s by r0 keeps bs */
+static void gemm_rows(void * ctx, int r0, int r1) {
+    const hal_rows_job_t * j = (const hal_rows_job_t *)ctx;
+    j->b->gemm_i2_i8(j->n, j->s + r0, j->bs, j->x + (size_t)r0 * j->row_bytes, j->vy, r1 - r0, j->nc);
+}
+
+/* Internal: run one kernel on backend b, over the pool unless b is a GPU backend.
+ * Also the CPU fallback path of the GPU backends. */
+void hal_run_vec_dot(const neuronos_backend_t * b, int n, float * s, size_t bs, const void * vx, size_t bx,
+                     const void * vy, size_t by, int nrc) {
+    if (hal_backend_is_gpu(b)) {
+        b->vec_dot_i2_i8(n, s, bs, vx, bx, vy, by, nrc);
+        return;
+    }
+    hal_rows_job_t j = {b, n, s, bs, (const uint8_t *)vx, bx, bx / 4, vy, by, 1};
+    hal_pool_parallel_rows(nrc, b->config.row_block_size, (size_t)n * (size_t)nrc, vec_dot_rows, &j);
+}
+
+void hal_run_gemv(const neuronos_backend_t * b, int n, float * s, size_t bs, const void * vx, const void * vy, int nr,
+                  int nc) {
+    if (hal_backend_is_gpu(b)) {
+        b->gemv_i2_i8(n, s, bs, vx, vy, nr, nc);
+        return;
+    }
+    hal_rows_job_t j = {b, n, s, bs, (const uint8_t *)vx, 0, (size_t)(n / 4), vy, 0, nc};
+    hal_pool_parallel_rows(nr, b->config.row_block_size, (size_t)n * (size_t)nr, gemv_rows, &j);
+}
+
+void hal_run_gemm(const neuronos_backend_t * b, int n, float * s, size_t bs, const void * vx, const void * vy, int nr,
+                  int nc) {
+    if (hal_backend_is_gpu(b)) {
+        b->gemm_i2_i8(n, s, bs, vx, vy, nr, nc);
+        return;
+    }
+    hal_rows_job_t j = {b, n, s, bs, (const uint8_t *)vx, 0, (size_t)(n / 4), vy, 0, nc};
+    hal_pool_parallel_rows(nr, b->config.row_block_size, (size_t)n * (size_t)nr * (size_t)(nc > 0 ? nc : 1),
+                           gemm_rows, &j);
+}
+
 void neuronos_vec_dot_i2_i8(int n, float * s, size_t bs, const void * vx, size_t bx, const void * vy, size_t by,
                             int nrc) {
-    const neuronos_backend_t * b = neuronos_hal_get_active_backend();
+    const neuronos_backend_t * b = neuronos_hal_get_backend_for_shape(n, nrc);
     if (b && b->vec_dot_i2_i8) {
-        b->vec_dot_i2_i8(n, s, bs, vx, bx, vy, by, nrc);
+        hal_run_vec_dot(b, n, s, bs, vx, bx, vy, by, nrc);
     }
 }
 
@@ -337,16 +566,17 @@ size_t neuronos_quantize_i2(const float * src, void * dst, int64_t nrow, int64_t
 }
 
 void neuronos_gemv_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
-    const neuronos_backend_t * b = neuronos_hal_get_active_backend();
+    const neuronos_backend_t * b = neuronos_hal_get_backend_for_shape(n, nr);
     if (b && b->gemv_i2_i8) {
-        b->gemv_i2_i8(n, s, bs, vx, vy, nr, nc);
+        hal_run_gemv(b, n, s, bs, vx, vy, nr, nc);
     }
 }
 
 void neuronos_gemm_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
+    hal_tune_first_gemm(n, nr);
     const neuronos_backend_t * b = neuronos_hal_get_active_backend();
     if (b && b->gemm_i2_i8) {
-        b->gemm_i2_i8(n, s, bs, vx, vy, nr, nc);
+        hal_run_gemm(b, n, s, bs, vx, vy, nr, nc);
     }
 }
 
@@ -357,6 +587,21 @@ const neuronos_kernel_config_t * neuronos_hal_get_kernel_config(void) {
     return &b->config;
 }
 
+neuronos_hal_status_t neuronos_hal_set_kernel_config(const neuronos_kernel_config_t * config) {
+    if (g_hal.active_index < 0)
+        return NEURONOS_HAL_ERR_NO_BACKEND;
+    neuronos_backend_t * b = &g_hal.backends[g_hal.active_index];
+    if (!config || config->qk_i2_s != b->config.qk_i2_s || config->row_block_size <= 0 ||
+        config->col_block_size <= 0 || config->parallel_size <= 0 || config->gemm_panel_kb < 0)
+        return NEURONOS_HAL_ERR_INVALID;
+    b->config = *config;
+    return NEURONOS_HAL_OK;
+}
+
+const char * neuronos_hal_get_cpu_model(void) {
+    return g_hal.cpu_model[0] ? g_hal.cpu_model : "unknown";
+}
+
 /* ──────────── Diagnostic output ────────────────────────────────── */
 
 void neuronos_hal_print_info(void) {
@@ -382,6 +627,12 @@ void neuronos_hal_print_info(void) {
                                  "D (MCU/Bare-metal)"};
     printf("Device tier: %s\n", tier_names[tier]);
 
+    printf("CPU model: %s\n", neuronos_hal_get_cpu_model());
+    const neuronos_hal_topology_t * topo = neuronos_hal_get_topology();
+    printf("Topology: %d CPUs, %d cores, %d NUMA node(s)", topo->n_cpus, topo->n_cores, topo->n_nodes);
+    if (topo->n_little > 0)
+        printf(", %d big + %d little", topo->n_big, topo->n_little);
+    printf("  (HAL threads: %d)\n", neuronos_hal_get_n_threads());
     printf("Hardware features:");
     if (f & NEURONOS_FEAT_SSE3)
         printf(" SSE3");
@@ -413,6 +664,10 @@ void neuronos_hal_print_info(void) {
         printf(" RVV");
     if (f & NEURONOS_FEAT_WASM_SIMD)
         printf(" WASM-SIMD");
+    if (f & NEURONOS_FEAT_WASM_RELAXED_SIMD)
+        printf(" WASM-RELAXED-SIMD");
+    if (f & NEURONOS_FEAT_VULKAN)
+        printf(" VULKAN");
     if (f == 0)
         printf(" (none)");
     printf("\n");
@@ -431,6 +686,9 @@ void neuronos_hal_print_info(void) {
         printf("Active backend: %s\n", active->name);
         printf("  row_block=%d  col_block=%d  parallel=%d  qk=%d\n", active->config.row_block_size,
                active->config.col_block_size, active->config.parallel_size, active->config.qk_i2_s);
+        if (active->config.gemm_panel_kb > 0)
+            printf("  gemm_panel=%d KB (%s)\n", active->config.gemm_panel_kb,
+                   neuronos_hal_config_is_tuned() ? "tuned" : "default");
     } else {
         printf("Active backend: NONE\n");
     }
@@ -0,0 +1,239 @@
+/**
+ * @file hal_riscv_rvv.c
+ * @brief NeuronOS HAL — RISC-V Vector (RVV 1.0) backend
+ *
+ * Vector-length-agnostic I2_S kernels for RVV 1.0 cores (SpacemiT K1/M1,
+ * SiFive X280/P670, Tenstorrent Ascalon). VLEN is read at runtime with
+ * vsetvl, so one binary covers VLEN = 128 (two chunks per 32-byte block
+ * slice) and VLEN >= 256 (one chunk per slice).
+ *
+ * Same ACT_PARALLEL packing and raw u2 × s8 sums as hal_scalar.c. RVV
+ * has no 4-way int8 dot product, so weight codes are unpacked with
+ * vsrl/vand and accumulated with widening vwmacc into int16 lanes,
+ * which are folded into an int32 reduction every RVV_FLUSH_BLOCKS
+ * blocks (worst case 8 × 4 × 2 × 3 × 128 < INT16_MAX).
+ *
+ * Requirements: V extension (RVV 1.0). T-Head C906/C910/C920 implement
+ *               the incompatible 0.7.1 draft and stay on the scalar backend.
+ *
+ * Compile with: -march=rv64gcv (gcc >= 14 / clang >= 17 intrinsics)
+ */
+
+#if defined(__riscv_vector)
+
+    #include "neuronos/neuronos_hal.h"
+
+    #include <riscv_vector.h>
+    #include <stdint.h>
+    #include <stdio.h>
+    #include <string.h>
+
+    #define RVV_QK_I2_S 128
+    #define RVV_FLUSH_BLOCKS 8
+
+/* |x| < 1e-6 (double) is exactly |x| <= 1e-6f: (float)1e-6 rounds down */
+    #define RVV_ZERO_THRESH 1e-6f
+
+/* ──────── vec_dot kernels ──────────────────────────────────────── */
+
+    #define RVV_SLICE(B, SHIFT) __riscv_vreinterpret_v_u8m1_i8m1(__riscv_vand_vx_u8m1(__riscv_vsrl_vx_u8m1(B, SHIFT, vl), 3, vl))
+
+/**
+ * Dot nrows packed rows (row_bytes apart) with one activation vector.
+ * Row r is written to (char *)s + r * bs. Four rows share each
+ * activation load. vl is fixed for the whole call, so the int16
+ * accumulators never see a tail lane.
+ */
+static void rvv_dot_rows(int n, float * s, size_t bs, const uint8_t * x, size_t row_bytes, const int8_t * y,
+                         int nrows) {
+    const int nb = n / RVV_QK_I2_S;
+    const size_t vl = __riscv_vsetvl_e8m1(32);
+
+    int row = 0;
+    for (; row + 4 <= nrows; row += 4) {
+        vint32m1_t sum0 = __riscv_vmv_s_x_i32m1(0, 1);
+        vint32m1_t sum1 = sum0, sum2 = sum0, sum3 = sum0;
+        const uint8_t * x0 = x + (size_t)row * row_bytes;
+
+        for (int i0 = 0; i0 < nb; i0 += RVV_FLUSH_BLOCKS) {
+            const int i1 = i0 + RVV_FLUSH_BLOCKS < nb ? i0 + RVV_FLUSH_BLOCKS : nb;
+            vint16m2_t acc0 = __riscv_vmv_v_x_i16m2(0, vl);
+            vint16m2_t acc1 = acc0, acc2 = acc0, acc3 = acc0;
+
+            for (int i = i0; i < i1; i++) {
+                const int8_t * py = y + i * RVV_QK_I2_S;
+                for (size_t j = 0; j < 32; j += vl) {
+                    const vint8m1_t v0 = __riscv_vle8_v_i8m1(py + j, vl);
+                    const vint8m1_t v1 = __riscv_vle8_v_i8m1(py + 32 + j, vl);
+                    const vint8m1_t v2 = __riscv_vle8_v_i8m1(py + 64 + j, vl);
+                    const vint8m1_t v3 = __riscv_vle8_v_i8m1(py + 96 + j, vl);
+
+    #define PROC_ROW(IDX, ACC)                                                                         \
+        {                                                                                              \
+            const vuint8m1_t b = __riscv_vle8_v_u8m1(x0 + (IDX) * row_bytes + (size_t)i * 32 + j, vl); \
+            ACC = __riscv_vwmacc_vv_i16m2(ACC, RVV_SLICE(b, 6), v0, vl);                               \
+            ACC = __riscv_vwmacc_vv_i16m2(ACC, RVV_SLICE(b, 4), v1, vl);                               \
+            ACC = __riscv_vwmacc_vv_i16m2(ACC, RVV_SLICE(b, 2), v2, vl);                               \
+            ACC = __riscv_vwmacc_vv_i16m2(ACC, RVV_SLICE(b, 0), v3, vl);                               \
+        }
+
+                    PROC_ROW(0, acc0);
+                    PROC_ROW(1, acc1);
+                    PROC_ROW(2, acc2);
+                    PROC_ROW(3, acc3);
+    #undef PROC_ROW
+                }
+            }
+
+            sum0 = __riscv_vwredsum_vs_i16m2_i32m1(acc0, sum0, vl);
+            sum1 = __riscv_vwredsum_vs_i16m2_i32m1(acc1, sum1, vl);
+            sum2 = __riscv_vwredsum_vs_i16m2_i32m1(acc2, sum2, vl);
+            sum3 = __riscv_vwredsum_vs_i16m2_i32m1(acc3, sum3, vl);
+        }
+
+        *(float *)((char *)s + (row + 0) * bs) = (float)__riscv_vmv_x_s_i32m1_i32(sum0);
+        *(float *)((char *)s + (row + 1) * bs) = (float)__riscv_vmv_x_s_i32m1_i32(sum1);
+        *(float *)((char *)s + (row + 2) * bs) = (float)__riscv_vmv_x_s_i32m1_i32(sum2);
+        *(float *)((char *)s + (row + 3) * bs) = (float)__riscv_vmv_x_s_i32m1_i32(sum3);
+    }
+
+    /* Remaining rows */
+    for (; row < nrows; row++) {
+        vint32m1_t sum = __riscv_vmv_s_x_i32m1(0, 1);
+        const uint8_t * xr = x + (size_t)row * row_bytes;
+        for (int i0 = 0; i0 < nb; i0 += RVV_FLUSH_BLOCKS) {
+            const int i1 = i0 + RVV_FLUSH_BLOCKS < nb ? i0 + RVV_FLUSH_BLOCKS : nb;
+            vint16m2_t acc = __riscv_vmv_v_x_i16m2(0, vl);
+            for (int i = i0; i < i1; i++) {
+                const int8_t * py = y + i * RVV_QK_I2_S;
+                for (size_t j = 0; j < 32; j += vl) {
+                    const vuint8m1_t b = __riscv_vle8_v_u8m1(xr + (size_t)i * 32 + j, vl);
+                    acc = __riscv_vwmacc_vv_i16m2(acc, RVV_SLICE(b, 6), __riscv_vle8_v_i8m1(py + j, vl), vl);
+                    acc = __riscv_vwmacc_vv_i16m2(acc, RVV_SLICE(b, 4), __riscv_vle8_v_i8m1(py + 32 + j, vl), vl);
+                    acc = __riscv_vwmacc_vv_i16m2(acc, RVV_SLICE(b, 2), __riscv_vle8_v_i8m1(py + 64 + j, vl), vl);
+                    acc = __riscv_vwmacc_vv_i16m2(acc, RVV_SLICE(b, 0), __riscv_vle8_v_i8m1(py + 96 + j, vl), vl);
+                }
+            }
+            sum = __riscv_vwredsum_vs_i16m2_i32m1(acc, sum, vl);
+        }
+        *(float *)((char *)s + row * bs) = (float)__riscv_vmv_x_s_i32m1_i32(sum);
+    }
+}
+
+    #undef RVV_SLICE
+
+/**
+ * RVV vec_dot: same row addressing as the scalar reference
+ * (row stride bx / 4 bytes, results packed in s[0..nrc)).
+ */
+static void rvv_vec_dot_i2_i8(int n, float * s, size_t bs, const void * vx, size_t bx, const void * vy, size_t by,
+                              int nrc) {
+    rvv_dot_rows(n, s, sizeof(float), (const uint8_t *)vx, bx / 4, (const int8_t *)vy, nrc);
+}
+
+/**
+ * RVV gemv: nr contiguous rows of n/4 bytes, output stride bs.
+ */
+static void rvv_gemv_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
+    (void)nc;
+    rvv_dot_rows(n, s, bs, (const uint8_t *)vx, (size_t)(n / 4), (const int8_t *)vy, nr);
+}
+
+/**
+ * RVV gemm: one vec_dot pass per activation column.
+ */
+static void rvv_gemm_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
+    const int8_t * y = (const int8_t *)vy;
+    for (int c = 0; c < nc; c++) {
+        rvv_dot_rows(n, (float *)((char *)s + c * bs), sizeof(float), (const uint8_t *)vx, (size_t)(n / 4),
+                     y + (size_t)c * n, nr);
+    }
+}
+
+/* ──────── quantize: f32 → I2_S packed ternary ──────────────────── */
+
+/* Codes of vl floats: 1 if |x| < 1e-6, else 2 if x > 0, else 0 (NaN → 0) */
+static inline vuint8m2_t rvv_ternary_codes(const float * x, size_t vl) {
+    const vfloat32m8_t v = __riscv_vle32_v_f32m8(x, vl);
+    const vbool4_t pos = __riscv_vmfgt_vf_f32m8_b4(v, 0.0f, vl);
+    const vbool4_t zero = __riscv_vmfle_vf_f32m8_b4(__riscv_vfabs_v_f32m8(v, vl), RVV_ZERO_THRESH, vl);
+    vuint8m2_t c = __riscv_vmv_v_x_u8m2(0, vl);
+    c = __riscv_vmerge_vxm_u8m2(c, 2, pos, vl);
+    return __riscv_vmerge_vxm_u8m2(c, 1, zero, vl);
+}
+
+/**
+ * Bit-identical to scalar_quantize_i2(): one max-abs scale for the
+ * whole tensor, codes packed straight into the output (no n-byte
+ * scratch buffer). e32m8 and e8m2 have the same VLMAX, so one vl
+ * covers both the float compare and the byte pack.
+ */
+static size_t rvv_quantize_i2(const float * src, void * dst, int64_t nrow, int64_t n_per_row,
+                              const float * quant_weights) {
+    (void)quant_weights; /* Not used in ternary quantization */
+
+    const int64_t n = nrow * n_per_row;
+
+    /* Step 1: max |x| (vfredmax ignores NaN like the scalar compare) */
+    vfloat32m1_t vmax = __riscv_vfmv_s_f_f32m1(0.0f, 1);
+    for (int64_t i = 0; i < n;) {
+        const size_t vl = __riscv_vsetvl_e32m8((size_t)(n - i));
+        const vfloat32m8_t v = __riscv_vle32_v_f32m8(src + i, vl);
+        vmax = __riscv_vfredmax_vs_f32m8_f32m1(__riscv_vfabs_v_f32m8(v, vl), vmax, vl);
+        i += (int64_t)vl;
+    }
+    const float i2_scale = __riscv_vfmv_f_s_f32m1_f32(vmax);
+
+    /* Step 2+3: element j of a block goes to byte j % 32, bits 6 - 2 * (j / 32) */
+    uint8_t * out = (uint8_t *)dst;
+    memset(out, 0, (size_t)(n / 4));
+
+    const int64_t num_blocks = n / RVV_QK_I2_S;
+    for (int64_t blk = 0; blk < num_blocks; blk++) {
+        const float * xb = src + blk * RVV_QK_I2_S;
+        for (size_t j = 0; j < 32;) {
+            const size_t vl = __riscv_vsetvl_e8m2(32 - j);
+            vuint8m2_t q = __riscv_vsll_vx_u8m2(rvv_ternary_codes(xb + j, vl), 6, vl);
+            q = __riscv_vor_vv_u8m2(q, __riscv_vsll_vx_u8m2(rvv_ternary_codes(xb + 32 + j, vl), 4, vl), vl);
+            q = __riscv_vor_vv_u8m2(q, __riscv_vsll_vx_u8m2(rvv_ternary_codes(xb + 64 + j, vl), 2, vl), vl);
+            q = __riscv_vor_vv_u8m2(q, rvv_ternary_codes(xb + 96 + j, vl), vl);
+            __riscv_vse8_v_u8m2(out + blk * 32 + j, q, vl);
+            j += vl;
+        }
+    }
+
+    /* Step 4: Store scale after packed data */
+    float * scale_ptr = (float *)((char *)out + n / 4);
+    scale_ptr[0] = i2_scale;
+
+    return (size_t)(n / 4 + 32);
+}
+
+static neuronos_hal_status_t rvv_init(void) {
+    printf("[HAL] RVV VLEN=%d bits\n", (int)(__riscv_vlenb() * 8));
+    return NEURONOS_HAL_OK;
+}
+
+/* ──────── Backend descriptor ───────────────────────────────────── */
+
+const neuronos_backend_t neuronos_backend_riscv_rvv = {
+    .name = "riscv_rvv",
+    .type = NEURONOS_BACKEND_RISCV_RVV,
+    .priority = 40, /* Only vector backend on RISC-V; scalar is 0 */
+    .required_features = NEURONOS_FEAT_RVV,
+    .config =
+        {
+            .row_block_size = 4,
+            .col_block_size = 128,
+            .parallel_size = 4,
+            .qk_i2_s = RVV_QK_I2_S,
+        },
+    .vec_dot_i2_i8 = rvv_vec_dot_i2_i8,
+    .quantize_i2 = rvv_quantize_i2,
+    .gemv_i2_i8 = rvv_gemv_i2_i8,
+    .gemm_i2_i8 = rvv_gemm_i2_i8,
+    .init = rvv_init,
+    .shutdown = NULL,
+};
+
+#endif /* __riscv_vector */
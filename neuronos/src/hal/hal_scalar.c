@@ -222,11 +222,15 @@ static void scalar_gemv_i2_i8(int n, float * s, size_t bs, const void * vx, cons
 /**
  * Scalar GEMM for ternary weights × int8 activations.
  * This is a naive O(n*nr*nc) implementation — purely for correctness.
+ * Column c of the result starts at (char *)s + c * bs.
  */
 static void scalar_gemm_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
-    /* For the scalar fallback, GEMM = batched GEMV */
+    /* For the scalar fallback, GEMM = one GEMV per activation column */
     /* This is intentionally naive; SIMD backends will be fast */
-    scalar_gemv_i2_i8(n, s, bs, vx, vy, nr, nc);
+    const int8_t * y = (const int8_t *)vy;
+    for (int c = 0; c < nc; c++) {
+        scalar_gemv_i2_i8(n, (float *)((char *)s + c * bs), sizeof(float), vx, y + (size_t)c * n, nr, 1);
+    }
 }
 
 /* ──────────── Backend descriptor ────────────────────────────────── */
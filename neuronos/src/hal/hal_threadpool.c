@@ -0,0 +1,644 @@
+/**
+ * @file hal_threadpool.c
+ * @brief NeuronOS HAL — CPU topology and kernel thread pool
+ *
+ * The HAL dispatch entry points split weight rows across a persistent
+ * pool of pinned workers:
+ *
+ *   - Topology: usable CPUs (affinity mask), their NUMA node, physical
+ *     core and relative capacity (P/E cores, big.LITTLE).
+ *   - Placement: workers are spread over NUMA nodes one core at a time
+ *     (SMT siblings last), then grouped by node so each node owns one
+ *     contiguous row shard. neuronos_hal_place_weights() migrates the
+ *     pages of that shard to the node.
+ *   - Partitioning: each worker's initial range is proportional to its
+ *     core's capacity. Workers that finish early steal chunks, trying
+ *     workers on their own node before remote ones.
+ *
+ * The caller thread is worker 0 and is never pinned. Idle workers spin
+ * briefly for back-to-back decode kernels, then sleep on a condvar.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE /* pthread_setaffinity_np, sched_getaffinity */
+#endif
+
+#include "neuronos/neuronos_hal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <process.h>
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+    #ifdef __linux__
+        #include <sched.h>
+        #include <sys/syscall.h>
+    #endif
+    #ifdef __APPLE__
+        #include <sys/types.h>
+        #include <sys/sysctl.h>
+    #endif
+#endif
+
+/* ──────────────────────────── Constants ─────────────────────────── */
+
+#define POOL_MAX_THREADS 64
+#define POOL_MAX_NODES 64
+#define POOL_SPIN_ITERS 20000           /* busy-wait before sleeping */
+#define POOL_MIN_WORK (256 * 1024)      /* n × rows below this runs inline */
+#define POOL_CHUNKS_PER_THREAD 4        /* stealing granularity */
+#define POOL_CAPACITY_BIG 1024          /* Linux cpu_capacity scale */
+#define POOL_CAPACITY_ATOM 512          /* Intel E-core vs P-core, int8 SIMD */
+
+/* ──────────────────────────── Platform shims ────────────────────── */
+
+#ifdef _WIN32
+typedef HANDLE hal_thread_t;
+typedef SRWLOCK hal_mutex_t;
+typedef CONDITION_VARIABLE hal_cond_t;
+    #define hal_mutex_init(m) InitializeSRWLock(m)
+    #define hal_mutex_lock(m) AcquireSRWLockExclusive(m)
+    #define hal_mutex_trylock(m) (TryAcquireSRWLockExclusive(m) != 0)
+    #define hal_mutex_unlock(m) ReleaseSRWLockExclusive(m)
+    #define hal_cond_init(c) InitializeConditionVariable(c)
+    #define hal_cond_wait(c, m) SleepConditionVariableSRW(c, m, INFINITE, 0)
+    #define hal_cond_broadcast(c) WakeAllConditionVariable(c)
+    #define hal_atomic_load(p) InterlockedCompareExchange((p), 0, 0)
+    #define hal_atomic_add(p, v) InterlockedExchangeAdd((p), (v))
+    #define hal_cpu_relax() YieldProcessor()
+#else
+typedef pthread_t hal_thread_t;
+typedef pthread_mutex_t hal_mutex_t;
+typedef pthread_cond_t hal_cond_t;
+    #define hal_mutex_init(m) pthread_mutex_init(m, NULL)
+    #define hal_mutex_lock(m) pthread_mutex_lock(m)
+    #define hal_mutex_trylock(m) (pthread_mutex_trylock(m) == 0)
+    #define hal_mutex_unlock(m) pthread_mutex_unlock(m)
+    #define hal_cond_init(c) pthread_cond_init(c, NULL)
+    #define hal_cond_wait(c, m) pthread_cond_wait(c, m)
+    #define hal_cond_broadcast(c) pthread_cond_broadcast(c)
+    #define hal_atomic_load(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define hal_atomic_add(p, v) __atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)
+    #if defined(__x86_64__) || defined(__i386__)
+        #define hal_cpu_relax() __builtin_ia32_pause()
+    #elif defined(__aarch64__)
+        #define hal_cpu_relax() __asm__ __volatile__("yield")
+    #else
+        #define hal_cpu_relax() ((void)0)
+    #endif
+#endif
+
+/* ──────────────────────────── Topology ──────────────────────────── */
+
+typedef struct {
+    int cpu;      /* logical CPU id */
+    int node;     /* NUMA node */
+    int core;     /* physical core key (package << 16 | core id) */
+    int smt_rank; /* 0 = first hardware thread of its core */
+    int capacity; /* relative throughput, POOL_CAPACITY_BIG = fastest */
+    int slot;     /* index among same-class CPUs of its node */
+} hal_cpu_t;
+
+static struct {
+    neuronos_hal_topology_t info;
+    hal_cpu_t cpus[NEURONOS_HAL_MAX_CPUS]; /* preferred pinning order */
+} g_topo;
+
+#ifdef __linux__
+static int read_sys_int(const char * path, int fallback) {
+    FILE * f = fopen(path, "r");
+    if (!f)
+        return fallback;
+    int v = fallback;
+    if (fscanf(f, "%d", &v) != 1)
+        v = fallback;
+    fclose(f);
+    return v;
+}
+
+/* Parse a sysfs CPU list ("0-3,8,10-11") into mask[]; false if unreadable */
+static bool read_cpulist(const char * path, bool * mask) {
+    FILE * f = fopen(path, "r");
+    if (!f)
+        return false;
+    char buf[1024];
+    bool ok = fgets(buf, sizeof(buf), f) != NULL;
+    fclose(f);
+    if (!ok)
+        return false;
+
+    char * p = buf;
+    while (*p && *p != '\n') {
+        char * end;
+        long a = strtol(p, &end, 10);
+        if (end == p)
+            break;
+        long b = a;
+        p = end;
+        if (*p == '-') {
+            b = strtol(p + 1, &end, 10);
+            p = end;
+        }
+        for (long c = a; c <= b && c < NEURONOS_HAL_MAX_CPUS; c++)
+            if (c >= 0)
+                mask[c] = true;
+        if (*p == ',')
+            p++;
+    }
+    return true;
+}
+
+static int detect_cpus(hal_cpu_t * cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0)
+        return 0;
+
+    /* NUMA node of every CPU */
+    int node_of[NEURONOS_HAL_MAX_CPUS];
+    for (int c = 0; c < NEURONOS_HAL_MAX_CPUS; c++)
+        node_of[c] = 0;
+    for (int node = 0; node < POOL_MAX_NODES; node++) {
+        char path[96];
+        bool mask[NEURONOS_HAL_MAX_CPUS] = {false};
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        if (!read_cpulist(path, mask))
+            continue;
+        for (int c = 0; c < NEURONOS_HAL_MAX_CPUS; c++)
+            if (mask[c])
+                node_of[c] = node;
+    }
+
+    /* Intel hybrid: E-cores are listed by the cpu_atom PMU */
+    bool atom[NEURONOS_HAL_MAX_CPUS] = {false};
+    bool hybrid = read_cpulist("/sys/devices/cpu_atom/cpus", atom);
+
+    int n = 0;
+    for (int c = 0; c < NEURONOS_HAL_MAX_CPUS && c < CPU_SETSIZE; c++) {
+        if (!CPU_ISSET(c, &set))
+            continue;
+        char path[128];
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/core_id", c);
+        int core_id = read_sys_int(path, c);
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", c);
+        int pkg = read_sys_int(path, 0);
+        /* ARM big.LITTLE (and some x86) expose capacity directly */
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpu_capacity", c);
+        int cap = read_sys_int(path, 0);
+        if (cap <= 0)
+            cap = hybrid && atom[c] ? POOL_CAPACITY_ATOM : POOL_CAPACITY_BIG;
+
+        cpus[n].cpu = c;
+        cpus[n].node = node_of[c];
+        cpus[n].core = (pkg << 16) | (core_id & 0xFFFF);
+        cpus[n].capacity = cap;
+        n++;
+    }
+    return n;
+}
+#elif defined(_WIN32)
+static int detect_cpus(hal_cpu_t * cpus) {
+    DWORD len = 0;
+    GetLogicalProcessorInformationEx(RelationProcessorCore, NULL, &len);
+    uint8_t * buf = len ? (uint8_t *)malloc(len) : NULL;
+    int n = 0;
+    if (buf && GetLogicalProcessorInformationEx(RelationProcessorCore, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buf, &len)) {
+        /* EfficiencyClass: higher = faster; find the top class first */
+        int top = 0;
+        for (DWORD off = 0; off < len;) {
+            PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX e = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buf + off);
+            if (e->Processor.EfficiencyClass > top)
+                top = e->Processor.EfficiencyClass;
+            off += e->Size;
+        }
+        int core = 0;
+        for (DWORD off = 0; off < len; off += ((PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buf + off))->Size) {
+            PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX e = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buf + off);
+            if (e->Processor.GroupMask[0].Group != 0)
+                continue; /* affinity masks below only address group 0 */
+            KAFFINITY mask = e->Processor.GroupMask[0].Mask;
+            for (int c = 0; c < 64 && n < NEURONOS_HAL_MAX_CPUS; c++) {
+                if (!(mask & ((KAFFINITY)1 << c)))
+                    continue;
+                UCHAR node = 0;
+                GetNumaProcessorNode((UCHAR)c, &node);
+                cpus[n].cpu = c;
+                cpus[n].node = node == 0xFF ? 0 : node;
+                cpus[n].core = core;
+                cpus[n].capacity = e->Processor.EfficiencyClass == top ? POOL_CAPACITY_BIG : POOL_CAPACITY_ATOM;
+                n++;
+            }
+            core++;
+        }
+    }
+    free(buf);
+    return n;
+}
+#else
+static int detect_cpus(hal_cpu_t * cpus) {
+    long nproc = 1;
+    #ifdef _SC_NPROCESSORS_ONLN
+    nproc = sysconf(_SC_NPROCESSORS_ONLN);
+    #endif
+    if (nproc < 1)
+        nproc = 1;
+    if (nproc > NEURONOS_HAL_MAX_CPUS)
+        nproc = NEURONOS_HAL_MAX_CPUS;
+
+    /* macOS cannot pin threads; perf levels are only reported in the topology */
+    for (int c = 0; c < (int)nproc; c++) {
+        cpus[c].cpu = c;
+        cpus[c].node = 0;
+        cpus[c].core = c;
+        cpus[c].capacity = POOL_CAPACITY_BIG;
+    }
+    return (int)nproc;
+}
+#endif
+
+/* Pinning order: one thread per core before SMT siblings, fastest class
+ * first, round-robin over NUMA nodes so a partial pool uses every socket. */
+static int cpu_order_cmp(const void * pa, const void * pb) {
+    const hal_cpu_t * a = (const hal_cpu_t *)pa;
+    const hal_cpu_t * b = (const hal_cpu_t *)pb;
+    if (a->smt_rank != b->smt_rank)
+        return a->smt_rank - b->smt_rank;
+    if (a->capacity != b->capacity)
+        return b->capacity - a->capacity;
+    if (a->slot != b->slot)
+        return a->slot - b->slot;
+    if (a->node != b->node)
+        return a->node - b->node;
+    return a->cpu - b->cpu;
+}
+
+void hal_topology_detect(void) {
+    memset(&g_topo, 0, sizeof(g_topo));
+    hal_cpu_t * cpus = g_topo.cpus;
+    int n = detect_cpus(cpus);
+    if (n <= 0) {
+        n = 1;
+        cpus[0].capacity = POOL_CAPACITY_BIG;
+    }
+
+    /* SMT rank, physical core count, node count, capacity classes */
+    int n_cores = 0, top = 0;
+    bool node_seen[POOL_MAX_NODES] = {false};
+    for (int i = 0; i < n; i++) {
+        int rank = 0;
+        for (int j = 0; j < i; j++)
+            if (cpus[j].core == cpus[i].core)
+                rank++;
+        cpus[i].smt_rank = rank;
+        if (rank == 0)
+            n_cores++;
+        if (cpus[i].node >= 0 && cpus[i].node < POOL_MAX_NODES && !node_seen[cpus[i].node]) {
+            node_seen[cpus[i].node] = true;
+            g_topo.info.n_nodes++;
+        }
+        if (cpus[i].capacity > top)
+            top = cpus[i].capacity;
+    }
+    for (int i = 0; i < n; i++) {
+        if (cpus[i].capacity >= top * 9 / 10)
+            g_topo.info.n_big++;
+        else
+            g_topo.info.n_little++;
+    }
+    g_topo.info.n_cpus = n;
+    g_topo.info.n_cores = n_cores;
+    if (g_topo.info.n_nodes == 0)
+        g_topo.info.n_nodes = 1;
+
+#ifdef __APPLE__
+    int perf = 0, eff = 0;
+    size_t len = sizeof(int);
+    if (sysctlbyname("hw.perflevel0.logicalcpu", &perf, &len, NULL, 0) == 0 && perf > 0) {
+        len = sizeof(int);
+        if (sysctlbyname("hw.perflevel1.logicalcpu", &eff, &len, NULL, 0) != 0)
+            eff = 0;
+        g_topo.info.n_big = perf;
+        g_topo.info.n_little = eff;
+    }
+#endif
+
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < i; j++)
+            if (cpus[j].node == cpus[i].node && cpus[j].smt_rank == cpus[i].smt_rank &&
+                cpus[j].capacity == cpus[i].capacity)
+                cpus[i].slot++;
+    qsort(cpus, (size_t)n, sizeof(hal_cpu_t), cpu_order_cmp);
+}
+
+/* ──────────────────────────── Pool state ────────────────────────── */
+
+typedef void (*hal_rows_fn)(void * ctx, int r0, int r1);
+
+/* One worker's share of the current job, padded to its own cache line */
+typedef struct {
+    volatile long next; /* first unclaimed row */
+    long end;
+    char pad[64 - 2 * sizeof(long)];
+} hal_range_t;
+
+static struct {
+    int n_threads; /* including the caller; 1 = inline dispatch */
+    hal_cpu_t slot[POOL_MAX_THREADS];
+    hal_thread_t threads[POOL_MAX_THREADS];
+    hal_range_t ranges[POOL_MAX_THREADS];
+
+    hal_mutex_t dispatch; /* one job at a time; contenders run inline */
+    hal_mutex_t lock;
+    hal_cond_t wake;
+    hal_cond_t done;
+    volatile long generation;
+    long start_generation; /* generation when the workers were created */
+    volatile long n_running; /* workers (not the caller) still on the job */
+    volatile long stop;
+    bool sync_ready;
+
+    /* Current job */
+    hal_rows_fn fn;
+    void * ctx;
+    int chunk;
+} g_pool = {.n_threads = 1};
+
+static void pin_current_thread(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(_WIN32)
+    if (cpu < 64)
+        SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu);
+#else
+    (void)cpu;
+#endif
+}
+
+/* Claim chunks from our own range, then steal: same node first */
+static void pool_run(int self) {
+    const int nt = g_pool.n_threads;
+    for (int pass = 0; pass < 2; pass++) {
+        for (int k = 0; k < nt; k++) {
+            const int victim = (self + k) % nt;
+            const bool local = g_pool.slot[victim].node == g_pool.slot[self].node;
+            if ((pass == 0) != local)
+                continue;
+            hal_range_t * r = &g_pool.ranges[victim];
+            for (;;) {
+                long r0 = hal_atomic_add(&r->next, (long)g_pool.chunk);
+                if (r0 >= r->end)
+                    break;
+                long r1 = r0 + g_pool.chunk < r->end ? r0 + g_pool.chunk : r->end;
+                g_pool.fn(g_pool.ctx, (int)r0, (int)r1);
+            }
+        }
+    }
+}
+
+#ifdef _WIN32
+static unsigned __stdcall pool_worker_main(void * arg) {
+#else
+static void * pool_worker_main(void * arg) {
+#endif
+    const int self = (int)(intptr_t)arg;
+    pin_current_thread(g_pool.slot[self].cpu);
+
+    long seen = g_pool.start_generation;
+    for (;;) {
+        /* Decode issues kernels back to back: spin before sleeping */
+        long gen = seen;
+        for (int spin = 0; spin < POOL_SPIN_ITERS && gen == seen && !hal_atomic_load(&g_pool.stop); spin++) {
+            hal_cpu_relax();
+            gen = hal_atomic_load(&g_pool.generation);
+        }
+        if (gen == seen) {
+            hal_mutex_lock(&g_pool.lock);
+            while (hal_atomic_load(&g_pool.generation) == seen && !hal_atomic_load(&g_pool.stop))
+                hal_cond_wait(&g_pool.wake, &g_pool.lock);
+            hal_mutex_unlock(&g_pool.lock);
+            gen = hal_atomic_load(&g_pool.generation);
+        }
+        if (hal_atomic_load(&g_pool.stop))
+            break;
+        seen = gen;
+
+        pool_run(self);
+
+        if (hal_atomic_add(&g_pool.n_running, -1) == 1) {
+            hal_mutex_lock(&g_pool.lock);
+            hal_cond_broadcast(&g_pool.done);
+            hal_mutex_unlock(&g_pool.lock);
+        }
+    }
+    return 0;
+}
+
+/* Rows per chunk: a multiple of grain, ~POOL_CHUNKS_PER_THREAD per worker */
+static int pool_chunk(int nr, int grain, int nt) {
+    if (grain < 1)
+        grain = 1;
+    int chunk = nr / (nt * POOL_CHUNKS_PER_THREAD);
+    chunk = (chunk + grain - 1) / grain * grain;
+    return chunk < grain ? grain : chunk;
+}
+
+/* Initial row ranges proportional to each worker's core capacity */
+static void pool_partition(int nr, int chunk, int nt, long * starts) {
+    long total = 0;
+    for (int i = 0; i < nt; i++)
+        total += g_pool.slot[i].capacity > 0 ? g_pool.slot[i].capacity : 1;
+    long acc = 0;
+    for (int i = 0; i < nt; i++) {
+        long r = (long)((double)nr * (double)acc / (double)total);
+        starts[i] = (r + chunk / 2) / chunk * chunk;
+        if (starts[i] > nr)
+            starts[i] = nr;
+        acc += g_pool.slot[i].capacity > 0 ? g_pool.slot[i].capacity : 1;
+    }
+    starts[nt] = nr;
+}
+
+static void pool_stop_workers(void) {
+    if (g_pool.n_threads <= 1)
+        return;
+    hal_mutex_lock(&g_pool.lock);
+    hal_atomic_add(&g_pool.stop, 1);
+    hal_cond_broadcast(&g_pool.wake);
+    hal_mutex_unlock(&g_pool.lock);
+    for (int i = 1; i < g_pool.n_threads; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(g_pool.threads[i], INFINITE);
+        CloseHandle(g_pool.threads[i]);
+#else
+        pthread_join(g_pool.threads[i], NULL);
+#endif
+    }
+    g_pool.stop = 0;
+    g_pool.n_threads = 1;
+}
+
+/* ──────────────────────────── Internal API ──────────────────────── */
+
+/**
+ * Run fn over rows [0, nr) on the pool, in chunks that are multiples of
+ * grain. Small jobs, a 1-thread pool, or a pool busy with another
+ * caller's job run inline on the calling thread.
+ */
+void hal_pool_parallel_rows(int nr, int grain, size_t work, hal_rows_fn fn, void * ctx) {
+    const int nt = g_pool.n_threads;
+    const int chunk = pool_chunk(nr, grain, nt);
+    if (nt <= 1 || work < POOL_MIN_WORK || nr < 2 * chunk || !hal_mutex_trylock(&g_pool.dispatch)) {
+        fn(ctx, 0, nr);
+        return;
+    }
+
+    long starts[POOL_MAX_THREADS + 1];
+    pool_partition(nr, chunk, nt, starts);
+    for (int i = 0; i < nt; i++) {
+        g_pool.ranges[i].next = starts[i];
+        g_pool.ranges[i].end = starts[i + 1];
+    }
+    g_pool.fn = fn;
+    g_pool.ctx = ctx;
+    g_pool.chunk = chunk;
+    g_pool.n_running = nt - 1;
+
+    hal_mutex_lock(&g_pool.lock);
+    hal_atomic_add(&g_pool.generation, 1);
+    hal_cond_broadcast(&g_pool.wake);
+    hal_mutex_unlock(&g_pool.lock);
+
+    pool_run(0);
+
+    for (int spin = 0; spin < POOL_SPIN_ITERS && hal_atomic_load(&g_pool.n_running) > 0; spin++)
+        hal_cpu_relax();
+    if (hal_atomic_load(&g_pool.n_running) > 0) {
+        hal_mutex_lock(&g_pool.lock);
+        while (hal_atomic_load(&g_pool.n_running) > 0)
+            hal_cond_wait(&g_pool.done, &g_pool.lock);
+        hal_mutex_unlock(&g_pool.lock);
+    }
+    hal_mutex_unlock(&g_pool.dispatch);
+}
+
+void hal_pool_shutdown(void) {
+    pool_stop_workers();
+}
+
+/* ──────────────────────────── Public API ────────────────────────── */
+
+const neuronos_hal_topology_t * neuronos_hal_get_topology(void) {
+    if (g_topo.info.n_cpus == 0)
+        hal_topology_detect();
+    return &g_topo.info;
+}
+
+neuronos_hal_status_t neuronos_hal_set_n_threads(int n_threads) {
+    if (n_threads < 1)
+        return NEURONOS_HAL_ERR_INVALID;
+    if (g_topo.info.n_cpus == 0)
+        hal_topology_detect();
+    if (n_threads > POOL_MAX_THREADS)
+        n_threads = POOL_MAX_THREADS;
+    if (n_threads == g_pool.n_threads)
+        return NEURONOS_HAL_OK;
+
+    if (!g_pool.sync_ready) {
+        hal_mutex_init(&g_pool.dispatch);
+        hal_mutex_init(&g_pool.lock);
+        hal_cond_init(&g_pool.wake);
+        hal_cond_init(&g_pool.done);
+        g_pool.sync_ready = true;
+    }
+    hal_mutex_lock(&g_pool.dispatch);
+    pool_stop_workers();
+
+    /* Take the first n CPUs of the pinning order (wrapping when
+     * oversubscribed), then group them by node for contiguous shards */
+    const int n_cpus = g_topo.info.n_cpus;
+    for (int i = 0; i < n_threads; i++)
+        g_pool.slot[i] = g_topo.cpus[i % n_cpus];
+    for (int i = 1; i < n_threads; i++) {
+        hal_cpu_t s = g_pool.slot[i];
+        int j = i - 1;
+        while (j >= 0 && g_pool.slot[j].node > s.node) {
+            g_pool.slot[j + 1] = g_pool.slot[j];
+            j--;
+        }
+        g_pool.slot[j + 1] = s;
+    }
+
+    g_pool.start_generation = hal_atomic_load(&g_pool.generation);
+    int started = 1;
+    for (int i = 1; i < n_threads; i++) {
+#ifdef _WIN32
+        uintptr_t h = _beginthreadex(NULL, 0, pool_worker_main, (void *)(intptr_t)i, 0, NULL);
+        if (!h)
+            break;
+        g_pool.threads[i] = (HANDLE)h;
+#else
+        if (pthread_create(&g_pool.threads[i], NULL, pool_worker_main, (void *)(intptr_t)i) != 0)
+            break;
+#endif
+        started++;
+    }
+    g_pool.n_threads = started;
+    if (started < n_threads) {
+        /* e.g. single-threaded WASM: keep what started, slots stay valid */
+        printf("[HAL] Thread pool: started %d of %d threads\n", started, n_threads);
+    }
+    hal_mutex_unlock(&g_pool.dispatch);
+    return started == n_threads ? NEURONOS_HAL_OK : NEURONOS_HAL_ERR_UNSUPPORTED;
+}
+
+int neuronos_hal_get_n_threads(void) {
+    return g_pool.n_threads;
+}
+
+neuronos_hal_status_t neuronos_hal_place_weights(const void * data, size_t row_bytes, int nr, int grain) {
+    if (!data || row_bytes == 0 || nr <= 0)
+        return NEURONOS_HAL_ERR_INVALID;
+    const int nt = g_pool.n_threads;
+    if (nt <= 1 || g_topo.info.n_nodes <= 1)
+        return NEURONOS_HAL_OK; /* nothing to place */
+#if defined(__linux__) && defined(SYS_mbind)
+    const int chunk = pool_chunk(nr, grain, nt);
+    long starts[POOL_MAX_THREADS + 1];
+    pool_partition(nr, chunk, nt, starts);
+
+    const uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    bool ok = true;
+    for (int i = 0; i < nt;) {
+        /* Workers are grouped by node: one contiguous shard per node */
+        int j = i;
+        while (j + 1 < nt && g_pool.slot[j + 1].node == g_pool.slot[i].node)
+            j++;
+        const int node = g_pool.slot[i].node;
+
+        uintptr_t lo = (uintptr_t)data + (uintptr_t)starts[i] * row_bytes;
+        uintptr_t hi = (uintptr_t)data + (uintptr_t)starts[j + 1] * row_bytes;
+        lo = (lo + page - 1) & ~(page - 1); /* whole pages inside the shard */
+        hi &= ~(page - 1);
+        if (hi > lo) {
+            unsigned long mask[POOL_MAX_NODES / (8 * sizeof(unsigned long)) + 1] = {0};
+            mask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+            /* MPOL_PREFERRED = 1, MPOL_MF_MOVE = 1 << 1 (numaif.h, no libnuma needed) */
+            if (syscall(SYS_mbind, (void *)lo, (unsigned long)(hi - lo), 1, mask, POOL_MAX_NODES + 1, 1 << 1) != 0)
+                ok = false;
+        }
+        i = j + 1;
+    }
+    return ok ? NEURONOS_HAL_OK : NEURONOS_HAL_ERR_UNSUPPORTED;
+#else
+    (void)grain;
+    return NEURONOS_HAL_ERR_UNSUPPORTED;
+#endif
+}
@@ -2,7 +2,8 @@
  * hal_vulkan.c — Vulkan GPU device detection and query
  *
  * Pure C11 HAL backend for detecting Vulkan-capable GPUs and querying device properties.
- * This module only handles DETECTION, not actual inference (llama.cpp handles that).
+ * The instance and selected device stay alive until neuronos_hal_shutdown(), so the
+ * I2_S compute backend (hal_vulkan_i2s.c) runs on the same device that is reported here.
  *
  * Follows the same pattern as hal_scalar.c, hal_x86_avx2.c, etc.
  */
@@ -30,12 +31,62 @@ typedef struct {
     uint32_t max_compute_work_group_size[3];   // Max work group size
     uint32_t max_compute_work_group_invocations; // Max total invocations
     bool supports_fp16;          // FP16 compute support
-    bool supports_int8;          // INT8 compute support
+    bool supports_int8;          // Packed int8 dot products (VK_KHR_shader_integer_dot_product)
 } neuronos_vulkan_device_t;
 
 // Singleton: global Vulkan device info
 static neuronos_vulkan_device_t g_vk_device = {0};
 static bool g_vk_initialized = false;
+static VkInstance g_vk_instance = VK_NULL_HANDLE;
+static VkPhysicalDevice g_vk_physical = VK_NULL_HANDLE;
+
+/* Highest instance version the loader offers, capped at 1.1 (needed for features2 queries) */
+static uint32_t vk_instance_api_version(void) {
+    PFN_vkEnumerateInstanceVersion enum_version =
+        (PFN_vkEnumerateInstanceVersion)vkGetInstanceProcAddr(VK_NULL_HANDLE, "vkEnumerateInstanceVersion");
+    uint32_t version = VK_API_VERSION_1_0;
+    if (enum_version && enum_version(&version) == VK_SUCCESS && version >= VK_API_VERSION_1_1)
+        return VK_API_VERSION_1_1;
+    return VK_API_VERSION_1_0;
+}
+
+static bool vk_has_device_extension(VkPhysicalDevice dev, const char * name) {
+    uint32_t count = 0;
+    if (vkEnumerateDeviceExtensionProperties(dev, NULL, &count, NULL) != VK_SUCCESS || count == 0)
+        return false;
+    VkExtensionProperties * exts = malloc(count * sizeof(VkExtensionProperties));
+    if (!exts)
+        return false;
+    bool found = false;
+    if (vkEnumerateDeviceExtensionProperties(dev, NULL, &count, exts) == VK_SUCCESS) {
+        for (uint32_t i = 0; i < count && !found; i++)
+            found = strcmp(exts[i].extensionName, name) == 0;
+    }
+    free(exts);
+    return found;
+}
+
+/* Packed 4 x int8 dot products: extension present and the feature bit set */
+static bool vk_query_int_dot(VkPhysicalDevice dev, uint32_t instance_version, uint32_t device_version) {
+#ifdef VK_KHR_shader_integer_dot_product
+    if (instance_version < VK_API_VERSION_1_1 || device_version < VK_API_VERSION_1_1)
+        return false;
+    if (!vk_has_device_extension(dev, VK_KHR_SHADER_INTEGER_DOT_PRODUCT_EXTENSION_NAME))
+        return false;
+    VkPhysicalDeviceShaderIntegerDotProductFeaturesKHR dot = {0};
+    dot.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_INTEGER_DOT_PRODUCT_FEATURES_KHR;
+    VkPhysicalDeviceFeatures2 features2 = {0};
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features2.pNext = &dot;
+    vkGetPhysicalDeviceFeatures2(dev, &features2);
+    return dot.shaderIntegerDotProduct == VK_TRUE;
+#else
+    (void)dev;
+    (void)instance_version;
+    (void)device_version;
+    return false;
+#endif
+}
 
 /**
  * Initialize Vulkan detection (called once, lazy)
@@ -51,7 +102,7 @@ neuronos_hal_status_t neuronos_hal_vulkan_init(void) {
     app_info.applicationVersion = VK_MAKE_VERSION(0, 9, 1);
     app_info.pEngineName = "NeuronOS HAL";
     app_info.engineVersion = VK_MAKE_VERSION(0, 9, 1);
-    app_info.apiVersion = VK_API_VERSION_1_0;
+    app_info.apiVersion = vk_instance_api_version();
 
     VkInstanceCreateInfo create_info = {0};
     create_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -134,7 +185,7 @@ neuronos_hal_status_t neuronos_hal_vulkan_init(void) {
     VkPhysicalDeviceFeatures features;
     vkGetPhysicalDeviceFeatures(selected, &features);
     g_vk_device.supports_fp16 = features.shaderFloat64;  // Proxy for FP16 (real check needs extensions)
-    g_vk_device.supports_int8 = features.shaderInt16;    // Proxy for INT8
+    g_vk_device.supports_int8 = vk_query_int_dot(selected, app_info.apiVersion, props.apiVersion);
 
     // Calculate total VRAM (sum all device-local memory heaps)
     g_vk_device.vram_bytes = 0;
@@ -144,14 +195,45 @@ neuronos_hal_status_t neuronos_hal_vulkan_init(void) {
         }
     }
 
-    // Cleanup: we only needed detection, llama.cpp will manage actual Vulkan usage
+    // Keep the instance: the I2_S compute backend creates its device on `selected`
     free(devices);
-    vkDestroyInstance(instance, NULL);
+    g_vk_instance = instance;
+    g_vk_physical = selected;
 
     g_vk_initialized = true;
     return NEURONOS_HAL_OK;
 }
 
+/**
+ * Release the instance kept for the compute backend (called by neuronos_hal_shutdown()).
+ * The next neuronos_hal_vulkan_init() detects again.
+ */
+void neuronos_hal_vulkan_shutdown(void) {
+    if (g_vk_instance != VK_NULL_HANDLE)
+        vkDestroyInstance(g_vk_instance, NULL);
+    g_vk_instance = VK_NULL_HANDLE;
+    g_vk_physical = VK_NULL_HANDLE;
+    memset(&g_vk_device, 0, sizeof(g_vk_device));
+    g_vk_initialized = false;
+}
+
+/* Internal: device the compute backend runs on (from hal_vulkan_i2s.c) */
+bool hal_vulkan_available(void) {
+    return g_vk_initialized && g_vk_device.available && g_vk_physical != VK_NULL_HANDLE;
+}
+
+VkPhysicalDevice hal_vulkan_physical_device(void) {
+    return g_vk_physical;
+}
+
+bool hal_vulkan_supports_int_dot(void) {
+    return g_vk_device.supports_int8;
+}
+
+size_t hal_vulkan_vram_bytes(void) {
+    return g_vk_device.vram_bytes;
+}
+
 /**
  * Get Vulkan device info (const pointer to singleton)
  */
@@ -198,6 +280,7 @@ void neuronos_hal_vulkan_print_info(void) {
     printf("\n");
 
     printf("  Device ID: 0x%04X\n", dev->device_id);
+    printf("  Int8 dot product: %s\n", dev->supports_int8 ? "yes" : "no");
 
     /* Extended info - useful for optimization */
     printf("  Vulkan API: %u.%u.%u\n",
@@ -249,4 +332,7 @@ void neuronos_hal_vulkan_print_info(void) {
     printf("Vulkan GPU: Not compiled (build with -DNEURONOS_VULKAN=ON)\n");
 }
 
+void neuronos_hal_vulkan_shutdown(void) {
+}
+
 #endif // NEURONOS_HAS_VULKAN
@@ -0,0 +1,594 @@
+/**
+ * @file hal_vulkan_i2s.c
+ * @brief NeuronOS HAL — Vulkan compute backend for I2_S ternary matmul
+ *
+ * Upstream ggml-vulkan has no I2_S kernels, so BitNet layers either
+ * stay on the CPU or get dequantized. This backend keeps the weights
+ * in their packed 2-bit form on the GPU and runs shaders/i2s_matmul.comp
+ * for vec_dot / gemv / gemm:
+ *
+ *   - Weights: uploaded once per host tensor into device-local memory
+ *     and cached by (pointer, size). A sampled fingerprint is checked
+ *     on every hit, so a freed and reused host buffer is re-uploaded.
+ *   - Activations / results: persistently mapped host-visible buffers,
+ *     one submit per call, results scattered to the caller's strides.
+ *   - Int8: the GL_EXT_integer_dot_product shader variant is used when
+ *     the device reports VK_KHR_shader_integer_dot_product.
+ *
+ * Products too small to amortize a submit, weights that do not fit the
+ * VRAM budget, and any Vulkan error run on the best CPU backend, so the
+ * results are always the same raw u2 × s8 sums as the scalar reference.
+ *
+ * Built only with NEURONOS_HAS_VULKAN_COMPUTE (Vulkan SDK with glslc):
+ * CMake compiles the shader to SPIR-V and embeds it as i2s_matmul_spv.h.
+ */
+
+#if defined(NEURONOS_HAS_VULKAN) && defined(NEURONOS_HAS_VULKAN_COMPUTE)
+
+#include "neuronos/neuronos_hal.h"
+
+#include "i2s_matmul_spv.h" /* generated: i2s_matmul_spv[], i2s_matmul_int8_spv[] */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vulkan/vulkan.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+typedef SRWLOCK vk_mutex_t;
+    #define VK_MUTEX_INIT SRWLOCK_INIT
+    #define vk_mutex_lock(m) AcquireSRWLockExclusive(m)
+    #define vk_mutex_unlock(m) ReleaseSRWLockExclusive(m)
+#else
+    #include <pthread.h>
+typedef pthread_mutex_t vk_mutex_t;
+    #define VK_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+    #define vk_mutex_lock(m) pthread_mutex_lock(m)
+    #define vk_mutex_unlock(m) pthread_mutex_unlock(m)
+#endif
+
+/* Device selected by detection (from hal_vulkan.c) */
+extern bool hal_vulkan_available(void);
+extern VkPhysicalDevice hal_vulkan_physical_device(void);
+extern bool hal_vulkan_supports_int_dot(void);
+extern size_t hal_vulkan_vram_bytes(void);
+
+/* CPU fallback and its pool dispatch (from hal_registry.c) */
+extern const neuronos_backend_t * hal_best_cpu_backend(void);
+extern void hal_run_vec_dot(const neuronos_backend_t * b, int n, float * s, size_t bs, const void * vx, size_t bx,
+                            const void * vy, size_t by, int nrc);
+extern void hal_run_gemv(const neuronos_backend_t * b, int n, float * s, size_t bs, const void * vx,
+                         const void * vy, int nr, int nc);
+extern void hal_run_gemm(const neuronos_backend_t * b, int n, float * s, size_t bs, const void * vx,
+                         const void * vy, int nr, int nc);
+
+/* ──────────────────────────── Constants ─────────────────────────── */
+
+#define VK_QK_I2_S 128
+#define VK_MAX_WEIGHTS 1024         /* cached weight tensors (a 7B model has ~230) */
+#define VK_MIN_MACS (1u << 20)      /* n × nr × nc below this stays on the CPU */
+#define VK_VRAM_BUDGET_PCT 75       /* share of device-local memory for weights */
+#define VK_FINGERPRINT_SAMPLES 64   /* 8-byte words hashed per weight tensor */
+#define VK_FENCE_TIMEOUT_NS 10000000000ull
+
+/* ──────────────────────────── State ─────────────────────────────── */
+
+typedef struct {
+    VkBuffer buf;
+    VkDeviceMemory mem;
+    void * map; /* persistently mapped (host-visible buffers only) */
+    size_t size;
+} vk_buffer_t;
+
+typedef struct {
+    const void * host;
+    size_t bytes;
+    uint64_t fingerprint;
+    vk_buffer_t gpu;
+} vk_weight_t;
+
+typedef struct {
+    uint32_t row_words;
+    uint32_t nr;
+    uint32_t row_base;
+} vk_push_t;
+
+static struct {
+    bool ready;
+    bool int_dot;
+    VkPhysicalDevice phys;
+    VkPhysicalDeviceMemoryProperties mem_props;
+    uint32_t max_groups[2];
+    VkDevice dev;
+    VkQueue queue;
+    VkDescriptorSetLayout set_layout;
+    VkPipelineLayout pipe_layout;
+    VkPipeline pipeline;
+    VkDescriptorPool desc_pool;
+    VkDescriptorSet desc_set;
+    VkCommandPool cmd_pool;
+    VkCommandBuffer cmd;
+    VkFence fence;
+    vk_buffer_t act, out, staging;
+    vk_weight_t weights[VK_MAX_WEIGHTS];
+    int n_weights;
+    size_t weight_bytes, weight_budget;
+    const neuronos_backend_t * cpu; /* fallback for work the GPU does not take */
+} g_vk;
+
+static vk_mutex_t g_vk_lock = VK_MUTEX_INIT;
+
+/* ──────────────────────────── Buffers ───────────────────────────── */
+
+static int vk_find_memory(uint32_t type_bits, VkMemoryPropertyFlags want) {
+    for (uint32_t i = 0; i < g_vk.mem_props.memoryTypeCount; i++) {
+        if ((type_bits & (1u << i)) && (g_vk.mem_props.memoryTypes[i].propertyFlags & want) == want)
+            return (int)i;
+    }
+    return -1;
+}
+
+static void vk_buffer_destroy(vk_buffer_t * b) {
+    if (b->map)
+        vkUnmapMemory(g_vk.dev, b->mem);
+    if (b->buf != VK_NULL_HANDLE)
+        vkDestroyBuffer(g_vk.dev, b->buf, NULL);
+    if (b->mem != VK_NULL_HANDLE)
+        vkFreeMemory(g_vk.dev, b->mem, NULL);
+    memset(b, 0, sizeof(*b));
+}
+
+static bool vk_buffer_create(vk_buffer_t * b, size_t size, VkBufferUsageFlags usage, bool host_visible) {
+    memset(b, 0, sizeof(*b));
+    VkBufferCreateInfo info = {0};
+    info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    info.size = size;
+    info.usage = usage;
+    info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(g_vk.dev, &info, NULL, &b->buf) != VK_SUCCESS)
+        return false;
+
+    VkMemoryRequirements req;
+    vkGetBufferMemoryRequirements(g_vk.dev, b->buf, &req);
+    int type = host_visible ? vk_find_memory(req.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                                     VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+                            : vk_find_memory(req.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    VkMemoryAllocateInfo alloc = {0};
+    alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc.allocationSize = req.size;
+    alloc.memoryTypeIndex = (uint32_t)type;
+    if (type < 0 || vkAllocateMemory(g_vk.dev, &alloc, NULL, &b->mem) != VK_SUCCESS ||
+        vkBindBufferMemory(g_vk.dev, b->buf, b->mem, 0) != VK_SUCCESS ||
+        (host_visible && vkMapMemory(g_vk.dev, b->mem, 0, VK_WHOLE_SIZE, 0, &b->map) != VK_SUCCESS)) {
+        vk_buffer_destroy(b);
+        return false;
+    }
+    b->size = size;
+    return true;
+}
+
+/* Grow a host-visible buffer to at least size bytes */
+static bool vk_host_reserve(vk_buffer_t * b, size_t size, VkBufferUsageFlags usage) {
+    if (b->size >= size)
+        return true;
+    vk_buffer_destroy(b);
+    return vk_buffer_create(b, size, usage, true);
+}
+
+/* ──────────────────────────── Submission ────────────────────────── */
+
+static bool vk_begin(void) {
+    VkCommandBufferBeginInfo begin = {0};
+    begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    return vkResetCommandBuffer(g_vk.cmd, 0) == VK_SUCCESS && vkBeginCommandBuffer(g_vk.cmd, &begin) == VK_SUCCESS;
+}
+
+static bool vk_submit_wait(void) {
+    if (vkEndCommandBuffer(g_vk.cmd) != VK_SUCCESS)
+        return false;
+    VkSubmitInfo submit = {0};
+    submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers = &g_vk.cmd;
+    if (vkQueueSubmit(g_vk.queue, 1, &submit, g_vk.fence) != VK_SUCCESS)
+        return false;
+    bool ok = vkWaitForFences(g_vk.dev, 1, &g_vk.fence, VK_TRUE, VK_FENCE_TIMEOUT_NS) == VK_SUCCESS;
+    vkResetFences(g_vk.dev, 1, &g_vk.fence);
+    return ok;
+}
+
+/* ──────────────────────────── Weight cache ──────────────────────── */
+
+/* Cheap identity check: FNV-1a over evenly spaced 8-byte samples */
+static uint64_t vk_fingerprint(const void * host, size_t bytes) {
+    const uint8_t * p = (const uint8_t *)host;
+    uint64_t h = 1469598103934665603ull;
+    const size_t words = bytes / 8;
+    for (int i = 0; i < VK_FINGERPRINT_SAMPLES && words > 0; i++) {
+        uint64_t v;
+        memcpy(&v, p + (words * (size_t)i / VK_FINGERPRINT_SAMPLES) * 8, sizeof(v));
+        h = (h ^ v) * 1099511628211ull;
+    }
+    return h ^ bytes;
+}
+
+static bool vk_upload(vk_buffer_t * dst, const void * host, size_t bytes) {
+    if (!vk_host_reserve(&g_vk.staging, bytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT))
+        return false;
+    memcpy(g_vk.staging.map, host, bytes);
+    if (!vk_begin())
+        return false;
+    VkBufferCopy region = {0, 0, bytes};
+    vkCmdCopyBuffer(g_vk.cmd, g_vk.staging.buf, dst->buf, 1, &region);
+    return vk_submit_wait();
+}
+
+/* Device copy of a weight tensor, uploading on first use; NULL if it does not fit */
+static const vk_weight_t * vk_weight_get(const void * host, size_t bytes) {
+    const uint64_t fp = vk_fingerprint(host, bytes);
+    for (int i = 0; i < g_vk.n_weights; i++) {
+        vk_weight_t * w = &g_vk.weights[i];
+        if (w->host != host || w->bytes != bytes)
+            continue;
+        if (w->fingerprint != fp) {
+            if (!vk_upload(&w->gpu, host, bytes))
+                return NULL;
+            w->fingerprint = fp;
+        }
+        return w;
+    }
+
+    if (g_vk.n_weights >= VK_MAX_WEIGHTS || g_vk.weight_bytes + bytes > g_vk.weight_budget)
+        return NULL;
+    vk_weight_t * w = &g_vk.weights[g_vk.n_weights];
+    if (!vk_buffer_create(&w->gpu, bytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                          false))
+        return NULL;
+    if (!vk_upload(&w->gpu, host, bytes)) {
+        vk_buffer_destroy(&w->gpu);
+        return NULL;
+    }
+    w->host = host;
+    w->bytes = bytes;
+    w->fingerprint = fp;
+    g_vk.weight_bytes += bytes;
+    g_vk.n_weights++;
+    return w;
+}
+
+static void vk_weights_release(void) {
+    for (int i = 0; i < g_vk.n_weights; i++)
+        vk_buffer_destroy(&g_vk.weights[i].gpu);
+    g_vk.n_weights = 0;
+    g_vk.weight_bytes = 0;
+}
+
+/* ──────────────────────────── Kernels ───────────────────────────── */
+
+static void vk_bind(VkBuffer weights, size_t weight_bytes, size_t act_bytes, size_t out_bytes) {
+    VkDescriptorBufferInfo infos[3] = {
+        {weights, 0, weight_bytes},
+        {g_vk.act.buf, 0, act_bytes},
+        {g_vk.out.buf, 0, out_bytes},
+    };
+    VkWriteDescriptorSet writes[3];
+    memset(writes, 0, sizeof(writes));
+    for (uint32_t i = 0; i < 3; i++) {
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet = g_vk.desc_set;
+        writes[i].dstBinding = i;
+        writes[i].descriptorCount = 1;
+        writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[i].pBufferInfo = &infos[i];
+    }
+    vkUpdateDescriptorSets(g_vk.dev, 3, writes, 0, NULL);
+}
+
+/**
+ * nr contiguous rows of n/4 packed bytes × nc activation columns of n
+ * bytes. Result (r, c) goes to (char *)s + c * col_stride + r * row_stride.
+ * Returns false (nothing written) when the work should run on the CPU.
+ */
+static bool vk_matmul(int n, float * s, size_t row_stride, size_t col_stride, const void * vx, const void * vy,
+                      int nr, int nc) {
+    if (!g_vk.ready || n <= 0 || n % VK_QK_I2_S != 0 || nr <= 0 || nc <= 0 ||
+        (size_t)n * (size_t)nr * (size_t)nc < VK_MIN_MACS || (uint32_t)nc > g_vk.max_groups[1])
+        return false;
+
+    const size_t w_bytes = (size_t)nr * (size_t)(n / 4);
+    const size_t a_bytes = (size_t)nc * (size_t)n;
+    const size_t o_bytes = (size_t)nc * (size_t)nr * sizeof(float);
+
+    vk_mutex_lock(&g_vk_lock);
+    bool ok = false;
+    const vk_weight_t * w = vk_weight_get(vx, w_bytes);
+    if (!w || !vk_host_reserve(&g_vk.act, a_bytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) ||
+        !vk_host_reserve(&g_vk.out, o_bytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT))
+        goto done;
+
+    memcpy(g_vk.act.map, vy, a_bytes);
+    vk_bind(w->gpu.buf, w_bytes, a_bytes, o_bytes);
+    if (!vk_begin())
+        goto done;
+    vkCmdBindPipeline(g_vk.cmd, VK_PIPELINE_BIND_POINT_COMPUTE, g_vk.pipeline);
+    vkCmdBindDescriptorSets(g_vk.cmd, VK_PIPELINE_BIND_POINT_COMPUTE, g_vk.pipe_layout, 0, 1, &g_vk.desc_set, 0,
+                            NULL);
+    for (uint32_t r0 = 0; r0 < (uint32_t)nr; r0 += g_vk.max_groups[0]) {
+        const uint32_t rows = (uint32_t)nr - r0 < g_vk.max_groups[0] ? (uint32_t)nr - r0 : g_vk.max_groups[0];
+        vk_push_t push = {(uint32_t)(n / 16), (uint32_t)nr, r0};
+        vkCmdPushConstants(g_vk.cmd, g_vk.pipe_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+        vkCmdDispatch(g_vk.cmd, rows, (uint32_t)nc, 1);
+    }
+    VkMemoryBarrier barrier = {0};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(g_vk.cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier,
+                         0, NULL, 0, NULL);
+    if (!vk_submit_wait())
+        goto done;
+
+    const float * out = (const float *)g_vk.out.map;
+    for (int c = 0; c < nc; c++) {
+        char * col = (char *)s + (size_t)c * col_stride;
+        for (int r = 0; r < nr; r++)
+            *(float *)(col + (size_t)r * row_stride) = out[(size_t)c * nr + r];
+    }
+    ok = true;
+
+done:
+    vk_mutex_unlock(&g_vk_lock);
+    return ok;
+}
+
+static void vk_vec_dot_i2_i8(int n, float * s, size_t bs, const void * vx, size_t bx, const void * vy, size_t by,
+                             int nrc) {
+    /* The GPU copy assumes densely packed rows (bx / 4 == n / 4) */
+    if (bx != (size_t)n || !vk_matmul(n, s, sizeof(float), 0, vx, vy, nrc, 1))
+        hal_run_vec_dot(g_vk.cpu, n, s, bs, vx, bx, vy, by, nrc);
+}
+
+static void vk_gemv_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
+    if (vk_matmul(n, s, bs, 0, vx, vy, nr, 1))
+        return;
+    if (g_vk.cpu->gemv_i2_i8) {
+        hal_run_gemv(g_vk.cpu, n, s, bs, vx, vy, nr, nc);
+    } else if (bs == sizeof(float)) {
+        hal_run_vec_dot(g_vk.cpu, n, s, bs, vx, (size_t)n, vy, 0, nr);
+    } else {
+        for (int r = 0; r < nr; r++)
+            g_vk.cpu->vec_dot_i2_i8(n, (float *)((char *)s + (size_t)r * bs), sizeof(float),
+                                    (const uint8_t *)vx + (size_t)r * (n / 4), (size_t)n, vy, 0, 1);
+    }
+}
+
+static void vk_gemm_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
+    if (vk_matmul(n, s, sizeof(float), bs, vx, vy, nr, nc))
+        return;
+    if (g_vk.cpu->gemm_i2_i8) {
+        hal_run_gemm(g_vk.cpu, n, s, bs, vx, vy, nr, nc);
+    } else {
+        for (int c = 0; c < nc; c++)
+            hal_run_vec_dot(g_vk.cpu, n, (float *)((char *)s + (size_t)c * bs), sizeof(float), vx, (size_t)n,
+                            (const int8_t *)vy + (size_t)c * n, 0, nr);
+    }
+}
+
+static size_t vk_quantize_i2(const float * src, void * dst, int64_t nrow, int64_t n_per_row,
+                             const float * quant_weights) {
+    return g_vk.cpu->quantize_i2(src, dst, nrow, n_per_row, quant_weights);
+}
+
+/* ──────────────────────────── Init / shutdown ───────────────────── */
+
+static void vk_destroy(void) {
+    if (g_vk.dev != VK_NULL_HANDLE) {
+        vkDeviceWaitIdle(g_vk.dev);
+        vk_weights_release();
+        vk_buffer_destroy(&g_vk.act);
+        vk_buffer_destroy(&g_vk.out);
+        vk_buffer_destroy(&g_vk.staging);
+        if (g_vk.fence != VK_NULL_HANDLE)
+            vkDestroyFence(g_vk.dev, g_vk.fence, NULL);
+        if (g_vk.cmd_pool != VK_NULL_HANDLE)
+            vkDestroyCommandPool(g_vk.dev, g_vk.cmd_pool, NULL);
+        if (g_vk.desc_pool != VK_NULL_HANDLE)
+            vkDestroyDescriptorPool(g_vk.dev, g_vk.desc_pool, NULL);
+        if (g_vk.pipeline != VK_NULL_HANDLE)
+            vkDestroyPipeline(g_vk.dev, g_vk.pipeline, NULL);
+        if (g_vk.pipe_layout != VK_NULL_HANDLE)
+            vkDestroyPipelineLayout(g_vk.dev, g_vk.pipe_layout, NULL);
+        if (g_vk.set_layout != VK_NULL_HANDLE)
+            vkDestroyDescriptorSetLayout(g_vk.dev, g_vk.set_layout, NULL);
+        vkDestroyDevice(g_vk.dev, NULL);
+    }
+    memset(&g_vk, 0, sizeof(g_vk));
+}
+
+static bool vk_create_device(void) {
+    uint32_t n_families = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(g_vk.phys, &n_families, NULL);
+    VkQueueFamilyProperties * families = malloc((n_families ? n_families : 1) * sizeof(VkQueueFamilyProperties));
+    if (!families)
+        return false;
+    vkGetPhysicalDeviceQueueFamilyProperties(g_vk.phys, &n_families, families);
+    int family = -1;
+    for (uint32_t i = 0; i < n_families && family < 0; i++) {
+        if (families[i].queueFlags & VK_QUEUE_COMPUTE_BIT)
+            family = (int)i;
+    }
+    free(families);
+    if (family < 0)
+        return false;
+
+    float prio = 1.0f;
+    VkDeviceQueueCreateInfo queue_info = {0};
+    queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queue_info.queueFamilyIndex = (uint32_t)family;
+    queue_info.queueCount = 1;
+    queue_info.pQueuePriorities = &prio;
+
+    VkDeviceCreateInfo dev_info = {0};
+    dev_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    dev_info.queueCreateInfoCount = 1;
+    dev_info.pQueueCreateInfos = &queue_info;
+#ifdef VK_KHR_shader_integer_dot_product
+    const char * ext = VK_KHR_SHADER_INTEGER_DOT_PRODUCT_EXTENSION_NAME;
+    VkPhysicalDeviceShaderIntegerDotProductFeaturesKHR dot = {0};
+    if (g_vk.int_dot) {
+        dot.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_INTEGER_DOT_PRODUCT_FEATURES_KHR;
+        dot.shaderIntegerDotProduct = VK_TRUE;
+        dev_info.pNext = &dot;
+        dev_info.enabledExtensionCount = 1;
+        dev_info.ppEnabledExtensionNames = &ext;
+    }
+#endif
+    if (vkCreateDevice(g_vk.phys, &dev_info, NULL, &g_vk.dev) != VK_SUCCESS) {
+        g_vk.dev = VK_NULL_HANDLE;
+        return false;
+    }
+    vkGetDeviceQueue(g_vk.dev, (uint32_t)family, 0, &g_vk.queue);
+
+    VkCommandPoolCreateInfo pool_info = {0};
+    pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    pool_info.queueFamilyIndex = (uint32_t)family;
+    VkCommandBufferAllocateInfo cmd_info = {0};
+    cmd_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    cmd_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cmd_info.commandBufferCount = 1;
+    VkFenceCreateInfo fence_info = {0};
+    fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    if (vkCreateCommandPool(g_vk.dev, &pool_info, NULL, &g_vk.cmd_pool) != VK_SUCCESS)
+        return false;
+    cmd_info.commandPool = g_vk.cmd_pool;
+    return vkAllocateCommandBuffers(g_vk.dev, &cmd_info, &g_vk.cmd) == VK_SUCCESS &&
+           vkCreateFence(g_vk.dev, &fence_info, NULL, &g_vk.fence) == VK_SUCCESS;
+}
+
+static bool vk_create_pipeline(void) {
+    VkDescriptorSetLayoutBinding bindings[3];
+    memset(bindings, 0, sizeof(bindings));
+    for (uint32_t i = 0; i < 3; i++) {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+    VkDescriptorSetLayoutCreateInfo set_info = {0};
+    set_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    set_info.bindingCount = 3;
+    set_info.pBindings = bindings;
+    if (vkCreateDescriptorSetLayout(g_vk.dev, &set_info, NULL, &g_vk.set_layout) != VK_SUCCESS)
+        return false;
+
+    VkPushConstantRange push = {VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(vk_push_t)};
+    VkPipelineLayoutCreateInfo layout_info = {0};
+    layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layout_info.setLayoutCount = 1;
+    layout_info.pSetLayouts = &g_vk.set_layout;
+    layout_info.pushConstantRangeCount = 1;
+    layout_info.pPushConstantRanges = &push;
+    if (vkCreatePipelineLayout(g_vk.dev, &layout_info, NULL, &g_vk.pipe_layout) != VK_SUCCESS)
+        return false;
+
+    VkShaderModuleCreateInfo module_info = {0};
+    module_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    module_info.codeSize = g_vk.int_dot ? sizeof(i2s_matmul_int8_spv) : sizeof(i2s_matmul_spv);
+    module_info.pCode = g_vk.int_dot ? i2s_matmul_int8_spv : i2s_matmul_spv;
+    VkShaderModule module;
+    if (vkCreateShaderModule(g_vk.dev, &module_info, NULL, &module) != VK_SUCCESS)
+        return false;
+
+    VkComputePipelineCreateInfo pipe_info = {0};
+    pipe_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipe_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipe_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipe_info.stage.module = module;
+    pipe_info.stage.pName = "main";
+    pipe_info.layout = g_vk.pipe_layout;
+    VkResult res = vkCreateComputePipelines(g_vk.dev, VK_NULL_HANDLE, 1, &pipe_info, NULL, &g_vk.pipeline);
+    vkDestroyShaderModule(g_vk.dev, module, NULL);
+    if (res != VK_SUCCESS)
+        return false;
+
+    VkDescriptorPoolSize pool_size = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3};
+    VkDescriptorPoolCreateInfo pool_info = {0};
+    pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_info.maxSets = 1;
+    pool_info.poolSizeCount = 1;
+    pool_info.pPoolSizes = &pool_size;
+    if (vkCreateDescriptorPool(g_vk.dev, &pool_info, NULL, &g_vk.desc_pool) != VK_SUCCESS)
+        return false;
+    VkDescriptorSetAllocateInfo set_alloc = {0};
+    set_alloc.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    set_alloc.descriptorPool = g_vk.desc_pool;
+    set_alloc.descriptorSetCount = 1;
+    set_alloc.pSetLayouts = &g_vk.set_layout;
+    return vkAllocateDescriptorSets(g_vk.dev, &set_alloc, &g_vk.desc_set) == VK_SUCCESS;
+}
+
+/*
+ * Called when the backend is selected. A device that fails to set up
+ * still leaves the backend usable: every call then takes the CPU path.
+ */
+static neuronos_hal_status_t vk_init(void) {
+    vk_destroy();
+    g_vk.cpu = hal_best_cpu_backend();
+    if (!g_vk.cpu)
+        return NEURONOS_HAL_ERR_NO_BACKEND;
+    if (!hal_vulkan_available())
+        return NEURONOS_HAL_ERR_UNSUPPORTED;
+
+    g_vk.phys = hal_vulkan_physical_device();
+    g_vk.int_dot = hal_vulkan_supports_int_dot();
+    vkGetPhysicalDeviceMemoryProperties(g_vk.phys, &g_vk.mem_props);
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(g_vk.phys, &props);
+    g_vk.max_groups[0] = props.limits.maxComputeWorkGroupCount[0];
+    g_vk.max_groups[1] = props.limits.maxComputeWorkGroupCount[1];
+    g_vk.weight_budget = hal_vulkan_vram_bytes() / 100 * VK_VRAM_BUDGET_PCT;
+
+    if (!vk_create_device() || !vk_create_pipeline()) {
+        const neuronos_backend_t * cpu = g_vk.cpu;
+        vk_destroy();
+        g_vk.cpu = cpu;
+        printf("[HAL] Vulkan: compute setup failed on %s, I2_S kernels stay on %s\n", props.deviceName, cpu->name);
+        return NEURONOS_HAL_OK;
+    }
+    g_vk.ready = true;
+    printf("[HAL] Vulkan: I2_S kernels on %s (%s dot, %zu MB weight budget, CPU fallback %s)\n", props.deviceName,
+           g_vk.int_dot ? "int8" : "scalar", g_vk.weight_budget / (1024 * 1024), g_vk.cpu->name);
+    return NEURONOS_HAL_OK;
+}
+
+static void vk_shutdown(void) {
+    vk_destroy();
+}
+
+/* ──────────────────────────── Backend descriptor ────────────────── */
+
+const neuronos_backend_t neuronos_backend_vulkan = {
+    .name = "vulkan_i2s",
+    .type = NEURONOS_BACKEND_VULKAN,
+    .priority = 100, /* above every CPU backend: small products fall back per call */
+    .required_features = NEURONOS_FEAT_VULKAN,
+    .config =
+        {
+            .row_block_size = 1, /* not split over the CPU pool: one submit per call */
+            .col_block_size = VK_QK_I2_S,
+            .parallel_size = 1,
+            .qk_i2_s = VK_QK_I2_S,
+        },
+    .vec_dot_i2_i8 = vk_vec_dot_i2_i8,
+    .quantize_i2 = vk_quantize_i2,
+    .gemv_i2_i8 = vk_gemv_i2_i8,
+    .gemm_i2_i8 = vk_gemm_i2_i8,
+    .init = vk_init,
+    .shutdown = vk_shutdown,
+};
+
+#endif /* NEURONOS_HAS_VULKAN && NEURONOS_HAS_VULKAN_COMPUTE */
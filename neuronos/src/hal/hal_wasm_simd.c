@@ -0,0 +1,294 @@
+/**
+ * @file hal_wasm_simd.c
+ * @brief NeuronOS HAL — WebAssembly SIMD128 / relaxed-SIMD backend
+ *
+ * Browser builds (neuronos/wasm/) run the I2_S kernels on 128-bit wasm
+ * vectors. Two descriptors:
+ *
+ *   wasm_simd128       — i16x8.extmul_{low,high}_i8x16 products, folded
+ *                        with i32x4.extadd_pairwise once per block
+ *   wasm_relaxed_simd  — i32x4.relaxed_dot_i8x16_i7x16_add: 16 MACs per
+ *                        instruction (VPDPBUSD / SDOT under the hood)
+ *
+ * Same ACT_PARALLEL packing and raw u2 × s8 sums as hal_scalar.c. Weight
+ * codes {0,1,2} are the 7-bit operand of the relaxed dot, so its result
+ * is exact on every engine. Wasm features are fixed when the module is
+ * compiled; the inference worker picks the module the browser validates.
+ *
+ * Compile with: -msimd128 [-mrelaxed-simd] (emcc / clang)
+ */
+
+#if defined(__wasm_simd128__)
+
+    #include "neuronos/neuronos_hal.h"
+
+    #include <stdint.h>
+    #include <wasm_simd128.h>
+
+    #define WASM_QK_I2_S 128
+
+extern size_t quantize_i2_s(const float * src, void * dst, int64_t nrow, int64_t n_per_row,
+                            const float * quant_weights);
+
+/* Codes of one 2-bit slice, as u8 lanes 0..2 */
+    #define WASM_SLICE(B, SHIFT) wasm_v128_and(wasm_u8x16_shr(B, SHIFT), mask)
+
+/* ──────── SIMD128 kernels ──────────────────────────────────────── */
+
+/*
+ * i16 partial of one 16-byte chunk and slice: |w·a| <= 2 × 128, two
+ * products per lane, four slices and two chunks per block → <= 4096.
+ */
+    #define SIMD128_MAC(ACC16, W, A) \
+        ACC16 = wasm_i16x8_add(ACC16, wasm_i16x8_add(wasm_i16x8_extmul_low_i8x16(W, A), wasm_i16x8_extmul_high_i8x16(W, A)))
+
+static inline int32_t wasm_hsum_i32x4(v128_t v) {
+    return wasm_i32x4_extract_lane(v, 0) + wasm_i32x4_extract_lane(v, 1) + wasm_i32x4_extract_lane(v, 2) +
+           wasm_i32x4_extract_lane(v, 3);
+}
+
+/**
+ * Dot nrows packed rows (row_bytes apart) with one activation vector.
+ * Row r is written to (char *)s + r * bs. Four rows share each
+ * activation load.
+ */
+static void simd128_dot_rows(int n, float * s, size_t bs, const uint8_t * x, size_t row_bytes, const int8_t * y,
+                             int nrows) {
+    const int nb = n / WASM_QK_I2_S;
+    const v128_t mask = wasm_i8x16_splat(0x03);
+
+    int row = 0;
+    for (; row + 4 <= nrows; row += 4) {
+        v128_t acc0 = wasm_i32x4_splat(0);
+        v128_t acc1 = acc0, acc2 = acc0, acc3 = acc0;
+        const uint8_t * x0 = x + (size_t)row * row_bytes;
+
+        for (int i = 0; i < nb; i++) {
+            const int8_t * py = y + i * WASM_QK_I2_S;
+            v128_t p0 = wasm_i16x8_splat(0);
+            v128_t p1 = p0, p2 = p0, p3 = p0;
+
+            for (int j = 0; j < 32; j += 16) {
+                const v128_t v0 = wasm_v128_load(py + j);
+                const v128_t v1 = wasm_v128_load(py + 32 + j);
+                const v128_t v2 = wasm_v128_load(py + 64 + j);
+                const v128_t v3 = wasm_v128_load(py + 96 + j);
+
+    #define PROC_ROW(IDX, P)                                                             \
+        {                                                                                \
+            const v128_t b = wasm_v128_load(x0 + (IDX) * row_bytes + (size_t)i * 32 + j); \
+            SIMD128_MAC(P, WASM_SLICE(b, 6), v0);                                        \
+            SIMD128_MAC(P, WASM_SLICE(b, 4), v1);                                        \
+            SIMD128_MAC(P, WASM_SLICE(b, 2), v2);                                        \
+            SIMD128_MAC(P, WASM_SLICE(b, 0), v3);                                        \
+        }
+
+                PROC_ROW(0, p0);
+                PROC_ROW(1, p1);
+                PROC_ROW(2, p2);
+                PROC_ROW(3, p3);
+    #undef PROC_ROW
+            }
+
+            acc0 = wasm_i32x4_add(acc0, wasm_i32x4_extadd_pairwise_i16x8(p0));
+            acc1 = wasm_i32x4_add(acc1, wasm_i32x4_extadd_pairwise_i16x8(p1));
+            acc2 = wasm_i32x4_add(acc2, wasm_i32x4_extadd_pairwise_i16x8(p2));
+            acc3 = wasm_i32x4_add(acc3, wasm_i32x4_extadd_pairwise_i16x8(p3));
+        }
+
+        *(float *)((char *)s + (row + 0) * bs) = (float)wasm_hsum_i32x4(acc0);
+        *(float *)((char *)s + (row + 1) * bs) = (float)wasm_hsum_i32x4(acc1);
+        *(float *)((char *)s + (row + 2) * bs) = (float)wasm_hsum_i32x4(acc2);
+        *(float *)((char *)s + (row + 3) * bs) = (float)wasm_hsum_i32x4(acc3);
+    }
+
+    /* Remaining rows */
+    for (; row < nrows; row++) {
+        v128_t acc = wasm_i32x4_splat(0);
+        const uint8_t * xr = x + (size_t)row * row_bytes;
+        for (int i = 0; i < nb; i++) {
+            const int8_t * py = y + i * WASM_QK_I2_S;
+            v128_t p = wasm_i16x8_splat(0);
+            for (int j = 0; j < 32; j += 16) {
+                const v128_t b = wasm_v128_load(xr + (size_t)i * 32 + j);
+                SIMD128_MAC(p, WASM_SLICE(b, 6), wasm_v128_load(py + j));
+                SIMD128_MAC(p, WASM_SLICE(b, 4), wasm_v128_load(py + 32 + j));
+                SIMD128_MAC(p, WASM_SLICE(b, 2), wasm_v128_load(py + 64 + j));
+                SIMD128_MAC(p, WASM_SLICE(b, 0), wasm_v128_load(py + 96 + j));
+            }
+            acc = wasm_i32x4_add(acc, wasm_i32x4_extadd_pairwise_i16x8(p));
+        }
+        *(float *)((char *)s + row * bs) = (float)wasm_hsum_i32x4(acc);
+    }
+}
+
+    #undef SIMD128_MAC
+
+/**
+ * SIMD128 vec_dot: same row addressing as the scalar reference
+ * (row stride bx / 4 bytes, results packed in s[0..nrc)).
+ */
+static void simd128_vec_dot_i2_i8(int n, float * s, size_t bs, const void * vx, size_t bx, const void * vy,
+                                  size_t by, int nrc) {
+    simd128_dot_rows(n, s, sizeof(float), (const uint8_t *)vx, bx / 4, (const int8_t *)vy, nrc);
+}
+
+/**
+ * SIMD128 gemv: nr contiguous rows of n/4 bytes, output stride bs.
+ */
+static void simd128_gemv_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
+    (void)nc;
+    simd128_dot_rows(n, s, bs, (const uint8_t *)vx, (size_t)(n / 4), (const int8_t *)vy, nr);
+}
+
+/**
+ * SIMD128 gemm: one vec_dot pass per activation column.
+ */
+static void simd128_gemm_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
+    const int8_t * y = (const int8_t *)vy;
+    for (int c = 0; c < nc; c++) {
+        simd128_dot_rows(n, (float *)((char *)s + c * bs), sizeof(float), (const uint8_t *)vx, (size_t)(n / 4),
+                         y + (size_t)c * n, nr);
+    }
+}
+
+/* ──────── Relaxed-SIMD kernels ─────────────────────────────────── */
+
+    #if defined(__wasm_relaxed_simd__)
+
+/* acc += dot4(act i8, codes i7) per i32 lane */
+        #define RELAXED_DOT(ACC, W, A) ACC = wasm_i32x4_relaxed_dot_i8x16_i7x16_add(A, W, ACC)
+
+/**
+ * Same contract as simd128_dot_rows(); each 16-byte chunk and slice is
+ * a single relaxed dot straight into the int32 accumulator.
+ */
+static void relaxed_dot_rows(int n, float * s, size_t bs, const uint8_t * x, size_t row_bytes, const int8_t * y,
+                             int nrows) {
+    const int nb = n / WASM_QK_I2_S;
+    const v128_t mask = wasm_i8x16_splat(0x03);
+
+    int row = 0;
+    for (; row + 4 <= nrows; row += 4) {
+        v128_t acc0 = wasm_i32x4_splat(0);
+        v128_t acc1 = acc0, acc2 = acc0, acc3 = acc0;
+        const uint8_t * x0 = x + (size_t)row * row_bytes;
+
+        for (int i = 0; i < nb; i++) {
+            const int8_t * py = y + i * WASM_QK_I2_S;
+            for (int j = 0; j < 32; j += 16) {
+                const v128_t v0 = wasm_v128_load(py + j);
+                const v128_t v1 = wasm_v128_load(py + 32 + j);
+                const v128_t v2 = wasm_v128_load(py + 64 + j);
+                const v128_t v3 = wasm_v128_load(py + 96 + j);
+
+        #define PROC_ROW(IDX, ACC)                                                           \
+            {                                                                                \
+                const v128_t b = wasm_v128_load(x0 + (IDX) * row_bytes + (size_t)i * 32 + j); \
+                RELAXED_DOT(ACC, WASM_SLICE(b, 6), v0);                                      \
+                RELAXED_DOT(ACC, WASM_SLICE(b, 4), v1);                                      \
+                RELAXED_DOT(ACC, WASM_SLICE(b, 2), v2);                                      \
+                RELAXED_DOT(ACC, WASM_SLICE(b, 0), v3);                                      \
+            }
+
+                PROC_ROW(0, acc0);
+                PROC_ROW(1, acc1);
+                PROC_ROW(2, acc2);
+                PROC_ROW(3, acc3);
+        #undef PROC_ROW
+            }
+        }
+
+        *(float *)((char *)s + (row + 0) * bs) = (float)wasm_hsum_i32x4(acc0);
+        *(float *)((char *)s + (row + 1) * bs) = (float)wasm_hsum_i32x4(acc1);
+        *(float *)((char *)s + (row + 2) * bs) = (float)wasm_hsum_i32x4(acc2);
+        *(float *)((char *)s + (row + 3) * bs) = (float)wasm_hsum_i32x4(acc3);
+    }
+
+    /* Remaining rows */
+    for (; row < nrows; row++) {
+        v128_t acc = wasm_i32x4_splat(0);
+        const uint8_t * xr = x + (size_t)row * row_bytes;
+        for (int i = 0; i < nb; i++) {
+            const int8_t * py = y + i * WASM_QK_I2_S;
+            for (int j = 0; j < 32; j += 16) {
+                const v128_t b = wasm_v128_load(xr + (size_t)i * 32 + j);
+                RELAXED_DOT(acc, WASM_SLICE(b, 6), wasm_v128_load(py + j));
+                RELAXED_DOT(acc, WASM_SLICE(b, 4), wasm_v128_load(py + 32 + j));
+                RELAXED_DOT(acc, WASM_SLICE(b, 2), wasm_v128_load(py + 64 + j));
+                RELAXED_DOT(acc, WASM_SLICE(b, 0), wasm_v128_load(py + 96 + j));
+            }
+        }
+        *(float *)((char *)s + row * bs) = (float)wasm_hsum_i32x4(acc);
+    }
+}
+
+        #undef RELAXED_DOT
+
+static void relaxed_vec_dot_i2_i8(int n, float * s, size_t bs, const void * vx, size_t bx, const void * vy,
+                                  size_t by, int nrc) {
+    relaxed_dot_rows(n, s, sizeof(float), (const uint8_t *)vx, bx / 4, (const int8_t *)vy, nrc);
+}
+
+static void relaxed_gemv_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
+    (void)nc;
+    relaxed_dot_rows(n, s, bs, (const uint8_t *)vx, (size_t)(n / 4), (const int8_t *)vy, nr);
+}
+
+static void relaxed_gemm_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
+    const int8_t * y = (const int8_t *)vy;
+    for (int c = 0; c < nc; c++) {
+        relaxed_dot_rows(n, (float *)((char *)s + c * bs), sizeof(float), (const uint8_t *)vx, (size_t)(n / 4),
+                         y + (size_t)c * n, nr);
+    }
+}
+
+    #endif /* __wasm_relaxed_simd__ */
+
+    #undef WASM_SLICE
+
+/* ──────── Backend descriptors ──────────────────────────────────── */
+
+const neuronos_backend_t neuronos_backend_wasm_simd128 = {
+    .name = "wasm_simd128",
+    .type = NEURONOS_BACKEND_WASM,
+    .priority = 30,
+    .required_features = NEURONOS_FEAT_WASM_SIMD,
+    .config =
+        {
+            .row_block_size = 4,
+            .col_block_size = 128,
+            .parallel_size = 4,
+            .qk_i2_s = WASM_QK_I2_S,
+        },
+    .vec_dot_i2_i8 = simd128_vec_dot_i2_i8,
+    .quantize_i2 = quantize_i2_s,
+    .gemv_i2_i8 = simd128_gemv_i2_i8,
+    .gemm_i2_i8 = simd128_gemm_i2_i8,
+    .init = NULL,
+    .shutdown = NULL,
+};
+
+    #if defined(__wasm_relaxed_simd__)
+const neuronos_backend_t neuronos_backend_wasm_relaxed_simd = {
+    .name = "wasm_relaxed_simd",
+    .type = NEURONOS_BACKEND_WASM_RELAXED,
+    .priority = 35, /* Above SIMD128: one dot instruction per 16 MACs */
+    .required_features = NEURONOS_FEAT_WASM_SIMD | NEURONOS_FEAT_WASM_RELAXED_SIMD,
+    .config =
+        {
+            .row_block_size = 4,
+            .col_block_size = 128,
+            .parallel_size = 4,
+            .qk_i2_s = WASM_QK_I2_S,
+        },
+    .vec_dot_i2_i8 = relaxed_vec_dot_i2_i8,
+    .quantize_i2 = quantize_i2_s,
+    .gemv_i2_i8 = relaxed_gemv_i2_i8,
+    .gemm_i2_i8 = relaxed_gemm_i2_i8,
+    .init = NULL,
+    .shutdown = NULL,
+};
+    #endif
+
+#endif /* __wasm_simd128__ */
@@ -7,6 +7,9 @@
  * layer — the actual SIMD code lives in ggml-bitnet-mad.cpp and
  * is called through the forward declarations below.
  *
+ * The exception is gemm: prefill batches go through a cache-blocked
+ * kernel here (see below) instead of one vec_dot pass per token.
+ *
  * Requirements: AVX2 + SSSE3 (for _mm256_maddubs_epi16)
  *
  * Compile with: -mavx2 -mssse3 (clang/gcc)
@@ -17,7 +20,9 @@
 
     #include "neuronos/neuronos_hal.h"
 
+    #include <immintrin.h>
     #include <stdint.h>
+    #include <stdlib.h>
 
 /* ──────── Forward declarations of existing kernel functions ─────── */
 
@@ -84,11 +89,135 @@ static void avx2_gemv_i2_i8(int n, float * s, size_t bs, const void * vx, const
     }
 }
 
+/* ──────── Blocked GEMM (prefill) ───────────────────────────────── */
+
+/*
+ * Weight rows are unpacked to u8 codes {0,1,2} one panel at a time;
+ * the panel is sized for L2 and then applied to every activation
+ * column, so each weight byte comes from DRAM once per call instead of
+ * once per token. Inside the panel a 4-row × 2-column micro-kernel
+ * keeps 8 accumulators in registers (maddubs u8 × s8 → s16 → s32).
+ */
+
+    #define X86_GEMM_PANEL_KB 256 /* default unpacked weight panel kept in L2 */
+    #define X86_GEMM_MR 4         /* micro-kernel rows */
+    #define X86_GEMM_KC 1024      /* 32 maddubs steps × 512 < INT16_MAX */
+
+static inline int hsum_i32_8(const __m256i a) {
+    const __m128i sum128 = _mm_add_epi32(_mm256_castsi256_si128(a), _mm256_extractf128_si256(a, 1));
+    const __m128i hi64 = _mm_unpackhi_epi64(sum128, sum128);
+    const __m128i sum64 = _mm_add_epi32(hi64, sum128);
+    const __m128i hi32 = _mm_shuffle_epi32(sum64, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_cvtsi128_si32(_mm_add_epi32(sum64, hi32));
+}
+
+/* Unpack one I2_S row (QK_I2_S = 128, 32 bytes per block) to n u8 codes */
+static void unpack_row_i2(uint8_t * dst, const uint8_t * x, int n) {
+    const __m256i mask = _mm256_set1_epi8(0x03);
+    for (int i = 0; i < n / 128; i++) {
+        const __m256i b = _mm256_loadu_si256((const __m256i *)(x + i * 32));
+        uint8_t * out = dst + i * 128;
+        _mm256_storeu_si256((__m256i *)(out + 0), _mm256_and_si256(_mm256_srli_epi16(b, 6), mask));
+        _mm256_storeu_si256((__m256i *)(out + 32), _mm256_and_si256(_mm256_srli_epi16(b, 4), mask));
+        _mm256_storeu_si256((__m256i *)(out + 64), _mm256_and_si256(_mm256_srli_epi16(b, 2), mask));
+        _mm256_storeu_si256((__m256i *)(out + 96), _mm256_and_si256(b, mask));
+    }
+}
+
+/* mr (≤ 4) panel rows × nc2 (1 or 2) columns, written at s + c * bs.
+ * Products are summed in 16 bits over X86_GEMM_KC elements and widened
+ * once per chunk, which saves the madd on every step. */
+static inline void gemm_micro(int n, const uint8_t * w, int mr, const int8_t * y, int nc2, float * s, size_t bs,
+                              int row) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i acc[X86_GEMM_MR][2];
+    for (int r = 0; r < X86_GEMM_MR; r++)
+        acc[r][0] = acc[r][1] = _mm256_setzero_si256();
+
+    const int8_t * y1 = nc2 > 1 ? y + n : y;
+    for (int k0 = 0; k0 < n; k0 += X86_GEMM_KC) {
+        const int k1 = n - k0 < X86_GEMM_KC ? n : k0 + X86_GEMM_KC;
+        __m256i sum[X86_GEMM_MR][2];
+        for (int r = 0; r < X86_GEMM_MR; r++)
+            sum[r][0] = sum[r][1] = _mm256_setzero_si256();
+
+        for (int k = k0; k < k1; k += 32) {
+            const __m256i a0 = _mm256_loadu_si256((const __m256i *)(y + k));
+            const __m256i a1 = _mm256_loadu_si256((const __m256i *)(y1 + k));
+            for (int r = 0; r < mr; r++) {
+                const __m256i b = _mm256_loadu_si256((const __m256i *)(w + (size_t)r * n + k));
+                sum[r][0] = _mm256_add_epi16(sum[r][0], _mm256_maddubs_epi16(b, a0));
+                sum[r][1] = _mm256_add_epi16(sum[r][1], _mm256_maddubs_epi16(b, a1));
+            }
+        }
+        for (int r = 0; r < mr; r++) {
+            acc[r][0] = _mm256_add_epi32(acc[r][0], _mm256_madd_epi16(sum[r][0], ones));
+            acc[r][1] = _mm256_add_epi32(acc[r][1], _mm256_madd_epi16(sum[r][1], ones));
+        }
+    }
+
+    for (int c = 0; c < nc2; c++) {
+        float * out = (float *)((char *)s + c * bs);
+        for (int r = 0; r < mr; r++)
+            out[row + r] = (float)hsum_i32_8(acc[r][c]);
+    }
+}
+
+/**
+ * x86 gemm: blocked kernel for nc > 1 (prefill), vec_dot path for a
+ * single column (decode). Output column c starts at (char *)s + c * bs.
+ * Also used by the AVX-VNNI and AVX-512 backends.
+ */
+void hal_x86_gemm_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
+    const uint8_t * x = (const uint8_t *)vx;
+    const int8_t * y = (const int8_t *)vy;
+    const size_t row_bytes = (size_t)(n / 4);
+
+    /* Panel height: as many whole micro-tiles as fit the L2 budget */
+    /* Panel size is the autotuned knob (hal_autotune.c) */
+    const neuronos_backend_t * active = neuronos_hal_get_active_backend();
+    const int panel_kb =
+        active && active->config.gemm_panel_kb > 0 ? active->config.gemm_panel_kb : X86_GEMM_PANEL_KB;
+    int mc = (int)((size_t)panel_kb * 1024 / (size_t)(n > 0 ? n : 1));
+    mc -= mc % X86_GEMM_MR;
+    if (mc < X86_GEMM_MR)
+        mc = X86_GEMM_MR;
+    if (mc > nr)
+        mc = nr;
+
+    uint8_t * panel = nc > 1 ? (uint8_t *)malloc((size_t)mc * n) : NULL;
+    if (!panel) {
+        for (int c = 0; c < nc; c++) {
+            avx2_gemv_i2_i8(n, (float *)((char *)s + c * bs), sizeof(float), vx, y + (size_t)c * n, nr, 1);
+        }
+        return;
+    }
+
+    for (int r0 = 0; r0 < nr; r0 += mc) {
+        const int rows = nr - r0 < mc ? nr - r0 : mc;
+        for (int r = 0; r < rows; r++)
+            unpack_row_i2(panel + (size_t)r * n, x + (size_t)(r0 + r) * row_bytes, n);
+
+        for (int c = 0; c < nc; c += 2) {
+            const int nc2 = nc - c < 2 ? nc - c : 2;
+            float * sc = (float *)((char *)s + c * bs);
+            for (int r = 0; r < rows; r += X86_GEMM_MR) {
+                const uint8_t * w = panel + (size_t)r * n;
+                if (rows - r >= X86_GEMM_MR) /* constant mr: accumulators stay in registers */
+                    gemm_micro(n, w, X86_GEMM_MR, y + (size_t)c * n, nc2, sc, bs, r0 + r);
+                else
+                    gemm_micro(n, w, rows - r, y + (size_t)c * n, nc2, sc, bs, r0 + r);
+            }
+        }
+    }
+    free(panel);
+}
+
 /**
- * AVX2 gemm: Uses vec_dot in a loop.
+ * AVX2 gemm: blocked for prefill batches, see hal_x86_gemm_i2_i8.
  */
 static void avx2_gemm_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc) {
-    avx2_gemv_i2_i8(n, s, bs, vx, vy, nr, nc);
+    hal_x86_gemm_i2_i8(n, s, bs, vx, vy, nr, nc);
 }
 
 /* ──────── Backend descriptor ───────────────────────────────────── */
@@ -111,6 +240,7 @@ const neuronos_backend_t neuronos_backend_x86_avx2 = {
             .col_block_size = 128,
             .parallel_size = 4,
             .qk_i2_s = 128,
+            .gemm_panel_kb = X86_GEMM_PANEL_KB,
         },
     .vec_dot_i2_i8 = avx2_vec_dot_i2_i8,
     .quantize_i2 = avx2_quantize_i2,
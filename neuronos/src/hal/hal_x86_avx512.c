@@ -0,0 +1,162 @@
+/**
+ * @file hal_x86_avx512.c
+ * @brief NeuronOS HAL — x86 AVX-512 VNNI backend
+ *
+ * Same I2_S layout and raw u2 × s8 sums as the scalar reference and
+ * the AVX-VNNI backend, on 512-bit registers: each zmm holds the 32
+ * packed weight bytes of two adjacent QK_I2_S blocks, so one VPDPBUSD
+ * covers 64 weights. Eight rows share every activation load.
+ *
+ * Requirements: AVX-512F + AVX-512BW + AVX-512 VNNI. Every CPU with
+ * AVX512-VNNI (Cascade Lake, Ice Lake, Sapphire Rapids, Zen 4) also
+ * has BW, so the registry only checks F and VNNI.
+ *
+ * Compile with: -mavx512f -mavx512bw -mavx512vnni (clang/gcc)
+ */
+
+#include "neuronos/neuronos_hal.h"
+#include <immintrin.h>
+#include <stdint.h>
+#include <string.h>
+
+extern size_t quantize_i2_s(const float * src, void * dst, int64_t nrow, int64_t n_per_row, const float * quant_weights);
+
+/* Blocked prefill GEMM (hal_x86_avx2.c) */
+extern void hal_x86_gemm_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc);
+
+/* Activations of blocks i and i+1 for one 2-bit slice: [block i | block i+1] */
+static inline __m512i load_act_pair(const int8_t * py, int off) {
+    __m512i v = _mm512_castsi256_si512(_mm256_loadu_si256((const __m256i*)(py + off)));
+    return _mm512_inserti64x4(v, _mm256_loadu_si256((const __m256i*)(py + 128 + off)), 1);
+}
+
+/* Single trailing block, upper half zeroed so it adds nothing */
+static inline __m512i load_act_tail(const int8_t * py, int off) {
+    return _mm512_zextsi256_si512(_mm256_loadu_si256((const __m256i*)(py + off)));
+}
+
+static void avx512_vec_dot_i2_i8(int n, float * s, size_t bs, const void * vx, size_t bx, const void * vy, size_t by, int nrc) {
+    const uint8_t * x = (const uint8_t *)vx;
+    const int8_t  * y = (const int8_t *)vy;
+    const int qk = 128;
+    const int nb = n / qk;
+
+    const __m512i mask = _mm512_set1_epi8(0x03);
+
+#define DOT_SLICES(ACC, B, V0, V1, V2, V3) \
+    { \
+        ACC = _mm512_dpbusd_epi32(ACC, _mm512_and_si512(_mm512_srli_epi16(B, 6), mask), V0); \
+        ACC = _mm512_dpbusd_epi32(ACC, _mm512_and_si512(_mm512_srli_epi16(B, 4), mask), V1); \
+        ACC = _mm512_dpbusd_epi32(ACC, _mm512_and_si512(_mm512_srli_epi16(B, 2), mask), V2); \
+        ACC = _mm512_dpbusd_epi32(ACC, _mm512_and_si512(B, mask), V3); \
+    }
+
+    int row = 0;
+    // 8 rows per pass: 8 accumulators + 4 activation registers stay resident
+    for (; row <= nrc - 8; row += 8) {
+        __m512i acc0 = _mm512_setzero_si512();
+        __m512i acc1 = _mm512_setzero_si512();
+        __m512i acc2 = _mm512_setzero_si512();
+        __m512i acc3 = _mm512_setzero_si512();
+        __m512i acc4 = _mm512_setzero_si512();
+        __m512i acc5 = _mm512_setzero_si512();
+        __m512i acc6 = _mm512_setzero_si512();
+        __m512i acc7 = _mm512_setzero_si512();
+
+        const uint8_t * x_base = x + (row * bx / 4);
+
+        int i = 0;
+        for (; i + 1 < nb; i += 2) {
+            const int8_t * py = y + i * 128;
+            _mm_prefetch((const char*)(py + 256), _MM_HINT_T0);
+
+            __m512i v0 = load_act_pair(py, 0);
+            __m512i v1 = load_act_pair(py, 32);
+            __m512i v2 = load_act_pair(py, 64);
+            __m512i v3 = load_act_pair(py, 96);
+
+#define PROC_ROW(IDX, ACC) \
+            { \
+                __m512i b = _mm512_loadu_si512((const void*)(x_base + (IDX * bx / 4) + i * 32)); \
+                DOT_SLICES(ACC, b, v0, v1, v2, v3); \
+            }
+
+            PROC_ROW(0, acc0); PROC_ROW(1, acc1);
+            PROC_ROW(2, acc2); PROC_ROW(3, acc3);
+            PROC_ROW(4, acc4); PROC_ROW(5, acc5);
+            PROC_ROW(6, acc6); PROC_ROW(7, acc7);
+#undef PROC_ROW
+        }
+
+        if (i < nb) {
+            const int8_t * py = y + i * 128;
+            __m512i v0 = load_act_tail(py, 0);
+            __m512i v1 = load_act_tail(py, 32);
+            __m512i v2 = load_act_tail(py, 64);
+            __m512i v3 = load_act_tail(py, 96);
+
+#define PROC_ROW(IDX, ACC) \
+            { \
+                __m512i b = _mm512_zextsi256_si512( \
+                    _mm256_loadu_si256((const __m256i*)(x_base + (IDX * bx / 4) + i * 32))); \
+                DOT_SLICES(ACC, b, v0, v1, v2, v3); \
+            }
+
+            PROC_ROW(0, acc0); PROC_ROW(1, acc1);
+            PROC_ROW(2, acc2); PROC_ROW(3, acc3);
+            PROC_ROW(4, acc4); PROC_ROW(5, acc5);
+            PROC_ROW(6, acc6); PROC_ROW(7, acc7);
+#undef PROC_ROW
+        }
+
+        s[row+0] = (float)_mm512_reduce_add_epi32(acc0);
+        s[row+1] = (float)_mm512_reduce_add_epi32(acc1);
+        s[row+2] = (float)_mm512_reduce_add_epi32(acc2);
+        s[row+3] = (float)_mm512_reduce_add_epi32(acc3);
+        s[row+4] = (float)_mm512_reduce_add_epi32(acc4);
+        s[row+5] = (float)_mm512_reduce_add_epi32(acc5);
+        s[row+6] = (float)_mm512_reduce_add_epi32(acc6);
+        s[row+7] = (float)_mm512_reduce_add_epi32(acc7);
+    }
+
+    // Fallback for remaining rows
+    for (; row < nrc; row++) {
+        __m512i acc0 = _mm512_setzero_si512();
+        const uint8_t * x_row = x + (row * bx / 4);
+        int i = 0;
+        for (; i + 1 < nb; i += 2) {
+            const int8_t * py = y + i * 128;
+            __m512i b0 = _mm512_loadu_si512((const void*)(x_row + i * 32));
+            DOT_SLICES(acc0, b0, load_act_pair(py, 0), load_act_pair(py, 32), load_act_pair(py, 64),
+                       load_act_pair(py, 96));
+        }
+        if (i < nb) {
+            const int8_t * py = y + i * 128;
+            __m512i b0 = _mm512_zextsi256_si512(_mm256_loadu_si256((const __m256i*)(x_row + i * 32)));
+            DOT_SLICES(acc0, b0, load_act_tail(py, 0), load_act_tail(py, 32), load_act_tail(py, 64),
+                       load_act_tail(py, 96));
+        }
+        s[row] = (float)_mm512_reduce_add_epi32(acc0);
+    }
+#undef DOT_SLICES
+}
+
+const neuronos_backend_t neuronos_backend_x86_avx512 = {
+    .name = "x86_avx512",
+    .type = NEURONOS_BACKEND_X86_AVX512,
+    .priority = 90, /* Above AVX-VNNI (75): twice the weights per instruction */
+    .required_features = NEURONOS_FEAT_AVX2 | NEURONOS_FEAT_AVX512F | NEURONOS_FEAT_AVX512VNNI,
+    .config = {
+        .row_block_size = 8,
+        .col_block_size = 256, /* two QK_I2_S blocks per zmm */
+        .parallel_size = 8,
+        .qk_i2_s = 128,
+        .gemm_panel_kb = 256, /* blocked gemm default; autotuned */
+    },
+    .vec_dot_i2_i8 = avx512_vec_dot_i2_i8,
+    .quantize_i2 = quantize_i2_s,
+    .gemv_i2_i8 = NULL,
+    .gemm_i2_i8 = hal_x86_gemm_i2_i8,
+    .init = NULL,
+    .shutdown = NULL,
+};
@@ -11,6 +11,9 @@
 
 extern size_t quantize_i2_s(const float * src, void * dst, int64_t nrow, int64_t n_per_row, const float * quant_weights);
 
+/* Blocked prefill GEMM (hal_x86_avx2.c) */
+extern void hal_x86_gemm_i2_i8(int n, float * s, size_t bs, const void * vx, const void * vy, int nr, int nc);
+
 static inline int hsum_i32_8(const __m256i a) {
     const __m128i sum128 = _mm_add_epi32(_mm256_castsi256_si128(a), _mm256_extractf128_si256(a, 1));
     const __m128i hi64 = _mm_unpackhi_epi64(sum128, sum128);
@@ -25,7 +28,6 @@ static void avxvnni_vec_dot_i2_i8(int n, float * s, size_t bs, const void * vx,
     const int qk = 128;
     const int nb = n / qk;
 
-    __m256i ones = _mm256_set1_epi8(1);
     __m256i mask = _mm256_set1_epi8(0x03);
 
     int row = 0;
@@ -40,8 +42,6 @@ static void avxvnni_vec_dot_i2_i8(int n, float * s, size_t bs, const void * vx,
         __m256i acc6 = _mm256_setzero_si256();
         __m256i acc7 = _mm256_setzero_si256();
 
-        __m256i sum_y = _mm256_setzero_si256();
-
         const uint8_t * x_base = x + (row * bx / 4);
 
         for (int i = 0; i < nb; i++) {
@@ -53,11 +53,6 @@ static void avxvnni_vec_dot_i2_i8(int n, float * s, size_t bs, const void * vx,
             __m256i v2 = _mm256_loadu_si256((const __m256i*)(py + 64));
             __m256i v3 = _mm256_loadu_si256((const __m256i*)(py + 96));
 
-            sum_y = _mm256_add_epi32(sum_y, _mm256_madd_epi16(_mm256_maddubs_epi16(ones, v0), ones));
-            sum_y = _mm256_add_epi32(sum_y, _mm256_madd_epi16(_mm256_maddubs_epi16(ones, v1), ones));
-            sum_y = _mm256_add_epi32(sum_y, _mm256_madd_epi16(_mm256_maddubs_epi16(ones, v2), ones));
-            sum_y = _mm256_add_epi32(sum_y, _mm256_madd_epi16(_mm256_maddubs_epi16(ones, v3), ones));
-
 #define PROC_ROW(IDX, ACC) \
             { \
                 __m256i b = _mm256_loadu_si256((const __m256i*)(x_base + (IDX * bx / 4) + i * 32)); \
@@ -74,21 +69,20 @@ static void avxvnni_vec_dot_i2_i8(int n, float * s, size_t bs, const void * vx,
 #undef PROC_ROW
         }
 
-        int sy = hsum_i32_8(sum_y);
-        s[row+0] = (float)(hsum_i32_8(acc0) - sy);
-        s[row+1] = (float)(hsum_i32_8(acc1) - sy);
-        s[row+2] = (float)(hsum_i32_8(acc2) - sy);
-        s[row+3] = (float)(hsum_i32_8(acc3) - sy);
-        s[row+4] = (float)(hsum_i32_8(acc4) - sy);
-        s[row+5] = (float)(hsum_i32_8(acc5) - sy);
-        s[row+6] = (float)(hsum_i32_8(acc6) - sy);
-        s[row+7] = (float)(hsum_i32_8(acc7) - sy);
+        /* Raw u2 × s8 sums, same as the scalar reference and ggml_vec_dot_i2_i8_s */
+        s[row+0] = (float)hsum_i32_8(acc0);
+        s[row+1] = (float)hsum_i32_8(acc1);
+        s[row+2] = (float)hsum_i32_8(acc2);
+        s[row+3] = (float)hsum_i32_8(acc3);
+        s[row+4] = (float)hsum_i32_8(acc4);
+        s[row+5] = (float)hsum_i32_8(acc5);
+        s[row+6] = (float)hsum_i32_8(acc6);
+        s[row+7] = (float)hsum_i32_8(acc7);
     }
 
     // Fallback for remaining rows
     for (; row < nrc; row++) {
         __m256i acc0 = _mm256_setzero_si256();
-        __m256i sum_y = _mm256_setzero_si256();
         const uint8_t * x_row = x + (row * bx / 4);
         for (int i = 0; i < nb; i++) {
             const int8_t * py = y + i * 128;
@@ -96,17 +90,13 @@ static void avxvnni_vec_dot_i2_i8(int n, float * s, size_t bs, const void * vx,
             __m256i v1 = _mm256_loadu_si256((const __m256i*)(py + 32));
             __m256i v2 = _mm256_loadu_si256((const __m256i*)(py + 64));
             __m256i v3 = _mm256_loadu_si256((const __m256i*)(py + 96));
-            sum_y = _mm256_add_epi32(sum_y, _mm256_madd_epi16(_mm256_maddubs_epi16(ones, v0), ones));
-            sum_y = _mm256_add_epi32(sum_y, _mm256_madd_epi16(_mm256_maddubs_epi16(ones, v1), ones));
-            sum_y = _mm256_add_epi32(sum_y, _mm256_madd_epi16(_mm256_maddubs_epi16(ones, v2), ones));
-            sum_y = _mm256_add_epi32(sum_y, _mm256_madd_epi16(_mm256_maddubs_epi16(ones, v3), ones));
             __m256i b0 = _mm256_loadu_si256((const __m256i*)(x_row + i * 32));
             acc0 = _mm256_dpbusd_epi32(acc0, _mm256_and_si256(_mm256_srli_epi16(b0, 6), mask), v0);
             acc0 = _mm256_dpbusd_epi32(acc0, _mm256_and_si256(_mm256_srli_epi16(b0, 4), mask), v1);
             acc0 = _mm256_dpbusd_epi32(acc0, _mm256_and_si256(_mm256_srli_epi16(b0, 2), mask), v2);
             acc0 = _mm256_dpbusd_epi32(acc0, _mm256_and_si256(b0, mask), v3);
         }
-        s[row] = (float)(hsum_i32_8(acc0) - hsum_i32_8(sum_y));
+        s[row] = (float)hsum_i32_8(acc0);
     }
 }
 
@@ -120,11 +110,12 @@ const neuronos_backend_t neuronos_backend_x86_avxvnni = {
         .col_block_size = 128,
         .parallel_size = 8,
         .qk_i2_s = 128,
+        .gemm_panel_kb = 256, /* blocked gemm default; autotuned */
     },
     .vec_dot_i2_i8 = avxvnni_vec_dot_i2_i8,
     .quantize_i2 = quantize_i2_s,
     .gemv_i2_i8 = NULL,
-    .gemm_i2_i8 = NULL,
+    .gemm_i2_i8 = hal_x86_gemm_i2_i8,
     .init = NULL,
     .shutdown = NULL,
 };
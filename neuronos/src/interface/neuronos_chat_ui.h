@@ -4,8 +4,1282 @@
 #ifndef NEURONOS_CHAT_UI_DATA_H
 #define NEURONOS_CHAT_UI_DATA_H
 
+static const unsigned char neuronos_chat_ui_html[] = {
+  0x3c,0x21,0x44,0x4f,0x43,0x54,0x59,0x50,0x45,0x20,0x68,0x74,0x6d,0x6c,0x3e,0x0a,
+  0x3c,0x68,0x74,0x6d,0x6c,0x20,0x6c,0x61,0x6e,0x67,0x3d,0x22,0x65,0x6e,0x22,0x3e,
+  0x0a,0x3c,0x68,0x65,0x61,0x64,0x3e,0x0a,0x3c,0x6d,0x65,0x74,0x61,0x20,0x63,0x68,
+  0x61,0x72,0x73,0x65,0x74,0x3d,0x22,0x55,0x54,0x46,0x2d,0x38,0x22,0x3e,0x0a,0x3c,
+  0x6d,0x65,0x74,0x61,0x20,0x6e,0x61,0x6d,0x65,0x3d,0x22,0x76,0x69,0x65,0x77,0x70,
+  0x6f,0x72,0x74,0x22,0x20,0x63,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x3d,0x22,0x77,0x69,
+  0x64,0x74,0x68,0x3d,0x64,0x65,0x76,0x69,0x63,0x65,0x2d,0x77,0x69,0x64,0x74,0x68,
+  0x2c,0x69,0x6e,0x69,0x74,0x69,0x61,0x6c,0x2d,0x73,0x63,0x61,0x6c,0x65,0x3d,0x31,
+  0x2e,0x30,0x22,0x3e,0x0a,0x3c,0x74,0x69,0x74,0x6c,0x65,0x3e,0x4e,0x65,0x75,0x72,
+  0x6f,0x6e,0x4f,0x53,0x3c,0x2f,0x74,0x69,0x74,0x6c,0x65,0x3e,0x0a,0x3c,0x6c,0x69,
+  0x6e,0x6b,0x20,0x72,0x65,0x6c,0x3d,0x22,0x69,0x63,0x6f,0x6e,0x22,0x20,0x68,0x72,
+  0x65,0x66,0x3d,0x22,0x64,0x61,0x74,0x61,0x3a,0x69,0x6d,0x61,0x67,0x65,0x2f,0x73,
+  0x76,0x67,0x2b,0x78,0x6d,0x6c,0x2c,0x3c,0x73,0x76,0x67,0x20,0x78,0x6d,0x6c,0x6e,
+  0x73,0x3d,0x27,0x68,0x74,0x74,0x70,0x3a,0x2f,0x2f,0x77,0x77,0x77,0x2e,0x77,0x33,
+  0x2e,0x6f,0x72,0x67,0x2f,0x32,0x30,0x30,0x30,0x2f,0x73,0x76,0x67,0x27,0x20,0x76,
+  0x69,0x65,0x77,0x42,0x6f,0x78,0x3d,0x27,0x30,0x20,0x30,0x20,0x31,0x30,0x30,0x20,
+  0x31,0x30,0x30,0x27,0x3e,0x3c,0x74,0x65,0x78,0x74,0x20,0x79,0x3d,0x27,0x2e,0x39,
+  0x65,0x6d,0x27,0x20,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,0x7a,0x65,0x3d,0x27,0x39,
+  0x30,0x27,0x3e,0xe2,0x9a,0xa1,0x3c,0x2f,0x74,0x65,0x78,0x74,0x3e,0x3c,0x2f,0x73,
+  0x76,0x67,0x3e,0x22,0x3e,0x0a,0x3c,0x73,0x74,0x79,0x6c,0x65,0x3e,0x0a,0x2f,0x2a,
+  0x20,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,
+  0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,
+  0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,
+  0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0x0a,0x20,0x20,0x20,0x4e,0x65,0x75,0x72,0x6f,0x6e,0x4f,0x53,0x20,0x43,
+  0x68,0x61,0x74,0x20,0x55,0x49,0x20,0xe2,0x80,0x94,0x20,0x50,0x72,0x65,0x6d,0x69,
+  0x75,0x6d,0x20,0x56,0x61,0x6e,0x69,0x6c,0x6c,0x61,0x20,0x43,0x53,0x53,0x0a,0x20,
+  0x20,0x20,0x44,0x61,0x72,0x6b,0x20,0x74,0x68,0x65,0x6d,0x65,0x20,0xc2,0xb7,0x20,
+  0x4d,0x6f,0x6e,0x6f,0x73,0x70,0x61,0x63,0x65,0x20,0xc2,0xb7,0x20,0x41,0x67,0x65,
+  0x6e,0x74,0x2d,0x66,0x69,0x72,0x73,0x74,0x20,0x64,0x65,0x73,0x69,0x67,0x6e,0x0a,
+  0x20,0x20,0x20,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,
+  0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,
+  0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,
+  0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,
+  0x90,0xe2,0x95,0x90,0x20,0x2a,0x2f,0x0a,0x2a,0x2c,0x2a,0x3a,0x3a,0x62,0x65,0x66,
+  0x6f,0x72,0x65,0x2c,0x2a,0x3a,0x3a,0x61,0x66,0x74,0x65,0x72,0x7b,0x6d,0x61,0x72,
+  0x67,0x69,0x6e,0x3a,0x30,0x3b,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x30,0x3b,
+  0x62,0x6f,0x78,0x2d,0x73,0x69,0x7a,0x69,0x6e,0x67,0x3a,0x62,0x6f,0x72,0x64,0x65,
+  0x72,0x2d,0x62,0x6f,0x78,0x7d,0x0a,0x0a,0x3a,0x72,0x6f,0x6f,0x74,0x20,0x7b,0x0a,
+  0x20,0x20,0x2d,0x2d,0x62,0x67,0x3a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x23,
+  0x30,0x39,0x30,0x39,0x30,0x62,0x3b,0x0a,0x20,0x20,0x2d,0x2d,0x73,0x75,0x72,0x66,
+  0x61,0x63,0x65,0x3a,0x20,0x20,0x20,0x23,0x30,0x66,0x30,0x66,0x31,0x33,0x3b,0x0a,
+  0x20,0x20,0x2d,0x2d,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x32,0x3a,0x20,0x20,0x23,
+  0x31,0x36,0x31,0x36,0x31,0x64,0x3b,0x0a,0x20,0x20,0x2d,0x2d,0x62,0x6f,0x72,0x64,
+  0x65,0x72,0x3a,0x20,0x20,0x20,0x20,0x23,0x31,0x65,0x31,0x65,0x32,0x61,0x3b,0x0a,
+  0x20,0x20,0x2d,0x2d,0x62,0x6f,0x72,0x64,0x65,0x72,0x32,0x3a,0x20,0x20,0x20,0x23,
+  0x32,0x61,0x32,0x61,0x33,0x61,0x3b,0x0a,0x20,0x20,0x2d,0x2d,0x74,0x65,0x78,0x74,
+  0x3a,0x20,0x20,0x20,0x20,0x20,0x20,0x23,0x65,0x34,0x65,0x34,0x65,0x37,0x3b,0x0a,
+  0x20,0x20,0x2d,0x2d,0x74,0x65,0x78,0x74,0x2d,0x64,0x69,0x6d,0x3a,0x20,0x20,0x23,
+  0x37,0x31,0x37,0x31,0x37,0x61,0x3b,0x0a,0x20,0x20,0x2d,0x2d,0x74,0x65,0x78,0x74,
+  0x2d,0x6d,0x75,0x74,0x65,0x64,0x3a,0x23,0x35,0x32,0x35,0x32,0x35,0x62,0x3b,0x0a,
+  0x20,0x20,0x2d,0x2d,0x61,0x63,0x63,0x65,0x6e,0x74,0x3a,0x20,0x20,0x20,0x20,0x23,
+  0x30,0x36,0x62,0x36,0x64,0x34,0x3b,0x0a,0x20,0x20,0x2d,0x2d,0x61,0x63,0x63,0x65,
+  0x6e,0x74,0x2d,0x64,0x69,0x6d,0x3a,0x23,0x30,0x65,0x37,0x34,0x39,0x30,0x3b,0x0a,
+  0x20,0x20,0x2d,0x2d,0x61,0x63,0x63,0x65,0x6e,0x74,0x2d,0x62,0x67,0x3a,0x20,0x72,
+  0x67,0x62,0x61,0x28,0x36,0x2c,0x31,0x38,0x32,0x2c,0x32,0x31,0x32,0x2c,0x30,0x2e,
+  0x30,0x38,0x29,0x3b,0x0a,0x20,0x20,0x2d,0x2d,0x75,0x73,0x65,0x72,0x2d,0x62,0x67,
+  0x3a,0x20,0x20,0x20,0x23,0x31,0x37,0x32,0x35,0x35,0x34,0x3b,0x0a,0x20,0x20,0x2d,
+  0x2d,0x75,0x73,0x65,0x72,0x2d,0x62,0x6f,0x72,0x64,0x65,0x72,0x3a,0x23,0x31,0x65,
+  0x33,0x61,0x35,0x66,0x3b,0x0a,0x20,0x20,0x2d,0x2d,0x62,0x6f,0x74,0x2d,0x62,0x67,
+  0x3a,0x20,0x20,0x20,0x20,0x23,0x31,0x31,0x31,0x31,0x31,0x38,0x3b,0x0a,0x20,0x20,
+  0x2d,0x2d,0x62,0x6f,0x74,0x2d,0x62,0x6f,0x72,0x64,0x65,0x72,0x3a,0x23,0x31,0x63,
+  0x31,0x63,0x32,0x65,0x3b,0x0a,0x20,0x20,0x2d,0x2d,0x67,0x72,0x65,0x65,0x6e,0x3a,
+  0x20,0x20,0x20,0x20,0x20,0x23,0x32,0x32,0x63,0x35,0x35,0x65,0x3b,0x0a,0x20,0x20,
+  0x2d,0x2d,0x79,0x65,0x6c,0x6c,0x6f,0x77,0x3a,0x20,0x20,0x20,0x20,0x23,0x65,0x61,
+  0x62,0x33,0x30,0x38,0x3b,0x0a,0x20,0x20,0x2d,0x2d,0x72,0x65,0x64,0x3a,0x20,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x23,0x65,0x66,0x34,0x34,0x34,0x34,0x3b,0x0a,0x20,0x20,
+  0x2d,0x2d,0x6f,0x72,0x61,0x6e,0x67,0x65,0x3a,0x20,0x20,0x20,0x20,0x23,0x66,0x39,
+  0x37,0x33,0x31,0x36,0x3b,0x0a,0x20,0x20,0x2d,0x2d,0x70,0x75,0x72,0x70,0x6c,0x65,
+  0x3a,0x20,0x20,0x20,0x20,0x23,0x61,0x38,0x35,0x35,0x66,0x37,0x3b,0x0a,0x20,0x20,
+  0x2d,0x2d,0x72,0x61,0x64,0x69,0x75,0x73,0x3a,0x20,0x20,0x20,0x20,0x31,0x32,0x70,
+  0x78,0x3b,0x0a,0x20,0x20,0x2d,0x2d,0x72,0x61,0x64,0x69,0x75,0x73,0x2d,0x73,0x6d,
+  0x3a,0x20,0x38,0x70,0x78,0x3b,0x0a,0x20,0x20,0x2d,0x2d,0x66,0x6f,0x6e,0x74,0x2d,
+  0x6d,0x6f,0x6e,0x6f,0x3a,0x20,0x27,0x53,0x46,0x20,0x4d,0x6f,0x6e,0x6f,0x27,0x2c,
+  0x27,0x4a,0x65,0x74,0x42,0x72,0x61,0x69,0x6e,0x73,0x20,0x4d,0x6f,0x6e,0x6f,0x27,
+  0x2c,0x27,0x46,0x69,0x72,0x61,0x20,0x43,0x6f,0x64,0x65,0x27,0x2c,0x27,0x43,0x61,
+  0x73,0x63,0x61,0x64,0x69,0x61,0x20,0x43,0x6f,0x64,0x65,0x27,0x2c,0x27,0x43,0x6f,
+  0x6e,0x73,0x6f,0x6c,0x61,0x73,0x27,0x2c,0x6d,0x6f,0x6e,0x6f,0x73,0x70,0x61,0x63,
+  0x65,0x3b,0x0a,0x20,0x20,0x2d,0x2d,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x61,0x6e,0x73,
+  0x3a,0x20,0x27,0x49,0x6e,0x74,0x65,0x72,0x27,0x2c,0x27,0x53,0x46,0x20,0x50,0x72,
+  0x6f,0x20,0x44,0x69,0x73,0x70,0x6c,0x61,0x79,0x27,0x2c,0x2d,0x61,0x70,0x70,0x6c,
+  0x65,0x2d,0x73,0x79,0x73,0x74,0x65,0x6d,0x2c,0x42,0x6c,0x69,0x6e,0x6b,0x4d,0x61,
+  0x63,0x53,0x79,0x73,0x74,0x65,0x6d,0x46,0x6f,0x6e,0x74,0x2c,0x27,0x53,0x65,0x67,
+  0x6f,0x65,0x20,0x55,0x49,0x27,0x2c,0x52,0x6f,0x62,0x6f,0x74,0x6f,0x2c,0x73,0x61,
+  0x6e,0x73,0x2d,0x73,0x65,0x72,0x69,0x66,0x3b,0x0a,0x20,0x20,0x2d,0x2d,0x73,0x68,
+  0x61,0x64,0x6f,0x77,0x3a,0x20,0x20,0x20,0x20,0x30,0x20,0x31,0x70,0x78,0x20,0x33,
+  0x70,0x78,0x20,0x72,0x67,0x62,0x61,0x28,0x30,0x2c,0x30,0x2c,0x30,0x2c,0x30,0x2e,
+  0x34,0x29,0x3b,0x0a,0x20,0x20,0x2d,0x2d,0x74,0x72,0x61,0x6e,0x73,0x69,0x74,0x69,
+  0x6f,0x6e,0x3a,0x31,0x35,0x30,0x6d,0x73,0x20,0x63,0x75,0x62,0x69,0x63,0x2d,0x62,
+  0x65,0x7a,0x69,0x65,0x72,0x28,0x30,0x2e,0x34,0x2c,0x30,0x2c,0x30,0x2e,0x32,0x2c,
+  0x31,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x68,0x74,0x6d,0x6c,0x2c,0x62,0x6f,0x64,0x79,
+  0x20,0x7b,0x0a,0x20,0x20,0x68,0x65,0x69,0x67,0x68,0x74,0x3a,0x31,0x30,0x30,0x25,
+  0x3b,0x66,0x6f,0x6e,0x74,0x2d,0x66,0x61,0x6d,0x69,0x6c,0x79,0x3a,0x76,0x61,0x72,
+  0x28,0x2d,0x2d,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x61,0x6e,0x73,0x29,0x3b,0x62,0x61,
+  0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x62,
+  0x67,0x29,0x3b,0x0a,0x20,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,
+  0x2d,0x2d,0x74,0x65,0x78,0x74,0x29,0x3b,0x6f,0x76,0x65,0x72,0x66,0x6c,0x6f,0x77,
+  0x3a,0x68,0x69,0x64,0x64,0x65,0x6e,0x3b,0x2d,0x77,0x65,0x62,0x6b,0x69,0x74,0x2d,
+  0x66,0x6f,0x6e,0x74,0x2d,0x73,0x6d,0x6f,0x6f,0x74,0x68,0x69,0x6e,0x67,0x3a,0x61,
+  0x6e,0x74,0x69,0x61,0x6c,0x69,0x61,0x73,0x65,0x64,0x3b,0x0a,0x7d,0x0a,0x0a,0x62,
+  0x6f,0x64,0x79,0x20,0x7b,0x64,0x69,0x73,0x70,0x6c,0x61,0x79,0x3a,0x66,0x6c,0x65,
+  0x78,0x3b,0x66,0x6c,0x65,0x78,0x2d,0x64,0x69,0x72,0x65,0x63,0x74,0x69,0x6f,0x6e,
+  0x3a,0x63,0x6f,0x6c,0x75,0x6d,0x6e,0x7d,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,0x94,0x80,
+  0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x48,0x65,0x61,0x64,0x65,0x72,0x20,0xe2,0x94,
+  0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x2a,0x2f,0x0a,0x2e,0x68,0x65,0x61,0x64,
+  0x65,0x72,0x20,0x7b,0x0a,0x20,0x20,0x64,0x69,0x73,0x70,0x6c,0x61,0x79,0x3a,0x66,
+  0x6c,0x65,0x78,0x3b,0x61,0x6c,0x69,0x67,0x6e,0x2d,0x69,0x74,0x65,0x6d,0x73,0x3a,
+  0x63,0x65,0x6e,0x74,0x65,0x72,0x3b,0x67,0x61,0x70,0x3a,0x31,0x32,0x70,0x78,0x3b,
+  0x0a,0x20,0x20,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x31,0x32,0x70,0x78,0x20,
+  0x32,0x30,0x70,0x78,0x3b,0x62,0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,
+  0x76,0x61,0x72,0x28,0x2d,0x2d,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x29,0x3b,0x0a,
+  0x20,0x20,0x62,0x6f,0x72,0x64,0x65,0x72,0x2d,0x62,0x6f,0x74,0x74,0x6f,0x6d,0x3a,
+  0x31,0x70,0x78,0x20,0x73,0x6f,0x6c,0x69,0x64,0x20,0x76,0x61,0x72,0x28,0x2d,0x2d,
+  0x62,0x6f,0x72,0x64,0x65,0x72,0x29,0x3b,0x66,0x6c,0x65,0x78,0x2d,0x73,0x68,0x72,
+  0x69,0x6e,0x6b,0x3a,0x30,0x3b,0x0a,0x20,0x20,0x7a,0x2d,0x69,0x6e,0x64,0x65,0x78,
+  0x3a,0x31,0x30,0x3b,0x0a,0x7d,0x0a,0x2e,0x68,0x65,0x61,0x64,0x65,0x72,0x2d,0x6c,
+  0x6f,0x67,0x6f,0x20,0x7b,0x0a,0x20,0x20,0x64,0x69,0x73,0x70,0x6c,0x61,0x79,0x3a,
+  0x66,0x6c,0x65,0x78,0x3b,0x61,0x6c,0x69,0x67,0x6e,0x2d,0x69,0x74,0x65,0x6d,0x73,
+  0x3a,0x63,0x65,0x6e,0x74,0x65,0x72,0x3b,0x67,0x61,0x70,0x3a,0x38,0x70,0x78,0x3b,
+  0x0a,0x20,0x20,0x66,0x6f,0x6e,0x74,0x2d,0x77,0x65,0x69,0x67,0x68,0x74,0x3a,0x37,
+  0x30,0x30,0x3b,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,0x7a,0x65,0x3a,0x31,0x36,0x70,
+  0x78,0x3b,0x6c,0x65,0x74,0x74,0x65,0x72,0x2d,0x73,0x70,0x61,0x63,0x69,0x6e,0x67,
+  0x3a,0x2d,0x30,0x2e,0x30,0x32,0x65,0x6d,0x3b,0x0a,0x7d,0x0a,0x2e,0x68,0x65,0x61,
+  0x64,0x65,0x72,0x2d,0x6c,0x6f,0x67,0x6f,0x20,0x73,0x76,0x67,0x20,0x7b,0x77,0x69,
+  0x64,0x74,0x68,0x3a,0x32,0x30,0x70,0x78,0x3b,0x68,0x65,0x69,0x67,0x68,0x74,0x3a,
+  0x32,0x30,0x70,0x78,0x7d,0x0a,0x2e,0x68,0x65,0x61,0x64,0x65,0x72,0x2d,0x6c,0x6f,
+  0x67,0x6f,0x20,0x73,0x70,0x61,0x6e,0x20,0x7b,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,
+  0x61,0x72,0x28,0x2d,0x2d,0x61,0x63,0x63,0x65,0x6e,0x74,0x29,0x7d,0x0a,0x2e,0x68,
+  0x65,0x61,0x64,0x65,0x72,0x2d,0x76,0x65,0x72,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6f,
+  0x6e,0x74,0x2d,0x66,0x61,0x6d,0x69,0x6c,0x79,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,
+  0x66,0x6f,0x6e,0x74,0x2d,0x6d,0x6f,0x6e,0x6f,0x29,0x3b,0x66,0x6f,0x6e,0x74,0x2d,
+  0x73,0x69,0x7a,0x65,0x3a,0x31,0x31,0x70,0x78,0x3b,0x0a,0x20,0x20,0x63,0x6f,0x6c,
+  0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x74,0x65,0x78,0x74,0x2d,0x6d,0x75,
+  0x74,0x65,0x64,0x29,0x3b,0x62,0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,
+  0x76,0x61,0x72,0x28,0x2d,0x2d,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x32,0x29,0x3b,
+  0x0a,0x20,0x20,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x32,0x70,0x78,0x20,0x38,
+  0x70,0x78,0x3b,0x62,0x6f,0x72,0x64,0x65,0x72,0x2d,0x72,0x61,0x64,0x69,0x75,0x73,
+  0x3a,0x34,0x70,0x78,0x3b,0x0a,0x7d,0x0a,0x2e,0x68,0x65,0x61,0x64,0x65,0x72,0x2d,
+  0x72,0x69,0x67,0x68,0x74,0x20,0x7b,0x0a,0x20,0x20,0x6d,0x61,0x72,0x67,0x69,0x6e,
+  0x2d,0x6c,0x65,0x66,0x74,0x3a,0x61,0x75,0x74,0x6f,0x3b,0x64,0x69,0x73,0x70,0x6c,
+  0x61,0x79,0x3a,0x66,0x6c,0x65,0x78,0x3b,0x61,0x6c,0x69,0x67,0x6e,0x2d,0x69,0x74,
+  0x65,0x6d,0x73,0x3a,0x63,0x65,0x6e,0x74,0x65,0x72,0x3b,0x67,0x61,0x70,0x3a,0x31,
+  0x36,0x70,0x78,0x3b,0x0a,0x7d,0x0a,0x2e,0x68,0x65,0x61,0x64,0x65,0x72,0x2d,0x73,
+  0x74,0x61,0x74,0x75,0x73,0x20,0x7b,0x0a,0x20,0x20,0x64,0x69,0x73,0x70,0x6c,0x61,
+  0x79,0x3a,0x66,0x6c,0x65,0x78,0x3b,0x61,0x6c,0x69,0x67,0x6e,0x2d,0x69,0x74,0x65,
+  0x6d,0x73,0x3a,0x63,0x65,0x6e,0x74,0x65,0x72,0x3b,0x67,0x61,0x70,0x3a,0x36,0x70,
+  0x78,0x3b,0x0a,0x20,0x20,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,0x7a,0x65,0x3a,0x31,
+  0x32,0x70,0x78,0x3b,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,
+  0x67,0x72,0x65,0x65,0x6e,0x29,0x3b,0x66,0x6f,0x6e,0x74,0x2d,0x77,0x65,0x69,0x67,
+  0x68,0x74,0x3a,0x35,0x30,0x30,0x3b,0x0a,0x7d,0x0a,0x2e,0x68,0x65,0x61,0x64,0x65,
+  0x72,0x2d,0x73,0x74,0x61,0x74,0x75,0x73,0x3a,0x3a,0x62,0x65,0x66,0x6f,0x72,0x65,
+  0x20,0x7b,0x0a,0x20,0x20,0x63,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x3a,0x27,0x27,0x3b,
+  0x77,0x69,0x64,0x74,0x68,0x3a,0x37,0x70,0x78,0x3b,0x68,0x65,0x69,0x67,0x68,0x74,
+  0x3a,0x37,0x70,0x78,0x3b,0x62,0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,
+  0x76,0x61,0x72,0x28,0x2d,0x2d,0x67,0x72,0x65,0x65,0x6e,0x29,0x3b,0x0a,0x20,0x20,
+  0x62,0x6f,0x72,0x64,0x65,0x72,0x2d,0x72,0x61,0x64,0x69,0x75,0x73,0x3a,0x35,0x30,
+  0x25,0x3b,0x62,0x6f,0x78,0x2d,0x73,0x68,0x61,0x64,0x6f,0x77,0x3a,0x30,0x20,0x30,
+  0x20,0x36,0x70,0x78,0x20,0x76,0x61,0x72,0x28,0x2d,0x2d,0x67,0x72,0x65,0x65,0x6e,
+  0x29,0x3b,0x0a,0x7d,0x0a,0x2e,0x68,0x65,0x61,0x64,0x65,0x72,0x2d,0x73,0x74,0x61,
+  0x74,0x75,0x73,0x2e,0x6f,0x66,0x66,0x6c,0x69,0x6e,0x65,0x20,0x7b,0x63,0x6f,0x6c,
+  0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x72,0x65,0x64,0x29,0x7d,0x0a,0x2e,
+  0x68,0x65,0x61,0x64,0x65,0x72,0x2d,0x73,0x74,0x61,0x74,0x75,0x73,0x2e,0x6f,0x66,
+  0x66,0x6c,0x69,0x6e,0x65,0x3a,0x3a,0x62,0x65,0x66,0x6f,0x72,0x65,0x20,0x7b,0x62,
+  0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,
+  0x72,0x65,0x64,0x29,0x3b,0x62,0x6f,0x78,0x2d,0x73,0x68,0x61,0x64,0x6f,0x77,0x3a,
+  0x30,0x20,0x30,0x20,0x36,0x70,0x78,0x20,0x76,0x61,0x72,0x28,0x2d,0x2d,0x72,0x65,
+  0x64,0x29,0x7d,0x0a,0x0a,0x2e,0x68,0x65,0x61,0x64,0x65,0x72,0x2d,0x62,0x61,0x64,
+  0x67,0x65,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,0x7a,0x65,
+  0x3a,0x31,0x31,0x70,0x78,0x3b,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,
+  0x2d,0x2d,0x74,0x65,0x78,0x74,0x2d,0x6d,0x75,0x74,0x65,0x64,0x29,0x3b,0x0a,0x20,
+  0x20,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x32,0x70,0x78,0x20,0x38,0x70,0x78,
+  0x3b,0x62,0x6f,0x72,0x64,0x65,0x72,0x3a,0x31,0x70,0x78,0x20,0x73,0x6f,0x6c,0x69,
+  0x64,0x20,0x76,0x61,0x72,0x28,0x2d,0x2d,0x62,0x6f,0x72,0x64,0x65,0x72,0x29,0x3b,
+  0x0a,0x20,0x20,0x62,0x6f,0x72,0x64,0x65,0x72,0x2d,0x72,0x61,0x64,0x69,0x75,0x73,
+  0x3a,0x34,0x70,0x78,0x3b,0x66,0x6f,0x6e,0x74,0x2d,0x66,0x61,0x6d,0x69,0x6c,0x79,
+  0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x66,0x6f,0x6e,0x74,0x2d,0x6d,0x6f,0x6e,0x6f,
+  0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,
+  0x94,0x80,0x20,0x43,0x68,0x61,0x74,0x20,0x41,0x72,0x65,0x61,0x20,0xe2,0x94,0x80,
+  0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x2a,0x2f,0x0a,0x2e,0x63,0x68,0x61,0x74,0x20,
+  0x7b,0x0a,0x20,0x20,0x66,0x6c,0x65,0x78,0x3a,0x31,0x3b,0x6f,0x76,0x65,0x72,0x66,
+  0x6c,0x6f,0x77,0x2d,0x79,0x3a,0x61,0x75,0x74,0x6f,0x3b,0x6f,0x76,0x65,0x72,0x66,
+  0x6c,0x6f,0x77,0x2d,0x78,0x3a,0x68,0x69,0x64,0x64,0x65,0x6e,0x3b,0x0a,0x20,0x20,
+  0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x30,0x3b,0x73,0x63,0x72,0x6f,0x6c,0x6c,
+  0x2d,0x62,0x65,0x68,0x61,0x76,0x69,0x6f,0x72,0x3a,0x73,0x6d,0x6f,0x6f,0x74,0x68,
+  0x3b,0x0a,0x7d,0x0a,0x2e,0x63,0x68,0x61,0x74,0x2d,0x69,0x6e,0x6e,0x65,0x72,0x20,
+  0x7b,0x0a,0x20,0x20,0x6d,0x61,0x78,0x2d,0x77,0x69,0x64,0x74,0x68,0x3a,0x38,0x30,
+  0x30,0x70,0x78,0x3b,0x6d,0x61,0x72,0x67,0x69,0x6e,0x3a,0x30,0x20,0x61,0x75,0x74,
+  0x6f,0x3b,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x32,0x34,0x70,0x78,0x20,0x32,
+  0x30,0x70,0x78,0x20,0x31,0x32,0x30,0x70,0x78,0x3b,0x0a,0x20,0x20,0x64,0x69,0x73,
+  0x70,0x6c,0x61,0x79,0x3a,0x66,0x6c,0x65,0x78,0x3b,0x66,0x6c,0x65,0x78,0x2d,0x64,
+  0x69,0x72,0x65,0x63,0x74,0x69,0x6f,0x6e,0x3a,0x63,0x6f,0x6c,0x75,0x6d,0x6e,0x3b,
+  0x67,0x61,0x70,0x3a,0x32,0x70,0x78,0x3b,0x0a,0x7d,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,
+  0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x57,0x65,0x6c,0x63,0x6f,0x6d,0x65,
+  0x20,0x53,0x63,0x72,0x65,0x65,0x6e,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,
+  0x80,0x20,0x2a,0x2f,0x0a,0x2e,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x20,0x7b,0x0a,
+  0x20,0x20,0x64,0x69,0x73,0x70,0x6c,0x61,0x79,0x3a,0x66,0x6c,0x65,0x78,0x3b,0x66,
+  0x6c,0x65,0x78,0x2d,0x64,0x69,0x72,0x65,0x63,0x74,0x69,0x6f,0x6e,0x3a,0x63,0x6f,
+  0x6c,0x75,0x6d,0x6e,0x3b,0x61,0x6c,0x69,0x67,0x6e,0x2d,0x69,0x74,0x65,0x6d,0x73,
+  0x3a,0x63,0x65,0x6e,0x74,0x65,0x72,0x3b,0x0a,0x20,0x20,0x6a,0x75,0x73,0x74,0x69,
+  0x66,0x79,0x2d,0x63,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x3a,0x63,0x65,0x6e,0x74,0x65,
+  0x72,0x3b,0x74,0x65,0x78,0x74,0x2d,0x61,0x6c,0x69,0x67,0x6e,0x3a,0x63,0x65,0x6e,
+  0x74,0x65,0x72,0x3b,0x0a,0x20,0x20,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x38,
+  0x30,0x70,0x78,0x20,0x32,0x30,0x70,0x78,0x20,0x34,0x30,0x70,0x78,0x3b,0x67,0x61,
+  0x70,0x3a,0x31,0x36,0x70,0x78,0x3b,0x0a,0x7d,0x0a,0x2e,0x77,0x65,0x6c,0x63,0x6f,
+  0x6d,0x65,0x2d,0x69,0x63,0x6f,0x6e,0x20,0x7b,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,
+  0x7a,0x65,0x3a,0x34,0x38,0x70,0x78,0x3b,0x6d,0x61,0x72,0x67,0x69,0x6e,0x2d,0x62,
+  0x6f,0x74,0x74,0x6f,0x6d,0x3a,0x38,0x70,0x78,0x7d,0x0a,0x2e,0x77,0x65,0x6c,0x63,
+  0x6f,0x6d,0x65,0x20,0x68,0x32,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6f,0x6e,0x74,0x2d,
+  0x73,0x69,0x7a,0x65,0x3a,0x32,0x34,0x70,0x78,0x3b,0x66,0x6f,0x6e,0x74,0x2d,0x77,
+  0x65,0x69,0x67,0x68,0x74,0x3a,0x37,0x30,0x30,0x3b,0x6c,0x65,0x74,0x74,0x65,0x72,
+  0x2d,0x73,0x70,0x61,0x63,0x69,0x6e,0x67,0x3a,0x2d,0x30,0x2e,0x30,0x33,0x65,0x6d,
+  0x3b,0x0a,0x20,0x20,0x62,0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,0x6c,
+  0x69,0x6e,0x65,0x61,0x72,0x2d,0x67,0x72,0x61,0x64,0x69,0x65,0x6e,0x74,0x28,0x31,
+  0x33,0x35,0x64,0x65,0x67,0x2c,0x76,0x61,0x72,0x28,0x2d,0x2d,0x61,0x63,0x63,0x65,
+  0x6e,0x74,0x29,0x2c,0x23,0x61,0x38,0x35,0x35,0x66,0x37,0x29,0x3b,0x0a,0x20,0x20,
+  0x2d,0x77,0x65,0x62,0x6b,0x69,0x74,0x2d,0x62,0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,
+  0x6e,0x64,0x2d,0x63,0x6c,0x69,0x70,0x3a,0x74,0x65,0x78,0x74,0x3b,0x2d,0x77,0x65,
+  0x62,0x6b,0x69,0x74,0x2d,0x74,0x65,0x78,0x74,0x2d,0x66,0x69,0x6c,0x6c,0x2d,0x63,
+  0x6f,0x6c,0x6f,0x72,0x3a,0x74,0x72,0x61,0x6e,0x73,0x70,0x61,0x72,0x65,0x6e,0x74,
+  0x3b,0x0a,0x20,0x20,0x62,0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x2d,0x63,
+  0x6c,0x69,0x70,0x3a,0x74,0x65,0x78,0x74,0x3b,0x0a,0x7d,0x0a,0x2e,0x77,0x65,0x6c,
+  0x63,0x6f,0x6d,0x65,0x20,0x70,0x20,0x7b,0x0a,0x20,0x20,0x63,0x6f,0x6c,0x6f,0x72,
+  0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x74,0x65,0x78,0x74,0x2d,0x64,0x69,0x6d,0x29,
+  0x3b,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,0x7a,0x65,0x3a,0x31,0x34,0x70,0x78,0x3b,
+  0x6c,0x69,0x6e,0x65,0x2d,0x68,0x65,0x69,0x67,0x68,0x74,0x3a,0x31,0x2e,0x37,0x3b,
+  0x0a,0x20,0x20,0x6d,0x61,0x78,0x2d,0x77,0x69,0x64,0x74,0x68,0x3a,0x34,0x38,0x30,
+  0x70,0x78,0x3b,0x0a,0x7d,0x0a,0x2e,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x63,
+  0x61,0x70,0x73,0x20,0x7b,0x0a,0x20,0x20,0x64,0x69,0x73,0x70,0x6c,0x61,0x79,0x3a,
+  0x66,0x6c,0x65,0x78,0x3b,0x66,0x6c,0x65,0x78,0x2d,0x77,0x72,0x61,0x70,0x3a,0x77,
+  0x72,0x61,0x70,0x3b,0x67,0x61,0x70,0x3a,0x38,0x70,0x78,0x3b,0x6a,0x75,0x73,0x74,
+  0x69,0x66,0x79,0x2d,0x63,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x3a,0x63,0x65,0x6e,0x74,
+  0x65,0x72,0x3b,0x0a,0x20,0x20,0x6d,0x61,0x72,0x67,0x69,0x6e,0x2d,0x74,0x6f,0x70,
+  0x3a,0x38,0x70,0x78,0x3b,0x0a,0x7d,0x0a,0x2e,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,
+  0x2d,0x63,0x61,0x70,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,
+  0x7a,0x65,0x3a,0x31,0x32,0x70,0x78,0x3b,0x66,0x6f,0x6e,0x74,0x2d,0x77,0x65,0x69,
+  0x67,0x68,0x74,0x3a,0x35,0x30,0x30,0x3b,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,
+  0x72,0x28,0x2d,0x2d,0x74,0x65,0x78,0x74,0x2d,0x64,0x69,0x6d,0x29,0x3b,0x0a,0x20,
+  0x20,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x36,0x70,0x78,0x20,0x31,0x34,0x70,
+  0x78,0x3b,0x62,0x6f,0x72,0x64,0x65,0x72,0x2d,0x72,0x61,0x64,0x69,0x75,0x73,0x3a,
+  0x32,0x30,0x70,0x78,0x3b,0x0a,0x20,0x20,0x62,0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,
+  0x6e,0x64,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x73,0x75,0x72,0x66,0x61,0x63,0x65,
+  0x32,0x29,0x3b,0x62,0x6f,0x72,0x64,0x65,0x72,0x3a,0x31,0x70,0x78,0x20,0x73,0x6f,
+  0x6c,0x69,0x64,0x20,0x76,0x61,0x72,0x28,0x2d,0x2d,0x62,0x6f,0x72,0x64,0x65,0x72,
+  0x29,0x3b,0x0a,0x20,0x20,0x74,0x72,0x61,0x6e,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3a,
+  0x61,0x6c,0x6c,0x20,0x76,0x61,0x72,0x28,0x2d,0x2d,0x74,0x72,0x61,0x6e,0x73,0x69,
+  0x74,0x69,0x6f,0x6e,0x29,0x3b,0x0a,0x7d,0x0a,0x2e,0x77,0x65,0x6c,0x63,0x6f,0x6d,
+  0x65,0x2d,0x63,0x61,0x70,0x3a,0x68,0x6f,0x76,0x65,0x72,0x20,0x7b,0x62,0x6f,0x72,
+  0x64,0x65,0x72,0x2d,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,
+  0x61,0x63,0x63,0x65,0x6e,0x74,0x2d,0x64,0x69,0x6d,0x29,0x3b,0x63,0x6f,0x6c,0x6f,
+  0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x61,0x63,0x63,0x65,0x6e,0x74,0x29,0x7d,
+  0x0a,0x2e,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x65,0x78,0x61,0x6d,0x70,0x6c,
+  0x65,0x73,0x20,0x7b,0x0a,0x20,0x20,0x6d,0x61,0x72,0x67,0x69,0x6e,0x2d,0x74,0x6f,
+  0x70,0x3a,0x32,0x30,0x70,0x78,0x3b,0x64,0x69,0x73,0x70,0x6c,0x61,0x79,0x3a,0x66,
+  0x6c,0x65,0x78,0x3b,0x66,0x6c,0x65,0x78,0x2d,0x64,0x69,0x72,0x65,0x63,0x74,0x69,
+  0x6f,0x6e,0x3a,0x63,0x6f,0x6c,0x75,0x6d,0x6e,0x3b,0x67,0x61,0x70,0x3a,0x38,0x70,
+  0x78,0x3b,0x0a,0x20,0x20,0x77,0x69,0x64,0x74,0x68,0x3a,0x31,0x30,0x30,0x25,0x3b,
+  0x6d,0x61,0x78,0x2d,0x77,0x69,0x64,0x74,0x68,0x3a,0x35,0x30,0x30,0x70,0x78,0x3b,
+  0x0a,0x7d,0x0a,0x2e,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x65,0x78,0x61,0x6d,
+  0x70,0x6c,0x65,0x20,0x7b,0x0a,0x20,0x20,0x63,0x75,0x72,0x73,0x6f,0x72,0x3a,0x70,
+  0x6f,0x69,0x6e,0x74,0x65,0x72,0x3b,0x74,0x65,0x78,0x74,0x2d,0x61,0x6c,0x69,0x67,
+  0x6e,0x3a,0x6c,0x65,0x66,0x74,0x3b,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x31,
+  0x32,0x70,0x78,0x20,0x31,0x36,0x70,0x78,0x3b,0x0a,0x20,0x20,0x62,0x61,0x63,0x6b,
+  0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x73,0x75,0x72,
+  0x66,0x61,0x63,0x65,0x29,0x3b,0x62,0x6f,0x72,0x64,0x65,0x72,0x3a,0x31,0x70,0x78,
+  0x20,0x73,0x6f,0x6c,0x69,0x64,0x20,0x76,0x61,0x72,0x28,0x2d,0x2d,0x62,0x6f,0x72,
+  0x64,0x65,0x72,0x29,0x3b,0x0a,0x20,0x20,0x62,0x6f,0x72,0x64,0x65,0x72,0x2d,0x72,
+  0x61,0x64,0x69,0x75,0x73,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x72,0x61,0x64,0x69,
+  0x75,0x73,0x2d,0x73,0x6d,0x29,0x3b,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,0x7a,0x65,
+  0x3a,0x31,0x33,0x70,0x78,0x3b,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,
+  0x2d,0x2d,0x74,0x65,0x78,0x74,0x2d,0x64,0x69,0x6d,0x29,0x3b,0x0a,0x20,0x20,0x74,
+  0x72,0x61,0x6e,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3a,0x61,0x6c,0x6c,0x20,0x76,0x61,
+  0x72,0x28,0x2d,0x2d,0x74,0x72,0x61,0x6e,0x73,0x69,0x74,0x69,0x6f,0x6e,0x29,0x3b,
+  0x0a,0x7d,0x0a,0x2e,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x65,0x78,0x61,0x6d,
+  0x70,0x6c,0x65,0x3a,0x68,0x6f,0x76,0x65,0x72,0x20,0x7b,0x0a,0x20,0x20,0x62,0x6f,
+  0x72,0x64,0x65,0x72,0x2d,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,
+  0x2d,0x62,0x6f,0x72,0x64,0x65,0x72,0x32,0x29,0x3b,0x63,0x6f,0x6c,0x6f,0x72,0x3a,
+  0x76,0x61,0x72,0x28,0x2d,0x2d,0x74,0x65,0x78,0x74,0x29,0x3b,0x0a,0x20,0x20,0x62,
+  0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,
+  0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x32,0x29,0x3b,0x0a,0x7d,0x0a,0x2e,0x77,0x65,
+  0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x65,0x78,0x61,0x6d,0x70,0x6c,0x65,0x20,0x73,0x70,
+  0x61,0x6e,0x20,0x7b,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,
+  0x74,0x65,0x78,0x74,0x2d,0x6d,0x75,0x74,0x65,0x64,0x29,0x3b,0x6d,0x61,0x72,0x67,
+  0x69,0x6e,0x2d,0x72,0x69,0x67,0x68,0x74,0x3a,0x38,0x70,0x78,0x7d,0x0a,0x0a,0x2f,
+  0x2a,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x4d,0x65,0x73,0x73,
+  0x61,0x67,0x65,0x20,0x42,0x6c,0x6f,0x63,0x6b,0x73,0x20,0xe2,0x94,0x80,0xe2,0x94,
+  0x80,0xe2,0x94,0x80,0x20,0x2a,0x2f,0x0a,0x2e,0x6d,0x73,0x67,0x2d,0x67,0x72,0x6f,
+  0x75,0x70,0x20,0x7b,0x0a,0x20,0x20,0x64,0x69,0x73,0x70,0x6c,0x61,0x79,0x3a,0x66,
+  0x6c,0x65,0x78,0x3b,0x66,0x6c,0x65,0x78,0x2d,0x64,0x69,0x72,0x65,0x63,0x74,0x69,
+  0x6f,0x6e,0x3a,0x63,0x6f,0x6c,0x75,0x6d,0x6e,0x3b,0x67,0x61,0x70,0x3a,0x30,0x3b,
+  0x0a,0x20,0x20,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x31,0x36,0x70,0x78,0x20,
+  0x30,0x3b,0x0a,0x7d,0x0a,0x2e,0x6d,0x73,0x67,0x2d,0x67,0x72,0x6f,0x75,0x70,0x20,
+  0x2b,0x20,0x2e,0x6d,0x73,0x67,0x2d,0x67,0x72,0x6f,0x75,0x70,0x20,0x7b,0x62,0x6f,
+  0x72,0x64,0x65,0x72,0x2d,0x74,0x6f,0x70,0x3a,0x31,0x70,0x78,0x20,0x73,0x6f,0x6c,
+  0x69,0x64,0x20,0x76,0x61,0x72,0x28,0x2d,0x2d,0x62,0x6f,0x72,0x64,0x65,0x72,0x29,
+  0x7d,0x0a,0x0a,0x2e,0x6d,0x73,0x67,0x2d,0x6c,0x61,0x62,0x65,0x6c,0x20,0x7b,0x0a,
+  0x20,0x20,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,0x7a,0x65,0x3a,0x31,0x32,0x70,0x78,
+  0x3b,0x66,0x6f,0x6e,0x74,0x2d,0x77,0x65,0x69,0x67,0x68,0x74,0x3a,0x36,0x30,0x30,
+  0x3b,0x74,0x65,0x78,0x74,0x2d,0x74,0x72,0x61,0x6e,0x73,0x66,0x6f,0x72,0x6d,0x3a,
+  0x75,0x70,0x70,0x65,0x72,0x63,0x61,0x73,0x65,0x3b,0x0a,0x20,0x20,0x6c,0x65,0x74,
+  0x74,0x65,0x72,0x2d,0x73,0x70,0x61,0x63,0x69,0x6e,0x67,0x3a,0x30,0x2e,0x30,0x35,
+  0x65,0x6d,0x3b,0x6d,0x61,0x72,0x67,0x69,0x6e,0x2d,0x62,0x6f,0x74,0x74,0x6f,0x6d,
+  0x3a,0x38,0x70,0x78,0x3b,0x0a,0x20,0x20,0x64,0x69,0x73,0x70,0x6c,0x61,0x79,0x3a,
+  0x66,0x6c,0x65,0x78,0x3b,0x61,0x6c,0x69,0x67,0x6e,0x2d,0x69,0x74,0x65,0x6d,0x73,
+  0x3a,0x63,0x65,0x6e,0x74,0x65,0x72,0x3b,0x67,0x61,0x70,0x3a,0x36,0x70,0x78,0x3b,
+  0x0a,0x7d,0x0a,0x2e,0x6d,0x73,0x67,0x2d,0x6c,0x61,0x62,0x65,0x6c,0x2e,0x75,0x73,
+  0x65,0x72,0x20,0x7b,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,
+  0x61,0x63,0x63,0x65,0x6e,0x74,0x29,0x7d,0x0a,0x2e,0x6d,0x73,0x67,0x2d,0x6c,0x61,
+  0x62,0x65,0x6c,0x2e,0x62,0x6f,0x74,0x20,0x20,0x7b,0x63,0x6f,0x6c,0x6f,0x72,0x3a,
+  0x76,0x61,0x72,0x28,0x2d,0x2d,0x70,0x75,0x72,0x70,0x6c,0x65,0x29,0x7d,0x0a,0x2e,
+  0x6d,0x73,0x67,0x2d,0x6c,0x61,0x62,0x65,0x6c,0x20,0x73,0x76,0x67,0x20,0x7b,0x77,
+  0x69,0x64,0x74,0x68,0x3a,0x31,0x34,0x70,0x78,0x3b,0x68,0x65,0x69,0x67,0x68,0x74,
+  0x3a,0x31,0x34,0x70,0x78,0x7d,0x0a,0x0a,0x2e,0x6d,0x73,0x67,0x2d,0x62,0x6f,0x64,
+  0x79,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,0x7a,0x65,0x3a,
+  0x31,0x34,0x70,0x78,0x3b,0x6c,0x69,0x6e,0x65,0x2d,0x68,0x65,0x69,0x67,0x68,0x74,
+  0x3a,0x31,0x2e,0x37,0x35,0x3b,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,
+  0x2d,0x2d,0x74,0x65,0x78,0x74,0x29,0x3b,0x0a,0x20,0x20,0x6f,0x76,0x65,0x72,0x66,
+  0x6c,0x6f,0x77,0x2d,0x77,0x72,0x61,0x70,0x3a,0x62,0x72,0x65,0x61,0x6b,0x2d,0x77,
+  0x6f,0x72,0x64,0x3b,0x77,0x6f,0x72,0x64,0x2d,0x77,0x72,0x61,0x70,0x3a,0x62,0x72,
+  0x65,0x61,0x6b,0x2d,0x77,0x6f,0x72,0x64,0x3b,0x0a,0x7d,0x0a,0x2e,0x6d,0x73,0x67,
+  0x2d,0x62,0x6f,0x64,0x79,0x20,0x70,0x20,0x7b,0x6d,0x61,0x72,0x67,0x69,0x6e,0x2d,
+  0x62,0x6f,0x74,0x74,0x6f,0x6d,0x3a,0x38,0x70,0x78,0x7d,0x0a,0x2e,0x6d,0x73,0x67,
+  0x2d,0x62,0x6f,0x64,0x79,0x20,0x70,0x3a,0x6c,0x61,0x73,0x74,0x2d,0x63,0x68,0x69,
+  0x6c,0x64,0x20,0x7b,0x6d,0x61,0x72,0x67,0x69,0x6e,0x2d,0x62,0x6f,0x74,0x74,0x6f,
+  0x6d,0x3a,0x30,0x7d,0x0a,0x0a,0x2f,0x2a,0x20,0x43,0x6f,0x64,0x65,0x20,0x62,0x6c,
+  0x6f,0x63,0x6b,0x73,0x20,0x2a,0x2f,0x0a,0x2e,0x6d,0x73,0x67,0x2d,0x62,0x6f,0x64,
+  0x79,0x20,0x70,0x72,0x65,0x20,0x7b,0x0a,0x20,0x20,0x62,0x61,0x63,0x6b,0x67,0x72,
+  0x6f,0x75,0x6e,0x64,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x73,0x75,0x72,0x66,0x61,
+  0x63,0x65,0x32,0x29,0x3b,0x62,0x6f,0x72,0x64,0x65,0x72,0x3a,0x31,0x70,0x78,0x20,
+  0x73,0x6f,0x6c,0x69,0x64,0x20,0x76,0x61,0x72,0x28,0x2d,0x2d,0x62,0x6f,0x72,0x64,
+  0x65,0x72,0x29,0x3b,0x0a,0x20,0x20,0x62,0x6f,0x72,0x64,0x65,0x72,0x2d,0x72,0x61,
+  0x64,0x69,0x75,0x73,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x72,0x61,0x64,0x69,0x75,
+  0x73,0x2d,0x73,0x6d,0x29,0x3b,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x31,0x34,
+  0x70,0x78,0x20,0x31,0x36,0x70,0x78,0x3b,0x0a,0x20,0x20,0x6d,0x61,0x72,0x67,0x69,
+  0x6e,0x3a,0x31,0x30,0x70,0x78,0x20,0x30,0x3b,0x6f,0x76,0x65,0x72,0x66,0x6c,0x6f,
+  0x77,0x2d,0x78,0x3a,0x61,0x75,0x74,0x6f,0x3b,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,
+  0x7a,0x65,0x3a,0x31,0x33,0x70,0x78,0x3b,0x0a,0x20,0x20,0x66,0x6f,0x6e,0x74,0x2d,
+  0x66,0x61,0x6d,0x69,0x6c,0x79,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x66,0x6f,0x6e,
+  0x74,0x2d,0x6d,0x6f,0x6e,0x6f,0x29,0x3b,0x6c,0x69,0x6e,0x65,0x2d,0x68,0x65,0x69,
+  0x67,0x68,0x74,0x3a,0x31,0x2e,0x35,0x3b,0x0a,0x20,0x20,0x63,0x6f,0x6c,0x6f,0x72,
+  0x3a,0x23,0x64,0x34,0x64,0x34,0x64,0x38,0x3b,0x0a,0x7d,0x0a,0x2e,0x6d,0x73,0x67,
+  0x2d,0x62,0x6f,0x64,0x79,0x20,0x63,0x6f,0x64,0x65,0x20,0x7b,0x0a,0x20,0x20,0x66,
+  0x6f,0x6e,0x74,0x2d,0x66,0x61,0x6d,0x69,0x6c,0x79,0x3a,0x76,0x61,0x72,0x28,0x2d,
+  0x2d,0x66,0x6f,0x6e,0x74,0x2d,0x6d,0x6f,0x6e,0x6f,0x29,0x3b,0x66,0x6f,0x6e,0x74,
+  0x2d,0x73,0x69,0x7a,0x65,0x3a,0x30,0x2e,0x39,0x65,0x6d,0x3b,0x0a,0x20,0x20,0x62,
+  0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,
+  0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x32,0x29,0x3b,0x70,0x61,0x64,0x64,0x69,0x6e,
+  0x67,0x3a,0x32,0x70,0x78,0x20,0x36,0x70,0x78,0x3b,0x0a,0x20,0x20,0x62,0x6f,0x72,
+  0x64,0x65,0x72,0x2d,0x72,0x61,0x64,0x69,0x75,0x73,0x3a,0x34,0x70,0x78,0x3b,0x63,
+  0x6f,0x6c,0x6f,0x72,0x3a,0x23,0x64,0x34,0x64,0x34,0x64,0x38,0x3b,0x0a,0x7d,0x0a,
+  0x2e,0x6d,0x73,0x67,0x2d,0x62,0x6f,0x64,0x79,0x20,0x70,0x72,0x65,0x20,0x63,0x6f,
+  0x64,0x65,0x20,0x7b,0x62,0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,0x6e,
+  0x6f,0x6e,0x65,0x3b,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x30,0x3b,0x62,0x6f,
+  0x72,0x64,0x65,0x72,0x2d,0x72,0x61,0x64,0x69,0x75,0x73,0x3a,0x30,0x7d,0x0a,0x0a,
+  0x2f,0x2a,0x20,0x42,0x6f,0x6c,0x64,0x2c,0x20,0x69,0x74,0x61,0x6c,0x69,0x63,0x2c,
+  0x20,0x6c,0x69,0x6e,0x6b,0x73,0x20,0x2a,0x2f,0x0a,0x2e,0x6d,0x73,0x67,0x2d,0x62,
+  0x6f,0x64,0x79,0x20,0x73,0x74,0x72,0x6f,0x6e,0x67,0x20,0x7b,0x66,0x6f,0x6e,0x74,
+  0x2d,0x77,0x65,0x69,0x67,0x68,0x74,0x3a,0x36,0x30,0x30,0x3b,0x63,0x6f,0x6c,0x6f,
+  0x72,0x3a,0x23,0x66,0x34,0x66,0x34,0x66,0x35,0x7d,0x0a,0x2e,0x6d,0x73,0x67,0x2d,
+  0x62,0x6f,0x64,0x79,0x20,0x65,0x6d,0x20,0x7b,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x74,
+  0x79,0x6c,0x65,0x3a,0x69,0x74,0x61,0x6c,0x69,0x63,0x3b,0x63,0x6f,0x6c,0x6f,0x72,
+  0x3a,0x23,0x61,0x31,0x61,0x31,0x61,0x61,0x7d,0x0a,0x2e,0x6d,0x73,0x67,0x2d,0x62,
+  0x6f,0x64,0x79,0x20,0x61,0x20,0x7b,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,
+  0x28,0x2d,0x2d,0x61,0x63,0x63,0x65,0x6e,0x74,0x29,0x3b,0x74,0x65,0x78,0x74,0x2d,
+  0x64,0x65,0x63,0x6f,0x72,0x61,0x74,0x69,0x6f,0x6e,0x3a,0x6e,0x6f,0x6e,0x65,0x7d,
+  0x0a,0x2e,0x6d,0x73,0x67,0x2d,0x62,0x6f,0x64,0x79,0x20,0x61,0x3a,0x68,0x6f,0x76,
+  0x65,0x72,0x20,0x7b,0x74,0x65,0x78,0x74,0x2d,0x64,0x65,0x63,0x6f,0x72,0x61,0x74,
+  0x69,0x6f,0x6e,0x3a,0x75,0x6e,0x64,0x65,0x72,0x6c,0x69,0x6e,0x65,0x7d,0x0a,0x0a,
+  0x2f,0x2a,0x20,0x4c,0x69,0x73,0x74,0x73,0x20,0x2a,0x2f,0x0a,0x2e,0x6d,0x73,0x67,
+  0x2d,0x62,0x6f,0x64,0x79,0x20,0x75,0x6c,0x2c,0x2e,0x6d,0x73,0x67,0x2d,0x62,0x6f,
+  0x64,0x79,0x20,0x6f,0x6c,0x20,0x7b,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x2d,0x6c,
+  0x65,0x66,0x74,0x3a,0x32,0x30,0x70,0x78,0x3b,0x6d,0x61,0x72,0x67,0x69,0x6e,0x3a,
+  0x38,0x70,0x78,0x20,0x30,0x7d,0x0a,0x2e,0x6d,0x73,0x67,0x2d,0x62,0x6f,0x64,0x79,
+  0x20,0x6c,0x69,0x20,0x7b,0x6d,0x61,0x72,0x67,0x69,0x6e,0x3a,0x34,0x70,0x78,0x20,
+  0x30,0x7d,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,
+  0x20,0x41,0x67,0x65,0x6e,0x74,0x20,0x53,0x74,0x65,0x70,0x73,0x20,0xe2,0x94,0x80,
+  0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x2a,0x2f,0x0a,0x2e,0x73,0x74,0x65,0x70,0x73,
+  0x20,0x7b,0x0a,0x20,0x20,0x6d,0x61,0x72,0x67,0x69,0x6e,0x2d,0x74,0x6f,0x70,0x3a,
+  0x31,0x32,0x70,0x78,0x3b,0x64,0x69,0x73,0x70,0x6c,0x61,0x79,0x3a,0x66,0x6c,0x65,
+  0x78,0x3b,0x66,0x6c,0x65,0x78,0x2d,0x64,0x69,0x72,0x65,0x63,0x74,0x69,0x6f,0x6e,
+  0x3a,0x63,0x6f,0x6c,0x75,0x6d,0x6e,0x3b,0x67,0x61,0x70,0x3a,0x36,0x70,0x78,0x3b,
+  0x0a,0x7d,0x0a,0x2e,0x73,0x74,0x65,0x70,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6f,0x6e,
+  0x74,0x2d,0x73,0x69,0x7a,0x65,0x3a,0x31,0x32,0x70,0x78,0x3b,0x66,0x6f,0x6e,0x74,
+  0x2d,0x66,0x61,0x6d,0x69,0x6c,0x79,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x66,0x6f,
+  0x6e,0x74,0x2d,0x6d,0x6f,0x6e,0x6f,0x29,0x3b,0x0a,0x20,0x20,0x70,0x61,0x64,0x64,
+  0x69,0x6e,0x67,0x3a,0x38,0x70,0x78,0x20,0x31,0x32,0x70,0x78,0x3b,0x62,0x6f,0x72,
+  0x64,0x65,0x72,0x2d,0x72,0x61,0x64,0x69,0x75,0x73,0x3a,0x76,0x61,0x72,0x28,0x2d,
+  0x2d,0x72,0x61,0x64,0x69,0x75,0x73,0x2d,0x73,0x6d,0x29,0x3b,0x0a,0x20,0x20,0x62,
+  0x6f,0x72,0x64,0x65,0x72,0x2d,0x6c,0x65,0x66,0x74,0x3a,0x33,0x70,0x78,0x20,0x73,
+  0x6f,0x6c,0x69,0x64,0x3b,0x61,0x6e,0x69,0x6d,0x61,0x74,0x69,0x6f,0x6e,0x3a,0x73,
+  0x74,0x65,0x70,0x49,0x6e,0x20,0x30,0x2e,0x32,0x73,0x20,0x65,0x61,0x73,0x65,0x3b,
+  0x0a,0x7d,0x0a,0x40,0x6b,0x65,0x79,0x66,0x72,0x61,0x6d,0x65,0x73,0x20,0x73,0x74,
+  0x65,0x70,0x49,0x6e,0x20,0x7b,0x0a,0x20,0x20,0x66,0x72,0x6f,0x6d,0x20,0x7b,0x6f,
+  0x70,0x61,0x63,0x69,0x74,0x79,0x3a,0x30,0x3b,0x74,0x72,0x61,0x6e,0x73,0x66,0x6f,
+  0x72,0x6d,0x3a,0x74,0x72,0x61,0x6e,0x73,0x6c,0x61,0x74,0x65,0x58,0x28,0x2d,0x34,
+  0x70,0x78,0x29,0x7d,0x0a,0x20,0x20,0x74,0x6f,0x20,0x20,0x20,0x7b,0x6f,0x70,0x61,
+  0x63,0x69,0x74,0x79,0x3a,0x31,0x3b,0x74,0x72,0x61,0x6e,0x73,0x66,0x6f,0x72,0x6d,
+  0x3a,0x6e,0x6f,0x6e,0x65,0x7d,0x0a,0x7d,0x0a,0x2e,0x73,0x74,0x65,0x70,0x2d,0x74,
+  0x68,0x69,0x6e,0x6b,0x20,0x7b,0x0a,0x20,0x20,0x62,0x61,0x63,0x6b,0x67,0x72,0x6f,
+  0x75,0x6e,0x64,0x3a,0x72,0x67,0x62,0x61,0x28,0x32,0x33,0x34,0x2c,0x31,0x37,0x39,
+  0x2c,0x38,0x2c,0x30,0x2e,0x30,0x36,0x29,0x3b,0x62,0x6f,0x72,0x64,0x65,0x72,0x2d,
+  0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x79,0x65,0x6c,0x6c,
+  0x6f,0x77,0x29,0x3b,0x0a,0x20,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,
+  0x28,0x2d,0x2d,0x79,0x65,0x6c,0x6c,0x6f,0x77,0x29,0x3b,0x0a,0x7d,0x0a,0x2e,0x73,
+  0x74,0x65,0x70,0x2d,0x74,0x6f,0x6f,0x6c,0x20,0x7b,0x0a,0x20,0x20,0x62,0x61,0x63,
+  0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,0x72,0x67,0x62,0x61,0x28,0x36,0x2c,0x31,
+  0x38,0x32,0x2c,0x32,0x31,0x32,0x2c,0x30,0x2e,0x30,0x36,0x29,0x3b,0x62,0x6f,0x72,
+  0x64,0x65,0x72,0x2d,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,
+  0x61,0x63,0x63,0x65,0x6e,0x74,0x29,0x3b,0x0a,0x20,0x20,0x63,0x6f,0x6c,0x6f,0x72,
+  0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x61,0x63,0x63,0x65,0x6e,0x74,0x29,0x3b,0x0a,
+  0x7d,0x0a,0x2e,0x73,0x74,0x65,0x70,0x2d,0x6f,0x62,0x73,0x20,0x7b,0x0a,0x20,0x20,
+  0x62,0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,0x76,0x61,0x72,0x28,0x2d,
+  0x2d,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x32,0x29,0x3b,0x62,0x6f,0x72,0x64,0x65,
+  0x72,0x2d,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x62,0x6f,
+  0x72,0x64,0x65,0x72,0x32,0x29,0x3b,0x0a,0x20,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3a,
+  0x76,0x61,0x72,0x28,0x2d,0x2d,0x74,0x65,0x78,0x74,0x2d,0x64,0x69,0x6d,0x29,0x3b,
+  0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,0x7a,0x65,0x3a,0x31,0x31,0x70,0x78,0x3b,0x0a,
+  0x20,0x20,0x6d,0x61,0x78,0x2d,0x68,0x65,0x69,0x67,0x68,0x74,0x3a,0x31,0x32,0x30,
+  0x70,0x78,0x3b,0x6f,0x76,0x65,0x72,0x66,0x6c,0x6f,0x77,0x2d,0x79,0x3a,0x61,0x75,
+  0x74,0x6f,0x3b,0x77,0x68,0x69,0x74,0x65,0x2d,0x73,0x70,0x61,0x63,0x65,0x3a,0x70,
+  0x72,0x65,0x2d,0x77,0x72,0x61,0x70,0x3b,0x0a,0x7d,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,
+  0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x4c,0x69,0x76,0x65,0x20,0x53,0x74,
+  0x61,0x74,0x75,0x73,0x20,0x28,0x64,0x75,0x72,0x69,0x6e,0x67,0x20,0x73,0x74,0x72,
+  0x65,0x61,0x6d,0x69,0x6e,0x67,0x29,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,
+  0x80,0x20,0x2a,0x2f,0x0a,0x2e,0x6c,0x69,0x76,0x65,0x20,0x7b,0x0a,0x20,0x20,0x64,
+  0x69,0x73,0x70,0x6c,0x61,0x79,0x3a,0x6e,0x6f,0x6e,0x65,0x3b,0x6d,0x61,0x78,0x2d,
+  0x77,0x69,0x64,0x74,0x68,0x3a,0x38,0x30,0x30,0x70,0x78,0x3b,0x6d,0x61,0x72,0x67,
+  0x69,0x6e,0x3a,0x30,0x20,0x61,0x75,0x74,0x6f,0x3b,0x0a,0x20,0x20,0x70,0x61,0x64,
+  0x64,0x69,0x6e,0x67,0x3a,0x34,0x70,0x78,0x20,0x32,0x30,0x70,0x78,0x20,0x38,0x70,
+  0x78,0x3b,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,0x7a,0x65,0x3a,0x31,0x32,0x70,0x78,
+  0x3b,0x0a,0x20,0x20,0x66,0x6f,0x6e,0x74,0x2d,0x66,0x61,0x6d,0x69,0x6c,0x79,0x3a,
+  0x76,0x61,0x72,0x28,0x2d,0x2d,0x66,0x6f,0x6e,0x74,0x2d,0x6d,0x6f,0x6e,0x6f,0x29,
+  0x3b,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x74,0x65,0x78,
+  0x74,0x2d,0x6d,0x75,0x74,0x65,0x64,0x29,0x3b,0x0a,0x7d,0x0a,0x2e,0x6c,0x69,0x76,
+  0x65,0x2e,0x6f,0x6e,0x20,0x7b,0x64,0x69,0x73,0x70,0x6c,0x61,0x79,0x3a,0x66,0x6c,
+  0x65,0x78,0x3b,0x61,0x6c,0x69,0x67,0x6e,0x2d,0x69,0x74,0x65,0x6d,0x73,0x3a,0x63,
+  0x65,0x6e,0x74,0x65,0x72,0x3b,0x67,0x61,0x70,0x3a,0x38,0x70,0x78,0x7d,0x0a,0x2e,
+  0x6c,0x69,0x76,0x65,0x2d,0x69,0x63,0x6f,0x6e,0x20,0x7b,0x0a,0x20,0x20,0x77,0x69,
+  0x64,0x74,0x68,0x3a,0x31,0x36,0x70,0x78,0x3b,0x68,0x65,0x69,0x67,0x68,0x74,0x3a,
+  0x31,0x36,0x70,0x78,0x3b,0x62,0x6f,0x72,0x64,0x65,0x72,0x3a,0x32,0x70,0x78,0x20,
+  0x73,0x6f,0x6c,0x69,0x64,0x20,0x76,0x61,0x72,0x28,0x2d,0x2d,0x61,0x63,0x63,0x65,
+  0x6e,0x74,0x29,0x3b,0x0a,0x20,0x20,0x62,0x6f,0x72,0x64,0x65,0x72,0x2d,0x74,0x6f,
+  0x70,0x2d,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x74,0x72,0x61,0x6e,0x73,0x70,0x61,0x72,
+  0x65,0x6e,0x74,0x3b,0x62,0x6f,0x72,0x64,0x65,0x72,0x2d,0x72,0x61,0x64,0x69,0x75,
+  0x73,0x3a,0x35,0x30,0x25,0x3b,0x0a,0x20,0x20,0x61,0x6e,0x69,0x6d,0x61,0x74,0x69,
+  0x6f,0x6e,0x3a,0x73,0x70,0x69,0x6e,0x20,0x30,0x2e,0x36,0x73,0x20,0x6c,0x69,0x6e,
+  0x65,0x61,0x72,0x20,0x69,0x6e,0x66,0x69,0x6e,0x69,0x74,0x65,0x3b,0x0a,0x7d,0x0a,
+  0x40,0x6b,0x65,0x79,0x66,0x72,0x61,0x6d,0x65,0x73,0x20,0x73,0x70,0x69,0x6e,0x20,
+  0x7b,0x74,0x6f,0x7b,0x74,0x72,0x61,0x6e,0x73,0x66,0x6f,0x72,0x6d,0x3a,0x72,0x6f,
+  0x74,0x61,0x74,0x65,0x28,0x33,0x36,0x30,0x64,0x65,0x67,0x29,0x7d,0x7d,0x0a,0x2e,
+  0x6c,0x69,0x76,0x65,0x2d,0x74,0x65,0x78,0x74,0x20,0x7b,0x63,0x6f,0x6c,0x6f,0x72,
+  0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x74,0x65,0x78,0x74,0x2d,0x64,0x69,0x6d,0x29,
+  0x7d,0x0a,0x2e,0x6c,0x69,0x76,0x65,0x2d,0x74,0x65,0x78,0x74,0x20,0x65,0x6d,0x20,
+  0x7b,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x61,0x63,0x63,
+  0x65,0x6e,0x74,0x29,0x3b,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x74,0x79,0x6c,0x65,0x3a,
+  0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x7d,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,0x94,0x80,0xe2,
+  0x94,0x80,0xe2,0x94,0x80,0x20,0x54,0x79,0x70,0x69,0x6e,0x67,0x20,0x49,0x6e,0x64,
+  0x69,0x63,0x61,0x74,0x6f,0x72,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,
+  0x20,0x2a,0x2f,0x0a,0x2e,0x74,0x79,0x70,0x69,0x6e,0x67,0x20,0x7b,0x0a,0x20,0x20,
+  0x64,0x69,0x73,0x70,0x6c,0x61,0x79,0x3a,0x6e,0x6f,0x6e,0x65,0x3b,0x61,0x6c,0x69,
+  0x67,0x6e,0x2d,0x69,0x74,0x65,0x6d,0x73,0x3a,0x63,0x65,0x6e,0x74,0x65,0x72,0x3b,
+  0x67,0x61,0x70,0x3a,0x35,0x70,0x78,0x3b,0x0a,0x20,0x20,0x70,0x61,0x64,0x64,0x69,
+  0x6e,0x67,0x3a,0x31,0x36,0x70,0x78,0x20,0x30,0x3b,0x6d,0x61,0x78,0x2d,0x77,0x69,
+  0x64,0x74,0x68,0x3a,0x38,0x30,0x30,0x70,0x78,0x3b,0x6d,0x61,0x72,0x67,0x69,0x6e,
+  0x3a,0x30,0x20,0x61,0x75,0x74,0x6f,0x3b,0x0a,0x7d,0x0a,0x2e,0x74,0x79,0x70,0x69,
+  0x6e,0x67,0x2e,0x6f,0x6e,0x20,0x7b,0x64,0x69,0x73,0x70,0x6c,0x61,0x79,0x3a,0x66,
+  0x6c,0x65,0x78,0x7d,0x0a,0x2e,0x74,0x79,0x70,0x69,0x6e,0x67,0x2d,0x64,0x6f,0x74,
+  0x20,0x7b,0x0a,0x20,0x20,0x77,0x69,0x64,0x74,0x68,0x3a,0x36,0x70,0x78,0x3b,0x68,
+  0x65,0x69,0x67,0x68,0x74,0x3a,0x36,0x70,0x78,0x3b,0x62,0x61,0x63,0x6b,0x67,0x72,
+  0x6f,0x75,0x6e,0x64,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x61,0x63,0x63,0x65,0x6e,
+  0x74,0x29,0x3b,0x62,0x6f,0x72,0x64,0x65,0x72,0x2d,0x72,0x61,0x64,0x69,0x75,0x73,
+  0x3a,0x35,0x30,0x25,0x3b,0x0a,0x20,0x20,0x61,0x6e,0x69,0x6d,0x61,0x74,0x69,0x6f,
+  0x6e,0x3a,0x74,0x79,0x70,0x69,0x6e,0x67,0x42,0x6f,0x75,0x6e,0x63,0x65,0x20,0x31,
+  0x2e,0x32,0x73,0x20,0x69,0x6e,0x66,0x69,0x6e,0x69,0x74,0x65,0x3b,0x0a,0x7d,0x0a,
+  0x2e,0x74,0x79,0x70,0x69,0x6e,0x67,0x2d,0x64,0x6f,0x74,0x3a,0x6e,0x74,0x68,0x2d,
+  0x63,0x68,0x69,0x6c,0x64,0x28,0x32,0x29,0x20,0x7b,0x61,0x6e,0x69,0x6d,0x61,0x74,
+  0x69,0x6f,0x6e,0x2d,0x64,0x65,0x6c,0x61,0x79,0x3a,0x30,0x2e,0x32,0x73,0x7d,0x0a,
+  0x2e,0x74,0x79,0x70,0x69,0x6e,0x67,0x2d,0x64,0x6f,0x74,0x3a,0x6e,0x74,0x68,0x2d,
+  0x63,0x68,0x69,0x6c,0x64,0x28,0x33,0x29,0x20,0x7b,0x61,0x6e,0x69,0x6d,0x61,0x74,
+  0x69,0x6f,0x6e,0x2d,0x64,0x65,0x6c,0x61,0x79,0x3a,0x30,0x2e,0x34,0x73,0x7d,0x0a,
+  0x40,0x6b,0x65,0x79,0x66,0x72,0x61,0x6d,0x65,0x73,0x20,0x74,0x79,0x70,0x69,0x6e,
+  0x67,0x42,0x6f,0x75,0x6e,0x63,0x65,0x20,0x7b,0x0a,0x20,0x20,0x30,0x25,0x2c,0x36,
+  0x30,0x25,0x2c,0x31,0x30,0x30,0x25,0x7b,0x6f,0x70,0x61,0x63,0x69,0x74,0x79,0x3a,
+  0x30,0x2e,0x33,0x3b,0x74,0x72,0x61,0x6e,0x73,0x66,0x6f,0x72,0x6d,0x3a,0x74,0x72,
+  0x61,0x6e,0x73,0x6c,0x61,0x74,0x65,0x59,0x28,0x30,0x29,0x7d,0x0a,0x20,0x20,0x33,
+  0x30,0x25,0x7b,0x6f,0x70,0x61,0x63,0x69,0x74,0x79,0x3a,0x31,0x3b,0x74,0x72,0x61,
+  0x6e,0x73,0x66,0x6f,0x72,0x6d,0x3a,0x74,0x72,0x61,0x6e,0x73,0x6c,0x61,0x74,0x65,
+  0x59,0x28,0x2d,0x34,0x70,0x78,0x29,0x7d,0x0a,0x7d,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,
+  0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x49,0x6e,0x70,0x75,0x74,0x20,0x41,
+  0x72,0x65,0x61,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x2a,0x2f,
+  0x0a,0x2e,0x69,0x6e,0x70,0x75,0x74,0x2d,0x61,0x72,0x65,0x61,0x20,0x7b,0x0a,0x20,
+  0x20,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3a,0x66,0x69,0x78,0x65,0x64,0x3b,
+  0x62,0x6f,0x74,0x74,0x6f,0x6d,0x3a,0x30,0x3b,0x6c,0x65,0x66,0x74,0x3a,0x30,0x3b,
+  0x72,0x69,0x67,0x68,0x74,0x3a,0x30,0x3b,0x0a,0x20,0x20,0x62,0x61,0x63,0x6b,0x67,
+  0x72,0x6f,0x75,0x6e,0x64,0x3a,0x6c,0x69,0x6e,0x65,0x61,0x72,0x2d,0x67,0x72,0x61,
+  0x64,0x69,0x65,0x6e,0x74,0x28,0x74,0x72,0x61,0x6e,0x73,0x70,0x61,0x72,0x65,0x6e,
+  0x74,0x2c,0x76,0x61,0x72,0x28,0x2d,0x2d,0x62,0x67,0x29,0x20,0x32,0x30,0x25,0x29,
+  0x3b,0x0a,0x20,0x20,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x31,0x36,0x70,0x78,
+  0x20,0x32,0x30,0x70,0x78,0x20,0x32,0x30,0x70,0x78,0x3b,0x7a,0x2d,0x69,0x6e,0x64,
+  0x65,0x78,0x3a,0x31,0x30,0x3b,0x0a,0x7d,0x0a,0x2e,0x69,0x6e,0x70,0x75,0x74,0x2d,
+  0x62,0x6f,0x78,0x20,0x7b,0x0a,0x20,0x20,0x6d,0x61,0x78,0x2d,0x77,0x69,0x64,0x74,
+  0x68,0x3a,0x38,0x30,0x30,0x70,0x78,0x3b,0x6d,0x61,0x72,0x67,0x69,0x6e,0x3a,0x30,
+  0x20,0x61,0x75,0x74,0x6f,0x3b,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3a,0x72,
+  0x65,0x6c,0x61,0x74,0x69,0x76,0x65,0x3b,0x0a,0x20,0x20,0x62,0x61,0x63,0x6b,0x67,
+  0x72,0x6f,0x75,0x6e,0x64,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x73,0x75,0x72,0x66,
+  0x61,0x63,0x65,0x29,0x3b,0x62,0x6f,0x72,0x64,0x65,0x72,0x3a,0x31,0x70,0x78,0x20,
+  0x73,0x6f,0x6c,0x69,0x64,0x20,0x76,0x61,0x72,0x28,0x2d,0x2d,0x62,0x6f,0x72,0x64,
+  0x65,0x72,0x29,0x3b,0x0a,0x20,0x20,0x62,0x6f,0x72,0x64,0x65,0x72,0x2d,0x72,0x61,
+  0x64,0x69,0x75,0x73,0x3a,0x31,0x36,0x70,0x78,0x3b,0x74,0x72,0x61,0x6e,0x73,0x69,
+  0x74,0x69,0x6f,0x6e,0x3a,0x62,0x6f,0x72,0x64,0x65,0x72,0x2d,0x63,0x6f,0x6c,0x6f,
+  0x72,0x20,0x76,0x61,0x72,0x28,0x2d,0x2d,0x74,0x72,0x61,0x6e,0x73,0x69,0x74,0x69,
+  0x6f,0x6e,0x29,0x3b,0x0a,0x20,0x20,0x62,0x6f,0x78,0x2d,0x73,0x68,0x61,0x64,0x6f,
+  0x77,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x73,0x68,0x61,0x64,0x6f,0x77,0x29,0x3b,
+  0x0a,0x7d,0x0a,0x2e,0x69,0x6e,0x70,0x75,0x74,0x2d,0x62,0x6f,0x78,0x3a,0x66,0x6f,
+  0x63,0x75,0x73,0x2d,0x77,0x69,0x74,0x68,0x69,0x6e,0x20,0x7b,0x62,0x6f,0x72,0x64,
+  0x65,0x72,0x2d,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x61,
+  0x63,0x63,0x65,0x6e,0x74,0x2d,0x64,0x69,0x6d,0x29,0x7d,0x0a,0x2e,0x69,0x6e,0x70,
+  0x75,0x74,0x2d,0x62,0x6f,0x78,0x20,0x74,0x65,0x78,0x74,0x61,0x72,0x65,0x61,0x20,
+  0x7b,0x0a,0x20,0x20,0x77,0x69,0x64,0x74,0x68,0x3a,0x31,0x30,0x30,0x25,0x3b,0x62,
+  0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,0x74,0x72,0x61,0x6e,0x73,0x70,
+  0x61,0x72,0x65,0x6e,0x74,0x3b,0x62,0x6f,0x72,0x64,0x65,0x72,0x3a,0x6e,0x6f,0x6e,
+  0x65,0x3b,0x0a,0x20,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,
+  0x2d,0x74,0x65,0x78,0x74,0x29,0x3b,0x66,0x6f,0x6e,0x74,0x2d,0x66,0x61,0x6d,0x69,
+  0x6c,0x79,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x61,
+  0x6e,0x73,0x29,0x3b,0x0a,0x20,0x20,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,0x7a,0x65,
+  0x3a,0x31,0x34,0x70,0x78,0x3b,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x31,0x34,
+  0x70,0x78,0x20,0x36,0x30,0x70,0x78,0x20,0x31,0x34,0x70,0x78,0x20,0x31,0x38,0x70,
+  0x78,0x3b,0x0a,0x20,0x20,0x72,0x65,0x73,0x69,0x7a,0x65,0x3a,0x6e,0x6f,0x6e,0x65,
+  0x3b,0x6f,0x75,0x74,0x6c,0x69,0x6e,0x65,0x3a,0x6e,0x6f,0x6e,0x65,0x3b,0x6d,0x61,
+  0x78,0x2d,0x68,0x65,0x69,0x67,0x68,0x74,0x3a,0x31,0x36,0x30,0x70,0x78,0x3b,0x0a,
+  0x20,0x20,0x6c,0x69,0x6e,0x65,0x2d,0x68,0x65,0x69,0x67,0x68,0x74,0x3a,0x31,0x2e,
+  0x35,0x3b,0x0a,0x7d,0x0a,0x2e,0x69,0x6e,0x70,0x75,0x74,0x2d,0x62,0x6f,0x78,0x20,
+  0x74,0x65,0x78,0x74,0x61,0x72,0x65,0x61,0x3a,0x3a,0x70,0x6c,0x61,0x63,0x65,0x68,
+  0x6f,0x6c,0x64,0x65,0x72,0x20,0x7b,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,
+  0x28,0x2d,0x2d,0x74,0x65,0x78,0x74,0x2d,0x6d,0x75,0x74,0x65,0x64,0x29,0x7d,0x0a,
+  0x0a,0x2e,0x69,0x6e,0x70,0x75,0x74,0x2d,0x61,0x63,0x74,0x69,0x6f,0x6e,0x73,0x20,
+  0x7b,0x0a,0x20,0x20,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3a,0x61,0x62,0x73,
+  0x6f,0x6c,0x75,0x74,0x65,0x3b,0x72,0x69,0x67,0x68,0x74,0x3a,0x38,0x70,0x78,0x3b,
+  0x62,0x6f,0x74,0x74,0x6f,0x6d,0x3a,0x38,0x70,0x78,0x3b,0x64,0x69,0x73,0x70,0x6c,
+  0x61,0x79,0x3a,0x66,0x6c,0x65,0x78,0x3b,0x67,0x61,0x70,0x3a,0x34,0x70,0x78,0x3b,
+  0x0a,0x7d,0x0a,0x2e,0x62,0x74,0x6e,0x2d,0x73,0x65,0x6e,0x64,0x20,0x7b,0x0a,0x20,
+  0x20,0x77,0x69,0x64,0x74,0x68,0x3a,0x33,0x36,0x70,0x78,0x3b,0x68,0x65,0x69,0x67,
+  0x68,0x74,0x3a,0x33,0x36,0x70,0x78,0x3b,0x62,0x6f,0x72,0x64,0x65,0x72,0x2d,0x72,
+  0x61,0x64,0x69,0x75,0x73,0x3a,0x31,0x30,0x70,0x78,0x3b,0x62,0x6f,0x72,0x64,0x65,
+  0x72,0x3a,0x6e,0x6f,0x6e,0x65,0x3b,0x0a,0x20,0x20,0x62,0x61,0x63,0x6b,0x67,0x72,
+  0x6f,0x75,0x6e,0x64,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x61,0x63,0x63,0x65,0x6e,
+  0x74,0x29,0x3b,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x62,
+  0x67,0x29,0x3b,0x63,0x75,0x72,0x73,0x6f,0x72,0x3a,0x70,0x6f,0x69,0x6e,0x74,0x65,
+  0x72,0x3b,0x0a,0x20,0x20,0x64,0x69,0x73,0x70,0x6c,0x61,0x79,0x3a,0x66,0x6c,0x65,
+  0x78,0x3b,0x61,0x6c,0x69,0x67,0x6e,0x2d,0x69,0x74,0x65,0x6d,0x73,0x3a,0x63,0x65,
+  0x6e,0x74,0x65,0x72,0x3b,0x6a,0x75,0x73,0x74,0x69,0x66,0x79,0x2d,0x63,0x6f,0x6e,
+  0x74,0x65,0x6e,0x74,0x3a,0x63,0x65,0x6e,0x74,0x65,0x72,0x3b,0x0a,0x20,0x20,0x74,
+  0x72,0x61,0x6e,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3a,0x61,0x6c,0x6c,0x20,0x76,0x61,
+  0x72,0x28,0x2d,0x2d,0x74,0x72,0x61,0x6e,0x73,0x69,0x74,0x69,0x6f,0x6e,0x29,0x3b,
+  0x0a,0x7d,0x0a,0x2e,0x62,0x74,0x6e,0x2d,0x73,0x65,0x6e,0x64,0x3a,0x68,0x6f,0x76,
+  0x65,0x72,0x20,0x7b,0x6f,0x70,0x61,0x63,0x69,0x74,0x79,0x3a,0x30,0x2e,0x38,0x35,
+  0x3b,0x74,0x72,0x61,0x6e,0x73,0x66,0x6f,0x72,0x6d,0x3a,0x73,0x63,0x61,0x6c,0x65,
+  0x28,0x31,0x2e,0x30,0x35,0x29,0x7d,0x0a,0x2e,0x62,0x74,0x6e,0x2d,0x73,0x65,0x6e,
+  0x64,0x3a,0x64,0x69,0x73,0x61,0x62,0x6c,0x65,0x64,0x20,0x7b,0x6f,0x70,0x61,0x63,
+  0x69,0x74,0x79,0x3a,0x30,0x2e,0x32,0x35,0x3b,0x63,0x75,0x72,0x73,0x6f,0x72,0x3a,
+  0x6e,0x6f,0x74,0x2d,0x61,0x6c,0x6c,0x6f,0x77,0x65,0x64,0x3b,0x74,0x72,0x61,0x6e,
+  0x73,0x66,0x6f,0x72,0x6d,0x3a,0x6e,0x6f,0x6e,0x65,0x7d,0x0a,0x2e,0x62,0x74,0x6e,
+  0x2d,0x73,0x65,0x6e,0x64,0x20,0x73,0x76,0x67,0x20,0x7b,0x77,0x69,0x64,0x74,0x68,
+  0x3a,0x31,0x38,0x70,0x78,0x3b,0x68,0x65,0x69,0x67,0x68,0x74,0x3a,0x31,0x38,0x70,
+  0x78,0x7d,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,
+  0x20,0x53,0x63,0x72,0x6f,0x6c,0x6c,0x62,0x61,0x72,0x20,0xe2,0x94,0x80,0xe2,0x94,
+  0x80,0xe2,0x94,0x80,0x20,0x2a,0x2f,0x0a,0x3a,0x3a,0x2d,0x77,0x65,0x62,0x6b,0x69,
+  0x74,0x2d,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x62,0x61,0x72,0x20,0x7b,0x77,0x69,0x64,
+  0x74,0x68,0x3a,0x36,0x70,0x78,0x7d,0x0a,0x3a,0x3a,0x2d,0x77,0x65,0x62,0x6b,0x69,
+  0x74,0x2d,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x62,0x61,0x72,0x2d,0x74,0x72,0x61,0x63,
+  0x6b,0x20,0x7b,0x62,0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,0x74,0x72,
+  0x61,0x6e,0x73,0x70,0x61,0x72,0x65,0x6e,0x74,0x7d,0x0a,0x3a,0x3a,0x2d,0x77,0x65,
+  0x62,0x6b,0x69,0x74,0x2d,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x62,0x61,0x72,0x2d,0x74,
+  0x68,0x75,0x6d,0x62,0x20,0x7b,0x62,0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,
+  0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,0x62,0x6f,0x72,0x64,0x65,0x72,0x32,0x29,0x3b,
+  0x62,0x6f,0x72,0x64,0x65,0x72,0x2d,0x72,0x61,0x64,0x69,0x75,0x73,0x3a,0x33,0x70,
+  0x78,0x7d,0x0a,0x3a,0x3a,0x2d,0x77,0x65,0x62,0x6b,0x69,0x74,0x2d,0x73,0x63,0x72,
+  0x6f,0x6c,0x6c,0x62,0x61,0x72,0x2d,0x74,0x68,0x75,0x6d,0x62,0x3a,0x68,0x6f,0x76,
+  0x65,0x72,0x20,0x7b,0x62,0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,0x76,
+  0x61,0x72,0x28,0x2d,0x2d,0x74,0x65,0x78,0x74,0x2d,0x6d,0x75,0x74,0x65,0x64,0x29,
+  0x7d,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,
+  0x52,0x65,0x73,0x70,0x6f,0x6e,0x73,0x69,0x76,0x65,0x20,0xe2,0x94,0x80,0xe2,0x94,
+  0x80,0xe2,0x94,0x80,0x20,0x2a,0x2f,0x0a,0x40,0x6d,0x65,0x64,0x69,0x61,0x28,0x6d,
+  0x61,0x78,0x2d,0x77,0x69,0x64,0x74,0x68,0x3a,0x36,0x34,0x30,0x70,0x78,0x29,0x20,
+  0x7b,0x0a,0x20,0x20,0x2e,0x63,0x68,0x61,0x74,0x2d,0x69,0x6e,0x6e,0x65,0x72,0x20,
+  0x7b,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x31,0x36,0x70,0x78,0x20,0x31,0x32,
+  0x70,0x78,0x20,0x31,0x32,0x30,0x70,0x78,0x7d,0x0a,0x20,0x20,0x2e,0x69,0x6e,0x70,
+  0x75,0x74,0x2d,0x61,0x72,0x65,0x61,0x20,0x7b,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,
+  0x3a,0x31,0x32,0x70,0x78,0x20,0x31,0x32,0x70,0x78,0x20,0x31,0x36,0x70,0x78,0x7d,
+  0x0a,0x20,0x20,0x2e,0x68,0x65,0x61,0x64,0x65,0x72,0x20,0x7b,0x70,0x61,0x64,0x64,
+  0x69,0x6e,0x67,0x3a,0x31,0x30,0x70,0x78,0x20,0x31,0x34,0x70,0x78,0x7d,0x0a,0x20,
+  0x20,0x2e,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x20,0x7b,0x70,0x61,0x64,0x64,0x69,
+  0x6e,0x67,0x3a,0x34,0x30,0x70,0x78,0x20,0x31,0x36,0x70,0x78,0x20,0x32,0x30,0x70,
+  0x78,0x7d,0x0a,0x20,0x20,0x2e,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x20,0x68,0x32,
+  0x20,0x7b,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,0x7a,0x65,0x3a,0x32,0x30,0x70,0x78,
+  0x7d,0x0a,0x20,0x20,0x2e,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x65,0x78,0x61,
+  0x6d,0x70,0x6c,0x65,0x73,0x20,0x7b,0x6d,0x61,0x78,0x2d,0x77,0x69,0x64,0x74,0x68,
+  0x3a,0x31,0x30,0x30,0x25,0x7d,0x0a,0x20,0x20,0x2e,0x6d,0x73,0x67,0x2d,0x62,0x6f,
+  0x64,0x79,0x20,0x70,0x72,0x65,0x20,0x7b,0x66,0x6f,0x6e,0x74,0x2d,0x73,0x69,0x7a,
+  0x65,0x3a,0x31,0x32,0x70,0x78,0x3b,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x3a,0x31,
+  0x30,0x70,0x78,0x20,0x31,0x32,0x70,0x78,0x7d,0x0a,0x7d,0x0a,0x0a,0x2f,0x2a,0x20,
+  0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x41,0x6e,0x69,0x6d,0x61,0x74,
+  0x69,0x6f,0x6e,0x73,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x2a,
+  0x2f,0x0a,0x2e,0x66,0x61,0x64,0x65,0x2d,0x69,0x6e,0x20,0x7b,0x61,0x6e,0x69,0x6d,
+  0x61,0x74,0x69,0x6f,0x6e,0x3a,0x66,0x61,0x64,0x65,0x49,0x6e,0x20,0x30,0x2e,0x32,
+  0x35,0x73,0x20,0x65,0x61,0x73,0x65,0x7d,0x0a,0x40,0x6b,0x65,0x79,0x66,0x72,0x61,
+  0x6d,0x65,0x73,0x20,0x66,0x61,0x64,0x65,0x49,0x6e,0x20,0x7b,0x0a,0x20,0x20,0x66,
+  0x72,0x6f,0x6d,0x20,0x7b,0x6f,0x70,0x61,0x63,0x69,0x74,0x79,0x3a,0x30,0x3b,0x74,
+  0x72,0x61,0x6e,0x73,0x66,0x6f,0x72,0x6d,0x3a,0x74,0x72,0x61,0x6e,0x73,0x6c,0x61,
+  0x74,0x65,0x59,0x28,0x36,0x70,0x78,0x29,0x7d,0x0a,0x20,0x20,0x74,0x6f,0x20,0x20,
+  0x20,0x7b,0x6f,0x70,0x61,0x63,0x69,0x74,0x79,0x3a,0x31,0x3b,0x74,0x72,0x61,0x6e,
+  0x73,0x66,0x6f,0x72,0x6d,0x3a,0x6e,0x6f,0x6e,0x65,0x7d,0x0a,0x7d,0x0a,0x0a,0x2f,
+  0x2a,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x53,0x65,0x6c,0x65,
+  0x63,0x74,0x69,0x6f,0x6e,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,
+  0x2a,0x2f,0x0a,0x3a,0x3a,0x73,0x65,0x6c,0x65,0x63,0x74,0x69,0x6f,0x6e,0x20,0x7b,
+  0x62,0x61,0x63,0x6b,0x67,0x72,0x6f,0x75,0x6e,0x64,0x3a,0x76,0x61,0x72,0x28,0x2d,
+  0x2d,0x61,0x63,0x63,0x65,0x6e,0x74,0x2d,0x64,0x69,0x6d,0x29,0x3b,0x63,0x6f,0x6c,
+  0x6f,0x72,0x3a,0x77,0x68,0x69,0x74,0x65,0x7d,0x0a,0x3c,0x2f,0x73,0x74,0x79,0x6c,
+  0x65,0x3e,0x0a,0x3c,0x2f,0x68,0x65,0x61,0x64,0x3e,0x0a,0x3c,0x62,0x6f,0x64,0x79,
+  0x3e,0x0a,0x0a,0x3c,0x21,0x2d,0x2d,0x20,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,
+  0x90,0x20,0x48,0x65,0x61,0x64,0x65,0x72,0x20,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0x20,0x2d,0x2d,0x3e,0x0a,0x3c,0x68,0x65,0x61,0x64,0x65,0x72,0x20,0x63,
+  0x6c,0x61,0x73,0x73,0x3d,0x22,0x68,0x65,0x61,0x64,0x65,0x72,0x22,0x3e,0x0a,0x20,
+  0x20,0x3c,0x64,0x69,0x76,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x68,0x65,0x61,
+  0x64,0x65,0x72,0x2d,0x6c,0x6f,0x67,0x6f,0x22,0x3e,0x0a,0x20,0x20,0x20,0x20,0x3c,
+  0x73,0x76,0x67,0x20,0x76,0x69,0x65,0x77,0x42,0x6f,0x78,0x3d,0x22,0x30,0x20,0x30,
+  0x20,0x32,0x34,0x20,0x32,0x34,0x22,0x20,0x66,0x69,0x6c,0x6c,0x3d,0x22,0x6e,0x6f,
+  0x6e,0x65,0x22,0x20,0x73,0x74,0x72,0x6f,0x6b,0x65,0x3d,0x22,0x63,0x75,0x72,0x72,
+  0x65,0x6e,0x74,0x43,0x6f,0x6c,0x6f,0x72,0x22,0x20,0x73,0x74,0x72,0x6f,0x6b,0x65,
+  0x2d,0x77,0x69,0x64,0x74,0x68,0x3d,0x22,0x32,0x2e,0x35,0x22,0x20,0x73,0x74,0x79,
+  0x6c,0x65,0x3d,0x22,0x63,0x6f,0x6c,0x6f,0x72,0x3a,0x76,0x61,0x72,0x28,0x2d,0x2d,
+  0x61,0x63,0x63,0x65,0x6e,0x74,0x29,0x22,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,
+  0x3c,0x70,0x61,0x74,0x68,0x20,0x64,0x3d,0x22,0x4d,0x31,0x33,0x20,0x32,0x4c,0x33,
+  0x20,0x31,0x34,0x68,0x39,0x6c,0x2d,0x31,0x20,0x38,0x20,0x31,0x30,0x2d,0x31,0x32,
+  0x68,0x2d,0x39,0x6c,0x31,0x2d,0x38,0x7a,0x22,0x2f,0x3e,0x0a,0x20,0x20,0x20,0x20,
+  0x3c,0x2f,0x73,0x76,0x67,0x3e,0x0a,0x20,0x20,0x20,0x20,0x3c,0x73,0x70,0x61,0x6e,
+  0x3e,0x4e,0x65,0x75,0x72,0x6f,0x6e,0x4f,0x53,0x3c,0x2f,0x73,0x70,0x61,0x6e,0x3e,
+  0x0a,0x20,0x20,0x3c,0x2f,0x64,0x69,0x76,0x3e,0x0a,0x20,0x20,0x3c,0x73,0x70,0x61,
+  0x6e,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x68,0x65,0x61,0x64,0x65,0x72,0x2d,
+  0x76,0x65,0x72,0x22,0x20,0x69,0x64,0x3d,0x22,0x76,0x65,0x72,0x22,0x3e,0x3c,0x2f,
+  0x73,0x70,0x61,0x6e,0x3e,0x0a,0x20,0x20,0x3c,0x64,0x69,0x76,0x20,0x63,0x6c,0x61,
+  0x73,0x73,0x3d,0x22,0x68,0x65,0x61,0x64,0x65,0x72,0x2d,0x72,0x69,0x67,0x68,0x74,
+  0x22,0x3e,0x0a,0x20,0x20,0x20,0x20,0x3c,0x73,0x70,0x61,0x6e,0x20,0x63,0x6c,0x61,
+  0x73,0x73,0x3d,0x22,0x68,0x65,0x61,0x64,0x65,0x72,0x2d,0x62,0x61,0x64,0x67,0x65,
+  0x22,0x20,0x69,0x64,0x3d,0x22,0x6d,0x6f,0x64,0x65,0x6c,0x2d,0x62,0x61,0x64,0x67,
+  0x65,0x22,0x3e,0x3c,0x2f,0x73,0x70,0x61,0x6e,0x3e,0x0a,0x20,0x20,0x20,0x20,0x3c,
+  0x73,0x70,0x61,0x6e,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x68,0x65,0x61,0x64,
+  0x65,0x72,0x2d,0x73,0x74,0x61,0x74,0x75,0x73,0x22,0x20,0x69,0x64,0x3d,0x22,0x73,
+  0x74,0x61,0x74,0x75,0x73,0x22,0x3e,0x4c,0x6f,0x63,0x61,0x6c,0x3c,0x2f,0x73,0x70,
+  0x61,0x6e,0x3e,0x0a,0x20,0x20,0x3c,0x2f,0x64,0x69,0x76,0x3e,0x0a,0x3c,0x2f,0x68,
+  0x65,0x61,0x64,0x65,0x72,0x3e,0x0a,0x0a,0x3c,0x21,0x2d,0x2d,0x20,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0x20,0x43,0x68,0x61,0x74,0x20,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0xe2,0x95,0x90,0x20,0x2d,0x2d,0x3e,0x0a,0x3c,0x6d,0x61,0x69,0x6e,0x20,
+  0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x63,0x68,0x61,0x74,0x22,0x20,0x69,0x64,0x3d,
+  0x22,0x63,0x68,0x61,0x74,0x22,0x3e,0x0a,0x20,0x20,0x3c,0x64,0x69,0x76,0x20,0x63,
+  0x6c,0x61,0x73,0x73,0x3d,0x22,0x63,0x68,0x61,0x74,0x2d,0x69,0x6e,0x6e,0x65,0x72,
+  0x22,0x20,0x69,0x64,0x3d,0x22,0x63,0x68,0x61,0x74,0x2d,0x69,0x6e,0x6e,0x65,0x72,
+  0x22,0x3e,0x0a,0x0a,0x20,0x20,0x20,0x20,0x3c,0x21,0x2d,0x2d,0x20,0x57,0x65,0x6c,
+  0x63,0x6f,0x6d,0x65,0x20,0x2d,0x2d,0x3e,0x0a,0x20,0x20,0x20,0x20,0x3c,0x64,0x69,
+  0x76,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,
+  0x22,0x20,0x69,0x64,0x3d,0x22,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x22,0x3e,0x0a,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x64,0x69,0x76,0x20,0x63,0x6c,0x61,0x73,0x73,
+  0x3d,0x22,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x69,0x63,0x6f,0x6e,0x22,0x3e,
+  0xe2,0x9a,0xa1,0x3c,0x2f,0x64,0x69,0x76,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,
+  0x3c,0x68,0x32,0x3e,0x4e,0x65,0x75,0x72,0x6f,0x6e,0x4f,0x53,0x20,0x41,0x67,0x65,
+  0x6e,0x74,0x3c,0x2f,0x68,0x32,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x70,
+  0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x53,0x6f,0x76,0x65,0x72,0x65,
+  0x69,0x67,0x6e,0x20,0x41,0x49,0x20,0x72,0x75,0x6e,0x6e,0x69,0x6e,0x67,0x20,0x31,
+  0x30,0x30,0x25,0x20,0x6f,0x6e,0x20,0x79,0x6f,0x75,0x72,0x20,0x64,0x65,0x76,0x69,
+  0x63,0x65,0x2e,0x3c,0x62,0x72,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,
+  0x4e,0x6f,0x20,0x63,0x6c,0x6f,0x75,0x64,0x2e,0x20,0x4e,0x6f,0x20,0x64,0x61,0x74,
+  0x61,0x20,0x6c,0x65,0x61,0x76,0x65,0x73,0x20,0x79,0x6f,0x75,0x72,0x20,0x6d,0x61,
+  0x63,0x68,0x69,0x6e,0x65,0x2e,0x20,0x45,0x76,0x65,0x72,0x2e,0x0a,0x20,0x20,0x20,
+  0x20,0x20,0x20,0x3c,0x2f,0x70,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x64,
+  0x69,0x76,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x77,0x65,0x6c,0x63,0x6f,0x6d,
+  0x65,0x2d,0x63,0x61,0x70,0x73,0x22,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,
+  0x20,0x3c,0x73,0x70,0x61,0x6e,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x77,0x65,
+  0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x63,0x61,0x70,0x22,0x3e,0xf0,0x9f,0xa7,0xa0,0x20,
+  0x52,0x65,0x61,0x73,0x6f,0x6e,0x69,0x6e,0x67,0x3c,0x2f,0x73,0x70,0x61,0x6e,0x3e,
+  0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x73,0x70,0x61,0x6e,0x20,0x63,
+  0x6c,0x61,0x73,0x73,0x3d,0x22,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x63,0x61,
+  0x70,0x22,0x3e,0xf0,0x9f,0x9b,0xa0,0x20,0x54,0x6f,0x6f,0x6c,0x73,0x3c,0x2f,0x73,
+  0x70,0x61,0x6e,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x73,0x70,
+  0x61,0x6e,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x77,0x65,0x6c,0x63,0x6f,0x6d,
+  0x65,0x2d,0x63,0x61,0x70,0x22,0x3e,0xf0,0x9f,0x92,0xbe,0x20,0x4d,0x65,0x6d,0x6f,
+  0x72,0x79,0x3c,0x2f,0x73,0x70,0x61,0x6e,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,
+  0x20,0x20,0x3c,0x73,0x70,0x61,0x6e,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x77,
+  0x65,0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x63,0x61,0x70,0x22,0x3e,0xf0,0x9f,0x93,0x81,
+  0x20,0x46,0x69,0x6c,0x65,0x73,0x3c,0x2f,0x73,0x70,0x61,0x6e,0x3e,0x0a,0x20,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x73,0x70,0x61,0x6e,0x20,0x63,0x6c,0x61,0x73,
+  0x73,0x3d,0x22,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x63,0x61,0x70,0x22,0x3e,
+  0xf0,0x9f,0x8c,0x90,0x20,0x57,0x65,0x62,0x3c,0x2f,0x73,0x70,0x61,0x6e,0x3e,0x0a,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x73,0x70,0x61,0x6e,0x20,0x63,0x6c,
+  0x61,0x73,0x73,0x3d,0x22,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x63,0x61,0x70,
+  0x22,0x3e,0xf0,0x9f,0x92,0xbb,0x20,0x53,0x68,0x65,0x6c,0x6c,0x3c,0x2f,0x73,0x70,
+  0x61,0x6e,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x73,0x70,0x61,
+  0x6e,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,
+  0x2d,0x63,0x61,0x70,0x22,0x3e,0xf0,0x9f,0x94,0x8c,0x20,0x4d,0x43,0x50,0x3c,0x2f,
+  0x73,0x70,0x61,0x6e,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x2f,0x64,0x69,
+  0x76,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x64,0x69,0x76,0x20,0x63,0x6c,
+  0x61,0x73,0x73,0x3d,0x22,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x65,0x78,0x61,
+  0x6d,0x70,0x6c,0x65,0x73,0x22,0x20,0x69,0x64,0x3d,0x22,0x65,0x78,0x61,0x6d,0x70,
+  0x6c,0x65,0x73,0x22,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x64,
+  0x69,0x76,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x77,0x65,0x6c,0x63,0x6f,0x6d,
+  0x65,0x2d,0x65,0x78,0x61,0x6d,0x70,0x6c,0x65,0x22,0x20,0x6f,0x6e,0x63,0x6c,0x69,
+  0x63,0x6b,0x3d,0x22,0x75,0x73,0x65,0x45,0x78,0x61,0x6d,0x70,0x6c,0x65,0x28,0x74,
+  0x68,0x69,0x73,0x29,0x22,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,
+  0x20,0x3c,0x73,0x70,0x61,0x6e,0x3e,0xe2,0x86,0x92,0x3c,0x2f,0x73,0x70,0x61,0x6e,
+  0x3e,0x20,0x57,0x68,0x61,0x74,0x20,0x66,0x69,0x6c,0x65,0x73,0x20,0x61,0x72,0x65,
+  0x20,0x69,0x6e,0x20,0x74,0x68,0x65,0x20,0x63,0x75,0x72,0x72,0x65,0x6e,0x74,0x20,
+  0x64,0x69,0x72,0x65,0x63,0x74,0x6f,0x72,0x79,0x3f,0x0a,0x20,0x20,0x20,0x20,0x20,
+  0x20,0x20,0x20,0x3c,0x2f,0x64,0x69,0x76,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,
+  0x20,0x20,0x3c,0x64,0x69,0x76,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x77,0x65,
+  0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x65,0x78,0x61,0x6d,0x70,0x6c,0x65,0x22,0x20,0x6f,
+  0x6e,0x63,0x6c,0x69,0x63,0x6b,0x3d,0x22,0x75,0x73,0x65,0x45,0x78,0x61,0x6d,0x70,
+  0x6c,0x65,0x28,0x74,0x68,0x69,0x73,0x29,0x22,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x3c,0x73,0x70,0x61,0x6e,0x3e,0xe2,0x86,0x92,0x3c,0x2f,
+  0x73,0x70,0x61,0x6e,0x3e,0x20,0x45,0x78,0x70,0x6c,0x61,0x69,0x6e,0x20,0x74,0x68,
+  0x65,0x20,0x61,0x72,0x63,0x68,0x69,0x74,0x65,0x63,0x74,0x75,0x72,0x65,0x20,0x6f,
+  0x66,0x20,0x74,0x68,0x69,0x73,0x20,0x70,0x72,0x6f,0x6a,0x65,0x63,0x74,0x0a,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x2f,0x64,0x69,0x76,0x3e,0x0a,0x20,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x64,0x69,0x76,0x20,0x63,0x6c,0x61,0x73,0x73,
+  0x3d,0x22,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x65,0x78,0x61,0x6d,0x70,0x6c,
+  0x65,0x22,0x20,0x6f,0x6e,0x63,0x6c,0x69,0x63,0x6b,0x3d,0x22,0x75,0x73,0x65,0x45,
+  0x78,0x61,0x6d,0x70,0x6c,0x65,0x28,0x74,0x68,0x69,0x73,0x29,0x22,0x3e,0x0a,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x73,0x70,0x61,0x6e,0x3e,0xe2,
+  0x86,0x92,0x3c,0x2f,0x73,0x70,0x61,0x6e,0x3e,0x20,0x52,0x65,0x6d,0x65,0x6d,0x62,
+  0x65,0x72,0x20,0x74,0x68,0x61,0x74,0x20,0x74,0x68,0x65,0x20,0x64,0x65,0x61,0x64,
+  0x6c,0x69,0x6e,0x65,0x20,0x69,0x73,0x20,0x4d,0x61,0x72,0x63,0x68,0x20,0x31,0x35,
+  0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x2f,0x64,0x69,0x76,0x3e,0x0a,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x64,0x69,0x76,0x20,0x63,0x6c,0x61,
+  0x73,0x73,0x3d,0x22,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x2d,0x65,0x78,0x61,0x6d,
+  0x70,0x6c,0x65,0x22,0x20,0x6f,0x6e,0x63,0x6c,0x69,0x63,0x6b,0x3d,0x22,0x75,0x73,
+  0x65,0x45,0x78,0x61,0x6d,0x70,0x6c,0x65,0x28,0x74,0x68,0x69,0x73,0x29,0x22,0x3e,
+  0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x73,0x70,0x61,0x6e,
+  0x3e,0xe2,0x86,0x92,0x3c,0x2f,0x73,0x70,0x61,0x6e,0x3e,0x20,0x53,0x65,0x61,0x72,
+  0x63,0x68,0x20,0x6d,0x79,0x20,0x6d,0x65,0x6d,0x6f,0x72,0x79,0x20,0x66,0x6f,0x72,
+  0x20,0x70,0x72,0x65,0x76,0x69,0x6f,0x75,0x73,0x20,0x6e,0x6f,0x74,0x65,0x73,0x0a,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x2f,0x64,0x69,0x76,0x3e,0x0a,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x3c,0x2f,0x64,0x69,0x76,0x3e,0x0a,0x20,0x20,0x20,0x20,
+  0x3c,0x2f,0x64,0x69,0x76,0x3e,0x0a,0x0a,0x20,0x20,0x3c,0x2f,0x64,0x69,0x76,0x3e,
+  0x0a,0x3c,0x2f,0x6d,0x61,0x69,0x6e,0x3e,0x0a,0x0a,0x3c,0x21,0x2d,0x2d,0x20,0xe2,
+  0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0x20,0x4c,0x69,0x76,0x65,0x20,0x53,0x74,
+  0x65,0x70,0x20,0x49,0x6e,0x64,0x69,0x63,0x61,0x74,0x6f,0x72,0x20,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0x20,0x2d,0x2d,0x3e,0x0a,0x3c,0x64,0x69,0x76,0x20,
+  0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x6c,0x69,0x76,0x65,0x22,0x20,0x69,0x64,0x3d,
+  0x22,0x6c,0x69,0x76,0x65,0x22,0x3e,0x0a,0x20,0x20,0x3c,0x64,0x69,0x76,0x20,0x63,
+  0x6c,0x61,0x73,0x73,0x3d,0x22,0x6c,0x69,0x76,0x65,0x2d,0x69,0x63,0x6f,0x6e,0x22,
+  0x3e,0x3c,0x2f,0x64,0x69,0x76,0x3e,0x0a,0x20,0x20,0x3c,0x64,0x69,0x76,0x20,0x63,
+  0x6c,0x61,0x73,0x73,0x3d,0x22,0x6c,0x69,0x76,0x65,0x2d,0x74,0x65,0x78,0x74,0x22,
+  0x20,0x69,0x64,0x3d,0x22,0x6c,0x69,0x76,0x65,0x2d,0x74,0x65,0x78,0x74,0x22,0x3e,
+  0x3c,0x2f,0x64,0x69,0x76,0x3e,0x0a,0x3c,0x2f,0x64,0x69,0x76,0x3e,0x0a,0x0a,0x3c,
+  0x21,0x2d,0x2d,0x20,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0x20,0x49,0x6e,
+  0x70,0x75,0x74,0x20,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0x20,0x2d,0x2d,
+  0x3e,0x0a,0x3c,0x64,0x69,0x76,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x69,0x6e,
+  0x70,0x75,0x74,0x2d,0x61,0x72,0x65,0x61,0x22,0x3e,0x0a,0x20,0x20,0x3c,0x64,0x69,
+  0x76,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x69,0x6e,0x70,0x75,0x74,0x2d,0x62,
+  0x6f,0x78,0x22,0x3e,0x0a,0x20,0x20,0x20,0x20,0x3c,0x74,0x65,0x78,0x74,0x61,0x72,
+  0x65,0x61,0x20,0x69,0x64,0x3d,0x22,0x69,0x6e,0x70,0x75,0x74,0x22,0x20,0x72,0x6f,
+  0x77,0x73,0x3d,0x22,0x31,0x22,0x20,0x70,0x6c,0x61,0x63,0x65,0x68,0x6f,0x6c,0x64,
+  0x65,0x72,0x3d,0x22,0x41,0x73,0x6b,0x20,0x61,0x6e,0x79,0x74,0x68,0x69,0x6e,0x67,
+  0x2e,0x2e,0x2e,0x22,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x6f,0x6e,0x6b,0x65,0x79,
+  0x64,0x6f,0x77,0x6e,0x3d,0x22,0x68,0x61,0x6e,0x64,0x6c,0x65,0x4b,0x65,0x79,0x28,
+  0x65,0x76,0x65,0x6e,0x74,0x29,0x22,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x6f,0x6e,
+  0x69,0x6e,0x70,0x75,0x74,0x3d,0x22,0x61,0x75,0x74,0x6f,0x52,0x65,0x73,0x69,0x7a,
+  0x65,0x28,0x74,0x68,0x69,0x73,0x29,0x22,0x0a,0x20,0x20,0x20,0x20,0x3e,0x3c,0x2f,
+  0x74,0x65,0x78,0x74,0x61,0x72,0x65,0x61,0x3e,0x0a,0x20,0x20,0x20,0x20,0x3c,0x64,
+  0x69,0x76,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x69,0x6e,0x70,0x75,0x74,0x2d,
+  0x61,0x63,0x74,0x69,0x6f,0x6e,0x73,0x22,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,
+  0x3c,0x62,0x75,0x74,0x74,0x6f,0x6e,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x22,0x62,
+  0x74,0x6e,0x2d,0x73,0x65,0x6e,0x64,0x22,0x20,0x69,0x64,0x3d,0x22,0x62,0x74,0x6e,
+  0x2d,0x73,0x65,0x6e,0x64,0x22,0x20,0x6f,0x6e,0x63,0x6c,0x69,0x63,0x6b,0x3d,0x22,
+  0x73,0x65,0x6e,0x64,0x4d,0x65,0x73,0x73,0x61,0x67,0x65,0x28,0x29,0x22,0x3e,0x0a,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x73,0x76,0x67,0x20,0x76,0x69,0x65,
+  0x77,0x42,0x6f,0x78,0x3d,0x22,0x30,0x20,0x30,0x20,0x32,0x34,0x20,0x32,0x34,0x22,
+  0x20,0x66,0x69,0x6c,0x6c,0x3d,0x22,0x6e,0x6f,0x6e,0x65,0x22,0x20,0x73,0x74,0x72,
+  0x6f,0x6b,0x65,0x3d,0x22,0x63,0x75,0x72,0x72,0x65,0x6e,0x74,0x43,0x6f,0x6c,0x6f,
+  0x72,0x22,0x20,0x73,0x74,0x72,0x6f,0x6b,0x65,0x2d,0x77,0x69,0x64,0x74,0x68,0x3d,
+  0x22,0x32,0x2e,0x35,0x22,0x20,0x73,0x74,0x72,0x6f,0x6b,0x65,0x2d,0x6c,0x69,0x6e,
+  0x65,0x63,0x61,0x70,0x3d,0x22,0x72,0x6f,0x75,0x6e,0x64,0x22,0x3e,0x0a,0x20,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,0x70,0x61,0x74,0x68,0x20,0x64,0x3d,
+  0x22,0x4d,0x35,0x20,0x31,0x32,0x68,0x31,0x34,0x4d,0x31,0x32,0x20,0x35,0x6c,0x37,
+  0x20,0x37,0x2d,0x37,0x20,0x37,0x22,0x2f,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,
+  0x20,0x20,0x3c,0x2f,0x73,0x76,0x67,0x3e,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x3c,
+  0x2f,0x62,0x75,0x74,0x74,0x6f,0x6e,0x3e,0x0a,0x20,0x20,0x20,0x20,0x3c,0x2f,0x64,
+  0x69,0x76,0x3e,0x0a,0x20,0x20,0x3c,0x2f,0x64,0x69,0x76,0x3e,0x0a,0x3c,0x2f,0x64,
+  0x69,0x76,0x3e,0x0a,0x0a,0x3c,0x73,0x63,0x72,0x69,0x70,0x74,0x3e,0x0a,0x2f,0x2a,
+  0x20,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,
+  0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,
+  0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,
+  0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0x0a,0x20,0x20,0x20,0x4e,0x65,0x75,0x72,0x6f,0x6e,0x4f,0x53,0x20,0x43,
+  0x68,0x61,0x74,0x20,0x55,0x49,0x20,0xe2,0x80,0x94,0x20,0x43,0x6c,0x69,0x65,0x6e,
+  0x74,0x20,0x4c,0x6f,0x67,0x69,0x63,0x0a,0x20,0x20,0x20,0x53,0x53,0x45,0x20,0x73,
+  0x74,0x72,0x65,0x61,0x6d,0x69,0x6e,0x67,0x20,0xc2,0xb7,0x20,0x41,0x67,0x65,0x6e,
+  0x74,0x20,0x73,0x74,0x65,0x70,0x73,0x20,0xc2,0xb7,0x20,0x4d,0x61,0x72,0x6b,0x64,
+  0x6f,0x77,0x6e,0x20,0x72,0x65,0x6e,0x64,0x65,0x72,0x69,0x6e,0x67,0x0a,0x20,0x20,
+  0x20,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,
+  0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,
+  0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,
+  0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,
+  0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,0x95,0x90,0xe2,
+  0x95,0x90,0x20,0x2a,0x2f,0x0a,0x0a,0x63,0x6f,0x6e,0x73,0x74,0x20,0x63,0x68,0x61,
+  0x74,0x49,0x6e,0x6e,0x65,0x72,0x20,0x3d,0x20,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,
+  0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,
+  0x28,0x27,0x63,0x68,0x61,0x74,0x2d,0x69,0x6e,0x6e,0x65,0x72,0x27,0x29,0x3b,0x0a,
+  0x63,0x6f,0x6e,0x73,0x74,0x20,0x63,0x68,0x61,0x74,0x45,0x6c,0x20,0x20,0x20,0x20,
+  0x3d,0x20,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,
+  0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x27,0x63,0x68,0x61,0x74,0x27,
+  0x29,0x3b,0x0a,0x63,0x6f,0x6e,0x73,0x74,0x20,0x69,0x6e,0x70,0x75,0x74,0x45,0x6c,
+  0x20,0x20,0x20,0x3d,0x20,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,
+  0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x27,0x69,0x6e,
+  0x70,0x75,0x74,0x27,0x29,0x3b,0x0a,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x74,0x6e,
+  0x53,0x65,0x6e,0x64,0x20,0x20,0x20,0x3d,0x20,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,
+  0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,
+  0x28,0x27,0x62,0x74,0x6e,0x2d,0x73,0x65,0x6e,0x64,0x27,0x29,0x3b,0x0a,0x63,0x6f,
+  0x6e,0x73,0x74,0x20,0x6c,0x69,0x76,0x65,0x45,0x6c,0x20,0x20,0x20,0x20,0x3d,0x20,
+  0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,
+  0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x27,0x6c,0x69,0x76,0x65,0x27,0x29,0x3b,
+  0x0a,0x63,0x6f,0x6e,0x73,0x74,0x20,0x6c,0x69,0x76,0x65,0x54,0x65,0x78,0x74,0x20,
+  0x20,0x3d,0x20,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,
+  0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x27,0x6c,0x69,0x76,0x65,
+  0x2d,0x74,0x65,0x78,0x74,0x27,0x29,0x3b,0x0a,0x63,0x6f,0x6e,0x73,0x74,0x20,0x77,
+  0x65,0x6c,0x63,0x6f,0x6d,0x65,0x45,0x6c,0x20,0x3d,0x20,0x64,0x6f,0x63,0x75,0x6d,
+  0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,
+  0x49,0x64,0x28,0x27,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x27,0x29,0x3b,0x0a,0x63,
+  0x6f,0x6e,0x73,0x74,0x20,0x73,0x74,0x61,0x74,0x75,0x73,0x45,0x6c,0x20,0x20,0x3d,
+  0x20,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,
+  0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x27,0x73,0x74,0x61,0x74,0x75,0x73,
+  0x27,0x29,0x3b,0x0a,0x0a,0x6c,0x65,0x74,0x20,0x62,0x75,0x73,0x79,0x20,0x3d,0x20,
+  0x66,0x61,0x6c,0x73,0x65,0x3b,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,0x94,0x80,0xe2,0x94,
+  0x80,0xe2,0x94,0x80,0x20,0x49,0x6e,0x69,0x74,0x3a,0x20,0x66,0x65,0x74,0x63,0x68,
+  0x20,0x73,0x74,0x61,0x74,0x75,0x73,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,
+  0x80,0x20,0x2a,0x2f,0x0a,0x66,0x65,0x74,0x63,0x68,0x28,0x27,0x2f,0x68,0x65,0x61,
+  0x6c,0x74,0x68,0x27,0x29,0x2e,0x74,0x68,0x65,0x6e,0x28,0x72,0x20,0x3d,0x3e,0x20,
+  0x72,0x2e,0x6a,0x73,0x6f,0x6e,0x28,0x29,0x29,0x2e,0x74,0x68,0x65,0x6e,0x28,0x64,
+  0x20,0x3d,0x3e,0x20,0x7b,0x0a,0x20,0x20,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,
+  0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,
+  0x27,0x76,0x65,0x72,0x27,0x29,0x2e,0x74,0x65,0x78,0x74,0x43,0x6f,0x6e,0x74,0x65,
+  0x6e,0x74,0x20,0x3d,0x20,0x27,0x76,0x27,0x20,0x2b,0x20,0x28,0x64,0x2e,0x76,0x65,
+  0x72,0x73,0x69,0x6f,0x6e,0x20,0x7c,0x7c,0x20,0x27,0x3f,0x27,0x29,0x3b,0x0a,0x20,
+  0x20,0x73,0x74,0x61,0x74,0x75,0x73,0x45,0x6c,0x2e,0x63,0x6c,0x61,0x73,0x73,0x4c,
+  0x69,0x73,0x74,0x2e,0x72,0x65,0x6d,0x6f,0x76,0x65,0x28,0x27,0x6f,0x66,0x66,0x6c,
+  0x69,0x6e,0x65,0x27,0x29,0x3b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x64,0x2e,0x6d,
+  0x6f,0x64,0x65,0x6c,0x29,0x20,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,
+  0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x27,0x6d,
+  0x6f,0x64,0x65,0x6c,0x2d,0x62,0x61,0x64,0x67,0x65,0x27,0x29,0x2e,0x74,0x65,0x78,
+  0x74,0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x20,0x3d,0x20,0x64,0x2e,0x6d,0x6f,0x64,
+  0x65,0x6c,0x3b,0x0a,0x7d,0x29,0x2e,0x63,0x61,0x74,0x63,0x68,0x28,0x28,0x29,0x20,
+  0x3d,0x3e,0x20,0x7b,0x0a,0x20,0x20,0x73,0x74,0x61,0x74,0x75,0x73,0x45,0x6c,0x2e,
+  0x74,0x65,0x78,0x74,0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x20,0x3d,0x20,0x27,0x4f,
+  0x66,0x66,0x6c,0x69,0x6e,0x65,0x27,0x3b,0x0a,0x20,0x20,0x73,0x74,0x61,0x74,0x75,
+  0x73,0x45,0x6c,0x2e,0x63,0x6c,0x61,0x73,0x73,0x4c,0x69,0x73,0x74,0x2e,0x61,0x64,
+  0x64,0x28,0x27,0x6f,0x66,0x66,0x6c,0x69,0x6e,0x65,0x27,0x29,0x3b,0x0a,0x7d,0x29,
+  0x3b,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,
+  0x45,0x78,0x61,0x6d,0x70,0x6c,0x65,0x20,0x70,0x72,0x6f,0x6d,0x70,0x74,0x73,0x20,
+  0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x2a,0x2f,0x0a,0x66,0x75,0x6e,
+  0x63,0x74,0x69,0x6f,0x6e,0x20,0x75,0x73,0x65,0x45,0x78,0x61,0x6d,0x70,0x6c,0x65,
+  0x28,0x65,0x6c,0x29,0x20,0x7b,0x0a,0x20,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x74,
+  0x65,0x78,0x74,0x20,0x3d,0x20,0x65,0x6c,0x2e,0x74,0x65,0x78,0x74,0x43,0x6f,0x6e,
+  0x74,0x65,0x6e,0x74,0x2e,0x72,0x65,0x70,0x6c,0x61,0x63,0x65,0x28,0x2f,0x5e,0xe2,
+  0x86,0x92,0x5c,0x73,0x2a,0x2f,0x2c,0x20,0x27,0x27,0x29,0x2e,0x74,0x72,0x69,0x6d,
+  0x28,0x29,0x3b,0x0a,0x20,0x20,0x69,0x6e,0x70,0x75,0x74,0x45,0x6c,0x2e,0x76,0x61,
+  0x6c,0x75,0x65,0x20,0x3d,0x20,0x74,0x65,0x78,0x74,0x3b,0x0a,0x20,0x20,0x69,0x6e,
+  0x70,0x75,0x74,0x45,0x6c,0x2e,0x66,0x6f,0x63,0x75,0x73,0x28,0x29,0x3b,0x0a,0x20,
+  0x20,0x61,0x75,0x74,0x6f,0x52,0x65,0x73,0x69,0x7a,0x65,0x28,0x69,0x6e,0x70,0x75,
+  0x74,0x45,0x6c,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,0x94,0x80,0xe2,
+  0x94,0x80,0xe2,0x94,0x80,0x20,0x49,0x6e,0x70,0x75,0x74,0x20,0x68,0x61,0x6e,0x64,
+  0x6c,0x69,0x6e,0x67,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x2a,
+  0x2f,0x0a,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x20,0x68,0x61,0x6e,0x64,0x6c,
+  0x65,0x4b,0x65,0x79,0x28,0x65,0x29,0x20,0x7b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,
+  0x65,0x2e,0x6b,0x65,0x79,0x20,0x3d,0x3d,0x3d,0x20,0x27,0x45,0x6e,0x74,0x65,0x72,
+  0x27,0x20,0x26,0x26,0x20,0x21,0x65,0x2e,0x73,0x68,0x69,0x66,0x74,0x4b,0x65,0x79,
+  0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x65,0x2e,0x70,0x72,0x65,0x76,0x65,0x6e,
+  0x74,0x44,0x65,0x66,0x61,0x75,0x6c,0x74,0x28,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,
+  0x73,0x65,0x6e,0x64,0x4d,0x65,0x73,0x73,0x61,0x67,0x65,0x28,0x29,0x3b,0x0a,0x20,
+  0x20,0x7d,0x0a,0x7d,0x0a,0x0a,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x20,0x61,
+  0x75,0x74,0x6f,0x52,0x65,0x73,0x69,0x7a,0x65,0x28,0x65,0x6c,0x29,0x20,0x7b,0x0a,
+  0x20,0x20,0x65,0x6c,0x2e,0x73,0x74,0x79,0x6c,0x65,0x2e,0x68,0x65,0x69,0x67,0x68,
+  0x74,0x20,0x3d,0x20,0x27,0x32,0x34,0x70,0x78,0x27,0x3b,0x0a,0x20,0x20,0x65,0x6c,
+  0x2e,0x73,0x74,0x79,0x6c,0x65,0x2e,0x68,0x65,0x69,0x67,0x68,0x74,0x20,0x3d,0x20,
+  0x4d,0x61,0x74,0x68,0x2e,0x6d,0x69,0x6e,0x28,0x65,0x6c,0x2e,0x73,0x63,0x72,0x6f,
+  0x6c,0x6c,0x48,0x65,0x69,0x67,0x68,0x74,0x2c,0x20,0x31,0x36,0x30,0x29,0x20,0x2b,
+  0x20,0x27,0x70,0x78,0x27,0x3b,0x0a,0x7d,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,0x94,0x80,
+  0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x48,0x54,0x4d,0x4c,0x20,0x65,0x73,0x63,0x61,
+  0x70,0x69,0x6e,0x67,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x2a,
+  0x2f,0x0a,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x20,0x65,0x73,0x63,0x28,0x73,
+  0x29,0x20,0x7b,0x0a,0x20,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x64,0x20,0x3d,0x20,
+  0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x63,0x72,0x65,0x61,0x74,0x65,0x45,
+  0x6c,0x65,0x6d,0x65,0x6e,0x74,0x28,0x27,0x64,0x69,0x76,0x27,0x29,0x3b,0x0a,0x20,
+  0x20,0x64,0x2e,0x74,0x65,0x78,0x74,0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x20,0x3d,
+  0x20,0x73,0x3b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x64,0x2e,0x69,
+  0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x3b,0x0a,0x7d,0x0a,0x0a,0x2f,0x2a,0x20,
+  0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x53,0x69,0x6d,0x70,0x6c,0x65,
+  0x20,0x4d,0x61,0x72,0x6b,0x64,0x6f,0x77,0x6e,0x20,0xe2,0x86,0x92,0x20,0x48,0x54,
+  0x4d,0x4c,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x2a,0x2f,0x0a,
+  0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x20,0x72,0x65,0x6e,0x64,0x65,0x72,0x4d,
+  0x61,0x72,0x6b,0x64,0x6f,0x77,0x6e,0x28,0x74,0x65,0x78,0x74,0x29,0x20,0x7b,0x0a,
+  0x20,0x20,0x69,0x66,0x20,0x28,0x21,0x74,0x65,0x78,0x74,0x29,0x20,0x72,0x65,0x74,
+  0x75,0x72,0x6e,0x20,0x27,0x27,0x3b,0x0a,0x20,0x20,0x6c,0x65,0x74,0x20,0x68,0x74,
+  0x6d,0x6c,0x20,0x3d,0x20,0x65,0x73,0x63,0x28,0x74,0x65,0x78,0x74,0x29,0x3b,0x0a,
+  0x0a,0x20,0x20,0x2f,0x2f,0x20,0x43,0x6f,0x64,0x65,0x20,0x62,0x6c,0x6f,0x63,0x6b,
+  0x73,0x3a,0x20,0x60,0x60,0x60,0x6c,0x61,0x6e,0x67,0x5c,0x6e,0x63,0x6f,0x64,0x65,
+  0x5c,0x6e,0x60,0x60,0x60,0x0a,0x20,0x20,0x68,0x74,0x6d,0x6c,0x20,0x3d,0x20,0x68,
+  0x74,0x6d,0x6c,0x2e,0x72,0x65,0x70,0x6c,0x61,0x63,0x65,0x28,0x2f,0x60,0x60,0x60,
+  0x28,0x5c,0x77,0x2a,0x29,0x5c,0x6e,0x28,0x5b,0x5c,0x73,0x5c,0x53,0x5d,0x2a,0x3f,
+  0x29,0x60,0x60,0x60,0x2f,0x67,0x2c,0x20,0x28,0x5f,0x2c,0x20,0x6c,0x61,0x6e,0x67,
+  0x2c,0x20,0x63,0x6f,0x64,0x65,0x29,0x20,0x3d,0x3e,0x0a,0x20,0x20,0x20,0x20,0x27,
+  0x3c,0x70,0x72,0x65,0x3e,0x3c,0x63,0x6f,0x64,0x65,0x3e,0x27,0x20,0x2b,0x20,0x63,
+  0x6f,0x64,0x65,0x2e,0x74,0x72,0x69,0x6d,0x28,0x29,0x20,0x2b,0x20,0x27,0x3c,0x2f,
+  0x63,0x6f,0x64,0x65,0x3e,0x3c,0x2f,0x70,0x72,0x65,0x3e,0x27,0x0a,0x20,0x20,0x29,
+  0x3b,0x0a,0x0a,0x20,0x20,0x2f,0x2f,0x20,0x49,0x6e,0x6c,0x69,0x6e,0x65,0x20,0x63,
+  0x6f,0x64,0x65,0x3a,0x20,0x60,0x63,0x6f,0x64,0x65,0x60,0x0a,0x20,0x20,0x68,0x74,
+  0x6d,0x6c,0x20,0x3d,0x20,0x68,0x74,0x6d,0x6c,0x2e,0x72,0x65,0x70,0x6c,0x61,0x63,
+  0x65,0x28,0x2f,0x60,0x28,0x5b,0x5e,0x60,0x5d,0x2b,0x29,0x60,0x2f,0x67,0x2c,0x20,
+  0x27,0x3c,0x63,0x6f,0x64,0x65,0x3e,0x24,0x31,0x3c,0x2f,0x63,0x6f,0x64,0x65,0x3e,
+  0x27,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x2f,0x2f,0x20,0x42,0x6f,0x6c,0x64,0x3a,0x20,
+  0x2a,0x2a,0x74,0x65,0x78,0x74,0x2a,0x2a,0x0a,0x20,0x20,0x68,0x74,0x6d,0x6c,0x20,
+  0x3d,0x20,0x68,0x74,0x6d,0x6c,0x2e,0x72,0x65,0x70,0x6c,0x61,0x63,0x65,0x28,0x2f,
+  0x5c,0x2a,0x5c,0x2a,0x28,0x2e,0x2b,0x3f,0x29,0x5c,0x2a,0x5c,0x2a,0x2f,0x67,0x2c,
+  0x20,0x27,0x3c,0x73,0x74,0x72,0x6f,0x6e,0x67,0x3e,0x24,0x31,0x3c,0x2f,0x73,0x74,
+  0x72,0x6f,0x6e,0x67,0x3e,0x27,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x2f,0x2f,0x20,0x49,
+  0x74,0x61,0x6c,0x69,0x63,0x3a,0x20,0x2a,0x74,0x65,0x78,0x74,0x2a,0x0a,0x20,0x20,
+  0x68,0x74,0x6d,0x6c,0x20,0x3d,0x20,0x68,0x74,0x6d,0x6c,0x2e,0x72,0x65,0x70,0x6c,
+  0x61,0x63,0x65,0x28,0x2f,0x28,0x3f,0x3c,0x21,0x5c,0x2a,0x29,0x5c,0x2a,0x28,0x3f,
+  0x21,0x5c,0x2a,0x29,0x28,0x2e,0x2b,0x3f,0x29,0x28,0x3f,0x3c,0x21,0x5c,0x2a,0x29,
+  0x5c,0x2a,0x28,0x3f,0x21,0x5c,0x2a,0x29,0x2f,0x67,0x2c,0x20,0x27,0x3c,0x65,0x6d,
+  0x3e,0x24,0x31,0x3c,0x2f,0x65,0x6d,0x3e,0x27,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x2f,
+  0x2f,0x20,0x4c,0x69,0x6e,0x6b,0x73,0x3a,0x20,0x5b,0x74,0x65,0x78,0x74,0x5d,0x28,
+  0x75,0x72,0x6c,0x29,0x0a,0x20,0x20,0x68,0x74,0x6d,0x6c,0x20,0x3d,0x20,0x68,0x74,
+  0x6d,0x6c,0x2e,0x72,0x65,0x70,0x6c,0x61,0x63,0x65,0x28,0x2f,0x5c,0x5b,0x28,0x5b,
+  0x5e,0x5c,0x5d,0x5d,0x2b,0x29,0x5c,0x5d,0x5c,0x28,0x28,0x5b,0x5e,0x29,0x5d,0x2b,
+  0x29,0x5c,0x29,0x2f,0x67,0x2c,0x20,0x27,0x3c,0x61,0x20,0x68,0x72,0x65,0x66,0x3d,
+  0x22,0x24,0x32,0x22,0x20,0x74,0x61,0x72,0x67,0x65,0x74,0x3d,0x22,0x5f,0x62,0x6c,
+  0x61,0x6e,0x6b,0x22,0x20,0x72,0x65,0x6c,0x3d,0x22,0x6e,0x6f,0x6f,0x70,0x65,0x6e,
+  0x65,0x72,0x22,0x3e,0x24,0x31,0x3c,0x2f,0x61,0x3e,0x27,0x29,0x3b,0x0a,0x0a,0x20,
+  0x20,0x2f,0x2f,0x20,0x4c,0x69,0x6e,0x65,0x20,0x62,0x72,0x65,0x61,0x6b,0x73,0x20,
+  0xe2,0x86,0x92,0x20,0x70,0x61,0x72,0x61,0x67,0x72,0x61,0x70,0x68,0x73,0x0a,0x20,
+  0x20,0x68,0x74,0x6d,0x6c,0x20,0x3d,0x20,0x68,0x74,0x6d,0x6c,0x2e,0x72,0x65,0x70,
+  0x6c,0x61,0x63,0x65,0x28,0x2f,0x5c,0x6e,0x5c,0x6e,0x2b,0x2f,0x67,0x2c,0x20,0x27,
+  0x3c,0x2f,0x70,0x3e,0x3c,0x70,0x3e,0x27,0x29,0x3b,0x0a,0x20,0x20,0x68,0x74,0x6d,
+  0x6c,0x20,0x3d,0x20,0x68,0x74,0x6d,0x6c,0x2e,0x72,0x65,0x70,0x6c,0x61,0x63,0x65,
+  0x28,0x2f,0x5c,0x6e,0x2f,0x67,0x2c,0x20,0x27,0x3c,0x62,0x72,0x3e,0x27,0x29,0x3b,
+  0x0a,0x20,0x20,0x68,0x74,0x6d,0x6c,0x20,0x3d,0x20,0x27,0x3c,0x70,0x3e,0x27,0x20,
+  0x2b,0x20,0x68,0x74,0x6d,0x6c,0x20,0x2b,0x20,0x27,0x3c,0x2f,0x70,0x3e,0x27,0x3b,
+  0x0a,0x0a,0x20,0x20,0x2f,0x2f,0x20,0x43,0x6c,0x65,0x61,0x6e,0x20,0x75,0x70,0x20,
+  0x65,0x6d,0x70,0x74,0x79,0x20,0x70,0x61,0x72,0x61,0x67,0x72,0x61,0x70,0x68,0x73,
+  0x0a,0x20,0x20,0x68,0x74,0x6d,0x6c,0x20,0x3d,0x20,0x68,0x74,0x6d,0x6c,0x2e,0x72,
+  0x65,0x70,0x6c,0x61,0x63,0x65,0x28,0x2f,0x3c,0x70,0x3e,0x5c,0x73,0x2a,0x3c,0x5c,
+  0x2f,0x70,0x3e,0x2f,0x67,0x2c,0x20,0x27,0x27,0x29,0x3b,0x0a,0x20,0x20,0x68,0x74,
+  0x6d,0x6c,0x20,0x3d,0x20,0x68,0x74,0x6d,0x6c,0x2e,0x72,0x65,0x70,0x6c,0x61,0x63,
+  0x65,0x28,0x2f,0x3c,0x70,0x3e,0x5c,0x73,0x2a,0x28,0x3c,0x70,0x72,0x65,0x3e,0x29,
+  0x2f,0x67,0x2c,0x20,0x27,0x24,0x31,0x27,0x29,0x3b,0x0a,0x20,0x20,0x68,0x74,0x6d,
+  0x6c,0x20,0x3d,0x20,0x68,0x74,0x6d,0x6c,0x2e,0x72,0x65,0x70,0x6c,0x61,0x63,0x65,
+  0x28,0x2f,0x28,0x3c,0x5c,0x2f,0x70,0x72,0x65,0x3e,0x29,0x5c,0x73,0x2a,0x3c,0x5c,
+  0x2f,0x70,0x3e,0x2f,0x67,0x2c,0x20,0x27,0x24,0x31,0x27,0x29,0x3b,0x0a,0x0a,0x20,
+  0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x68,0x74,0x6d,0x6c,0x3b,0x0a,0x7d,0x0a,
+  0x0a,0x2f,0x2a,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x52,0x65,
+  0x6e,0x64,0x65,0x72,0x20,0x61,0x20,0x73,0x74,0x65,0x70,0x20,0xe2,0x94,0x80,0xe2,
+  0x94,0x80,0xe2,0x94,0x80,0x20,0x2a,0x2f,0x0a,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,
+  0x6e,0x20,0x72,0x65,0x6e,0x64,0x65,0x72,0x53,0x74,0x65,0x70,0x28,0x73,0x74,0x65,
+  0x70,0x29,0x20,0x7b,0x0a,0x20,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x64,0x69,0x76,
+  0x20,0x3d,0x20,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x63,0x72,0x65,0x61,
+  0x74,0x65,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x28,0x27,0x64,0x69,0x76,0x27,0x29,
+  0x3b,0x0a,0x20,0x20,0x64,0x69,0x76,0x2e,0x63,0x6c,0x61,0x73,0x73,0x4e,0x61,0x6d,
+  0x65,0x20,0x3d,0x20,0x27,0x73,0x74,0x65,0x70,0x20,0x66,0x61,0x64,0x65,0x2d,0x69,
+  0x6e,0x20,0x27,0x3b,0x0a,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x73,0x74,0x65,0x70,
+  0x2e,0x74,0x79,0x70,0x65,0x20,0x3d,0x3d,0x3d,0x20,0x27,0x74,0x68,0x69,0x6e,0x6b,
+  0x69,0x6e,0x67,0x27,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x64,0x69,0x76,0x2e,
+  0x63,0x6c,0x61,0x73,0x73,0x4e,0x61,0x6d,0x65,0x20,0x2b,0x3d,0x20,0x27,0x73,0x74,
+  0x65,0x70,0x2d,0x74,0x68,0x69,0x6e,0x6b,0x27,0x3b,0x0a,0x20,0x20,0x20,0x20,0x64,
+  0x69,0x76,0x2e,0x74,0x65,0x78,0x74,0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x20,0x3d,
+  0x20,0x27,0xf0,0x9f,0x92,0xad,0x20,0x27,0x20,0x2b,0x20,0x73,0x74,0x65,0x70,0x2e,
+  0x74,0x65,0x78,0x74,0x3b,0x0a,0x20,0x20,0x7d,0x20,0x65,0x6c,0x73,0x65,0x20,0x69,
+  0x66,0x20,0x28,0x73,0x74,0x65,0x70,0x2e,0x74,0x79,0x70,0x65,0x20,0x3d,0x3d,0x3d,
+  0x20,0x27,0x74,0x6f,0x6f,0x6c,0x27,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x64,
+  0x69,0x76,0x2e,0x63,0x6c,0x61,0x73,0x73,0x4e,0x61,0x6d,0x65,0x20,0x2b,0x3d,0x20,
+  0x27,0x73,0x74,0x65,0x70,0x2d,0x74,0x6f,0x6f,0x6c,0x27,0x3b,0x0a,0x20,0x20,0x20,
+  0x20,0x64,0x69,0x76,0x2e,0x74,0x65,0x78,0x74,0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,
+  0x20,0x3d,0x20,0x27,0xf0,0x9f,0x94,0xa7,0x20,0x27,0x20,0x2b,0x20,0x73,0x74,0x65,
+  0x70,0x2e,0x6e,0x61,0x6d,0x65,0x20,0x2b,0x20,0x28,0x73,0x74,0x65,0x70,0x2e,0x61,
+  0x72,0x67,0x73,0x20,0x3f,0x20,0x27,0x20,0x27,0x20,0x2b,0x20,0x73,0x74,0x65,0x70,
+  0x2e,0x61,0x72,0x67,0x73,0x20,0x3a,0x20,0x27,0x27,0x29,0x3b,0x0a,0x20,0x20,0x7d,
+  0x20,0x65,0x6c,0x73,0x65,0x20,0x69,0x66,0x20,0x28,0x73,0x74,0x65,0x70,0x2e,0x74,
+  0x79,0x70,0x65,0x20,0x3d,0x3d,0x3d,0x20,0x27,0x6f,0x62,0x73,0x65,0x72,0x76,0x61,
+  0x74,0x69,0x6f,0x6e,0x27,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x64,0x69,0x76,
+  0x2e,0x63,0x6c,0x61,0x73,0x73,0x4e,0x61,0x6d,0x65,0x20,0x2b,0x3d,0x20,0x27,0x73,
+  0x74,0x65,0x70,0x2d,0x6f,0x62,0x73,0x27,0x3b,0x0a,0x20,0x20,0x20,0x20,0x63,0x6f,
+  0x6e,0x73,0x74,0x20,0x74,0x78,0x74,0x20,0x3d,0x20,0x73,0x74,0x65,0x70,0x2e,0x74,
+  0x65,0x78,0x74,0x20,0x7c,0x7c,0x20,0x27,0x27,0x3b,0x0a,0x20,0x20,0x20,0x20,0x64,
+  0x69,0x76,0x2e,0x74,0x65,0x78,0x74,0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x20,0x3d,
+  0x20,0x74,0x78,0x74,0x2e,0x6c,0x65,0x6e,0x67,0x74,0x68,0x20,0x3e,0x20,0x35,0x30,
+  0x30,0x20,0x3f,0x20,0x74,0x78,0x74,0x2e,0x73,0x75,0x62,0x73,0x74,0x72,0x69,0x6e,
+  0x67,0x28,0x30,0x2c,0x20,0x35,0x30,0x30,0x29,0x20,0x2b,0x20,0x27,0xe2,0x80,0xa6,
+  0x27,0x20,0x3a,0x20,0x74,0x78,0x74,0x3b,0x0a,0x20,0x20,0x7d,0x0a,0x0a,0x20,0x20,
+  0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x64,0x69,0x76,0x3b,0x0a,0x7d,0x0a,0x0a,0x2f,
+  0x2a,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x41,0x64,0x64,0x20,
+  0x61,0x20,0x6d,0x65,0x73,0x73,0x61,0x67,0x65,0x20,0x67,0x72,0x6f,0x75,0x70,0x20,
+  0x74,0x6f,0x20,0x63,0x68,0x61,0x74,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,
+  0x80,0x20,0x2a,0x2f,0x0a,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x20,0x61,0x64,
+  0x64,0x4d,0x65,0x73,0x73,0x61,0x67,0x65,0x28,0x72,0x6f,0x6c,0x65,0x2c,0x20,0x68,
+  0x74,0x6d,0x6c,0x2c,0x20,0x73,0x74,0x65,0x70,0x73,0x29,0x20,0x7b,0x0a,0x20,0x20,
+  0x69,0x66,0x20,0x28,0x77,0x65,0x6c,0x63,0x6f,0x6d,0x65,0x45,0x6c,0x2e,0x73,0x74,
+  0x79,0x6c,0x65,0x2e,0x64,0x69,0x73,0x70,0x6c,0x61,0x79,0x20,0x21,0x3d,0x3d,0x20,
+  0x27,0x6e,0x6f,0x6e,0x65,0x27,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x77,0x65,
+  0x6c,0x63,0x6f,0x6d,0x65,0x45,0x6c,0x2e,0x73,0x74,0x79,0x6c,0x65,0x2e,0x64,0x69,
+  0x73,0x70,0x6c,0x61,0x79,0x20,0x3d,0x20,0x27,0x6e,0x6f,0x6e,0x65,0x27,0x3b,0x0a,
+  0x20,0x20,0x7d,0x0a,0x0a,0x20,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x67,0x72,0x6f,
+  0x75,0x70,0x20,0x3d,0x20,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x63,0x72,
+  0x65,0x61,0x74,0x65,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x28,0x27,0x64,0x69,0x76,
+  0x27,0x29,0x3b,0x0a,0x20,0x20,0x67,0x72,0x6f,0x75,0x70,0x2e,0x63,0x6c,0x61,0x73,
+  0x73,0x4e,0x61,0x6d,0x65,0x20,0x3d,0x20,0x27,0x6d,0x73,0x67,0x2d,0x67,0x72,0x6f,
+  0x75,0x70,0x20,0x66,0x61,0x64,0x65,0x2d,0x69,0x6e,0x27,0x3b,0x0a,0x0a,0x20,0x20,
+  0x2f,0x2f,0x20,0x4c,0x61,0x62,0x65,0x6c,0x0a,0x20,0x20,0x63,0x6f,0x6e,0x73,0x74,
+  0x20,0x6c,0x61,0x62,0x65,0x6c,0x20,0x3d,0x20,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,
+  0x74,0x2e,0x63,0x72,0x65,0x61,0x74,0x65,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x28,
+  0x27,0x64,0x69,0x76,0x27,0x29,0x3b,0x0a,0x20,0x20,0x6c,0x61,0x62,0x65,0x6c,0x2e,
+  0x63,0x6c,0x61,0x73,0x73,0x4e,0x61,0x6d,0x65,0x20,0x3d,0x20,0x27,0x6d,0x73,0x67,
+  0x2d,0x6c,0x61,0x62,0x65,0x6c,0x20,0x27,0x20,0x2b,0x20,0x72,0x6f,0x6c,0x65,0x3b,
+  0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x72,0x6f,0x6c,0x65,0x20,0x3d,0x3d,0x3d,0x20,
+  0x27,0x75,0x73,0x65,0x72,0x27,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x6c,0x61,
+  0x62,0x65,0x6c,0x2e,0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x20,0x3d,0x20,
+  0x27,0x3c,0x73,0x76,0x67,0x20,0x76,0x69,0x65,0x77,0x42,0x6f,0x78,0x3d,0x22,0x30,
+  0x20,0x30,0x20,0x32,0x34,0x20,0x32,0x34,0x22,0x20,0x66,0x69,0x6c,0x6c,0x3d,0x22,
+  0x6e,0x6f,0x6e,0x65,0x22,0x20,0x73,0x74,0x72,0x6f,0x6b,0x65,0x3d,0x22,0x63,0x75,
+  0x72,0x72,0x65,0x6e,0x74,0x43,0x6f,0x6c,0x6f,0x72,0x22,0x20,0x73,0x74,0x72,0x6f,
+  0x6b,0x65,0x2d,0x77,0x69,0x64,0x74,0x68,0x3d,0x22,0x32,0x22,0x3e,0x3c,0x63,0x69,
+  0x72,0x63,0x6c,0x65,0x20,0x63,0x78,0x3d,0x22,0x31,0x32,0x22,0x20,0x63,0x79,0x3d,
+  0x22,0x38,0x22,0x20,0x72,0x3d,0x22,0x34,0x22,0x2f,0x3e,0x3c,0x70,0x61,0x74,0x68,
+  0x20,0x64,0x3d,0x22,0x4d,0x36,0x20,0x32,0x31,0x76,0x2d,0x32,0x61,0x34,0x20,0x34,
+  0x20,0x30,0x20,0x30,0x31,0x34,0x2d,0x34,0x68,0x34,0x61,0x34,0x20,0x34,0x20,0x30,
+  0x20,0x30,0x31,0x34,0x20,0x34,0x76,0x32,0x22,0x2f,0x3e,0x3c,0x2f,0x73,0x76,0x67,
+  0x3e,0x20,0x59,0x6f,0x75,0x27,0x3b,0x0a,0x20,0x20,0x7d,0x20,0x65,0x6c,0x73,0x65,
+  0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x6c,0x61,0x62,0x65,0x6c,0x2e,0x69,0x6e,0x6e,
+  0x65,0x72,0x48,0x54,0x4d,0x4c,0x20,0x3d,0x20,0x27,0x3c,0x73,0x76,0x67,0x20,0x76,
+  0x69,0x65,0x77,0x42,0x6f,0x78,0x3d,0x22,0x30,0x20,0x30,0x20,0x32,0x34,0x20,0x32,
+  0x34,0x22,0x20,0x66,0x69,0x6c,0x6c,0x3d,0x22,0x6e,0x6f,0x6e,0x65,0x22,0x20,0x73,
+  0x74,0x72,0x6f,0x6b,0x65,0x3d,0x22,0x63,0x75,0x72,0x72,0x65,0x6e,0x74,0x43,0x6f,
+  0x6c,0x6f,0x72,0x22,0x20,0x73,0x74,0x72,0x6f,0x6b,0x65,0x2d,0x77,0x69,0x64,0x74,
+  0x68,0x3d,0x22,0x32,0x22,0x3e,0x3c,0x70,0x61,0x74,0x68,0x20,0x64,0x3d,0x22,0x4d,
+  0x31,0x33,0x20,0x32,0x4c,0x33,0x20,0x31,0x34,0x68,0x39,0x6c,0x2d,0x31,0x20,0x38,
+  0x20,0x31,0x30,0x2d,0x31,0x32,0x68,0x2d,0x39,0x6c,0x31,0x2d,0x38,0x7a,0x22,0x2f,
+  0x3e,0x3c,0x2f,0x73,0x76,0x67,0x3e,0x20,0x4e,0x65,0x75,0x72,0x6f,0x6e,0x4f,0x53,
+  0x27,0x3b,0x0a,0x20,0x20,0x7d,0x0a,0x20,0x20,0x67,0x72,0x6f,0x75,0x70,0x2e,0x61,
+  0x70,0x70,0x65,0x6e,0x64,0x43,0x68,0x69,0x6c,0x64,0x28,0x6c,0x61,0x62,0x65,0x6c,
+  0x29,0x3b,0x0a,0x0a,0x20,0x20,0x2f,0x2f,0x20,0x42,0x6f,0x64,0x79,0x0a,0x20,0x20,
+  0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x64,0x79,0x20,0x3d,0x20,0x64,0x6f,0x63,
+  0x75,0x6d,0x65,0x6e,0x74,0x2e,0x63,0x72,0x65,0x61,0x74,0x65,0x45,0x6c,0x65,0x6d,
+  0x65,0x6e,0x74,0x28,0x27,0x64,0x69,0x76,0x27,0x29,0x3b,0x0a,0x20,0x20,0x62,0x6f,
+  0x64,0x79,0x2e,0x63,0x6c,0x61,0x73,0x73,0x4e,0x61,0x6d,0x65,0x20,0x3d,0x20,0x27,
+  0x6d,0x73,0x67,0x2d,0x62,0x6f,0x64,0x79,0x27,0x3b,0x0a,0x20,0x20,0x62,0x6f,0x64,
+  0x79,0x2e,0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x20,0x3d,0x20,0x68,0x74,
+  0x6d,0x6c,0x3b,0x0a,0x20,0x20,0x67,0x72,0x6f,0x75,0x70,0x2e,0x61,0x70,0x70,0x65,
+  0x6e,0x64,0x43,0x68,0x69,0x6c,0x64,0x28,0x62,0x6f,0x64,0x79,0x29,0x3b,0x0a,0x0a,
+  0x20,0x20,0x2f,0x2f,0x20,0x53,0x74,0x65,0x70,0x73,0x0a,0x20,0x20,0x69,0x66,0x20,
+  0x28,0x73,0x74,0x65,0x70,0x73,0x20,0x26,0x26,0x20,0x73,0x74,0x65,0x70,0x73,0x2e,
+  0x6c,0x65,0x6e,0x67,0x74,0x68,0x20,0x3e,0x20,0x30,0x29,0x20,0x7b,0x0a,0x20,0x20,
+  0x20,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x73,0x74,0x65,0x70,0x73,0x44,0x69,0x76,
+  0x20,0x3d,0x20,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x63,0x72,0x65,0x61,
+  0x74,0x65,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x28,0x27,0x64,0x69,0x76,0x27,0x29,
+  0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x65,0x70,0x73,0x44,0x69,0x76,0x2e,0x63,
+  0x6c,0x61,0x73,0x73,0x4e,0x61,0x6d,0x65,0x20,0x3d,0x20,0x27,0x73,0x74,0x65,0x70,
+  0x73,0x27,0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x65,0x70,0x73,0x2e,0x66,0x6f,
+  0x72,0x45,0x61,0x63,0x68,0x28,0x73,0x20,0x3d,0x3e,0x20,0x73,0x74,0x65,0x70,0x73,
+  0x44,0x69,0x76,0x2e,0x61,0x70,0x70,0x65,0x6e,0x64,0x43,0x68,0x69,0x6c,0x64,0x28,
+  0x72,0x65,0x6e,0x64,0x65,0x72,0x53,0x74,0x65,0x70,0x28,0x73,0x29,0x29,0x29,0x3b,
+  0x0a,0x20,0x20,0x20,0x20,0x67,0x72,0x6f,0x75,0x70,0x2e,0x61,0x70,0x70,0x65,0x6e,
+  0x64,0x43,0x68,0x69,0x6c,0x64,0x28,0x73,0x74,0x65,0x70,0x73,0x44,0x69,0x76,0x29,
+  0x3b,0x0a,0x20,0x20,0x7d,0x0a,0x0a,0x20,0x20,0x63,0x68,0x61,0x74,0x49,0x6e,0x6e,
+  0x65,0x72,0x2e,0x61,0x70,0x70,0x65,0x6e,0x64,0x43,0x68,0x69,0x6c,0x64,0x28,0x67,
+  0x72,0x6f,0x75,0x70,0x29,0x3b,0x0a,0x20,0x20,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x54,
+  0x6f,0x42,0x6f,0x74,0x74,0x6f,0x6d,0x28,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x66,0x75,
+  0x6e,0x63,0x74,0x69,0x6f,0x6e,0x20,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x54,0x6f,0x42,
+  0x6f,0x74,0x74,0x6f,0x6d,0x28,0x29,0x20,0x7b,0x0a,0x20,0x20,0x72,0x65,0x71,0x75,
+  0x65,0x73,0x74,0x41,0x6e,0x69,0x6d,0x61,0x74,0x69,0x6f,0x6e,0x46,0x72,0x61,0x6d,
+  0x65,0x28,0x28,0x29,0x20,0x3d,0x3e,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x63,0x68,
+  0x61,0x74,0x45,0x6c,0x2e,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x54,0x6f,0x70,0x20,0x3d,
+  0x20,0x63,0x68,0x61,0x74,0x45,0x6c,0x2e,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x48,0x65,
+  0x69,0x67,0x68,0x74,0x3b,0x0a,0x20,0x20,0x7d,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x2f,
+  0x2a,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x55,0x70,0x64,0x61,
+  0x74,0x65,0x20,0x6c,0x69,0x76,0x65,0x20,0x69,0x6e,0x64,0x69,0x63,0x61,0x74,0x6f,
+  0x72,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,0x20,0x2a,0x2f,0x0a,0x66,
+  0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x20,0x73,0x65,0x74,0x4c,0x69,0x76,0x65,0x28,
+  0x74,0x65,0x78,0x74,0x29,0x20,0x7b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x74,0x65,
+  0x78,0x74,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x6c,0x69,0x76,0x65,0x45,0x6c,
+  0x2e,0x63,0x6c,0x61,0x73,0x73,0x4c,0x69,0x73,0x74,0x2e,0x61,0x64,0x64,0x28,0x27,
+  0x6f,0x6e,0x27,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x6c,0x69,0x76,0x65,0x54,0x65,
+  0x78,0x74,0x2e,0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x20,0x3d,0x20,0x74,
+  0x65,0x78,0x74,0x3b,0x0a,0x20,0x20,0x7d,0x20,0x65,0x6c,0x73,0x65,0x20,0x7b,0x0a,
+  0x20,0x20,0x20,0x20,0x6c,0x69,0x76,0x65,0x45,0x6c,0x2e,0x63,0x6c,0x61,0x73,0x73,
+  0x4c,0x69,0x73,0x74,0x2e,0x72,0x65,0x6d,0x6f,0x76,0x65,0x28,0x27,0x6f,0x6e,0x27,
+  0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x6c,0x69,0x76,0x65,0x54,0x65,0x78,0x74,0x2e,
+  0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x20,0x3d,0x20,0x27,0x27,0x3b,0x0a,
+  0x20,0x20,0x7d,0x0a,0x7d,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,
+  0xe2,0x94,0x80,0x20,0x53,0x65,0x6e,0x64,0x20,0x6d,0x65,0x73,0x73,0x61,0x67,0x65,
+  0x20,0x76,0x69,0x61,0x20,0x53,0x53,0x45,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,
+  0x94,0x80,0x20,0x2a,0x2f,0x0a,0x61,0x73,0x79,0x6e,0x63,0x20,0x66,0x75,0x6e,0x63,
+  0x74,0x69,0x6f,0x6e,0x20,0x73,0x65,0x6e,0x64,0x4d,0x65,0x73,0x73,0x61,0x67,0x65,
+  0x28,0x29,0x20,0x7b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x62,0x75,0x73,0x79,0x29,
+  0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x3b,0x0a,0x20,0x20,0x63,0x6f,0x6e,0x73,0x74,
+  0x20,0x74,0x65,0x78,0x74,0x20,0x3d,0x20,0x69,0x6e,0x70,0x75,0x74,0x45,0x6c,0x2e,
+  0x76,0x61,0x6c,0x75,0x65,0x2e,0x74,0x72,0x69,0x6d,0x28,0x29,0x3b,0x0a,0x20,0x20,
+  0x69,0x66,0x20,0x28,0x21,0x74,0x65,0x78,0x74,0x29,0x20,0x72,0x65,0x74,0x75,0x72,
+  0x6e,0x3b,0x0a,0x0a,0x20,0x20,0x69,0x6e,0x70,0x75,0x74,0x45,0x6c,0x2e,0x76,0x61,
+  0x6c,0x75,0x65,0x20,0x3d,0x20,0x27,0x27,0x3b,0x0a,0x20,0x20,0x69,0x6e,0x70,0x75,
+  0x74,0x45,0x6c,0x2e,0x73,0x74,0x79,0x6c,0x65,0x2e,0x68,0x65,0x69,0x67,0x68,0x74,
+  0x20,0x3d,0x20,0x27,0x32,0x34,0x70,0x78,0x27,0x3b,0x0a,0x20,0x20,0x61,0x64,0x64,
+  0x4d,0x65,0x73,0x73,0x61,0x67,0x65,0x28,0x27,0x75,0x73,0x65,0x72,0x27,0x2c,0x20,
+  0x65,0x73,0x63,0x28,0x74,0x65,0x78,0x74,0x29,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x62,
+  0x75,0x73,0x79,0x20,0x3d,0x20,0x74,0x72,0x75,0x65,0x3b,0x0a,0x20,0x20,0x62,0x74,
+  0x6e,0x53,0x65,0x6e,0x64,0x2e,0x64,0x69,0x73,0x61,0x62,0x6c,0x65,0x64,0x20,0x3d,
+  0x20,0x74,0x72,0x75,0x65,0x3b,0x0a,0x20,0x20,0x73,0x65,0x74,0x4c,0x69,0x76,0x65,
+  0x28,0x27,0x3c,0x65,0x6d,0x3e,0x54,0x68,0x69,0x6e,0x6b,0x69,0x6e,0x67,0x2e,0x2e,
+  0x2e,0x3c,0x2f,0x65,0x6d,0x3e,0x27,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x6c,0x65,0x74,
+  0x20,0x73,0x74,0x65,0x70,0x73,0x20,0x3d,0x20,0x5b,0x5d,0x3b,0x0a,0x20,0x20,0x6c,
+  0x65,0x74,0x20,0x72,0x65,0x73,0x70,0x6f,0x6e,0x73,0x65,0x20,0x3d,0x20,0x27,0x27,
+  0x3b,0x0a,0x0a,0x20,0x20,0x74,0x72,0x79,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x63,
+  0x6f,0x6e,0x73,0x74,0x20,0x72,0x65,0x73,0x20,0x3d,0x20,0x61,0x77,0x61,0x69,0x74,
+  0x20,0x66,0x65,0x74,0x63,0x68,0x28,0x27,0x2f,0x61,0x70,0x69,0x2f,0x63,0x68,0x61,
+  0x74,0x27,0x2c,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x6d,0x65,0x74,0x68,
+  0x6f,0x64,0x3a,0x20,0x27,0x50,0x4f,0x53,0x54,0x27,0x2c,0x0a,0x20,0x20,0x20,0x20,
+  0x20,0x20,0x68,0x65,0x61,0x64,0x65,0x72,0x73,0x3a,0x20,0x7b,0x20,0x27,0x43,0x6f,
+  0x6e,0x74,0x65,0x6e,0x74,0x2d,0x54,0x79,0x70,0x65,0x27,0x3a,0x20,0x27,0x61,0x70,
+  0x70,0x6c,0x69,0x63,0x61,0x74,0x69,0x6f,0x6e,0x2f,0x6a,0x73,0x6f,0x6e,0x27,0x20,
+  0x7d,0x2c,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x62,0x6f,0x64,0x79,0x3a,0x20,0x4a,
+  0x53,0x4f,0x4e,0x2e,0x73,0x74,0x72,0x69,0x6e,0x67,0x69,0x66,0x79,0x28,0x7b,0x20,
+  0x6d,0x65,0x73,0x73,0x61,0x67,0x65,0x3a,0x20,0x74,0x65,0x78,0x74,0x20,0x7d,0x29,
+  0x0a,0x20,0x20,0x20,0x20,0x7d,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x20,0x20,0x69,0x66,
+  0x20,0x28,0x21,0x72,0x65,0x73,0x2e,0x6f,0x6b,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,
+  0x20,0x20,0x20,0x74,0x68,0x72,0x6f,0x77,0x20,0x6e,0x65,0x77,0x20,0x45,0x72,0x72,
+  0x6f,0x72,0x28,0x27,0x53,0x65,0x72,0x76,0x65,0x72,0x20,0x72,0x65,0x74,0x75,0x72,
+  0x6e,0x65,0x64,0x20,0x27,0x20,0x2b,0x20,0x72,0x65,0x73,0x2e,0x73,0x74,0x61,0x74,
+  0x75,0x73,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,0x0a,0x20,0x20,0x20,0x20,
+  0x63,0x6f,0x6e,0x73,0x74,0x20,0x72,0x65,0x61,0x64,0x65,0x72,0x20,0x3d,0x20,0x72,
+  0x65,0x73,0x2e,0x62,0x6f,0x64,0x79,0x2e,0x67,0x65,0x74,0x52,0x65,0x61,0x64,0x65,
+  0x72,0x28,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x64,
+  0x65,0x63,0x6f,0x64,0x65,0x72,0x20,0x3d,0x20,0x6e,0x65,0x77,0x20,0x54,0x65,0x78,
+  0x74,0x44,0x65,0x63,0x6f,0x64,0x65,0x72,0x28,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,
+  0x6c,0x65,0x74,0x20,0x62,0x75,0x66,0x20,0x3d,0x20,0x27,0x27,0x3b,0x0a,0x0a,0x20,
+  0x20,0x20,0x20,0x77,0x68,0x69,0x6c,0x65,0x20,0x28,0x74,0x72,0x75,0x65,0x29,0x20,
+  0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x7b,0x20,
+  0x64,0x6f,0x6e,0x65,0x2c,0x20,0x76,0x61,0x6c,0x75,0x65,0x20,0x7d,0x20,0x3d,0x20,
+  0x61,0x77,0x61,0x69,0x74,0x20,0x72,0x65,0x61,0x64,0x65,0x72,0x2e,0x72,0x65,0x61,
+  0x64,0x28,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x69,0x66,0x20,0x28,0x64,
+  0x6f,0x6e,0x65,0x29,0x20,0x62,0x72,0x65,0x61,0x6b,0x3b,0x0a,0x0a,0x20,0x20,0x20,
+  0x20,0x20,0x20,0x62,0x75,0x66,0x20,0x2b,0x3d,0x20,0x64,0x65,0x63,0x6f,0x64,0x65,
+  0x72,0x2e,0x64,0x65,0x63,0x6f,0x64,0x65,0x28,0x76,0x61,0x6c,0x75,0x65,0x2c,0x20,
+  0x7b,0x20,0x73,0x74,0x72,0x65,0x61,0x6d,0x3a,0x20,0x74,0x72,0x75,0x65,0x20,0x7d,
+  0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x6c,
+  0x69,0x6e,0x65,0x73,0x20,0x3d,0x20,0x62,0x75,0x66,0x2e,0x73,0x70,0x6c,0x69,0x74,
+  0x28,0x27,0x5c,0x6e,0x27,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x62,0x75,
+  0x66,0x20,0x3d,0x20,0x6c,0x69,0x6e,0x65,0x73,0x2e,0x70,0x6f,0x70,0x28,0x29,0x3b,
+  0x0a,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x66,0x6f,0x72,0x20,0x28,0x63,0x6f,0x6e,
+  0x73,0x74,0x20,0x6c,0x69,0x6e,0x65,0x20,0x6f,0x66,0x20,0x6c,0x69,0x6e,0x65,0x73,
+  0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x69,0x66,0x20,0x28,
+  0x21,0x6c,0x69,0x6e,0x65,0x2e,0x73,0x74,0x61,0x72,0x74,0x73,0x57,0x69,0x74,0x68,
+  0x28,0x27,0x64,0x61,0x74,0x61,0x3a,0x20,0x27,0x29,0x29,0x20,0x63,0x6f,0x6e,0x74,
+  0x69,0x6e,0x75,0x65,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x63,0x6f,
+  0x6e,0x73,0x74,0x20,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64,0x20,0x3d,0x20,0x6c,0x69,
+  0x6e,0x65,0x2e,0x73,0x6c,0x69,0x63,0x65,0x28,0x36,0x29,0x2e,0x74,0x72,0x69,0x6d,
+  0x28,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x69,0x66,0x20,0x28,
+  0x70,0x61,0x79,0x6c,0x6f,0x61,0x64,0x20,0x3d,0x3d,0x3d,0x20,0x27,0x5b,0x44,0x4f,
+  0x4e,0x45,0x5d,0x27,0x29,0x20,0x63,0x6f,0x6e,0x74,0x69,0x6e,0x75,0x65,0x3b,0x0a,
+  0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x74,0x72,0x79,0x20,0x7b,0x0a,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x65,
+  0x76,0x20,0x3d,0x20,0x4a,0x53,0x4f,0x4e,0x2e,0x70,0x61,0x72,0x73,0x65,0x28,0x70,
+  0x61,0x79,0x6c,0x6f,0x61,0x64,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,
+  0x20,0x20,0x20,0x20,0x69,0x66,0x20,0x28,0x65,0x76,0x2e,0x74,0x79,0x70,0x65,0x20,
+  0x3d,0x3d,0x3d,0x20,0x27,0x74,0x68,0x69,0x6e,0x6b,0x69,0x6e,0x67,0x27,0x29,0x20,
+  0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x73,0x74,
+  0x65,0x70,0x73,0x2e,0x70,0x75,0x73,0x68,0x28,0x65,0x76,0x29,0x3b,0x0a,0x20,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x73,0x65,0x74,0x4c,0x69,0x76,
+  0x65,0x28,0x27,0xf0,0x9f,0x92,0xad,0x20,0x3c,0x65,0x6d,0x3e,0x27,0x20,0x2b,0x20,
+  0x65,0x73,0x63,0x28,0x65,0x76,0x2e,0x74,0x65,0x78,0x74,0x2e,0x73,0x75,0x62,0x73,
+  0x74,0x72,0x69,0x6e,0x67,0x28,0x30,0x2c,0x20,0x38,0x30,0x29,0x29,0x20,0x2b,0x20,
+  0x27,0x3c,0x2f,0x65,0x6d,0x3e,0x27,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,
+  0x20,0x20,0x20,0x20,0x7d,0x20,0x65,0x6c,0x73,0x65,0x20,0x69,0x66,0x20,0x28,0x65,
+  0x76,0x2e,0x74,0x79,0x70,0x65,0x20,0x3d,0x3d,0x3d,0x20,0x27,0x74,0x6f,0x6f,0x6c,
+  0x27,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,
+  0x20,0x73,0x74,0x65,0x70,0x73,0x2e,0x70,0x75,0x73,0x68,0x28,0x65,0x76,0x29,0x3b,
+  0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x73,0x65,0x74,
+  0x4c,0x69,0x76,0x65,0x28,0x27,0xf0,0x9f,0x94,0xa7,0x20,0x3c,0x65,0x6d,0x3e,0x27,
+  0x20,0x2b,0x20,0x65,0x73,0x63,0x28,0x65,0x76,0x2e,0x6e,0x61,0x6d,0x65,0x29,0x20,
+  0x2b,0x20,0x27,0x3c,0x2f,0x65,0x6d,0x3e,0x27,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x7d,0x20,0x65,0x6c,0x73,0x65,0x20,0x69,0x66,0x20,
+  0x28,0x65,0x76,0x2e,0x74,0x79,0x70,0x65,0x20,0x3d,0x3d,0x3d,0x20,0x27,0x6f,0x62,
+  0x73,0x65,0x72,0x76,0x61,0x74,0x69,0x6f,0x6e,0x27,0x29,0x20,0x7b,0x0a,0x20,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x73,0x74,0x65,0x70,0x73,0x2e,
+  0x70,0x75,0x73,0x68,0x28,0x65,0x76,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x73,0x65,0x74,0x4c,0x69,0x76,0x65,0x28,0x27,0xf0,
+  0x9f,0x93,0x8b,0x20,0x50,0x72,0x6f,0x63,0x65,0x73,0x73,0x69,0x6e,0x67,0x20,0x72,
+  0x65,0x73,0x75,0x6c,0x74,0x2e,0x2e,0x2e,0x27,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x7d,0x20,0x65,0x6c,0x73,0x65,0x20,0x69,0x66,0x20,
+  0x28,0x65,0x76,0x2e,0x74,0x79,0x70,0x65,0x20,0x3d,0x3d,0x3d,0x20,0x27,0x72,0x65,
+  0x73,0x70,0x6f,0x6e,0x73,0x65,0x27,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x72,0x65,0x73,0x70,0x6f,0x6e,0x73,0x65,0x20,
+  0x3d,0x20,0x65,0x76,0x2e,0x74,0x65,0x78,0x74,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,
+  0x20,0x20,0x20,0x20,0x20,0x7d,0x20,0x65,0x6c,0x73,0x65,0x20,0x69,0x66,0x20,0x28,
+  0x65,0x76,0x2e,0x74,0x79,0x70,0x65,0x20,0x3d,0x3d,0x3d,0x20,0x27,0x65,0x72,0x72,
+  0x6f,0x72,0x27,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,
+  0x20,0x20,0x20,0x72,0x65,0x73,0x70,0x6f,0x6e,0x73,0x65,0x20,0x3d,0x20,0x27,0xe2,
+  0x9a,0xa0,0xef,0xb8,0x8f,0x20,0x27,0x20,0x2b,0x20,0x28,0x65,0x76,0x2e,0x74,0x65,
+  0x78,0x74,0x20,0x7c,0x7c,0x20,0x27,0x41,0x67,0x65,0x6e,0x74,0x20,0x65,0x72,0x72,
+  0x6f,0x72,0x27,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,
+  0x7d,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x7d,0x20,0x63,0x61,0x74,0x63,
+  0x68,0x20,0x28,0x65,0x29,0x20,0x7b,0x20,0x2f,0x2a,0x20,0x73,0x6b,0x69,0x70,0x20,
+  0x6d,0x61,0x6c,0x66,0x6f,0x72,0x6d,0x65,0x64,0x20,0x65,0x76,0x65,0x6e,0x74,0x73,
+  0x20,0x2a,0x2f,0x20,0x7d,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,
+  0x20,0x20,0x7d,0x0a,0x20,0x20,0x7d,0x20,0x63,0x61,0x74,0x63,0x68,0x20,0x28,0x65,
+  0x72,0x72,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x73,0x70,0x6f,0x6e,
+  0x73,0x65,0x20,0x3d,0x20,0x27,0xe2,0x9a,0xa0,0xef,0xb8,0x8f,0x20,0x43,0x6f,0x6e,
+  0x6e,0x65,0x63,0x74,0x69,0x6f,0x6e,0x20,0x65,0x72,0x72,0x6f,0x72,0x3a,0x20,0x27,
+  0x20,0x2b,0x20,0x65,0x72,0x72,0x2e,0x6d,0x65,0x73,0x73,0x61,0x67,0x65,0x3b,0x0a,
+  0x20,0x20,0x7d,0x0a,0x0a,0x20,0x20,0x73,0x65,0x74,0x4c,0x69,0x76,0x65,0x28,0x6e,
+  0x75,0x6c,0x6c,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x72,0x65,0x73,
+  0x70,0x6f,0x6e,0x73,0x65,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x61,0x64,0x64,
+  0x4d,0x65,0x73,0x73,0x61,0x67,0x65,0x28,0x27,0x62,0x6f,0x74,0x27,0x2c,0x20,0x72,
+  0x65,0x6e,0x64,0x65,0x72,0x4d,0x61,0x72,0x6b,0x64,0x6f,0x77,0x6e,0x28,0x72,0x65,
+  0x73,0x70,0x6f,0x6e,0x73,0x65,0x29,0x2c,0x20,0x73,0x74,0x65,0x70,0x73,0x29,0x3b,
+  0x0a,0x20,0x20,0x7d,0x0a,0x0a,0x20,0x20,0x62,0x75,0x73,0x79,0x20,0x3d,0x20,0x66,
+  0x61,0x6c,0x73,0x65,0x3b,0x0a,0x20,0x20,0x62,0x74,0x6e,0x53,0x65,0x6e,0x64,0x2e,
+  0x64,0x69,0x73,0x61,0x62,0x6c,0x65,0x64,0x20,0x3d,0x20,0x66,0x61,0x6c,0x73,0x65,
+  0x3b,0x0a,0x20,0x20,0x69,0x6e,0x70,0x75,0x74,0x45,0x6c,0x2e,0x66,0x6f,0x63,0x75,
+  0x73,0x28,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,0x94,0x80,0xe2,0x94,
+  0x80,0xe2,0x94,0x80,0x20,0x46,0x6f,0x63,0x75,0x73,0x20,0x69,0x6e,0x70,0x75,0x74,
+  0x20,0x6f,0x6e,0x20,0x6c,0x6f,0x61,0x64,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,
+  0x94,0x80,0x20,0x2a,0x2f,0x0a,0x69,0x6e,0x70,0x75,0x74,0x45,0x6c,0x2e,0x66,0x6f,
+  0x63,0x75,0x73,0x28,0x29,0x3b,0x0a,0x0a,0x2f,0x2a,0x20,0xe2,0x94,0x80,0xe2,0x94,
+  0x80,0xe2,0x94,0x80,0x20,0x43,0x74,0x72,0x6c,0x2b,0x2f,0x20,0x74,0x6f,0x20,0x73,
+  0x68,0x6f,0x77,0x20,0x73,0x68,0x6f,0x72,0x74,0x63,0x75,0x74,0x73,0x20,0x28,0x66,
+  0x75,0x74,0x75,0x72,0x65,0x29,0x20,0xe2,0x94,0x80,0xe2,0x94,0x80,0xe2,0x94,0x80,
+  0x20,0x2a,0x2f,0x0a,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x61,0x64,0x64,
+  0x45,0x76,0x65,0x6e,0x74,0x4c,0x69,0x73,0x74,0x65,0x6e,0x65,0x72,0x28,0x27,0x6b,
+  0x65,0x79,0x64,0x6f,0x77,0x6e,0x27,0x2c,0x20,0x28,0x65,0x29,0x20,0x3d,0x3e,0x20,
+  0x7b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x65,0x2e,0x6b,0x65,0x79,0x20,0x3d,0x3d,
+  0x3d,0x20,0x27,0x2f,0x27,0x20,0x26,0x26,0x20,0x21,0x62,0x75,0x73,0x79,0x20,0x26,
+  0x26,0x20,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x61,0x63,0x74,0x69,0x76,
+  0x65,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x20,0x21,0x3d,0x3d,0x20,0x69,0x6e,0x70,
+  0x75,0x74,0x45,0x6c,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x65,0x2e,0x70,0x72,
+  0x65,0x76,0x65,0x6e,0x74,0x44,0x65,0x66,0x61,0x75,0x6c,0x74,0x28,0x29,0x3b,0x0a,
+  0x20,0x20,0x20,0x20,0x69,0x6e,0x70,0x75,0x74,0x45,0x6c,0x2e,0x66,0x6f,0x63,0x75,
+  0x73,0x28,0x29,0x3b,0x0a,0x20,0x20,0x7d,0x0a,0x7d,0x29,0x3b,0x0a,0x3c,0x2f,0x73,
+  0x63,0x72,0x69,0x70,0x74,0x3e,0x0a,0x3c,0x2f,0x62,0x6f,0x64,0x79,0x3e,0x0a,0x3c,
+  0x2f,0x68,0x74,0x6d,0x6c,0x3e,0x0a,
+};
+static const unsigned int neuronos_chat_ui_html_len = 20311;
+
 static const unsigned char neuronos_chat_ui_html_gz[] = {
-  0x1f,0x8b,0x08,0x00,0x48,0xa4,0x8c,0x69,0x02,0xff,0xdd,0x5c,0x4f,0x73,0x1b,0x47,
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xdd,0x5c,0x4f,0x73,0x1b,0x47,
   0x76,0xbf,0xf3,0x53,0xb4,0x21,0x7b,0x67,0x40,0x61,0x06,0x03,0x10,0x80,0x28,0x80,
   0xa0,0xd6,0x92,0xa8,0x5a,0x6d,0x24,0xcb,0x25,0xca,0x71,0x5c,0xa2,0x76,0xdd,0xc0,
   0x34,0x80,0x31,0x07,0x33,0xc8,0xcc,0x80,0x24,0xcc,0x65,0x95,0x73,0xc9,0x25,0x5b,
@@ -400,7 +1674,8 @@ static const unsigned char neuronos_chat_ui_html_gz[] = {
   0x4f,0x00,0x00,
 };
 static const unsigned int neuronos_chat_ui_html_gz_len = 6275;
-static const unsigned int neuronos_chat_ui_html_raw_len = 20311;
+
 #define NEURONOS_CHAT_UI_IS_GZIPPED 1
+#define NEURONOS_CHAT_UI_HAS_BROTLI 0
 
 #endif /* NEURONOS_CHAT_UI_DATA_H */
@@ -7,16 +7,29 @@
  *   POST /v1/messages          — Anthropic Messages API (SSE) — Claude Code backend
  *   GET  /v1/models            — List models
  *   GET  /health               — Health check
+ *   GET  /metrics              — Prometheus metrics (JSON with Accept: application/json)
  *   POST /api/chat             — Agent chat (SSE streaming, tool use)
  *   GET  /                     — Chat UI (agent mode) or status page
  *
- * No external dependencies — pure POSIX sockets.
+ * Threading:
+ *   - Event loop (caller's thread): owns every socket through epoll
+ *     (Linux), kqueue (macOS/BSD) or poll/WSAPoll. Speaks HTTP/1.1
+ *     with keep-alive and pipelining, and answers cheap endpoints
+ *     inline, so /health never waits behind a generation.
+ *   - Inference thread: owns the model. Generation requests are handed
+ *     over with their connection; OpenAI/Anthropic completions run
+ *     concurrently on the continuous-batching scheduler, agent chats
+ *     one at a time. The connection returns to the loop when the
+ *     response is complete.
+ *
+ * No external dependencies — plain BSD sockets / Winsock.
  * Designed for: desktop apps, browser clients, mobile apps, Claude Code, OpenCode.
  * ============================================================ */
 #include "neuronos/neuronos.h"
 #include "neuronos/neuronos_json.h"
 #include "neuronos_chat_ui.h"
 
+#include <ctype.h>
 #include <errno.h>
 #include <signal.h>
 #include <stdio.h>
@@ -26,20 +39,58 @@
 #ifdef _WIN32
     #include <winsock2.h>
     #include <ws2tcpip.h>
+    #include <windows.h>
     #pragma comment(lib, "ws2_32.lib")
 typedef SOCKET socket_t;
     #define INVALID_SOCK INVALID_SOCKET
     #define close_socket closesocket
     /* MSVC/Clang-cl don't define ssize_t — use the Windows SDK equivalent */
     typedef SSIZE_T ssize_t;
+    #define SRV_POLL_POLL 1 /* WSAPoll */
+    #define sock_would_block() (WSAGetLastError() == WSAEWOULDBLOCK)
+typedef HANDLE srv_thread_t;
+typedef SRWLOCK srv_mutex_t;
+typedef CONDITION_VARIABLE srv_cond_t;
+    #define srv_mutex_init(m) InitializeSRWLock(m)
+    #define srv_mutex_lock(m) AcquireSRWLockExclusive(m)
+    #define srv_mutex_unlock(m) ReleaseSRWLockExclusive(m)
+    #define srv_cond_init(c) InitializeConditionVariable(c)
+    #define srv_cond_wait(c, m) SleepConditionVariableSRW(c, m, INFINITE, 0)
+    #define srv_cond_signal(c) WakeConditionVariable(c)
 #else
     #include <arpa/inet.h>
+    #include <fcntl.h>
     #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <poll.h>
+    #include <pthread.h>
     #include <sys/socket.h>
+    #include <sys/time.h>
+    #include <sys/uio.h>
+    #include <time.h>
     #include <unistd.h>
+    #if defined(__linux__)
+        #include <sys/epoll.h>
+        #define SRV_POLL_EPOLL 1
+    #elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__DragonFly__)
+        #include <sys/event.h>
+        #define SRV_POLL_KQUEUE 1
+    #else
+        #define SRV_POLL_POLL 1
+    #endif
 typedef int socket_t;
     #define INVALID_SOCK (-1)
     #define close_socket close
+    #define sock_would_block() (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+typedef pthread_t srv_thread_t;
+typedef pthread_mutex_t srv_mutex_t;
+typedef pthread_cond_t srv_cond_t;
+    #define srv_mutex_init(m) pthread_mutex_init(m, NULL)
+    #define srv_mutex_lock(m) pthread_mutex_lock(m)
+    #define srv_mutex_unlock(m) pthread_mutex_unlock(m)
+    #define srv_cond_init(c) pthread_cond_init(c, NULL)
+    #define srv_cond_wait(c, m) pthread_cond_wait(c, m)
+    #define srv_cond_signal(c) pthread_cond_signal(c)
 #endif
 
 /* ---- Global state ---- */
@@ -55,69 +106,489 @@ static void signal_handler(int sig) {
 
 /* JSON escape: use nj_escape() / nj_escape_n() from neuronos_json.h */
 
-/* ---- HTTP helpers ---- */
+/* ---- Limits ---- */
+
+#define SRV_MAX_HEAD (64 * 1024)        /* request line + headers              */
+#define SRV_MAX_BODY (32 * 1024 * 1024) /* decoded body: long chat histories   */
+#define SRV_IN_INITIAL 4096             /* input buffer of a new connection    */
+#define SRV_IN_KEEP (64 * 1024)         /* larger buffers are freed when idle  */
+#define SRV_IN_MAX (SRV_MAX_HEAD + SRV_MAX_BODY + SRV_IN_INITIAL)
+#define SRV_CHUNK_LINE_MAX 1024         /* chunk-size line incl. extensions    */
+#define SRV_MAX_CONNS 1024              /* open connections; more are refused  */
+#define SRV_MAX_EVENTS 64               /* readiness events per wait           */
+#define SRV_IDLE_TIMEOUT_MS 30000       /* idle keep-alive connections closed  */
+#define SRV_SEND_TIMEOUT_MS 30000       /* inference-thread sends to slow peers */
+#define SRV_DEFAULT_SLOTS 4             /* scheduler slots (params.n_slots = 0) */
+#define SRV_QUEUE_PER_SLOT 4            /* waiting requests per slot (max_queue = 0) */
+#define SRV_CANCEL_POLL_MS 100          /* client liveness checks during inference */
+#define SRV_RETRY_AFTER_MAX_S 60        /* cap on the Retry-After estimate     */
+
+static double srv_now_ms(void) {
+#ifdef _WIN32
+    return (double)GetTickCount64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+#endif
+}
 
-#define MAX_REQUEST 65536
-#define MAX_RESPONSE 262144
+/* ---- HTTP parsing ---- */
+
+typedef enum {
+    CHUNK_SIZE = 0, /* expecting a chunk-size line      */
+    CHUNK_DATA,     /* chunk_left data bytes to go      */
+    CHUNK_DATA_END, /* expecting the CRLF after data    */
+    CHUNK_TRAILER,  /* trailer fields until a blank line */
+} chunk_state_t;
 
 typedef struct {
     char method[16];
     char path[256];
-    char body[MAX_REQUEST];
+    const char * body; /* view into the connection buffer, NUL-terminated while handled */
     int body_len;
     int content_length;
     bool accept_gzip;
+    bool accept_br;
+    bool accept_json; /* Accept: application/json */
+    char if_none_match[128]; /* truncated lists just miss */
+    bool keep_alive;      /* HTTP/1.1 default unless "Connection: close" */
+    bool expect_continue; /* "Expect: 100-continue" */
+
+    /* Parser progress, kept across reads */
+    int head_len; /* 0 until the head is complete */
+    bool chunked; /* Transfer-Encoding: chunked */
+    chunk_state_t chunk_state;
+    int chunk_left;
+    int chunk_scan; /* next undecoded byte (offset in the buffer) */
 } http_request_t;
 
-static int parse_request(const char * raw, int raw_len, http_request_t * req) {
+static bool ascii_ieq(const char * a, const char * b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (tolower((unsigned char)a[i]) != tolower((unsigned char)b[i]))
+            return false;
+    }
+    return true;
+}
+
+/* Case-insensitive token search inside one header value */
+static bool header_has(const char * value, int value_len, const char * token) {
+    size_t tlen = strlen(token);
+    for (int i = 0; value && i + (int)tlen <= value_len; i++) {
+        if (ascii_ieq(value + i, token, tlen))
+            return true;
+    }
+    return false;
+}
+
+/* Does an Accept-Encoding value allow `coding`? Honours "q=0" and "*". */
+static bool accepts_coding(const char * value, int value_len, const char * coding) {
+    size_t clen = strlen(coding);
+    bool star = false;
+    const char * p = value;
+    const char * end = value ? value + value_len : NULL;
+    while (p && p < end) {
+        while (p < end && (*p == ' ' || *p == ','))
+            p++;
+        const char * tok = p;
+        while (p < end && *p != ',' && *p != ';' && *p != ' ')
+            p++;
+        size_t tlen = (size_t)(p - tok);
+        bool q_zero = false;
+        while (p < end && *p != ',') {
+            if (*p == 'q' && p + 2 < end && p[1] == '=') {
+                double q = strtod(p + 2, NULL);
+                q_zero = q <= 0.0;
+            }
+            p++;
+        }
+        if (tlen == clen && ascii_ieq(tok, coding, clen))
+            return !q_zero;
+        if (tlen == 1 && *tok == '*')
+            star = !q_zero;
+    }
+    return star;
+}
+
+/* Value of header `name` (case-insensitive) within [head, head_end), or NULL */
+static const char * find_header(const char * head, const char * head_end, const char * name, int * value_len) {
+    size_t name_len = strlen(name);
+    const char * line = memchr(head, '\n', (size_t)(head_end - head)); /* skip the request line */
+    while (line && line + 1 < head_end) {
+        line++;
+        const char * eol = memchr(line, '\n', (size_t)(head_end - line));
+        if (!eol)
+            eol = head_end;
+        if ((size_t)(eol - line) > name_len && line[name_len] == ':' && ascii_ieq(line, name, name_len)) {
+            const char * v = line + name_len + 1;
+            const char * e = eol;
+            while (v < e && (*v == ' ' || *v == '\t'))
+                v++;
+            while (e > v && (e[-1] == '\r' || e[-1] == ' ' || e[-1] == '\t'))
+                e--;
+            *value_len = (int)(e - v);
+            return v;
+        }
+        line = eol;
+    }
+    return NULL;
+}
+
+static const char * find_crlf(const char * p, int n) {
+    for (int i = 0; i + 1 < n; i++) {
+        if (p[i] == '\r' && p[i + 1] == '\n')
+            return p + i;
+    }
+    return NULL;
+}
+
+/* Parse the request line and headers. Returns 1 when the head is
+ * complete, otherwise the parse_request() codes. */
+static int parse_head(const char * raw, int raw_len, http_request_t * req) {
     memset(req, 0, sizeof(*req));
 
+    /* Find the end of the head (\r\n\r\n) */
+    int head_len = -1;
+    int limit = raw_len < SRV_MAX_HEAD ? raw_len : SRV_MAX_HEAD;
+    for (int i = 0; i + 3 < limit; i++) {
+        if (raw[i] == '\r' && raw[i + 1] == '\n' && raw[i + 2] == '\r' && raw[i + 3] == '\n') {
+            head_len = i + 4;
+            break;
+        }
+    }
+    if (head_len < 0)
+        return raw_len >= SRV_MAX_HEAD ? -2 : 0;
+
     /* Parse request line */
-    const char * line_end = strstr(raw, "\r\n");
-    if (!line_end)
+    char version[16] = {0};
+    if (sscanf(raw, "%15s %255s %15s", req->method, req->path, version) < 2)
         return -1;
 
-    sscanf(raw, "%15s %255s", req->method, req->path);
-
-    /* Detect Accept-Encoding: gzip */
-    const char * ae = strstr(raw, "Accept-Encoding:");
-    if (!ae) ae = strstr(raw, "accept-encoding:");
-    if (ae) {
-        const char * ae_end = strstr(ae, "\r\n");
-        if (ae_end) {
-            /* Search within this header line */
-            const char * gz = strstr(ae, "gzip");
-            if (gz && gz < ae_end) req->accept_gzip = true;
+    const char * head_end = raw + head_len - 2;
+    const char * v;
+    int vlen = 0;
+
+    v = find_header(raw, head_end, "Transfer-Encoding", &vlen);
+    if (v && header_has(v, vlen, "chunked"))
+        req->chunked = true; /* overrides Content-Length */
+    else if (v && !header_has(v, vlen, "identity"))
+        return -3;
+
+    v = find_header(raw, head_end, "Content-Length", &vlen);
+    if (v && !req->chunked) {
+        long cl = strtol(v, NULL, 10);
+        if (cl < 0)
+            return -1;
+        if (cl > SRV_MAX_BODY)
+            return -2;
+        req->content_length = (int)cl;
+    }
+
+    /* Precompressed static assets */
+    v = find_header(raw, head_end, "Accept-Encoding", &vlen);
+    req->accept_gzip = accepts_coding(v, vlen, "gzip");
+    req->accept_br = accepts_coding(v, vlen, "br");
+
+    v = find_header(raw, head_end, "If-None-Match", &vlen);
+    if (v) {
+        int n = vlen < (int)sizeof(req->if_none_match) - 1 ? vlen : (int)sizeof(req->if_none_match) - 1;
+        memcpy(req->if_none_match, v, (size_t)n);
+        req->if_none_match[n] = '\0';
+    }
+
+    v = find_header(raw, head_end, "Accept", &vlen);
+    req->accept_json = header_has(v, vlen, "application/json");
+
+    v = find_header(raw, head_end, "Connection", &vlen);
+    if (strcmp(version, "HTTP/1.1") == 0)
+        req->keep_alive = !header_has(v, vlen, "close");
+    else
+        req->keep_alive = header_has(v, vlen, "keep-alive");
+
+    v = find_header(raw, head_end, "Expect", &vlen);
+    req->expect_continue = header_has(v, vlen, "100-continue");
+
+    req->head_len = head_len;
+    req->chunk_scan = head_len;
+    return 1;
+}
+
+/*
+ * Decode as much of a chunked body as has arrived. Chunk data is moved
+ * down to sit right after the head, then the undecoded rest of the
+ * buffer (including any pipelined request) is moved down behind it,
+ * so *raw_len shrinks by the framing consumed so far.
+ */
+static int parse_chunked(char * raw, int * raw_len, http_request_t * req) {
+    char * body = raw + req->head_len;
+    int len = *raw_len;
+    int scan = req->chunk_scan;
+    bool done = false;
+    int rc = 0;
+
+    while (!done && rc == 0) {
+        if (req->chunk_state == CHUNK_DATA) {
+            int n = len - scan < req->chunk_left ? len - scan : req->chunk_left;
+            if (n == 0)
+                break;
+            if (raw + scan != body + req->body_len)
+                memmove(body + req->body_len, raw + scan, (size_t)n);
+            req->body_len += n;
+            req->chunk_left -= n;
+            scan += n;
+            if (req->chunk_left == 0)
+                req->chunk_state = CHUNK_DATA_END;
+            continue;
+        }
+
+        const char * eol = find_crlf(raw + scan, len - scan);
+        if (!eol) {
+            if (len - scan > SRV_CHUNK_LINE_MAX)
+                rc = -1;
+            break;
+        }
+        int line_len = (int)(eol - (raw + scan));
+
+        if (req->chunk_state == CHUNK_SIZE) {
+            char * end = NULL;
+            long size = strtol(raw + scan, &end, 16);
+            if (end == raw + scan || size < 0)
+                rc = -1;
+            else if (size > SRV_MAX_BODY - req->body_len)
+                rc = -2;
+            else {
+                req->chunk_left = (int)size;
+                req->chunk_state = size == 0 ? CHUNK_TRAILER : CHUNK_DATA;
+            }
+        } else if (req->chunk_state == CHUNK_DATA_END) {
+            if (line_len != 0)
+                rc = -1;
+            req->chunk_state = CHUNK_SIZE;
+        } else if (line_len == 0) {
+            done = true; /* blank line ends the (ignored) trailer fields */
         }
+        scan += line_len + 2;
+    }
+
+    int kept = req->head_len + req->body_len;
+    if (scan > kept) {
+        memmove(raw + kept, raw + scan, (size_t)(len - scan));
+        *raw_len = len - (scan - kept);
+    }
+    req->chunk_scan = kept;
+
+    if (rc < 0)
+        return rc;
+    if (!done)
+        return 0;
+    req->body = body;
+    return kept;
+}
+
+/*
+ * Incremental request parser: call again with the same req as bytes
+ * arrive. The head is parsed once; the body is then awaited
+ * (Content-Length) or decoded in place (chunked). The body is a view
+ * into raw, no copy is made.
+ *
+ * Returns the request's length in raw once complete, 0 if more bytes
+ * are needed, -1 if malformed, -2 if over SRV_MAX_HEAD / SRV_MAX_BODY,
+ * -3 for a Transfer-Encoding other than chunked / identity.
+ */
+static int parse_request(char * raw, int * raw_len, http_request_t * req) {
+    if (req->head_len == 0) {
+        int rc = parse_head(raw, *raw_len, req);
+        if (rc <= 0)
+            return rc;
     }
 
-    /* Find Content-Length */
-    const char * cl = strstr(raw, "Content-Length:");
-    if (!cl)
-        cl = strstr(raw, "content-length:");
-    if (cl) {
-        req->content_length = atoi(cl + 15);
-    }
-
-    /* Find body (after \r\n\r\n) */
-    const char * body_start = strstr(raw, "\r\n\r\n");
-    if (body_start) {
-        body_start += 4;
-        int body_available = raw_len - (int)(body_start - raw);
-        if (body_available > 0) {
-            int copy_len = body_available;
-            if (copy_len >= MAX_REQUEST)
-                copy_len = MAX_REQUEST - 1;
-            memcpy(req->body, body_start, (size_t)copy_len);
-            req->body[copy_len] = '\0';
-            req->body_len = copy_len;
+    if (req->chunked)
+        return parse_chunked(raw, raw_len, req);
+
+    if (*raw_len - req->head_len < req->content_length)
+        return 0;
+    req->body = raw + req->head_len;
+    req->body_len = req->content_length;
+    return req->head_len + req->content_length;
+}
+
+/* ---- Connections ---- */
+
+typedef struct srv_conn {
+    socket_t fd;
+    char * in; /* grows up to SRV_IN_MAX; one spare byte for the body's NUL */
+    int in_len;
+    int in_cap;
+
+    /* Output queued while the event loop owns the connection */
+    char * out;
+    size_t out_len;
+    size_t out_off;
+    size_t out_cap;
+
+    /* Static response body sent after out[] without copying */
+    const char * body;
+    size_t body_len;
+    size_t body_off;
+
+    http_request_t req; /* request being handled */
+    int req_len;        /* bytes of in[] it spans */
+    char req_saved;     /* byte overwritten by the body's NUL */
+
+    bool keep_alive;    /* current response leaves the connection open */
+    bool blocking;      /* owned by the inference thread: send() directly */
+    bool in_gen;        /* waiting on a scheduler generation */
+    bool send_failed;   /* peer went away mid-response */
+    bool sent_continue; /* 100 Continue sent for the pending request */
+    bool peer_closed;   /* read side hit EOF */
+    bool closing;       /* close once out[] is flushed */
+    int interest;       /* SRV_EV_* registered with the poller, -1 = none */
+    double last_active_ms;
+
+    uint32_t peer_ip;     /* client IPv4 address, per-client limit key   */
+    bool inferring;       /* counted in g_n_inference (event loop only) */
+    double handoff_ms;    /* handed to the inference thread             */
+    bool peer_gone;       /* client hung up during inference            */
+    double peer_polled_ms;
+
+    struct srv_conn * prev; /* every open connection (event loop only) */
+    struct srv_conn * next;
+    struct srv_conn * next_job; /* inference queue / returned list */
+} srv_conn_t;
+
+static bool conn_queue(srv_conn_t * conn, const void * data, size_t len) {
+    if (conn->body_off < conn->body_len) {
+        /* Keep response order: the pending static body goes first */
+        const char * body = conn->body + conn->body_off;
+        size_t body_len = conn->body_len - conn->body_off;
+        conn->body = NULL;
+        conn->body_len = conn->body_off = 0;
+        if (!conn_queue(conn, body, body_len))
+            return false;
+    }
+    if (conn->out_off == conn->out_len)
+        conn->out_off = conn->out_len = 0;
+    if (conn->out_len + len > conn->out_cap) {
+        size_t cap = conn->out_cap ? conn->out_cap : 4096;
+        while (cap < conn->out_len + len)
+            cap *= 2;
+        char * out = realloc(conn->out, cap);
+        if (!out) {
+            conn->send_failed = true;
+            return false;
         }
+        conn->out = out;
+        conn->out_cap = cap;
     }
+    memcpy(conn->out + conn->out_len, data, len);
+    conn->out_len += len;
+    return true;
+}
 
-    return 0;
+static bool sock_send_all(srv_conn_t * conn, const char * p, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(conn->fd, p, (int)len, 0);
+        if (n <= 0) {
+#ifndef _WIN32
+            if (n < 0 && errno == EINTR)
+                continue;
+#endif
+            conn->send_failed = true;
+            return false;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/* Response bytes: queued on event-loop connections, sent directly
+ * (blocking, SRV_SEND_TIMEOUT_MS) from the inference thread.
+ * Returns false once the peer is gone. */
+static bool conn_send(srv_conn_t * conn, const void * data, size_t len) {
+    if (conn->send_failed)
+        return false;
+    if (!conn->blocking)
+        return conn_queue(conn, data, len);
+
+    /* Anything the loop queued before the hand-over goes first */
+    if (conn->out_off < conn->out_len) {
+        if (!sock_send_all(conn, conn->out + conn->out_off, conn->out_len - conn->out_off))
+            return false;
+        conn->out_off = conn->out_len = 0;
+    }
+    if (conn->body_off < conn->body_len) {
+        if (!sock_send_all(conn, conn->body + conn->body_off, conn->body_len - conn->body_off))
+            return false;
+        conn->body = NULL;
+        conn->body_len = conn->body_off = 0;
+    }
+    return sock_send_all(conn, (const char *)data, len);
+}
+
+/* Queue a response head plus a body that outlives the connection
+ * (embedded assets). The body is never copied: conn_flush() sends both
+ * with one writev() / WSASend(). */
+static bool conn_queue_static(srv_conn_t * conn, const char * head, size_t head_len, const void * body,
+                              size_t body_len) {
+    if (!conn_queue(conn, head, head_len)) /* also flushes an earlier static body into out[] */
+        return false;
+    conn->body = (const char *)body;
+    conn->body_len = body_len;
+    conn->body_off = 0;
+    return true;
+}
+
+/* Gathered send of two buffers; returns bytes sent or -1 */
+static ssize_t sock_send2(socket_t fd, const char * a, size_t a_len, const char * b, size_t b_len) {
+#ifdef _WIN32
+    WSABUF bufs[2] = {{(ULONG)a_len, (CHAR *)a}, {(ULONG)b_len, (CHAR *)b}};
+    DWORD sent = 0;
+    if (WSASend(fd, bufs, 2, &sent, 0, NULL, NULL) != 0)
+        return -1;
+    return (ssize_t)sent;
+#else
+    struct iovec iov[2] = {{(void *)a, a_len}, {(void *)b, b_len}};
+    return writev(fd, iov, 2);
+#endif
+}
+
+/* Has the client hung up? A zero-timeout poll plus a peek, so bytes
+ * of a pipelined request waiting in the socket don't count. */
+static bool sock_peer_gone(socket_t fd) {
+#ifdef _WIN32
+    WSAPOLLFD pfd = {.fd = fd, .events = POLLRDNORM};
+    int rc = WSAPoll(&pfd, 1, 0);
+#else
+    struct pollfd pfd = {.fd = fd, .events = POLLIN};
+    int rc = poll(&pfd, 1, 0);
+#endif
+    if (rc <= 0)
+        return false;
+    if (pfd.revents & (POLLERR | POLLNVAL))
+        return true;
+    char c;
+    ssize_t n = recv(fd, &c, 1, MSG_PEEK);
+    return n == 0 || (n < 0 && !sock_would_block());
+}
+
+/* Liveness of a connection owned by the inference thread, polled at
+ * most every SRV_CANCEL_POLL_MS. A client that disconnects stops its
+ * generation or agent run instead of letting it decode to max_tokens. */
+static bool conn_client_gone(srv_conn_t * conn) {
+    if (conn->send_failed || conn->peer_gone)
+        return true;
+    double now = srv_now_ms();
+    if (now - conn->peer_polled_ms < SRV_CANCEL_POLL_MS)
+        return false;
+    conn->peer_polled_ms = now;
+    conn->peer_gone = sock_peer_gone(conn->fd);
+    return conn->peer_gone;
 }
 
-static void send_response(socket_t sock, int status_code, const char * status_text, const char * content_type,
+/* ---- HTTP helpers ---- */
+
+static void send_response(srv_conn_t * conn, int status_code, const char * status_text, const char * content_type,
                           const char * body, int body_len) {
     char header[512];
     int hlen = snprintf(header, sizeof(header),
@@ -127,41 +598,25 @@ static void send_response(socket_t sock, int status_code, const char * status_te
                         "Access-Control-Allow-Origin: *\r\n"
                         "Access-Control-Allow-Methods: GET, POST, OPTIONS\r\n"
                         "Access-Control-Allow-Headers: Content-Type, Authorization\r\n"
-                        "Connection: close\r\n"
+                        "Connection: %s\r\n"
                         "\r\n",
-                        status_code, status_text, content_type, body_len);
-    send(sock, header, hlen, 0);
+                        status_code, status_text, content_type, body_len, conn->keep_alive ? "keep-alive" : "close");
+    conn_send(conn, header, (size_t)hlen);
     if (body && body_len > 0) {
-        send(sock, body, body_len, 0);
+        conn_send(conn, body, (size_t)body_len);
     }
 }
 
-static void send_json(socket_t sock, int status, const char * json) {
-    send_response(sock, status, status == 200 ? "OK" : "Error", "application/json", json, (int)strlen(json));
-}
-
-/* Send a gzip-compressed response (browser decompresses automatically) */
-static void send_gzip_response(socket_t sock, const char * content_type,
-                               const unsigned char * data, int data_len) {
-    char header[512];
-    int hlen = snprintf(header, sizeof(header),
-                        "HTTP/1.1 200 OK\r\n"
-                        "Content-Type: %s\r\n"
-                        "Content-Encoding: gzip\r\n"
-                        "Content-Length: %d\r\n"
-                        "Cache-Control: no-cache\r\n"
-                        "Access-Control-Allow-Origin: *\r\n"
-                        "Connection: close\r\n"
-                        "\r\n",
-                        content_type, data_len);
-    send(sock, header, hlen, 0);
-    send(sock, (const char *)data, data_len, 0);
+static void send_json(srv_conn_t * conn, int status, const char * json) {
+    send_response(conn, status, status == 200 ? "OK" : "Error", "application/json", json, (int)strlen(json));
 }
 
-/* JSON parsing: use nj_copy_str/nj_find_int/nj_find_float from neuronos_json.h */
+/* JSON parsing: request bodies are parsed once with nj_parse() and read
+ * through the nj_doc accessors (neuronos_json.h) */
 
-/* Extract content from messages array (last user message) */
-static int extract_last_user_content(const char * json, char * out, size_t out_len) {
+/* Extract content from messages array (last user message).
+ * Returns malloc'd string or NULL. */
+static char * extract_last_user_content(const char * json) {
     /* Simple heuristic: find last "content": "..." with "role": "user" */
     const char * last_content = NULL;
     const char * p = json;
@@ -170,125 +625,61 @@ static int extract_last_user_content(const char * json, char * out, size_t out_l
         p++;
     }
     if (!last_content)
-        return -1;
+        return NULL;
 
-    return nj_copy_str(last_content - 1, "content", out, out_len) >= 0 ? 0 : -1;
+    return nj_alloc_str(last_content - 1, "content");
 }
 
-/*
- * Parse OpenAI-format messages array into neuronos_chat_msg_t array.
- * The messages array looks like: "messages": [{"role":"user","content":"hello"}, ...]
- *
- * Returns malloc'd arrays. Caller must free msgs, and each role/content string,
- * then the msgs array itself. Returns count via *out_count.
- * Returns NULL on failure.
- */
 typedef struct {
     char * role;
     char * content;
 } parsed_msg_t;
 
-static parsed_msg_t * parse_messages_array(const char * json, int * out_count) {
-    *out_count = 0;
+static void free_parsed_msgs(parsed_msg_t * msgs, int count) {
+    if (!msgs)
+        return;
+    for (int i = 0; i < count; i++) {
+        free(msgs[i].role);
+        free(msgs[i].content);
+    }
+    free(msgs);
+}
 
-    /* Find "messages" array */
-    const char * arr = strstr(json, "\"messages\"");
-    if (!arr)
-        return NULL;
+/*
+ * Parse the OpenAI/Anthropic "messages" array of a parsed request body:
+ * [{"role":"user","content":"hello"}, ...]. Strings are unescaped.
+ * Messages whose content is not a string (e.g. content blocks) are skipped.
+ *
+ * Returns a malloc'd array (free with free_parsed_msgs) and its length via
+ * *out_count, or NULL if there are no usable messages.
+ */
+static parsed_msg_t * parse_messages_array(const nj_doc_t * doc, int * out_count) {
+    *out_count = 0;
 
-    /* Find opening bracket */
-    const char * bracket = strchr(arr + 10, '[');
-    if (!bracket)
+    int arr = nj_get(doc, 0, "messages");
+    int n = nj_count(doc, arr);
+    if (n == 0)
         return NULL;
-    bracket++;
 
-    /* Count messages (rough: count occurrences of "role" within the array) */
-    int cap = 32;
-    parsed_msg_t * msgs = calloc((size_t)cap, sizeof(parsed_msg_t));
+    parsed_msg_t * msgs = calloc((size_t)n, sizeof(parsed_msg_t));
     if (!msgs)
         return NULL;
 
     int count = 0;
-    const char * p = bracket;
-
-    while (*p) {
-        /* Find next message object opening brace */
-        const char * obj_start = strchr(p, '{');
-        if (!obj_start)
-            break;
-
-        /* Check if we've gone past the closing bracket of the messages array */
-        /* Scan from p to obj_start: if we hit ']' first, we're done */
-        for (const char * scan = p; scan < obj_start; scan++) {
-            if (*scan == ']')
-                goto done;
-        }
-
-        /* Find matching closing brace for this message object */
-        int depth = 1;
-        const char * obj_end = obj_start + 1;
-        bool in_str = false;
-        while (*obj_end && depth > 0) {
-            if (*obj_end == '"' && *(obj_end - 1) != '\\')
-                in_str = !in_str;
-            if (!in_str) {
-                if (*obj_end == '{')
-                    depth++;
-                else if (*obj_end == '}')
-                    depth--;
-            }
-            if (depth > 0)
-                obj_end++;
-        }
-        if (depth != 0)
-            break;
-
-        /* We have the object from obj_start to obj_end (inclusive) */
-        size_t obj_len = (size_t)(obj_end - obj_start + 1);
-        char * obj = malloc(obj_len + 1);
-        if (!obj)
-            break;
-        memcpy(obj, obj_start, obj_len);
-        obj[obj_len] = '\0';
-
-        /* Extract role and content */
-        char role_buf[64] = {0};
-        char * content_str = NULL;
-        if (nj_copy_str(obj, "role", role_buf, sizeof(role_buf)) >= 0 &&
-            (content_str = nj_alloc_str(obj, "content")) != NULL) {
-            if (count >= cap) {
-                cap *= 2;
-                msgs = realloc(msgs, (size_t)cap * sizeof(parsed_msg_t));
-                if (!msgs) {
-                    free(content_str);
-                    free(obj);
-                    *out_count = 0;
-                    return NULL;
-                }
-            }
-            msgs[count].role = strdup(role_buf);
-            msgs[count].content = content_str; /* already allocated */
-            if (!msgs[count].role || !msgs[count].content) {
-                free(msgs[count].role);
-                free(msgs[count].content);
-                free(obj);
-                /* Free previously allocated messages */
-                for (int j = 0; j < count; j++) {
-                    free(msgs[j].role);
-                    free(msgs[j].content);
-                }
-                free(msgs);
-                *out_count = 0;
-                return NULL;
-            }
-            count++;
+    for (int m = nj_first(doc, arr); m >= 0; m = nj_next(doc, arr, m)) {
+        int role = nj_get(doc, m, "role");
+        int content = nj_get(doc, m, "content");
+        if (nj_type(doc, role) != NJ_STRING || nj_type(doc, content) != NJ_STRING)
+            continue;
+        msgs[count].role = nj_str_dup(doc, role);
+        msgs[count].content = nj_str_dup(doc, content);
+        if (!msgs[count].role || !msgs[count].content) {
+            free_parsed_msgs(msgs, count + 1);
+            return NULL;
         }
-
-        free(obj);
-        p = obj_end + 1;
+        count++;
     }
 
-done:
     *out_count = count;
     if (count == 0) {
         free(msgs);
@@ -297,211 +688,197 @@ done:
     return msgs;
 }
 
-static void free_parsed_msgs(parsed_msg_t * msgs, int count) {
-    if (!msgs)
-        return;
-    for (int i = 0; i < count; i++) {
-        free(msgs[i].role);
-        free(msgs[i].content);
-    }
-    free(msgs);
-}
-
 /* ---- Endpoint Handlers ---- */
 
-static void handle_health(socket_t sock) {
-    send_json(sock, 200, "{\"status\":\"ok\",\"engine\":\"neuronos\",\"version\":\"" NEURONOS_VERSION_STRING "\"}");
+static void handle_health(srv_conn_t * conn) {
+    send_json(conn, 200, "{\"status\":\"ok\",\"engine\":\"neuronos\",\"version\":\"" NEURONOS_VERSION_STRING "\"}");
+}
+
+/* Prometheus text by default; the JSON summary for Accept: application/json */
+static void handle_metrics(srv_conn_t * conn, bool want_json) {
+    char * body = want_json ? neuronos_metrics_json() : neuronos_metrics_prometheus();
+    if (!body) {
+        send_json(conn, 500, "{\"error\":{\"message\":\"Out of memory\"}}");
+        return;
+    }
+    if (want_json)
+        send_json(conn, 200, body);
+    else
+        send_response(conn, 200, "OK", "text/plain; version=0.0.4; charset=utf-8", body, (int)strlen(body));
+    free(body);
 }
 
-static void handle_models(socket_t sock) {
+static void handle_models(srv_conn_t * conn) {
     const char * response = "{\"object\":\"list\",\"data\":[{"
                             "\"id\":\"neuronos-local\","
                             "\"object\":\"model\","
                             "\"owned_by\":\"local\","
                             "\"permission\":[]}]}";
-    send_json(sock, 200, response);
+    send_json(conn, 200, response);
 }
 
-static void handle_completions(socket_t sock, const char * body) {
-    if (!g_model) {
-        send_json(sock, 503, "{\"error\":{\"message\":\"No model loaded\"}}");
-        return;
-    }
-
-    char prompt[8192] = {0};
-    nj_copy_str(body, "prompt", prompt, sizeof(prompt));
-    if (prompt[0] == '\0') {
-        send_json(sock, 400, "{\"error\":{\"message\":\"Missing prompt\"}}");
-        return;
+/* ---- Generations (inference thread) ----
+ *
+ * The completion handlers parse the request and build the prompt, then
+ * queue a srv_gen_t. gen_step() admits queued generations into free
+ * scheduler slots, runs one batched decode step and sends the response
+ * tail of every generation that finished. */
+
+typedef enum {
+    GEN_COMPLETION = 0, /* POST /v1/completions      */
+    GEN_CHAT,           /* POST /v1/chat/completions */
+    GEN_ANTHROPIC,      /* POST /v1/messages         */
+} srv_gen_kind_t;
+
+typedef struct srv_gen {
+    srv_gen_kind_t kind;
+    srv_conn_t * conn;
+    bool stream;
+    bool include_usage; /* OpenAI stream_options.include_usage */
+    char * prompt;
+    neuronos_gen_params_t params;
+    int request_id; /* scheduler request id, -1 = waiting for a slot */
+    int n_tokens;   /* tokens streamed so far */
+    double t_queued;
+    bool admitted; /* counted in NEURONOS_GAUGE_IN_FLIGHT */
+    struct srv_gen * next;
+} srv_gen_t;
+
+static neuronos_scheduler_t * g_sched = NULL; /* created on first use */
+static bool g_sched_failed = false;
+static int g_n_slots = SRV_DEFAULT_SLOTS;
+static int g_cache_mb = 0; /* scheduler KV snapshots (0 = engine default) */
+static srv_gen_t * g_gen_waiting = NULL; /* FIFO */
+static srv_gen_t * g_gen_waiting_tail = NULL;
+static srv_gen_t * g_gen_running = NULL;
+
+static void conn_release(srv_conn_t * conn);
+
+static void send_gen_error(srv_gen_kind_t kind, srv_conn_t * conn, int status, const char * message) {
+    char json[256];
+    if (kind == GEN_ANTHROPIC) {
+        snprintf(json, sizeof(json), "{\"type\":\"error\",\"error\":{\"type\":\"%s\",\"message\":\"%s\"}}",
+                 status == 400 ? "invalid_request_error" : "api_error", message);
+    } else {
+        snprintf(json, sizeof(json), "{\"error\":{\"message\":\"%s\"}}", message);
     }
+    send_json(conn, status, json);
+}
 
-    int max_tokens = nj_find_int(body, "max_tokens", 256);
-    float temperature = nj_find_float(body, "temperature", 0.7f);
-
-    neuronos_gen_params_t gparams = {
-        .prompt = prompt,
-        .max_tokens = max_tokens,
-        .temperature = temperature,
-        .top_p = 0.95f,
-        .top_k = 40,
-        .grammar = NULL,
-        .on_token = NULL,
-        .user_data = NULL,
-        .seed = 0,
-    };
-
-    neuronos_gen_result_t result = neuronos_generate(g_model, gparams);
-
-    if (result.status == NEURONOS_OK && result.text) {
-        /* JSON-escape the generated text */
-        char * escaped = nj_escape(result.text);
-        if (!escaped) {
-            send_json(sock, 500, "{\"error\":{\"message\":\"Memory allocation failed\"}}");
-            neuronos_gen_result_free(&result);
-            return;
-        }
+/* Coalesce tokens into one SSE frame (and one send) per flush.
+ * At ~20 t/s this is one frame per decode step at worst. */
+static const neuronos_flush_policy_t SSE_FLUSH_POLICY = {.every_n_tokens = 16, .every_ms = 50};
 
-        /* Build OpenAI-compatible response */
-        size_t resp_cap = strlen(escaped) + 512;
-        char * response = malloc(resp_cap);
-        if (!response) {
-            free(escaped);
-            send_json(sock, 500, "{\"error\":{\"message\":\"Memory allocation failed\"}}");
-            neuronos_gen_result_free(&result);
-            return;
-        }
+/* Format one SSE frame around a JSON-escaped text span and send it */
+static bool send_sse_text(srv_conn_t * conn, const char * prefix, const char * suffix, const char * text,
+                          size_t text_len) {
+    char * escaped = nj_escape_n(text, text_len);
+    if (!escaped)
+        return false;
 
-        snprintf(response, resp_cap,
-                 "{\"id\":\"cmpl-neuronos\","
-                 "\"object\":\"text_completion\","
-                 "\"created\":%d,"
-                 "\"model\":\"neuronos-local\","
-                 "\"choices\":[{"
-                 "\"text\":\"%s\","
-                 "\"index\":0,"
-                 "\"finish_reason\":\"stop\""
-                 "}],"
-                 "\"usage\":{"
-                 "\"completion_tokens\":%d,"
-                 "\"total_tokens\":%d"
-                 "}}",
-                 0, /* timestamp placeholder */
-                 escaped, result.n_tokens, result.n_tokens);
-
-        send_json(sock, 200, response);
-        free(response);
+    size_t cap = strlen(prefix) + strlen(escaped) + strlen(suffix) + 1;
+    char * frame = malloc(cap);
+    if (!frame) {
         free(escaped);
-    } else {
-        send_json(sock, 500, "{\"error\":{\"message\":\"Generation failed\"}}");
+        return false;
     }
+    int len = snprintf(frame, cap, "%s%s%s", prefix, escaped, suffix);
+    free(escaped);
 
-    neuronos_gen_result_free(&result);
+    bool sent = conn_send(conn, frame, (size_t)len);
+    free(frame);
+    return sent;
 }
 
-/* ---- SSE Streaming support ---- */
-
-typedef struct {
-    socket_t sock;
-    int n_tokens;
-} sse_stream_ctx_t;
-
-/* SSE streaming callback: sends each token as an SSE event */
-static bool sse_token_callback(const char * token_text, void * user_data) {
-    sse_stream_ctx_t * ctx = (sse_stream_ctx_t *)user_data;
-    if (!ctx || !token_text)
-        return false;
-
-    /* JSON-escape the token text */
-    char * escaped = nj_escape(token_text);
-    if (!escaped)
+/* SSE streaming callback: sends each flushed span as an SSE event */
+static bool sse_stream_callback(const int32_t * token_ids, int n_tokens, const char * text, size_t text_len,
+                                void * user_data) {
+    (void)token_ids;
+    srv_gen_t * gen = (srv_gen_t *)user_data;
+    if (!gen || !g_running)
         return false;
+    gen->n_tokens += n_tokens;
+    if (text_len == 0)
+        return true;
 
     /* OpenAI streaming format: data: {"choices":[{"delta":{"content":"..."}}]} */
-    char chunk[4096];
-    int len = snprintf(chunk, sizeof(chunk),
-                       "data: {\"id\":\"chatcmpl-neuronos\","
-                       "\"object\":\"chat.completion.chunk\","
-                       "\"model\":\"neuronos-local\","
-                       "\"choices\":[{"
-                       "\"index\":0,"
-                       "\"delta\":{\"content\":\"%s\"},"
-                       "\"finish_reason\":null"
-                       "}]}\n\n",
-                       escaped);
-    free(escaped);
+    return send_sse_text(gen->conn,
+                         "data: {\"id\":\"chatcmpl-neuronos\","
+                         "\"object\":\"chat.completion.chunk\","
+                         "\"model\":\"neuronos-local\","
+                         "\"choices\":[{"
+                         "\"index\":0,"
+                         "\"delta\":{\"content\":\"",
+                         "\"},"
+                         "\"finish_reason\":null"
+                         "}]}\n\n",
+                         text, text_len);
+}
 
-    ssize_t sent = send(ctx->sock, chunk, (size_t)len, 0);
-    ctx->n_tokens++;
+/**
+ * SSE callback for Anthropic streaming format.
+ * Sends content_block_delta events with text_delta.
+ */
+static bool anthropic_sse_stream_callback(const int32_t * token_ids, int n_tokens, const char * text,
+                                          size_t text_len, void * user_data) {
+    (void)token_ids;
+    srv_gen_t * gen = (srv_gen_t *)user_data;
+    if (!gen || !g_running)
+        return false;
+    gen->n_tokens += n_tokens;
+    if (text_len == 0)
+        return true;
 
-    return (sent > 0);
+    /* Anthropic streaming format:
+     * event: content_block_delta
+     * data: {"type":"content_block_delta","index":0,"delta":{"type":"text_delta","text":"..."}}
+     */
+    return send_sse_text(gen->conn,
+                         "event: content_block_delta\n"
+                         "data: {\"type\":\"content_block_delta\",\"index\":0,"
+                         "\"delta\":{\"type\":\"text_delta\",\"text\":\"",
+                         "\"}}\n\n", text, text_len);
 }
 
-/* Send SSE headers to start streaming */
-static void send_sse_headers(socket_t sock) {
+/* Send SSE headers to start streaming. The stream ends when the
+ * connection closes, so it is never kept alive. */
+static void send_sse_headers(srv_conn_t * conn) {
     const char * headers = "HTTP/1.1 200 OK\r\n"
                            "Content-Type: text/event-stream\r\n"
                            "Cache-Control: no-cache\r\n"
-                           "Connection: keep-alive\r\n"
+                           "Connection: close\r\n"
                            "Access-Control-Allow-Origin: *\r\n"
                            "Access-Control-Allow-Methods: GET, POST, OPTIONS\r\n"
                            "Access-Control-Allow-Headers: Content-Type, Authorization\r\n"
                            "\r\n";
-    send(sock, headers, strlen(headers), 0);
+    conn->keep_alive = false;
+    conn_send(conn, headers, strlen(headers));
 }
 
-/* JSON bool: use nj_find_bool() from neuronos_json.h */
-
-static void handle_chat_completions(socket_t sock, const char * body) {
-    if (!g_model) {
-        send_json(sock, 503, "{\"error\":{\"message\":\"No model loaded\"}}");
-        return;
-    }
-
-    /* Parse messages array and format with chat template */
-    int msg_count = 0;
-    parsed_msg_t * parsed = parse_messages_array(body, &msg_count);
-
-    char * formatted_prompt = NULL;
-
-    if (parsed && msg_count > 0) {
-        /* Build neuronos_chat_msg_t array from parsed messages */
-        neuronos_chat_msg_t * chat_msgs = calloc((size_t)msg_count, sizeof(neuronos_chat_msg_t));
-        if (!chat_msgs) {
-            free_parsed_msgs(parsed, msg_count);
-            send_json(sock, 500, "{\"error\":{\"message\":\"Memory allocation failed\"}}");
-            return;
-        }
-        if (chat_msgs) {
-            for (int i = 0; i < msg_count; i++) {
-                chat_msgs[i].role = parsed[i].role;
-                chat_msgs[i].content = parsed[i].content;
-            }
-
-            neuronos_chat_format(g_model, NULL, chat_msgs, (size_t)msg_count, true, &formatted_prompt);
-            free(chat_msgs);
-        }
-    }
-
-    /* Fallback: extract last user content if template formatting failed */
-    char content_fallback[8192] = {0};
-    if (!formatted_prompt) {
-        if (extract_last_user_content(body, content_fallback, sizeof(content_fallback)) != 0) {
-            free_parsed_msgs(parsed, msg_count);
-            send_json(sock, 400, "{\"error\":{\"message\":\"Missing messages content\"}}");
-            return;
-        }
-    }
-
-    const char * effective_prompt = formatted_prompt ? formatted_prompt : content_fallback;
-
-    int max_tokens = nj_find_int(body, "max_tokens", 256);
-    float temperature = nj_find_float(body, "temperature", 0.7f);
-    bool stream = nj_find_bool(body, "stream", false);
+/* Stream head: SSE headers plus the opening events of each API */
+static void gen_send_preamble(srv_gen_t * gen) {
+    srv_conn_t * conn = gen->conn;
+    send_sse_headers(conn);
 
-    if (stream) {
-        /* ── SSE Streaming mode ── */
-        send_sse_headers(sock);
+    if (gen->kind == GEN_ANTHROPIC) {
+        /* Event 1: message_start */
+        const char * msg_start =
+            "event: message_start\n"
+            "data: {\"type\":\"message_start\",\"message\":"
+            "{\"id\":\"msg_neuronos_01\",\"type\":\"message\",\"role\":\"assistant\","
+            "\"content\":[],\"model\":\"neuronos-local\",\"stop_reason\":null,"
+            "\"stop_sequence\":null,"
+            "\"usage\":{\"input_tokens\":0,\"output_tokens\":0}}}\n\n";
+        conn_send(conn, msg_start, strlen(msg_start));
 
+        /* Event 2: content_block_start */
+        const char * block_start =
+            "event: content_block_start\n"
+            "data: {\"type\":\"content_block_start\",\"index\":0,"
+            "\"content_block\":{\"type\":\"text\",\"text\":\"\"}}\n\n";
+        conn_send(conn, block_start, strlen(block_start));
+        /* Event 3 (repeated): content_block_delta — via token callback */
+    } else {
         /* Send initial role delta */
         const char * role_chunk = "data: {\"id\":\"chatcmpl-neuronos\","
                                   "\"object\":\"chat.completion.chunk\","
@@ -511,103 +888,455 @@ static void handle_chat_completions(socket_t sock, const char * body) {
                                   "\"delta\":{\"role\":\"assistant\",\"content\":\"\"},"
                                   "\"finish_reason\":null"
                                   "}]}\n\n";
-        send(sock, role_chunk, strlen(role_chunk), 0);
-
-        sse_stream_ctx_t ctx = {.sock = sock, .n_tokens = 0};
-
-        neuronos_gen_params_t gparams = {
-            .prompt = effective_prompt,
-            .max_tokens = max_tokens,
-            .temperature = temperature,
-            .top_p = 0.95f,
-            .top_k = 40,
-            .grammar = NULL,
-            .on_token = sse_token_callback,
-            .user_data = &ctx,
-            .seed = 0,
-        };
-
-        neuronos_gen_result_t result = neuronos_generate(g_model, gparams);
+        conn_send(conn, role_chunk, strlen(role_chunk));
+    }
+}
 
-        /* Send finish chunk */
-        const char * done_chunk = "data: {\"id\":\"chatcmpl-neuronos\","
-                                  "\"object\":\"chat.completion.chunk\","
-                                  "\"model\":\"neuronos-local\","
-                                  "\"choices\":[{"
-                                  "\"index\":0,"
-                                  "\"delta\":{},"
-                                  "\"finish_reason\":\"stop\""
-                                  "}]}\n\n"
-                                  "data: [DONE]\n\n";
-        send(sock, done_chunk, strlen(done_chunk), 0);
+/* Stream tail: finish events once generation has ended */
+static void gen_send_epilogue(srv_gen_t * gen, const neuronos_gen_result_t * result) {
+    srv_conn_t * conn = gen->conn;
 
-        neuronos_gen_result_free(&result);
-    } else {
-        /* ── Non-streaming mode ── */
-        neuronos_gen_params_t gparams = {
-            .prompt = effective_prompt,
-            .max_tokens = max_tokens,
-            .temperature = temperature,
-            .top_p = 0.95f,
-            .top_k = 40,
-            .grammar = NULL,
-            .on_token = NULL,
-            .user_data = NULL,
-            .seed = 0,
+    if (gen->kind == GEN_ANTHROPIC) {
+        /* Event 4: content_block_stop */
+        const char * block_stop =
+            "event: content_block_stop\n"
+            "data: {\"type\":\"content_block_stop\",\"index\":0}\n\n";
+        conn_send(conn, block_stop, strlen(block_stop));
+
+        /* Event 5: message_delta (with final usage) */
+        char msg_delta[512];
+        snprintf(msg_delta, sizeof(msg_delta),
+                 "event: message_delta\n"
+                 "data: {\"type\":\"message_delta\","
+                 "\"delta\":{\"stop_reason\":\"end_turn\",\"stop_sequence\":null},"
+                 "\"usage\":{\"output_tokens\":%d}}\n\n",
+                 gen->n_tokens);
+        conn_send(conn, msg_delta, strlen(msg_delta));
+
+        /* Event 6: message_stop */
+        const char * msg_stop =
+            "event: message_stop\n"
+            "data: {\"type\":\"message_stop\"}\n\n";
+        conn_send(conn, msg_stop, strlen(msg_stop));
+        return;
+    }
+
+    /* Send finish chunk */
+    const char * done_chunk = "data: {\"id\":\"chatcmpl-neuronos\","
+                              "\"object\":\"chat.completion.chunk\","
+                              "\"model\":\"neuronos-local\","
+                              "\"choices\":[{"
+                              "\"index\":0,"
+                              "\"delta\":{},"
+                              "\"finish_reason\":\"stop\""
+                              "}]}\n\n";
+    conn_send(conn, done_chunk, strlen(done_chunk));
+
+    /* OpenAI usage chunk: empty choices, sent last before [DONE] */
+    if (gen->include_usage) {
+        char usage[512];
+        int len = snprintf(usage, sizeof(usage),
+                           "data: {\"id\":\"chatcmpl-neuronos\","
+                           "\"object\":\"chat.completion.chunk\","
+                           "\"model\":\"neuronos-local\","
+                           "\"choices\":[],"
+                           "\"usage\":{\"prompt_tokens\":%d,\"completion_tokens\":%d,\"total_tokens\":%d,"
+                           "\"prompt_tokens_details\":{\"cached_tokens\":%d}}}\n\n",
+                           result->n_prompt_tokens, result->n_tokens, result->n_prompt_tokens + result->n_tokens,
+                           result->n_reused_tokens);
+        conn_send(conn, usage, (size_t)len);
+    }
+
+    const char * done = "data: [DONE]\n\n";
+    conn_send(conn, done, strlen(done));
+}
+
+/* Non-streaming response body for a finished generation */
+static void gen_send_result(srv_gen_t * gen, const neuronos_gen_result_t * result) {
+    srv_conn_t * conn = gen->conn;
+
+    if (result->status != NEURONOS_OK || !result->text) {
+        send_gen_error(gen->kind, conn, 500, "Generation failed");
+        return;
+    }
+
+    nj_writer_t w = {0};
+    nj_w_obj(&w);
+    switch (gen->kind) {
+    case GEN_COMPLETION:
+        nj_w_key(&w, "id");
+        nj_w_str(&w, "cmpl-neuronos");
+        nj_w_key(&w, "object");
+        nj_w_str(&w, "text_completion");
+        nj_w_key(&w, "created");
+        nj_w_int(&w, 0); /* timestamp placeholder */
+        nj_w_key(&w, "model");
+        nj_w_str(&w, "neuronos-local");
+        nj_w_key(&w, "choices");
+        nj_w_arr(&w);
+        nj_w_obj(&w);
+        nj_w_key(&w, "text");
+        nj_w_str(&w, result->text);
+        nj_w_key(&w, "index");
+        nj_w_int(&w, 0);
+        nj_w_key(&w, "finish_reason");
+        nj_w_str(&w, "stop");
+        nj_w_obj_end(&w);
+        nj_w_arr_end(&w);
+        nj_w_key(&w, "usage");
+        nj_w_obj(&w);
+        nj_w_key(&w, "prompt_tokens");
+        nj_w_int(&w, result->n_prompt_tokens);
+        nj_w_key(&w, "completion_tokens");
+        nj_w_int(&w, result->n_tokens);
+        nj_w_key(&w, "total_tokens");
+        nj_w_int(&w, result->n_prompt_tokens + result->n_tokens);
+        nj_w_obj_end(&w);
+        break;
+    case GEN_CHAT:
+        nj_w_key(&w, "id");
+        nj_w_str(&w, "chatcmpl-neuronos");
+        nj_w_key(&w, "object");
+        nj_w_str(&w, "chat.completion");
+        nj_w_key(&w, "created");
+        nj_w_int(&w, 0);
+        nj_w_key(&w, "model");
+        nj_w_str(&w, "neuronos-local");
+        nj_w_key(&w, "choices");
+        nj_w_arr(&w);
+        nj_w_obj(&w);
+        nj_w_key(&w, "index");
+        nj_w_int(&w, 0);
+        nj_w_key(&w, "message");
+        nj_w_obj(&w);
+        nj_w_key(&w, "role");
+        nj_w_str(&w, "assistant");
+        nj_w_key(&w, "content");
+        nj_w_str(&w, result->text);
+        nj_w_obj_end(&w);
+        nj_w_key(&w, "finish_reason");
+        nj_w_str(&w, "stop");
+        nj_w_obj_end(&w);
+        nj_w_arr_end(&w);
+        nj_w_key(&w, "usage");
+        nj_w_obj(&w);
+        nj_w_key(&w, "prompt_tokens");
+        nj_w_int(&w, result->n_prompt_tokens);
+        nj_w_key(&w, "completion_tokens");
+        nj_w_int(&w, result->n_tokens);
+        nj_w_key(&w, "total_tokens");
+        nj_w_int(&w, result->n_prompt_tokens + result->n_tokens);
+        nj_w_obj_end(&w);
+        break;
+    case GEN_ANTHROPIC:
+        /* Anthropic Messages response format */
+        nj_w_key(&w, "id");
+        nj_w_str(&w, "msg_neuronos_01");
+        nj_w_key(&w, "type");
+        nj_w_str(&w, "message");
+        nj_w_key(&w, "role");
+        nj_w_str(&w, "assistant");
+        nj_w_key(&w, "content");
+        nj_w_arr(&w);
+        nj_w_obj(&w);
+        nj_w_key(&w, "type");
+        nj_w_str(&w, "text");
+        nj_w_key(&w, "text");
+        nj_w_str(&w, result->text);
+        nj_w_obj_end(&w);
+        nj_w_arr_end(&w);
+        nj_w_key(&w, "model");
+        nj_w_str(&w, "neuronos-local");
+        nj_w_key(&w, "stop_reason");
+        nj_w_str(&w, "end_turn");
+        nj_w_key(&w, "stop_sequence");
+        nj_w_null(&w);
+        nj_w_key(&w, "usage");
+        nj_w_obj(&w);
+        nj_w_key(&w, "input_tokens");
+        nj_w_int(&w, 0);
+        nj_w_key(&w, "output_tokens");
+        nj_w_int(&w, result->n_tokens);
+        nj_w_obj_end(&w);
+        break;
+    }
+    nj_w_obj_end(&w);
+
+    char * response = nj_w_finish(&w);
+    if (!response) {
+        send_gen_error(gen->kind, conn, 500, "Memory allocation failed");
+        return;
+    }
+    send_json(conn, 200, response);
+    free(response);
+}
+
+static void gen_free(srv_gen_t * gen) {
+    if (gen->admitted)
+        neuronos_metrics_gauge_add(NEURONOS_GAUGE_IN_FLIGHT, -1);
+    free(gen->prompt);
+    free(gen);
+}
+
+/* Send the response tail and hand the connection back to the loop.
+ * A cancelled generation's client is gone: nothing is sent and the
+ * loop closes the connection. */
+static void gen_finish(srv_gen_t * gen, neuronos_gen_result_t * result) {
+    srv_conn_t * conn = gen->conn;
+    if (result->status == NEURONOS_ERROR_CANCELLED) {
+        neuronos_metrics_add(NEURONOS_COUNTER_CANCELLED, 1);
+        conn->keep_alive = false;
+    } else if (gen->stream) {
+        gen_send_epilogue(gen, result);
+    } else {
+        gen_send_result(gen, result);
+    }
+    neuronos_gen_result_free(result);
+    gen_free(gen);
+
+    conn->in_gen = false;
+    conn_release(conn);
+}
+
+/* is_cancelled poll of every scheduled generation */
+static bool gen_is_cancelled(void * user_data) {
+    srv_gen_t * gen = (srv_gen_t *)user_data;
+    return !g_running || conn_client_gone(gen->conn);
+}
+
+/* Queue a generation for conn. The prompt is copied. */
+static void gen_submit(srv_conn_t * conn, srv_gen_kind_t kind, bool stream, bool include_usage, const char * prompt,
+                       int max_tokens, float temperature) {
+    srv_gen_t * gen = calloc(1, sizeof(srv_gen_t));
+    char * prompt_copy = strdup(prompt);
+    if (!gen || !prompt_copy) {
+        free(gen);
+        free(prompt_copy);
+        send_gen_error(kind, conn, 500, "Memory allocation failed");
+        return;
+    }
+
+    gen->kind = kind;
+    gen->conn = conn;
+    gen->stream = stream;
+    gen->include_usage = stream && include_usage;
+    gen->prompt = prompt_copy;
+    gen->request_id = -1;
+    gen->params = (neuronos_gen_params_t){
+        .prompt = gen->prompt,
+        .max_tokens = max_tokens,
+        .temperature = temperature,
+        .top_p = 0.95f,
+        .top_k = 40,
+        .grammar = NULL,
+        .on_token = NULL,
+        .on_stream = !stream ? NULL : kind == GEN_ANTHROPIC ? anthropic_sse_stream_callback : sse_stream_callback,
+        .flush = SSE_FLUSH_POLICY,
+        .user_data = gen,
+        .seed = 0,
+        .is_cancelled = gen_is_cancelled,
+    };
+
+    if (stream)
+        gen_send_preamble(gen);
+
+    gen->t_queued = neuronos_metrics_now_ms();
+    neuronos_metrics_gauge_add(NEURONOS_GAUGE_QUEUED, 1);
+
+    conn->in_gen = true;
+    if (g_gen_waiting_tail)
+        g_gen_waiting_tail->next = gen;
+    else
+        g_gen_waiting = gen;
+    g_gen_waiting_tail = gen;
+}
+
+static srv_gen_t * gen_pop_waiting(void) {
+    srv_gen_t * gen = g_gen_waiting;
+    if (gen) {
+        g_gen_waiting = gen->next;
+        if (!g_gen_waiting)
+            g_gen_waiting_tail = NULL;
+        gen->next = NULL;
+        neuronos_metrics_gauge_add(NEURONOS_GAUGE_QUEUED, -1);
+    }
+    return gen;
+}
+
+/* Finish queued generations whose client already left, so they never
+ * take a slot */
+static void gen_drop_cancelled(void) {
+    srv_gen_t ** link = &g_gen_waiting;
+    g_gen_waiting_tail = NULL;
+    while (*link) {
+        srv_gen_t * gen = *link;
+        if (!gen_is_cancelled(gen)) {
+            g_gen_waiting_tail = gen;
+            link = &gen->next;
+            continue;
+        }
+        *link = gen->next;
+        gen->next = NULL;
+        neuronos_metrics_gauge_add(NEURONOS_GAUGE_QUEUED, -1);
+        neuronos_gen_result_t result = {.status = NEURONOS_ERROR_CANCELLED};
+        gen_finish(gen, &result);
+    }
+}
+
+/* The generation leaves the queue and starts running */
+static void gen_admit(srv_gen_t * gen) {
+    neuronos_metrics_record(NEURONOS_METRIC_QUEUE_WAIT, neuronos_metrics_now_ms() - gen->t_queued);
+    neuronos_metrics_gauge_add(NEURONOS_GAUGE_IN_FLIGHT, 1);
+    gen->admitted = true;
+}
+
+/* Admit, decode one step, finish. Runs on the inference thread. */
+static void gen_step(void) {
+    gen_drop_cancelled();
+
+    if (!g_sched && !g_sched_failed && g_gen_waiting) {
+        /* Finished slots stay warm, so chat clients that resend the whole
+         * conversation only prefill the new turn */
+        neuronos_scheduler_params_t sparams = {
+            .n_slots = g_n_slots,
+            .slot_ctx = neuronos_scheduler_slot_ctx(g_model, g_n_slots), /* model context split across slots */
+            .cache_mb = g_cache_mb,
         };
+        g_sched = neuronos_scheduler_create(g_model, sparams);
+        if (!g_sched) {
+            g_sched_failed = true;
+            fprintf(stderr, "Warning: batch scheduler unavailable, serving generations one at a time\n");
+        }
+    }
 
-        neuronos_gen_result_t result = neuronos_generate(g_model, gparams);
-
-        if (result.status == NEURONOS_OK && result.text) {
-            /* JSON-escape the generated text */
-            char * escaped = nj_escape(result.text);
-            if (!escaped) {
-                send_json(sock, 500, "{\"error\":{\"message\":\"Memory allocation failed\"}}");
-                neuronos_gen_result_free(&result);
-                neuronos_free(formatted_prompt);
-                free_parsed_msgs(parsed, msg_count);
-                return;
-            }
+    /* Fallback: the model's own context, one generation per call */
+    if (!g_sched) {
+        srv_gen_t * gen = gen_pop_waiting();
+        if (gen) {
+            gen_admit(gen);
+            if (g_agent)
+                neuronos_context_compact_wait(g_agent, true); /* it may be summarizing on g_model */
+            neuronos_gen_result_t result = neuronos_generate(g_model, gen->params);
+            gen_finish(gen, &result);
+        }
+        return;
+    }
 
-            size_t resp_cap = strlen(escaped) + 512;
-            char * response = malloc(resp_cap);
-            if (!response) {
-                free(escaped);
-                send_json(sock, 500, "{\"error\":{\"message\":\"Memory allocation failed\"}}");
-                neuronos_gen_result_free(&result);
-                neuronos_free(formatted_prompt);
-                free_parsed_msgs(parsed, msg_count);
-                return;
-            }
+    /* Finished slots are taken right after each step, so every busy
+     * slot is counted by neuronos_scheduler_active() */
+    while (g_gen_waiting && neuronos_scheduler_active(g_sched) < g_n_slots) {
+        srv_gen_t * gen = gen_pop_waiting();
+        gen_admit(gen);
+        gen->request_id = neuronos_scheduler_submit(g_sched, gen->params);
+        if (gen->request_id < 0) {
+            /* A slot was free, so the prompt does not fit a slot's context:
+             * run it on the model's own, full-size context instead. The
+             * other slots wait for it. */
+            if (g_agent)
+                neuronos_context_compact_wait(g_agent, true);
+            neuronos_gen_result_t result = neuronos_generate(g_model, gen->params);
+            gen_finish(gen, &result);
+            continue;
+        }
+        gen->next = g_gen_running;
+        g_gen_running = gen;
+    }
+
+    if (neuronos_scheduler_active(g_sched) > 0)
+        neuronos_scheduler_step(g_sched);
 
-            snprintf(response, resp_cap,
-                     "{\"id\":\"chatcmpl-neuronos\","
-                     "\"object\":\"chat.completion\","
-                     "\"created\":%d,"
-                     "\"model\":\"neuronos-local\","
-                     "\"choices\":[{"
-                     "\"index\":0,"
-                     "\"message\":{\"role\":\"assistant\",\"content\":\"%s\"},"
-                     "\"finish_reason\":\"stop\""
-                     "}],"
-                     "\"usage\":{"
-                     "\"prompt_tokens\":0,"
-                     "\"completion_tokens\":%d,"
-                     "\"total_tokens\":%d"
-                     "}}",
-                     0, escaped, result.n_tokens, result.n_tokens);
-
-            send_json(sock, 200, response);
-            free(response);
-            free(escaped);
+    srv_gen_t ** link = &g_gen_running;
+    while (*link) {
+        srv_gen_t * gen = *link;
+        neuronos_gen_result_t result;
+        if (neuronos_scheduler_take(g_sched, gen->request_id, &result)) {
+            *link = gen->next;
+            gen_finish(gen, &result);
         } else {
-            send_json(sock, 500, "{\"error\":{\"message\":\"Generation failed\"}}");
+            link = &gen->next;
+        }
+    }
+}
+
+
+static void handle_completions(srv_conn_t * conn, const char * body) {
+    if (!g_model) {
+        send_json(conn, 503, "{\"error\":{\"message\":\"No model loaded\"}}");
+        return;
+    }
+
+    char * prompt = nj_alloc_str(body, "prompt");
+    if (!prompt || prompt[0] == '\0') {
+        free(prompt);
+        send_json(conn, 400, "{\"error\":{\"message\":\"Missing prompt\"}}");
+        return;
+    }
+
+    int max_tokens = nj_find_int(body, "max_tokens", 256);
+    float temperature = nj_find_float(body, "temperature", 0.7f);
+
+    gen_submit(conn, GEN_COMPLETION, false, false, prompt, max_tokens, temperature);
+    free(prompt);
+}
+
+static void handle_chat_completions(srv_conn_t * conn, const char * body) {
+    if (!g_model) {
+        send_json(conn, 503, "{\"error\":{\"message\":\"No model loaded\"}}");
+        return;
+    }
+
+    /* A malformed body leaves the doc empty: defaults and the fallback apply */
+    nj_doc_t doc;
+    nj_parse(&doc, body, strlen(body));
+
+    /* Parse messages array and format with chat template */
+    int msg_count = 0;
+    parsed_msg_t * parsed = parse_messages_array(&doc, &msg_count);
+
+    char * formatted_prompt = NULL;
+
+    if (parsed && msg_count > 0) {
+        /* Build neuronos_chat_msg_t array from parsed messages */
+        neuronos_chat_msg_t * chat_msgs = calloc((size_t)msg_count, sizeof(neuronos_chat_msg_t));
+        if (!chat_msgs) {
+            free_parsed_msgs(parsed, msg_count);
+            nj_doc_free(&doc);
+            send_json(conn, 500, "{\"error\":{\"message\":\"Memory allocation failed\"}}");
+            return;
+        }
+        for (int i = 0; i < msg_count; i++) {
+            chat_msgs[i].role = parsed[i].role;
+            chat_msgs[i].content = parsed[i].content;
         }
 
-        neuronos_gen_result_free(&result);
+        neuronos_chat_format(g_model, NULL, chat_msgs, (size_t)msg_count, true, &formatted_prompt);
+        free(chat_msgs);
     }
 
+    /* Fallback: extract last user content if template formatting failed */
+    char * content_fallback = NULL;
+    if (!formatted_prompt) {
+        content_fallback = extract_last_user_content(body);
+        if (!content_fallback) {
+            free_parsed_msgs(parsed, msg_count);
+            nj_doc_free(&doc);
+            send_json(conn, 400, "{\"error\":{\"message\":\"Missing messages content\"}}");
+            return;
+        }
+    }
+
+    const char * effective_prompt = formatted_prompt ? formatted_prompt : content_fallback;
+
+    int max_tokens = (int)nj_int(&doc, nj_get(&doc, 0, "max_tokens"), 256);
+    float temperature = (float)nj_num(&doc, nj_get(&doc, 0, "temperature"), 0.7);
+    bool stream = nj_bool(&doc, nj_get(&doc, 0, "stream"), false);
+    bool include_usage = nj_bool(&doc, nj_get(&doc, nj_get(&doc, 0, "stream_options"), "include_usage"), false);
+    nj_doc_free(&doc);
+
+    gen_submit(conn, GEN_CHAT, stream, include_usage, effective_prompt, max_tokens, temperature);
+
     neuronos_free(formatted_prompt);
+    free(content_fallback);
     free_parsed_msgs(parsed, msg_count);
 }
 
@@ -619,48 +1348,13 @@ static void handle_chat_completions(socket_t sock, const char * body) {
  * Supports: "system": "text" (string form).
  * Returns malloc'd string or NULL.
  */
-static char * parse_anthropic_system(const char * json) {
-    char buf[8192] = {0};
-    if (nj_copy_str(json, "system", buf, sizeof(buf)) >= 0 && buf[0] != '\0') {
-        return strdup(buf);
+static char * parse_anthropic_system(const nj_doc_t * doc) {
+    char * sys = nj_str_dup(doc, nj_get(doc, 0, "system"));
+    if (sys && sys[0] == '\0') {
+        free(sys);
+        sys = NULL;
     }
-    return NULL;
-}
-
-/**
- * SSE callback for Anthropic streaming format.
- * Sends content_block_delta events with text_delta.
- */
-typedef struct {
-    socket_t sock;
-    int n_tokens;
-} anthropic_stream_ctx_t;
-
-static bool anthropic_sse_token_callback(const char * token_text, void * user_data) {
-    anthropic_stream_ctx_t * ctx = (anthropic_stream_ctx_t *)user_data;
-    if (!ctx || !token_text)
-        return false;
-
-    char * escaped = nj_escape(token_text);
-    if (!escaped)
-        return false;
-
-    /* Anthropic streaming format:
-     * event: content_block_delta
-     * data: {"type":"content_block_delta","index":0,"delta":{"type":"text_delta","text":"..."}}
-     */
-    char chunk[4096];
-    int len = snprintf(chunk, sizeof(chunk),
-                       "event: content_block_delta\n"
-                       "data: {\"type\":\"content_block_delta\",\"index\":0,"
-                       "\"delta\":{\"type\":\"text_delta\",\"text\":\"%s\"}}\n\n",
-                       escaped);
-    free(escaped);
-
-    ssize_t sent = send(ctx->sock, chunk, (size_t)len, 0);
-    ctx->n_tokens++;
-
-    return (sent > 0);
+    return sys;
 }
 
 /**
@@ -671,30 +1365,30 @@ static bool anthropic_sse_token_callback(const char * token_text, void * user_da
  * Streaming: message_start → content_block_start → content_block_delta* →
  *            content_block_stop → message_delta → message_stop
  */
-static void handle_anthropic_messages(socket_t sock, const char * body) {
+static void handle_anthropic_messages(srv_conn_t * conn, const char * body) {
     if (!g_model) {
         /* Anthropic error format */
-        send_json(sock, 503,
-                  "{\"type\":\"error\",\"error\":{\"type\":\"api_error\","
-                  "\"message\":\"No model loaded\"}}");
+        send_gen_error(GEN_ANTHROPIC, conn, 503, "No model loaded");
         return;
     }
 
+    nj_doc_t doc;
+    nj_parse(&doc, body, strlen(body));
+
     /* Parse Anthropic-specific fields */
-    char * system_prompt = parse_anthropic_system(body);
-    int max_tokens = nj_find_int(body, "max_tokens", 1024);
-    float temperature = nj_find_float(body, "temperature", 0.7f);
-    bool stream = nj_find_bool(body, "stream", false);
+    char * system_prompt = parse_anthropic_system(&doc);
+    int max_tokens = (int)nj_int(&doc, nj_get(&doc, 0, "max_tokens"), 1024);
+    float temperature = (float)nj_num(&doc, nj_get(&doc, 0, "temperature"), 0.7);
+    bool stream = nj_bool(&doc, nj_get(&doc, 0, "stream"), false);
 
     /* Parse messages array (same format as OpenAI: [{role, content}]) */
     int msg_count = 0;
-    parsed_msg_t * parsed = parse_messages_array(body, &msg_count);
+    parsed_msg_t * parsed = parse_messages_array(&doc, &msg_count);
+    nj_doc_free(&doc);
 
     if (!parsed || msg_count == 0) {
         free(system_prompt);
-        send_json(sock, 400,
-                  "{\"type\":\"error\",\"error\":{\"type\":\"invalid_request_error\","
-                  "\"message\":\"Missing or empty messages array\"}}");
+        send_gen_error(GEN_ANTHROPIC, conn, 400, "Missing or empty messages array");
         return;
     }
 
@@ -724,195 +1418,149 @@ static void handle_anthropic_messages(socket_t sock, const char * body) {
     }
 
     /* Fallback: extract last user content */
-    char content_fallback[8192] = {0};
+    char * content_fallback = NULL;
     if (!formatted_prompt) {
-        if (extract_last_user_content(body, content_fallback, sizeof(content_fallback)) != 0) {
+        content_fallback = extract_last_user_content(body);
+        if (!content_fallback) {
             free(system_prompt);
             free_parsed_msgs(parsed, msg_count);
-            send_json(sock, 400,
-                      "{\"type\":\"error\",\"error\":{\"type\":\"invalid_request_error\","
-                      "\"message\":\"Missing messages content\"}}");
+            send_gen_error(GEN_ANTHROPIC, conn, 400, "Missing messages content");
             return;
         }
     }
 
     const char * effective_prompt = formatted_prompt ? formatted_prompt : content_fallback;
 
-    if (stream) {
-        /* ── Anthropic SSE Streaming ── */
-        send_sse_headers(sock);
+    gen_submit(conn, GEN_ANTHROPIC, stream, false, effective_prompt, max_tokens, temperature);
 
-        /* Event 1: message_start */
-        const char * msg_start =
-            "event: message_start\n"
-            "data: {\"type\":\"message_start\",\"message\":"
-            "{\"id\":\"msg_neuronos_01\",\"type\":\"message\",\"role\":\"assistant\","
-            "\"content\":[],\"model\":\"neuronos-local\",\"stop_reason\":null,"
-            "\"stop_sequence\":null,"
-            "\"usage\":{\"input_tokens\":0,\"output_tokens\":0}}}\n\n";
-        send(sock, msg_start, strlen(msg_start), 0);
-
-        /* Event 2: content_block_start */
-        const char * block_start =
-            "event: content_block_start\n"
-            "data: {\"type\":\"content_block_start\",\"index\":0,"
-            "\"content_block\":{\"type\":\"text\",\"text\":\"\"}}\n\n";
-        send(sock, block_start, strlen(block_start), 0);
-
-        /* Event 3 (repeated): content_block_delta — via token callback */
-        anthropic_stream_ctx_t ctx = {.sock = sock, .n_tokens = 0};
-
-        neuronos_gen_params_t gparams = {
-            .prompt = effective_prompt,
-            .max_tokens = max_tokens,
-            .temperature = temperature,
-            .top_p = 0.95f,
-            .top_k = 40,
-            .grammar = NULL,
-            .on_token = anthropic_sse_token_callback,
-            .user_data = &ctx,
-            .seed = 0,
-        };
-
-        neuronos_gen_result_t result = neuronos_generate(g_model, gparams);
-
-        /* Event 4: content_block_stop */
-        const char * block_stop =
-            "event: content_block_stop\n"
-            "data: {\"type\":\"content_block_stop\",\"index\":0}\n\n";
-        send(sock, block_stop, strlen(block_stop), 0);
+    neuronos_free(formatted_prompt);
+    free(content_fallback);
+    free(system_prompt);
+    free_parsed_msgs(parsed, msg_count);
+}
 
-        /* Event 5: message_delta (with final usage) */
-        char msg_delta[512];
-        snprintf(msg_delta, sizeof(msg_delta),
-                 "event: message_delta\n"
-                 "data: {\"type\":\"message_delta\","
-                 "\"delta\":{\"stop_reason\":\"end_turn\",\"stop_sequence\":null},"
-                 "\"usage\":{\"output_tokens\":%d}}\n\n",
-                 ctx.n_tokens);
-        send(sock, msg_delta, strlen(msg_delta), 0);
+/* ---- Static assets ---- */
 
-        /* Event 6: message_stop */
-        const char * msg_stop =
-            "event: message_stop\n"
-            "data: {\"type\":\"message_stop\"}\n\n";
-        send(sock, msg_stop, strlen(msg_stop), 0);
+/* The chat UI is embedded raw and precompressed (embed_webui.py), so a
+ * page load costs one header snprintf plus a zero-copy send. Each
+ * variant gets a strong ETag at startup; the page isn't versioned, so
+ * browsers revalidate every load and get 304 while it is unchanged. */
+typedef struct {
+    const char * encoding; /* Content-Encoding, NULL = identity */
+    const unsigned char * data;
+    size_t len;
+    char etag[32];
+} srv_asset_variant_t;
+
+static srv_asset_variant_t g_ui_variants[3]; /* preferred first: br, gzip, identity */
+static int g_n_ui_variants = 0;
+
+static void ui_variant_add(const char * encoding, const unsigned char * data, size_t len, uint64_t hash) {
+    srv_asset_variant_t * v = &g_ui_variants[g_n_ui_variants++];
+    v->encoding = encoding;
+    v->data = data;
+    v->len = len;
+    snprintf(v->etag, sizeof(v->etag), "\"%016llx%s%s\"", (unsigned long long)hash, encoding ? "-" : "",
+             encoding ? encoding : "");
+}
 
-        neuronos_gen_result_free(&result);
-    } else {
-        /* ── Non-streaming Anthropic response ── */
-        neuronos_gen_params_t gparams = {
-            .prompt = effective_prompt,
-            .max_tokens = max_tokens,
-            .temperature = temperature,
-            .top_p = 0.95f,
-            .top_k = 40,
-            .grammar = NULL,
-            .on_token = NULL,
-            .user_data = NULL,
-            .seed = 0,
-        };
+static void srv_assets_init(void) {
+    /* FNV-1a of the page: the ETag changes exactly when the UI does */
+    uint64_t h = 1469598103934665603ULL;
+    for (unsigned int i = 0; i < neuronos_chat_ui_html_len; i++)
+        h = (h ^ neuronos_chat_ui_html[i]) * 1099511628211ULL;
 
-        neuronos_gen_result_t result = neuronos_generate(g_model, gparams);
-
-        if (result.status == NEURONOS_OK && result.text) {
-            char * escaped = nj_escape(result.text);
-            if (!escaped) {
-                send_json(sock, 500,
-                          "{\"type\":\"error\",\"error\":{\"type\":\"api_error\","
-                          "\"message\":\"Memory allocation failed\"}}");
-                neuronos_gen_result_free(&result);
-                neuronos_free(formatted_prompt);
-                free(system_prompt);
-                free_parsed_msgs(parsed, msg_count);
-                return;
-            }
+    g_n_ui_variants = 0;
+#if NEURONOS_CHAT_UI_HAS_BROTLI
+    ui_variant_add("br", neuronos_chat_ui_html_br, neuronos_chat_ui_html_br_len, h);
+#endif
+#if NEURONOS_CHAT_UI_IS_GZIPPED
+    ui_variant_add("gzip", neuronos_chat_ui_html_gz, neuronos_chat_ui_html_gz_len, h);
+#endif
+    ui_variant_add(NULL, neuronos_chat_ui_html, neuronos_chat_ui_html_len, h);
+}
 
-            /* Anthropic Messages response format */
-            size_t resp_cap = strlen(escaped) + 512;
-            char * response = malloc(resp_cap);
-            if (!response) {
-                free(escaped);
-                send_json(sock, 500,
-                          "{\"type\":\"error\",\"error\":{\"type\":\"api_error\","
-                          "\"message\":\"Memory allocation failed\"}}");
-                neuronos_gen_result_free(&result);
-                neuronos_free(formatted_prompt);
-                free(system_prompt);
-                free_parsed_msgs(parsed, msg_count);
-                return;
-            }
+/* If-None-Match: comma-separated list or "*", compared weakly (RFC 9110) */
+static bool etag_matches(const char * list, const char * etag) {
+    size_t elen = strlen(etag);
+    const char * p = list;
+    while (*p) {
+        while (*p == ' ' || *p == ',')
+            p++;
+        if (*p == '*')
+            return true;
+        if (p[0] == 'W' && p[1] == '/')
+            p += 2;
+        const char * tok = p;
+        while (*p && *p != ',' && *p != ' ')
+            p++;
+        if ((size_t)(p - tok) == elen && memcmp(tok, etag, elen) == 0)
+            return true;
+    }
+    return false;
+}
 
-            snprintf(response, resp_cap,
-                     "{\"id\":\"msg_neuronos_01\","
-                     "\"type\":\"message\","
-                     "\"role\":\"assistant\","
-                     "\"content\":[{\"type\":\"text\",\"text\":\"%s\"}],"
-                     "\"model\":\"neuronos-local\","
-                     "\"stop_reason\":\"end_turn\","
-                     "\"stop_sequence\":null,"
-                     "\"usage\":{"
-                     "\"input_tokens\":0,"
-                     "\"output_tokens\":%d"
-                     "}}",
-                     escaped, result.n_tokens);
-
-            send_json(sock, 200, response);
-            free(response);
-            free(escaped);
-        } else {
-            send_json(sock, 500,
-                      "{\"type\":\"error\",\"error\":{\"type\":\"api_error\","
-                      "\"message\":\"Generation failed\"}}");
+static void handle_root(srv_conn_t * conn) {
+    const http_request_t * req = &conn->req;
+    const srv_asset_variant_t * v = &g_ui_variants[g_n_ui_variants - 1];
+    for (int i = 0; i < g_n_ui_variants - 1; i++) {
+        const char * enc = g_ui_variants[i].encoding;
+        if ((strcmp(enc, "br") == 0 && req->accept_br) || (strcmp(enc, "gzip") == 0 && req->accept_gzip)) {
+            v = &g_ui_variants[i];
+            break;
         }
-
-        neuronos_gen_result_free(&result);
     }
 
-    neuronos_free(formatted_prompt);
-    free(system_prompt);
-    free_parsed_msgs(parsed, msg_count);
-}
+    bool not_modified = req->if_none_match[0] && etag_matches(req->if_none_match, v->etag);
+    bool head_only = strcmp(req->method, "HEAD") == 0;
 
-static void handle_root(socket_t sock, bool accept_gzip) {
-#if NEURONOS_CHAT_UI_IS_GZIPPED
-    if (accept_gzip) {
-        /* Serve gzip-compressed embedded Chat UI */
-        send_gzip_response(sock, "text/html; charset=utf-8",
-                           neuronos_chat_ui_html_gz, (int)neuronos_chat_ui_html_gz_len);
-        return;
-    }
-    /* Fallback: browser doesn't support gzip — serve a redirect hint */
-    const char * html = "<!DOCTYPE html><html><head><title>NeuronOS</title></head><body>"
-                        "<h1>NeuronOS v" NEURONOS_VERSION_STRING "</h1>"
-                        "<p>Your browser needs gzip support for the Chat UI.</p>"
-                        "<p>Use a modern browser (Chrome, Firefox, Safari, Edge).</p>"
-                        "</body></html>";
-    send_response(sock, 200, "OK", "text/html; charset=utf-8", html, (int)strlen(html));
-#else
-    /* Non-gzipped embedded Chat UI */
-    send_response(sock, 200, "OK", "text/html; charset=utf-8",
-                  (const char *)neuronos_chat_ui_html, (int)neuronos_chat_ui_html_len);
-#endif
+    char head[512];
+    int hlen = snprintf(head, sizeof(head),
+                        "HTTP/1.1 %s\r\n"
+                        "Content-Type: text/html; charset=utf-8\r\n"
+                        "%s%s%s"
+                        "Content-Length: %zu\r\n"
+                        "ETag: %s\r\n"
+                        "Cache-Control: no-cache\r\n"
+                        "Vary: Accept-Encoding\r\n"
+                        "Access-Control-Allow-Origin: *\r\n"
+                        "Connection: %s\r\n"
+                        "\r\n",
+                        not_modified ? "304 Not Modified" : "200 OK", v->encoding ? "Content-Encoding: " : "",
+                        v->encoding ? v->encoding : "", v->encoding ? "\r\n" : "", v->len, v->etag, conn->keep_alive ? "keep-alive" : "close");
+    if (not_modified || head_only)
+        conn_send(conn, head, (size_t)hlen);
+    else
+        conn_queue_static(conn, head, (size_t)hlen, v->data, v->len);
 }
 
 /* ---- Agent SSE Chat Endpoint ---- */
 
 /* Context for agent step callback during SSE streaming */
 typedef struct {
-    socket_t sock;
+    srv_conn_t * conn;
     bool ok;
 } agent_sse_ctx_t;
 
-/* Send an SSE event to the client */
-static void sse_send_event(socket_t sock, const char * json_payload) {
+/* Send an SSE event to the client. Returns false once the peer is gone. */
+static bool sse_send_event(srv_conn_t * conn, const char * json_payload) {
     char buf[16384];
     int len = snprintf(buf, sizeof(buf), "data: %s\n\n", json_payload);
     if (len > 0 && len < (int)sizeof(buf)) {
-        send(sock, buf, (size_t)len, 0);
+        return conn_send(conn, buf, (size_t)len);
     }
+    return !conn->send_failed;
 }
 
+/* Cancellation poll for the agent: stops between steps and mid-generation */
+static bool agent_sse_cancelled(void * user_data) {
+    agent_sse_ctx_t * ctx = (agent_sse_ctx_t *)user_data;
+    if (!ctx->ok || !g_running || conn_client_gone(ctx->conn))
+        ctx->ok = false;
+    return !ctx->ok;
+}
+
+
 /* Agent step callback: sends thinking/tool/observation as SSE events */
 static void agent_sse_step_cb(int step, const char * thought, const char * action,
                                const char * observation, void * user_data) {
@@ -928,7 +1576,7 @@ static void agent_sse_step_cb(int step, const char * thought, const char * actio
         if (esc) {
             char ev[8192];
             snprintf(ev, sizeof(ev), "{\"type\":\"thinking\",\"text\":\"%s\"}", esc);
-            sse_send_event(ctx->sock, ev);
+            ctx->ok = sse_send_event(ctx->conn, ev);
             free(esc);
         }
     }
@@ -943,7 +1591,7 @@ static void agent_sse_step_cb(int step, const char * thought, const char * actio
             if (esc_act) {
                 char ev[4096];
                 snprintf(ev, sizeof(ev), "{\"type\":\"tool\",\"name\":\"%s\"}", esc_act);
-                sse_send_event(ctx->sock, ev);
+                ctx->ok = sse_send_event(ctx->conn, ev);
                 free(esc_act);
             }
         } else {
@@ -955,7 +1603,7 @@ static void agent_sse_step_cb(int step, const char * thought, const char * actio
             if (esc_obs) {
                 char ev[8192];
                 snprintf(ev, sizeof(ev), "{\"type\":\"observation\",\"text\":\"%s\"}", esc_obs);
-                sse_send_event(ctx->sock, ev);
+                ctx->ok = sse_send_event(ctx->conn, ev);
                 free(esc_obs);
             }
         }
@@ -963,27 +1611,38 @@ static void agent_sse_step_cb(int step, const char * thought, const char * actio
 }
 
 /* POST /api/chat — Interactive agent with SSE streaming of steps */
-static void handle_agent_chat(socket_t sock, const char * body) {
+static void handle_agent_chat(srv_conn_t * conn, const char * body) {
     if (!g_agent) {
-        send_json(sock, 503, "{\"error\":{\"message\":\"Agent not available\"}}");
+        send_json(conn, 503, "{\"error\":{\"message\":\"Agent not available\"}}");
         return;
     }
 
     /* Extract message from body: {"message": "user text"} */
-    char message[8192] = {0};
-    if (nj_copy_str(body, "message", message, sizeof(message)) < 0) {
-        send_json(sock, 400, "{\"error\":{\"message\":\"Missing 'message' field\"}}");
+    char * message = nj_alloc_str(body, "message");
+    if (!message) {
+        send_json(conn, 400, "{\"error\":{\"message\":\"Missing 'message' field\"}}");
         return;
     }
 
     /* Send SSE headers */
-    send_sse_headers(sock);
+    send_sse_headers(conn);
 
     /* Run agent with SSE step callback */
-    agent_sse_ctx_t ctx = {.sock = sock, .ok = true};
+    agent_sse_ctx_t ctx = {.conn = conn, .ok = true};
+    neuronos_agent_set_cancel(g_agent, agent_sse_cancelled, &ctx);
+    neuronos_metrics_gauge_add(NEURONOS_GAUGE_IN_FLIGHT, 1);
     neuronos_agent_result_t result = neuronos_agent_chat(g_agent, message, agent_sse_step_cb, &ctx);
+    neuronos_metrics_gauge_add(NEURONOS_GAUGE_IN_FLIGHT, -1);
+    neuronos_agent_set_cancel(g_agent, NULL, NULL);
 
     /* Send final response event */
+    if (result.status == NEURONOS_ERROR_CANCELLED) {
+        neuronos_metrics_add(NEURONOS_COUNTER_CANCELLED, 1);
+        conn->keep_alive = false;
+        neuronos_agent_result_free(&result);
+        free(message);
+        return;
+    }
     if (result.status == NEURONOS_OK && result.text) {
         char * esc = nj_escape(result.text);
         if (esc) {
@@ -993,29 +1652,792 @@ static void handle_agent_chat(socket_t sock, const char * body) {
             if (ev) {
                 snprintf(ev, ev_cap, "{\"type\":\"response\",\"text\":\"%s\",\"steps\":%d}",
                          esc, result.steps_taken);
-                sse_send_event(sock, ev);
+                sse_send_event(conn, ev);
                 free(ev);
             }
             free(esc);
         }
     } else {
-        sse_send_event(sock, "{\"type\":\"error\",\"text\":\"Agent failed to generate response\"}");
+        sse_send_event(conn, "{\"type\":\"error\",\"text\":\"Agent failed to generate response\"}");
     }
 
     /* Send done marker */
     const char * done = "data: [DONE]\n\n";
-    send(sock, done, strlen(done), 0);
+    conn_send(conn, done, strlen(done));
 
     neuronos_agent_result_free(&result);
+    free(message);
+}
+
+
+/* ---- Inference thread ---- */
+
+static struct {
+    srv_mutex_t mu;
+    srv_cond_t cv;
+    srv_conn_t * jobs; /* requests handed over by the event loop (FIFO) */
+    srv_conn_t * jobs_tail;
+    srv_conn_t * done; /* connections handed back to the loop */
+    bool stop;
+} g_q;
+
+/* Readable end wakes the event loop when g_q.done gains a connection */
+static socket_t g_wake_rd = INVALID_SOCK;
+static socket_t g_wake_wr = INVALID_SOCK;
+
+static void srv_wake(void) {
+    char b = 1;
+#ifdef _WIN32
+    send(g_wake_wr, &b, 1, 0);
+#else
+    ssize_t r = write(g_wake_wr, &b, 1); /* a full pipe already means "wake up" */
+    (void)r;
+#endif
+}
+
+/* Hand a connection back to the event loop once its response is complete */
+static void conn_release(srv_conn_t * conn) {
+    srv_mutex_lock(&g_q.mu);
+    conn->next_job = g_q.done;
+    g_q.done = conn;
+    srv_mutex_unlock(&g_q.mu);
+    srv_wake();
+}
+
+static bool is_inference_request(const http_request_t * req) {
+    if (strcmp(req->method, "POST") != 0)
+        return false;
+    return strcmp(req->path, "/v1/completions") == 0 || strcmp(req->path, "/v1/chat/completions") == 0 ||
+           strcmp(req->path, "/v1/messages") == 0 || strcmp(req->path, "/api/chat") == 0;
+}
+
+static void route_inference(srv_conn_t * conn) {
+    const http_request_t * req = &conn->req;
+    if (strcmp(req->path, "/v1/completions") == 0) {
+        handle_completions(conn, req->body);
+    } else if (strcmp(req->path, "/v1/chat/completions") == 0) {
+        handle_chat_completions(conn, req->body);
+    } else if (strcmp(req->path, "/v1/messages") == 0) {
+        handle_anthropic_messages(conn, req->body);
+    } else {
+        handle_agent_chat(conn, req->body);
+    }
+}
+
+static void srv_worker_main(void) {
+    for (;;) {
+        srv_mutex_lock(&g_q.mu);
+        while (!g_q.stop && !g_q.jobs && !g_gen_waiting && !g_gen_running)
+            srv_cond_wait(&g_q.cv, &g_q.mu);
+        bool stop = g_q.stop;
+        srv_conn_t * jobs = stop ? NULL : g_q.jobs;
+        if (!stop)
+            g_q.jobs = g_q.jobs_tail = NULL;
+        srv_mutex_unlock(&g_q.mu);
+        if (stop)
+            break;
+
+        while (jobs) {
+            srv_conn_t * conn = jobs;
+            jobs = conn->next_job;
+            conn->next_job = NULL;
+            route_inference(conn);
+            if (!conn->in_gen)
+                conn_release(conn);
+        }
+
+        gen_step();
+    }
+
+    /* Shutdown: the loop closes every connection after the join */
+    srv_gen_t * gen;
+    while ((gen = gen_pop_waiting()) != NULL)
+        gen_free(gen);
+    while ((gen = g_gen_running) != NULL) {
+        g_gen_running = gen->next;
+        gen_free(gen);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI srv_worker_thread(LPVOID arg) {
+    (void)arg;
+    srv_worker_main();
+    return 0;
+}
+#else
+static void * srv_worker_thread(void * arg) {
+    (void)arg;
+    srv_worker_main();
+    return NULL;
+}
+#endif
+
+/* ---- Readiness poller: epoll / kqueue / poll ---- */
+
+#define SRV_EV_READ 1
+#define SRV_EV_WRITE 2
+
+typedef struct {
+    void * tag;
+    int events;
+} srv_event_t;
+
+static char g_listen_tag; /* tags of the non-connection sockets */
+static char g_wake_tag;
+
+#if defined(SRV_POLL_EPOLL)
+
+static int g_poll_fd = -1;
+
+static bool poller_init(void) {
+    g_poll_fd = epoll_create1(EPOLL_CLOEXEC);
+    return g_poll_fd >= 0;
+}
+
+static void poller_close(void) {
+    if (g_poll_fd >= 0)
+        close(g_poll_fd);
+    g_poll_fd = -1;
+}
+
+/* Change fd's interest from old_mask to new_mask (-1 = not registered) */
+static void poller_ctl(socket_t fd, void * tag, int old_mask, int new_mask) {
+    struct epoll_event ev = {0};
+    ev.events = ((new_mask & SRV_EV_READ) ? EPOLLIN : 0) | ((new_mask & SRV_EV_WRITE) ? EPOLLOUT : 0);
+    ev.data.ptr = tag;
+    if (new_mask < 0)
+        epoll_ctl(g_poll_fd, EPOLL_CTL_DEL, fd, &ev);
+    else
+        epoll_ctl(g_poll_fd, old_mask < 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &ev);
+}
+
+static int poller_wait(srv_event_t * out, int max, int timeout_ms) {
+    struct epoll_event evs[SRV_MAX_EVENTS];
+    int n = epoll_wait(g_poll_fd, evs, max < SRV_MAX_EVENTS ? max : SRV_MAX_EVENTS, timeout_ms);
+    for (int i = 0; i < n; i++) {
+        out[i].tag = evs[i].data.ptr;
+        out[i].events = ((evs[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) ? SRV_EV_READ : 0) |
+                        ((evs[i].events & EPOLLOUT) ? SRV_EV_WRITE : 0);
+    }
+    return n < 0 ? 0 : n;
+}
+
+#elif defined(SRV_POLL_KQUEUE)
+
+static int g_poll_fd = -1;
+
+static bool poller_init(void) {
+    g_poll_fd = kqueue();
+    return g_poll_fd >= 0;
+}
+
+static void poller_close(void) {
+    if (g_poll_fd >= 0)
+        close(g_poll_fd);
+    g_poll_fd = -1;
+}
+
+/* Both filters are added once and toggled with EV_ENABLE / EV_DISABLE */
+static void poller_ctl(socket_t fd, void * tag, int old_mask, int new_mask) {
+    struct kevent ch[2];
+    if (new_mask < 0) {
+        EV_SET(&ch[0], fd, EVFILT_READ, EV_DELETE, 0, 0, NULL);
+        EV_SET(&ch[1], fd, EVFILT_WRITE, EV_DELETE, 0, 0, NULL);
+    } else {
+        unsigned short add = old_mask < 0 ? EV_ADD : 0;
+        EV_SET(&ch[0], fd, EVFILT_READ, add | ((new_mask & SRV_EV_READ) ? EV_ENABLE : EV_DISABLE), 0, 0, tag);
+        EV_SET(&ch[1], fd, EVFILT_WRITE, add | ((new_mask & SRV_EV_WRITE) ? EV_ENABLE : EV_DISABLE), 0, 0, tag);
+    }
+    kevent(g_poll_fd, ch, 2, NULL, 0, NULL);
+}
+
+static int poller_wait(srv_event_t * out, int max, int timeout_ms) {
+    struct kevent evs[SRV_MAX_EVENTS];
+    struct timespec ts = {.tv_sec = timeout_ms / 1000, .tv_nsec = (long)(timeout_ms % 1000) * 1000000L};
+    int n = kevent(g_poll_fd, NULL, 0, evs, max < SRV_MAX_EVENTS ? max : SRV_MAX_EVENTS, &ts);
+    for (int i = 0; i < n; i++) {
+        out[i].tag = (void *)evs[i].udata;
+        out[i].events = evs[i].filter == EVFILT_WRITE ? SRV_EV_WRITE : SRV_EV_READ;
+    }
+    return n < 0 ? 0 : n;
+}
+
+#else /* SRV_POLL_POLL: poll(), or WSAPoll() on Windows */
+
+    #ifdef _WIN32
+typedef WSAPOLLFD srv_pollfd_t;
+        #define srv_poll WSAPoll
+    #else
+typedef struct pollfd srv_pollfd_t;
+        #define srv_poll poll
+    #endif
+
+static struct {
+    socket_t fd;
+    void * tag;
+    int mask;
+} g_poll_set[SRV_MAX_CONNS + 2]; /* + listener and wake socket */
+static srv_pollfd_t g_poll_fds[SRV_MAX_CONNS + 2];
+static int g_poll_n = 0;
+
+static bool poller_init(void) {
+    g_poll_n = 0;
+    return true;
+}
+
+static void poller_close(void) {
+    g_poll_n = 0;
+}
+
+static void poller_ctl(socket_t fd, void * tag, int old_mask, int new_mask) {
+    (void)old_mask;
+    int i = 0;
+    while (i < g_poll_n && g_poll_set[i].fd != fd)
+        i++;
+    if (new_mask < 0) {
+        if (i < g_poll_n)
+            g_poll_set[i] = g_poll_set[--g_poll_n];
+        return;
+    }
+    if (i == g_poll_n) {
+        if (g_poll_n == SRV_MAX_CONNS + 2)
+            return;
+        g_poll_n++;
+    }
+    g_poll_set[i].fd = fd;
+    g_poll_set[i].tag = tag;
+    g_poll_set[i].mask = new_mask;
+}
+
+static int poller_wait(srv_event_t * out, int max, int timeout_ms) {
+    for (int i = 0; i < g_poll_n; i++) {
+        g_poll_fds[i].fd = g_poll_set[i].fd;
+        g_poll_fds[i].events = (short)(((g_poll_set[i].mask & SRV_EV_READ) ? POLLIN : 0) |
+                                       ((g_poll_set[i].mask & SRV_EV_WRITE) ? POLLOUT : 0));
+        g_poll_fds[i].revents = 0;
+    }
+    if (srv_poll(g_poll_fds, (unsigned)g_poll_n, timeout_ms) <= 0)
+        return 0;
+
+    int n = 0;
+    for (int i = 0; i < g_poll_n && n < max; i++) {
+        short re = g_poll_fds[i].revents;
+        if (!re)
+            continue;
+        out[n].tag = g_poll_set[i].tag;
+        out[n].events = ((re & (POLLIN | POLLHUP | POLLERR)) ? SRV_EV_READ : 0) | ((re & POLLOUT) ? SRV_EV_WRITE : 0);
+        n++;
+    }
+    return n;
+}
+
+#endif
+
+/* ---- Event loop ---- */
+
+static srv_conn_t * g_conns = NULL; /* every open connection */
+static int g_n_conns = 0;
+
+/* Admission control (event loop only) */
+static int g_n_inference = 0;     /* connections handed to the inference thread */
+static int g_max_pending = 0;     /* n_slots + max_queue, 0 = unbounded */
+static int g_max_per_client = 0;  /* 0 = unlimited */
+static double g_service_ms = 0.0; /* moving average of hand-over → release */
+
+static void sock_set_blocking(socket_t fd, bool blocking) {
+#ifdef _WIN32
+    u_long mode = blocking ? 0 : 1;
+    ioctlsocket(fd, FIONBIO, &mode);
+#else
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK));
+#endif
+}
+
+static bool srv_wake_init(void) {
+#ifdef _WIN32
+    /* WSAPoll only takes sockets: a loopback UDP socket connected to itself */
+    socket_t s = socket(AF_INET, SOCK_DGRAM, 0);
+    if (s == INVALID_SOCK)
+        return false;
+    struct sockaddr_in a = {0};
+    a.sin_family = AF_INET;
+    a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int alen = sizeof(a);
+    if (bind(s, (struct sockaddr *)&a, sizeof(a)) != 0 || getsockname(s, (struct sockaddr *)&a, &alen) != 0 ||
+        connect(s, (struct sockaddr *)&a, sizeof(a)) != 0) {
+        closesocket(s);
+        return false;
+    }
+    sock_set_blocking(s, false);
+    g_wake_rd = g_wake_wr = s;
+#else
+    int fds[2];
+    if (pipe(fds) != 0)
+        return false;
+    sock_set_blocking(fds[0], false);
+    sock_set_blocking(fds[1], false);
+    g_wake_rd = fds[0];
+    g_wake_wr = fds[1];
+#endif
+    return true;
+}
+
+static void srv_wake_drain(void) {
+    char buf[64];
+#ifdef _WIN32
+    while (recv(g_wake_rd, buf, sizeof(buf), 0) > 0) {
+    }
+#else
+    while (read(g_wake_rd, buf, sizeof(buf)) > 0) {
+    }
+#endif
+}
+
+static void srv_wake_close(void) {
+    if (g_wake_wr != INVALID_SOCK && g_wake_wr != g_wake_rd)
+        close_socket(g_wake_wr);
+    if (g_wake_rd != INVALID_SOCK)
+        close_socket(g_wake_rd);
+    g_wake_rd = g_wake_wr = INVALID_SOCK;
+}
+
+static void conn_close(srv_conn_t * conn) {
+    if (conn->interest >= 0)
+        poller_ctl(conn->fd, conn, conn->interest, -1);
+    close_socket(conn->fd);
+
+    if (conn->prev)
+        conn->prev->next = conn->next;
+    else
+        g_conns = conn->next;
+    if (conn->next)
+        conn->next->prev = conn->prev;
+    g_n_conns--;
+
+    free(conn->in);
+    free(conn->out);
+    free(conn);
+}
+
+/* Send queued output without blocking.
+ * Returns 1 when drained, 0 if the socket is full, -1 on error. */
+static int conn_flush(srv_conn_t * conn) {
+    if (conn->send_failed)
+        return -1;
+    while (conn->out_off < conn->out_len || conn->body_off < conn->body_len) {
+        size_t head_left = conn->out_len - conn->out_off;
+        ssize_t n = sock_send2(conn->fd, conn->out + conn->out_off, head_left, conn->body + conn->body_off,
+                               conn->body_len - conn->body_off);
+        if (n < 0 && sock_would_block())
+            return 0;
+        if (n <= 0)
+            return -1;
+        if ((size_t)n <= head_left) {
+            conn->out_off += (size_t)n;
+        } else {
+            conn->out_off = conn->out_len;
+            conn->body_off += (size_t)n - head_left;
+        }
+        conn->last_active_ms = srv_now_ms();
+    }
+    conn->out_off = conn->out_len = 0;
+    conn->body = NULL;
+    conn->body_len = conn->body_off = 0;
+    return 1;
+}
+
+/* Flush, then register the interest the connection needs now (or close it) */
+static void conn_update(srv_conn_t * conn) {
+    int rc = conn_flush(conn);
+    if (rc < 0 || (rc > 0 && conn->closing)) {
+        conn_close(conn);
+        return;
+    }
+    int want = (rc == 0 ? SRV_EV_WRITE : 0) | (conn->closing || conn->peer_closed ? 0 : SRV_EV_READ);
+    if (want == 0) {
+        conn_close(conn);
+        return;
+    }
+    if (want != conn->interest) {
+        poller_ctl(conn->fd, conn, conn->interest, want);
+        conn->interest = want;
+    }
+}
+
+/* Grow the input buffer so `need` more bytes (plus the NUL) fit.
+ * Returns false at SRV_IN_MAX or when out of memory. */
+static bool conn_reserve(srv_conn_t * conn, int need) {
+    int want = conn->in_len + need + 1;
+    if (want <= conn->in_cap)
+        return true;
+    if (conn->in_cap >= SRV_IN_MAX)
+        return false;
+    int cap = conn->in_cap;
+    while (cap < want && cap < SRV_IN_MAX)
+        cap *= 2;
+    if (cap > SRV_IN_MAX)
+        cap = SRV_IN_MAX;
+    char * in = realloc(conn->in, (size_t)cap);
+    if (!in)
+        return false;
+    conn->in = in;
+    conn->in_cap = cap;
+    return true;
+}
+
+/* Drop the handled request from the input buffer */
+static void conn_consume(srv_conn_t * conn) {
+    if (conn->req_len <= 0)
+        return;
+    conn->in[conn->req_len] = conn->req_saved;
+    conn->in_len -= conn->req_len;
+    memmove(conn->in, conn->in + conn->req_len, (size_t)conn->in_len);
+    conn->req_len = 0;
+    memset(&conn->req, 0, sizeof(conn->req));
+
+    /* Don't hold a large request's buffer across keep-alive idle time */
+    if (conn->in_len == 0 && conn->in_cap > SRV_IN_KEEP) {
+        char * in = realloc(conn->in, SRV_IN_INITIAL);
+        if (in) {
+            conn->in = in;
+            conn->in_cap = SRV_IN_INITIAL;
+        }
+    }
+}
+
+/* 429 / 503 with a Retry-After hint. The body mirrors each API's error shape. */
+static void send_busy(srv_conn_t * conn, int status, int retry_after_s) {
+    const bool anthropic = strcmp(conn->req.path, "/v1/messages") == 0;
+    const char * message = status == 429 ? "Too many concurrent requests from this client" : "Server is busy";
+    char body[256];
+    if (anthropic) {
+        snprintf(body, sizeof(body), "{\"type\":\"error\",\"error\":{\"type\":\"%s\",\"message\":\"%s\"}}",
+                 status == 429 ? "rate_limit_error" : "overloaded_error", message);
+    } else {
+        snprintf(body, sizeof(body), "{\"error\":{\"message\":\"%s\"}}", message);
+    }
+
+    char header[512];
+    int body_len = (int)strlen(body);
+    int hlen = snprintf(header, sizeof(header),
+                        "HTTP/1.1 %d %s\r\n"
+                        "Content-Type: application/json\r\n"
+                        "Content-Length: %d\r\n"
+                        "Retry-After: %d\r\n"
+                        "Access-Control-Allow-Origin: *\r\n"
+                        "Connection: %s\r\n"
+                        "\r\n",
+                        status, status == 429 ? "Too Many Requests" : "Service Unavailable", body_len, retry_after_s,
+                        conn->keep_alive ? "keep-alive" : "close");
+    conn_send(conn, header, (size_t)hlen);
+    conn_send(conn, body, (size_t)body_len);
+}
+
+/* Seconds until `waves` rounds of n_slots requests have drained */
+static int srv_retry_after(int waves) {
+    double s = (double)waves * g_service_ms / 1000.0;
+    int secs = (int)s + (s > (int)s ? 1 : 0);
+    if (secs < 1)
+        secs = 1;
+    return secs < SRV_RETRY_AFTER_MAX_S ? secs : SRV_RETRY_AFTER_MAX_S;
+}
+
+/* Admission control for an inference request, decided on the loop
+ * before the body is read (Expect: 100-continue) or handed over.
+ * Sheds load early instead of queueing without bound.
+ * Returns true if the request was refused. */
+static bool srv_shed(srv_conn_t * conn) {
+    if (g_max_per_client > 0) {
+        int n = 0;
+        for (const srv_conn_t * c = g_conns; c; c = c->next)
+            n += c->inferring && c->peer_ip == conn->peer_ip;
+        if (n >= g_max_per_client) {
+            neuronos_metrics_add(NEURONOS_COUNTER_REJECTED, 1);
+            send_busy(conn, 429, srv_retry_after(1));
+            return true;
+        }
+    }
+    if (g_max_pending > 0 && g_n_inference >= g_max_pending) {
+        neuronos_metrics_add(NEURONOS_COUNTER_REJECTED, 1);
+        send_busy(conn, 503, srv_retry_after((g_n_inference - g_n_slots) / g_n_slots + 1));
+        return true;
+    }
+    return false;
+}
+
+/* Move the connection to the inference thread; the loop stops polling it */
+static void conn_handoff(srv_conn_t * conn) {
+    if (conn->interest >= 0)
+        poller_ctl(conn->fd, conn, conn->interest, -1);
+    conn->interest = -1;
+    sock_set_blocking(conn->fd, true);
+    conn->blocking = true;
+    conn->inferring = true;
+    conn->handoff_ms = srv_now_ms();
+    conn->peer_gone = false;
+    conn->peer_polled_ms = 0.0;
+    g_n_inference++;
+
+    srv_mutex_lock(&g_q.mu);
+    if (g_q.jobs_tail)
+        g_q.jobs_tail->next_job = conn;
+    else
+        g_q.jobs = conn;
+    g_q.jobs_tail = conn;
+    srv_cond_signal(&g_q.cv);
+    srv_mutex_unlock(&g_q.mu);
+}
+
+static void route_inline(srv_conn_t * conn) {
+    const http_request_t * req = &conn->req;
+    if (strcmp(req->method, "OPTIONS") == 0) {
+        /* CORS preflight */
+        send_response(conn, 204, "No Content", "text/plain", "", 0);
+    } else if (strcmp(req->path, "/health") == 0) {
+        handle_health(conn);
+    } else if (strcmp(req->path, "/metrics") == 0) {
+        handle_metrics(conn, req->accept_json);
+    } else if (strcmp(req->path, "/v1/models") == 0) {
+        handle_models(conn);
+    } else if (strcmp(req->path, "/") == 0) {
+        handle_root(conn);
+    } else {
+        send_json(conn, 404, "{\"error\":{\"message\":\"Not found\"}}");
+    }
+}
+
+/*
+ * Answer every complete request buffered on conn, in order.
+ * Returns false once the connection was handed to the inference
+ * thread (the loop must not touch it until it comes back).
+ */
+static bool conn_process(srv_conn_t * conn) {
+    while (!conn->closing) {
+        conn->in[conn->in_len] = '\0';
+        int len = parse_request(conn->in, &conn->in_len, &conn->req);
+        if (len == 0 && conn->in_len + 1 >= SRV_IN_MAX)
+            len = -2; /* buffer full and still incomplete */
+
+        if (len == 0) {
+            if (conn->req.expect_continue && !conn->sent_continue) {
+                if (is_inference_request(&conn->req)) {
+                    /* Refuse before the client sends the body */
+                    conn->keep_alive = false;
+                    if (srv_shed(conn)) {
+                        conn->closing = true;
+                        break;
+                    }
+                    conn->keep_alive = conn->req.keep_alive;
+                }
+                const char * cont = "HTTP/1.1 100 Continue\r\n\r\n";
+                conn_queue(conn, cont, strlen(cont));
+                conn->sent_continue = true;
+            }
+            if (conn->peer_closed)
+                conn->closing = true; /* the request can never complete */
+            break;
+        }
+        if (len < 0) {
+            conn->keep_alive = false;
+            if (len == -2)
+                send_json(conn, 413, "{\"error\":{\"message\":\"Request too large\"}}");
+            else if (len == -3)
+                send_json(conn, 501, "{\"error\":{\"message\":\"Transfer-Encoding not supported\"}}");
+            else
+                send_json(conn, 400, "{\"error\":{\"message\":\"Malformed request\"}}");
+            conn->closing = true;
+            break;
+        }
+
+        neuronos_metrics_add(NEURONOS_COUNTER_HTTP_REQUESTS, 1);
+        conn->sent_continue = false;
+        conn->keep_alive = conn->req.keep_alive;
+        conn->req_len = len;
+        /* NUL-terminate the body in place for the JSON helpers */
+        conn->req_saved = conn->in[len];
+        conn->in[len] = '\0';
+
+        if (is_inference_request(&conn->req)) {
+            if (!srv_shed(conn)) {
+                conn_handoff(conn);
+                return false;
+            }
+            conn_consume(conn);
+            if (!conn->keep_alive)
+                conn->closing = true;
+            continue;
+        }
+
+        route_inline(conn);
+        conn_consume(conn);
+        if (!conn->keep_alive)
+            conn->closing = true;
+    }
+    return true;
+}
+
+static void srv_accept(socket_t server_fd) {
+    for (;;) {
+        struct sockaddr_in client_addr;
+        socklen_t client_len = sizeof(client_addr);
+        socket_t fd = accept(server_fd, (struct sockaddr *)&client_addr, &client_len);
+        if (fd == INVALID_SOCK) {
+            if (!sock_would_block() && g_running)
+                fprintf(stderr, "Warning: accept() failed\n");
+            return;
+        }
+
+        srv_conn_t * conn = g_n_conns < SRV_MAX_CONNS ? calloc(1, sizeof(srv_conn_t)) : NULL;
+        char * in = conn ? malloc(SRV_IN_INITIAL) : NULL;
+        if (!in) {
+            free(conn);
+            close_socket(fd);
+            continue;
+        }
+        conn->in = in;
+        conn->in_cap = SRV_IN_INITIAL;
+
+        sock_set_blocking(fd, false);
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (const char *)&one, sizeof(one)); /* SSE frames go out at once */
+#ifdef _WIN32
+        DWORD send_timeout = SRV_SEND_TIMEOUT_MS;
+#else
+        struct timeval send_timeout = {.tv_sec = SRV_SEND_TIMEOUT_MS / 1000, .tv_usec = 0};
+#endif
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, (const char *)&send_timeout, sizeof(send_timeout));
+
+        conn->fd = fd;
+        conn->peer_ip = client_addr.sin_addr.s_addr;
+        conn->interest = -1;
+        conn->last_active_ms = srv_now_ms();
+        conn->next = g_conns;
+        if (g_conns)
+            g_conns->prev = conn;
+        g_conns = conn;
+        g_n_conns++;
+
+        conn_update(conn);
+    }
+}
+
+static void conn_event(srv_conn_t * conn, int events) {
+    if (events & SRV_EV_READ) {
+        /* Size the buffer for a known Content-Length in one step */
+        const http_request_t * req = &conn->req;
+        int need = SRV_IN_INITIAL;
+        if (req->head_len > 0 && !req->chunked && req->head_len + req->content_length - conn->in_len > need)
+            need = req->head_len + req->content_length - conn->in_len;
+        if (!conn_reserve(conn, need) && conn->in_cap < SRV_IN_MAX && conn->in_len + 1 >= conn->in_cap) {
+            conn_close(conn); /* out of memory */
+            return;
+        }
+
+        int room = conn->in_cap - 1 - conn->in_len;
+        ssize_t n = room > 0 ? recv(conn->fd, conn->in + conn->in_len, room, 0) : 0;
+        if (n > 0) {
+            conn->in_len += (int)n;
+            conn->last_active_ms = srv_now_ms();
+        } else if (n == 0 && room > 0) {
+            conn->peer_closed = true; /* still answer what was already received */
+        } else if (n < 0 && !sock_would_block()) {
+            conn_close(conn);
+            return;
+        }
+        if (!conn_process(conn))
+            return;
+    }
+    conn_update(conn);
+}
+
+/* Take back connections whose inference response is complete */
+static void srv_reclaim(void) {
+    srv_wake_drain();
+
+    srv_mutex_lock(&g_q.mu);
+    srv_conn_t * list = g_q.done;
+    g_q.done = NULL;
+    srv_mutex_unlock(&g_q.mu);
+
+    while (list) {
+        srv_conn_t * conn = list;
+        list = conn->next_job;
+        conn->next_job = NULL;
+
+        conn->blocking = false;
+        sock_set_blocking(conn->fd, false);
+        conn->inferring = false;
+        g_n_inference--;
+        if (!conn->peer_gone) {
+            double took = srv_now_ms() - conn->handoff_ms;
+            g_service_ms = g_service_ms > 0.0 ? 0.8 * g_service_ms + 0.2 * took : took;
+        }
+        conn_consume(conn);
+        if (conn->send_failed || !conn->keep_alive) {
+            conn_close(conn);
+            continue;
+        }
+        conn->last_active_ms = srv_now_ms();
+        if (conn_process(conn)) /* pipelined requests queued behind it */
+            conn_update(conn);
+    }
+}
+
+static void srv_close_idle(double now) {
+    srv_conn_t * conn = g_conns;
+    while (conn) {
+        srv_conn_t * next = conn->next;
+        if (!conn->blocking && now - conn->last_active_ms > SRV_IDLE_TIMEOUT_MS)
+            conn_close(conn);
+        conn = next;
+    }
+}
+
+static void srv_loop(socket_t server_fd) {
+    srv_event_t events[SRV_MAX_EVENTS];
+    double last_sweep = srv_now_ms();
+
+    while (g_running) {
+        int n = poller_wait(events, SRV_MAX_EVENTS, 1000);
+        for (int i = 0; i < n; i++) {
+            if (events[i].tag == &g_listen_tag)
+                srv_accept(server_fd);
+            else if (events[i].tag == &g_wake_tag)
+                srv_reclaim();
+            else
+                conn_event((srv_conn_t *)events[i].tag, events[i].events);
+        }
+
+        double now = srv_now_ms();
+        if (now - last_sweep >= 1000.0) {
+            srv_close_idle(now);
+            last_sweep = now;
+        }
+    }
 }
 
 /* ---- Main Server Loop ---- */
 
+void neuronos_server_stop(void) {
+    g_running = 0;
+    if (g_wake_wr != INVALID_SOCK)
+        srv_wake();
+}
+
 neuronos_status_t neuronos_server_start(neuronos_model_t * model, neuronos_tool_registry_t * tools,
                                         neuronos_server_params_t params) {
+    g_running = 1;
     g_model = model;
     g_tools = tools;
     g_agent = params.agent; /* May be NULL (raw inference only) */
+    g_n_slots = params.n_slots > 0 ? params.n_slots : SRV_DEFAULT_SLOTS;
+    g_cache_mb = params.cache_mb;
+    srv_assets_init();
+    int max_queue = params.max_queue == 0 ? SRV_QUEUE_PER_SLOT * g_n_slots : params.max_queue;
+    g_max_pending = max_queue < 0 ? 0 : g_n_slots + max_queue;
+    g_max_per_client = params.max_per_client > 0 ? params.max_per_client : 0;
 
     if (!params.host)
         params.host = "127.0.0.1";
@@ -1053,11 +2475,45 @@ neuronos_status_t neuronos_server_start(neuronos_model_t * model, neuronos_tool_
         return NEURONOS_ERROR_INIT;
     }
 
-    if (listen(server_fd, 16) < 0) {
+    if (listen(server_fd, SOMAXCONN) < 0) {
         fprintf(stderr, "Error: Cannot listen\n");
         close_socket(server_fd);
         return NEURONOS_ERROR_INIT;
     }
+    sock_set_blocking(server_fd, false);
+
+    if (!poller_init() || !srv_wake_init()) {
+        fprintf(stderr, "Error: Cannot create event loop\n");
+        poller_close();
+        close_socket(server_fd);
+        return NEURONOS_ERROR_INIT;
+    }
+    poller_ctl(server_fd, &g_listen_tag, -1, SRV_EV_READ);
+    poller_ctl(g_wake_rd, &g_wake_tag, -1, SRV_EV_READ);
+
+    srv_mutex_init(&g_q.mu);
+    srv_cond_init(&g_q.cv);
+    g_q.jobs = g_q.jobs_tail = g_q.done = NULL;
+    g_q.stop = false;
+
+    /* Agent mode: restore (or prefill and snapshot) the system prompt KV state */
+    if (g_agent)
+        neuronos_agent_warm_cache(g_agent, NULL);
+
+    srv_thread_t worker;
+#ifdef _WIN32
+    worker = CreateThread(NULL, 0, srv_worker_thread, NULL, 0, NULL);
+    bool worker_ok = worker != NULL;
+#else
+    bool worker_ok = pthread_create(&worker, NULL, srv_worker_thread, NULL) == 0;
+#endif
+    if (!worker_ok) {
+        fprintf(stderr, "Error: Cannot start inference thread\n");
+        srv_wake_close();
+        poller_close();
+        close_socket(server_fd);
+        return NEURONOS_ERROR_INIT;
+    }
 
     fprintf(stderr,
             "\n╔══════════════════════════════════════════╗\n"
@@ -1070,54 +2526,28 @@ neuronos_status_t neuronos_server_start(neuronos_model_t * model, neuronos_tool_
             g_agent ? "Agent chat UI ready                     "
                     : "OpenAI-compatible API ready             ");
 
-    while (g_running) {
-        struct sockaddr_in client_addr;
-        socklen_t client_len = sizeof(client_addr);
-        socket_t client_fd = accept(server_fd, (struct sockaddr *)&client_addr, &client_len);
-        if (client_fd == INVALID_SOCK) {
-            if (g_running)
-                fprintf(stderr, "Warning: accept() failed\n");
-            continue;
-        }
+    srv_loop(server_fd);
 
-        /* Read request */
-        char raw[MAX_REQUEST] = {0};
-        int total_read = 0;
-        int n = (int)recv(client_fd, raw, sizeof(raw) - 1, 0);
-        if (n > 0)
-            total_read = n;
-
-        /* If we have Content-Length, read the rest of body if needed */
-        if (total_read > 0) {
-            http_request_t req;
-            if (parse_request(raw, total_read, &req) == 0) {
-                /* Route request */
-                if (strcmp(req.method, "OPTIONS") == 0) {
-                    /* CORS preflight */
-                    send_response(client_fd, 204, "No Content", "text/plain", "", 0);
-                } else if (strcmp(req.path, "/health") == 0) {
-                    handle_health(client_fd);
-                } else if (strcmp(req.path, "/v1/models") == 0) {
-                    handle_models(client_fd);
-                } else if (strcmp(req.path, "/v1/completions") == 0 && strcmp(req.method, "POST") == 0) {
-                    handle_completions(client_fd, req.body);
-                } else if (strcmp(req.path, "/v1/chat/completions") == 0 && strcmp(req.method, "POST") == 0) {
-                    handle_chat_completions(client_fd, req.body);
-                } else if (strcmp(req.path, "/v1/messages") == 0 && strcmp(req.method, "POST") == 0) {
-                    handle_anthropic_messages(client_fd, req.body);
-                } else if (strcmp(req.path, "/api/chat") == 0 && strcmp(req.method, "POST") == 0) {
-                    handle_agent_chat(client_fd, req.body);
-                } else if (strcmp(req.path, "/") == 0) {
-                    handle_root(client_fd, req.accept_gzip);
-                } else {
-                    send_json(client_fd, 404, "{\"error\":{\"message\":\"Not found\"}}");
-                }
-            }
-        }
+    /* Stop the inference thread (streams see g_running == 0 and end) */
+    srv_mutex_lock(&g_q.mu);
+    g_q.stop = true;
+    srv_cond_signal(&g_q.cv);
+    srv_mutex_unlock(&g_q.mu);
+#ifdef _WIN32
+    WaitForSingleObject(worker, INFINITE);
+    CloseHandle(worker);
+#else
+    pthread_join(worker, NULL);
+#endif
 
-        close_socket(client_fd);
-    }
+    while (g_conns)
+        conn_close(g_conns);
+    neuronos_scheduler_free(g_sched);
+    g_sched = NULL;
+    g_sched_failed = false;
 
+    srv_wake_close();
+    poller_close();
     close_socket(server_fd);
 
 #ifdef _WIN32
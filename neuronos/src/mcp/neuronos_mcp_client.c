@@ -8,7 +8,12 @@
  *
  * Supports:
  *   - STDIO transport (fork+exec, pipe JSON-RPC 2.0)
- *   - Auto-discovery of tools via tools/list
+ *   - Streamable HTTP transport (keep-alive pool, SSE replies,
+ *     TLS with session resumption when built with OpenSSL)
+ *   - One reader thread polling every server; concurrent
+ *     in-flight requests matched by JSON-RPC id, per-call timeouts
+ *   - Auto-discovery of tools via tools/list, servers started in
+ *     parallel, results cached on disk per server version
  *   - Bridge function to register MCP tools in tool_registry
  *   - Config loading from ~/.neuronos/mcp.json
  *
@@ -47,20 +52,44 @@ int neuronos_mcp_client_add_server(neuronos_mcp_client_t * client,
     (void)client; (void)config; return -1;
 }
 int neuronos_mcp_client_connect(neuronos_mcp_client_t * client) { (void)client; return -1; }
+int neuronos_mcp_client_connect_async(neuronos_mcp_client_t * client) { (void)client; return -1; }
+int neuronos_mcp_client_wait(neuronos_mcp_client_t * client, int timeout_ms) { (void)client; (void)timeout_ms; return 0; }
+void neuronos_mcp_client_set_cache_dir(neuronos_mcp_client_t * client, const char * dir) { (void)client; (void)dir; }
 int neuronos_mcp_client_tool_count(const neuronos_mcp_client_t * client) { (void)client; return 0; }
 int neuronos_mcp_client_register_tools(neuronos_mcp_client_t * client,
                                        neuronos_tool_registry_t * registry) { (void)client; (void)registry; return 0; }
 char * neuronos_mcp_client_call_tool(neuronos_mcp_client_t * client,
                                      const char * tool_name,
                                      const char * args_json) { (void)client; (void)tool_name; (void)args_json; return NULL; }
+char * neuronos_mcp_client_call_tool_timeout(neuronos_mcp_client_t * client,
+                                             const char * tool_name,
+                                             const char * args_json,
+                                             int timeout_ms) { (void)client; (void)tool_name; (void)args_json; (void)timeout_ms; return NULL; }
 int neuronos_mcp_client_load_config(neuronos_mcp_client_t * client,
                                     const char * config_path) { (void)client; (void)config_path; return 0; }
 void neuronos_mcp_client_free(neuronos_mcp_client_t * client) { free(client); }
 
 #else /* Unix implementation */
     #include <fcntl.h>
+    #include <netdb.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <poll.h>
+    #include <pthread.h>
+    #include <strings.h>
+    #include <sys/socket.h>
+    #include <sys/stat.h>
     #include <sys/wait.h>
+    #include <time.h>
     #include <unistd.h>
+    #ifdef NEURONOS_HAS_OPENSSL
+        #include <openssl/ssl.h>
+    #endif
+    #ifdef MSG_NOSIGNAL
+        #define MCP_SEND_FLAGS MSG_NOSIGNAL
+    #else
+        #define MCP_SEND_FLAGS 0
+    #endif
 #endif
 
 #ifndef _WIN32 /* Rest of the file is Unix-only */
@@ -71,13 +100,17 @@ void neuronos_mcp_client_free(neuronos_mcp_client_t * client) { free(client); }
 
 #define MCP_CLIENT_VERSION       "0.1.0"
 #define MCP_PROTOCOL_VERSION     "2025-11-25"
-#define MCP_MAX_LINE             131072 /* 128 KB max JSON-RPC line  */
 #define MCP_MAX_SERVERS          16     /* Max simultaneous servers  */
 #define MCP_MAX_TOOLS            256    /* Max tools across servers  */
 #define MCP_MAX_TOOL_NAME        128
 #define MCP_MAX_TOOL_DESC        1024
 #define MCP_MAX_TOOL_SCHEMA      8192
-#define MCP_READ_TIMEOUT_MS      30000  /* 30s timeout for responses */
+#define MCP_DEFAULT_TIMEOUT_MS   30000  /* per-call timeout unless configured */
+#define MCP_MAX_MESSAGE          (16 * 1024 * 1024) /* longer lines are dropped */
+#define MCP_READ_CHUNK           65536  /* reactor read size */
+#define MCP_HTTP_POOL            4      /* idle keep-alive connections per server */
+#define MCP_HTTP_RETRIES         3      /* connection attempts per HTTP request */
+#define MCP_HTTP_BACKOFF_MS      100    /* first retry delay, doubled each time */
 
 /* JSON helpers provided by neuronos/neuronos_json.h (nj_*) */
 
@@ -91,9 +124,21 @@ typedef struct {
     char description[MCP_MAX_TOOL_DESC];
     char schema[MCP_MAX_TOOL_SCHEMA]; /* JSON Schema for input */
     int server_index;                 /* which server owns this tool */
+    bool registered;                  /* handed to a tool registry   */
 } mcp_tool_entry_t;
 
-/* A connected MCP server process */
+/* One HTTP(S) connection to a Streamable HTTP server */
+typedef struct {
+    int fd;
+#ifdef NEURONOS_HAS_OPENSSL
+    SSL * ssl;                          /* NULL for http:// */
+#endif
+    char buf[16384];                    /* buffered reads */
+    size_t pos;
+    size_t len;
+} mcp_http_conn_t;
+
+/* A connected MCP server (child process or HTTP endpoint) */
 typedef struct {
     char name[128];                     /* human-readable name               */
     neuronos_mcp_transport_t transport; /* STDIO or HTTP                     */
@@ -102,7 +147,35 @@ typedef struct {
     int fd_read;                        /* pipe: child stdout → parent reads */
     int next_id;                        /* JSON-RPC request ID counter       */
     bool connected;                     /* successfully initialized?         */
-    char * read_buf;                    /* line buffer for reading           */
+    bool starting;                      /* start-up thread still running     */
+    bool has_starter;                   /* starter must be joined            */
+    pthread_t starter;
+    int timeout_ms;                     /* default per-call timeout          */
+    char version[64];                   /* serverInfo.version                */
+    char cached_version[64];            /* version in the discovery cache    */
+    int n_cached;                       /* tools loaded from the cache       */
+    char protocol[32];                  /* negotiated protocol version       */
+    /* HTTP transport */
+    char * url;
+    char * path;                        /* request target, e.g. "/mcp"       */
+    char host[256];
+    char port[8];
+    bool tls;                           /* https://                          */
+    char session_id[160];               /* Mcp-Session-Id from initialize    */
+    char ** headers;                    /* extra "Name: value" headers       */
+    int n_headers;
+    mcp_http_conn_t * idle[MCP_HTTP_POOL]; /* keep-alive pool (client->lock) */
+    int n_idle;
+#ifdef NEURONOS_HAS_OPENSSL
+    SSL_SESSION * tls_session;          /* resumed on reconnect (client->lock) */
+#endif
+    pthread_mutex_t write_lock;         /* one request written at a time     */
+    /* Reactor state (client->lock) */
+    char * in_buf;                      /* partial line read so far          */
+    size_t in_len;
+    size_t in_cap;
+    bool in_skip;                       /* dropping an oversized line        */
+    bool detach;                        /* reactor must close fd_read        */
     /* Config storage (owned copies) */
     char * command;
     char ** args;
@@ -111,151 +184,974 @@ typedef struct {
     int n_env;
 } mcp_server_conn_t;
 
-/* The MCP client */
+/* A request waiting for its response (on the caller's stack) */
+typedef struct mcp_pending {
+    int server;                         /* index into client->servers */
+    int id;                             /* JSON-RPC id                */
+    char * response;                    /* response line (reactor)    */
+    bool done;                          /* answered, or server gone   */
+    struct mcp_pending * next;
+} mcp_pending_t;
+
+/* The MCP client.
+ * One reactor thread polls every server's stdout, splits lines and
+ * hands each response to the caller waiting for its id, so callers on
+ * any thread can have requests in flight on the same server.
+ * tools[] only grows; entries are immutable once n_tools covers them. */
 struct neuronos_mcp_client {
     mcp_server_conn_t servers[MCP_MAX_SERVERS];
     int n_servers;
     mcp_tool_entry_t tools[MCP_MAX_TOOLS];
     int n_tools;
+
+    pthread_mutex_t lock;               /* pending, next_id, fd_read, reactor state */
+    pthread_cond_t cond;                /* a response arrived / a server detached */
+    mcp_pending_t * pending;
+    pthread_t reactor;
+    bool reactor_running;
+    bool stopping;                      /* reactor: exit                   */
+    bool closing;                       /* callers and starters: give up  */
+    int wake[2];                        /* self-pipe: rebuild the poll set */
+    char cache_dir[512];                /* discovery cache ("" = off)      */
+#ifdef NEURONOS_HAS_OPENSSL
+    SSL_CTX * tls_ctx;                  /* shared by https:// servers      */
+#endif
 };
 
 /* ============================================================
  * STDIO TRANSPORT: fork + exec + pipe
  * ============================================================ */
 
-/* Send a JSON-RPC request to a server. Returns the request ID. */
+static int mcp_write_all(int fd, const char * buf, size_t len) {
+    while (len > 0) {
+        ssize_t w = write(fd, buf, len);
+        if (w < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        buf += w;
+        len -= (size_t)w;
+    }
+    return 0;
+}
+
+/* Send one newline-terminated JSON-RPC message to a server */
 static int mcp_client_send(mcp_server_conn_t * srv, const char * json) {
     if (!srv || srv->fd_write < 0 || !json)
         return -1;
 
-    size_t len = strlen(json);
-    const char newline = '\n';
+    pthread_mutex_lock(&srv->write_lock);
+    int rc = mcp_write_all(srv->fd_write, json, strlen(json));
+    if (rc == 0)
+        rc = mcp_write_all(srv->fd_write, "\n", 1);
+    pthread_mutex_unlock(&srv->write_lock);
 
-    ssize_t w = write(srv->fd_write, json, len);
-    if (w < 0) {
+    if (rc < 0)
         fprintf(stderr, "[mcp-client] Write error to '%s': %s\n", srv->name, strerror(errno));
+    return rc;
+}
+
+static void mcp_reactor_wake(neuronos_mcp_client_t * client) {
+    if (client->wake[1] >= 0) {
+        char c = 1;
+        ssize_t w = write(client->wake[1], &c, 1);
+        (void)w;
+    }
+}
+
+/* Fail every request still waiting on server s (client->lock held) */
+static void mcp_fail_pending(neuronos_mcp_client_t * client, int s) {
+    for (mcp_pending_t * p = client->pending; p; p = p->next) {
+        if (p->server == s)
+            p->done = true;
+    }
+    pthread_cond_broadcast(&client->cond);
+}
+
+/* Close a server's read side from the reactor (client->lock held) */
+static void mcp_reactor_close(neuronos_mcp_client_t * client, int s) {
+    mcp_server_conn_t * srv = &client->servers[s];
+    if (srv->fd_read >= 0) {
+        close(srv->fd_read);
+        srv->fd_read = -1;
+    }
+    srv->connected = false;
+    srv->detach = false;
+    srv->in_len = 0;
+    mcp_fail_pending(client, s);
+}
+
+/* Hand a complete line to the request waiting for its id (client->lock held).
+ * Notifications and server-to-client requests carry a method: skipped. */
+static void mcp_reactor_dispatch(neuronos_mcp_client_t * client, int s, const char * line) {
+    if (nj_find_str(line, "method", NULL))
+        return;
+    int id = nj_find_int(line, "id", -1);
+    for (mcp_pending_t * p = client->pending; p; p = p->next) {
+        if (p->server == s && p->id == id && !p->done) {
+            p->response = strdup(line);
+            p->done = true;
+            pthread_cond_broadcast(&client->cond);
+            return;
+        }
+    }
+    /* No waiter: a response to a request that already timed out */
+}
+
+/* Split what was read from server s into lines (client->lock held) */
+static void mcp_reactor_feed(neuronos_mcp_client_t * client, int s, const char * data, size_t n) {
+    mcp_server_conn_t * srv = &client->servers[s];
+    while (n > 0) {
+        const char * nl = memchr(data, '\n', n);
+        size_t take = nl ? (size_t)(nl - data) : n;
+
+        if (!srv->in_skip && srv->in_len + take > MCP_MAX_MESSAGE) {
+            fprintf(stderr, "[mcp-client] Dropping message over %d bytes from '%s'\n", MCP_MAX_MESSAGE,
+                    srv->name);
+            srv->in_skip = true;
+            srv->in_len = 0;
+        }
+        if (!srv->in_skip && take > 0) {
+            if (srv->in_len + take + 1 > srv->in_cap) {
+                size_t cap = srv->in_cap ? srv->in_cap : 4096;
+                while (cap < srv->in_len + take + 1)
+                    cap *= 2;
+                char * grown = realloc(srv->in_buf, cap);
+                if (!grown) {
+                    srv->in_skip = true;
+                    srv->in_len = 0;
+                } else {
+                    srv->in_buf = grown;
+                    srv->in_cap = cap;
+                }
+            }
+            if (!srv->in_skip) {
+                memcpy(srv->in_buf + srv->in_len, data, take);
+                srv->in_len += take;
+            }
+        }
+
+        if (!nl)
+            break;
+        if (!srv->in_skip && srv->in_len > 0) {
+            srv->in_buf[srv->in_len] = '\0';
+            mcp_reactor_dispatch(client, s, srv->in_buf);
+        }
+        srv->in_len = 0;
+        srv->in_skip = false;
+        data = nl + 1;
+        n -= take + 1;
+    }
+}
+
+/* Reactor: one poll() over the self-pipe and every server's stdout */
+static void * mcp_reactor_main(void * arg) {
+    neuronos_mcp_client_t * client = arg;
+    struct pollfd fds[MCP_MAX_SERVERS + 1];
+    int owner[MCP_MAX_SERVERS + 1];
+    char * chunk = malloc(MCP_READ_CHUNK);
+    if (!chunk)
+        return NULL;
+
+    for (;;) {
+        pthread_mutex_lock(&client->lock);
+        if (client->stopping) {
+            pthread_mutex_unlock(&client->lock);
+            break;
+        }
+        int n = 0;
+        fds[n].fd = client->wake[0];
+        fds[n].events = POLLIN;
+        owner[n++] = -1;
+        for (int i = 0; i < client->n_servers; i++) {
+            mcp_server_conn_t * srv = &client->servers[i];
+            if (srv->detach)
+                mcp_reactor_close(client, i);
+            if (srv->fd_read < 0)
+                continue;
+            fds[n].fd = srv->fd_read;
+            fds[n].events = POLLIN;
+            owner[n++] = i;
+        }
+        pthread_mutex_unlock(&client->lock);
+
+        if (poll(fds, (nfds_t)n, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            fprintf(stderr, "[mcp-client] poll() failed: %s\n", strerror(errno));
+            break;
+        }
+
+        if (fds[0].revents) {
+            char drain[64];
+            while (read(client->wake[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+        for (int k = 1; k < n; k++) {
+            if (!(fds[k].revents & (POLLIN | POLLHUP | POLLERR)))
+                continue;
+            ssize_t r = read(fds[k].fd, chunk, MCP_READ_CHUNK);
+            if (r < 0 && (errno == EINTR || errno == EAGAIN))
+                continue;
+            pthread_mutex_lock(&client->lock);
+            if (r > 0) {
+                mcp_reactor_feed(client, owner[k], chunk, (size_t)r);
+            } else {
+                fprintf(stderr, "[mcp-client] '%s' closed its output\n", client->servers[owner[k]].name);
+                mcp_reactor_close(client, owner[k]);
+            }
+            pthread_mutex_unlock(&client->lock);
+        }
+    }
+
+    free(chunk);
+    return NULL;
+}
+
+static int mcp_reactor_start(neuronos_mcp_client_t * client) {
+    if (client->reactor_running)
+        return 0;
+    if (pipe(client->wake) < 0) {
+        client->wake[0] = client->wake[1] = -1;
+        return -1;
+    }
+    fcntl(client->wake[0], F_SETFL, O_NONBLOCK);
+    fcntl(client->wake[1], F_SETFL, O_NONBLOCK);
+    client->stopping = false;
+    client->reactor_running = pthread_create(&client->reactor, NULL, mcp_reactor_main, client) == 0;
+    return client->reactor_running ? 0 : -1;
+}
+
+static void mcp_reactor_stop(neuronos_mcp_client_t * client) {
+    if (client->reactor_running) {
+        pthread_mutex_lock(&client->lock);
+        client->stopping = true;
+        pthread_mutex_unlock(&client->lock);
+        mcp_reactor_wake(client);
+        pthread_join(client->reactor, NULL);
+        client->reactor_running = false;
+    }
+    for (int i = 0; i < 2; i++) {
+        if (client->wake[i] >= 0)
+            close(client->wake[i]);
+        client->wake[i] = -1;
+    }
+}
+
+/* Absolute CLOCK_REALTIME time timeout_ms from now, for cond_timedwait */
+static void mcp_deadline(struct timespec * ts, int timeout_ms) {
+    clock_gettime(CLOCK_REALTIME, ts);
+    ts->tv_sec += timeout_ms / 1000;
+    ts->tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+/* Milliseconds left until deadline (0 once passed) */
+static int mcp_remaining_ms(const struct timespec * deadline) {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    long long ms = (long long)(deadline->tv_sec - now.tv_sec) * 1000 + (deadline->tv_nsec - now.tv_nsec) / 1000000;
+    return ms > 0 ? (ms > INT32_MAX ? INT32_MAX : (int)ms) : 0;
+}
+
+/* ============================================================
+ * STREAMABLE HTTP TRANSPORT
+ *
+ * Each request is a POST of one JSON-RPC message. The reply is either
+ * application/json or a text/event-stream whose events are scanned as
+ * they arrive until the response with our id shows up. Requests run on
+ * the caller's thread over a keep-alive connection taken from the
+ * server's pool, so concurrent calls use separate connections and
+ * finished ones are reused. https:// needs OpenSSL (NEURONOS_MCP_TLS);
+ * TLS sessions are resumed when a connection is re-established.
+ * ============================================================ */
+
+/* Parse http[s]://host[:port][/path] into srv */
+static int mcp_url_parse(mcp_server_conn_t * srv, const char * url) {
+    const char * p;
+    if (strncmp(url, "https://", 8) == 0) {
+        srv->tls = true;
+        p = url + 8;
+    } else if (strncmp(url, "http://", 7) == 0) {
+        srv->tls = false;
+        p = url + 7;
+    } else {
         return -1;
     }
-    write(srv->fd_write, &newline, 1);
+
+    const char * host = p;
+    const char * host_end;
+    if (*p == '[') { /* [IPv6] */
+        host = ++p;
+        while (*p && *p != ']')
+            p++;
+        if (*p != ']')
+            return -1;
+        host_end = p++;
+    } else {
+        while (*p && *p != ':' && *p != '/' && *p != '?')
+            p++;
+        host_end = p;
+    }
+    if (host_end == host || (size_t)(host_end - host) >= sizeof(srv->host))
+        return -1;
+    memcpy(srv->host, host, (size_t)(host_end - host));
+    srv->host[host_end - host] = '\0';
+
+    if (*p == ':') {
+        const char * port = ++p;
+        while (*p >= '0' && *p <= '9')
+            p++;
+        if (p == port || (size_t)(p - port) >= sizeof(srv->port))
+            return -1;
+        memcpy(srv->port, port, (size_t)(p - port));
+        srv->port[p - port] = '\0';
+    } else {
+        snprintf(srv->port, sizeof(srv->port), "%s", srv->tls ? "443" : "80");
+    }
+
+    if (*p && *p != '/' && *p != '?')
+        return -1;
+    if (*p == '?') {
+        size_t n = strlen(p);
+        srv->path = malloc(n + 2);
+        if (srv->path) {
+            srv->path[0] = '/';
+            memcpy(srv->path + 1, p, n + 1);
+        }
+    } else {
+        srv->path = strdup(*p ? p : "/");
+    }
+    return srv->path ? 0 : -1;
+}
+
+static void mcp_http_close(mcp_http_conn_t * c) {
+    if (!c)
+        return;
+#ifdef NEURONOS_HAS_OPENSSL
+    if (c->ssl) {
+        SSL_shutdown(c->ssl);
+        SSL_free(c->ssl);
+    }
+#endif
+    if (c->fd >= 0)
+        close(c->fd);
+    free(c);
+}
+
+/* Wait for the socket to become readable/writable. 0 = ready, -1 = timeout/error. */
+static int mcp_http_wait(int fd, short events, const struct timespec * deadline) {
+    for (;;) {
+        struct pollfd pfd = {.fd = fd, .events = events};
+        int rc = poll(&pfd, 1, mcp_remaining_ms(deadline));
+        if (rc > 0)
+            return 0;
+        if (rc < 0 && errno == EINTR)
+            continue;
+        return -1;
+    }
+}
+
+#ifdef NEURONOS_HAS_OPENSSL
+/* Retry an SSL call that asked for more I/O. Returns false when it failed for good. */
+static bool mcp_tls_retry(mcp_http_conn_t * c, int rc, const struct timespec * deadline) {
+    switch (SSL_get_error(c->ssl, rc)) {
+    case SSL_ERROR_WANT_READ:
+        return mcp_http_wait(c->fd, POLLIN, deadline) == 0;
+    case SSL_ERROR_WANT_WRITE:
+        return mcp_http_wait(c->fd, POLLOUT, deadline) == 0;
+    default:
+        return false;
+    }
+}
+#endif
+
+static int mcp_http_write(mcp_http_conn_t * c, const char * data, size_t len, const struct timespec * deadline) {
+    while (len > 0) {
+        ssize_t w;
+#ifdef NEURONOS_HAS_OPENSSL
+        if (c->ssl) {
+            int rc = SSL_write(c->ssl, data, len > INT32_MAX ? INT32_MAX : (int)len);
+            if (rc <= 0) {
+                if (!mcp_tls_retry(c, rc, deadline))
+                    return -1;
+                continue;
+            }
+            w = rc;
+        } else
+#endif
+        {
+            w = send(c->fd, data, len, MCP_SEND_FLAGS);
+            if (w < 0) {
+                if (errno == EINTR)
+                    continue;
+                if ((errno == EAGAIN || errno == EWOULDBLOCK) && mcp_http_wait(c->fd, POLLOUT, deadline) == 0)
+                    continue;
+                return -1;
+            }
+        }
+        data += w;
+        len -= (size_t)w;
+    }
     return 0;
 }
 
-/* Read a line from the server (blocking, with timeout via poll/select).
- * Returns the line (in srv->read_buf) or NULL on error/timeout. */
-static char * mcp_client_readline(mcp_server_conn_t * srv) {
-    if (!srv || srv->fd_read < 0)
+/* Refill the read buffer. Returns bytes read, 0 on EOF, -1 on error/timeout. */
+static int mcp_http_fill(mcp_http_conn_t * c, const struct timespec * deadline) {
+    if (c->pos == c->len)
+        c->pos = c->len = 0;
+    if (c->len == sizeof(c->buf)) {
+        memmove(c->buf, c->buf + c->pos, c->len - c->pos);
+        c->len -= c->pos;
+        c->pos = 0;
+    }
+    for (;;) {
+#ifdef NEURONOS_HAS_OPENSSL
+        if (c->ssl) {
+            int rc = SSL_read(c->ssl, c->buf + c->len, (int)(sizeof(c->buf) - c->len));
+            if (rc > 0) {
+                c->len += (size_t)rc;
+                return rc;
+            }
+            if (SSL_get_error(c->ssl, rc) == SSL_ERROR_ZERO_RETURN)
+                return 0;
+            if (!mcp_tls_retry(c, rc, deadline))
+                return -1;
+            continue;
+        }
+#endif
+        ssize_t r = recv(c->fd, c->buf + c->len, sizeof(c->buf) - c->len, 0);
+        if (r >= 0) {
+            c->len += (size_t)r;
+            return (int)r;
+        }
+        if (errno == EINTR)
+            continue;
+        if ((errno == EAGAIN || errno == EWOULDBLOCK) && mcp_http_wait(c->fd, POLLIN, deadline) == 0)
+            continue;
+        return -1;
+    }
+}
+
+/* Read one CRLF/LF-terminated header or chunk-size line (terminator stripped) */
+static int mcp_http_getline(mcp_http_conn_t * c, char * line, size_t cap, const struct timespec * deadline) {
+    size_t n = 0;
+    for (;;) {
+        while (c->pos < c->len) {
+            char ch = c->buf[c->pos++];
+            if (ch == '\n') {
+                if (n > 0 && line[n - 1] == '\r')
+                    n--;
+                line[n] = '\0';
+                return (int)n;
+            }
+            if (n + 1 < cap)
+                line[n++] = ch;
+        }
+        if (mcp_http_fill(c, deadline) <= 0)
+            return -1;
+    }
+}
+
+/* Connect to srv (TCP, then TLS for https://) before the deadline */
+static mcp_http_conn_t * mcp_http_dial(neuronos_mcp_client_t * client, mcp_server_conn_t * srv,
+                                       const struct timespec * deadline) {
+    struct addrinfo hints = {.ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM};
+    struct addrinfo * res = NULL;
+    int gai = getaddrinfo(srv->host, srv->port, &hints, &res);
+    if (gai != 0) {
+        fprintf(stderr, "[mcp-client] '%s': cannot resolve %s: %s\n", srv->name, srv->host, gai_strerror(gai));
         return NULL;
+    }
 
-    if (!srv->read_buf) {
-        srv->read_buf = malloc(MCP_MAX_LINE);
-        if (!srv->read_buf)
-            return NULL;
+    int fd = -1;
+    for (struct addrinfo * ai = res; ai && fd < 0; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0)
+            continue;
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) < 0) {
+            int err = 0;
+            socklen_t elen = sizeof(err);
+            if (errno != EINPROGRESS || mcp_http_wait(fd, POLLOUT, deadline) < 0 ||
+                getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &elen) < 0 || err != 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
     }
+    freeaddrinfo(res);
+    if (fd < 0)
+        return NULL;
 
-    /* Use select() for timeout */
-    fd_set fds;
-    struct timeval tv;
-    FD_ZERO(&fds);
-    FD_SET(srv->fd_read, &fds);
-    tv.tv_sec = MCP_READ_TIMEOUT_MS / 1000;
-    tv.tv_usec = (MCP_READ_TIMEOUT_MS % 1000) * 1000;
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#ifdef SO_NOSIGPIPE
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
 
-    int ret = select(srv->fd_read + 1, &fds, NULL, NULL, &tv);
-    if (ret <= 0) {
-        if (ret == 0)
-            fprintf(stderr, "[mcp-client] Timeout reading from '%s'\n", srv->name);
-        else
-            fprintf(stderr, "[mcp-client] Select error on '%s': %s\n", srv->name, strerror(errno));
+    mcp_http_conn_t * c = calloc(1, sizeof(*c));
+    if (!c) {
+        close(fd);
         return NULL;
     }
+    c->fd = fd;
 
-    /* Read byte-by-byte until newline (JSON-RPC newline-delimited) */
-    size_t pos = 0;
-    while (pos < MCP_MAX_LINE - 1) {
-        ssize_t r = read(srv->fd_read, srv->read_buf + pos, 1);
-        if (r <= 0)
-            break;
-        if (srv->read_buf[pos] == '\n') {
-            srv->read_buf[pos] = '\0';
-            return srv->read_buf;
+    if (srv->tls) {
+#ifdef NEURONOS_HAS_OPENSSL
+        c->ssl = client->tls_ctx ? SSL_new(client->tls_ctx) : NULL;
+        if (!c->ssl || SSL_set_fd(c->ssl, fd) != 1) {
+            mcp_http_close(c);
+            return NULL;
+        }
+        SSL_set_tlsext_host_name(c->ssl, srv->host);
+        SSL_set1_host(c->ssl, srv->host);
+        pthread_mutex_lock(&client->lock);
+        if (srv->tls_session)
+            SSL_set_session(c->ssl, srv->tls_session);
+        pthread_mutex_unlock(&client->lock);
+        int rc;
+        while ((rc = SSL_connect(c->ssl)) != 1) {
+            if (!mcp_tls_retry(c, rc, deadline)) {
+                fprintf(stderr, "[mcp-client] '%s': TLS handshake with %s failed\n", srv->name, srv->host);
+                mcp_http_close(c);
+                return NULL;
+            }
         }
-        pos++;
+#else
+        (void)client;
+        mcp_http_close(c);
+        return NULL;
+#endif
     }
+    return c;
+}
 
-    if (pos > 0) {
-        srv->read_buf[pos] = '\0';
-        return srv->read_buf;
+/* Take an idle keep-alive connection, dropping any the server closed */
+static mcp_http_conn_t * mcp_http_pool_get(neuronos_mcp_client_t * client, mcp_server_conn_t * srv) {
+    for (;;) {
+        pthread_mutex_lock(&client->lock);
+        mcp_http_conn_t * c = srv->n_idle > 0 ? srv->idle[--srv->n_idle] : NULL;
+        pthread_mutex_unlock(&client->lock);
+        if (!c)
+            return NULL;
+        /* An idle connection has nothing to say: readable means EOF */
+        struct pollfd pfd = {.fd = c->fd, .events = POLLIN};
+        if (poll(&pfd, 1, 0) == 0)
+            return c;
+        mcp_http_close(c);
     }
+}
 
-    return NULL;
+static void mcp_http_pool_put(neuronos_mcp_client_t * client, mcp_server_conn_t * srv, mcp_http_conn_t * c) {
+#ifdef NEURONOS_HAS_OPENSSL
+    SSL_SESSION * sess = c->ssl ? SSL_get1_session(c->ssl) : NULL;
+#endif
+    pthread_mutex_lock(&client->lock);
+#ifdef NEURONOS_HAS_OPENSSL
+    if (sess) {
+        if (srv->tls_session)
+            SSL_SESSION_free(srv->tls_session);
+        srv->tls_session = sess;
+    }
+#endif
+    if (srv->n_idle < MCP_HTTP_POOL && !client->closing) {
+        srv->idle[srv->n_idle++] = c;
+        c = NULL;
+    }
+    pthread_mutex_unlock(&client->lock);
+    mcp_http_close(c);
+}
+
+/* Response body reader: Content-Length, chunked, or until close */
+typedef struct {
+    mcp_http_conn_t * c;
+    bool chunked;
+    long long left; /* bytes left in body or chunk; -1 = until EOF */
+    bool done;
+} mcp_http_body_t;
+
+/* Read up to n body bytes. Returns count, 0 at end of body, -1 on error. */
+static int mcp_http_body_read(mcp_http_body_t * b, char * out, size_t n, const struct timespec * deadline) {
+    mcp_http_conn_t * c = b->c;
+    while (!b->done) {
+        if (b->chunked && b->left == 0) {
+            char line[64];
+            if (mcp_http_getline(c, line, sizeof(line), deadline) < 0)
+                return -1;
+            if (!line[0]) /* CRLF after the previous chunk */
+                continue;
+            b->left = strtoll(line, NULL, 16);
+            if (b->left == 0) { /* last chunk: skip trailers */
+                while (mcp_http_getline(c, line, sizeof(line), deadline) > 0) {
+                }
+                b->done = true;
+                return 0;
+            }
+        }
+        if (!b->chunked && b->left == 0) {
+            b->done = true;
+            return 0;
+        }
+        if (c->pos == c->len) {
+            int r = mcp_http_fill(c, deadline);
+            if (r < 0)
+                return -1;
+            if (r == 0) {
+                if (b->left >= 0 || b->chunked)
+                    return -1; /* truncated */
+                b->done = true;
+                return 0;
+            }
+        }
+        size_t avail = c->len - c->pos;
+        if (b->left >= 0 && (long long)avail > b->left)
+            avail = (size_t)b->left;
+        if (avail > n)
+            avail = n;
+        memcpy(out, c->buf + c->pos, avail);
+        c->pos += avail;
+        if (b->left >= 0)
+            b->left -= (long long)avail;
+        return (int)avail;
+    }
+    return 0;
+}
+
+/* Does this message answer request want_id? */
+static bool mcp_is_response(const char * json, int want_id) {
+    return !nj_find_str(json, "method", NULL) && nj_find_int(json, "id", -1) == want_id;
+}
+
+/* Scan an event stream for the response to want_id. Returns it (malloc'd) or NULL. */
+static char * mcp_sse_scan(mcp_http_body_t * b, int want_id, const struct timespec * deadline) {
+    char chunk[4096];
+    char * line = NULL, * data = NULL;
+    size_t line_len = 0, line_cap = 0, data_len = 0, data_cap = 0;
+    char * found = NULL;
+    bool ok = true;
+
+    while (ok && !found) {
+        int r = mcp_http_body_read(b, chunk, sizeof(chunk), deadline);
+        if (r <= 0)
+            break;
+        for (int i = 0; i < r && ok && !found; i++) {
+            if (chunk[i] != '\n') {
+                if (line_len + 2 > line_cap) {
+                    size_t cap = line_cap ? line_cap * 2 : 256;
+                    char * grown = line_len < MCP_MAX_MESSAGE ? realloc(line, cap) : NULL;
+                    if (!grown) {
+                        ok = false;
+                        break;
+                    }
+                    line = grown;
+                    line_cap = cap;
+                }
+                line[line_len++] = chunk[i];
+                continue;
+            }
+            if (line_len > 0 && line[line_len - 1] == '\r')
+                line_len--;
+
+            if (line_len == 0) { /* blank line: dispatch the event */
+                if (data_len > 0) {
+                    data[data_len] = '\0';
+                    if (mcp_is_response(data, want_id)) {
+                        found = data;
+                        data = NULL;
+                        data_cap = 0;
+                    }
+                }
+                data_len = 0;
+            } else if (line_len >= 5 && memcmp(line, "data:", 5) == 0) {
+                size_t off = line_len > 5 && line[5] == ' ' ? 6 : 5;
+                size_t add = line_len - off + (data_len ? 1 : 0);
+                if (data_len + add + 1 > data_cap) {
+                    size_t cap = data_cap ? data_cap : 1024;
+                    while (cap < data_len + add + 1)
+                        cap *= 2;
+                    char * grown = cap <= MCP_MAX_MESSAGE ? realloc(data, cap) : NULL;
+                    if (!grown) {
+                        ok = false;
+                        break;
+                    }
+                    data = grown;
+                    data_cap = cap;
+                }
+                if (data_len)
+                    data[data_len++] = '\n';
+                memcpy(data + data_len, line + off, line_len - off);
+                data_len += line_len - off;
+            }
+            /* event:, id:, retry: and comments need no handling here */
+            line_len = 0;
+        }
+    }
+    free(line);
+    free(data);
+    return found;
 }
 
-/* Send a JSON-RPC request and wait for the response.
- * Returns the response line (in srv->read_buf). Caller must NOT free. */
-static const char * mcp_client_request(mcp_server_conn_t * srv, const char * method,
-                                       const char * params_json) {
-    if (!srv || !method)
+/* POST one JSON-RPC message. want_id >= 0: return the response to that id
+ * (caller frees); want_id < 0: notification, returns NULL. On failure
+ * *failed is set. Stale or refused connections are retried a bounded
+ * number of times with backoff. */
+static char * mcp_http_post(neuronos_mcp_client_t * client, int s, const char * json, int want_id, int timeout_ms,
+                            bool * failed) {
+    mcp_server_conn_t * srv = &client->servers[s];
+    struct timespec deadline;
+    mcp_deadline(&deadline, timeout_ms);
+    *failed = true;
+
+    /* Request head */
+    size_t json_len = strlen(json);
+    size_t head_cap = 512 + strlen(srv->path) + strlen(srv->host);
+    for (int i = 0; i < srv->n_headers; i++)
+        head_cap += strlen(srv->headers[i]) + 2;
+    char * head = malloc(head_cap);
+    if (!head)
         return NULL;
+    bool default_port = strcmp(srv->port, srv->tls ? "443" : "80") == 0;
+    bool v6 = strchr(srv->host, ':') != NULL;
+    int hl = snprintf(head, head_cap,
+                      "POST %s HTTP/1.1\r\n"
+                      "Host: %s%s%s%s%s\r\n"
+                      "Content-Type: application/json\r\n"
+                      "Accept: application/json, text/event-stream\r\n"
+                      "Content-Length: %zu\r\n",
+                      srv->path, v6 ? "[" : "", srv->host, v6 ? "]" : "", default_port ? "" : ":",
+                      default_port ? "" : srv->port, json_len);
+    if (srv->session_id[0])
+        hl += snprintf(head + hl, head_cap - (size_t)hl, "Mcp-Session-Id: %s\r\n", srv->session_id);
+    if (srv->protocol[0])
+        hl += snprintf(head + hl, head_cap - (size_t)hl, "MCP-Protocol-Version: %s\r\n", srv->protocol);
+    for (int i = 0; i < srv->n_headers; i++)
+        hl += snprintf(head + hl, head_cap - (size_t)hl, "%s\r\n", srv->headers[i]);
+    hl += snprintf(head + hl, head_cap - (size_t)hl, "\r\n");
+
+    char * result = NULL;
+    int backoff = MCP_HTTP_BACKOFF_MS;
+    for (int attempt = 0; attempt < MCP_HTTP_RETRIES; attempt++) {
+        bool reused = true;
+        mcp_http_conn_t * c = mcp_http_pool_get(client, srv);
+        if (!c) {
+            reused = false;
+            c = mcp_http_dial(client, srv, &deadline);
+        }
+        if (!c) {
+            int left = mcp_remaining_ms(&deadline);
+            if (left <= backoff)
+                break;
+            usleep((useconds_t)backoff * 1000);
+            backoff *= 2;
+            continue;
+        }
 
-    int id = srv->next_id++;
-    char buf[MCP_MAX_LINE];
+        char line[1024];
+        int status = 0;
+        if (mcp_http_write(c, head, (size_t)hl, &deadline) < 0 || mcp_http_write(c, json, json_len, &deadline) < 0 ||
+            mcp_http_getline(c, line, sizeof(line), &deadline) < 0 || sscanf(line, "HTTP/%*s %d", &status) != 1) {
+            mcp_http_close(c);
+            if (mcp_remaining_ms(&deadline) == 0)
+                break;
+            if (reused)
+                attempt--; /* the server dropped an idle connection: free retry */
+            continue;
+        }
 
-    if (params_json && params_json[0]) {
-        snprintf(buf, sizeof(buf),
-                 "{\"jsonrpc\":\"2.0\",\"id\":%d,\"method\":\"%s\",\"params\":%s}",
-                 id, method, params_json);
-    } else {
-        snprintf(buf, sizeof(buf),
-                 "{\"jsonrpc\":\"2.0\",\"id\":%d,\"method\":\"%s\",\"params\":{}}",
-                 id, method);
+        /* Headers */
+        mcp_http_body_t body = {.c = c, .left = -1};
+        bool keep_alive = true, sse = false, bad = false;
+        for (;;) {
+            int n = mcp_http_getline(c, line, sizeof(line), &deadline);
+            if (n < 0) {
+                bad = true;
+                break;
+            }
+            if (n == 0)
+                break;
+            char * colon = strchr(line, ':');
+            if (!colon)
+                continue;
+            *colon = '\0';
+            char * val = colon + 1;
+            while (*val == ' ' || *val == '\t')
+                val++;
+            if (strcasecmp(line, "Content-Length") == 0)
+                body.left = strtoll(val, NULL, 10);
+            else if (strcasecmp(line, "Transfer-Encoding") == 0 && strstr(val, "chunked"))
+                body.chunked = true;
+            else if (strcasecmp(line, "Content-Type") == 0)
+                sse = strncasecmp(val, "text/event-stream", 17) == 0;
+            else if (strcasecmp(line, "Connection") == 0 && strncasecmp(val, "close", 5) == 0)
+                keep_alive = false;
+            else if (strcasecmp(line, "Mcp-Session-Id") == 0 && !srv->session_id[0])
+                snprintf(srv->session_id, sizeof(srv->session_id), "%s", val);
+        }
+        if (body.chunked)
+            body.left = 0;
+        if (body.left < 0 && !body.chunked)
+            keep_alive = false; /* body runs until close */
+        if (status == 204 || status == 304)
+            body.done = true;
+
+        if (bad) {
+            mcp_http_close(c);
+            break;
+        }
+
+        if (status >= 200 && status < 300) {
+            *failed = false;
+            if (want_id >= 0 && sse) {
+                result = mcp_sse_scan(&body, want_id, &deadline);
+                if (!result)
+                    *failed = true;
+            } else if (want_id >= 0) {
+                size_t len = 0, cap = 4096;
+                result = malloc(cap);
+                int r;
+                while (result && (r = mcp_http_body_read(&body, result + len, cap - len - 1, &deadline)) > 0) {
+                    len += (size_t)r;
+                    if (cap - len - 1 == 0) {
+                        char * grown = cap < MCP_MAX_MESSAGE ? realloc(result, cap * 2) : NULL;
+                        if (!grown) {
+                            free(result);
+                            result = NULL;
+                            break;
+                        }
+                        result = grown;
+                        cap *= 2;
+                    }
+                }
+                if (result)
+                    result[len] = '\0';
+                if (!result || !body.done)
+                    *failed = true;
+            }
+        } else {
+            fprintf(stderr, "[mcp-client] '%s': HTTP %d\n", srv->name, status);
+            if (status == 404 && srv->session_id[0]) /* session expired on the server */
+                fprintf(stderr, "[mcp-client] '%s': session %s no longer valid\n", srv->name, srv->session_id);
+        }
+
+        /* Reuse the connection only if the body was read to the end.
+         * An event stream usually ends right after our response. */
+        if (keep_alive && !body.done) {
+            struct timespec grace;
+            mcp_deadline(&grace, 50);
+            char sink[1024];
+            while (mcp_http_body_read(&body, sink, sizeof(sink), &grace) > 0) {
+            }
+        }
+        if (keep_alive && body.done)
+            mcp_http_pool_put(client, srv, c);
+        else
+            mcp_http_close(c);
+        break;
     }
 
-    if (mcp_client_send(srv, buf) < 0)
+    free(head);
+    return result;
+}
+
+/* Send a JSON-RPC request to server s and wait up to timeout_ms for the
+ * response. Other requests may be in flight meanwhile, on any thread.
+ * Returns the response line (caller frees) or NULL on error/timeout. */
+static char * mcp_client_request(neuronos_mcp_client_t * client, int s, const char * method,
+                                 const char * params_json, int timeout_ms) {
+    if (!client || !method || s < 0 || s >= client->n_servers)
         return NULL;
+    mcp_server_conn_t * srv = &client->servers[s];
 
-    /* Read response(s) — skip notifications, look for matching id */
-    for (int attempts = 0; attempts < 20; attempts++) {
-        char * line = mcp_client_readline(srv);
-        if (!line)
+    if (srv->transport == NEURONOS_MCP_TRANSPORT_HTTP) {
+        pthread_mutex_lock(&client->lock);
+        int id = client->closing ? -1 : srv->next_id++;
+        pthread_mutex_unlock(&client->lock);
+        if (id < 0)
+            return NULL;
+        const char * params = params_json && params_json[0] ? params_json : "{}";
+        size_t len = strlen(method) + strlen(params) + 96;
+        char * buf = malloc(len);
+        if (!buf)
             return NULL;
+        snprintf(buf, len, "{\"jsonrpc\":\"2.0\",\"id\":%d,\"method\":\"%s\",\"params\":%s}", id, method, params);
+        bool failed;
+        char * resp = mcp_http_post(client, s, buf, id, timeout_ms, &failed);
+        free(buf);
+        if (failed)
+            fprintf(stderr, "[mcp-client] No response from '%s' (%s, id %d)\n", srv->name, method, id);
+        return resp;
+    }
 
-        /* Skip empty lines */
-        if (line[0] == '\0')
-            continue;
+    mcp_pending_t req = {.server = s};
+    pthread_mutex_lock(&client->lock);
+    if (srv->fd_read < 0 || client->closing) {
+        pthread_mutex_unlock(&client->lock);
+        return NULL;
+    }
+    req.id = srv->next_id++;
+    req.next = client->pending;
+    client->pending = &req;
+    pthread_mutex_unlock(&client->lock);
+
+    const char * params = params_json && params_json[0] ? params_json : "{}";
+    size_t len = strlen(method) + strlen(params) + 96;
+    char * buf = malloc(len);
+    bool sent = false;
+    if (buf) {
+        snprintf(buf, len, "{\"jsonrpc\":\"2.0\",\"id\":%d,\"method\":\"%s\",\"params\":%s}", req.id, method,
+                 params);
+        sent = mcp_client_send(srv, buf) == 0;
+        free(buf);
+    }
 
-        /* Check if this is a response (has "id") matching ours */
-        int resp_id = nj_find_int(line, "id", -1);
-        if (resp_id == id) {
-            return line; /* Matched! */
-        }
+    struct timespec deadline;
+    mcp_deadline(&deadline, timeout_ms);
 
-        /* This is either a notification or a response with different id.
-         * Log and continue reading. */
-        int method_len = 0;
-        const char * m = nj_find_str(line, "method", &method_len);
-        if (m) {
-            /* It's a notification — ignore (e.g., progress, log) */
-            continue;
+    pthread_mutex_lock(&client->lock);
+    while (sent && !req.done && !client->closing) {
+        if (pthread_cond_timedwait(&client->cond, &client->lock, &deadline) == ETIMEDOUT)
+            break;
+    }
+    for (mcp_pending_t ** pp = &client->pending; *pp; pp = &(*pp)->next) {
+        if (*pp == &req) {
+            *pp = req.next;
+            break;
         }
     }
+    bool timed_out = sent && !req.done && !client->closing;
+    pthread_mutex_unlock(&client->lock);
 
-    fprintf(stderr, "[mcp-client] No matching response from '%s' for id %d\n", srv->name, id);
-    return NULL;
+    if (timed_out)
+        fprintf(stderr, "[mcp-client] Timeout after %d ms waiting for '%s' (%s, id %d)\n", timeout_ms,
+                srv->name, method, req.id);
+    return req.response;
 }
 
 /* Send a JSON-RPC notification (no response expected) */
-static void mcp_client_notify(mcp_server_conn_t * srv, const char * method) {
-    if (!srv || !method)
+static void mcp_client_notify(neuronos_mcp_client_t * client, int s, const char * method) {
+    mcp_server_conn_t * srv = &client->servers[s];
+    if (!method)
         return;
 
     char buf[512];
     snprintf(buf, sizeof(buf),
              "{\"jsonrpc\":\"2.0\",\"method\":\"%s\"}", method);
-    mcp_client_send(srv, buf);
+    if (srv->transport == NEURONOS_MCP_TRANSPORT_HTTP) {
+        bool failed;
+        mcp_http_post(client, s, buf, -1, srv->timeout_ms, &failed);
+    } else {
+        mcp_client_send(srv, buf);
+    }
 }
 
 /* Spawn MCP server process with STDIO transport */
-static int mcp_server_spawn(mcp_server_conn_t * srv) {
+static int mcp_server_spawn(neuronos_mcp_client_t * client, mcp_server_conn_t * srv) {
     if (!srv || !srv->command)
         return -1;
 
@@ -317,11 +1213,18 @@ static int mcp_server_spawn(mcp_server_conn_t * srv) {
     close(pipe_in[0]);  /* parent doesn't read from child's stdin pipe */
     close(pipe_out[1]); /* parent doesn't write to child's stdout pipe */
 
+    /* Later children must not inherit our ends, or EOF never arrives */
+    fcntl(pipe_in[1], F_SETFD, FD_CLOEXEC);
+    fcntl(pipe_out[0], F_SETFD, FD_CLOEXEC);
+
+    pthread_mutex_lock(&client->lock);
     srv->pid = pid;
     srv->fd_write = pipe_in[1];
     srv->fd_read = pipe_out[0];
-
-    /* Set non-blocking flags could be useful but we use select() */
+    srv->in_len = 0;
+    srv->in_skip = false;
+    pthread_mutex_unlock(&client->lock);
+    mcp_reactor_wake(client); /* start polling the new fd */
 
     fprintf(stderr, "[mcp-client] Spawned '%s' (PID %d): %s", srv->name, pid, srv->command);
     for (int i = 0; i < srv->n_args; i++)
@@ -332,9 +1235,8 @@ static int mcp_server_spawn(mcp_server_conn_t * srv) {
 }
 
 /* Initialize handshake with an MCP server */
-static int mcp_server_initialize(mcp_server_conn_t * srv) {
-    if (!srv)
-        return -1;
+static int mcp_server_initialize(neuronos_mcp_client_t * client, int s) {
+    mcp_server_conn_t * srv = &client->servers[s];
 
     char params[1024];
     snprintf(params, sizeof(params),
@@ -346,7 +1248,7 @@ static int mcp_server_initialize(mcp_server_conn_t * srv) {
              "}}",
              MCP_PROTOCOL_VERSION, MCP_CLIENT_VERSION);
 
-    const char * resp = mcp_client_request(srv, "initialize", params);
+    char * resp = mcp_client_request(client, s, "initialize", params, srv->timeout_ms);
     if (!resp) {
         fprintf(stderr, "[mcp-client] Initialize failed for '%s'\n", srv->name);
         return -1;
@@ -358,31 +1260,100 @@ static int mcp_server_initialize(mcp_server_conn_t * srv) {
         const char * emsg = nj_find_str(resp, "message", &elen);
         fprintf(stderr, "[mcp-client] Server '%s' error: %.*s\n",
                 srv->name, elen, emsg ? emsg : "unknown");
+        free(resp);
         return -1;
     }
 
     /* Check protocol version in result */
+    char * result = nj_extract_object(resp, "result");
+    free(resp);
     int vlen = 0;
-    const char * ver = nj_find_str(resp, "protocolVersion", &vlen);
+    const char * ver = result ? nj_find_str(result, "protocolVersion", &vlen) : NULL;
     if (ver) {
         fprintf(stderr, "[mcp-client] '%s' protocol: %.*s\n", srv->name, vlen, ver);
+        /* HTTP requests carry it from now on */
+        snprintf(srv->protocol, sizeof(srv->protocol), "%.*s", vlen, ver);
     }
 
+    /* serverInfo.version decides whether cached tools are still current */
+    char * info = result ? nj_extract_object(result, "serverInfo") : NULL;
+    const char * sver = info ? nj_find_str(info, "version", &vlen) : NULL;
+    snprintf(srv->version, sizeof(srv->version), "%.*s", sver ? vlen : 0, sver ? sver : "");
+    free(info);
+    free(result);
+
     /* Send initialized notification */
-    mcp_client_notify(srv, "notifications/initialized");
+    mcp_client_notify(client, s, "notifications/initialized");
 
-    srv->connected = true;
+    pthread_mutex_lock(&client->lock);
+    srv->connected = srv->transport == NEURONOS_MCP_TRANSPORT_HTTP || srv->fd_read >= 0;
+    pthread_mutex_unlock(&client->lock);
     fprintf(stderr, "[mcp-client] '%s' connected successfully\n", srv->name);
     return 0;
 }
 
+/* Copy a string node as written (still escaped), truncated to cap - 1 */
+static int mcp_copy_raw_str(const nj_doc_t * doc, int node, char * dst, int cap) {
+    int len = 0;
+    const char * v = nj_str(doc, node, &len);
+    if (!v || len <= 0)
+        return 0;
+    if (len > cap - 1)
+        len = cap - 1;
+    memcpy(dst, v, (size_t)len);
+    dst[len] = '\0';
+    return len;
+}
+
+/* Parse the "tools" array of obj_json (a tools/list result or a cache
+ * file) into tools[]. Returns the number parsed. Names and descriptions
+ * are kept JSON-escaped, as they arrived. */
+static int mcp_parse_tools(const char * obj_json, const char * srv_name, mcp_tool_entry_t * tools,
+                           int max_tools, int server_index) {
+    nj_doc_t doc;
+    int arr = nj_parse(&doc, obj_json, strlen(obj_json)) == 0 ? nj_get(&doc, 0, "tools") : -1;
+    if (nj_type(&doc, arr) != NJ_ARRAY) {
+        fprintf(stderr, "[mcp-client] No tools array in response from '%s'\n", srv_name);
+        nj_doc_free(&doc);
+        return 0;
+    }
+
+    int count = 0;
+    for (int it = nj_first(&doc, arr); it >= 0 && count < max_tools; it = nj_next(&doc, arr, it)) {
+        mcp_tool_entry_t * t = &tools[count];
+        memset(t, 0, sizeof(*t));
+        if (!mcp_copy_raw_str(&doc, nj_get(&doc, it, "name"), t->name, MCP_MAX_TOOL_NAME))
+            continue;
+
+        if (!mcp_copy_raw_str(&doc, nj_get(&doc, it, "description"), t->description, MCP_MAX_TOOL_DESC))
+            snprintf(t->description, MCP_MAX_TOOL_DESC, "MCP tool from %s", srv_name);
+
+        int schema = nj_get(&doc, it, "inputSchema");
+        size_t slen = 0;
+        const char * sraw = nj_type(&doc, schema) == NJ_OBJECT ? nj_raw(&doc, schema, &slen) : NULL;
+        if (sraw && slen < MCP_MAX_TOOL_SCHEMA) {
+            memcpy(t->schema, sraw, slen);
+            t->schema[slen] = '\0';
+        } else {
+            strncpy(t->schema, "{\"type\":\"object\"}", MCP_MAX_TOOL_SCHEMA);
+        }
+
+        t->server_index = server_index;
+        count++;
+    }
+
+    nj_doc_free(&doc);
+    return count;
+}
+
 /* Discover tools from a connected MCP server */
-static int mcp_discover_tools(mcp_server_conn_t * srv, mcp_tool_entry_t * tools,
+static int mcp_discover_tools(neuronos_mcp_client_t * client, mcp_tool_entry_t * tools,
                               int max_tools, int server_index) {
-    if (!srv || !srv->connected || !tools)
+    mcp_server_conn_t * srv = &client->servers[server_index];
+    if (!tools)
         return 0;
 
-    const char * resp = mcp_client_request(srv, "tools/list", "{}");
+    char * resp = mcp_client_request(client, server_index, "tools/list", "{}", srv->timeout_ms);
     if (!resp) {
         fprintf(stderr, "[mcp-client] tools/list failed for '%s'\n", srv->name);
         return 0;
@@ -390,112 +1361,186 @@ static int mcp_discover_tools(mcp_server_conn_t * srv, mcp_tool_entry_t * tools,
 
     /* Extract tools array from result */
     char * result = nj_extract_object(resp, "result");
+    free(resp);
     if (!result) {
         fprintf(stderr, "[mcp-client] No result in tools/list response from '%s'\n", srv->name);
         return 0;
     }
 
-    char * tools_arr = nj_extract_array(result, "tools");
+    int count = mcp_parse_tools(result, srv->name, tools, max_tools, server_index);
     free(result);
-    if (!tools_arr) {
-        fprintf(stderr, "[mcp-client] No tools array in response from '%s'\n", srv->name);
-        return 0;
+    fprintf(stderr, "[mcp-client] Discovered %d tools from '%s'\n", count, srv->name);
+    return count;
+}
+
+/* Publish tools found for server s. A name the server already lists is
+ * kept as is: the registry may hold pointers into that entry. */
+static int mcp_tools_merge(neuronos_mcp_client_t * client, int s, const mcp_tool_entry_t * found, int n) {
+    int added = 0;
+    pthread_mutex_lock(&client->lock);
+    for (int i = 0; i < n && client->n_tools < MCP_MAX_TOOLS; i++) {
+        bool known = false;
+        for (int j = 0; j < client->n_tools && !known; j++)
+            known = client->tools[j].server_index == s && strcmp(client->tools[j].name, found[i].name) == 0;
+        if (known)
+            continue;
+        client->tools[client->n_tools] = found[i];
+        client->tools[client->n_tools].registered = false;
+        __atomic_store_n(&client->n_tools, client->n_tools + 1, __ATOMIC_RELEASE);
+        added++;
     }
+    pthread_mutex_unlock(&client->lock);
+    return added;
+}
 
-    /* Parse individual tools from array.
-     * Simple approach: scan for {"name": patterns within the array */
-    int count = 0;
-    const char * p = tools_arr + 1; /* skip '[' */
+/* ============================================================
+ * DISCOVERY CACHE
+ *
+ * <cache_dir>/<hash of command, args, env>.json holds the server's
+ * serverInfo.version and its tools/list result. Cached tools are
+ * offered as soon as connecting starts; tools/list is skipped when
+ * the server reports the same version after initialize.
+ * ============================================================ */
 
-    while (*p && count < max_tools) {
-        /* Find next object start */
-        while (*p && *p != '{')
-            p++;
-        if (!*p)
-            break;
+/* FNV-1a, including the terminating NUL so "a","bc" != "ab","c" */
+static uint64_t mcp_hash_str(uint64_t h, const char * str) {
+    const char * c = str ? str : "";
+    do {
+        h ^= (unsigned char)*c;
+        h *= 1099511628211ULL;
+    } while (*c++);
+    return h;
+}
 
-        /* Find matching close brace */
-        const char * obj_start = p;
-        int depth = 1;
-        p++;
-        while (*p && depth > 0) {
-            if (*p == '{')
-                depth++;
-            else if (*p == '}')
-                depth--;
-            else if (*p == '"') {
-                p++;
-                while (*p && *p != '"') {
-                    if (*p == '\\' && *(p + 1))
-                        p++;
-                    p++;
-                }
-            }
-            if (depth > 0)
-                p++;
-        }
+static uint64_t mcp_cache_key(const mcp_server_conn_t * srv) {
+    uint64_t h = mcp_hash_str(1469598103934665603ULL, srv->command);
+    if (srv->url)
+        h = mcp_hash_str(h, srv->url);
+    for (int i = 0; i < srv->n_args; i++)
+        h = mcp_hash_str(h, srv->args[i]);
+    for (int i = 0; i < srv->n_env; i++)
+        h = mcp_hash_str(h, srv->env[i]);
+    return h;
+}
 
-        if (depth != 0)
-            break;
+static bool mcp_cache_path(const neuronos_mcp_client_t * client, const mcp_server_conn_t * srv, char * buf,
+                           size_t len) {
+    if (!client->cache_dir[0] || (!srv->command && !srv->url))
+        return false;
+    snprintf(buf, len, "%s/%016llx.json", client->cache_dir, (unsigned long long)mcp_cache_key(srv));
+    return true;
+}
 
-        /* Extract tool object as string */
-        size_t obj_len = (size_t)(p - obj_start + 1);
-        char * tool_json = malloc(obj_len + 1);
-        if (!tool_json)
-            break;
-        memcpy(tool_json, obj_start, obj_len);
-        tool_json[obj_len] = '\0';
-
-        /* Parse name */
-        int name_len = 0;
-        const char * name = nj_find_str(tool_json, "name", &name_len);
-        if (name && name_len > 0) {
-            mcp_tool_entry_t * t = &tools[count];
-            int cpy = name_len < MCP_MAX_TOOL_NAME - 1 ? name_len : MCP_MAX_TOOL_NAME - 1;
-            memcpy(t->name, name, (size_t)cpy);
-            t->name[cpy] = '\0';
-
-            /* Parse description */
-            int desc_len = 0;
-            const char * desc = nj_find_str(tool_json, "description", &desc_len);
-            if (desc && desc_len > 0) {
-                int dcpy = desc_len < MCP_MAX_TOOL_DESC - 1 ? desc_len : MCP_MAX_TOOL_DESC - 1;
-                memcpy(t->description, desc, (size_t)dcpy);
-                t->description[dcpy] = '\0';
-            } else {
-                snprintf(t->description, MCP_MAX_TOOL_DESC, "MCP tool from %s", srv->name);
-            }
+/* Load server s's cached tools. Returns the count; sets srv->cached_version. */
+static int mcp_cache_load(neuronos_mcp_client_t * client, int s, mcp_tool_entry_t * found, int max) {
+    mcp_server_conn_t * srv = &client->servers[s];
+    char path[640];
+    if (!mcp_cache_path(client, srv, path, sizeof(path)))
+        return 0;
+    FILE * f = fopen(path, "rb");
+    if (!f)
+        return 0;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char * json = size > 0 && size <= MCP_MAX_MESSAGE ? malloc((size_t)size + 1) : NULL;
+    size_t nread = json ? fread(json, 1, (size_t)size, f) : 0;
+    fclose(f);
+    if (!json)
+        return 0;
+    json[nread] = '\0';
 
-            /* Parse inputSchema */
-            char * schema = nj_extract_object(tool_json, "inputSchema");
-            if (schema) {
-                size_t slen = strlen(schema);
-                if (slen < MCP_MAX_TOOL_SCHEMA) {
-                    memcpy(t->schema, schema, slen + 1);
-                } else {
-                    strncpy(t->schema, "{\"type\":\"object\"}", MCP_MAX_TOOL_SCHEMA);
-                }
-                free(schema);
-            } else {
-                strncpy(t->schema, "{\"type\":\"object\"}", MCP_MAX_TOOL_SCHEMA);
-            }
+    int vlen = 0;
+    const char * ver = nj_find_str(json, "version", &vlen);
+    int n = ver ? mcp_parse_tools(json, srv->name, found, max, s) : 0;
+    if (n > 0)
+        snprintf(srv->cached_version, sizeof(srv->cached_version), "%.*s", vlen, ver);
+    free(json);
+    return n;
+}
 
-            t->server_index = server_index;
-            count++;
-        }
+/* Save server s's tool list (as published) for the next start */
+static void mcp_cache_store(neuronos_mcp_client_t * client, int s, const mcp_tool_entry_t * found, int n) {
+    mcp_server_conn_t * srv = &client->servers[s];
+    char path[640], tmp[660];
+    if (!mcp_cache_path(client, srv, path, sizeof(path)))
+        return;
+    char parent[512];
+    snprintf(parent, sizeof(parent), "%s", client->cache_dir);
+    char * slash = strrchr(parent, '/');
+    if (slash && slash != parent) {
+        *slash = '\0';
+        mkdir(parent, 0755);
+    }
+    mkdir(client->cache_dir, 0755);
 
-        free(tool_json);
-        if (*p)
-            p++; /* move past '}' */
+    snprintf(tmp, sizeof(tmp), "%s.%d.tmp", path, (int)getpid());
+    FILE * f = fopen(tmp, "wb");
+    if (!f)
+        return;
+    /* name/description are kept JSON-escaped, so they are written verbatim */
+    fprintf(f, "{\"version\":\"%s\",\"tools\":[", srv->version);
+    for (int i = 0; i < n; i++)
+        fprintf(f, "%s{\"name\":\"%s\",\"description\":\"%s\",\"inputSchema\":%s}", i ? "," : "",
+                found[i].name, found[i].description, found[i].schema[0] ? found[i].schema : "{}");
+    fprintf(f, "]}\n");
+    if (fclose(f) != 0 || rename(tmp, path) != 0)
+        remove(tmp);
+}
+
+/* ============================================================
+ * STARTUP: one thread per server spawns, initializes and discovers,
+ * so slow servers (npx, pip) start side by side.
+ * ============================================================ */
+
+typedef struct {
+    neuronos_mcp_client_t * client;
+    int index;
+} mcp_start_arg_t;
+
+static void mcp_server_stop(neuronos_mcp_client_t * client, mcp_server_conn_t * srv);
+
+static void * mcp_server_start(void * arg) {
+    mcp_start_arg_t a = *(mcp_start_arg_t *)arg;
+    free(arg);
+    neuronos_mcp_client_t * client = a.client;
+    mcp_server_conn_t * srv = &client->servers[a.index];
+
+    pthread_mutex_lock(&client->lock);
+    bool closing = client->closing;
+    pthread_mutex_unlock(&client->lock);
+
+    if (closing) {
+        /* Shutting down before we started */
+    } else if (srv->transport == NEURONOS_MCP_TRANSPORT_STDIO && mcp_server_spawn(client, srv) < 0) {
+        fprintf(stderr, "[mcp-client] Failed to spawn '%s'\n", srv->name);
+    } else if (mcp_server_initialize(client, a.index) < 0) {
+        fprintf(stderr, "[mcp-client] Initialization failed for '%s'\n", srv->name);
+        mcp_server_stop(client, srv);
+    } else if (srv->n_cached > 0 && strcmp(srv->version, srv->cached_version) == 0) {
+        fprintf(stderr, "[mcp-client] '%s': %d tools from cache\n", srv->name, srv->n_cached);
+    } else {
+        mcp_tool_entry_t * found = calloc(MCP_MAX_TOOLS, sizeof(mcp_tool_entry_t));
+        int n = found ? mcp_discover_tools(client, found, MCP_MAX_TOOLS, a.index) : 0;
+        if (n > 0) {
+            mcp_tools_merge(client, a.index, found, n);
+            mcp_cache_store(client, a.index, found, n);
+            if (srv->n_cached > 0)
+                fprintf(stderr, "[mcp-client] '%s' changed version (%s -> %s); cache refreshed\n", srv->name,
+                        srv->cached_version, srv->version);
+        }
+        free(found);
     }
 
-    free(tools_arr);
-    fprintf(stderr, "[mcp-client] Discovered %d tools from '%s'\n", count, srv->name);
-    return count;
+    pthread_mutex_lock(&client->lock);
+    srv->starting = false;
+    pthread_cond_broadcast(&client->cond);
+    pthread_mutex_unlock(&client->lock);
+    return NULL;
 }
 
 /* Stop an MCP server process */
-static void mcp_server_stop(mcp_server_conn_t * srv) {
+static void mcp_server_stop(neuronos_mcp_client_t * client, mcp_server_conn_t * srv) {
     if (!srv)
         return;
 
@@ -503,10 +1548,23 @@ static void mcp_server_stop(mcp_server_conn_t * srv) {
         close(srv->fd_write);
         srv->fd_write = -1;
     }
+
+    /* While the reactor runs it owns fd_read: ask it to close the fd
+     * rather than closing one it may be polling. */
+    pthread_mutex_lock(&client->lock);
     if (srv->fd_read >= 0) {
-        close(srv->fd_read);
-        srv->fd_read = -1;
+        if (client->reactor_running) {
+            srv->detach = true;
+            mcp_reactor_wake(client);
+            while (srv->detach)
+                pthread_cond_wait(&client->cond, &client->lock);
+        } else {
+            close(srv->fd_read);
+            srv->fd_read = -1;
+        }
     }
+    srv->connected = false;
+    pthread_mutex_unlock(&client->lock);
 
     if (srv->pid > 0) {
         kill(srv->pid, SIGTERM);
@@ -515,8 +1573,9 @@ static void mcp_server_stop(mcp_server_conn_t * srv) {
         srv->pid = -1;
     }
 
-    free(srv->read_buf);
-    srv->read_buf = NULL;
+    free(srv->in_buf);
+    srv->in_buf = NULL;
+    srv->in_len = srv->in_cap = 0;
     free(srv->command);
     srv->command = NULL;
 
@@ -534,7 +1593,29 @@ static void mcp_server_stop(mcp_server_conn_t * srv) {
         srv->env = NULL;
     }
 
-    srv->connected = false;
+    /* HTTP: pooled connections and config */
+    pthread_mutex_lock(&client->lock);
+    int n_idle = srv->n_idle;
+    srv->n_idle = 0;
+    pthread_mutex_unlock(&client->lock);
+    for (int i = 0; i < n_idle; i++)
+        mcp_http_close(srv->idle[i]);
+#ifdef NEURONOS_HAS_OPENSSL
+    if (srv->tls_session) {
+        SSL_SESSION_free(srv->tls_session);
+        srv->tls_session = NULL;
+    }
+#endif
+    free(srv->url);
+    srv->url = NULL;
+    free(srv->path);
+    srv->path = NULL;
+    if (srv->headers) {
+        for (int i = 0; i < srv->n_headers; i++)
+            free(srv->headers[i]);
+        free(srv->headers);
+        srv->headers = NULL;
+    }
 }
 
 /* ============================================================
@@ -586,7 +1667,12 @@ static neuronos_tool_result_t mcp_tool_bridge(const char * args_json, void * use
  *     "name": {
  *       "command": "npx",
  *       "args": ["-y", "@modelcontextprotocol/server-filesystem", "/tmp"],
- *       "env": { "KEY": "value" }
+ *       "env": { "KEY": "value" },
+ *       "timeout": 60000              (optional, per-call ms)
+ *     },
+ *     "remote": {
+ *       "url": "https://mcp.example.com/mcp",
+ *       "headers": { "Authorization": "Bearer ..." }
  *     }
  *   }
  * }
@@ -645,8 +1731,8 @@ static int parse_string_array(const char * arr_json, char *** out) {
     return count;
 }
 
-/* Parse env object { "KEY": "val", ... } → array of "KEY=val" strings */
-static int parse_env_object(const char * obj_json, char *** out) {
+/* Parse env object { "KEY": "val", ... } → array of "KEY<sep>val" strings */
+static int parse_env_object(const char * obj_json, const char * sep, char *** out) {
     if (!obj_json || obj_json[0] != '{' || !out)
         return 0;
 
@@ -703,12 +1789,13 @@ static int parse_env_object(const char * obj_json, char *** out) {
         }
 
         /* Format: KEY=value */
-        items[count] = malloc(key_len + 1 + val_len + 1);
+        size_t sep_len = strlen(sep);
+        items[count] = malloc(key_len + sep_len + val_len + 1);
         if (items[count]) {
             memcpy(items[count], key_start, key_len);
-            items[count][key_len] = '=';
-            memcpy(items[count] + key_len + 1, val_start, val_len);
-            items[count][key_len + 1 + val_len] = '\0';
+            memcpy(items[count] + key_len, sep, sep_len);
+            memcpy(items[count] + key_len + sep_len, val_start, val_len);
+            items[count][key_len + sep_len + val_len] = '\0';
             count++;
         }
     }
@@ -733,6 +1820,14 @@ neuronos_mcp_client_t * neuronos_mcp_client_create(void) {
         client->servers[i].fd_read = -1;
         client->servers[i].next_id = 1;
     }
+    pthread_mutex_init(&client->lock, NULL);
+    pthread_cond_init(&client->cond, NULL);
+    client->wake[0] = client->wake[1] = -1;
+
+    /* Discovery cache: ~/.neuronos/mcp_cache */
+    const char * home = getenv("HOME");
+    if (home)
+        snprintf(client->cache_dir, sizeof(client->cache_dir), "%s/.neuronos/mcp_cache", home);
 
     return client;
 }
@@ -749,6 +1844,10 @@ int neuronos_mcp_client_add_server(neuronos_mcp_client_t * client,
         fprintf(stderr, "[mcp-client] STDIO transport requires 'command'\n");
         return -1;
     }
+    if (config->transport == NEURONOS_MCP_TRANSPORT_HTTP && !config->url) {
+        fprintf(stderr, "[mcp-client] HTTP transport requires 'url'\n");
+        return -1;
+    }
 
     mcp_server_conn_t * srv = &client->servers[client->n_servers];
     memset(srv, 0, sizeof(*srv));
@@ -756,10 +1855,40 @@ int neuronos_mcp_client_add_server(neuronos_mcp_client_t * client,
     srv->fd_write = -1;
     srv->fd_read = -1;
     srv->next_id = 1;
+    srv->timeout_ms = config->timeout_ms > 0 ? config->timeout_ms : MCP_DEFAULT_TIMEOUT_MS;
+    pthread_mutex_init(&srv->write_lock, NULL);
 
     strncpy(srv->name, config->name, sizeof(srv->name) - 1);
     srv->transport = config->transport;
 
+    /* HTTP endpoint */
+    if (config->transport == NEURONOS_MCP_TRANSPORT_HTTP) {
+        if (mcp_url_parse(srv, config->url) < 0) {
+            fprintf(stderr, "[mcp-client] '%s': invalid URL %s\n", config->name, config->url);
+            free(srv->path);
+            srv->path = NULL;
+            return -1;
+        }
+#ifndef NEURONOS_HAS_OPENSSL
+        if (srv->tls) {
+            fprintf(stderr, "[mcp-client] '%s': https:// needs a build with OpenSSL (NEURONOS_MCP_TLS)\n",
+                    config->name);
+            free(srv->path);
+            srv->path = NULL;
+            return -1;
+        }
+#endif
+        srv->url = strdup(config->url);
+        if (config->headers && config->n_headers > 0) {
+            srv->headers = calloc((size_t)config->n_headers, sizeof(char *));
+            if (!srv->headers) return -1;
+            for (int i = 0; i < config->n_headers; i++) {
+                if (config->headers[i])
+                    srv->headers[srv->n_headers++] = strdup(config->headers[i]);
+            }
+        }
+    }
+
     /* Copy command */
     if (config->command)
         srv->command = strdup(config->command);
@@ -787,64 +1916,128 @@ int neuronos_mcp_client_add_server(neuronos_mcp_client_t * client,
     client->n_servers++;
     fprintf(stderr, "[mcp-client] Added server '%s' (%s)\n",
             config->name,
-            config->transport == NEURONOS_MCP_TRANSPORT_STDIO ? "STDIO" : "HTTP");
+            config->transport == NEURONOS_MCP_TRANSPORT_STDIO ? "STDIO" : config->url);
     return 0;
 }
 
-int neuronos_mcp_client_connect(neuronos_mcp_client_t * client) {
+void neuronos_mcp_client_set_cache_dir(neuronos_mcp_client_t * client, const char * dir) {
+    if (client)
+        snprintf(client->cache_dir, sizeof(client->cache_dir), "%s", dir ? dir : "");
+}
+
+int neuronos_mcp_client_connect_async(neuronos_mcp_client_t * client) {
     if (!client)
         return -1;
 
-    int connected = 0;
-    int total_tools = 0;
+    if (mcp_reactor_start(client) < 0) {
+        fprintf(stderr, "[mcp-client] Failed to start reader thread\n");
+        return -1;
+    }
+
+    /* A server that goes away must not take us down with SIGPIPE */
+    struct sigaction sa;
+    if (sigaction(SIGPIPE, NULL, &sa) == 0 && sa.sa_handler == SIG_DFL)
+        signal(SIGPIPE, SIG_IGN);
+
+#ifdef NEURONOS_HAS_OPENSSL
+    if (!client->tls_ctx) {
+        for (int i = 0; i < client->n_servers; i++) {
+            if (client->servers[i].tls) {
+                client->tls_ctx = SSL_CTX_new(TLS_client_method());
+                if (client->tls_ctx) {
+                    SSL_CTX_set_default_verify_paths(client->tls_ctx);
+                    SSL_CTX_set_verify(client->tls_ctx, SSL_VERIFY_PEER, NULL);
+                    SSL_CTX_set_session_cache_mode(client->tls_ctx, SSL_SESS_CACHE_CLIENT);
+                }
+                break;
+            }
+        }
+    }
+#endif
 
     fprintf(stderr, "[mcp-client] Connecting to %d MCP server(s)...\n", client->n_servers);
 
+    mcp_tool_entry_t * cached = calloc(MCP_MAX_TOOLS, sizeof(mcp_tool_entry_t));
+    int started = 0;
     for (int i = 0; i < client->n_servers; i++) {
         mcp_server_conn_t * srv = &client->servers[i];
 
-        if (srv->transport != NEURONOS_MCP_TRANSPORT_STDIO) {
-            fprintf(stderr, "[mcp-client] Skipping '%s' (HTTP transport not yet implemented)\n",
-                    srv->name);
-            continue;
-        }
+        if (srv->has_starter)
+            continue; /* already started (or tried) */
 
-        /* Spawn the server process */
-        if (mcp_server_spawn(srv) < 0) {
-            fprintf(stderr, "[mcp-client] Failed to spawn '%s'\n", srv->name);
-            continue;
+        /* Offer last run's tools right away; calls wait for the server */
+        if (cached) {
+            srv->n_cached = mcp_cache_load(client, i, cached, MCP_MAX_TOOLS);
+            if (srv->n_cached > 0)
+                mcp_tools_merge(client, i, cached, srv->n_cached);
         }
 
-        /* Small delay to let the server start */
-        usleep(200000); /* 200ms */
-
-        /* Initialize handshake */
-        if (mcp_server_initialize(srv) < 0) {
-            fprintf(stderr, "[mcp-client] Initialization failed for '%s'\n", srv->name);
-            mcp_server_stop(srv);
+        mcp_start_arg_t * arg = malloc(sizeof(*arg));
+        if (!arg)
+            continue;
+        arg->client = client;
+        arg->index = i;
+        pthread_mutex_lock(&client->lock);
+        srv->starting = true;
+        pthread_mutex_unlock(&client->lock);
+        if (pthread_create(&srv->starter, NULL, mcp_server_start, arg) != 0) {
+            free(arg);
+            pthread_mutex_lock(&client->lock);
+            srv->starting = false;
+            pthread_mutex_unlock(&client->lock);
             continue;
         }
+        srv->has_starter = true;
+        started++;
+    }
+    free(cached);
+    return started;
+}
 
-        connected++;
+int neuronos_mcp_client_wait(neuronos_mcp_client_t * client, int timeout_ms) {
+    if (!client)
+        return 0;
 
-        /* Discover tools */
-        int remaining = MCP_MAX_TOOLS - client->n_tools;
-        if (remaining > 0) {
-            int found = mcp_discover_tools(srv, &client->tools[client->n_tools],
-                                           remaining, i);
-            client->n_tools += found;
-            total_tools += found;
-        }
+    struct timespec deadline;
+    if (timeout_ms >= 0)
+        mcp_deadline(&deadline, timeout_ms);
+
+    int pending;
+    pthread_mutex_lock(&client->lock);
+    for (;;) {
+        pending = 0;
+        for (int i = 0; i < client->n_servers; i++)
+            pending += client->servers[i].starting;
+        if (pending == 0)
+            break;
+        if (timeout_ms < 0)
+            pthread_cond_wait(&client->cond, &client->lock);
+        else if (pthread_cond_timedwait(&client->cond, &client->lock, &deadline) == ETIMEDOUT)
+            break;
     }
+    pthread_mutex_unlock(&client->lock);
+    return pending;
+}
+
+int neuronos_mcp_client_connect(neuronos_mcp_client_t * client) {
+    if (neuronos_mcp_client_connect_async(client) < 0)
+        return -1;
+    neuronos_mcp_client_wait(client, -1);
+
+    int connected = 0;
+    pthread_mutex_lock(&client->lock);
+    for (int i = 0; i < client->n_servers; i++)
+        connected += client->servers[i].connected;
+    pthread_mutex_unlock(&client->lock);
 
     fprintf(stderr, "[mcp-client] Connected: %d/%d servers, %d tools discovered\n",
-            connected, client->n_servers, total_tools);
+            connected, client->n_servers, neuronos_mcp_client_tool_count(client));
 
     return connected > 0 ? 0 : -1;
 }
 
 int neuronos_mcp_client_tool_count(const neuronos_mcp_client_t * client) {
-    return client ? client->n_tools : 0;
+    return client ? __atomic_load_n(&client->n_tools, __ATOMIC_ACQUIRE) : 0;
 }
 
 int neuronos_mcp_client_register_tools(neuronos_mcp_client_t * client,
@@ -853,9 +2046,13 @@ int neuronos_mcp_client_register_tools(neuronos_mcp_client_t * client,
         return -1;
 
     int registered = 0;
+    int n_tools = neuronos_mcp_client_tool_count(client);
 
-    for (int i = 0; i < client->n_tools; i++) {
-        const mcp_tool_entry_t * tool = &client->tools[i];
+    for (int i = 0; i < n_tools; i++) {
+        mcp_tool_entry_t * tool = &client->tools[i];
+        if (tool->registered)
+            continue;
+        tool->registered = true; /* a rejected duplicate is not retried */
 
         /* Allocate bridge data (leaked intentionally — lives as long as registry) */
         mcp_bridge_data_t * bd = malloc(sizeof(mcp_bridge_data_t));
@@ -871,6 +2068,7 @@ int neuronos_mcp_client_register_tools(neuronos_mcp_client_t * client,
             .execute = mcp_tool_bridge,
             .user_data = bd,
             .required_caps = NEURONOS_CAP_NETWORK, /* MCP tools use IPC = network-like */
+            .thread_safe = true, /* requests are correlated by id */
         };
 
         if (neuronos_tool_register(registry, &desc) == 0) {
@@ -880,20 +2078,29 @@ int neuronos_mcp_client_register_tools(neuronos_mcp_client_t * client,
         }
     }
 
-    fprintf(stderr, "[mcp-client] Registered %d/%d MCP tools in tool registry\n",
-            registered, client->n_tools);
+    if (registered > 0)
+        fprintf(stderr, "[mcp-client] Registered %d/%d MCP tools in tool registry\n",
+                registered, n_tools);
     return registered;
 }
 
 char * neuronos_mcp_client_call_tool(neuronos_mcp_client_t * client,
                                      const char * tool_name,
                                      const char * args_json) {
+    return neuronos_mcp_client_call_tool_timeout(client, tool_name, args_json, 0);
+}
+
+char * neuronos_mcp_client_call_tool_timeout(neuronos_mcp_client_t * client,
+                                             const char * tool_name,
+                                             const char * args_json,
+                                             int timeout_ms) {
     if (!client || !tool_name)
         return NULL;
 
     /* Find the tool and its server */
     int tool_idx = -1;
-    for (int i = 0; i < client->n_tools; i++) {
+    int n_tools = neuronos_mcp_client_tool_count(client);
+    for (int i = 0; i < n_tools; i++) {
         if (strcmp(client->tools[i].name, tool_name) == 0) {
             tool_idx = i;
             break;
@@ -912,74 +2119,96 @@ char * neuronos_mcp_client_call_tool(neuronos_mcp_client_t * client,
     }
 
     mcp_server_conn_t * srv = &client->servers[srv_idx];
-    if (!srv->connected) {
+    if (timeout_ms <= 0)
+        timeout_ms = srv->timeout_ms;
+
+    /* A tool offered from the discovery cache may belong to a server
+     * that is still starting: give it the call's timeout to come up. */
+    pthread_mutex_lock(&client->lock);
+    if (srv->starting) {
+        struct timespec deadline;
+        mcp_deadline(&deadline, timeout_ms);
+        while (srv->starting && !client->closing) {
+            if (pthread_cond_timedwait(&client->cond, &client->lock, &deadline) == ETIMEDOUT)
+                break;
+        }
+    }
+    bool connected = srv->connected;
+    pthread_mutex_unlock(&client->lock);
+    if (!connected) {
         fprintf(stderr, "[mcp-client] Server '%s' not connected\n", srv->name);
         return NULL;
     }
 
     /* Build tools/call params */
     char * esc_name = nj_escape(tool_name);
-    char params[MCP_MAX_LINE];
-    snprintf(params, sizeof(params),
-             "{\"name\":\"%s\",\"arguments\":%s}",
-             esc_name ? esc_name : tool_name,
-             (args_json && args_json[0] == '{') ? args_json : "{}");
+    const char * name = esc_name ? esc_name : tool_name;
+    const char * args = (args_json && args_json[0] == '{') ? args_json : "{}";
+    size_t plen = strlen(name) + strlen(args) + 32;
+    char * params = malloc(plen);
+    if (!params) {
+        free(esc_name);
+        return NULL;
+    }
+    snprintf(params, plen, "{\"name\":\"%s\",\"arguments\":%s}", name, args);
     free(esc_name);
 
     fprintf(stderr, "[mcp-client] Calling tool '%s' on '%s'\n", tool_name, srv->name);
 
-    const char * resp = mcp_client_request(srv, "tools/call", params);
+    char * resp = mcp_client_request(client, srv_idx, "tools/call", params, timeout_ms);
+    free(params);
     if (!resp) {
         fprintf(stderr, "[mcp-client] No response for tools/call '%s'\n", tool_name);
         return NULL;
     }
 
-    /* Check for error */
-    if (strstr(resp, "\"error\"") && !strstr(resp, "\"isError\"")) {
+    nj_doc_t doc;
+    nj_parse(&doc, resp, strlen(resp));
+
+    /* JSON-RPC error */
+    int error = nj_get(&doc, 0, "error");
+    if (error >= 0) {
         int elen = 0;
-        const char * emsg = nj_find_str(resp, "message", &elen);
+        const char * emsg = nj_str(&doc, nj_get(&doc, error, "message"), &elen);
+        char * err = NULL;
         if (emsg) {
-            char * err = malloc((size_t)(elen + 32));
-            if (err) {
+            err = malloc((size_t)(elen + 32));
+            if (err)
                 snprintf(err, (size_t)(elen + 32), "MCP error: %.*s", elen, emsg);
-                return err;
-            }
-        }
-        return strdup("MCP tool call returned an error");
-    }
-
-    /* Extract text content from result.content[0].text */
-    char * result_obj = nj_extract_object(resp, "result");
-    if (!result_obj) {
-        /* Try direct text extraction */
-        int tlen = 0;
-        const char * text = nj_find_str(resp, "text", &tlen);
-        if (text && tlen > 0) {
-            char * out = malloc((size_t)(tlen + 1));
-            if (out) {
-                memcpy(out, text, (size_t)tlen);
-                out[tlen] = '\0';
-                return out;
-            }
         }
+        nj_doc_free(&doc);
+        free(resp);
+        return err ? err : strdup("MCP tool call returned an error");
+    }
+
+    int result = nj_get(&doc, 0, "result");
+    if (result < 0) {
+        nj_doc_free(&doc);
+        free(resp);
         return strdup("(empty result)");
     }
 
-    /* Look for text in content array */
-    int tlen = 0;
-    const char * text = nj_find_str(result_obj, "text", &tlen);
-    if (text && tlen > 0) {
-        char * out = malloc((size_t)(tlen + 1));
-        if (out) {
-            memcpy(out, text, (size_t)tlen);
-            out[tlen] = '\0';
-        }
-        free(result_obj);
-        return out;
+    /* Join the text blocks of result.content, unescaped */
+    nj_writer_t text = {0};
+    int content = nj_get(&doc, result, "content");
+    for (int c = nj_first(&doc, content); c >= 0; c = nj_next(&doc, content, c)) {
+        char * block = nj_str_dup(&doc, nj_get(&doc, c, "text"));
+        if (!block)
+            continue;
+        if (text.len)
+            nj_w_raw(&text, "\n");
+        nj_w_raw(&text, block);
+        free(block);
     }
+    char * out = text.len ? nj_w_finish(&text) : NULL;
+    nj_w_free(&text);
 
     /* Fallback: return the whole result object */
-    return result_obj;
+    if (!out)
+        out = nj_raw_dup(&doc, result);
+    nj_doc_free(&doc);
+    free(resp);
+    return out;
 }
 
 int neuronos_mcp_client_load_config(neuronos_mcp_client_t * client,
@@ -1083,18 +2312,27 @@ int neuronos_mcp_client_load_config(neuronos_mcp_client_t * client,
         memcpy(srv_json, obj_start, obj_len);
         srv_json[obj_len] = '\0';
 
-        /* Extract command */
-        int cmd_len = 0;
+        /* Extract command (local process) or url (remote server) */
+        int cmd_len = 0, url_len = 0;
         const char * cmd = nj_find_str(srv_json, "command", &cmd_len);
+        const char * url = nj_find_str(srv_json, "url", &url_len);
+        if (cmd && cmd_len == 0)
+            cmd = NULL;
 
-        if (cmd && cmd_len > 0) {
+        if (cmd || (url && url_len > 0)) {
             char server_name[128] = {0};
             size_t ncpy = name_len < sizeof(server_name) - 1 ? name_len : sizeof(server_name) - 1;
             memcpy(server_name, name_start, ncpy);
 
             char command[512] = {0};
-            int ccpy = cmd_len < (int)sizeof(command) - 1 ? cmd_len : (int)sizeof(command) - 1;
-            memcpy(command, cmd, (size_t)ccpy);
+            char url_buf[1024] = {0};
+            if (cmd) {
+                int ccpy = cmd_len < (int)sizeof(command) - 1 ? cmd_len : (int)sizeof(command) - 1;
+                memcpy(command, cmd, (size_t)ccpy);
+            } else {
+                int ucpy = url_len < (int)sizeof(url_buf) - 1 ? url_len : (int)sizeof(url_buf) - 1;
+                memcpy(url_buf, url, (size_t)ucpy);
+            }
 
             /* Parse args array */
             char ** args = NULL;
@@ -1110,18 +2348,31 @@ int neuronos_mcp_client_load_config(neuronos_mcp_client_t * client,
             int n_env = 0;
             char * env_obj = nj_extract_object(srv_json, "env");
             if (env_obj) {
-                n_env = parse_env_object(env_obj, &env);
+                n_env = parse_env_object(env_obj, "=", &env);
                 free(env_obj);
             }
 
+            /* Parse headers object (HTTP) */
+            char ** headers = NULL;
+            int n_headers = 0;
+            char * hdr_obj = nj_extract_object(srv_json, "headers");
+            if (hdr_obj) {
+                n_headers = parse_env_object(hdr_obj, ": ", &headers);
+                free(hdr_obj);
+            }
+
             neuronos_mcp_server_config_t config = {
                 .name = server_name,
-                .transport = NEURONOS_MCP_TRANSPORT_STDIO,
-                .command = command,
+                .transport = cmd ? NEURONOS_MCP_TRANSPORT_STDIO : NEURONOS_MCP_TRANSPORT_HTTP,
+                .command = cmd ? command : NULL,
                 .args = (const char **)args,
                 .n_args = n_args,
+                .url = cmd ? NULL : url_buf,
                 .env = (const char **)env,
                 .n_env = n_env,
+                .timeout_ms = nj_find_int(srv_json, "timeout", 0),
+                .headers = (const char **)headers,
+                .n_headers = n_headers,
             };
 
             if (neuronos_mcp_client_add_server(client, &config) == 0) {
@@ -1139,6 +2390,11 @@ int neuronos_mcp_client_load_config(neuronos_mcp_client_t * client,
                     free(env[i]);
                 free(env);
             }
+            if (headers) {
+                for (int i = 0; i < n_headers; i++)
+                    free(headers[i]);
+                free(headers);
+            }
         }
 
         free(srv_json);
@@ -1159,10 +2415,27 @@ void neuronos_mcp_client_free(neuronos_mcp_client_t * client) {
 
     fprintf(stderr, "[mcp-client] Shutting down %d server(s)...\n", client->n_servers);
 
+    /* Release callers and start-up threads, then stop the reactor */
+    pthread_mutex_lock(&client->lock);
+    client->closing = true;
+    pthread_cond_broadcast(&client->cond);
+    pthread_mutex_unlock(&client->lock);
     for (int i = 0; i < client->n_servers; i++) {
-        mcp_server_stop(&client->servers[i]);
+        if (client->servers[i].has_starter)
+            pthread_join(client->servers[i].starter, NULL);
+    }
+    mcp_reactor_stop(client);
+    for (int i = 0; i < client->n_servers; i++) {
+        mcp_server_stop(client, &client->servers[i]);
+        pthread_mutex_destroy(&client->servers[i].write_lock);
     }
 
+#ifdef NEURONOS_HAS_OPENSSL
+    if (client->tls_ctx)
+        SSL_CTX_free(client->tls_ctx);
+#endif
+    pthread_cond_destroy(&client->cond);
+    pthread_mutex_destroy(&client->lock);
     free(client);
 }
 
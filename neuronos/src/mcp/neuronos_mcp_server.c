@@ -8,7 +8,7 @@
  *   - Cursor, Windsurf, etc.
  *
  * Protocol: JSON-RPC 2.0 over stdin/stdout (newline-delimited)
- * Features: tools/list, tools/call, ping
+ * Features: tools/list, tools/call (concurrent, cancellable), ping
  *
  * First MCP server written in pure C.
  *
@@ -22,35 +22,139 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef _WIN32
+#include <windows.h>
+typedef HANDLE mcps_thread_t;
+typedef SRWLOCK mcps_mutex_t;
+typedef CONDITION_VARIABLE mcps_cond_t;
+#define mcps_mutex_init(m) InitializeSRWLock(m)
+#define mcps_mutex_destroy(m) ((void)(m))
+#define mcps_mutex_lock(m) AcquireSRWLockExclusive(m)
+#define mcps_mutex_unlock(m) ReleaseSRWLockExclusive(m)
+#define mcps_cond_init(c) InitializeConditionVariable(c)
+#define mcps_cond_destroy(c) ((void)(c))
+#define mcps_cond_wait(c, m) SleepConditionVariableSRW(c, m, INFINITE, 0)
+#define mcps_cond_signal(c) WakeConditionVariable(c)
+#define mcps_cond_broadcast(c) WakeAllConditionVariable(c)
+#else
+#include <pthread.h>
+typedef pthread_t mcps_thread_t;
+typedef pthread_mutex_t mcps_mutex_t;
+typedef pthread_cond_t mcps_cond_t;
+#define mcps_mutex_init(m) pthread_mutex_init(m, NULL)
+#define mcps_mutex_destroy(m) pthread_mutex_destroy(m)
+#define mcps_mutex_lock(m) pthread_mutex_lock(m)
+#define mcps_mutex_unlock(m) pthread_mutex_unlock(m)
+#define mcps_cond_init(c) pthread_cond_init(c, NULL)
+#define mcps_cond_destroy(c) pthread_cond_destroy(c)
+#define mcps_cond_wait(c, m) pthread_cond_wait(c, m)
+#define mcps_cond_signal(c) pthread_cond_signal(c)
+#define mcps_cond_broadcast(c) pthread_cond_broadcast(c)
+#endif
+
 /* ---- Constants ---- */
-#define MCP_MAX_LINE 131072 /* 128KB max JSON-RPC message */
+#define MCP_MAX_MESSAGE (16 * 1024 * 1024) /* longer requests are rejected */
+#define MCP_WORKERS 4                      /* concurrent tools/call */
 #define MCP_PROTOCOL_VERSION "2025-11-25"
 #define MCP_SERVER_NAME "neuronos"
 #define MCP_SERVER_VERSION NEURONOS_VERSION_STRING
 
 /* JSON helpers provided by neuronos/neuronos_json.h (nj_*) */
 
+/* ============================================================
+ * SERVER STATE
+ *
+ * The reader (the calling thread) parses requests and answers the cheap
+ * ones itself. tools/call goes to a pool of workers, so a slow shell or
+ * http_get call does not hold up ping or other calls; responses carry
+ * their id and may leave out of order. Every frame goes through one
+ * writer thread, so lines on stdout never interleave.
+ * ============================================================ */
+
+/* Outgoing frame */
+typedef struct mcp_frame {
+    char * json;
+    struct mcp_frame * next;
+} mcp_frame_t;
+
+/* A tools/call, queued or running */
+typedef struct mcp_job {
+    int id;
+    char * params;
+    bool running;
+    bool cancelled; /* notifications/cancelled: drop the response */
+    struct mcp_job * next;
+} mcp_job_t;
+
+typedef struct {
+    neuronos_tool_registry_t * tools;
+
+    mcps_mutex_t lock;       /* everything below */
+    mcps_cond_t work_cond;   /* a job was queued, or stopping */
+    mcps_cond_t frame_cond;  /* a frame was queued, or stopping */
+    mcp_frame_t * frames;    /* FIFO */
+    mcp_frame_t * frames_tail;
+    mcp_job_t * jobs;        /* queued and running, oldest first */
+    bool stop_workers;
+    bool stop_writer;
+
+    mcps_mutex_t serial;     /* tools not marked thread_safe run one at a time */
+} mcp_srv_t;
+
+/* Queue a JSON-RPC frame for stdout. Takes ownership of json. */
+static void mcp_send_owned(mcp_srv_t * s, char * json) {
+    mcp_frame_t * f = json ? malloc(sizeof(*f)) : NULL;
+    if (!f) {
+        free(json);
+        return;
+    }
+    f->json = json;
+    f->next = NULL;
+    mcps_mutex_lock(&s->lock);
+    if (s->frames_tail)
+        s->frames_tail->next = f;
+    else
+        s->frames = f;
+    s->frames_tail = f;
+    mcps_cond_signal(&s->frame_cond);
+    mcps_mutex_unlock(&s->lock);
+}
+
 /* Write a JSON-RPC response to stdout (newline-delimited) */
-static void mcp_send(const char * json) {
-    fprintf(stdout, "%s\n", json);
-    fflush(stdout);
+static void mcp_send(mcp_srv_t * s, const char * json) {
+    mcp_send_owned(s, strdup(json));
 }
 
 /* Send a JSON-RPC error response */
-static void mcp_send_error(int id, int code, const char * message) {
-    char buf[4096];
-    if (id >= 0) {
-        snprintf(buf, sizeof(buf),
-                 "{\"jsonrpc\":\"2.0\",\"id\":%d,"
-                 "\"error\":{\"code\":%d,\"message\":\"%s\"}}",
-                 id, code, message);
-    } else {
-        snprintf(buf, sizeof(buf),
-                 "{\"jsonrpc\":\"2.0\",\"id\":null,"
-                 "\"error\":{\"code\":%d,\"message\":\"%s\"}}",
-                 code, message);
-    }
-    mcp_send(buf);
+static void mcp_send_error(mcp_srv_t * s, int id, int code, const char * message) {
+    nj_writer_t w = {0};
+    nj_w_obj(&w);
+    nj_w_key(&w, "jsonrpc");
+    nj_w_str(&w, "2.0");
+    nj_w_key(&w, "id");
+    if (id >= 0)
+        nj_w_int(&w, id);
+    else
+        nj_w_null(&w);
+    nj_w_key(&w, "error");
+    nj_w_obj(&w);
+    nj_w_key(&w, "code");
+    nj_w_int(&w, code);
+    nj_w_key(&w, "message");
+    nj_w_str(&w, message);
+    nj_w_obj_end(&w);
+    nj_w_obj_end(&w);
+    mcp_send_owned(s, nj_w_finish(&w));
+}
+
+/* Start a result frame: {"jsonrpc":"2.0","id":<id>,"result": */
+static void mcp_result_begin(nj_writer_t * w, int id) {
+    nj_w_obj(w);
+    nj_w_key(w, "jsonrpc");
+    nj_w_str(w, "2.0");
+    nj_w_key(w, "id");
+    nj_w_int(w, id);
+    nj_w_key(w, "result");
 }
 
 /* ============================================================
@@ -58,7 +162,7 @@ static void mcp_send_error(int id, int code, const char * message) {
  * ============================================================ */
 
 /* Handle "initialize" — respond with server capabilities */
-static void handle_initialize(int id) {
+static void handle_initialize(mcp_srv_t * s, int id) {
     char buf[4096];
     snprintf(buf, sizeof(buf),
              "{\"jsonrpc\":\"2.0\",\"id\":%d,"
@@ -76,139 +180,320 @@ static void handle_initialize(int id) {
              "}"
              "}}",
              id, MCP_PROTOCOL_VERSION, MCP_SERVER_NAME, MCP_SERVER_VERSION);
-    mcp_send(buf);
+    mcp_send(s, buf);
     fprintf(stderr, "[mcp] Initialized (protocol %s)\n", MCP_PROTOCOL_VERSION);
 }
 
 /* Handle "ping" — respond with empty result */
-static void handle_ping(int id) {
+static void handle_ping(mcp_srv_t * s, int id) {
     char buf[256];
     snprintf(buf, sizeof(buf), "{\"jsonrpc\":\"2.0\",\"id\":%d,\"result\":{}}", id);
-    mcp_send(buf);
+    mcp_send(s, buf);
 }
 
 /* Handle "tools/list" — enumerate all registered tools as MCP tool objects */
-static void handle_tools_list(int id, neuronos_tool_registry_t * tools) {
+static void handle_tools_list(mcp_srv_t * s, int id) {
+    neuronos_tool_registry_t * tools = s->tools;
     if (!tools) {
-        mcp_send_error(id, -32603, "No tool registry available");
+        mcp_send_error(s, id, -32603, "No tool registry available");
         return;
     }
 
     int n = neuronos_tool_count(tools);
 
-    /* Build JSON array of tools */
-    size_t cap = 32768;
-    char * buf = malloc(cap);
-    if (!buf) {
-        mcp_send_error(id, -32603, "Out of memory");
-        return;
-    }
-
-    size_t pos = 0;
-    pos += (size_t)snprintf(buf + pos, cap - pos,
-                            "{\"jsonrpc\":\"2.0\",\"id\":%d,"
-                            "\"result\":{\"tools\":[",
-                            id);
-
+    nj_writer_t w = {0};
+    mcp_result_begin(&w, id);
+    nj_w_obj(&w);
+    nj_w_key(&w, "tools");
+    nj_w_arr(&w);
     for (int i = 0; i < n; i++) {
-        /* Access tool descriptor details */
         const char * name = neuronos_tool_name(tools, i);
         const char * desc = neuronos_tool_description(tools, i);
         const char * schema = neuronos_tool_schema(tools, i);
 
-        if (i > 0)
-            buf[pos++] = ',';
-
-        char * esc_desc = nj_escape(desc ? desc : "");
-
         /* Tool object: name, description, inputSchema */
-        pos += (size_t)snprintf(buf + pos, cap - pos,
-                                "{\"name\":\"%s\","
-                                "\"description\":\"%s\","
-                                "\"inputSchema\":%s}",
-                                name ? name : "unknown", esc_desc ? esc_desc : "",
-                                (schema && schema[0] == '{') ? schema
-                                                             : "{\"type\":\"object\",\"additionalProperties\":false}");
-
-        free(esc_desc);
-
-        /* Grow buffer if needed */
-        if (pos > cap - 4096) {
-            cap *= 2;
-            char * newbuf = realloc(buf, cap);
-            if (!newbuf) {
-                free(buf);
-                mcp_send_error(id, -32603, "Out of memory");
-                return;
-            }
-            buf = newbuf;
-        }
+        nj_w_obj(&w);
+        nj_w_key(&w, "name");
+        nj_w_str(&w, name ? name : "unknown");
+        nj_w_key(&w, "description");
+        nj_w_str(&w, desc ? desc : "");
+        nj_w_key(&w, "inputSchema");
+        nj_w_raw(&w, (schema && schema[0] == '{') ? schema : "{\"type\":\"object\",\"additionalProperties\":false}");
+        nj_w_obj_end(&w);
     }
+    nj_w_arr_end(&w);
+    nj_w_obj_end(&w);
+    nj_w_obj_end(&w);
 
-    pos += (size_t)snprintf(buf + pos, cap - pos, "]}}");
-    mcp_send(buf);
-    free(buf);
+    char * json = nj_w_finish(&w);
+    if (!json) {
+        mcp_send_error(s, id, -32603, "Out of memory");
+        return;
+    }
+    mcp_send_owned(s, json);
 
     fprintf(stderr, "[mcp] tools/list → %d tools\n", n);
 }
 
-/* Handle "tools/call" — execute a tool and return result */
-static void handle_tools_call(int id, const char * params, neuronos_tool_registry_t * tools) {
+/* Handle "tools/call" — execute a tool and return result.
+ * Runs on a worker; the reply is dropped if the call was cancelled. */
+static void handle_tools_call(mcp_srv_t * s, mcp_job_t * job) {
+    int id = job->id;
+    const char * params = job->params;
+    neuronos_tool_registry_t * tools = s->tools;
     if (!tools || !params) {
-        mcp_send_error(id, -32602, "Missing params or tool registry");
+        mcp_send_error(s, id, -32602, "Missing params or tool registry");
         return;
     }
 
     /* Extract tool name */
-    int name_len = 0;
-    const char * name_ptr = nj_find_str(params, "name", &name_len);
-    if (!name_ptr || name_len <= 0) {
-        mcp_send_error(id, -32602, "Missing 'name' in params");
+    nj_doc_t doc;
+    nj_parse(&doc, params, strlen(params));
+    char tool_name[256] = {0};
+    if (nj_str_copy(&doc, nj_get(&doc, 0, "name"), tool_name, sizeof(tool_name)) <= 0) {
+        nj_doc_free(&doc);
+        mcp_send_error(s, id, -32602, "Missing 'name' in params");
         return;
     }
 
-    char tool_name[256] = {0};
-    if (name_len >= (int)sizeof(tool_name))
-        name_len = (int)sizeof(tool_name) - 1;
-    memcpy(tool_name, name_ptr, (size_t)name_len);
-
     /* Extract arguments object */
-    char * args = nj_extract_object(params, "arguments");
+    int args_node = nj_get(&doc, 0, "arguments");
+    char * args = nj_type(&doc, args_node) == NJ_OBJECT ? nj_raw_dup(&doc, args_node) : NULL;
     const char * args_str = args ? args : "{}";
+    nj_doc_free(&doc);
 
     fprintf(stderr, "[mcp] tools/call → %s(%s)\n", tool_name, args_str);
 
     /* Execute the tool */
+    bool serial = !neuronos_tool_thread_safe(tools, tool_name);
+    if (serial)
+        mcps_mutex_lock(&s->serial);
     neuronos_tool_result_t result = neuronos_tool_execute(tools, tool_name, args_str);
+    if (serial)
+        mcps_mutex_unlock(&s->serial);
+    free(args);
 
-    /* Build response */
-    size_t cap = 65536;
-    char * buf = malloc(cap);
-    if (!buf) {
-        free(args);
+    mcps_mutex_lock(&s->lock);
+    bool cancelled = job->cancelled;
+    mcps_mutex_unlock(&s->lock);
+    if (cancelled) {
+        fprintf(stderr, "[mcp] tools/call → %s: cancelled\n", tool_name);
         neuronos_tool_result_free(&result);
-        mcp_send_error(id, -32603, "Out of memory");
         return;
     }
 
-    char * esc_output = nj_escape(result.success ? result.output : result.error);
+    nj_writer_t w = {0};
+    mcp_result_begin(&w, id);
+    nj_w_obj(&w);
+    nj_w_key(&w, "content");
+    nj_w_arr(&w);
+    nj_w_obj(&w);
+    nj_w_key(&w, "type");
+    nj_w_str(&w, "text");
+    nj_w_key(&w, "text");
+    nj_w_str(&w, result.success ? result.output : result.error);
+    nj_w_obj_end(&w);
+    nj_w_arr_end(&w);
+    nj_w_key(&w, "isError");
+    nj_w_bool(&w, !result.success);
+    nj_w_obj_end(&w);
+    nj_w_obj_end(&w);
+
+    char * json = nj_w_finish(&w);
+    if (json)
+        mcp_send_owned(s, json);
+    else
+        mcp_send_error(s, id, -32603, "Out of memory");
+
+    bool ok = result.success;
+    neuronos_tool_result_free(&result);
 
-    snprintf(buf, cap,
-             "{\"jsonrpc\":\"2.0\",\"id\":%d,"
-             "\"result\":{"
-             "\"content\":[{\"type\":\"text\",\"text\":\"%s\"}],"
-             "\"isError\":%s"
-             "}}",
-             id, esc_output ? esc_output : "null", result.success ? "false" : "true");
+    fprintf(stderr, "[mcp] tools/call → %s: %s\n", tool_name, ok ? "OK" : "ERROR");
+}
+
+/* ============================================================
+ * WORKERS & WRITER
+ * ============================================================ */
 
-    mcp_send(buf);
+static void mcp_job_free(mcp_job_t * job) {
+    free(job->params);
+    free(job);
+}
 
-    free(esc_output);
-    free(buf);
-    free(args);
-    neuronos_tool_result_free(&result);
+/* Take the oldest queued job, or NULL once stopping with nothing queued */
+static mcp_job_t * mcp_job_next(mcp_srv_t * s) {
+    mcps_mutex_lock(&s->lock);
+    for (;;) {
+        for (mcp_job_t * j = s->jobs; j; j = j->next) {
+            if (!j->running) {
+                j->running = true;
+                mcps_mutex_unlock(&s->lock);
+                return j;
+            }
+        }
+        if (s->stop_workers)
+            break;
+        mcps_cond_wait(&s->work_cond, &s->lock);
+    }
+    mcps_mutex_unlock(&s->lock);
+    return NULL;
+}
+
+static void mcp_job_done(mcp_srv_t * s, mcp_job_t * job) {
+    mcps_mutex_lock(&s->lock);
+    for (mcp_job_t ** pp = &s->jobs; *pp; pp = &(*pp)->next) {
+        if (*pp == job) {
+            *pp = job->next;
+            break;
+        }
+    }
+    mcps_mutex_unlock(&s->lock);
+    mcp_job_free(job);
+}
+
+static void mcp_worker_run(mcp_srv_t * s) {
+    mcp_job_t * job;
+    while ((job = mcp_job_next(s)) != NULL) {
+        handle_tools_call(s, job);
+        mcp_job_done(s, job);
+    }
+}
 
-    fprintf(stderr, "[mcp] tools/call → %s: %s\n", tool_name, result.success ? "OK" : "ERROR");
+static void mcp_writer_run(mcp_srv_t * s) {
+    mcps_mutex_lock(&s->lock);
+    for (;;) {
+        mcp_frame_t * f = s->frames;
+        if (!f) {
+            if (s->stop_writer)
+                break;
+            mcps_cond_wait(&s->frame_cond, &s->lock);
+            continue;
+        }
+        s->frames = f->next;
+        if (!s->frames)
+            s->frames_tail = NULL;
+        mcps_mutex_unlock(&s->lock);
+
+        fputs(f->json, stdout);
+        fputc('\n', stdout);
+        fflush(stdout);
+        free(f->json);
+        free(f);
+
+        mcps_mutex_lock(&s->lock);
+    }
+    mcps_mutex_unlock(&s->lock);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI mcp_worker_main(LPVOID arg) {
+    mcp_worker_run((mcp_srv_t *)arg);
+    return 0;
+}
+static DWORD WINAPI mcp_writer_main(LPVOID arg) {
+    mcp_writer_run((mcp_srv_t *)arg);
+    return 0;
+}
+#else
+static void * mcp_worker_main(void * arg) {
+    mcp_worker_run((mcp_srv_t *)arg);
+    return NULL;
+}
+static void * mcp_writer_main(void * arg) {
+    mcp_writer_run((mcp_srv_t *)arg);
+    return NULL;
+}
+#endif
+
+static bool mcp_thread_start(mcps_thread_t * t, bool writer, mcp_srv_t * s) {
+#ifdef _WIN32
+    *t = CreateThread(NULL, 0, writer ? mcp_writer_main : mcp_worker_main, s, 0, NULL);
+    return *t != NULL;
+#else
+    return pthread_create(t, NULL, writer ? mcp_writer_main : mcp_worker_main, s) == 0;
+#endif
+}
+
+static void mcp_thread_join(mcps_thread_t t) {
+#ifdef _WIN32
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+#else
+    pthread_join(t, NULL);
+#endif
+}
+
+/* Queue a tools/call. Takes ownership of params. */
+static void mcp_job_submit(mcp_srv_t * s, int id, char * params) {
+    mcp_job_t * job = calloc(1, sizeof(*job));
+    if (!job) {
+        free(params);
+        mcp_send_error(s, id, -32603, "Out of memory");
+        return;
+    }
+    job->id = id;
+    job->params = params;
+
+    mcps_mutex_lock(&s->lock);
+    mcp_job_t ** pp = &s->jobs;
+    while (*pp)
+        pp = &(*pp)->next;
+    *pp = job;
+    mcps_cond_signal(&s->work_cond);
+    mcps_mutex_unlock(&s->lock);
+}
+
+/* notifications/cancelled: forget a queued call, or mute a running one */
+static void mcp_job_cancel(mcp_srv_t * s, int id) {
+    mcp_job_t * dropped = NULL;
+    mcps_mutex_lock(&s->lock);
+    for (mcp_job_t ** pp = &s->jobs; *pp; pp = &(*pp)->next) {
+        mcp_job_t * j = *pp;
+        if (j->id != id)
+            continue;
+        if (j->running) {
+            j->cancelled = true;
+        } else {
+            *pp = j->next;
+            dropped = j;
+        }
+        break;
+    }
+    mcps_mutex_unlock(&s->lock);
+    if (dropped)
+        mcp_job_free(dropped);
+    fprintf(stderr, "[mcp] Cancellation received for request %d%s\n", id, dropped ? " (dropped)" : "");
+}
+
+/* Read one line from stdin, growing the buffer as needed.
+ * Returns the length, 0 for a line over MCP_MAX_MESSAGE (consumed and
+ * discarded), -1 on EOF. */
+static long mcp_read_line(char ** line, size_t * cap) {
+    size_t len = 0;
+    bool oversized = false;
+    for (;;) {
+        if (*cap - len < 2) {
+            if (*cap >= MCP_MAX_MESSAGE) {
+                oversized = true; /* keep reading into the same buffer */
+                len = 0;
+            } else {
+                size_t ncap = *cap ? *cap * 2 : 4096;
+                char * nl = realloc(*line, ncap);
+                if (!nl)
+                    return -1;
+                *line = nl;
+                *cap = ncap;
+            }
+        }
+        if (!fgets(*line + len, (int)(*cap - len), stdin))
+            break;
+        len += strlen(*line + len);
+        if (len > 0 && (*line)[len - 1] == '\n')
+            break;
+    }
+    if (oversized)
+        return 0;
+    return len > 0 ? (long)len : -1;
 }
 
 /* ============================================================
@@ -228,45 +513,69 @@ neuronos_status_t neuronos_mcp_serve_stdio(neuronos_tool_registry_t * tools) {
             "[mcp] Waiting for JSON-RPC messages on stdin...\n",
             MCP_SERVER_VERSION, MCP_PROTOCOL_VERSION, neuronos_tool_count(tools));
 
-    char * line = malloc(MCP_MAX_LINE);
-    if (!line)
-        return NEURONOS_ERROR_MEMORY;
-
+    mcp_srv_t srv = {.tools = tools};
+    mcp_srv_t * s = &srv;
+    mcps_mutex_init(&s->lock);
+    mcps_mutex_init(&s->serial);
+    mcps_cond_init(&s->work_cond);
+    mcps_cond_init(&s->frame_cond);
+
+    mcps_thread_t writer;
+    if (!mcp_thread_start(&writer, true, s)) {
+        mcps_cond_destroy(&s->frame_cond);
+        mcps_cond_destroy(&s->work_cond);
+        mcps_mutex_destroy(&s->serial);
+        mcps_mutex_destroy(&s->lock);
+        return NEURONOS_ERROR_INIT;
+    }
+    mcps_thread_t workers[MCP_WORKERS];
+    int n_workers = 0;
+    while (n_workers < MCP_WORKERS && mcp_thread_start(&workers[n_workers], false, s))
+        n_workers++;
+
+    char * line = NULL;
+    size_t line_cap = 0;
+    long got;
     bool initialized = false;
 
-    while (fgets(line, MCP_MAX_LINE, stdin)) {
+    while ((got = mcp_read_line(&line, &line_cap)) >= 0) {
+        if (got == 0) {
+            mcp_send_error(s, -1, -32600, "Invalid Request: message too large");
+            continue;
+        }
+
         /* Strip trailing newline */
-        size_t len = strlen(line);
+        size_t len = (size_t)got;
         while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
             line[--len] = '\0';
 
         if (len == 0)
             continue; /* skip empty lines */
 
-        /* Parse JSON-RPC envelope: extract method and id */
-        int msg_id = nj_find_int(line, "id", -1);
-
-        int method_len = 0;
-        const char * method_ptr = nj_find_str(line, "method", &method_len);
+        /* Parse JSON-RPC envelope once: method, id, params */
+        nj_doc_t doc;
+        if (nj_parse(&doc, line, len) < 0) {
+            mcp_send_error(s, -1, -32700, "Parse error");
+            continue;
+        }
+        int msg_id = (int)nj_int(&doc, nj_get(&doc, 0, "id"), -1);
 
-        if (!method_ptr) {
+        char method[256] = {0};
+        if (nj_str_copy(&doc, nj_get(&doc, 0, "method"), method, sizeof(method)) < 0) {
             /* Might be a response or notification — ignore for now */
             if (msg_id >= 0) {
                 /* Unknown request without method */
-                mcp_send_error(msg_id, -32600, "Invalid Request: missing method");
+                mcp_send_error(s, msg_id, -32600, "Invalid Request: missing method");
             }
+            nj_doc_free(&doc);
             continue;
         }
-
-        char method[256] = {0};
-        if (method_len >= (int)sizeof(method))
-            method_len = (int)sizeof(method) - 1;
-        memcpy(method, method_ptr, (size_t)method_len);
+        int params_node = nj_get(&doc, 0, "params");
 
         /* ---- Dispatch ---- */
 
         if (strcmp(method, "initialize") == 0) {
-            handle_initialize(msg_id);
+            handle_initialize(s, msg_id);
             initialized = true;
 
         } else if (strcmp(method, "notifications/initialized") == 0) {
@@ -274,38 +583,62 @@ neuronos_status_t neuronos_mcp_serve_stdio(neuronos_tool_registry_t * tools) {
             fprintf(stderr, "[mcp] Client initialized, ready for operations\n");
 
         } else if (strcmp(method, "ping") == 0) {
-            handle_ping(msg_id);
+            handle_ping(s, msg_id);
 
         } else if (strcmp(method, "tools/list") == 0) {
-            if (!initialized) {
-                mcp_send_error(msg_id, -32002, "Server not initialized");
-                continue;
-            }
-            handle_tools_list(msg_id, tools);
+            if (!initialized)
+                mcp_send_error(s, msg_id, -32002, "Server not initialized");
+            else
+                handle_tools_list(s, msg_id);
 
         } else if (strcmp(method, "tools/call") == 0) {
+            char * params = nj_type(&doc, params_node) == NJ_OBJECT ? nj_raw_dup(&doc, params_node) : NULL;
             if (!initialized) {
-                mcp_send_error(msg_id, -32002, "Server not initialized");
-                continue;
+                mcp_send_error(s, msg_id, -32002, "Server not initialized");
+                free(params);
+            } else if (n_workers > 0) {
+                mcp_job_submit(s, msg_id, params);
+            } else {
+                mcp_job_t job = {.id = msg_id, .params = params};
+                handle_tools_call(s, &job);
+                free(params);
             }
-            char * params = nj_extract_object(line, "params");
-            handle_tools_call(msg_id, params, tools);
-            free(params);
 
         } else if (strcmp(method, "notifications/cancelled") == 0) {
-            /* Cancellation notification — log and ignore */
-            fprintf(stderr, "[mcp] Cancellation received\n");
+            int req_id = (int)nj_int(&doc, nj_get(&doc, params_node, "requestId"), -1);
+            if (req_id >= 0)
+                mcp_job_cancel(s, req_id);
 
         } else {
             /* Unknown method */
             if (msg_id >= 0)
-                mcp_send_error(msg_id, -32601, "Method not found");
+                mcp_send_error(s, msg_id, -32601, "Method not found");
             else
                 fprintf(stderr, "[mcp] Unknown notification: %s\n", method);
         }
+        nj_doc_free(&doc);
     }
 
     free(line);
     fprintf(stderr, "[mcp] STDIO stream closed, shutting down\n");
+
+    /* Answer what was already asked, then flush the writer */
+    mcps_mutex_lock(&s->lock);
+    s->stop_workers = true;
+    mcps_cond_broadcast(&s->work_cond);
+    mcps_mutex_unlock(&s->lock);
+    for (int i = 0; i < n_workers; i++)
+        mcp_thread_join(workers[i]);
+
+    mcps_mutex_lock(&s->lock);
+    s->stop_writer = true;
+    mcps_cond_signal(&s->frame_cond);
+    mcps_mutex_unlock(&s->lock);
+    mcp_thread_join(writer);
+
+    mcps_cond_destroy(&s->frame_cond);
+    mcps_cond_destroy(&s->work_cond);
+    mcps_mutex_destroy(&s->serial);
+    mcps_mutex_destroy(&s->lock);
     return NEURONOS_OK;
 }
@@ -6,7 +6,10 @@
  *  2. Recall Memory — full conversation history
  *  3. Archival Memory — long-term facts (FTS5 searchable)
  *
- * Dependencies: SQLite 3 (amalgamation), FTS5 extension
+ * With an embedder attached, recall and archival rows also get
+ * sqlite-vec embeddings and search fuses both rankings.
+ *
+ * Dependencies: SQLite 3 (amalgamation), FTS5 extension, sqlite-vec
  * No runtime dependencies beyond libc.
  *
  * Copyright (c) 2025 NeuronOS Project
@@ -14,6 +17,7 @@
  * ============================================================ */
 #include "neuronos/neuronos.h"
 
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -24,62 +28,338 @@
 #include <direct.h>   /* _mkdir */
 #include <windows.h>
 #define neuronos_mkdir(path) _mkdir(path)
+typedef HANDLE mem_thread_t;
+typedef SRWLOCK mem_mutex_t;
+typedef CONDITION_VARIABLE mem_cond_t;
+#define mem_mutex_init(m) InitializeSRWLock(m)
+#define mem_mutex_destroy(m) ((void)(m))
+#define mem_mutex_lock(m) AcquireSRWLockExclusive(m)
+#define mem_mutex_unlock(m) ReleaseSRWLockExclusive(m)
+#define mem_cond_init(c) InitializeConditionVariable(c)
+#define mem_cond_destroy(c) ((void)(c))
+#define mem_cond_wait(c, m) SleepConditionVariableSRW(c, m, INFINITE, 0)
+#define mem_cond_signal(c) WakeConditionVariable(c)
+#define mem_cond_broadcast(c) WakeAllConditionVariable(c)
+#define mem_atomic_load(p) InterlockedCompareExchange64((volatile LONG64 *)(p), 0, 0)
+#define mem_atomic_store(p, v) ((void)InterlockedExchange64((volatile LONG64 *)(p), (v)))
+#define mem_atomic_xchg(p, v) InterlockedExchange64((volatile LONG64 *)(p), (v))
+#define mem_atomic_cas(p, old, v) (InterlockedCompareExchange64((volatile LONG64 *)(p), (v), (old)) == (old))
+#define mem_atomic_inc(p) ((void)InterlockedIncrement64((volatile LONG64 *)(p)))
 #else
+#include <pthread.h>
 #include <unistd.h>
 #define neuronos_mkdir(path) mkdir(path, 0755)
+typedef pthread_t mem_thread_t;
+typedef pthread_mutex_t mem_mutex_t;
+typedef pthread_cond_t mem_cond_t;
+#define mem_mutex_init(m) pthread_mutex_init(m, NULL)
+#define mem_mutex_destroy(m) pthread_mutex_destroy(m)
+#define mem_mutex_lock(m) pthread_mutex_lock(m)
+#define mem_mutex_unlock(m) pthread_mutex_unlock(m)
+#define mem_cond_init(c) pthread_cond_init(c, NULL)
+#define mem_cond_destroy(c) pthread_cond_destroy(c)
+#define mem_cond_wait(c, m) pthread_cond_wait(c, m)
+#define mem_cond_signal(c) pthread_cond_signal(c)
+#define mem_cond_broadcast(c) pthread_cond_broadcast(c)
+#define mem_atomic_load(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define mem_atomic_store(p, v) __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define mem_atomic_xchg(p, v) __atomic_exchange_n((p), (v), __ATOMIC_SEQ_CST)
+#define mem_atomic_cas(p, old, v) \
+    __atomic_compare_exchange_n((p), &(int64_t){(old)}, (v), false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+#define mem_atomic_inc(p) ((void)__atomic_add_fetch((p), 1, __ATOMIC_SEQ_CST))
 #endif
 
 /* SQLite amalgamation (compiled with -DSQLITE_CORE -DSQLITE_ENABLE_FTS5) */
 #include "sqlite3.h"
+#include "sqlite-vec.h"
+
+/* ---- Constants ---- */
+#define EMBED_BATCH   16   /* rows per embedder call */
+#define EMBED_MAX_DIM 8192 /* vec0 column limit */
+#define RRF_K         60   /* reciprocal rank fusion: 1 / (RRF_K + rank) */
+#define HYBRID_POOL   4    /* candidates per ranking = max_results * HYBRID_POOL */
+#define WB_MAX_QUEUE  65536 /* write-behind queue capacity limit */
+#define WB_ID_BLOCK   64    /* recall row ids reserved per sqlite_sequence bump */
+
+/* embed_queue.kind */
+#define EMBED_ARCHIVAL 0
+#define EMBED_RECALL   1
+
+/* ---- Cached statements ----
+ * Prepared once at open (vector queries on first use, since their
+ * tables only exist with an embedder) and reset + re-bound per call. */
+typedef enum {
+    STMT_CORE_SET,
+    STMT_CORE_GET,
+    STMT_CORE_DUMP,
+    STMT_RECALL_INSERT,
+    STMT_RECALL_RECENT,
+    STMT_RECALL_SEARCH,
+    STMT_RECALL_STATS,
+    STMT_RECALL_GC_AGE,
+    STMT_RECALL_GC_TRIM,
+    STMT_RECALL_BY_ID,
+    STMT_RECALL_FTS_IDS,
+    STMT_ARCHIVAL_FIND,
+    STMT_ARCHIVAL_UPDATE,
+    STMT_ARCHIVAL_INSERT,
+    STMT_ARCHIVAL_TOUCH,
+    STMT_ARCHIVAL_GET,
+    STMT_ARCHIVAL_SEARCH,
+    STMT_ARCHIVAL_STATS,
+    STMT_ARCHIVAL_BY_ID,
+    STMT_ARCHIVAL_FTS_IDS,
+    STMT_SESSION_CREATE,
+    STMT_EAGER_COUNT, /* statements below are prepared on first use */
+    STMT_ARCHIVAL_KNN = STMT_EAGER_COUNT,
+    STMT_RECALL_KNN,
+    STMT_RECALL_RESERVE,
+    STMT_COUNT,
+} mem_stmt_id_t;
+
+#define RECALL_COLS   "id, role, content, timestamp, token_count, session_id, summary_of"
+#define ARCHIVAL_COLS "id, key, value, category, importance, created_at, updated_at, access_count"
+
+static const char * const MEM_STMT_SQL[STMT_COUNT] = {
+    [STMT_CORE_SET] =
+        "INSERT INTO core_blocks(label, content, updated_at) VALUES(?1, ?2, strftime('%s','now')) "
+        "ON CONFLICT(label) DO UPDATE SET content=?2, updated_at=strftime('%s','now');",
+    [STMT_CORE_GET] = "SELECT content FROM core_blocks WHERE label = ?1;",
+    [STMT_CORE_DUMP] = "SELECT label, content FROM core_blocks ORDER BY label;",
+    [STMT_RECALL_INSERT] =
+        "INSERT INTO recall_memory(id, session_id, role, content, token_count, summary_of) "
+        "VALUES(?6, ?1, ?2, ?3, ?4, ?5);", /* ?6 NULL = next AUTOINCREMENT id */
+    [STMT_RECALL_RECENT] =
+        "SELECT " RECALL_COLS " FROM recall_memory WHERE session_id=?1 "
+        "ORDER BY timestamp DESC LIMIT ?2;",
+    [STMT_RECALL_SEARCH] =
+        "SELECT r.id, r.role, r.content, r.timestamp, r.token_count, r.session_id, r.summary_of "
+        "FROM recall_fts f "
+        "JOIN recall_memory r ON f.rowid = r.id "
+        "WHERE recall_fts MATCH ?1 "
+        "ORDER BY rank LIMIT ?2;",
+    [STMT_RECALL_STATS] =
+        "SELECT COUNT(*), COALESCE(SUM(token_count), 0) "
+        "FROM recall_memory WHERE session_id=?1;",
+    [STMT_RECALL_GC_AGE] =
+        "DELETE FROM recall_memory "
+        "WHERE session_id=?1 AND timestamp < (strftime('%s','now') - ?2);",
+    [STMT_RECALL_GC_TRIM] =
+        "DELETE FROM recall_memory "
+        "WHERE session_id=?1 AND id NOT IN ("
+        "  SELECT id FROM recall_memory WHERE session_id=?1 "
+        "  ORDER BY timestamp DESC LIMIT ?2"
+        ");",
+    [STMT_RECALL_BY_ID] = "SELECT " RECALL_COLS " FROM recall_memory WHERE id = ?1;",
+    [STMT_RECALL_FTS_IDS] = "SELECT rowid FROM recall_fts WHERE recall_fts MATCH ?1 ORDER BY rank LIMIT ?2;",
+    [STMT_ARCHIVAL_FIND] = "SELECT id FROM archival_memory WHERE key=?1 LIMIT 1;",
+    [STMT_ARCHIVAL_UPDATE] =
+        "UPDATE archival_memory SET value=?1, category=?2, importance=?3, "
+        "updated_at=strftime('%s','now') WHERE id=?4;",
+    [STMT_ARCHIVAL_INSERT] =
+        "INSERT INTO archival_memory(key, value, category, importance) "
+        "VALUES(?1, ?2, ?3, ?4);",
+    [STMT_ARCHIVAL_TOUCH] = "UPDATE archival_memory SET access_count = access_count + ?2 WHERE key=?1;",
+    [STMT_ARCHIVAL_GET] = "SELECT value FROM archival_memory WHERE key=?1 LIMIT 1;",
+    [STMT_ARCHIVAL_SEARCH] =
+        "SELECT a.id, a.key, a.value, a.category, a.importance, "
+        "       a.created_at, a.updated_at, a.access_count "
+        "FROM archival_fts f "
+        "JOIN archival_memory a ON f.rowid = a.id "
+        "WHERE archival_fts MATCH ?1 "
+        "ORDER BY rank LIMIT ?2;",
+    [STMT_ARCHIVAL_STATS] = "SELECT COUNT(*) FROM archival_memory;",
+    [STMT_ARCHIVAL_BY_ID] = "SELECT " ARCHIVAL_COLS " FROM archival_memory WHERE id = ?1;",
+    [STMT_ARCHIVAL_FTS_IDS] =
+        "SELECT rowid FROM archival_fts WHERE archival_fts MATCH ?1 ORDER BY rank LIMIT ?2;",
+    [STMT_SESSION_CREATE] = "INSERT INTO sessions(title) VALUES('');",
+    [STMT_ARCHIVAL_KNN] =
+        "SELECT rowid FROM archival_vec WHERE embedding MATCH ?1 AND k = ?2 ORDER BY distance;",
+    [STMT_RECALL_KNN] =
+        "SELECT rowid FROM recall_vec WHERE embedding MATCH ?1 AND k = ?2 ORDER BY distance;",
+    [STMT_RECALL_RESERVE] =
+        "UPDATE sqlite_sequence SET seq = seq + ?1 WHERE name = 'recall_memory' RETURNING seq;",
+};
+
+/* ---- Write-behind queue ----
+ * Bounded lock-free MPSC ring (per-cell sequence numbers): any thread
+ * claims a cell with a CAS on wb_enq, only the writer thread pops. */
+typedef enum {
+    WB_RECALL_INSERT,
+    WB_RECALL_GC,
+    WB_ARCHIVAL_TOUCH,
+} wb_kind_t;
+
+typedef struct {
+    wb_kind_t kind;
+    int64_t session_id;   /* RECALL_* */
+    int64_t summary_of;   /* RECALL_INSERT */
+    int64_t id;           /* RECALL_INSERT reserved row id (0 = none) */
+    char * role;          /* RECALL_INSERT */
+    char * text;          /* RECALL_INSERT content, ARCHIVAL_TOUCH key */
+    int n1;               /* RECALL_INSERT token_count, RECALL_GC max_messages */
+    int n2;               /* RECALL_GC max_age_seconds */
+} wb_op_t;
+
+typedef struct {
+    volatile int64_t seq; /* == pos: free for pos, == pos + 1: holds pos */
+    wb_op_t op;
+} wb_cell_t;
 
 /* ---- Internal struct ---- */
 struct neuronos_memory {
     sqlite3 * db;
     int64_t current_session_id;
+    char * path;                  /* resolved DB path, for the worker's connection */
+
+    /* Cached statements on db. A statement is used by one caller at a
+     * time: stmt_lock is held from stmt_acquire() to stmt_release(). */
+    sqlite3_stmt * stmts[STMT_COUNT];
+    mem_mutex_t stmt_lock;
+    int txn_depth;                /* neuronos_memory_begin() nesting */
+    volatile int64_t core_gen;    /* bumped by every core memory write */
+
+    /* Embeddings (neuronos_memory_set_embedder) */
+    neuronos_embed_fn embed;
+    void * embed_data;
+    int embed_dim;
+    mem_mutex_t embed_lock;       /* one embedder call at a time */
+    mem_mutex_t worker_lock;      /* guards worker_kick / worker_stop */
+    mem_cond_t worker_cond;
+    bool worker_kick;
+    bool worker_stop;
+    bool worker_running;
+    mem_thread_t worker;
+
+    /* Write-behind (neuronos_memory_set_write_behind) */
+    wb_cell_t * wb_cells;
+    int64_t wb_mask;              /* capacity - 1 (capacity is a power of 2) */
+    volatile int64_t wb_enq;      /* next position to claim */
+    int64_t wb_deq;               /* next position to pop (writer only) */
+    volatile int64_t wb_done;     /* positions below this are committed */
+    volatile int64_t wb_idle;     /* writer is asleep: wake it on push */
+    sqlite3 * wb_db;              /* writer's own connection */
+    sqlite3_stmt * wb_stmts[STMT_COUNT];
+    wb_op_t * wb_batch;           /* popped ops of the batch being written */
+    mem_mutex_t wb_lock;          /* guards wb_stop and the condition waits */
+    mem_cond_t wb_cond;           /* wakes the writer */
+    mem_cond_t wb_done_cond;      /* wakes flushers and producers of a full queue */
+    int64_t wb_id_next;           /* reserved recall ids [wb_id_next, wb_id_end), */
+    int64_t wb_id_end;            /* guarded by stmt_lock */
+    bool wb_stop;
+    bool wb_running;
+    mem_thread_t wb_thread;
 };
 
 /* ---- Forward declarations ---- */
 static int  memory_create_schema(sqlite3 * db);
 static char * memory_resolve_path(const char * db_path);
+static void embed_worker_stop(neuronos_memory_t * mem);
+static void embed_kick(neuronos_memory_t * mem);
+static bool wb_push(neuronos_memory_t * mem, wb_op_t * op);
+static void wb_sync(neuronos_memory_t * mem);
+static void wb_stop(neuronos_memory_t * mem);
+static int  recall_search_hybrid(neuronos_memory_t * mem, const char * query, int max_results,
+                                 neuronos_recall_entry_t ** out_entries, int * out_count);
+static int  archival_search_hybrid(neuronos_memory_t * mem, const char * query, int max_results,
+                                   neuronos_archival_entry_t ** out_entries, int * out_count);
+
+/* SQLite reports each statement's run time; record it per SQL verb */
+static int memory_profile_cb(unsigned type, void * ctx, void * p, void * x) {
+    (void)ctx;
+    if (type != SQLITE_TRACE_PROFILE) return 0;
+    const char * sql = sqlite3_sql((sqlite3_stmt *)p);
+    char verb[16] = "other";
+    if (sql) {
+        while (isspace((unsigned char)*sql)) sql++;
+        size_t n = 0;
+        while (n < sizeof(verb) - 1 && isalpha((unsigned char)sql[n])) {
+            verb[n] = (char)tolower((unsigned char)sql[n]);
+            n++;
+        }
+        if (n > 0) verb[n] = '\0';
+    }
+    neuronos_metrics_record_label(NEURONOS_METRIC_MEMORY, verb, (double)*(sqlite3_int64 *)x / 1e6);
+    return 0;
+}
 
 /* ============================================================
  * OPEN / CLOSE
  * ============================================================ */
 
+/* Open a connection with sqlite-vec registered and the edge pragmas set */
+static sqlite3 * memory_db_open(const char * path) {
+    sqlite3 * db = NULL;
+    if (sqlite3_open(path, &db) != SQLITE_OK) {
+        fprintf(stderr, "[neuronos-memory] Failed to open DB: %s\n",
+                sqlite3_errmsg(db));
+        sqlite3_close(db);
+        return NULL;
+    }
+
+    sqlite3_vec_init(db, NULL, NULL);
+    sqlite3_trace_v2(db, SQLITE_TRACE_PROFILE, memory_profile_cb, NULL);
+
+    /* Performance pragmas for edge devices */
+    sqlite3_exec(db, "PRAGMA journal_mode=WAL;", NULL, NULL, NULL);
+    sqlite3_exec(db, "PRAGMA synchronous=NORMAL;", NULL, NULL, NULL);
+    sqlite3_exec(db, "PRAGMA busy_timeout=5000;", NULL, NULL, NULL);
+    return db;
+}
+
+static void memory_finalize_all(neuronos_memory_t * mem) {
+    for (int i = 0; i < STMT_COUNT; i++) {
+        sqlite3_finalize(mem->stmts[i]);
+        mem->stmts[i] = NULL;
+    }
+}
+
 neuronos_memory_t * neuronos_memory_open(const char * db_path) {
     neuronos_memory_t * mem = calloc(1, sizeof(neuronos_memory_t));
     if (!mem) return NULL;
 
-    char * resolved = memory_resolve_path(db_path);
-    if (!resolved) {
+    mem->path = memory_resolve_path(db_path);
+    if (!mem->path) {
         free(mem);
         return NULL;
     }
 
-    int rc = sqlite3_open(resolved, &mem->db);
-    free(resolved);
-
-    if (rc != SQLITE_OK) {
-        fprintf(stderr, "[neuronos-memory] Failed to open DB: %s\n",
-                sqlite3_errmsg(mem->db));
-        sqlite3_close(mem->db);
+    mem->db = memory_db_open(mem->path);
+    if (!mem->db) {
+        free(mem->path);
         free(mem);
         return NULL;
     }
 
-    /* Performance pragmas for edge devices */
-    sqlite3_exec(mem->db, "PRAGMA journal_mode=WAL;", NULL, NULL, NULL);
-    sqlite3_exec(mem->db, "PRAGMA synchronous=NORMAL;", NULL, NULL, NULL);
-    sqlite3_exec(mem->db, "PRAGMA busy_timeout=5000;", NULL, NULL, NULL);
-
     /* Create schema if needed */
     if (memory_create_schema(mem->db) != 0) {
         fprintf(stderr, "[neuronos-memory] Failed to create schema\n");
         sqlite3_close(mem->db);
+        free(mem->path);
         free(mem);
         return NULL;
     }
 
+    for (int i = 0; i < STMT_EAGER_COUNT; i++) {
+        if (sqlite3_prepare_v3(mem->db, MEM_STMT_SQL[i], -1, SQLITE_PREPARE_PERSISTENT,
+                               &mem->stmts[i], NULL) != SQLITE_OK) {
+            fprintf(stderr, "[neuronos-memory] Failed to prepare statement: %s\n", sqlite3_errmsg(mem->db));
+            memory_finalize_all(mem);
+            sqlite3_close(mem->db);
+            free(mem->path);
+            free(mem);
+            return NULL;
+        }
+    }
+
+    mem_mutex_init(&mem->stmt_lock);
+    mem_mutex_init(&mem->embed_lock);
+    mem_mutex_init(&mem->worker_lock);
+    mem_cond_init(&mem->worker_cond);
+    mem_mutex_init(&mem->wb_lock);
+    mem_cond_init(&mem->wb_cond);
+    mem_cond_init(&mem->wb_done_cond);
+
     /* Auto-create session 1 if none exists */
     mem->current_session_id = 1;
 
@@ -88,12 +368,88 @@ neuronos_memory_t * neuronos_memory_open(const char * db_path) {
 
 void neuronos_memory_close(neuronos_memory_t * mem) {
     if (!mem) return;
+    wb_stop(mem); /* commits everything still queued */
+    embed_worker_stop(mem);
+    if (mem->txn_depth > 0) {
+        sqlite3_exec(mem->db, "COMMIT;", NULL, NULL, NULL);
+    }
+    memory_finalize_all(mem);
     if (mem->db) {
         sqlite3_close(mem->db);
     }
+    mem_cond_destroy(&mem->wb_done_cond);
+    mem_cond_destroy(&mem->wb_cond);
+    mem_mutex_destroy(&mem->wb_lock);
+    mem_cond_destroy(&mem->worker_cond);
+    mem_mutex_destroy(&mem->worker_lock);
+    mem_mutex_destroy(&mem->embed_lock);
+    mem_mutex_destroy(&mem->stmt_lock);
+    free(mem->path);
     free(mem);
 }
 
+/* ---- Statement cache ---- */
+
+/* Borrow cached statement `id` and hold stmt_lock until stmt_release().
+ * Returns NULL (lock not held) if it cannot be prepared. */
+static sqlite3_stmt * stmt_acquire(neuronos_memory_t * mem, mem_stmt_id_t id) {
+    mem_mutex_lock(&mem->stmt_lock);
+    if (!mem->stmts[id] &&
+        sqlite3_prepare_v3(mem->db, MEM_STMT_SQL[id], -1, SQLITE_PREPARE_PERSISTENT,
+                           &mem->stmts[id], NULL) != SQLITE_OK) {
+        mem->stmts[id] = NULL;
+        mem_mutex_unlock(&mem->stmt_lock);
+        return NULL;
+    }
+    return mem->stmts[id];
+}
+
+/* Reset the statement for its next use and drop the borrowed bindings */
+static void stmt_release(neuronos_memory_t * mem, sqlite3_stmt * stmt) {
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    mem_mutex_unlock(&mem->stmt_lock);
+}
+
+/* ---- Batched writes ----
+ * With write-behind on, queued writes are already committed in batches
+ * by the writer, so begin/commit only track nesting: holding a write
+ * transaction here would stall the writer behind the caller. */
+
+int neuronos_memory_begin(neuronos_memory_t * mem) {
+    if (!mem || !mem->db) return -1;
+    mem_mutex_lock(&mem->stmt_lock);
+    int rc = 0;
+    if (mem->txn_depth == 0 && !mem->wb_running &&
+        sqlite3_exec(mem->db, "BEGIN IMMEDIATE;", NULL, NULL, NULL) != SQLITE_OK) {
+        rc = -1;
+    }
+    if (rc == 0) mem->txn_depth++;
+    mem_mutex_unlock(&mem->stmt_lock);
+    return rc;
+}
+
+int neuronos_memory_commit(neuronos_memory_t * mem) {
+    if (!mem || !mem->db) return -1;
+    mem_mutex_lock(&mem->stmt_lock);
+    int rc = 0;
+    bool committed = false;
+    if (mem->txn_depth == 0) {
+        rc = -1;
+    } else if (--mem->txn_depth == 0 && !mem->wb_running) {
+        if (sqlite3_exec(mem->db, "COMMIT;", NULL, NULL, NULL) != SQLITE_OK) {
+            sqlite3_exec(mem->db, "ROLLBACK;", NULL, NULL, NULL);
+            rc = -1;
+        } else {
+            committed = true;
+        }
+    }
+    mem_mutex_unlock(&mem->stmt_lock);
+    /* Rows queued inside the transaction were invisible to the worker */
+    if (committed) embed_kick(mem);
+    return rc;
+}
+
 /* ============================================================
  * SCHEMA
  * ============================================================ */
@@ -178,6 +534,19 @@ static int memory_create_schema(sqlite3 * db) {
         "  title TEXT DEFAULT ''"
         ");\n"
 
+        /* Key/value settings, e.g. the model behind stored embeddings */
+        "CREATE TABLE IF NOT EXISTS memory_meta ("
+        "  key TEXT PRIMARY KEY,"
+        "  value TEXT NOT NULL"
+        ");\n"
+
+        /* Rows whose embedding is missing or stale (kind 0 = archival, 1 = recall) */
+        "CREATE TABLE IF NOT EXISTS embed_queue ("
+        "  kind INTEGER NOT NULL,"
+        "  row_id INTEGER NOT NULL,"
+        "  PRIMARY KEY(kind, row_id)"
+        ") WITHOUT ROWID;\n"
+
         /* Insert default session if empty */
         "INSERT OR IGNORE INTO sessions(id, title) VALUES(1, 'default');\n"
 
@@ -240,29 +609,24 @@ static char * memory_resolve_path(const char * db_path) {
 int neuronos_memory_core_set(neuronos_memory_t * mem, const char * label, const char * content) {
     if (!mem || !mem->db || !label || !content) return -1;
 
-    const char * sql =
-        "INSERT INTO core_blocks(label, content, updated_at) VALUES(?1, ?2, strftime('%s','now')) "
-        "ON CONFLICT(label) DO UPDATE SET content=?2, updated_at=strftime('%s','now');";
-
-    sqlite3_stmt * stmt = NULL;
-    int rc = sqlite3_prepare_v2(mem->db, sql, -1, &stmt, NULL);
-    if (rc != SQLITE_OK) return -1;
+    sqlite3_stmt * stmt = stmt_acquire(mem, STMT_CORE_SET);
+    if (!stmt) return -1;
 
     sqlite3_bind_text(stmt, 1, label, -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 2, content, -1, SQLITE_TRANSIENT);
 
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    return (rc == SQLITE_DONE) ? 0 : -1;
+    int rc = sqlite3_step(stmt);
+    stmt_release(mem, stmt);
+    if (rc != SQLITE_DONE) return -1;
+    mem_atomic_inc(&mem->core_gen);
+    return 0;
 }
 
 char * neuronos_memory_core_get(neuronos_memory_t * mem, const char * label) {
     if (!mem || !mem->db || !label) return NULL;
 
-    const char * sql = "SELECT content FROM core_blocks WHERE label = ?1;";
-    sqlite3_stmt * stmt = NULL;
-    int rc = sqlite3_prepare_v2(mem->db, sql, -1, &stmt, NULL);
-    if (rc != SQLITE_OK) return NULL;
+    sqlite3_stmt * stmt = stmt_acquire(mem, STMT_CORE_GET);
+    if (!stmt) return NULL;
 
     sqlite3_bind_text(stmt, 1, label, -1, SQLITE_TRANSIENT);
 
@@ -271,7 +635,7 @@ char * neuronos_memory_core_get(neuronos_memory_t * mem, const char * label) {
         const char * text = (const char *)sqlite3_column_text(stmt, 0);
         if (text) result = strdup(text);
     }
-    sqlite3_finalize(stmt);
+    stmt_release(mem, stmt);
     return result;
 }
 
@@ -298,19 +662,21 @@ int neuronos_memory_core_append(neuronos_memory_t * mem, const char * label, con
     return rc;
 }
 
+uint64_t neuronos_memory_core_generation(neuronos_memory_t * mem) {
+    return mem ? (uint64_t)mem_atomic_load(&mem->core_gen) : 0;
+}
+
 char * neuronos_memory_core_dump(neuronos_memory_t * mem) {
     if (!mem || !mem->db) return NULL;
 
-    const char * sql = "SELECT label, content FROM core_blocks ORDER BY label;";
-    sqlite3_stmt * stmt = NULL;
-    int rc = sqlite3_prepare_v2(mem->db, sql, -1, &stmt, NULL);
-    if (rc != SQLITE_OK) return NULL;
+    sqlite3_stmt * stmt = stmt_acquire(mem, STMT_CORE_DUMP);
+    if (!stmt) return NULL;
 
     /* Build formatted string */
     size_t cap = 4096;
     size_t len = 0;
     char * buf = malloc(cap);
-    if (!buf) { sqlite3_finalize(stmt); return NULL; }
+    if (!buf) { stmt_release(mem, stmt); return NULL; }
     buf[0] = '\0';
 
     while (sqlite3_step(stmt) == SQLITE_ROW) {
@@ -322,12 +688,12 @@ char * neuronos_memory_core_dump(neuronos_memory_t * mem) {
         while (len + need > cap) {
             cap *= 2;
             void * tmp = realloc(buf, cap);
-            if (!tmp) { free(buf); sqlite3_finalize(stmt); return NULL; }
+            if (!tmp) { free(buf); stmt_release(mem, stmt); return NULL; }
             buf = tmp;
         }
         len += (size_t)snprintf(buf + len, cap - len, "<%s>:\n%s\n---\n", label, content);
     }
-    sqlite3_finalize(stmt);
+    stmt_release(mem, stmt);
     return buf;
 }
 
@@ -335,30 +701,86 @@ char * neuronos_memory_core_dump(neuronos_memory_t * mem) {
  * RECALL MEMORY
  * ============================================================ */
 
-int64_t neuronos_memory_recall_add(neuronos_memory_t * mem, int64_t session_id,
-                                   const char * role, const char * content, int token_count) {
-    if (!mem || !mem->db || !role || !content) return -1;
-
-    const char * sql =
-        "INSERT INTO recall_memory(session_id, role, content, token_count) "
-        "VALUES(?1, ?2, ?3, ?4);";
-
-    sqlite3_stmt * stmt = NULL;
-    int rc = sqlite3_prepare_v2(mem->db, sql, -1, &stmt, NULL);
-    if (rc != SQLITE_OK) return -1;
+/* Columns: id, role, content, timestamp, token_count, session_id, summary_of */
+static void recall_read_row(sqlite3_stmt * stmt, neuronos_recall_entry_t * e) {
+    e->id         = sqlite3_column_int64(stmt, 0);
+    e->role       = strdup((const char *)sqlite3_column_text(stmt, 1));
+    e->content    = strdup((const char *)sqlite3_column_text(stmt, 2));
+    e->timestamp  = sqlite3_column_int64(stmt, 3);
+    e->token_count = sqlite3_column_int(stmt, 4);
+    e->session_id = sqlite3_column_int64(stmt, 5);
+    e->summary_of = sqlite3_column_int64(stmt, 6);
+}
 
+/* Shared by the direct path and the write-behind writer. id 0 lets
+ * AUTOINCREMENT pick the row id. */
+static int64_t recall_insert_step(sqlite3 * db, sqlite3_stmt * stmt, int64_t id, int64_t session_id,
+                                  const char * role, const char * content, int token_count, int64_t summary_of) {
     sqlite3_bind_int64(stmt, 1, session_id);
     sqlite3_bind_text(stmt, 2, role, -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 3, content, -1, SQLITE_TRANSIENT);
     sqlite3_bind_int(stmt, 4, token_count);
+    sqlite3_bind_int64(stmt, 5, summary_of);
+    if (id > 0)
+        sqlite3_bind_int64(stmt, 6, id);
+    else
+        sqlite3_bind_null(stmt, 6);
+    return sqlite3_step(stmt) == SQLITE_DONE ? sqlite3_last_insert_rowid(db) : -1;
+}
 
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+/* Row id for a queued insert, so the caller can link to it (summary_of)
+ * before the writer commits. Ids come in blocks moved past the table's
+ * AUTOINCREMENT counter, which no other connection will hand out.
+ * Returns 0 if no block could be reserved (the writer then assigns). */
+static int64_t recall_reserve_id(neuronos_memory_t * mem) {
+    sqlite3_stmt * stmt = stmt_acquire(mem, STMT_RECALL_RESERVE);
+    if (!stmt) return 0;
+    if (mem->wb_id_next >= mem->wb_id_end) {
+        /* sqlite_sequence has no row until the first insert */
+        sqlite3_exec(mem->db,
+                     "INSERT INTO sqlite_sequence(name, seq) "
+                     "SELECT 'recall_memory', COALESCE((SELECT MAX(id) FROM recall_memory), 0) "
+                     "WHERE NOT EXISTS (SELECT 1 FROM sqlite_sequence WHERE name = 'recall_memory');",
+                     NULL, NULL, NULL);
+        sqlite3_bind_int(stmt, 1, WB_ID_BLOCK);
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            mem->wb_id_end = sqlite3_column_int64(stmt, 0) + 1;
+            mem->wb_id_next = mem->wb_id_end - WB_ID_BLOCK;
+        }
+    }
+    int64_t id = mem->wb_id_next < mem->wb_id_end ? mem->wb_id_next++ : 0;
+    stmt_release(mem, stmt);
+    return id;
+}
 
-    if (rc == SQLITE_DONE) {
-        return sqlite3_last_insert_rowid(mem->db);
+static int64_t recall_insert(neuronos_memory_t * mem, int64_t session_id, const char * role,
+                             const char * content, int token_count, int64_t summary_of) {
+    if (!mem || !mem->db || !role || !content) return -1;
+
+    if (mem->wb_running) {
+        int64_t id = recall_reserve_id(mem);
+        wb_op_t op = {.kind = WB_RECALL_INSERT, .session_id = session_id, .summary_of = summary_of, .id = id,
+                      .role = strdup(role), .text = strdup(content), .n1 = token_count};
+        return wb_push(mem, &op) ? id : -1;
     }
-    return -1;
+
+    sqlite3_stmt * stmt = stmt_acquire(mem, STMT_RECALL_INSERT);
+    if (!stmt) return -1;
+
+    int64_t id = recall_insert_step(mem->db, stmt, 0, session_id, role, content, token_count, summary_of);
+    stmt_release(mem, stmt);
+    if (id > 0) embed_kick(mem);
+    return id;
+}
+
+int64_t neuronos_memory_recall_add(neuronos_memory_t * mem, int64_t session_id,
+                                   const char * role, const char * content, int token_count) {
+    return recall_insert(mem, session_id, role, content, token_count, 0);
+}
+
+int64_t neuronos_memory_recall_add_summary(neuronos_memory_t * mem, int64_t session_id, const char * content,
+                                           int token_count, int64_t summary_of) {
+    return recall_insert(mem, session_id, "system", content, token_count, summary_of);
 }
 
 int neuronos_memory_recall_recent(neuronos_memory_t * mem, int64_t session_id,
@@ -366,15 +788,10 @@ int neuronos_memory_recall_recent(neuronos_memory_t * mem, int64_t session_id,
     if (!mem || !mem->db || !out_entries || !out_count) return -1;
     *out_entries = NULL;
     *out_count = 0;
+    wb_sync(mem); /* read-your-writes */
 
-    const char * sql =
-        "SELECT id, role, content, timestamp, token_count, session_id, summary_of "
-        "FROM recall_memory WHERE session_id=?1 "
-        "ORDER BY timestamp DESC LIMIT ?2;";
-
-    sqlite3_stmt * stmt = NULL;
-    int rc = sqlite3_prepare_v2(mem->db, sql, -1, &stmt, NULL);
-    if (rc != SQLITE_OK) return -1;
+    sqlite3_stmt * stmt = stmt_acquire(mem, STMT_RECALL_RECENT);
+    if (!stmt) return -1;
 
     sqlite3_bind_int64(stmt, 1, session_id);
     sqlite3_bind_int(stmt, 2, limit > 0 ? limit : 100);
@@ -383,26 +800,19 @@ int neuronos_memory_recall_recent(neuronos_memory_t * mem, int64_t session_id,
     int count = 0;
     int cap = 32;
     neuronos_recall_entry_t * entries = calloc((size_t)cap, sizeof(neuronos_recall_entry_t));
-    if (!entries) { sqlite3_finalize(stmt); *out_entries = NULL; *out_count = 0; return -1; }
+    if (!entries) { stmt_release(mem, stmt); *out_entries = NULL; *out_count = 0; return -1; }
 
     while (sqlite3_step(stmt) == SQLITE_ROW) {
         if (count >= cap) {
             cap *= 2;
             void * tmp = realloc(entries, (size_t)cap * sizeof(neuronos_recall_entry_t));
-            if (!tmp) { neuronos_memory_recall_free(entries, count); sqlite3_finalize(stmt); *out_entries = NULL; *out_count = 0; return -1; }
+            if (!tmp) { neuronos_memory_recall_free(entries, count); stmt_release(mem, stmt); *out_entries = NULL; *out_count = 0; return -1; }
             entries = tmp;
         }
-        neuronos_recall_entry_t * e = &entries[count];
-        e->id         = sqlite3_column_int64(stmt, 0);
-        e->role       = strdup((const char *)sqlite3_column_text(stmt, 1));
-        e->content    = strdup((const char *)sqlite3_column_text(stmt, 2));
-        e->timestamp  = sqlite3_column_int64(stmt, 3);
-        e->token_count = sqlite3_column_int(stmt, 4);
-        e->session_id = sqlite3_column_int64(stmt, 5);
-        e->summary_of = sqlite3_column_int64(stmt, 6);
+        recall_read_row(stmt, &entries[count]);
         count++;
     }
-    sqlite3_finalize(stmt);
+    stmt_release(mem, stmt);
 
     *out_entries = entries;
     *out_count = count;
@@ -414,17 +824,14 @@ int neuronos_memory_recall_search(neuronos_memory_t * mem, const char * query,
     if (!mem || !mem->db || !query || !out_entries || !out_count) return -1;
     *out_entries = NULL;
     *out_count = 0;
+    wb_sync(mem); /* read-your-writes */
 
-    const char * sql =
-        "SELECT r.id, r.role, r.content, r.timestamp, r.token_count, r.session_id, r.summary_of "
-        "FROM recall_fts f "
-        "JOIN recall_memory r ON f.rowid = r.id "
-        "WHERE recall_fts MATCH ?1 "
-        "ORDER BY rank LIMIT ?2;";
+    if (mem->embed) {
+        return recall_search_hybrid(mem, query, max_results, out_entries, out_count);
+    }
 
-    sqlite3_stmt * stmt = NULL;
-    int rc = sqlite3_prepare_v2(mem->db, sql, -1, &stmt, NULL);
-    if (rc != SQLITE_OK) return -1;
+    sqlite3_stmt * stmt = stmt_acquire(mem, STMT_RECALL_SEARCH);
+    if (!stmt) return -1;
 
     sqlite3_bind_text(stmt, 1, query, -1, SQLITE_TRANSIENT);
     sqlite3_bind_int(stmt, 2, max_results > 0 ? max_results : 10);
@@ -432,26 +839,19 @@ int neuronos_memory_recall_search(neuronos_memory_t * mem, const char * query,
     int count = 0;
     int cap = 16;
     neuronos_recall_entry_t * entries = calloc((size_t)cap, sizeof(neuronos_recall_entry_t));
-    if (!entries) { sqlite3_finalize(stmt); *out_entries = NULL; *out_count = 0; return -1; }
+    if (!entries) { stmt_release(mem, stmt); *out_entries = NULL; *out_count = 0; return -1; }
 
     while (sqlite3_step(stmt) == SQLITE_ROW) {
         if (count >= cap) {
             cap *= 2;
             void * tmp = realloc(entries, (size_t)cap * sizeof(neuronos_recall_entry_t));
-            if (!tmp) { neuronos_memory_recall_free(entries, count); sqlite3_finalize(stmt); *out_entries = NULL; *out_count = 0; return -1; }
+            if (!tmp) { neuronos_memory_recall_free(entries, count); stmt_release(mem, stmt); *out_entries = NULL; *out_count = 0; return -1; }
             entries = tmp;
         }
-        neuronos_recall_entry_t * e = &entries[count];
-        e->id         = sqlite3_column_int64(stmt, 0);
-        e->role       = strdup((const char *)sqlite3_column_text(stmt, 1));
-        e->content    = strdup((const char *)sqlite3_column_text(stmt, 2));
-        e->timestamp  = sqlite3_column_int64(stmt, 3);
-        e->token_count = sqlite3_column_int(stmt, 4);
-        e->session_id = sqlite3_column_int64(stmt, 5);
-        e->summary_of = sqlite3_column_int64(stmt, 6);
+        recall_read_row(stmt, &entries[count]);
         count++;
     }
-    sqlite3_finalize(stmt);
+    stmt_release(mem, stmt);
 
     *out_entries = entries;
     *out_count = count;
@@ -470,14 +870,10 @@ void neuronos_memory_recall_free(neuronos_recall_entry_t * entries, int count) {
 int neuronos_memory_recall_stats(neuronos_memory_t * mem, int64_t session_id,
                                  int * out_msg_count, int * out_token_count) {
     if (!mem || !mem->db) return -1;
+    wb_sync(mem); /* read-your-writes */
 
-    const char * sql =
-        "SELECT COUNT(*), COALESCE(SUM(token_count), 0) "
-        "FROM recall_memory WHERE session_id=?1;";
-
-    sqlite3_stmt * stmt = NULL;
-    int rc = sqlite3_prepare_v2(mem->db, sql, -1, &stmt, NULL);
-    if (rc != SQLITE_OK) return -1;
+    sqlite3_stmt * stmt = stmt_acquire(mem, STMT_RECALL_STATS);
+    if (!stmt) return -1;
 
     sqlite3_bind_int64(stmt, 1, session_id);
 
@@ -485,47 +881,43 @@ int neuronos_memory_recall_stats(neuronos_memory_t * mem, int64_t session_id,
         if (out_msg_count)   *out_msg_count   = sqlite3_column_int(stmt, 0);
         if (out_token_count) *out_token_count  = sqlite3_column_int(stmt, 1);
     }
-    sqlite3_finalize(stmt);
+    stmt_release(mem, stmt);
     return 0;
 }
 
+/* One GC pass (STMT_RECALL_GC_AGE or STMT_RECALL_GC_TRIM): rows deleted */
+static int recall_gc_step(sqlite3 * db, sqlite3_stmt * stmt, int64_t session_id, int limit) {
+    sqlite3_bind_int64(stmt, 1, session_id);
+    sqlite3_bind_int(stmt, 2, limit);
+    return sqlite3_step(stmt) == SQLITE_DONE ? sqlite3_changes(db) : 0;
+}
+
 int neuronos_memory_recall_gc(neuronos_memory_t * mem, int64_t session_id,
                               int max_messages, int max_age_seconds) {
     if (!mem || !mem->db) return -1;
+
+    if (mem->wb_running) {
+        wb_op_t op = {.kind = WB_RECALL_GC, .session_id = session_id, .n1 = max_messages, .n2 = max_age_seconds};
+        return wb_push(mem, &op) ? 0 : -1;
+    }
+
     int deleted = 0;
 
     /* 1. Delete messages older than max_age_seconds (if > 0) */
     if (max_age_seconds > 0) {
-        const char * age_sql =
-            "DELETE FROM recall_memory "
-            "WHERE session_id=?1 AND timestamp < (strftime('%s','now') - ?2);";
-        sqlite3_stmt * stmt = NULL;
-        int rc = sqlite3_prepare_v2(mem->db, age_sql, -1, &stmt, NULL);
-        if (rc == SQLITE_OK) {
-            sqlite3_bind_int64(stmt, 1, session_id);
-            sqlite3_bind_int(stmt, 2, max_age_seconds);
-            sqlite3_step(stmt);
-            deleted += sqlite3_changes(mem->db);
-            sqlite3_finalize(stmt);
+        sqlite3_stmt * stmt = stmt_acquire(mem, STMT_RECALL_GC_AGE);
+        if (stmt) {
+            deleted += recall_gc_step(mem->db, stmt, session_id, max_age_seconds);
+            stmt_release(mem, stmt);
         }
     }
 
     /* 2. Keep only the newest max_messages per session (if > 0) */
     if (max_messages > 0) {
-        const char * trim_sql =
-            "DELETE FROM recall_memory "
-            "WHERE session_id=?1 AND id NOT IN ("
-            "  SELECT id FROM recall_memory WHERE session_id=?1 "
-            "  ORDER BY timestamp DESC LIMIT ?2"
-            ");";
-        sqlite3_stmt * stmt = NULL;
-        int rc = sqlite3_prepare_v2(mem->db, trim_sql, -1, &stmt, NULL);
-        if (rc == SQLITE_OK) {
-            sqlite3_bind_int64(stmt, 1, session_id);
-            sqlite3_bind_int(stmt, 2, max_messages);
-            sqlite3_step(stmt);
-            deleted += sqlite3_changes(mem->db);
-            sqlite3_finalize(stmt);
+        sqlite3_stmt * stmt = stmt_acquire(mem, STMT_RECALL_GC_TRIM);
+        if (stmt) {
+            deleted += recall_gc_step(mem->db, stmt, session_id, max_messages);
+            stmt_release(mem, stmt);
         }
     }
 
@@ -536,79 +928,79 @@ int neuronos_memory_recall_gc(neuronos_memory_t * mem, int64_t session_id,
  * ARCHIVAL MEMORY
  * ============================================================ */
 
+/* Columns: id, key, value, category, importance, created_at, updated_at, access_count */
+static void archival_read_row(sqlite3_stmt * stmt, neuronos_archival_entry_t * e) {
+    e->id           = sqlite3_column_int64(stmt, 0);
+    e->key          = strdup((const char *)sqlite3_column_text(stmt, 1));
+    e->value        = strdup((const char *)sqlite3_column_text(stmt, 2));
+    const char * cat = (const char *)sqlite3_column_text(stmt, 3);
+    e->category     = cat ? strdup(cat) : strdup("general");
+    e->importance   = (float)sqlite3_column_double(stmt, 4);
+    e->created_at   = sqlite3_column_int64(stmt, 5);
+    e->updated_at   = sqlite3_column_int64(stmt, 6);
+    e->access_count = sqlite3_column_int(stmt, 7);
+}
+
 int64_t neuronos_memory_archival_store(neuronos_memory_t * mem, const char * key,
                                        const char * value, const char * category, float importance) {
     if (!mem || !mem->db || !key || !value) return -1;
 
     /* Check for existing key — update if exists */
-    const char * check_sql = "SELECT id FROM archival_memory WHERE key=?1 LIMIT 1;";
-    sqlite3_stmt * check_stmt = NULL;
-    int rc = sqlite3_prepare_v2(mem->db, check_sql, -1, &check_stmt, NULL);
-    if (rc != SQLITE_OK) return -1;
-    sqlite3_bind_text(check_stmt, 1, key, -1, SQLITE_TRANSIENT);
+    sqlite3_stmt * stmt = stmt_acquire(mem, STMT_ARCHIVAL_FIND);
+    if (!stmt) return -1;
+    sqlite3_bind_text(stmt, 1, key, -1, SQLITE_TRANSIENT);
 
     int64_t existing_id = -1;
-    if (sqlite3_step(check_stmt) == SQLITE_ROW) {
-        existing_id = sqlite3_column_int64(check_stmt, 0);
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        existing_id = sqlite3_column_int64(stmt, 0);
     }
-    sqlite3_finalize(check_stmt);
+    stmt_release(mem, stmt);
 
+    int64_t id = -1;
     if (existing_id >= 0) {
         /* Update existing */
-        const char * update_sql =
-            "UPDATE archival_memory SET value=?1, category=?2, importance=?3, "
-            "updated_at=strftime('%s','now') WHERE id=?4;";
-        sqlite3_stmt * stmt = NULL;
-        rc = sqlite3_prepare_v2(mem->db, update_sql, -1, &stmt, NULL);
-        if (rc != SQLITE_OK) return -1;
+        stmt = stmt_acquire(mem, STMT_ARCHIVAL_UPDATE);
+        if (!stmt) return -1;
         sqlite3_bind_text(stmt, 1, value, -1, SQLITE_TRANSIENT);
         sqlite3_bind_text(stmt, 2, category ? category : "general", -1, SQLITE_TRANSIENT);
         sqlite3_bind_double(stmt, 3, (double)importance);
         sqlite3_bind_int64(stmt, 4, existing_id);
-        rc = sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
-        return (rc == SQLITE_DONE) ? existing_id : -1;
+        if (sqlite3_step(stmt) == SQLITE_DONE) id = existing_id;
+        stmt_release(mem, stmt);
+    } else {
+        /* Insert new */
+        stmt = stmt_acquire(mem, STMT_ARCHIVAL_INSERT);
+        if (!stmt) return -1;
+        sqlite3_bind_text(stmt, 1, key, -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2, value, -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 3, category ? category : "general", -1, SQLITE_TRANSIENT);
+        sqlite3_bind_double(stmt, 4, (double)importance);
+        if (sqlite3_step(stmt) == SQLITE_DONE) id = sqlite3_last_insert_rowid(mem->db);
+        stmt_release(mem, stmt);
     }
 
-    /* Insert new */
-    const char * insert_sql =
-        "INSERT INTO archival_memory(key, value, category, importance) "
-        "VALUES(?1, ?2, ?3, ?4);";
-    sqlite3_stmt * stmt = NULL;
-    rc = sqlite3_prepare_v2(mem->db, insert_sql, -1, &stmt, NULL);
-    if (rc != SQLITE_OK) return -1;
-
-    sqlite3_bind_text(stmt, 1, key, -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 2, value, -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 3, category ? category : "general", -1, SQLITE_TRANSIENT);
-    sqlite3_bind_double(stmt, 4, (double)importance);
-
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-
-    if (rc == SQLITE_DONE) {
-        return sqlite3_last_insert_rowid(mem->db);
-    }
-    return -1;
+    if (id >= 0) embed_kick(mem);
+    return id;
 }
 
 char * neuronos_memory_archival_recall(neuronos_memory_t * mem, const char * key) {
     if (!mem || !mem->db || !key) return NULL;
 
-    const char * sql =
-        "UPDATE archival_memory SET access_count = access_count + 1 WHERE key=?1;"
-        ;
-    sqlite3_stmt * upd = NULL;
-    if (sqlite3_prepare_v2(mem->db, sql, -1, &upd, NULL) == SQLITE_OK) {
-        sqlite3_bind_text(upd, 1, key, -1, SQLITE_TRANSIENT);
-        sqlite3_step(upd);
-        sqlite3_finalize(upd);
+    /* The access count is bookkeeping: with write-behind it is bumped
+     * later, and repeated reads of one key coalesce into one UPDATE */
+    sqlite3_stmt * stmt = NULL;
+    if (mem->wb_running) {
+        wb_op_t op = {.kind = WB_ARCHIVAL_TOUCH, .text = strdup(key)};
+        wb_push(mem, &op);
+    } else if ((stmt = stmt_acquire(mem, STMT_ARCHIVAL_TOUCH)) != NULL) {
+        sqlite3_bind_text(stmt, 1, key, -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(stmt, 2, 1);
+        sqlite3_step(stmt);
+        stmt_release(mem, stmt);
     }
 
-    const char * sel_sql = "SELECT value FROM archival_memory WHERE key=?1 LIMIT 1;";
-    sqlite3_stmt * stmt = NULL;
-    int rc = sqlite3_prepare_v2(mem->db, sel_sql, -1, &stmt, NULL);
-    if (rc != SQLITE_OK) return NULL;
+    stmt = stmt_acquire(mem, STMT_ARCHIVAL_GET);
+    if (!stmt) return NULL;
 
     sqlite3_bind_text(stmt, 1, key, -1, SQLITE_TRANSIENT);
 
@@ -617,7 +1009,7 @@ char * neuronos_memory_archival_recall(neuronos_memory_t * mem, const char * key
         const char * val = (const char *)sqlite3_column_text(stmt, 0);
         if (val) result = strdup(val);
     }
-    sqlite3_finalize(stmt);
+    stmt_release(mem, stmt);
     return result;
 }
 
@@ -627,17 +1019,12 @@ int neuronos_memory_archival_search(neuronos_memory_t * mem, const char * query,
     *out_entries = NULL;
     *out_count = 0;
 
-    const char * sql =
-        "SELECT a.id, a.key, a.value, a.category, a.importance, "
-        "       a.created_at, a.updated_at, a.access_count "
-        "FROM archival_fts f "
-        "JOIN archival_memory a ON f.rowid = a.id "
-        "WHERE archival_fts MATCH ?1 "
-        "ORDER BY rank LIMIT ?2;";
+    if (mem->embed) {
+        return archival_search_hybrid(mem, query, max_results, out_entries, out_count);
+    }
 
-    sqlite3_stmt * stmt = NULL;
-    int rc = sqlite3_prepare_v2(mem->db, sql, -1, &stmt, NULL);
-    if (rc != SQLITE_OK) return -1;
+    sqlite3_stmt * stmt = stmt_acquire(mem, STMT_ARCHIVAL_SEARCH);
+    if (!stmt) return -1;
 
     sqlite3_bind_text(stmt, 1, query, -1, SQLITE_TRANSIENT);
     sqlite3_bind_int(stmt, 2, max_results > 0 ? max_results : 10);
@@ -645,28 +1032,19 @@ int neuronos_memory_archival_search(neuronos_memory_t * mem, const char * query,
     int count = 0;
     int cap = 16;
     neuronos_archival_entry_t * entries = calloc((size_t)cap, sizeof(neuronos_archival_entry_t));
-    if (!entries) { sqlite3_finalize(stmt); *out_entries = NULL; *out_count = 0; return -1; }
+    if (!entries) { stmt_release(mem, stmt); *out_entries = NULL; *out_count = 0; return -1; }
 
     while (sqlite3_step(stmt) == SQLITE_ROW) {
         if (count >= cap) {
             cap *= 2;
             void * tmp = realloc(entries, (size_t)cap * sizeof(neuronos_archival_entry_t));
-            if (!tmp) { neuronos_memory_archival_free(entries, count); sqlite3_finalize(stmt); *out_entries = NULL; *out_count = 0; return -1; }
+            if (!tmp) { neuronos_memory_archival_free(entries, count); stmt_release(mem, stmt); *out_entries = NULL; *out_count = 0; return -1; }
             entries = tmp;
         }
-        neuronos_archival_entry_t * e = &entries[count];
-        e->id           = sqlite3_column_int64(stmt, 0);
-        e->key          = strdup((const char *)sqlite3_column_text(stmt, 1));
-        e->value        = strdup((const char *)sqlite3_column_text(stmt, 2));
-        const char * cat = (const char *)sqlite3_column_text(stmt, 3);
-        e->category     = cat ? strdup(cat) : strdup("general");
-        e->importance   = (float)sqlite3_column_double(stmt, 4);
-        e->created_at   = sqlite3_column_int64(stmt, 5);
-        e->updated_at   = sqlite3_column_int64(stmt, 6);
-        e->access_count = sqlite3_column_int(stmt, 7);
+        archival_read_row(stmt, &entries[count]);
         count++;
     }
-    sqlite3_finalize(stmt);
+    stmt_release(mem, stmt);
 
     *out_entries = entries;
     *out_count = count;
@@ -686,15 +1064,688 @@ void neuronos_memory_archival_free(neuronos_archival_entry_t * entries, int coun
 int neuronos_memory_archival_stats(neuronos_memory_t * mem, int * out_fact_count) {
     if (!mem || !mem->db) return -1;
 
-    const char * sql = "SELECT COUNT(*) FROM archival_memory;";
-    sqlite3_stmt * stmt = NULL;
-    int rc = sqlite3_prepare_v2(mem->db, sql, -1, &stmt, NULL);
-    if (rc != SQLITE_OK) return -1;
+    sqlite3_stmt * stmt = stmt_acquire(mem, STMT_ARCHIVAL_STATS);
+    if (!stmt) return -1;
 
     if (sqlite3_step(stmt) == SQLITE_ROW) {
         if (out_fact_count) *out_fact_count = sqlite3_column_int(stmt, 0);
     }
+    stmt_release(mem, stmt);
+    return 0;
+}
+
+/* ============================================================
+ * WRITE-BEHIND
+ * ============================================================ */
+
+static void wb_op_free(wb_op_t * op) {
+    free(op->role);
+    free(op->text);
+}
+
+/* Claim the next cell and publish op into it; false if the queue is full */
+static bool wb_try_push(neuronos_memory_t * mem, const wb_op_t * op) {
+    int64_t pos = mem_atomic_load(&mem->wb_enq);
+    for (;;) {
+        wb_cell_t * cell = &mem->wb_cells[pos & mem->wb_mask];
+        int64_t dif = mem_atomic_load(&cell->seq) - pos;
+        if (dif == 0 && mem_atomic_cas(&mem->wb_enq, pos, pos + 1)) {
+            cell->op = *op;
+            mem_atomic_store(&cell->seq, pos + 1);
+            return true;
+        }
+        if (dif < 0) return false; /* the writer has not popped this cell yet */
+        pos = mem_atomic_load(&mem->wb_enq);
+    }
+}
+
+/* Queue op, taking ownership of its strings. Waits only while the
+ * queue is full (for the writer's next commit). */
+static bool wb_push(neuronos_memory_t * mem, wb_op_t * op) {
+    if (op->kind != WB_RECALL_GC && (!op->text || (op->kind == WB_RECALL_INSERT && !op->role))) {
+        wb_op_free(op);
+        return false;
+    }
+
+    for (;;) {
+        int64_t done = mem_atomic_load(&mem->wb_done);
+        if (wb_try_push(mem, op)) break;
+        mem_mutex_lock(&mem->wb_lock);
+        while (mem_atomic_load(&mem->wb_done) == done) {
+            mem_cond_wait(&mem->wb_done_cond, &mem->wb_lock);
+        }
+        mem_mutex_unlock(&mem->wb_lock);
+    }
+
+    if (mem_atomic_xchg(&mem->wb_idle, 0)) {
+        mem_mutex_lock(&mem->wb_lock);
+        mem_cond_signal(&mem->wb_cond);
+        mem_mutex_unlock(&mem->wb_lock);
+    }
+    return true;
+}
+
+static bool wb_ready(neuronos_memory_t * mem) {
+    wb_cell_t * cell = &mem->wb_cells[mem->wb_deq & mem->wb_mask];
+    return mem_atomic_load(&cell->seq) == mem->wb_deq + 1;
+}
+
+static bool wb_pop(neuronos_memory_t * mem, wb_op_t * out) {
+    if (!wb_ready(mem)) return false;
+    wb_cell_t * cell = &mem->wb_cells[mem->wb_deq & mem->wb_mask];
+    *out = cell->op;
+    mem_atomic_store(&cell->seq, mem->wb_deq + mem->wb_mask + 1);
+    mem->wb_deq++;
+    return true;
+}
+
+/* Write a popped batch in one transaction on the writer's connection */
+static void wb_apply(neuronos_memory_t * mem, wb_op_t * ops, int n) {
+    sqlite3 * db = mem->wb_db;
+    sqlite3_stmt ** st = mem->wb_stmts;
+    /* If BEGIN fails (e.g. busy past busy_timeout) each write commits alone */
+    bool in_txn = sqlite3_exec(db, "BEGIN IMMEDIATE;", NULL, NULL, NULL) == SQLITE_OK;
+    bool inserted = false;
+
+    for (int i = 0; i < n; i++) {
+        wb_op_t * op = &ops[i];
+        switch (op->kind) {
+            case WB_RECALL_INSERT:
+                inserted |= recall_insert_step(db, st[STMT_RECALL_INSERT], op->id, op->session_id, op->role,
+                                               op->text, op->n1, op->summary_of) > 0;
+                sqlite3_reset(st[STMT_RECALL_INSERT]);
+                break;
+            case WB_RECALL_GC:
+                if (op->n2 > 0) {
+                    recall_gc_step(db, st[STMT_RECALL_GC_AGE], op->session_id, op->n2);
+                    sqlite3_reset(st[STMT_RECALL_GC_AGE]);
+                }
+                if (op->n1 > 0) {
+                    recall_gc_step(db, st[STMT_RECALL_GC_TRIM], op->session_id, op->n1);
+                    sqlite3_reset(st[STMT_RECALL_GC_TRIM]);
+                }
+                break;
+            case WB_ARCHIVAL_TOUCH: {
+                if (!op->text) break; /* folded into an earlier bump */
+                int count = 1;
+                for (int j = i + 1; j < n; j++) {
+                    if (ops[j].kind == WB_ARCHIVAL_TOUCH && ops[j].text && strcmp(ops[j].text, op->text) == 0) {
+                        free(ops[j].text);
+                        ops[j].text = NULL;
+                        count++;
+                    }
+                }
+                sqlite3_bind_text(st[STMT_ARCHIVAL_TOUCH], 1, op->text, -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int(st[STMT_ARCHIVAL_TOUCH], 2, count);
+                sqlite3_step(st[STMT_ARCHIVAL_TOUCH]);
+                sqlite3_reset(st[STMT_ARCHIVAL_TOUCH]);
+                break;
+            }
+        }
+        wb_op_free(op);
+    }
+
+    if (in_txn && sqlite3_exec(db, "COMMIT;", NULL, NULL, NULL) != SQLITE_OK) {
+        fprintf(stderr, "[neuronos-memory] Write-behind commit failed: %s\n", sqlite3_errmsg(db));
+        sqlite3_exec(db, "ROLLBACK;", NULL, NULL, NULL);
+    }
+    if (inserted) embed_kick(mem);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI wb_main(LPVOID arg) {
+#else
+static void * wb_main(void * arg) {
+#endif
+    neuronos_memory_t * mem = arg;
+    int cap = (int)mem->wb_mask + 1;
+    for (;;) {
+        /* Everything queued while the last batch was committing goes in the next */
+        int n = 0;
+        while (n < cap && wb_pop(mem, &mem->wb_batch[n])) n++;
+        if (n > 0) {
+            wb_apply(mem, mem->wb_batch, n);
+            mem_mutex_lock(&mem->wb_lock);
+            mem_atomic_store(&mem->wb_done, mem->wb_deq);
+            mem_cond_broadcast(&mem->wb_done_cond);
+            mem_mutex_unlock(&mem->wb_lock);
+            continue;
+        }
+
+        /* Sleep until a push. wb_idle is raised before the re-check, so a
+         * push that lands in between sees it and signals. */
+        mem_mutex_lock(&mem->wb_lock);
+        mem_atomic_xchg(&mem->wb_idle, 1);
+        while (!mem->wb_stop && !wb_ready(mem)) {
+            mem_cond_wait(&mem->wb_cond, &mem->wb_lock);
+        }
+        mem_atomic_xchg(&mem->wb_idle, 0);
+        bool stop = mem->wb_stop && !wb_ready(mem);
+        mem_mutex_unlock(&mem->wb_lock);
+        if (stop) break;
+    }
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/* Wait until every write queued before this call is committed */
+static void wb_sync(neuronos_memory_t * mem) {
+    if (!mem->wb_running) return;
+    int64_t target = mem_atomic_load(&mem->wb_enq);
+    if (mem_atomic_load(&mem->wb_done) >= target) return;
+    mem_mutex_lock(&mem->wb_lock);
+    while (mem_atomic_load(&mem->wb_done) < target) {
+        mem_cond_wait(&mem->wb_done_cond, &mem->wb_lock);
+    }
+    mem_mutex_unlock(&mem->wb_lock);
+}
+
+/* Drain and join the writer, then release its queue and connection */
+static void wb_stop(neuronos_memory_t * mem) {
+    if (mem->wb_running) {
+        mem_mutex_lock(&mem->wb_lock);
+        mem->wb_stop = true;
+        mem_cond_signal(&mem->wb_cond);
+        mem_mutex_unlock(&mem->wb_lock);
+#ifdef _WIN32
+        WaitForSingleObject(mem->wb_thread, INFINITE);
+        CloseHandle(mem->wb_thread);
+#else
+        pthread_join(mem->wb_thread, NULL);
+#endif
+        mem->wb_running = false;
+    }
+    for (int i = 0; i < STMT_COUNT; i++) {
+        sqlite3_finalize(mem->wb_stmts[i]);
+        mem->wb_stmts[i] = NULL;
+    }
+    sqlite3_close(mem->wb_db);
+    mem->wb_db = NULL;
+    free(mem->wb_cells);
+    mem->wb_cells = NULL;
+    free(mem->wb_batch);
+    mem->wb_batch = NULL;
+}
+
+int neuronos_memory_set_write_behind(neuronos_memory_t * mem, int capacity) {
+    if (!mem || !mem->db || mem->txn_depth > 0) return -1;
+    wb_stop(mem);
+    if (capacity <= 0) return 0;
+    /* An in-memory database is private to its connection */
+    if (strcmp(mem->path, ":memory:") == 0) return -1;
+
+    int64_t cap = 2;
+    while (cap < capacity && cap < WB_MAX_QUEUE) cap *= 2;
+    mem->wb_cells = calloc((size_t)cap, sizeof(wb_cell_t));
+    mem->wb_batch = malloc((size_t)cap * sizeof(wb_op_t));
+    mem->wb_db = mem->wb_cells && mem->wb_batch ? memory_db_open(mem->path) : NULL;
+
+    static const mem_stmt_id_t used[] = {STMT_RECALL_INSERT, STMT_RECALL_GC_AGE, STMT_RECALL_GC_TRIM,
+                                         STMT_ARCHIVAL_TOUCH};
+    bool ok = mem->wb_db != NULL;
+    for (size_t i = 0; ok && i < sizeof(used) / sizeof(used[0]); i++) {
+        ok = sqlite3_prepare_v3(mem->wb_db, MEM_STMT_SQL[used[i]], -1, SQLITE_PREPARE_PERSISTENT,
+                                &mem->wb_stmts[used[i]], NULL) == SQLITE_OK;
+    }
+    if (!ok) {
+        wb_stop(mem);
+        return -1;
+    }
+
+    for (int64_t i = 0; i < cap; i++) mem->wb_cells[i].seq = i;
+    mem->wb_mask = cap - 1;
+    mem->wb_enq = mem->wb_deq = mem->wb_done = mem->wb_idle = 0;
+    mem->wb_stop = false;
+#ifdef _WIN32
+    mem->wb_thread = CreateThread(NULL, 0, wb_main, mem, 0, NULL);
+    mem->wb_running = mem->wb_thread != NULL;
+#else
+    mem->wb_running = pthread_create(&mem->wb_thread, NULL, wb_main, mem) == 0;
+#endif
+    if (!mem->wb_running) {
+        wb_stop(mem);
+        return -1;
+    }
+    return 0;
+}
+
+int neuronos_memory_flush(neuronos_memory_t * mem) {
+    if (!mem || !mem->db) return -1;
+    wb_sync(mem);
+    return 0;
+}
+
+/* ============================================================
+ * EMBEDDINGS (sqlite-vec) + HYBRID SEARCH
+ * ============================================================ */
+
+/* Queue triggers: a row needs a new vector when it is inserted or its
+ * text changes; deleting it drops the vector. */
+static const char EMBED_TRIGGERS[] =
+    "CREATE TRIGGER IF NOT EXISTS archival_eq_ai AFTER INSERT ON archival_memory BEGIN "
+    "  INSERT OR IGNORE INTO embed_queue(kind, row_id) VALUES (0, new.id); "
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS archival_eq_au AFTER UPDATE OF key, value ON archival_memory BEGIN "
+    "  INSERT OR IGNORE INTO embed_queue(kind, row_id) VALUES (0, new.id); "
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS archival_eq_ad AFTER DELETE ON archival_memory BEGIN "
+    "  DELETE FROM embed_queue WHERE kind = 0 AND row_id = old.id; "
+    "  DELETE FROM archival_vec WHERE rowid = old.id; "
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS recall_eq_ai AFTER INSERT ON recall_memory BEGIN "
+    "  INSERT OR IGNORE INTO embed_queue(kind, row_id) VALUES (1, new.id); "
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS recall_eq_au AFTER UPDATE OF content ON recall_memory BEGIN "
+    "  INSERT OR IGNORE INTO embed_queue(kind, row_id) VALUES (1, new.id); "
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS recall_eq_ad AFTER DELETE ON recall_memory BEGIN "
+    "  DELETE FROM embed_queue WHERE kind = 1 AND row_id = old.id; "
+    "  DELETE FROM recall_vec WHERE rowid = old.id; "
+    "END;\n";
+
+static const char * const EMBED_VEC_TABLE[2] = {"archival_vec", "recall_vec"};
+static const char * const EMBED_ROW_TABLE[2] = {"archival_memory", "recall_memory"};
+
+/* Call the embedder; embedder calls are serialized across threads */
+static int embed_texts(neuronos_memory_t * mem, const char * const * texts, int n, float * out) {
+    mem_mutex_lock(&mem->embed_lock);
+    int rc = mem->embed(mem->embed_data, texts, n, out);
+    mem_mutex_unlock(&mem->embed_lock);
+    return rc;
+}
+
+/*
+ * Embed up to EMBED_BATCH queued rows through connection db.
+ * Returns the number of queue entries settled (0 = queue empty), or -1.
+ */
+static int embed_batch(neuronos_memory_t * mem, sqlite3 * db) {
+    const char * sel_sql =
+        "SELECT q.kind, q.row_id, CASE q.kind "
+        "  WHEN 0 THEN (SELECT key || ': ' || value FROM archival_memory WHERE id = q.row_id) "
+        "  ELSE (SELECT content FROM recall_memory WHERE id = q.row_id) END "
+        "FROM embed_queue q LIMIT ?1;";
+    sqlite3_stmt * stmt = NULL;
+    if (sqlite3_prepare_v2(db, sel_sql, -1, &stmt, NULL) != SQLITE_OK) return -1;
+    sqlite3_bind_int(stmt, 1, EMBED_BATCH);
+
+    int kinds[EMBED_BATCH];
+    int64_t ids[EMBED_BATCH];
+    char * texts[EMBED_BATCH];
+    int n = 0;
+    while (n < EMBED_BATCH && sqlite3_step(stmt) == SQLITE_ROW) {
+        const char * text = (const char *)sqlite3_column_text(stmt, 2);
+        kinds[n] = sqlite3_column_int(stmt, 0) == EMBED_RECALL ? EMBED_RECALL : EMBED_ARCHIVAL;
+        ids[n] = sqlite3_column_int64(stmt, 1);
+        texts[n] = text ? strdup(text) : NULL; /* NULL: row is gone */
+        n++;
+    }
     sqlite3_finalize(stmt);
+    if (n == 0) return 0;
+
+    /* Vectors for the rows that still exist, in queue order */
+    const char * batch[EMBED_BATCH];
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        if (texts[i]) batch[m++] = texts[i];
+    }
+    float * vecs = m > 0 ? malloc((size_t)m * (size_t)mem->embed_dim * sizeof(float)) : NULL;
+    int rc = (m > 0 && (!vecs || embed_texts(mem, batch, m, vecs) != 0)) ? -1 : 0;
+
+    if (rc == 0 && sqlite3_exec(db, "BEGIN IMMEDIATE;", NULL, NULL, NULL) != SQLITE_OK) rc = -1;
+    if (rc == 0) {
+        sqlite3_stmt * del_vec[2] = {NULL, NULL};
+        sqlite3_stmt * ins_vec[2] = {NULL, NULL};
+        sqlite3_stmt * del_q = NULL;
+        char sql[256];
+        for (int k = 0; k < 2 && rc == 0; k++) {
+            snprintf(sql, sizeof(sql), "DELETE FROM %s WHERE rowid = ?1;", EMBED_VEC_TABLE[k]);
+            if (sqlite3_prepare_v2(db, sql, -1, &del_vec[k], NULL) != SQLITE_OK) rc = -1;
+            /* Skip rows deleted since they were read */
+            snprintf(sql, sizeof(sql),
+                     "INSERT INTO %s(rowid, embedding) SELECT ?1, ?2 "
+                     "WHERE EXISTS (SELECT 1 FROM %s WHERE id = ?1);",
+                     EMBED_VEC_TABLE[k], EMBED_ROW_TABLE[k]);
+            if (rc == 0 && sqlite3_prepare_v2(db, sql, -1, &ins_vec[k], NULL) != SQLITE_OK) rc = -1;
+        }
+        if (rc == 0 && sqlite3_prepare_v2(db, "DELETE FROM embed_queue WHERE kind = ?1 AND row_id = ?2;",
+                                          -1, &del_q, NULL) != SQLITE_OK) {
+            rc = -1;
+        }
+
+        for (int i = 0, v = 0; i < n && rc == 0; i++) {
+            int k = kinds[i];
+            if (texts[i]) {
+                sqlite3_bind_int64(del_vec[k], 1, ids[i]);
+                if (sqlite3_step(del_vec[k]) != SQLITE_DONE) rc = -1;
+                sqlite3_reset(del_vec[k]);
+
+                sqlite3_bind_int64(ins_vec[k], 1, ids[i]);
+                sqlite3_bind_blob(ins_vec[k], 2, vecs + (size_t)v * (size_t)mem->embed_dim,
+                                  mem->embed_dim * (int)sizeof(float), SQLITE_STATIC);
+                if (rc == 0 && sqlite3_step(ins_vec[k]) != SQLITE_DONE) rc = -1;
+                sqlite3_reset(ins_vec[k]);
+                v++;
+            }
+            sqlite3_bind_int(del_q, 1, k);
+            sqlite3_bind_int64(del_q, 2, ids[i]);
+            if (rc == 0 && sqlite3_step(del_q) != SQLITE_DONE) rc = -1;
+            sqlite3_reset(del_q);
+        }
+
+        for (int k = 0; k < 2; k++) {
+            sqlite3_finalize(del_vec[k]);
+            sqlite3_finalize(ins_vec[k]);
+        }
+        sqlite3_finalize(del_q);
+        sqlite3_exec(db, rc == 0 ? "COMMIT;" : "ROLLBACK;", NULL, NULL, NULL);
+    }
+
+    free(vecs);
+    for (int i = 0; i < n; i++) free(texts[i]);
+    return rc == 0 ? n : -1;
+}
+
+int neuronos_memory_embed_flush(neuronos_memory_t * mem) {
+    if (!mem || !mem->db || !mem->embed) return -1;
+    int total = 0;
+    int n;
+    while ((n = embed_batch(mem, mem->db)) > 0) total += n;
+    return n < 0 ? -1 : total;
+}
+
+/* ---- Background worker: embeds queued rows on its own connection ---- */
+
+static bool embed_worker_wait(neuronos_memory_t * mem) {
+    mem_mutex_lock(&mem->worker_lock);
+    while (!mem->worker_kick && !mem->worker_stop) {
+        mem_cond_wait(&mem->worker_cond, &mem->worker_lock);
+    }
+    mem->worker_kick = false;
+    bool stop = mem->worker_stop;
+    mem_mutex_unlock(&mem->worker_lock);
+    return !stop;
+}
+
+static bool embed_worker_stopping(neuronos_memory_t * mem) {
+    mem_mutex_lock(&mem->worker_lock);
+    bool stop = mem->worker_stop;
+    mem_mutex_unlock(&mem->worker_lock);
+    return stop;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI embed_worker_main(LPVOID arg) {
+#else
+static void * embed_worker_main(void * arg) {
+#endif
+    neuronos_memory_t * mem = arg;
+    sqlite3 * db = memory_db_open(mem->path);
+    while (embed_worker_wait(mem)) {
+        /* An embedder error leaves the rows queued until the next write */
+        while (db && !embed_worker_stopping(mem) && embed_batch(mem, db) > 0) {
+        }
+    }
+    sqlite3_close(db);
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/* Start the worker for file databases. An in-memory database is private
+ * to its connection, so its rows are embedded at search time instead. */
+static void embed_worker_start(neuronos_memory_t * mem) {
+    if (mem->worker_running || strcmp(mem->path, ":memory:") == 0) return;
+    mem->worker_stop = false;
+    mem->worker_kick = true; /* catch up on rows queued while detached */
+#ifdef _WIN32
+    mem->worker = CreateThread(NULL, 0, embed_worker_main, mem, 0, NULL);
+    mem->worker_running = mem->worker != NULL;
+#else
+    mem->worker_running = pthread_create(&mem->worker, NULL, embed_worker_main, mem) == 0;
+#endif
+}
+
+static void embed_worker_stop(neuronos_memory_t * mem) {
+    if (!mem->worker_running) return;
+    mem_mutex_lock(&mem->worker_lock);
+    mem->worker_stop = true;
+    mem_cond_signal(&mem->worker_cond);
+    mem_mutex_unlock(&mem->worker_lock);
+#ifdef _WIN32
+    WaitForSingleObject(mem->worker, INFINITE);
+    CloseHandle(mem->worker);
+#else
+    pthread_join(mem->worker, NULL);
+#endif
+    mem->worker_running = false;
+}
+
+/* Wake the worker after a write that queued a row */
+static void embed_kick(neuronos_memory_t * mem) {
+    if (!mem->worker_running) return;
+    mem_mutex_lock(&mem->worker_lock);
+    mem->worker_kick = true;
+    mem_cond_signal(&mem->worker_cond);
+    mem_mutex_unlock(&mem->worker_lock);
+}
+
+int neuronos_memory_set_embedder(neuronos_memory_t * mem, const char * name, int dim, neuronos_embed_fn fn,
+                                 void * user_data) {
+    if (!mem || !mem->db) return -1;
+    embed_worker_stop(mem);
+    mem->embed = NULL;
+    if (!fn) return 0;
+    if (dim <= 0 || dim > EMBED_MAX_DIM) return -1;
+
+    /* Vectors from another model (or size) are not comparable: rebuild */
+    char model_id[320];
+    snprintf(model_id, sizeof(model_id), "%s:%d", name ? name : "", dim);
+    bool reset = true;
+    sqlite3_stmt * stmt = NULL;
+    if (sqlite3_prepare_v2(mem->db, "SELECT value FROM memory_meta WHERE key = 'embed_model';",
+                           -1, &stmt, NULL) == SQLITE_OK) {
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            const char * stored = (const char *)sqlite3_column_text(stmt, 0);
+            reset = !stored || strcmp(stored, model_id) != 0;
+        }
+        sqlite3_finalize(stmt);
+    }
+
+    if (reset) {
+        /* The vec tables are recreated; drop their statements with them */
+        mem_mutex_lock(&mem->stmt_lock);
+        for (int i = STMT_EAGER_COUNT; i < STMT_COUNT; i++) {
+            sqlite3_finalize(mem->stmts[i]);
+            mem->stmts[i] = NULL;
+        }
+        mem_mutex_unlock(&mem->stmt_lock);
+
+        char sql[1024];
+        snprintf(sql, sizeof(sql),
+                 "BEGIN IMMEDIATE;"
+                 "DROP TABLE IF EXISTS archival_vec;"
+                 "DROP TABLE IF EXISTS recall_vec;"
+                 "CREATE VIRTUAL TABLE archival_vec USING vec0(embedding float[%d]);"
+                 "CREATE VIRTUAL TABLE recall_vec USING vec0(embedding float[%d]);"
+                 "DELETE FROM embed_queue;"
+                 "INSERT INTO embed_queue(kind, row_id) SELECT 0, id FROM archival_memory;"
+                 "INSERT INTO embed_queue(kind, row_id) SELECT 1, id FROM recall_memory;",
+                 dim, dim);
+        char * err_msg = NULL;
+        int rc = sqlite3_exec(mem->db, sql, NULL, NULL, &err_msg);
+        if (rc == SQLITE_OK) {
+            rc = sqlite3_prepare_v2(mem->db,
+                                    "INSERT OR REPLACE INTO memory_meta(key, value) VALUES('embed_model', ?1);",
+                                    -1, &stmt, NULL);
+            if (rc == SQLITE_OK) {
+                sqlite3_bind_text(stmt, 1, model_id, -1, SQLITE_TRANSIENT);
+                rc = sqlite3_step(stmt) == SQLITE_DONE ? SQLITE_OK : SQLITE_ERROR;
+                sqlite3_finalize(stmt);
+            }
+        }
+        if (rc == SQLITE_OK) rc = sqlite3_exec(mem->db, "COMMIT;", NULL, NULL, &err_msg);
+        if (rc != SQLITE_OK) {
+            fprintf(stderr, "[neuronos-memory] Embedding schema error: %s\n",
+                    err_msg ? err_msg : sqlite3_errmsg(mem->db));
+            sqlite3_free(err_msg);
+            sqlite3_exec(mem->db, "ROLLBACK;", NULL, NULL, NULL);
+            return -1;
+        }
+    }
+
+    char * err_msg = NULL;
+    if (sqlite3_exec(mem->db, EMBED_TRIGGERS, NULL, NULL, &err_msg) != SQLITE_OK) {
+        fprintf(stderr, "[neuronos-memory] Embedding schema error: %s\n", err_msg ? err_msg : "unknown");
+        sqlite3_free(err_msg);
+        return -1;
+    }
+
+    mem->embed = fn;
+    mem->embed_data = user_data;
+    mem->embed_dim = dim;
+    embed_worker_start(mem);
+    return 0;
+}
+
+/* ---- Hybrid ranking ---- */
+
+typedef struct {
+    int64_t id;
+    double score;
+} rrf_hit_t;
+
+static void rrf_add(rrf_hit_t * hits, int * n_hits, int64_t id, int rank) {
+    double score = 1.0 / (double)(RRF_K + rank + 1);
+    for (int i = 0; i < *n_hits; i++) {
+        if (hits[i].id == id) {
+            hits[i].score += score;
+            return;
+        }
+    }
+    hits[*n_hits].id = id;
+    hits[*n_hits].score = score;
+    (*n_hits)++;
+}
+
+static int rrf_cmp(const void * a, const void * b) {
+    const rrf_hit_t * x = a;
+    const rrf_hit_t * y = b;
+    if (x->score != y->score) return x->score < y->score ? 1 : -1;
+    return (x->id < y->id) - (x->id > y->id); /* ties: newer first */
+}
+
+/*
+ * Rank row ids for query by reciprocal rank fusion of the FTS5 ranking
+ * (fts_sql: ?1 = query, ?2 = limit) and the nearest neighbours in the
+ * vec0 table of `kind`. Either ranking may come up empty, e.g. when the
+ * query is not valid FTS5 syntax. Returns the number of ids in out.
+ */
+static int hybrid_rank(neuronos_memory_t * mem, int kind, const char * query, int max_results, int64_t * out) {
+    static const mem_stmt_id_t fts_ids[2] = {STMT_ARCHIVAL_FTS_IDS, STMT_RECALL_FTS_IDS};
+    static const mem_stmt_id_t knn_ids[2] = {STMT_ARCHIVAL_KNN, STMT_RECALL_KNN};
+
+    /* Rows written since the last search have no worker to embed them */
+    if (!mem->worker_running) neuronos_memory_embed_flush(mem);
+
+    int pool = max_results * HYBRID_POOL;
+    rrf_hit_t * hits = calloc((size_t)pool * 2, sizeof(rrf_hit_t));
+    float * qvec = malloc((size_t)mem->embed_dim * sizeof(float));
+    if (!hits || !qvec) {
+        free(hits);
+        free(qvec);
+        return 0;
+    }
+    int n_hits = 0;
+
+    sqlite3_stmt * stmt = stmt_acquire(mem, fts_ids[kind]);
+    if (stmt) {
+        sqlite3_bind_text(stmt, 1, query, -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(stmt, 2, pool);
+        for (int rank = 0; rank < pool && sqlite3_step(stmt) == SQLITE_ROW; rank++) {
+            rrf_add(hits, &n_hits, sqlite3_column_int64(stmt, 0), rank);
+        }
+        stmt_release(mem, stmt);
+    }
+
+    /* Embed outside the statement lock — the embedder may take a while */
+    const char * texts[1] = {query};
+    if (embed_texts(mem, texts, 1, qvec) == 0 && (stmt = stmt_acquire(mem, knn_ids[kind])) != NULL) {
+        sqlite3_bind_blob(stmt, 1, qvec, mem->embed_dim * (int)sizeof(float), SQLITE_STATIC);
+        sqlite3_bind_int(stmt, 2, pool);
+        for (int rank = 0; rank < pool && sqlite3_step(stmt) == SQLITE_ROW; rank++) {
+            rrf_add(hits, &n_hits, sqlite3_column_int64(stmt, 0), rank);
+        }
+        stmt_release(mem, stmt);
+    }
+    free(qvec);
+
+    qsort(hits, (size_t)n_hits, sizeof(rrf_hit_t), rrf_cmp);
+    int n = n_hits < max_results ? n_hits : max_results;
+    for (int i = 0; i < n; i++) out[i] = hits[i].id;
+    free(hits);
+    return n;
+}
+
+static int recall_search_hybrid(neuronos_memory_t * mem, const char * query, int max_results,
+                                neuronos_recall_entry_t ** out_entries, int * out_count) {
+    if (max_results <= 0) max_results = 10;
+    int64_t * ids = malloc((size_t)max_results * sizeof(int64_t));
+    neuronos_recall_entry_t * entries = calloc((size_t)max_results, sizeof(neuronos_recall_entry_t));
+    if (!ids || !entries) {
+        free(ids);
+        free(entries);
+        return -1;
+    }
+
+    int n = hybrid_rank(mem, EMBED_RECALL, query, max_results, ids);
+    int count = 0;
+    sqlite3_stmt * stmt = n > 0 ? stmt_acquire(mem, STMT_RECALL_BY_ID) : NULL;
+    if (stmt) {
+        for (int i = 0; i < n; i++) {
+            sqlite3_bind_int64(stmt, 1, ids[i]);
+            if (sqlite3_step(stmt) == SQLITE_ROW) recall_read_row(stmt, &entries[count++]);
+            sqlite3_reset(stmt);
+        }
+        stmt_release(mem, stmt);
+    }
+    free(ids);
+
+    *out_entries = entries;
+    *out_count = count;
+    return 0;
+}
+
+static int archival_search_hybrid(neuronos_memory_t * mem, const char * query, int max_results,
+                                  neuronos_archival_entry_t ** out_entries, int * out_count) {
+    if (max_results <= 0) max_results = 10;
+    int64_t * ids = malloc((size_t)max_results * sizeof(int64_t));
+    neuronos_archival_entry_t * entries = calloc((size_t)max_results, sizeof(neuronos_archival_entry_t));
+    if (!ids || !entries) {
+        free(ids);
+        free(entries);
+        return -1;
+    }
+
+    int n = hybrid_rank(mem, EMBED_ARCHIVAL, query, max_results, ids);
+    int count = 0;
+    sqlite3_stmt * stmt = n > 0 ? stmt_acquire(mem, STMT_ARCHIVAL_BY_ID) : NULL;
+    if (stmt) {
+        for (int i = 0; i < n; i++) {
+            sqlite3_bind_int64(stmt, 1, ids[i]);
+            if (sqlite3_step(stmt) == SQLITE_ROW) archival_read_row(stmt, &entries[count++]);
+            sqlite3_reset(stmt);
+        }
+        stmt_release(mem, stmt);
+    }
+    free(ids);
+
+    *out_entries = entries;
+    *out_count = count;
     return 0;
 }
 
@@ -705,20 +1756,15 @@ int neuronos_memory_archival_stats(neuronos_memory_t * mem, int * out_fact_count
 int64_t neuronos_memory_session_create(neuronos_memory_t * mem) {
     if (!mem || !mem->db) return -1;
 
-    const char * sql = "INSERT INTO sessions(title) VALUES('');";
-    sqlite3_stmt * stmt = NULL;
-    int rc = sqlite3_prepare_v2(mem->db, sql, -1, &stmt, NULL);
-    if (rc != SQLITE_OK) return -1;
+    sqlite3_stmt * stmt = stmt_acquire(mem, STMT_SESSION_CREATE);
+    if (!stmt) return -1;
 
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+    int64_t sid = -1;
+    if (sqlite3_step(stmt) == SQLITE_DONE) sid = sqlite3_last_insert_rowid(mem->db);
+    stmt_release(mem, stmt);
 
-    if (rc == SQLITE_DONE) {
-        int64_t sid = sqlite3_last_insert_rowid(mem->db);
-        mem->current_session_id = sid;
-        return sid;
-    }
-    return -1;
+    if (sid >= 0) mem->current_session_id = sid;
+    return sid;
 }
 
 /* ============================================================
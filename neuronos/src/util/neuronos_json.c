@@ -11,6 +11,11 @@
  *   - All public functions build on nj_find_key().
  *   - String skip handles \", \\, and all escape sequences.
  *   - Object/array extraction counts brace/bracket depth.
+ *   - nj_parse() builds an offset tape in one pass for callers
+ *     that read many fields; string bodies are located with a
+ *     16/32-byte SIMD scan (SSE2/AVX2/NEON) when available.
+ *   - nj_writer_t appends JSON with escaping done in place;
+ *     nj_escape() and nj_canonical() share its buffer code.
  *
  * Copyright (c) 2025 NeuronOS Project
  * SPDX-License-Identifier: MIT
@@ -19,10 +24,23 @@
 #include "neuronos/neuronos_json.h"
 
 #include <ctype.h>
+#include <math.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 /* ──────────────────────────────────────────────────────────────
  * Internal: skip helpers
  * ────────────────────────────────────────────────────────────── */
@@ -154,6 +172,167 @@ const char * nj_skip_value(const char * p) {
     }
 }
 
+/* ──────────────────────────────────────────────────────────────
+ * Internal: output buffer, escaping, unescaping
+ * ────────────────────────────────────────────────────────────── */
+
+/* Append n bytes, keeping the buffer NUL-terminated */
+static int nj_w_put(nj_writer_t * w, const char * p, size_t n) {
+    if (w->failed)
+        return -1;
+    if (w->len + n + 1 > w->cap) {
+        size_t cap = w->cap ? w->cap : 64;
+        while (w->len + n + 1 > cap)
+            cap *= 2;
+        char * s = realloc(w->s, cap);
+        if (!s) {
+            w->failed = 1;
+            return -1;
+        }
+        w->s = s;
+        w->cap = cap;
+    }
+    memcpy(w->s + w->len, p, n);
+    w->len += n;
+    w->s[w->len] = '\0';
+    return 0;
+}
+
+/* Append s[0..n) escaped (no quotes); runs of plain bytes are copied whole */
+static int nj_w_escape(nj_writer_t * w, const char * s, size_t n) {
+    static const char hex[] = "0123456789abcdef";
+    size_t run = 0;
+    for (size_t i = 0; i < n; i++) {
+        unsigned char c = (unsigned char)s[i];
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+        if (nj_w_put(w, s + run, i - run) < 0)
+            return -1;
+        char esc[6] = {'\\', 0};
+        size_t elen = 2;
+        switch (c) {
+            case '"':
+                esc[1] = '"';
+                break;
+            case '\\':
+                esc[1] = '\\';
+                break;
+            case '\n':
+                esc[1] = 'n';
+                break;
+            case '\r':
+                esc[1] = 'r';
+                break;
+            case '\t':
+                esc[1] = 't';
+                break;
+            case '\b':
+                esc[1] = 'b';
+                break;
+            case '\f':
+                esc[1] = 'f';
+                break;
+            default:
+                memcpy(esc + 1, "u00", 3);
+                esc[4] = hex[c >> 4];
+                esc[5] = hex[c & 0xf];
+                elen = 6;
+                break;
+        }
+        if (nj_w_put(w, esc, elen) < 0)
+            return -1;
+        run = i + 1;
+    }
+    return nj_w_put(w, s + run, n - run);
+}
+
+static int hex4(const char * p) {
+    int v = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = p[i];
+        v <<= 4;
+        if (c >= '0' && c <= '9')
+            v |= c - '0';
+        else if (c >= 'a' && c <= 'f')
+            v |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            v |= c - 'A' + 10;
+        else
+            return -1;
+    }
+    return v;
+}
+
+/* Unescape s[0..len) into out (at most len bytes); returns bytes written.
+ * \uXXXX (and surrogate pairs) become UTF-8; unknown escapes are kept. */
+static size_t nj_unescape_span(const char * s, size_t len, char * out) {
+    size_t j = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (s[i] != '\\' || i + 1 >= len) {
+            out[j++] = s[i];
+            continue;
+        }
+        char simple = 0;
+        switch (s[i + 1]) {
+            case 'n':
+                simple = '\n';
+                break;
+            case 't':
+                simple = '\t';
+                break;
+            case 'r':
+                simple = '\r';
+                break;
+            case 'b':
+                simple = '\b';
+                break;
+            case 'f':
+                simple = '\f';
+                break;
+            case '"':
+            case '\\':
+            case '/':
+                simple = s[i + 1];
+                break;
+        }
+        if (simple) {
+            out[j++] = simple;
+            i++;
+            continue;
+        }
+        int cp = (s[i + 1] == 'u' && i + 6 <= len) ? hex4(s + i + 2) : -1;
+        if (cp < 0) {
+            out[j++] = s[i];
+            continue;
+        }
+        size_t used = 6;
+        if (cp >= 0xD800 && cp <= 0xDBFF && i + 12 <= len && s[i + 6] == '\\' && s[i + 7] == 'u') {
+            int lo = hex4(s + i + 8);
+            if (lo >= 0xDC00 && lo <= 0xDFFF) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                used = 12;
+            }
+        }
+        if (cp < 0x80) {
+            out[j++] = (char)cp;
+        } else if (cp < 0x800) {
+            out[j++] = (char)(0xC0 | (cp >> 6));
+            out[j++] = (char)(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out[j++] = (char)(0xE0 | (cp >> 12));
+            out[j++] = (char)(0x80 | ((cp >> 6) & 0x3F));
+            out[j++] = (char)(0x80 | (cp & 0x3F));
+        } else {
+            out[j++] = (char)(0xF0 | (cp >> 18));
+            out[j++] = (char)(0x80 | ((cp >> 12) & 0x3F));
+            out[j++] = (char)(0x80 | ((cp >> 6) & 0x3F));
+            out[j++] = (char)(0x80 | (cp & 0x3F));
+        }
+        i += used - 1;
+    }
+    return j;
+}
+
 /* ──────────────────────────────────────────────────────────────
  * Internal: find key in JSON
  *
@@ -319,58 +498,7 @@ int nj_copy_str(const char * json, const char * key, char * buf, size_t bufsize)
 }
 
 char * nj_escape(const char * s) {
-    if (!s)
-        return strdup("null");
-
-    size_t slen = strlen(s);
-    /* Worst case: every char becomes \uXXXX (6 chars) + NUL */
-    size_t cap = slen * 6 + 1;
-    char * out = malloc(cap);
-    if (!out)
-        return NULL;
-
-    size_t j = 0;
-    for (size_t i = 0; s[i] && j < cap - 6; i++) {
-        switch (s[i]) {
-            case '"':
-                out[j++] = '\\';
-                out[j++] = '"';
-                break;
-            case '\\':
-                out[j++] = '\\';
-                out[j++] = '\\';
-                break;
-            case '\n':
-                out[j++] = '\\';
-                out[j++] = 'n';
-                break;
-            case '\r':
-                out[j++] = '\\';
-                out[j++] = 'r';
-                break;
-            case '\t':
-                out[j++] = '\\';
-                out[j++] = 't';
-                break;
-            case '\b':
-                out[j++] = '\\';
-                out[j++] = 'b';
-                break;
-            case '\f':
-                out[j++] = '\\';
-                out[j++] = 'f';
-                break;
-            default:
-                if ((unsigned char)s[i] < 0x20) {
-                    j += (size_t)snprintf(out + j, cap - j, "\\u%04x", (unsigned char)s[i]);
-                } else {
-                    out[j++] = s[i];
-                }
-                break;
-        }
-    }
-    out[j] = '\0';
-    return out;
+    return nj_escape_n(s, (size_t)-1);
 }
 
 int nj_find_bool(const char * json, const char * key, int fallback) {
@@ -411,57 +539,16 @@ char * nj_escape_n(const char * s, size_t max_len) {
     if (!s)
         return strdup("null");
 
-    size_t slen = strlen(s);
-    if (max_len < slen)
-        slen = max_len;
+    size_t slen = 0; /* s need not be NUL-terminated within max_len */
+    while (slen < max_len && s[slen])
+        slen++;
 
-    size_t cap = slen * 6 + 1;
-    char * out = malloc(cap);
-    if (!out)
+    nj_writer_t w = {0};
+    if (nj_w_put(&w, "", 0) < 0 || nj_w_escape(&w, s, slen) < 0) {
+        free(w.s);
         return NULL;
-
-    size_t j = 0;
-    for (size_t i = 0; i < slen && s[i] && j < cap - 6; i++) {
-        switch (s[i]) {
-            case '"':
-                out[j++] = '\\';
-                out[j++] = '"';
-                break;
-            case '\\':
-                out[j++] = '\\';
-                out[j++] = '\\';
-                break;
-            case '\n':
-                out[j++] = '\\';
-                out[j++] = 'n';
-                break;
-            case '\r':
-                out[j++] = '\\';
-                out[j++] = 'r';
-                break;
-            case '\t':
-                out[j++] = '\\';
-                out[j++] = 't';
-                break;
-            case '\b':
-                out[j++] = '\\';
-                out[j++] = 'b';
-                break;
-            case '\f':
-                out[j++] = '\\';
-                out[j++] = 'f';
-                break;
-            default:
-                if ((unsigned char)s[i] < 0x20) {
-                    j += (size_t)snprintf(out + j, cap - j, "\\u%04x", (unsigned char)s[i]);
-                } else {
-                    out[j++] = s[i];
-                }
-                break;
-        }
     }
-    out[j] = '\0';
-    return out;
+    return w.s;
 }
 
 char * nj_unescape(const char * s) {
@@ -471,51 +558,629 @@ char * nj_unescape(const char * s) {
     char * out = malloc(len + 1);
     if (!out)
         return NULL;
+    out[nj_unescape_span(s, len, out)] = '\0';
+    return out;
+}
 
-    size_t j = 0;
-    for (size_t i = 0; i < len; i++) {
-        if (s[i] == '\\' && i + 1 < len) {
-            switch (s[i + 1]) {
-                case 'n':
-                    out[j++] = '\n';
-                    i++;
-                    break;
-                case 't':
-                    out[j++] = '\t';
-                    i++;
-                    break;
-                case 'r':
-                    out[j++] = '\r';
-                    i++;
-                    break;
-                case '"':
-                    out[j++] = '"';
-                    i++;
-                    break;
-                case '\\':
-                    out[j++] = '\\';
-                    i++;
-                    break;
-                case '/':
-                    out[j++] = '/';
-                    i++;
-                    break;
-                case 'b':
-                    out[j++] = '\b';
-                    i++;
-                    break;
-                case 'f':
-                    out[j++] = '\f';
-                    i++;
-                    break;
-                default:
-                    out[j++] = s[i];
-                    break;
+/* ──────────────────────────────────────────────────────────────
+ * Canonical form
+ * ────────────────────────────────────────────────────────────── */
+
+#define NJ_CANON_MAX_DEPTH 64
+
+typedef struct {
+    const char * key; /* including quotes */
+    size_t key_len;
+    const char * value;
+} nj_member_t;
+
+static int member_cmp(const void * a, const void * b) {
+    const nj_member_t * x = a;
+    const nj_member_t * y = b;
+    size_t n = x->key_len < y->key_len ? x->key_len : y->key_len;
+    int c = memcmp(x->key, y->key, n);
+    if (c)
+        return c;
+    if (x->key_len != y->key_len)
+        return x->key_len < y->key_len ? -1 : 1;
+    return x->value < y->value ? -1 : x->value > y->value; /* duplicates keep text order */
+}
+
+/* Append the canonical form of the value at p; returns the end of the value or NULL */
+static const char * canon_value(nj_writer_t * b, const char * p, int depth) {
+    p = nj_skip_ws(p);
+    if (!p || depth > NJ_CANON_MAX_DEPTH)
+        return NULL;
+
+    if (*p == '[') {
+        if (nj_w_put(b, "[", 1) < 0)
+            return NULL;
+        p = nj_skip_ws(p + 1);
+        for (int i = 0; *p != ']'; i++) {
+            if (i) {
+                if (*p != ',' || nj_w_put(b, ",", 1) < 0)
+                    return NULL;
+                p++;
             }
-        } else {
-            out[j++] = s[i];
+            p = canon_value(b, p, depth + 1);
+            if (!p)
+                return NULL;
+            p = nj_skip_ws(p);
+        }
+        return nj_w_put(b, "]", 1) < 0 ? NULL : p + 1;
+    }
+
+    if (*p == '{') {
+        nj_member_t * m = NULL;
+        int n = 0, cap = 0;
+        p = nj_skip_ws(p + 1);
+        while (*p != '}') {
+            if (n && *p++ != ',')
+                goto bad;
+            p = nj_skip_ws(p);
+            const char * key_end = skip_string(p);
+            if (!key_end)
+                goto bad;
+            const char * colon = nj_skip_ws(key_end);
+            if (*colon != ':')
+                goto bad;
+            const char * value = nj_skip_ws(colon + 1);
+            const char * value_end = nj_skip_value(value);
+            if (!value_end)
+                goto bad;
+            if (n == cap) {
+                cap = cap ? cap * 2 : 8;
+                nj_member_t * grown = realloc(m, (size_t)cap * sizeof(*m));
+                if (!grown)
+                    goto bad;
+                m = grown;
+            }
+            m[n].key = p;
+            m[n].key_len = (size_t)(key_end - p);
+            m[n].value = value;
+            n++;
+            p = nj_skip_ws(value_end);
         }
+        qsort(m, (size_t)n, sizeof(*m), member_cmp);
+
+        if (nj_w_put(b, "{", 1) < 0)
+            goto bad;
+        for (int i = 0; i < n; i++) {
+            if ((i && nj_w_put(b, ",", 1) < 0) || nj_w_put(b, m[i].key, m[i].key_len) < 0 ||
+                nj_w_put(b, ":", 1) < 0 || !canon_value(b, m[i].value, depth + 1))
+                goto bad;
+        }
+        free(m);
+        return nj_w_put(b, "}", 1) < 0 ? NULL : p + 1;
+    bad:
+        free(m);
+        return NULL;
     }
-    out[j] = '\0';
+
+    const char * end = nj_skip_value(p);
+    if (!end || nj_w_put(b, p, (size_t)(end - p)) < 0)
+        return NULL;
+    return end;
+}
+
+char * nj_canonical(const char * json) {
+    nj_writer_t b = {0};
+    const char * end = canon_value(&b, json, 0);
+    if (!end || *nj_skip_ws(end)) {
+        free(b.s);
+        return NULL;
+    }
+    return b.s;
+}
+
+/* ──────────────────────────────────────────────────────────────
+ * Doc: one-pass tokenizer into an offset tape
+ * ────────────────────────────────────────────────────────────── */
+
+#define NJ_PARSE_MAX_DEPTH 256
+
+static inline int nj_ctz32(uint32_t m) {
+#ifdef _MSC_VER
+    unsigned long i;
+    _BitScanForward(&i, m);
+    return (int)i;
+#else
+    return __builtin_ctz(m);
+#endif
+}
+
+/* First '"' or '\\' in [p, end), or end. This is where a parse spends
+ * its time on real payloads (prompts, tool output), so whole blocks of
+ * string body are skipped per compare. */
+static const char * nj_scan_str(const char * p, const char * end) {
+#if defined(__AVX2__)
+    const __m256i q32 = _mm256_set1_epi8('"');
+    const __m256i bs32 = _mm256_set1_epi8('\\');
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)p);
+        uint32_t m = (uint32_t)_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, q32), _mm256_cmpeq_epi8(v, bs32)));
+        if (m)
+            return p + nj_ctz32(m);
+        p += 32;
+    }
+#endif
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+    const __m128i q = _mm_set1_epi8('"');
+    const __m128i bs = _mm_set1_epi8('\\');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(const void *)p);
+        uint32_t m = (uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, q), _mm_cmpeq_epi8(v, bs)));
+        if (m)
+            return p + nj_ctz32(m);
+        p += 16;
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t q = vdupq_n_u8('"');
+    const uint8x16_t bs = vdupq_n_u8('\\');
+    while (end - p >= 16) {
+        uint8x16_t v = vld1q_u8((const uint8_t *)p);
+        uint8x16_t hit = vorrq_u8(vceqq_u8(v, q), vceqq_u8(v, bs));
+        /* narrow to 4 bits per byte so the mask fits a u64 */
+        uint64_t m = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hit), 4)), 0);
+        if (m)
+            return p + (__builtin_ctzll(m) >> 2);
+        p += 16;
+    }
+#endif
+    while (p < end && *p != '"' && *p != '\\')
+        p++;
+    return p;
+}
+
+static const char * nj_ws_n(const char * p, const char * end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+        p++;
+    return p;
+}
+
+static int nj_tok_push(nj_doc_t * doc, nj_type_t type, const char * at) {
+    if (doc->n == doc->cap) {
+        int cap = doc->cap ? doc->cap * 2 : 64;
+        nj_tok_t * tok = realloc(doc->tok, (size_t)cap * sizeof(*tok));
+        if (!tok)
+            return -1;
+        doc->tok = tok;
+        doc->cap = cap;
+    }
+    nj_tok_t * t = &doc->tok[doc->n];
+    t->start = (uint32_t)(at - doc->json);
+    t->len = 0;
+    t->next = (uint32_t)doc->n + 1;
+    t->type = (uint8_t)type;
+    t->escaped = 0;
+    return doc->n++;
+}
+
+/* String token for the quote at p; returns the byte after the closing quote */
+static const char * nj_tok_string(nj_doc_t * doc, const char * p, const char * end) {
+    int i = nj_tok_push(doc, NJ_STRING, p + 1);
+    if (i < 0)
+        return NULL;
+    const char * q = p + 1;
+    for (;;) {
+        q = nj_scan_str(q, end);
+        if (q >= end)
+            return NULL;
+        if (*q == '"')
+            break;
+        doc->tok[i].escaped = 1;
+        q += 2;
+    }
+    doc->tok[i].len = (uint32_t)(q - (p + 1));
+    return q + 1;
+}
+
+/* Scalar token (number, true, false, null) at p */
+static const char * nj_tok_scalar(nj_doc_t * doc, const char * p, const char * end) {
+    static const struct {
+        const char * word;
+        nj_type_t type;
+    } lits[] = {{"true", NJ_TRUE}, {"false", NJ_FALSE}, {"null", NJ_NULL}};
+    for (size_t k = 0; k < sizeof(lits) / sizeof(lits[0]); k++) {
+        size_t n = strlen(lits[k].word);
+        if ((size_t)(end - p) >= n && memcmp(p, lits[k].word, n) == 0) {
+            int i = nj_tok_push(doc, lits[k].type, p);
+            if (i < 0)
+                return NULL;
+            doc->tok[i].len = (uint32_t)n;
+            return p + n;
+        }
+    }
+
+    const char * q = p;
+    bool digits = false;
+    if (q < end && *q == '-')
+        q++;
+    while (q < end && ((*q >= '0' && *q <= '9') || *q == '.' || *q == 'e' || *q == 'E' || *q == '+' || *q == '-')) {
+        digits |= (*q >= '0' && *q <= '9');
+        q++;
+    }
+    if (!digits)
+        return NULL;
+    int i = nj_tok_push(doc, NJ_NUMBER, p);
+    if (i < 0)
+        return NULL;
+    doc->tok[i].len = (uint32_t)(q - p);
+    return q;
+}
+
+int nj_parse(nj_doc_t * doc, const char * json, size_t len) {
+    if (!doc)
+        return -1;
+    memset(doc, 0, sizeof(*doc));
+    if (!json || len >= UINT32_MAX)
+        return -1;
+    doc->json = json;
+
+    const char * end = json + len;
+    const char * p = nj_ws_n(json, end);
+    int stack[NJ_PARSE_MAX_DEPTH];
+    int depth = 0;
+
+value:
+    if (p >= end)
+        goto bad;
+    if (*p == '{' || *p == '[') {
+        bool obj = *p == '{';
+        int i = nj_tok_push(doc, obj ? NJ_OBJECT : NJ_ARRAY, p);
+        if (i < 0 || depth == NJ_PARSE_MAX_DEPTH)
+            goto bad;
+        stack[depth++] = i;
+        p = nj_ws_n(p + 1, end);
+        if (p < end && *p == (obj ? '}' : ']'))
+            goto close;
+        if (obj)
+            goto key;
+        goto value;
+    }
+    p = *p == '"' ? nj_tok_string(doc, p, end) : nj_tok_scalar(doc, p, end);
+    if (!p)
+        goto bad;
+
+after:
+    p = nj_ws_n(p, end);
+    if (depth == 0) {
+        if (p != end)
+            goto bad;
+        return 0;
+    }
+    if (p >= end)
+        goto bad;
+    if (*p == ',') {
+        p = nj_ws_n(p + 1, end);
+        if (doc->tok[stack[depth - 1]].type == NJ_OBJECT)
+            goto key;
+        goto value;
+    }
+    if (*p != (doc->tok[stack[depth - 1]].type == NJ_OBJECT ? '}' : ']'))
+        goto bad;
+
+close: {
+    nj_tok_t * c = &doc->tok[stack[--depth]];
+    c->len = (uint32_t)(p + 1 - (json + c->start));
+    c->next = (uint32_t)doc->n;
+    p++;
+    goto after;
+}
+
+key:
+    if (p >= end || *p != '"')
+        goto bad;
+    p = nj_tok_string(doc, p, end);
+    if (!p)
+        goto bad;
+    p = nj_ws_n(p, end);
+    if (p >= end || *p != ':')
+        goto bad;
+    p = nj_ws_n(p + 1, end);
+    goto value;
+
+bad:
+    nj_doc_free(doc);
+    return -1;
+}
+
+void nj_doc_free(nj_doc_t * doc) {
+    if (!doc)
+        return;
+    free(doc->tok);
+    doc->tok = NULL;
+    doc->n = doc->cap = 0;
+}
+
+static inline const nj_tok_t * nj_node(const nj_doc_t * doc, int node) {
+    return (doc && node >= 0 && node < doc->n) ? &doc->tok[node] : NULL;
+}
+
+nj_type_t nj_type(const nj_doc_t * doc, int node) {
+    const nj_tok_t * t = nj_node(doc, node);
+    return t ? (nj_type_t)t->type : NJ_NULL;
+}
+
+int nj_get(const nj_doc_t * doc, int obj, const char * key) {
+    const nj_tok_t * o = nj_node(doc, obj);
+    if (!o || o->type != NJ_OBJECT || !key)
+        return -1;
+    size_t klen = strlen(key);
+    for (int k = obj + 1; k < (int)o->next; k = (int)doc->tok[k + 1].next) {
+        const nj_tok_t * t = &doc->tok[k];
+        if (t->escaped ? nj_str_eq(doc, k, key)
+                       : (t->len == klen && memcmp(doc->json + t->start, key, klen) == 0))
+            return k + 1;
+    }
+    return -1;
+}
+
+int nj_first(const nj_doc_t * doc, int node) {
+    const nj_tok_t * t = nj_node(doc, node);
+    if (!t || (t->type != NJ_ARRAY && t->type != NJ_OBJECT) || (int)t->next == node + 1)
+        return -1;
+    return t->type == NJ_OBJECT ? node + 2 : node + 1;
+}
+
+int nj_next(const nj_doc_t * doc, int node, int child) {
+    const nj_tok_t * t = nj_node(doc, node);
+    const nj_tok_t * c = nj_node(doc, child);
+    if (!t || !c || child <= node)
+        return -1;
+    int j = (int)c->next;
+    if (j >= (int)t->next)
+        return -1;
+    return t->type == NJ_OBJECT ? j + 1 : j;
+}
+
+int nj_count(const nj_doc_t * doc, int node) {
+    int n = 0;
+    for (int c = nj_first(doc, node); c >= 0; c = nj_next(doc, node, c))
+        n++;
+    return n;
+}
+
+const char * nj_str(const nj_doc_t * doc, int node, int * out_len) {
+    const nj_tok_t * t = nj_node(doc, node);
+    if (!t || t->type != NJ_STRING)
+        return NULL;
+    if (out_len)
+        *out_len = (int)t->len;
+    return doc->json + t->start;
+}
+
+char * nj_str_dup(const nj_doc_t * doc, int node) {
+    const nj_tok_t * t = nj_node(doc, node);
+    if (!t || t->type != NJ_STRING)
+        return NULL;
+    char * out = malloc((size_t)t->len + 1);
+    if (!out)
+        return NULL;
+    const char * src = doc->json + t->start;
+    size_t n = t->escaped ? nj_unescape_span(src, t->len, out) : (memcpy(out, src, t->len), t->len);
+    out[n] = '\0';
+    return out;
+}
+
+int nj_str_copy(const nj_doc_t * doc, int node, char * buf, size_t bufsize) {
+    const nj_tok_t * t = nj_node(doc, node);
+    if (!t || t->type != NJ_STRING || !buf || bufsize == 0)
+        return -1;
+    const char * src = doc->json + t->start;
+    size_t n;
+    if (!t->escaped) {
+        n = t->len < bufsize - 1 ? t->len : bufsize - 1;
+        memcpy(buf, src, n);
+    } else {
+        char * full = nj_str_dup(doc, node);
+        if (!full)
+            return -1;
+        n = strlen(full);
+        if (n > bufsize - 1)
+            n = bufsize - 1;
+        memcpy(buf, full, n);
+        free(full);
+    }
+    buf[n] = '\0';
+    return (int)n;
+}
+
+int nj_str_eq(const nj_doc_t * doc, int node, const char * s) {
+    const nj_tok_t * t = nj_node(doc, node);
+    if (!t || t->type != NJ_STRING || !s)
+        return 0;
+    if (!t->escaped)
+        return t->len == strlen(s) && memcmp(doc->json + t->start, s, t->len) == 0;
+    char * u = nj_str_dup(doc, node);
+    int eq = u && strcmp(u, s) == 0;
+    free(u);
+    return eq;
+}
+
+/* Number text as a NUL-terminated copy (the source may not end there) */
+static bool nj_num_text(const nj_doc_t * doc, int node, char * buf, size_t bufsize) {
+    const nj_tok_t * t = nj_node(doc, node);
+    if (!t || t->type != NJ_NUMBER || t->len >= bufsize)
+        return false;
+    memcpy(buf, doc->json + t->start, t->len);
+    buf[t->len] = '\0';
+    return true;
+}
+
+long long nj_int(const nj_doc_t * doc, int node, long long fallback) {
+    char buf[64];
+    return nj_num_text(doc, node, buf, sizeof(buf)) ? strtoll(buf, NULL, 10) : fallback;
+}
+
+double nj_num(const nj_doc_t * doc, int node, double fallback) {
+    char buf[64];
+    return nj_num_text(doc, node, buf, sizeof(buf)) ? strtod(buf, NULL) : fallback;
+}
+
+int nj_bool(const nj_doc_t * doc, int node, int fallback) {
+    nj_type_t type = nj_type(doc, node);
+    if (node < 0 || (type != NJ_TRUE && type != NJ_FALSE))
+        return fallback;
+    return type == NJ_TRUE;
+}
+
+const char * nj_raw(const nj_doc_t * doc, int node, size_t * out_len) {
+    const nj_tok_t * t = nj_node(doc, node);
+    if (!t)
+        return NULL;
+    bool quoted = t->type == NJ_STRING;
+    if (out_len)
+        *out_len = t->len + (quoted ? 2 : 0);
+    return doc->json + t->start - (quoted ? 1 : 0);
+}
+
+char * nj_raw_dup(const nj_doc_t * doc, int node) {
+    size_t len = 0;
+    const char * raw = nj_raw(doc, node, &len);
+    if (!raw)
+        return NULL;
+    char * out = malloc(len + 1);
+    if (!out)
+        return NULL;
+    memcpy(out, raw, len);
+    out[len] = '\0';
     return out;
 }
+
+/* ──────────────────────────────────────────────────────────────
+ * Writer
+ * ────────────────────────────────────────────────────────────── */
+
+#define NJ_W_MAX_DEPTH 64
+
+/* Separator before a value: nothing after a key, a comma between items */
+static void nj_w_sep(nj_writer_t * w) {
+    if (w->after_key) {
+        w->after_key = 0;
+        return;
+    }
+    if (w->depth == 0)
+        return;
+    uint64_t bit = 1ULL << (w->depth - 1);
+    if (w->has_items & bit)
+        nj_w_put(w, ",", 1);
+    w->has_items |= bit;
+}
+
+static void nj_w_open(nj_writer_t * w, const char * c) {
+    nj_w_sep(w);
+    if (w->depth == NJ_W_MAX_DEPTH) {
+        w->failed = 1;
+        return;
+    }
+    nj_w_put(w, c, 1);
+    w->depth++;
+    w->has_items &= ~(1ULL << (w->depth - 1));
+}
+
+static void nj_w_close(nj_writer_t * w, const char * c) {
+    if (w->depth == 0) {
+        w->failed = 1;
+        return;
+    }
+    w->depth--;
+    nj_w_put(w, c, 1);
+}
+
+void nj_w_obj(nj_writer_t * w) {
+    nj_w_open(w, "{");
+}
+
+void nj_w_obj_end(nj_writer_t * w) {
+    nj_w_close(w, "}");
+}
+
+void nj_w_arr(nj_writer_t * w) {
+    nj_w_open(w, "[");
+}
+
+void nj_w_arr_end(nj_writer_t * w) {
+    nj_w_close(w, "]");
+}
+
+void nj_w_key(nj_writer_t * w, const char * key) {
+    nj_w_sep(w);
+    nj_w_put(w, "\"", 1);
+    nj_w_escape(w, key ? key : "", key ? strlen(key) : 0);
+    nj_w_put(w, "\":", 2);
+    w->after_key = 1;
+}
+
+void nj_w_str_n(nj_writer_t * w, const char * s, size_t n) {
+    if (!s) {
+        nj_w_null(w);
+        return;
+    }
+    size_t len = 0;
+    while (len < n && s[len])
+        len++;
+    nj_w_sep(w);
+    nj_w_put(w, "\"", 1);
+    nj_w_escape(w, s, len);
+    nj_w_put(w, "\"", 1);
+}
+
+void nj_w_str(nj_writer_t * w, const char * s) {
+    nj_w_str_n(w, s, (size_t)-1);
+}
+
+void nj_w_int(nj_writer_t * w, long long v) {
+    char buf[32];
+    int n = snprintf(buf, sizeof(buf), "%lld", v);
+    nj_w_sep(w);
+    nj_w_put(w, buf, (size_t)n);
+}
+
+void nj_w_num(nj_writer_t * w, double v) {
+    if (!isfinite(v)) {
+        nj_w_null(w);
+        return;
+    }
+    char buf[32];
+    int n = snprintf(buf, sizeof(buf), "%.15g", v);
+    if (strtod(buf, NULL) != v)
+        n = snprintf(buf, sizeof(buf), "%.17g", v);
+    nj_w_sep(w);
+    nj_w_put(w, buf, (size_t)n);
+}
+
+void nj_w_bool(nj_writer_t * w, int v) {
+    nj_w_sep(w);
+    nj_w_put(w, v ? "true" : "false", v ? 4 : 5);
+}
+
+void nj_w_null(nj_writer_t * w) {
+    nj_w_sep(w);
+    nj_w_put(w, "null", 4);
+}
+
+void nj_w_raw(nj_writer_t * w, const char * json) {
+    if (!json) {
+        nj_w_null(w);
+        return;
+    }
+    nj_w_sep(w);
+    nj_w_put(w, json, strlen(json));
+}
+
+char * nj_w_finish(nj_writer_t * w) {
+    char * out = w->failed || w->depth ? NULL : w->s;
+    if (!out)
+        free(w->s);
+    else if (!w->s)
+        out = strdup("");
+    memset(w, 0, sizeof(*w));
+    return out;
+}
+
+void nj_w_free(nj_writer_t * w) {
+    free(w->s);
+    memset(w, 0, sizeof(*w));
+}
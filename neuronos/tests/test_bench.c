@@ -0,0 +1,377 @@
+/* ============================================================
+ * NeuronOS — Benchmark Report Test Suite
+ *
+ * `neuronos bench` promises a report two builds can diff key by
+ * key. These tests hold it to that: the keys, their order and the
+ * line layout are checked, and two runs must differ only in values.
+ *
+ * Tests:
+ *  1. No model: nothing written, error returned
+ *  2. Report schema: every section's keys, in order       (model)
+ *  3. Stable layout: a second run changes values only     (model)
+ *  4. Phase selection: gen-only report drops agent/server (model)
+ *
+ * Usage: ./test_bench [path-to-gguf-model]
+ * ============================================================ */
+#include "neuronos/neuronos.h"
+#include "neuronos/neuronos_json.h"
+#include "neuronos_bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET test_sock_t;
+#define TEST_BAD_SOCK INVALID_SOCKET
+#define test_close_sock closesocket
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int test_sock_t;
+#define TEST_BAD_SOCK (-1)
+#define test_close_sock close
+#endif
+
+/* ---- Helpers ---- */
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_START(name)                                                                                               \
+    do {                                                                                                               \
+        tests_run++;                                                                                                   \
+        fprintf(stderr, "\n[TEST %d] %s... ", tests_run, name);                                                        \
+    } while (0)
+
+#define TEST_PASS()                                                                                                    \
+    do {                                                                                                               \
+        tests_passed++;                                                                                                \
+        fprintf(stderr, "PASS ✓\n");                                                                                   \
+    } while (0)
+
+#define TEST_FAIL(msg)                                                                                                 \
+    do {                                                                                                               \
+        tests_failed++;                                                                                                \
+        fprintf(stderr, "FAIL ✗ (%s)\n", msg);                                                                         \
+    } while (0)
+
+/* Reports and docs are released by the caller after a failed check */
+#define ASSERT(cond, msg)                                                                                              \
+    do {                                                                                                               \
+        if (!(cond)) {                                                                                                 \
+            TEST_FAIL(msg);                                                                                            \
+            goto done;                                                                                                 \
+        }                                                                                                              \
+    } while (0)
+
+/* ---- Globals ---- */
+static neuronos_engine_t * g_engine = NULL;
+static neuronos_model_t * g_model = NULL;
+static char * g_report = NULL; /* full-suite report from test 2, reused by test 3 */
+
+/* A port the kernel considers free right now */
+static int free_port(void) {
+    test_sock_t fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd == TEST_BAD_SOCK)
+        return 0;
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    int port = 0;
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0 && getsockname(fd, (struct sockaddr *)&addr, &len) == 0)
+        port = ntohs(addr.sin_port);
+    test_close_sock(fd);
+    return port;
+}
+
+/* Run the suite and return its report (malloc'd), or NULL */
+static char * run_bench(neuronos_model_t * model, unsigned phases, int * rc) {
+    FILE * f = tmpfile();
+    if (!f)
+        return NULL;
+    neuronos_bench_params_t params = {.phases = phases, .host = "127.0.0.1", .port = free_port()};
+    *rc = neuronos_bench_run(model, params, f);
+
+    long len = ftell(f);
+    char * report = len >= 0 ? malloc((size_t)len + 1) : NULL;
+    rewind(f);
+    if (report && fread(report, 1, (size_t)len, f) != (size_t)len) {
+        free(report);
+        report = NULL;
+    }
+    if (report)
+        report[len] = '\0';
+    fclose(f);
+    return report;
+}
+
+/* Does object `obj` have exactly the comma-separated `keys`, in order? */
+static bool keys_are(const nj_doc_t * doc, int obj, const char * keys) {
+    if (nj_type(doc, obj) != NJ_OBJECT)
+        return false;
+    const char * k = keys;
+    for (int v = nj_first(doc, obj); v >= 0; v = nj_next(doc, obj, v)) {
+        int len = 0;
+        const char * name = nj_str(doc, v - 1, &len);
+        size_t want = strcspn(k, ",");
+        if (!name || (size_t)len != want || strncmp(name, k, want) != 0)
+            return false;
+        k += want;
+        if (*k == ',')
+            k++;
+    }
+    return *k == '\0';
+}
+
+/* {"p50":..,"p90":..,"p99":..}: numbers, or null when nothing was measured */
+static bool is_dist(const nj_doc_t * doc, int obj) {
+    if (!keys_are(doc, obj, "p50,p90,p99"))
+        return false;
+    for (int v = nj_first(doc, obj); v >= 0; v = nj_next(doc, obj, v)) {
+        if (nj_type(doc, v) != NJ_NUMBER && nj_type(doc, v) != NJ_NULL)
+            return false;
+    }
+    return true;
+}
+
+/* The report with every scalar masked as '#': what two runs must share.
+ * Each line is one key and value, one array element or one bracket. */
+static char * report_skeleton(const char * report) {
+    size_t n = strlen(report);
+    char * out = malloc(n + 1);
+    if (!out)
+        return NULL;
+    char * o = out;
+    for (const char * line = report; *line;) {
+        const char * eol = strchr(line, '\n');
+        if (!eol)
+            eol = line + strlen(line);
+        const char * v = line;
+        while (v < eol && *v == ' ')
+            v++;
+        if (v < eol && *v == '"') { /* "key": value? */
+            const char * q = memchr(v + 1, '"', (size_t)(eol - v - 1));
+            if (q && q + 2 < eol && q[1] == ':' && q[2] == ' ')
+                v = q + 3;
+        }
+        memcpy(o, line, (size_t)(v - line));
+        o += v - line;
+        if (v < eol && strchr("{}[]", *v)) {
+            memcpy(o, v, (size_t)(eol - v));
+            o += eol - v;
+        } else {
+            *o++ = '#';
+            if (eol > v && eol[-1] == ',')
+                *o++ = ',';
+        }
+        if (*eol == '\n')
+            *o++ = '\n';
+        line = *eol ? eol + 1 : eol;
+    }
+    *o = '\0';
+    return out;
+}
+
+/* ============================================================
+ * TEST 1: No model
+ * ============================================================ */
+static void test_no_model(void) {
+    TEST_START("No model: error, empty report");
+    int rc = 0;
+    char * report = run_bench(NULL, 0, &rc);
+    ASSERT(rc == -1, "expected -1 without a model");
+    ASSERT(report && report[0] == '\0', "something was written");
+    TEST_PASS();
+done:
+    free(report);
+}
+
+/* ============================================================
+ * TEST 2: Report schema
+ * ============================================================ */
+static void test_schema(void) {
+    TEST_START("Report schema: keys and order");
+    nj_doc_t doc = {0};
+    int rc = -1;
+    if (!g_model) {
+        fprintf(stderr, "SKIP (no model)\n");
+        tests_passed++;
+        return;
+    }
+
+    g_report = run_bench(g_model, 0, &rc);
+    ASSERT(g_report && rc >= 0, "suite did not produce a report");
+    ASSERT(nj_parse(&doc, g_report, strlen(g_report)) == 0, "report is not valid JSON");
+    ASSERT(keys_are(&doc, 0, "schema,neuronos_version,model,hardware,suite,rss_after_load_mb,generation,agent,"
+                             "server,peak_rss_mb"),
+           "top-level keys");
+    ASSERT(nj_str_eq(&doc, nj_get(&doc, 0, "schema"), "neuronos-bench/1"), "schema tag");
+    ASSERT(keys_are(&doc, nj_get(&doc, 0, "model"), "description,n_params,size_mb,n_ctx"), "model keys");
+    ASSERT(keys_are(&doc, nj_get(&doc, 0, "hardware"), "cpu,arch,cores_physical,cores_logical,ram_mb"),
+           "hardware keys");
+    int suite = nj_get(&doc, 0, "suite");
+    ASSERT(keys_are(&doc, suite,
+                    "seed,reps,decode_tokens,prompt_lengths,agent_tasks,agent_max_steps,clients,turns_per_client,"
+                    "reply_tokens"),
+           "suite keys");
+
+    /* One sweep point per prompt length: measured, or skipped past the context */
+    int gen = nj_get(&doc, 0, "generation");
+    ASSERT(keys_are(&doc, gen, "points,peak_rss_mb"), "generation keys");
+    int points = nj_get(&doc, gen, "points");
+    ASSERT(nj_count(&doc, points) == nj_count(&doc, nj_get(&doc, suite, "prompt_lengths")),
+           "a sweep point is missing");
+    for (int p = nj_first(&doc, points); p >= 0; p = nj_next(&doc, points, p)) {
+        if (keys_are(&doc, p, "target_prompt_tokens,skipped"))
+            continue;
+        ASSERT(keys_are(&doc, p,
+                        "target_prompt_tokens,prompt_tokens,generated_tokens,reused_tokens,errors,ttft_ms,tpot_ms,"
+                        "prefill_tokens_per_s,decode_tokens_per_s"),
+               "sweep point keys");
+        ASSERT(is_dist(&doc, nj_get(&doc, p, "ttft_ms")) && is_dist(&doc, nj_get(&doc, p, "tpot_ms")) &&
+                   is_dist(&doc, nj_get(&doc, p, "prefill_tokens_per_s")) &&
+                   is_dist(&doc, nj_get(&doc, p, "decode_tokens_per_s")),
+               "sweep point distribution");
+    }
+
+    int agent = nj_get(&doc, 0, "agent");
+    ASSERT(keys_are(&doc, agent,
+                    "tasks,steps,tool_calls,passed,errors,steps_per_s,step_ms,prefix_cache_hit_rate,peak_rss_mb"),
+           "agent keys");
+    ASSERT(is_dist(&doc, nj_get(&doc, agent, "step_ms")), "agent step distribution");
+    int tasks = nj_get(&doc, agent, "tasks");
+    ASSERT(nj_count(&doc, tasks) == nj_int(&doc, nj_get(&doc, suite, "agent_tasks"), -1), "an agent task is missing");
+    for (int t = nj_first(&doc, tasks); t >= 0; t = nj_next(&doc, tasks, t))
+        ASSERT(keys_are(&doc, t, "name,steps,tool_calls,passed,ms"), "agent task keys");
+
+    /* Every concurrency level is reported, even after a failing one */
+    int server = nj_get(&doc, 0, "server");
+    ASSERT(keys_are(&doc, server, "n_slots,levels,peak_rss_mb"), "server keys");
+    int levels = nj_get(&doc, server, "levels");
+    ASSERT(nj_count(&doc, levels) == nj_count(&doc, nj_get(&doc, suite, "clients")), "a client level is missing");
+    for (int l = nj_first(&doc, levels); l >= 0; l = nj_next(&doc, levels, l)) {
+        ASSERT(keys_are(&doc, l,
+                        "clients,requests,errors,ttft_ms,tpot_ms,requests_per_s,tokens_per_s,prompt_tokens,"
+                        "cached_tokens,prefix_cache_hit_rate"),
+               "client level keys");
+        ASSERT(is_dist(&doc, nj_get(&doc, l, "ttft_ms")) && is_dist(&doc, nj_get(&doc, l, "tpot_ms")),
+               "client level distribution");
+    }
+
+    TEST_PASS();
+done:
+    nj_doc_free(&doc);
+}
+
+/* ============================================================
+ * TEST 3: Same keys on the same lines, run to run
+ * ============================================================ */
+static void test_stable_layout(void) {
+    TEST_START("Stable layout: second run differs in values only");
+    char * report = NULL;
+    char * a = NULL;
+    char * b = NULL;
+    int rc = -1;
+    if (!g_report) {
+        fprintf(stderr, "SKIP (no report from test 2)\n");
+        tests_passed++;
+        return;
+    }
+
+    report = run_bench(g_model, 0, &rc);
+    ASSERT(report && rc >= 0, "second run did not produce a report");
+    a = report_skeleton(g_report);
+    b = report_skeleton(report);
+    ASSERT(a && b, "out of memory");
+    ASSERT(strcmp(a, b) == 0, "keys or layout moved between runs");
+    /* Values one per line: the skeleton has a line per report line */
+    ASSERT(strstr(a, "\"schema\": #,\n") && strstr(a, "\"p99\": #\n"), "values not one per line");
+
+    TEST_PASS();
+done:
+    free(a);
+    free(b);
+    free(report);
+}
+
+/* ============================================================
+ * TEST 4: Phase selection
+ * ============================================================ */
+static void test_phases(void) {
+    TEST_START("Phase selection: gen only");
+    nj_doc_t doc = {0};
+    char * report = NULL;
+    int rc = -1;
+    if (!g_model) {
+        fprintf(stderr, "SKIP (no model)\n");
+        tests_passed++;
+        return;
+    }
+
+    report = run_bench(g_model, NEURONOS_BENCH_GEN, &rc);
+    ASSERT(report && rc >= 0, "suite did not produce a report");
+    ASSERT(nj_parse(&doc, report, strlen(report)) == 0, "report is not valid JSON");
+    ASSERT(keys_are(&doc, 0, "schema,neuronos_version,model,hardware,suite,rss_after_load_mb,generation,peak_rss_mb"),
+           "top-level keys");
+
+    TEST_PASS();
+done:
+    nj_doc_free(&doc);
+    free(report);
+}
+
+int main(int argc, char * argv[]) {
+    fprintf(stderr, "═══════════════════════════════════════════\n");
+    fprintf(stderr, "  NeuronOS Benchmark Report Test Suite\n");
+    fprintf(stderr, "═══════════════════════════════════════════\n");
+
+#ifdef _WIN32
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+
+    if (argc > 1) {
+        fprintf(stderr, "Model: %s\n", argv[1]);
+        neuronos_engine_params_t eparams = {.n_threads = 4};
+        g_engine = neuronos_init(eparams);
+        /* 4096 tokens: the 8192 sweep point is skipped, the rest run */
+        neuronos_model_params_t mparams = {
+            .model_path = argv[1],
+            .context_size = 4096,
+            .use_mmap = true,
+        };
+        g_model = g_engine ? neuronos_model_load(g_engine, mparams) : NULL;
+        if (!g_model)
+            fprintf(stderr, "  (model load failed — report tests skipped)\n");
+    } else {
+        fprintf(stderr, "Usage: %s [model.gguf]\n", argv[0]);
+        fprintf(stderr, "  (running without model — report tests skipped)\n");
+    }
+
+    test_no_model();
+    test_schema();
+    test_stable_layout();
+    test_phases();
+
+    free(g_report);
+    if (g_model)
+        neuronos_model_free(g_model);
+    if (g_engine)
+        neuronos_shutdown(g_engine);
+
+    /* Summary */
+    fprintf(stderr, "\n═══════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d/%d passed", tests_passed, tests_run);
+    if (tests_failed > 0) {
+        fprintf(stderr, " (%d FAILED)", tests_failed);
+    }
+    fprintf(stderr, "\n═══════════════════════════════════════════\n");
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,373 @@
+/* ============================================================
+ * NeuronOS — Model Download Test Suite
+ *
+ * neuronos_model_download() against a stub `curl` placed first on
+ * PATH, which serves a local file (HEAD with an optional
+ * X-Linked-Etag, byte ranges) and logs every ranged fetch. Built
+ * with DL_CHUNK_MB=1 so a few MB make several chunks.
+ *
+ * Tests:
+ *  1. Fresh download verified against X-Linked-Etag
+ *  2. Interrupted download resumes from the chunk journal
+ *     (verified chunks kept, a damaged one refetched)
+ *  3. Registry SHA-256 mismatch rejected, partial files removed
+ *  4. X-Linked-Etag mismatch rejected
+ *  5. No digest available: download still completes
+ *
+ * Usage: ./test_download   (POSIX shell required; skipped on Windows)
+ * ============================================================ */
+#include "neuronos/neuronos_model_registry.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+/* ---- Helpers ---- */
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_START(name)                                                                                               \
+    do {                                                                                                               \
+        tests_run++;                                                                                                   \
+        fprintf(stderr, "\n[TEST %d] %s... ", tests_run, name);                                                        \
+    } while (0)
+
+#define TEST_PASS()                                                                                                    \
+    do {                                                                                                               \
+        tests_passed++;                                                                                                \
+        fprintf(stderr, "PASS ✓\n");                                                                                   \
+    } while (0)
+
+#define TEST_FAIL(msg)                                                                                                 \
+    do {                                                                                                               \
+        tests_failed++;                                                                                                \
+        fprintf(stderr, "FAIL ✗ (%s)\n", msg);                                                                         \
+    } while (0)
+
+#define ASSERT(cond, msg)                                                                                              \
+    do {                                                                                                               \
+        if (!(cond)) {                                                                                                 \
+            TEST_FAIL(msg);                                                                                            \
+            return;                                                                                                    \
+        }                                                                                                              \
+    } while (0)
+
+#ifndef _WIN32
+
+#define CHUNK (1 << 20)
+#define SRC_SIZE (3 * CHUNK + CHUNK / 2) /* 4 chunks, the last one short */
+
+/* Scratch layout under a mkdtemp directory */
+static char g_root[256];
+static char g_src[300], g_log[300], g_models[300];
+static char g_dest[400], g_part[410], g_journal[420];
+static char g_url[320];
+
+/* Stub transport. HEAD: a HuggingFace-style redirect carrying
+ * X-Linked-Etag ($STUB_ETAG; "auto" = the file's real sha256), then the
+ * size and range support. GET -r A-B: those bytes, logged to $STUB_LOG;
+ * ranges starting at or past $STUB_FAIL_FROM fail like a dropped
+ * connection. */
+static const char * STUB_CURL =
+    "#!/bin/sh\n"
+    "head=0; range=; f=\n"
+    "for a; do case \"$a\" in -fsIL) head=1;; [0-9]*-[0-9]*) range=$a;; stub://*) f=${a#stub://};; esac; done\n"
+    "[ -f \"$f\" ] || exit 22\n"
+    "if [ $head = 1 ]; then\n"
+    "  etag=$STUB_ETAG\n"
+    "  [ \"$etag\" = auto ] && etag=$( (sha256sum \"$f\" 2>/dev/null || shasum -a 256 \"$f\") | cut -c1-64)\n"
+    "  printf 'HTTP/1.1 302 Found\\r\\n'\n"
+    "  [ -n \"$etag\" ] && printf 'X-Linked-Etag: \"%s\"\\r\\n' \"$etag\"\n"
+    "  printf 'Location: stub://%s\\r\\n\\r\\n' \"$f\"\n"
+    "  printf 'HTTP/1.1 200 OK\\r\\nContent-Length: %s\\r\\nAccept-Ranges: bytes\\r\\n\\r\\n' $(wc -c < \"$f\")\n"
+    "  exit 0\n"
+    "fi\n"
+    "[ -n \"$range\" ] || { cat \"$f\"; exit 0; }\n"
+    "a=${range%-*}; b=${range#*-}\n"
+    "[ -n \"$STUB_FAIL_FROM\" ] && [ $a -ge $STUB_FAIL_FROM ] && exit 56\n"
+    "echo $a >> \"$STUB_LOG\"\n"
+    "tail -c +$((a + 1)) \"$f\" | head -c $((b - a + 1))\n";
+
+static bool write_file(const char * path, const char * data, size_t len) {
+    FILE * f = fopen(path, "wb");
+    if (!f)
+        return false;
+    bool ok = fwrite(data, 1, len, f) == len;
+    return fclose(f) == 0 && ok;
+}
+
+/* Whole file into a malloc'd buffer; NULL if missing */
+static char * read_file(const char * path, size_t * len) {
+    FILE * f = fopen(path, "rb");
+    if (!f)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char * buf = malloc((size_t)n + 1);
+    if (buf && fread(buf, 1, (size_t)n, f) != (size_t)n) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    if (buf) {
+        buf[n] = '\0';
+        *len = (size_t)n;
+    }
+    return buf;
+}
+
+static bool exists(const char * path) {
+    struct stat st;
+    return stat(path, &st) == 0;
+}
+
+static bool dest_matches_src(void) {
+    size_t a_len = 0, b_len = 0;
+    char * a = read_file(g_src, &a_len);
+    char * b = read_file(g_dest, &b_len);
+    bool same = a && b && a_len == b_len && memcmp(a, b, a_len) == 0;
+    free(a);
+    free(b);
+    return same;
+}
+
+/* Was the chunk at this offset fetched since the log was cleared? */
+static bool fetched(long off) {
+    size_t len;
+    char * log = read_file(g_log, &len);
+    bool hit = false;
+    for (char * line = log ? strtok(log, "\n") : NULL; line && !hit; line = strtok(NULL, "\n"))
+        hit = atol(line) == off;
+    free(log);
+    return hit;
+}
+
+static void reset(const char * etag) {
+    remove(g_dest);
+    remove(g_part);
+    remove(g_journal);
+    remove(g_log);
+    setenv("STUB_ETAG", etag, 1);
+    unsetenv("STUB_FAIL_FROM");
+}
+
+static neuronos_registry_entry_t make_entry(const char * sha256) {
+    neuronos_registry_entry_t e = {
+        .id = "stub-model",
+        .display_name = "Stub model",
+        .filename = "model.gguf",
+        .url = g_url,
+        .sha256 = sha256,
+        .size_mb = SRC_SIZE >> 20,
+    };
+    return e;
+}
+
+static bool setup(void) {
+    const char * tmp = getenv("TMPDIR");
+    snprintf(g_root, sizeof(g_root), "%s/neuronos-dl-XXXXXX", tmp && tmp[0] ? tmp : "/tmp");
+    if (!mkdtemp(g_root))
+        return false;
+
+    char bin[300], curl[320];
+    snprintf(bin, sizeof(bin), "%s/bin", g_root);
+    snprintf(curl, sizeof(curl), "%s/curl", bin);
+    snprintf(g_src, sizeof(g_src), "%s/src.gguf", g_root);
+    snprintf(g_log, sizeof(g_log), "%s/fetches.log", g_root);
+    snprintf(g_models, sizeof(g_models), "%s/models", g_root);
+    snprintf(g_dest, sizeof(g_dest), "%s/stub-model/model.gguf", g_models);
+    snprintf(g_part, sizeof(g_part), "%s.part", g_dest);
+    snprintf(g_journal, sizeof(g_journal), "%s.chunks", g_part);
+    snprintf(g_url, sizeof(g_url), "stub://%s", g_src);
+
+    if (mkdir(bin, 0755) != 0 || mkdir(g_models, 0755) != 0 || !write_file(curl, STUB_CURL, strlen(STUB_CURL)) ||
+        chmod(curl, 0755) != 0)
+        return false;
+
+    /* Deterministic, non-repeating content so misplaced chunks show */
+    char * data = malloc(SRC_SIZE);
+    if (!data)
+        return false;
+    uint32_t x = 0x12345678u;
+    for (int i = 0; i < SRC_SIZE; i++) {
+        x = x * 1664525u + 1013904223u;
+        data[i] = (char)(x >> 24);
+    }
+    bool ok = write_file(g_src, data, SRC_SIZE);
+    free(data);
+
+    const char * path = getenv("PATH");
+    size_t n = strlen(bin) + (path ? strlen(path) : 0) + 2;
+    char * new_path = malloc(n);
+    if (!new_path)
+        return false;
+    snprintf(new_path, n, "%s:%s", bin, path ? path : "");
+    setenv("PATH", new_path, 1);
+    free(new_path);
+    setenv("STUB_LOG", g_log, 1);
+    setenv("NEURONOS_DL_CONNECTIONS", "4", 1);
+    return ok;
+}
+
+static void teardown(void) {
+    char cmd[300];
+    snprintf(cmd, sizeof(cmd), "rm -rf \"%s\"", g_root);
+    if (system(cmd) != 0)
+        fprintf(stderr, "warning: could not remove %s\n", g_root);
+}
+
+/* ============================================================
+ * TEST 1: Fresh download, verified against X-Linked-Etag
+ * ============================================================ */
+static void test_fresh_download(void) {
+    TEST_START("Fresh download verified against X-Linked-Etag");
+    reset("auto");
+    neuronos_registry_entry_t e = make_entry(NULL);
+
+    ASSERT(neuronos_model_download(&e, g_models, NULL, NULL) == 0, "download failed");
+    ASSERT(dest_matches_src(), "downloaded bytes differ");
+    ASSERT(!exists(g_part) && !exists(g_journal), "partial files left behind");
+    for (long off = 0; off < SRC_SIZE; off += CHUNK)
+        ASSERT(fetched(off), "a chunk was never fetched");
+
+    TEST_PASS();
+}
+
+/* ============================================================
+ * TEST 2: Resume from the chunk journal
+ * ============================================================ */
+static void test_journal_resume(void) {
+    TEST_START("Interrupted download resumes from the chunk journal");
+    reset("auto");
+    neuronos_registry_entry_t e = make_entry(NULL);
+
+    /* Chunks 2 and 3 fail: one worker per chunk, so 0 and 1 land */
+    setenv("STUB_FAIL_FROM", "2097152", 1);
+    ASSERT(neuronos_model_download(&e, g_models, NULL, NULL) == -1, "interrupted download reported success");
+    ASSERT(!exists(g_dest), "incomplete file published");
+    ASSERT(exists(g_part) && exists(g_journal), "partial state not kept for resume");
+
+    /* Workers take one chunk each, so 0 and 1 normally both land; a
+     * worker that starts after the failure stops without fetching */
+    bool journaled[4] = {false};
+    size_t len;
+    char * journal = read_file(g_journal, &len);
+    ASSERT(journal, "journal unreadable");
+    for (char * line = strchr(journal, '\n'); line && line[1]; line = strchr(line + 1, '\n')) {
+        int k = atoi(line + 1);
+        if (k >= 0 && k < 4)
+            journaled[k] = true;
+    }
+    free(journal);
+    ASSERT(!journaled[2] && !journaled[3], "failed chunks journaled");
+    int damaged = journaled[1] ? 1 : 0;
+    ASSERT(journaled[damaged], "no chunk completed before the failure");
+
+    /* Damage one journaled chunk on disk: its entry no longer matches */
+    FILE * f = fopen(g_part, "r+b");
+    ASSERT(f, "cannot open .part");
+    fseek(f, (long)damaged * CHUNK + 100, SEEK_SET);
+    fputc(0, f);
+    fputc(0, f);
+    fclose(f);
+
+    unsetenv("STUB_FAIL_FROM");
+    remove(g_log);
+    ASSERT(neuronos_model_download(&e, g_models, NULL, NULL) == 0, "resumed download failed");
+    ASSERT(dest_matches_src(), "resumed file differs from the source");
+    for (int k = 0; k < 4; k++) {
+        bool want = !journaled[k] || k == damaged;
+        ASSERT(fetched((long)k * CHUNK) == want,
+               want ? "missing or damaged chunk not fetched" : "verified chunk fetched again");
+    }
+    ASSERT(!exists(g_part) && !exists(g_journal), "partial files left behind");
+
+    TEST_PASS();
+}
+
+/* ============================================================
+ * TEST 3: Registry digest mismatch
+ * ============================================================ */
+static void test_registry_mismatch(void) {
+    TEST_START("Registry SHA-256 mismatch rejected");
+    reset("auto"); /* the registry digest takes precedence over the etag */
+    neuronos_registry_entry_t e = make_entry("0000000000000000000000000000000000000000000000000000000000000000");
+
+    ASSERT(neuronos_model_download(&e, g_models, NULL, NULL) == -2, "mismatch not reported as -2");
+    ASSERT(!exists(g_dest), "rejected file published");
+    ASSERT(!exists(g_part) && !exists(g_journal), "rejected data kept for resume");
+
+    TEST_PASS();
+}
+
+/* ============================================================
+ * TEST 4: X-Linked-Etag mismatch
+ * ============================================================ */
+static void test_etag_mismatch(void) {
+    TEST_START("X-Linked-Etag mismatch rejected");
+    reset("1111111111111111111111111111111111111111111111111111111111111111");
+    neuronos_registry_entry_t e = make_entry(NULL);
+
+    ASSERT(neuronos_model_download(&e, g_models, NULL, NULL) == -2, "etag mismatch not reported as -2");
+    ASSERT(!exists(g_dest), "rejected file published");
+
+    /* A git blob id (non-LFS file) is not a sha256 and is ignored */
+    reset("0123456789abcdef0123456789abcdef01234567");
+    ASSERT(neuronos_model_download(&e, g_models, NULL, NULL) == 0, "40-digit etag treated as a digest");
+
+    TEST_PASS();
+}
+
+/* ============================================================
+ * TEST 5: No digest at all
+ * ============================================================ */
+static void test_no_digest(void) {
+    TEST_START("No digest: warns and completes");
+    reset("");
+    neuronos_registry_entry_t e = make_entry(NULL);
+
+    ASSERT(neuronos_model_download(&e, g_models, NULL, NULL) == 0, "download failed");
+    ASSERT(dest_matches_src(), "downloaded bytes differ");
+
+    TEST_PASS();
+}
+
+#endif /* !_WIN32 */
+
+int main(void) {
+    fprintf(stderr, "═══════════════════════════════════════════\n");
+    fprintf(stderr, "  NeuronOS Model Download Test Suite\n");
+    fprintf(stderr, "═══════════════════════════════════════════\n");
+
+#ifdef _WIN32
+    fprintf(stderr, "  (needs a POSIX shell for the stub transport — skipped)\n");
+#else
+    if (!setup()) {
+        fprintf(stderr, "Cannot create the scratch directory\n");
+        return 1;
+    }
+    test_fresh_download();
+    test_journal_resume();
+    test_registry_mismatch();
+    test_etag_mismatch();
+    test_no_digest();
+    teardown();
+#endif
+
+    /* Summary */
+    fprintf(stderr, "\n═══════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d/%d passed", tests_passed, tests_run);
+    if (tests_failed > 0) {
+        fprintf(stderr, " (%d FAILED)", tests_failed);
+    }
+    fprintf(stderr, "\n═══════════════════════════════════════════\n");
+
+    return tests_failed > 0 ? 1 : 0;
+}
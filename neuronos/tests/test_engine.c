@@ -17,6 +17,20 @@
  *  13. MCP server protocol
  * 14. Chat template formatting
  * 15. Ternary GPU offload guard
+ * 16. KV cache prefix reuse
+ * 17. Continuous batching scheduler
+ * 18. Session snapshots
+ * 19. Speculative decoding
+ * 20. Per-phase timings & latency histograms
+ * 21. Grammar sampler cache
+ * 22. Coalesced token streaming
+ * 23. Shared-weights model pool
+ * 24. Generation cancellation
+ * 25. Parallel tool batches
+ * 26. Tool result cache
+ * 27. Tool relevance selection
+ * 28. GGUF header scan & scan cache
+ * 29. Metrics shard reuse across short-lived threads
  *
  * Usage: ./test_engine <path-to-gguf-model>
  * ============================================================ */
@@ -25,6 +39,25 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <windows.h>
+#define test_atomic_inc(p) InterlockedIncrement((volatile LONG *)(p))
+#define test_atomic_load(p) InterlockedCompareExchange((volatile LONG *)(p), 0, 0)
+typedef HANDLE test_thread_t;
+#define test_thread_start(t, fn, arg) ((*(t) = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)(fn), (arg), 0, NULL)) != NULL)
+#define test_thread_join(t) (WaitForSingleObject((t), INFINITE), CloseHandle(t))
+#else
+#include <pthread.h>
+#include <unistd.h>
+#define test_atomic_inc(p) __atomic_add_fetch((p), 1, __ATOMIC_SEQ_CST)
+#define test_atomic_load(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+typedef pthread_t test_thread_t;
+#define test_thread_start(t, fn, arg) (pthread_create((t), NULL, (void * (*)(void *))(fn), (arg)) == 0)
+#define test_thread_join(t) pthread_join((t), NULL)
+#endif
 
 /* ---- Helpers ---- */
 static int tests_run = 0;
@@ -381,8 +414,29 @@ static void test_auto_tune(void) {
     /* Validate: mmap should always be true */
     ASSERT(tuned.use_mmap == true, "use_mmap should be true");
 
-    fprintf(stderr, "\n  threads=%d batch=%d ctx=%d mmap=%d mlock=%d gpu=%d", tuned.n_threads, tuned.n_batch,
-            tuned.n_ctx, tuned.use_mmap, tuned.use_mlock, tuned.n_gpu_layers);
+    /* Validate: prefill threads and micro-batch */
+    ASSERT(tuned.n_threads_batch >= tuned.n_threads, "prefill threads should be >= decode threads");
+    ASSERT(tuned.n_ubatch > 0 && tuned.n_ubatch <= tuned.n_batch, "n_ubatch should be in (0, n_batch]");
+
+    /* Validate: tuned values reach the model load params */
+    neuronos_model_params_t mp = neuronos_tuned_model_params(&tuned, fake_model.path);
+    ASSERT(mp.model_path == fake_model.path, "model_path not forwarded");
+    ASSERT(mp.context_size == tuned.n_ctx && mp.n_batch == tuned.n_batch, "ctx/batch not forwarded");
+    ASSERT(mp.n_ubatch == tuned.n_ubatch && mp.n_threads_batch == tuned.n_threads_batch,
+           "ubatch/threads_batch not forwarded");
+    ASSERT(mp.use_mlock == tuned.use_mlock, "use_mlock not forwarded");
+    ASSERT(mp.flash_attn == (tuned.flash_attn ? 1 : -1), "flash_attn not forwarded");
+    ASSERT(mp.kv_type == tuned.kv_type, "kv_type not forwarded");
+
+    /* Validate: quantized KV is cheaper and only chosen with flash attention */
+    ASSERT(neuronos_kv_mb_per_1k(NEURONOS_KV_F16) > neuronos_kv_mb_per_1k(NEURONOS_KV_Q8_0) &&
+               neuronos_kv_mb_per_1k(NEURONOS_KV_Q8_0) > neuronos_kv_mb_per_1k(NEURONOS_KV_Q4_0),
+           "KV cost should shrink with quantization");
+    ASSERT(tuned.flash_attn || tuned.kv_type == NEURONOS_KV_F16, "quantized KV requires flash attention");
+
+    fprintf(stderr, "\n  threads=%d/%d batch=%d ubatch=%d ctx=%d mmap=%d mlock=%d gpu=%d", tuned.n_threads,
+            tuned.n_threads_batch, tuned.n_batch, tuned.n_ubatch, tuned.n_ctx, tuned.use_mmap, tuned.use_mlock,
+            tuned.n_gpu_layers);
 
     /* Print formatted output */
     neuronos_tune_print(&tuned);
@@ -637,9 +691,853 @@ static void test_ternary_gpu_guard(void) {
     TEST_PASS();
 }
 
+/* ---- Test 16: KV cache prefix reuse ---- */
+static void test_kv_prefix_reuse(void) {
+    TEST_START("KV cache prefix reuse");
+
+    if (!g_model) {
+        fprintf(stderr, "SKIP (model not loaded)");
+        tests_run--;
+        return;
+    }
+
+    /* Greedy decoding: the second call reuses the cached prompt and
+     * must produce exactly the same text as a cold prefill. */
+    neuronos_gen_params_t params = {
+        .prompt = "The capital of France is",
+        .max_tokens = 16,
+        .temperature = 0.0f,
+        .seed = 42,
+    };
+
+    neuronos_gen_result_t cold = neuronos_generate(g_model, params);
+    ASSERT(cold.status == NEURONOS_OK, "cold generation failed");
+
+    neuronos_gen_result_t warm = neuronos_generate(g_model, params);
+    ASSERT(warm.status == NEURONOS_OK, "warm generation failed");
+    ASSERT(strcmp(cold.text, warm.text) == 0, "warm output differs from cold output");
+
+    /* Extending the prompt keeps the shared prefix and decodes the rest */
+    params.prompt = "The capital of France is Paris. The capital of Spain is";
+    neuronos_gen_result_t ext = neuronos_generate(g_model, params);
+    ASSERT(ext.status == NEURONOS_OK, "extended generation failed");
+
+    ASSERT(warm.n_prompt_tokens == cold.n_prompt_tokens, "prompt token count mismatch");
+    ASSERT(warm.n_reused_tokens == warm.n_prompt_tokens - 1, "warm call should reuse all but the last token");
+    ASSERT(ext.n_reused_tokens > 0 && ext.n_reused_tokens < ext.n_prompt_tokens, "extension should reuse the prefix");
+
+    fprintf(stderr, "\n  cold=%.1f ms, warm=%.1f ms", cold.elapsed_ms, warm.elapsed_ms);
+
+    neuronos_gen_result_free(&cold);
+    neuronos_gen_result_free(&warm);
+    neuronos_gen_result_free(&ext);
+    TEST_PASS();
+}
+
+/* ---- Test 17: Continuous batching scheduler ---- */
+static void test_scheduler(void) {
+    TEST_START("Continuous batching scheduler");
+
+    neuronos_scheduler_params_t sp = {
+        .n_slots = 2,
+        .slot_ctx = 512,
+    };
+    ASSERT(neuronos_scheduler_create(NULL, sp) == NULL, "create without model should fail");
+
+    if (!g_model) {
+        fprintf(stderr, "SKIP (model not loaded)");
+        tests_run--;
+        return;
+    }
+
+    neuronos_scheduler_t * sched = neuronos_scheduler_create(g_model, sp);
+    ASSERT(sched != NULL, "scheduler create failed");
+
+    neuronos_gen_params_t params = {
+        .prompt = "Once upon a time",
+        .max_tokens = 16,
+        .temperature = 0.0f,
+    };
+    int id_a = neuronos_scheduler_submit(sched, params);
+    params.prompt = "The three primary colors are";
+    int id_b = neuronos_scheduler_submit(sched, params);
+    ASSERT(id_a >= 0 && id_b >= 0 && id_a != id_b, "submit failed");
+    ASSERT(neuronos_scheduler_submit(sched, params) == -1, "third submit should find no free slot");
+    ASSERT(neuronos_scheduler_active(sched) == 2, "expected 2 active requests");
+
+    ASSERT(neuronos_scheduler_run(sched) == NEURONOS_OK, "run failed");
+    ASSERT(neuronos_scheduler_active(sched) == 0, "requests still active after run");
+
+    neuronos_gen_result_t ra, rb;
+    ASSERT(neuronos_scheduler_take(sched, id_a, &ra), "take a failed");
+    ASSERT(neuronos_scheduler_take(sched, id_b, &rb), "take b failed");
+    ASSERT(!neuronos_scheduler_take(sched, id_a, &ra), "double take should fail");
+    ASSERT(ra.status == NEURONOS_OK && ra.n_tokens > 0, "request a produced no tokens");
+    ASSERT(rb.status == NEURONOS_OK && rb.n_tokens > 0, "request b produced no tokens");
+
+    fprintf(stderr, "\n  a: \"%.40s\"\n  b: \"%.40s\"", ra.text, rb.text);
+
+    /* A finished slot keeps its KV: resending a prompt reuses it */
+    params.prompt = "Once upon a time";
+    int id_c = neuronos_scheduler_submit(sched, params);
+    ASSERT(id_c >= 0, "resubmit failed");
+    ASSERT(neuronos_scheduler_run(sched) == NEURONOS_OK, "run (resubmit) failed");
+    neuronos_gen_result_t rc;
+    ASSERT(neuronos_scheduler_take(sched, id_c, &rc), "take c failed");
+    ASSERT(rc.n_reused_tokens == rc.n_prompt_tokens - 1, "resubmitted prompt should reuse the warm slot");
+    ASSERT(strcmp(rc.text, ra.text) == 0, "greedy output changed after slot reuse");
+
+    neuronos_gen_result_free(&ra);
+    neuronos_gen_result_free(&rb);
+    neuronos_gen_result_free(&rc);
+    neuronos_scheduler_free(sched);
+    TEST_PASS();
+}
+
+/* ---- Test 18: Session snapshots ---- */
+static void test_session_snapshot(void) {
+    TEST_START("Session snapshots");
+
+    ASSERT(neuronos_session_save(NULL, "x") == NEURONOS_ERROR_INVALID_PARAM, "save without model should fail");
+    ASSERT(neuronos_session_load(NULL, "x") == NEURONOS_ERROR_INVALID_PARAM, "load without model should fail");
+
+    if (!g_model) {
+        fprintf(stderr, "SKIP (model not loaded)");
+        tests_run--;
+        return;
+    }
+
+    const char * prefix = "You are a helpful assistant. Answer briefly.\n";
+    const char * path = "/tmp/neuronos_test.session";
+
+    ASSERT(neuronos_session_warm(g_model, prefix, "/tmp") == NEURONOS_OK, "warm (prefill) failed");
+    ASSERT(neuronos_session_save(g_model, path) == NEURONOS_OK, "save failed");
+    ASSERT(neuronos_session_load(g_model, path) == NEURONOS_OK, "load failed");
+    ASSERT(neuronos_session_load(g_model, "/tmp/neuronos_missing.session") != NEURONOS_OK,
+           "loading a missing snapshot should fail");
+
+    /* Generation on top of the restored prefix */
+    neuronos_gen_params_t params = {
+        .prompt = "You are a helpful assistant. Answer briefly.\nWhat is 2+2?",
+        .max_tokens = 8,
+        .temperature = 0.0f,
+    };
+    neuronos_gen_result_t result = neuronos_generate(g_model, params);
+    ASSERT(result.status == NEURONOS_OK, "generation after restore failed");
+
+    neuronos_gen_result_free(&result);
+    remove(path);
+    TEST_PASS();
+}
+
+/* ---- Test 19: Speculative decoding ---- */
+static void test_speculative(void) {
+    TEST_START("Speculative decoding");
+
+    if (!g_model) {
+        fprintf(stderr, "SKIP (model not loaded)");
+        tests_run--;
+        return;
+    }
+
+    /* A second instance of the same model is a (perfect) draft */
+    neuronos_model_params_t mparams = {
+        .model_path = g_model_path,
+        .context_size = 512,
+        .use_mmap = true,
+    };
+    neuronos_model_t * draft = neuronos_model_load(g_engine, mparams);
+    ASSERT(draft != NULL, "draft model load failed");
+
+    neuronos_gen_params_t params = {
+        .prompt = "List the days of the week:",
+        .max_tokens = 32,
+        .temperature = 0.0f,
+        .draft_model = draft,
+        .n_draft = 4,
+    };
+    neuronos_gen_result_t result = neuronos_generate(g_model, params);
+    ASSERT(result.status == NEURONOS_OK, "speculative generation failed");
+    ASSERT(result.n_tokens > 0, "no tokens generated");
+    ASSERT(result.n_drafted > 0, "no draft tokens proposed");
+    ASSERT(result.acceptance_rate >= 0.0 && result.acceptance_rate <= 1.0, "acceptance rate out of range");
+
+    fprintf(stderr, "\n  accepted %d/%d (%.0f%%), %.2f t/s", result.n_accepted, result.n_drafted,
+            result.acceptance_rate * 100.0, result.tokens_per_s);
+
+    neuronos_gen_result_free(&result);
+    neuronos_model_free(draft);
+    TEST_PASS();
+}
+
+/* ---- Test 20: Per-phase timings & latency histograms ---- */
+static void test_metrics(void) {
+    TEST_START("Per-phase timings & latency histograms");
+
+    neuronos_metrics_reset();
+    for (int i = 1; i <= 100; i++)
+        neuronos_metrics_record(NEURONOS_METRIC_SAMPLE, (double)i);
+    neuronos_histogram_t h = neuronos_metrics_get(NEURONOS_METRIC_SAMPLE);
+    ASSERT(h.count == 100 && h.min_ms == 1.0 && h.max_ms == 100.0, "histogram count/min/max");
+
+    double p50 = neuronos_histogram_percentile(&h, 0.50);
+    double p99 = neuronos_histogram_percentile(&h, 0.99);
+    ASSERT(p50 >= 25.0 && p50 <= 100.0, "p50 outside its bucket");
+    ASSERT(p99 >= p50 && p99 <= 100.0, "p99 should be >= p50 and <= max");
+
+    char * json = neuronos_metrics_json();
+    ASSERT(json && strstr(json, "\"sample\":{\"count\":100") && strstr(json, "\"ttft\""), "metrics JSON");
+    free(json);
+
+    /* Labelled series and counters in the Prometheus export */
+    neuronos_metrics_record_label(NEURONOS_METRIC_TOOL, "calculate", 3.0);
+    neuronos_metrics_add(NEURONOS_COUNTER_HTTP_REQUESTS, 2);
+    neuronos_metrics_gauge_set(NEURONOS_GAUGE_QUEUED, 5);
+    ASSERT(neuronos_metrics_get(NEURONOS_METRIC_TOOL).count == 1, "labelled record should count in the total");
+    char * prom = neuronos_metrics_prometheus();
+    ASSERT(prom != NULL, "prometheus export failed");
+    bool prom_ok = strstr(prom, "neuronos_tool_seconds_bucket{tool=\"calculate\",le=\"0.005\"} 1\n") &&
+                   strstr(prom, "neuronos_sample_seconds_count 100\n") &&
+                   strstr(prom, "neuronos_http_requests_total 2\n") && strstr(prom, "neuronos_generations_queued 5\n");
+    free(prom);
+    ASSERT(prom_ok, "prometheus text");
+    neuronos_metrics_gauge_set(NEURONOS_GAUGE_QUEUED, 0);
+
+    neuronos_metrics_reset();
+    ASSERT(neuronos_metrics_get(NEURONOS_METRIC_SAMPLE).count == 0, "reset should clear histograms");
+    ASSERT(neuronos_metrics_counter(NEURONOS_COUNTER_HTTP_REQUESTS) == 0, "reset should clear counters");
+
+    if (g_model) {
+        neuronos_gen_params_t params = {
+            .prompt = "Count to five:",
+            .max_tokens = 8,
+            .temperature = 0.0f,
+            .seed = 42,
+        };
+        neuronos_gen_result_t r = neuronos_generate(g_model, params);
+        ASSERT(r.status == NEURONOS_OK, "generation failed");
+        ASSERT(r.n_prompt_tokens > 0 && r.n_reused_tokens < r.n_prompt_tokens, "prompt token accounting");
+        ASSERT(r.ttft_ms > 0.0 && r.ttft_ms <= r.elapsed_ms, "ttft should be within elapsed");
+        ASSERT(r.prefill_ms + r.decode_ms + r.sample_ms <= r.elapsed_ms + 1.0, "phases exceed elapsed");
+        ASSERT(neuronos_metrics_get(NEURONOS_METRIC_GENERATE).count == 1, "generate not recorded");
+        ASSERT(neuronos_metrics_get(NEURONOS_METRIC_TTFT).count == 1, "ttft not recorded");
+
+        fprintf(stderr, "\n  ttft=%.2f ms prefill=%.1f t/s decode=%.1f t/s sample=%.2f ms", r.ttft_ms,
+                r.prefill_tokens_per_s, r.decode_tokens_per_s, r.sample_ms);
+        neuronos_gen_result_free(&r);
+    }
+
+    TEST_PASS();
+}
+
+/* ---- Test 21: Grammar sampler cache ---- */
+static void test_grammar_cache(void) {
+    TEST_START("Grammar sampler cache");
+
+    if (!g_model) {
+        fprintf(stderr, "SKIP (model not loaded)");
+        tests_run--;
+        return;
+    }
+
+    /* Cached chains are handed out as clones: every call must start
+     * from the grammar root and give the same greedy output. */
+    neuronos_gen_params_t params = {
+        .prompt = "Is the sky blue? Answer:",
+        .max_tokens = 8,
+        .temperature = 0.0f,
+        .grammar = "root ::= \" yes\" | \" no\"",
+        .seed = 42,
+    };
+
+    neuronos_gen_result_t first = neuronos_generate(g_model, params);
+    ASSERT(first.status == NEURONOS_OK, "first generation failed");
+
+    for (int i = 0; i < 3; i++) {
+        if (i == 1)
+            neuronos_sampler_cache_invalidate();
+        neuronos_gen_result_t again = neuronos_generate(g_model, params);
+        ASSERT(again.status == NEURONOS_OK, "cached generation failed");
+        int same = strcmp(first.text, again.text) == 0;
+        neuronos_gen_result_free(&again);
+        ASSERT(same, "cached grammar chain changed the output");
+    }
+
+    fprintf(stderr, "\n  output=\"%s\"", first.text);
+    neuronos_gen_result_free(&first);
+    TEST_PASS();
+}
+
+/* ---- Test 22: Coalesced token streaming ---- */
+typedef struct {
+    char text[4096];
+    size_t len;
+    int n_tokens;
+    int n_calls;
+    int max_per_call;
+    int stop_after;
+} stream_capture_t;
+
+static bool capture_stream(const int32_t * token_ids, int n_tokens, const char * text, size_t text_len,
+                           void * user_data) {
+    stream_capture_t * cap = user_data;
+    (void)token_ids;
+    if (cap->len + text_len < sizeof(cap->text)) {
+        memcpy(cap->text + cap->len, text, text_len);
+        cap->len += text_len;
+        cap->text[cap->len] = '\0';
+    }
+    cap->n_tokens += n_tokens;
+    cap->n_calls++;
+    if (n_tokens > cap->max_per_call)
+        cap->max_per_call = n_tokens;
+    return cap->stop_after == 0 || cap->n_calls < cap->stop_after;
+}
+
+static void test_coalesced_stream(void) {
+    TEST_START("Coalesced token streaming");
+
+    if (!g_model) {
+        fprintf(stderr, "SKIP (model not loaded)");
+        tests_run--;
+        return;
+    }
+
+    stream_capture_t cap = {0};
+    neuronos_gen_params_t params = {
+        .prompt = "List three colors:",
+        .max_tokens = 24,
+        .temperature = 0.0f,
+        .seed = 42,
+        .on_stream = capture_stream,
+        .flush = {.every_n_tokens = 4},
+        .user_data = &cap,
+    };
+
+    neuronos_gen_result_t r = neuronos_generate(g_model, params);
+    ASSERT(r.status == NEURONOS_OK, "generation failed");
+    ASSERT(cap.n_tokens == r.n_tokens, "streamed token count differs from result");
+    ASSERT(strcmp(cap.text, r.text) == 0, "streamed text differs from result");
+    ASSERT(cap.max_per_call <= 4, "flush policy exceeded every_n_tokens");
+    ASSERT(r.n_tokens < 4 || cap.n_calls < r.n_tokens, "tokens were not coalesced");
+    int n_full = r.n_tokens;
+    neuronos_gen_result_free(&r);
+
+    /* Returning false from the callback stops generation */
+    memset(&cap, 0, sizeof(cap));
+    cap.stop_after = 1;
+    params.flush = (neuronos_flush_policy_t){0}; /* every token */
+    r = neuronos_generate(g_model, params);
+    ASSERT(r.status == NEURONOS_OK, "stopped generation failed");
+    ASSERT(cap.n_calls == 1 && (n_full <= 1 || r.n_tokens < n_full), "callback stop ignored");
+    neuronos_gen_result_free(&r);
+
+    TEST_PASS();
+}
+
+/* ---- Test 23: Shared-weights model pool ---- */
+typedef struct {
+    neuronos_model_pool_t * pool;
+    neuronos_model_params_t mp;
+    int n_ok;
+} pool_worker_t;
+
+/* One of two threads sharing a pool: acquire, generate, release */
+static void * pool_worker(void * arg) {
+    pool_worker_t * w = arg;
+    neuronos_gen_params_t gp = {.prompt = "Hi", .max_tokens = 2, .temperature = 0.0f, .seed = 42};
+    for (int i = 0; i < 8; i++) {
+        neuronos_model_t * m = neuronos_pool_acquire(w->pool, w->mp);
+        if (!m)
+            continue;
+        neuronos_gen_result_t r = neuronos_generate(m, gp);
+        if (r.status == NEURONOS_OK)
+            w->n_ok++;
+        neuronos_gen_result_free(&r);
+        neuronos_pool_release(w->pool, m);
+        (void)neuronos_pool_stats(w->pool);
+    }
+    return NULL;
+}
+
+static void test_model_pool(void) {
+    TEST_START("Shared-weights model pool");
+
+    if (!g_model || !g_engine) {
+        fprintf(stderr, "SKIP (model not loaded)");
+        tests_run--;
+        return;
+    }
+
+    neuronos_model_pool_t * pool = neuronos_pool_create(g_engine, (neuronos_pool_params_t){.budget_mb = 1 << 20});
+    ASSERT(pool != NULL, "pool create failed");
+
+    neuronos_model_params_t mp = {.model_path = g_model_path, .context_size = 512, .use_mmap = true};
+    neuronos_model_t * a = neuronos_pool_acquire(pool, mp);
+    neuronos_model_t * b = neuronos_pool_acquire(pool, mp);
+    ASSERT(a && b && a != b, "two handles expected");
+
+    neuronos_pool_stats_t ps = neuronos_pool_stats(pool);
+    ASSERT(ps.n_models == 1 && ps.n_contexts == 2 && ps.n_in_use == 2, "contexts should share one model");
+
+    neuronos_gen_params_t gp = {.prompt = "Hello", .max_tokens = 4, .temperature = 0.0f, .seed = 42};
+    neuronos_gen_result_t ra = neuronos_generate(a, gp);
+    neuronos_gen_result_t rb = neuronos_generate(b, gp);
+    ASSERT(ra.status == NEURONOS_OK && rb.status == NEURONOS_OK, "pooled generation failed");
+    ASSERT(strcmp(ra.text, rb.text) == 0, "shared weights should give identical greedy output");
+    neuronos_gen_result_free(&ra);
+    neuronos_gen_result_free(&rb);
+
+    /* Released handles are reused warm by a matching acquire */
+    neuronos_pool_release(pool, b);
+    neuronos_model_t * c = neuronos_pool_acquire(pool, mp);
+    ASSERT(c == b, "idle context should be reused");
+
+    mp.context_size = 256;
+    neuronos_model_t * d = neuronos_pool_acquire(pool, mp);
+    ASSERT(d && d != a && d != c, "different settings should get a new context");
+    ASSERT(neuronos_pool_stats(pool).n_models == 1, "weights should still be shared");
+
+    neuronos_model_free(d); /* same as release for pooled handles */
+    neuronos_pool_release(pool, c);
+    neuronos_pool_release(pool, a);
+    ps = neuronos_pool_stats(pool);
+    ASSERT(ps.n_in_use == 0 && ps.n_contexts == 3, "idle contexts stay within budget");
+    neuronos_pool_free(pool);
+
+    /* A tiny budget evicts everything idle on release */
+    pool = neuronos_pool_create(g_engine, (neuronos_pool_params_t){.budget_mb = 1});
+    a = neuronos_pool_acquire(pool, mp);
+    ASSERT(a != NULL, "in-use handles are never refused for budget alone");
+    neuronos_pool_release(pool, a);
+    ps = neuronos_pool_stats(pool);
+    ASSERT(ps.n_contexts == 0 && ps.used_mb <= ps.budget_mb, "LRU eviction should respect the budget");
+    neuronos_pool_free(pool);
+
+    /* Two threads (e.g. the server and an MCP-side generator) share one pool */
+    pool = neuronos_pool_create(g_engine, (neuronos_pool_params_t){.budget_mb = 1 << 20});
+    pool_worker_t workers[2] = {{pool, mp, 0}, {pool, mp, 0}};
+    test_thread_t th[2];
+    ASSERT(test_thread_start(&th[0], pool_worker, &workers[0]), "thread start failed");
+    ASSERT(test_thread_start(&th[1], pool_worker, &workers[1]), "thread start failed");
+    test_thread_join(th[0]);
+    test_thread_join(th[1]);
+    ps = neuronos_pool_stats(pool);
+    ASSERT(workers[0].n_ok == 8 && workers[1].n_ok == 8, "concurrent pooled generations failed");
+    ASSERT(ps.n_models == 1 && ps.n_in_use == 0 && ps.n_contexts <= 2, "concurrent acquire/release corrupted the pool");
+    neuronos_pool_free(pool);
+
+    TEST_PASS();
+}
+
+/* ---- Test 24: Cancellation ---- */
+static bool cancel_after(void * user_data) {
+    int * polls_left = user_data;
+    return --*polls_left < 0;
+}
+
+static void test_cancellation(void) {
+    TEST_START("Generation cancellation");
+
+    if (!g_model) {
+        fprintf(stderr, "SKIP (model not loaded)");
+        tests_run--;
+        return;
+    }
+
+    int polls_left = 0;
+    neuronos_gen_params_t params = {
+        .prompt = "Count to twenty:",
+        .max_tokens = 32,
+        .temperature = 0.0f,
+        .is_cancelled = cancel_after,
+        .user_data = &polls_left,
+    };
+
+    /* Cancelled before the prompt is evaluated */
+    neuronos_gen_result_t r = neuronos_generate(g_model, params);
+    ASSERT(r.status == NEURONOS_ERROR_CANCELLED && r.n_tokens == 0, "prefill cancellation ignored");
+    neuronos_gen_result_free(&r);
+
+    /* One poll for the prompt chunk, then one per token */
+    polls_left = 3;
+    r = neuronos_generate(g_model, params);
+    ASSERT(r.status == NEURONOS_ERROR_CANCELLED, "decode cancellation ignored");
+    ASSERT(r.text != NULL && r.n_tokens <= 2, "generation ran past the cancellation");
+    neuronos_gen_result_free(&r);
+
+    /* Scheduler: the slot finishes cancelled and keeps its KV cells */
+    neuronos_scheduler_params_t sp = {.n_slots = 1, .slot_ctx = 512};
+    neuronos_scheduler_t * sched = neuronos_scheduler_create(g_model, sp);
+    ASSERT(sched != NULL, "scheduler create failed");
+    polls_left = 3;
+    int id = neuronos_scheduler_submit(sched, params);
+    ASSERT(id >= 0, "submit failed");
+    neuronos_scheduler_run(sched);
+    ASSERT(neuronos_scheduler_take(sched, id, &r), "take failed");
+    ASSERT(r.status == NEURONOS_ERROR_CANCELLED && r.n_tokens < params.max_tokens, "scheduled cancellation ignored");
+    neuronos_gen_result_free(&r);
+
+    params.is_cancelled = NULL;
+    id = neuronos_scheduler_submit(sched, params);
+    ASSERT(neuronos_scheduler_run(sched) == NEURONOS_OK, "run after cancellation failed");
+    ASSERT(neuronos_scheduler_take(sched, id, &r), "take after cancellation failed");
+    ASSERT(r.status == NEURONOS_OK && r.n_reused_tokens > 0, "cancelled slot lost its cached prompt");
+    neuronos_gen_result_free(&r);
+    neuronos_scheduler_free(sched);
+
+    TEST_PASS();
+}
+
+/* ---- Test 25: Parallel tool batches ---- */
+static int g_batch_started = 0;
+
+/* Thread-safe tool: only succeeds if all three run at the same time */
+static neuronos_tool_result_t batch_tool_rendezvous(const char * args_json, void * user_data) {
+    (void)user_data;
+    neuronos_tool_result_t r = {0};
+    test_atomic_inc(&g_batch_started);
+    double t0 = neuronos_metrics_now_ms();
+    while (test_atomic_load(&g_batch_started) < 3 && neuronos_metrics_now_ms() - t0 < 2000.0) {
+    }
+    r.success = test_atomic_load(&g_batch_started) >= 3;
+    r.output = strdup(args_json);
+    return r;
+}
+
+/* Unsafe tool: reports how many calls had started before it ran */
+static neuronos_tool_result_t batch_tool_serial(const char * args_json, void * user_data) {
+    (void)args_json;
+    (void)user_data;
+    neuronos_tool_result_t r = {0};
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%d", test_atomic_inc(&g_batch_started));
+    r.success = true;
+    r.output = strdup(buf);
+    return r;
+}
+
+static void test_tool_batch(void) {
+    TEST_START("Parallel tool batches");
+
+    neuronos_tool_registry_t * reg = neuronos_tool_registry_create();
+    neuronos_tool_desc_t meet = {
+        .name = "meet", .description = "", .args_schema_json = "{}",
+        .execute = batch_tool_rendezvous, .thread_safe = true,
+    };
+    neuronos_tool_desc_t serial = {
+        .name = "serial", .description = "", .args_schema_json = "{}",
+        .execute = batch_tool_serial,
+    };
+    neuronos_tool_register(reg, &meet);
+    neuronos_tool_register(reg, &serial);
+
+    neuronos_tool_call_t calls[] = {
+        {"serial", NULL}, {"meet", "{\"i\":1}"}, {"missing", "{}"}, {"meet", "{\"i\":3}"}, {"meet", "{\"i\":4}"},
+    };
+    neuronos_tool_result_t res[5];
+    neuronos_tool_execute_batch(reg, calls, 5, res, 4);
+
+    ASSERT(res[1].success && res[3].success && res[4].success, "thread-safe calls did not overlap");
+    ASSERT(strcmp(res[1].output, "{\"i\":1}") == 0 && strcmp(res[4].output, "{\"i\":4}") == 0,
+           "results out of call order");
+    ASSERT(res[0].success && strcmp(res[0].output, "4") == 0, "unsafe call should run after the parallel ones");
+    ASSERT(!res[2].success, "unknown tool in a batch should fail in place");
+    for (int i = 0; i < 5; i++)
+        neuronos_tool_result_free(&res[i]);
+
+    /* A second batch runs on the helpers the first one started */
+    g_batch_started = 0;
+    neuronos_tool_execute_batch(reg, calls + 1, 4, res, 4);
+    ASSERT(res[0].success && res[2].success && res[3].success, "pooled helpers did not pick up the next batch");
+    for (int i = 0; i < 4; i++)
+        neuronos_tool_result_free(&res[i]);
+
+    neuronos_tool_registry_free(reg);
+    TEST_PASS();
+}
+
+/* ---- Test 26: Tool result cache ---- */
+static int g_cache_runs = 0;
+
+static neuronos_tool_result_t cache_tool_count(const char * args_json, void * user_data) {
+    (void)args_json;
+    (void)user_data;
+    neuronos_tool_result_t r = {0};
+    char buf[16];
+    snprintf(buf, sizeof(buf), "run %d", ++g_cache_runs);
+    r.success = true;
+    r.output = strdup(buf);
+    return r;
+}
+
+static void test_tool_cache(void) {
+    TEST_START("Tool result cache");
+
+    const char * path = "test_tool_cache.txt";
+    FILE * f = fopen(path, "w");
+    ASSERT(f != NULL, "cannot create temp file");
+    fputs("one", f);
+    fclose(f);
+
+    neuronos_tool_registry_t * reg = neuronos_tool_registry_create();
+    neuronos_tool_desc_t file_tool = {
+        .name = "peek", .description = "", .args_schema_json = "{}",
+        .execute = cache_tool_count, .cache = NEURONOS_TOOL_CACHE_PATH,
+    };
+    neuronos_tool_desc_t plain = {
+        .name = "plain", .description = "", .args_schema_json = "{}",
+        .execute = cache_tool_count,
+    };
+    neuronos_tool_register(reg, &file_tool);
+    neuronos_tool_register(reg, &plain);
+
+    /* Disabled by default */
+    neuronos_tool_result_t r = neuronos_tool_execute(reg, "peek", "{\"path\":\"test_tool_cache.txt\"}");
+    neuronos_tool_result_free(&r);
+    r = neuronos_tool_execute(reg, "peek", "{\"path\":\"test_tool_cache.txt\"}");
+    ASSERT(r.success && strcmp(r.output, "run 2") == 0, "cache should be off by default");
+    neuronos_tool_result_free(&r);
+
+    neuronos_tool_cache_enable(reg, 64 * 1024);
+    r = neuronos_tool_execute(reg, "peek", "{\"path\":\"test_tool_cache.txt\",\"start_line\":1}");
+    neuronos_tool_result_free(&r);
+    r = neuronos_tool_execute(reg, "peek", "{ \"start_line\": 1, \"path\": \"test_tool_cache.txt\" }");
+    ASSERT(r.success && strcmp(r.output, "run 3") == 0, "reordered args should hit");
+    neuronos_tool_result_free(&r);
+
+    /* A different size invalidates, whatever the mtime granularity */
+    f = fopen(path, "w");
+    fputs("three", f);
+    fclose(f);
+    r = neuronos_tool_execute(reg, "peek", "{\"path\":\"test_tool_cache.txt\",\"start_line\":1}");
+    ASSERT(r.success && strcmp(r.output, "run 4") == 0, "modified file should miss");
+    neuronos_tool_result_free(&r);
+
+    /* Uncacheable tools always run */
+    r = neuronos_tool_execute(reg, "plain", "{}");
+    neuronos_tool_result_free(&r);
+    r = neuronos_tool_execute(reg, "plain", "{}");
+    ASSERT(r.success && strcmp(r.output, "run 6") == 0, "CACHE_NONE tool should not be cached");
+    neuronos_tool_result_free(&r);
+
+    neuronos_tool_cache_stats_t st = neuronos_tool_cache_stats(reg);
+    ASSERT(st.hits == 1 && st.misses == 2 && st.entries == 1, "unexpected cache stats");
+    ASSERT(st.bytes > 0 && st.bytes <= st.max_bytes, "cache size not accounted");
+
+    neuronos_tool_cache_enable(reg, 0);
+    st = neuronos_tool_cache_stats(reg);
+    ASSERT(st.entries == 0 && st.bytes == 0, "disabling should drop entries");
+
+    neuronos_tool_registry_free(reg);
+    remove(path);
+    TEST_PASS();
+}
+
+/* ---- Test 27: Tool relevance selection ---- */
+static neuronos_tool_result_t select_tool_noop(const char * args_json, void * user_data) {
+    (void)args_json;
+    (void)user_data;
+    neuronos_tool_result_t r = {0};
+    r.success = true;
+    r.output = strdup("ok");
+    return r;
+}
+
+static void test_tool_select(void) {
+    TEST_START("Tool relevance selection");
+
+    /* Names must outlive the registry: it keeps the caller's pointers */
+    static char names[200][24];
+    static char descs[200][64];
+    neuronos_tool_registry_t * reg = neuronos_tool_registry_create();
+    for (int i = 0; i < 200; i++) {
+        snprintf(names[i], sizeof(names[i]), "mcp_tool_%d", i);
+        snprintf(descs[i], sizeof(descs[i]), "Generic remote operation number %d", i);
+        neuronos_tool_desc_t d = {
+            .name = names[i], .description = descs[i], .args_schema_json = "{}",
+            .execute = select_tool_noop,
+        };
+        if (i == 137) {
+            snprintf(names[i], sizeof(names[i]), "weather_forecast");
+            d.description = "Get the weather forecast for a city";
+        }
+        ASSERT(neuronos_tool_register(reg, &d) == 0, "registration past 64 tools failed");
+    }
+    ASSERT(neuronos_tool_count(reg) == 200, "expected 200 tools");
+    ASSERT(neuronos_tool_register(reg, &(neuronos_tool_desc_t){
+               .name = "weather_forecast", .description = "", .execute = select_tool_noop}) != 0,
+           "duplicate name should be rejected");
+
+    neuronos_tool_result_t r = neuronos_tool_execute(reg, "mcp_tool_199", "{}");
+    ASSERT(r.success, "lookup of the last tool failed");
+    neuronos_tool_result_free(&r);
+
+    int idx[8];
+    int n = neuronos_tool_select(reg, "What's the weather in Paris tomorrow?", 8, idx);
+    ASSERT(n >= 1 && idx[0] == 137, "weather tool should rank first");
+    ASSERT(neuronos_tool_select(reg, "the and of", 8, idx) == 0, "stopword query should match nothing");
+
+    int subset[2] = {3, 137};
+    char * desc = neuronos_tool_prompt_description_subset(reg, subset, 2);
+    ASSERT(desc && strstr(desc, "weather_forecast") && strstr(desc, "mcp_tool_3:") &&
+               !strstr(desc, "mcp_tool_4:"),
+           "subset description should list only the subset");
+    free(desc);
+
+    char * grammar = neuronos_tool_grammar_names_subset(reg, subset, 2);
+    ASSERT(grammar && strstr(grammar, "\\\"weather_forecast\\\"") && !strstr(grammar, "mcp_tool_4\\"),
+           "subset grammar should list only the subset");
+    free(grammar);
+
+    neuronos_tool_registry_free(reg);
+    TEST_PASS();
+}
+
 /* ============================================================
- * MAIN
+ * TEST 28: GGUF header scan & scan cache
  * ============================================================ */
+static void gguf_w_u32(FILE * f, uint32_t v) {
+    fwrite(&v, 4, 1, f);
+}
+static void gguf_w_u64(FILE * f, uint64_t v) {
+    fwrite(&v, 8, 1, f);
+}
+static void gguf_w_str(FILE * f, const char * s) {
+    gguf_w_u64(f, strlen(s));
+    fwrite(s, 1, strlen(s), f);
+}
+static void gguf_w_kv_u32(FILE * f, const char * key, uint32_t v) {
+    gguf_w_str(f, key);
+    gguf_w_u32(f, 4); /* GGUF_TYPE_UINT32 */
+    gguf_w_u32(f, v);
+}
+
+/* Minimal llama-style GGUF: one 256x256 Q4_K matrix + one F32 norm */
+static bool write_test_gguf(const char * path, uint32_t n_layer) {
+    FILE * f = fopen(path, "wb");
+    if (!f)
+        return false;
+    fwrite("GGUF", 1, 4, f);
+    gguf_w_u32(f, 3);
+    gguf_w_u64(f, 2); /* tensors */
+    gguf_w_u64(f, 7); /* kv pairs */
+    gguf_w_str(f, "general.architecture");
+    gguf_w_u32(f, 8); /* string */
+    gguf_w_str(f, "llama");
+    gguf_w_str(f, "tokenizer.ggml.scores");
+    gguf_w_u32(f, 9); /* array of f32, skipped */
+    gguf_w_u32(f, 6);
+    gguf_w_u64(f, 100);
+    for (int i = 0; i < 100; i++)
+        fwrite(&(float){0.5f}, 4, 1, f);
+    gguf_w_kv_u32(f, "llama.block_count", n_layer);
+    gguf_w_kv_u32(f, "llama.embedding_length", 256);
+    gguf_w_kv_u32(f, "llama.context_length", 1024);
+    gguf_w_kv_u32(f, "llama.attention.head_count", 8);
+    gguf_w_kv_u32(f, "llama.attention.head_count_kv", 2);
+
+    gguf_w_str(f, "blk.0.attn_q.weight");
+    gguf_w_u32(f, 2);
+    gguf_w_u64(f, 256);
+    gguf_w_u64(f, 256);
+    gguf_w_u32(f, 12); /* Q4_K */
+    gguf_w_u64(f, 0);
+    gguf_w_str(f, "output_norm.weight");
+    gguf_w_u32(f, 1);
+    gguf_w_u64(f, 256);
+    gguf_w_u32(f, 0); /* F32 */
+    gguf_w_u64(f, 36864);
+
+    long pad = (32 - ftell(f) % 32) % 32;
+    size_t data = (size_t)pad + 36864 + 1024 + n_layer; /* size differs per n_layer */
+    for (size_t i = 0; i < data; i++)
+        fputc(0, f);
+    return fclose(f) == 0;
+}
+
+static void test_gguf_scan(void) {
+    TEST_START("GGUF header scan & scan cache");
+
+    const char * dir = "neuronos_scan_test";
+    const char * path = "neuronos_scan_test/misnamed-q8_0.gguf";
+#ifdef _WIN32
+    _mkdir(dir);
+#else
+    mkdir(dir, 0755);
+#endif
+    ASSERT(write_test_gguf(path, 4), "could not write test GGUF");
+
+    neuronos_hw_info_t hw = neuronos_detect_hardware();
+    int count = 0;
+    neuronos_model_entry_t * models = neuronos_model_scan(dir, &hw, &count);
+    ASSERT(models && count == 1, "scan should find the test model");
+    ASSERT(models[0].quant == NEURONOS_QUANT_Q4_K_M, "quant should come from tensor types, not the filename");
+    ASSERT(models[0].n_params_est == 256 * 256 + 256, "param count should be exact");
+    ASSERT(models[0].n_layer == 4 && models[0].n_embd == 256 && models[0].n_ctx_train == 1024,
+           "header fields not read");
+    /* 4 layers × 2 KV heads × (32 + 32) dims × 2 bytes */
+    ASSERT(models[0].kv_bytes_per_tok == 1024, "GQA-aware KV size wrong");
+    neuronos_model_scan_free(models, count);
+
+    /* A changed file (new size) must not be served from models.idx */
+    ASSERT(write_test_gguf(path, 6), "could not rewrite test GGUF");
+    models = neuronos_model_scan(dir, &hw, &count);
+    ASSERT(models && count == 1 && models[0].n_layer == 6, "stale scan cache entry");
+
+    /* Tuning never asks for more context than the model was trained on */
+    neuronos_tuned_params_t t = neuronos_auto_tune(&hw, &models[0]);
+    ASSERT(t.n_ctx <= 1024, "n_ctx should be capped at n_ctx_train");
+    neuronos_model_scan_free(models, count);
+
+    remove(path);
+#ifdef _WIN32
+    _rmdir(dir);
+#else
+    rmdir(dir);
+#endif
+    TEST_PASS();
+}
+
+/* ---- Test 29: Metrics shard reuse across short-lived threads ---- */
+#define SHARD_WAVES 25
+#define SHARD_WAVE_THREADS 8
+
+static void * shard_thread(void * arg) {
+    (void)arg;
+    neuronos_metrics_record(NEURONOS_METRIC_TOOL, 1.0);
+    neuronos_metrics_add(NEURONOS_COUNTER_TOOL_ERRORS, 1);
+    return NULL;
+}
+
+static void test_metrics_shards(void) {
+    TEST_START("Metrics shard reuse across short-lived threads");
+
+    neuronos_metrics_reset();
+    int before = neuronos_metrics_shard_count();
+    for (int w = 0; w < SHARD_WAVES; w++) {
+        test_thread_t th[SHARD_WAVE_THREADS];
+        int started = 0;
+        while (started < SHARD_WAVE_THREADS && test_thread_start(&th[started], shard_thread, NULL))
+            started++;
+        for (int i = 0; i < started; i++)
+            test_thread_join(th[i]);
+        ASSERT(started == SHARD_WAVE_THREADS, "thread start failed");
+    }
+
+    int after = neuronos_metrics_shard_count();
+    fprintf(stderr, "\n  %d threads, shards %d -> %d", SHARD_WAVES * SHARD_WAVE_THREADS, before, after);
+    ASSERT(after <= before + SHARD_WAVE_THREADS, "shards of exited threads were not reused");
+    /* Adopted shards keep what their previous owners recorded */
+    ASSERT(neuronos_metrics_get(NEURONOS_METRIC_TOOL).count == SHARD_WAVES * SHARD_WAVE_THREADS,
+           "samples lost across shard reuse");
+    ASSERT(neuronos_metrics_counter(NEURONOS_COUNTER_TOOL_ERRORS) == SHARD_WAVES * SHARD_WAVE_THREADS,
+           "counters lost across shard reuse");
+    neuronos_metrics_reset();
+
+    TEST_PASS();
+}
+
 int main(int argc, char * argv[]) {
     fprintf(stderr, "═══════════════════════════════════════════\n");
     fprintf(stderr, "  NeuronOS Engine & Agent Test Suite v0.7\n");
@@ -669,6 +1567,20 @@ int main(int argc, char * argv[]) {
     test_mcp_protocol();
     test_chat_format();
     test_ternary_gpu_guard();
+    test_kv_prefix_reuse();
+    test_scheduler();
+    test_session_snapshot();
+    test_speculative();
+    test_metrics();
+    test_grammar_cache();
+    test_coalesced_stream();
+    test_model_pool();
+    test_cancellation();
+    test_tool_batch();
+    test_tool_cache();
+    test_tool_select();
+    test_gguf_scan();
+    test_metrics_shards();
 
     /* Cleanup model if loaded */
     if (g_model)
@@ -7,6 +7,12 @@
  *   2. Backend registration and selection
  *   3. Scalar vec_dot correctness
  *   4. Scalar quantize correctness
+ *   5. AVX-VNNI / AVX-512 vec_dot agree with the scalar reference
+ *   6. SVE / I8MM vec_dot and gemm agree with the scalar reference
+ *   7. x86 blocked prefill gemm agrees with the scalar reference
+ *   8. Kernel config validation, first-gemm autotune and persistence
+ *   9. Threaded dispatch matches single-threaded results
+ *  14. Streaming, threaded I2_S row packing matches scalar quantize
  */
 
 #include "neuronos/neuronos_hal.h"
@@ -16,6 +22,19 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef _WIN32
+    #include <direct.h>
+    #include <io.h>
+    #define test_setenv(k, v) _putenv_s(k, v)
+    #define test_unsetenv(k)  _putenv_s(k, "")
+    #define test_rmdir(p)     _rmdir(p)
+#else
+    #include <unistd.h>
+    #define test_setenv(k, v) setenv(k, v, 1)
+    #define test_unsetenv(k)  unsetenv(k)
+    #define test_rmdir(p)     rmdir(p)
+#endif
+
 #define ASSERT(cond, msg)                                                                                              \
     do {                                                                                                               \
         if (!(cond)) {                                                                                                 \
@@ -149,6 +168,464 @@ static int test_scalar_vec_dot(void) {
     return 0;
 }
 
+/* ──────── SIMD-vs-scalar helpers ──────── */
+
+/* 5 blocks (odd: exercises single-block tails) × 11 rows (8/4-row passes + remainder) */
+enum { CMP_N = 5 * 128, CMP_ROWS = 11, CMP_COLS = 7 };
+
+static uint8_t g_cmp_packed[CMP_ROWS * CMP_N / 4];
+static int8_t g_cmp_act[CMP_COLS * CMP_N];
+
+/* Registered backend of this type whose features the CPU has, or NULL */
+static const neuronos_backend_t * find_feasible_backend(neuronos_backend_type_t type) {
+    for (int i = 0; i < neuronos_hal_get_backend_count(); i++) {
+        const neuronos_backend_t * b = neuronos_hal_get_backend(i);
+        if (b->type == type && (neuronos_hal_get_features() & b->required_features) == b->required_features)
+            return b;
+    }
+    return NULL;
+}
+
+/* Random packed weights (raw values 0..2 only) and activations */
+static void fill_cmp_data(void) {
+    unsigned seed = 12345;
+    for (size_t i = 0; i < sizeof(g_cmp_packed); i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint8_t b = 0;
+        for (int k = 0; k < 4; k++)
+            b = (uint8_t)((b << 2) | ((seed >> (8 + 2 * k)) % 3));
+        g_cmp_packed[i] = b;
+    }
+    for (size_t i = 0; i < sizeof(g_cmp_act); i++) {
+        seed = seed * 1103515245u + 12345u;
+        g_cmp_act[i] = (int8_t)(seed >> 16);
+    }
+}
+
+/* ──────── Test 5: AVX-VNNI / AVX-512 vec_dot vs scalar ──────── */
+static int test_vnni_vec_dot(void) {
+    const neuronos_backend_t * ref = find_feasible_backend(NEURONOS_BACKEND_SCALAR);
+    const neuronos_backend_t * vnni[2] = {
+        find_feasible_backend(NEURONOS_BACKEND_X86_AVXVNNI),
+        find_feasible_backend(NEURONOS_BACKEND_X86_AVX512),
+    };
+    ASSERT(ref != NULL, "Scalar backend should be registered");
+    if (!vnni[0] && !vnni[1]) {
+        printf("  SKIP: AVX-VNNI / AVX512-VNNI not available\n");
+        return 0;
+    }
+
+    fill_cmp_data();
+    float want[CMP_ROWS];
+    ref->vec_dot_i2_i8(CMP_N, want, sizeof(float), g_cmp_packed, CMP_N, g_cmp_act, 0, CMP_ROWS);
+
+    for (int k = 0; k < 2; k++) {
+        if (!vnni[k])
+            continue;
+        float got[CMP_ROWS];
+        vnni[k]->vec_dot_i2_i8(CMP_N, got, sizeof(float), g_cmp_packed, CMP_N, g_cmp_act, 0, CMP_ROWS);
+        for (int r = 0; r < CMP_ROWS; r++) {
+            ASSERT(got[r] == want[r], "VNNI vec_dot should match scalar");
+        }
+        printf("  %s: row 0 = %.1f (scalar %.1f)\n", vnni[k]->name, got[0], want[0]);
+    }
+
+    PASS("VNNI vec_dot matches scalar");
+    return 0;
+}
+
+/* ──────── Test 6: SVE / I8MM vec_dot + gemm vs scalar ──────── */
+static int test_sve_kernels(void) {
+    const neuronos_backend_t * ref = find_feasible_backend(NEURONOS_BACKEND_SCALAR);
+    const neuronos_backend_t * sve[2] = {
+        find_feasible_backend(NEURONOS_BACKEND_ARM_SVE),
+        find_feasible_backend(NEURONOS_BACKEND_ARM_SVE_I8MM),
+    };
+    ASSERT(ref != NULL, "Scalar backend should be registered");
+    if (!sve[0] && !sve[1]) {
+        printf("  SKIP: SVE not available\n");
+        return 0;
+    }
+
+    fill_cmp_data();
+    static float want[CMP_COLS][CMP_ROWS], got[CMP_COLS][CMP_ROWS];
+    ref->gemm_i2_i8(CMP_N, &want[0][0], sizeof(want[0]), g_cmp_packed, g_cmp_act, CMP_ROWS, CMP_COLS);
+
+    for (int k = 0; k < 2; k++) {
+        const neuronos_backend_t * b = sve[k];
+        if (!b)
+            continue;
+
+        float vd[CMP_ROWS];
+        b->vec_dot_i2_i8(CMP_N, vd, sizeof(float), g_cmp_packed, CMP_N, g_cmp_act, 0, CMP_ROWS);
+        for (int r = 0; r < CMP_ROWS; r++)
+            ASSERT(vd[r] == want[0][r], "SVE vec_dot should match scalar");
+
+        memset(got, 0, sizeof(got));
+        b->gemm_i2_i8(CMP_N, &got[0][0], sizeof(got[0]), g_cmp_packed, g_cmp_act, CMP_ROWS, CMP_COLS);
+        for (int c = 0; c < CMP_COLS; c++)
+            for (int r = 0; r < CMP_ROWS; r++)
+                ASSERT(got[c][r] == want[c][r], "SVE gemm should match scalar");
+        printf("  %s: vec_dot + %dx%d gemm match scalar\n", b->name, CMP_ROWS, CMP_COLS);
+    }
+
+    PASS("SVE kernels match scalar");
+    return 0;
+}
+
+/* ──────── Test 7: x86 blocked gemm vs scalar ──────── */
+static int test_x86_gemm(void) {
+    const neuronos_backend_t * ref = find_feasible_backend(NEURONOS_BACKEND_SCALAR);
+    const neuronos_backend_t * x86 = find_feasible_backend(NEURONOS_BACKEND_X86_AVX2);
+    ASSERT(ref != NULL, "Scalar backend should be registered");
+    if (!x86) {
+        printf("  SKIP: AVX2 not available\n");
+        return 0;
+    }
+
+    fill_cmp_data();
+    static float want[CMP_COLS][CMP_ROWS], got[CMP_COLS][CMP_ROWS];
+    ref->gemm_i2_i8(CMP_N, &want[0][0], sizeof(want[0]), g_cmp_packed, g_cmp_act, CMP_ROWS, CMP_COLS);
+    x86->gemm_i2_i8(CMP_N, &got[0][0], sizeof(got[0]), g_cmp_packed, g_cmp_act, CMP_ROWS, CMP_COLS);
+    for (int c = 0; c < CMP_COLS; c++)
+        for (int r = 0; r < CMP_ROWS; r++)
+            ASSERT(got[c][r] == want[c][r], "x86 blocked gemm should match scalar");
+    printf("  %dx%d gemm: [0][0] = %.1f\n", CMP_ROWS, CMP_COLS, got[0][0]);
+
+    PASS("x86 blocked gemm matches scalar");
+    return 0;
+}
+
+/* ──────── Test 8: Kernel config + autotune ──────── */
+
+static int test_autotune(void) {
+    const neuronos_kernel_config_t * cur = neuronos_hal_get_kernel_config();
+    ASSERT(cur != NULL, "Active backend should have a kernel config");
+
+    neuronos_kernel_config_t bad = *cur;
+    bad.qk_i2_s = cur->qk_i2_s * 2;
+    ASSERT(neuronos_hal_set_kernel_config(&bad) == NEURONOS_HAL_ERR_INVALID, "qk_i2_s must not change");
+    bad = *cur;
+    bad.row_block_size = 0;
+    ASSERT(neuronos_hal_set_kernel_config(&bad) == NEURONOS_HAL_ERR_INVALID, "row_block_size must be > 0");
+    ASSERT(neuronos_hal_set_kernel_config(NULL) == NEURONOS_HAL_ERR_INVALID, "NULL config rejected");
+
+    neuronos_hal_shape_t bad_shape = {100, 16};
+    ASSERT(neuronos_hal_autotune(&bad_shape, 1) == NEURONOS_HAL_ERR_INVALID, "n must be a multiple of 128");
+
+    /* The first dispatched gemm tunes on its own shape (HOME is a scratch dir) */
+    fill_cmp_data();
+    static float out[CMP_COLS][CMP_ROWS];
+    neuronos_gemm_i2_i8(CMP_N, &out[0][0], sizeof(out[0]), g_cmp_packed, g_cmp_act, CMP_ROWS, CMP_COLS);
+    ASSERT(neuronos_hal_config_is_tuned(), "first gemm dispatch should tune");
+
+    neuronos_hal_shape_t shapes[2] = {{CMP_N, 64}, {1024, 64}};
+    ASSERT(neuronos_hal_autotune(shapes, 2) == NEURONOS_HAL_OK, "autotune should succeed");
+    ASSERT(neuronos_hal_config_is_tuned(), "config should be tuned after autotune");
+    int tuned_kb = neuronos_hal_get_kernel_config()->gemm_panel_kb;
+
+    /* Re-init: the persisted result is applied again */
+    neuronos_hal_shutdown();
+    ASSERT(neuronos_hal_init() == NEURONOS_HAL_OK, "re-init should succeed");
+    ASSERT(neuronos_hal_config_is_tuned(), "persisted config should be applied at init");
+    ASSERT(neuronos_hal_get_kernel_config()->gemm_panel_kb == tuned_kb, "persisted panel should match");
+    printf("  gemm_panel = %d KB\n", tuned_kb);
+
+    PASS("Kernel config validation and autotune");
+    return 0;
+}
+
+/* ──────── Test 9: Thread pool dispatch ──────── */
+static int test_thread_pool(void) {
+    const neuronos_hal_topology_t * topo = neuronos_hal_get_topology();
+    ASSERT(topo && topo->n_cpus >= 1, "Topology should report at least one CPU");
+    ASSERT(topo->n_big + topo->n_little >= 1 && topo->n_nodes >= 1, "Topology counts should be sane");
+    printf("  %d CPUs, %d cores, %d nodes, %d big / %d little\n", topo->n_cpus, topo->n_cores, topo->n_nodes,
+           topo->n_big, topo->n_little);
+    ASSERT(neuronos_hal_set_n_threads(0) == NEURONOS_HAL_ERR_INVALID, "0 threads rejected");
+
+    /* Large enough to be split across the pool */
+    const int n = CMP_N, nr = 517, nc = 3;
+    uint8_t * w = malloc((size_t)nr * n / 4);
+    int8_t * a = malloc((size_t)nc * n);
+    float * want = malloc((size_t)nr * nc * sizeof(float));
+    float * got = malloc((size_t)nr * nc * sizeof(float));
+    ASSERT(w && a && want && got, "alloc");
+    for (int i = 0; i < nr * n / 4; i++)
+        w[i] = (uint8_t)((i * 37 + 11) & 0xFF);
+    for (int i = 0; i < nc * n; i++)
+        a[i] = (int8_t)((i * 13) % 255 - 127);
+
+    neuronos_gemm_i2_i8(n, want, (size_t)nr * sizeof(float), w, a, nr, nc);
+    ASSERT(neuronos_hal_set_n_threads(4) == NEURONOS_HAL_OK, "set_n_threads(4) should succeed");
+    ASSERT(neuronos_hal_get_n_threads() == 4, "pool should have 4 threads");
+    for (int rep = 0; rep < 3; rep++) {
+        memset(got, 0, (size_t)nr * nc * sizeof(float));
+        neuronos_gemm_i2_i8(n, got, (size_t)nr * sizeof(float), w, a, nr, nc);
+        ASSERT(memcmp(got, want, (size_t)nr * nc * sizeof(float)) == 0, "threaded gemm should match");
+    }
+    const neuronos_backend_t * b = neuronos_hal_get_active_backend();
+    b->vec_dot_i2_i8(n, want, 0, w, (size_t)n, a, 0, nr);
+    neuronos_vec_dot_i2_i8(n, got, 0, w, (size_t)n, a, 0, nr);
+    ASSERT(memcmp(got, want, (size_t)nr * sizeof(float)) == 0, "threaded vec_dot should match");
+
+    neuronos_hal_status_t st = neuronos_hal_place_weights(w, (size_t)n / 4, nr, b->config.row_block_size);
+    ASSERT(st == NEURONOS_HAL_OK || st == NEURONOS_HAL_ERR_UNSUPPORTED, "place_weights should not fail");
+
+    ASSERT(neuronos_hal_set_n_threads(1) == NEURONOS_HAL_OK, "pool should shrink back to 1");
+    free(w);
+    free(a);
+    free(want);
+    free(got);
+
+    PASS("Threaded dispatch matches single-threaded");
+    return 0;
+}
+
+/* ──────── Test 10: RVV vec_dot + gemm + quantize vs scalar ──────── */
+static int test_rvv_kernels(void) {
+    const neuronos_backend_t * ref = find_feasible_backend(NEURONOS_BACKEND_SCALAR);
+    const neuronos_backend_t * rvv = find_feasible_backend(NEURONOS_BACKEND_RISCV_RVV);
+    ASSERT(ref != NULL, "Scalar backend should be registered");
+    if (!rvv) {
+        printf("  SKIP: RVV not available\n");
+        return 0;
+    }
+
+    fill_cmp_data();
+    static float want[CMP_COLS][CMP_ROWS], got[CMP_COLS][CMP_ROWS];
+    ref->gemm_i2_i8(CMP_N, &want[0][0], sizeof(want[0]), g_cmp_packed, g_cmp_act, CMP_ROWS, CMP_COLS);
+
+    float vd[CMP_ROWS];
+    rvv->vec_dot_i2_i8(CMP_N, vd, sizeof(float), g_cmp_packed, CMP_N, g_cmp_act, 0, CMP_ROWS);
+    for (int r = 0; r < CMP_ROWS; r++)
+        ASSERT(vd[r] == want[0][r], "RVV vec_dot should match scalar");
+
+    rvv->gemm_i2_i8(CMP_N, &got[0][0], sizeof(got[0]), g_cmp_packed, g_cmp_act, CMP_ROWS, CMP_COLS);
+    for (int c = 0; c < CMP_COLS; c++)
+        for (int r = 0; r < CMP_ROWS; r++)
+            ASSERT(got[c][r] == want[c][r], "RVV gemm should match scalar");
+
+    /* Quantize: signs, exact zeros and values on both sides of the 1e-6 threshold */
+    static float src[2 * CMP_N];
+    static uint8_t q_want[2 * CMP_N / 4 + 32], q_got[2 * CMP_N / 4 + 32];
+    for (int i = 0; i < 2 * CMP_N; i++) {
+        const float v[6] = {0.0f, 9.99e-7f, -1.01e-6f, 0.5f, -0.25f, 3.0f};
+        src[i] = v[(i * 7) % 6] * (float)(1 + i % 5);
+    }
+    size_t n_want = ref->quantize_i2(src, q_want, 2, CMP_N, NULL);
+    size_t n_got = rvv->quantize_i2(src, q_got, 2, CMP_N, NULL);
+    ASSERT(n_got == n_want, "RVV quantize should return the scalar size");
+    ASSERT(memcmp(q_got, q_want, 2 * CMP_N / 4 + sizeof(float)) == 0, "RVV quantize should match scalar");
+    printf("  %s: vec_dot + %dx%d gemm + quantize match scalar\n", rvv->name, CMP_ROWS, CMP_COLS);
+
+    PASS("RVV kernels match scalar");
+    return 0;
+}
+
+/* ──────── Test 11: WASM SIMD128 / relaxed-SIMD vs scalar ──────── */
+static int test_wasm_kernels(void) {
+    const neuronos_backend_t * ref = find_feasible_backend(NEURONOS_BACKEND_SCALAR);
+    const neuronos_backend_t * wasm[2] = {
+        find_feasible_backend(NEURONOS_BACKEND_WASM),
+        find_feasible_backend(NEURONOS_BACKEND_WASM_RELAXED),
+    };
+    ASSERT(ref != NULL, "Scalar backend should be registered");
+    if (!wasm[0] && !wasm[1]) {
+        printf("  SKIP: WASM SIMD not available\n");
+        return 0;
+    }
+
+    fill_cmp_data();
+    static float want[CMP_COLS][CMP_ROWS], got[CMP_COLS][CMP_ROWS];
+    ref->gemm_i2_i8(CMP_N, &want[0][0], sizeof(want[0]), g_cmp_packed, g_cmp_act, CMP_ROWS, CMP_COLS);
+
+    for (int k = 0; k < 2; k++) {
+        const neuronos_backend_t * b = wasm[k];
+        if (!b)
+            continue;
+
+        float vd[CMP_ROWS];
+        b->vec_dot_i2_i8(CMP_N, vd, sizeof(float), g_cmp_packed, CMP_N, g_cmp_act, 0, CMP_ROWS);
+        for (int r = 0; r < CMP_ROWS; r++)
+            ASSERT(vd[r] == want[0][r], "WASM vec_dot should match scalar");
+
+        b->gemm_i2_i8(CMP_N, &got[0][0], sizeof(got[0]), g_cmp_packed, g_cmp_act, CMP_ROWS, CMP_COLS);
+        for (int c = 0; c < CMP_COLS; c++)
+            for (int r = 0; r < CMP_ROWS; r++)
+                ASSERT(got[c][r] == want[c][r], "WASM gemm should match scalar");
+        printf("  %s: vec_dot + %dx%d gemm match scalar\n", b->name, CMP_ROWS, CMP_COLS);
+    }
+
+    PASS("WASM SIMD kernels match scalar");
+    return 0;
+}
+
+/* ──────── Test 12: LUT backend vs scalar ──────── */
+static int test_lut_kernels(void) {
+    const neuronos_backend_t * ref = find_feasible_backend(NEURONOS_BACKEND_SCALAR);
+    const neuronos_backend_t * lut = find_feasible_backend(NEURONOS_BACKEND_LUT);
+    ASSERT(ref != NULL, "Scalar backend should be registered");
+    ASSERT(lut != NULL, "LUT backend should always be registered");
+
+    /* CMP_ROWS is below the table threshold: exercises the direct path */
+    fill_cmp_data();
+    static float want[CMP_COLS][CMP_ROWS], got[CMP_COLS][CMP_ROWS];
+    ref->gemm_i2_i8(CMP_N, &want[0][0], sizeof(want[0]), g_cmp_packed, g_cmp_act, CMP_ROWS, CMP_COLS);
+    lut->gemm_i2_i8(CMP_N, &got[0][0], sizeof(got[0]), g_cmp_packed, g_cmp_act, CMP_ROWS, CMP_COLS);
+    for (int c = 0; c < CMP_COLS; c++)
+        for (int r = 0; r < CMP_ROWS; r++)
+            ASSERT(got[c][r] == want[c][r], "LUT gemm should match scalar");
+
+    /* Enough rows for the tables, and more blocks than one table chunk */
+    const int n = 20 * 128, nr = 37;
+    uint8_t * w = (uint8_t *)malloc((size_t)nr * n / 4);
+    int8_t * y = (int8_t *)malloc((size_t)n);
+    float * vd_want = (float *)malloc(nr * sizeof(float));
+    float * vd_got = (float *)malloc(nr * sizeof(float));
+    float * gv_got = (float *)malloc(nr * 2 * sizeof(float));
+    ASSERT(w && y && vd_want && vd_got && gv_got, "alloc");
+    uint32_t seed = 0x2545F491u;
+    for (size_t i = 0; i < (size_t)nr * n / 4; i++) {
+        seed = seed * 1103515245u + 12345u;
+        w[i] = (uint8_t)(seed >> 24);
+    }
+    for (int i = 0; i < n; i++) {
+        seed = seed * 1103515245u + 12345u;
+        y[i] = (int8_t)(seed >> 16);
+    }
+
+    ref->vec_dot_i2_i8(n, vd_want, sizeof(float), w, n, y, 0, nr);
+    lut->vec_dot_i2_i8(n, vd_got, sizeof(float), w, n, y, 0, nr);
+    lut->gemv_i2_i8(n, gv_got, 2 * sizeof(float), w, y, nr, 1);
+    int bad = 0;
+    for (int r = 0; r < nr; r++)
+        bad += vd_got[r] != vd_want[r] || gv_got[2 * r] != vd_want[r];
+    free(w);
+    free(y);
+    free(vd_want);
+    free(vd_got);
+    free(gv_got);
+    ASSERT(bad == 0, "LUT vec_dot / gemv should match scalar");
+
+    /* Untuned shapes dispatch to the active backend */
+    ASSERT(neuronos_hal_get_backend_for_shape(128, 1) == neuronos_hal_get_active_backend(),
+           "unlisted shape should use the active backend");
+    printf("  %s: %dx%d gemm + %dx%d vec_dot / gemv match scalar\n", lut->name, CMP_ROWS, CMP_COLS, nr, n);
+
+    PASS("LUT kernels match scalar");
+    return 0;
+}
+
+/* ──────── Test 13: Vulkan I2_S compute vs scalar ──────── */
+static void fill_random(uint8_t * w, size_t w_len, int8_t * a, size_t a_len, uint32_t seed) {
+    for (size_t i = 0; i < w_len; i++) {
+        seed = seed * 1103515245u + 12345u;
+        w[i] = (uint8_t)(seed >> 24);
+    }
+    for (size_t i = 0; i < a_len; i++) {
+        seed = seed * 1103515245u + 12345u;
+        a[i] = (int8_t)(seed >> 16);
+    }
+}
+
+static int test_vulkan_kernels(void) {
+    const neuronos_backend_t * ref = find_feasible_backend(NEURONOS_BACKEND_SCALAR);
+    const neuronos_backend_t * vk = find_feasible_backend(NEURONOS_BACKEND_VULKAN);
+    ASSERT(ref != NULL, "Scalar backend should be registered");
+    if (!vk) {
+        printf("  SKIP: Vulkan compute not available\n");
+        return 0;
+    }
+    ASSERT(neuronos_hal_select_backend(NEURONOS_BACKEND_VULKAN) == NEURONOS_HAL_OK, "select Vulkan");
+
+    /* Large enough to run on the GPU rather than the CPU fallback */
+    const int n = 1024, nr = 1100, nc = 3;
+    uint8_t * w = (uint8_t *)malloc((size_t)nr * n / 4);
+    int8_t * a = (int8_t *)malloc((size_t)nc * n);
+    float * want = (float *)malloc((size_t)nr * nc * sizeof(float));
+    float * got = (float *)malloc((size_t)nr * nc * 2 * sizeof(float));
+    ASSERT(w && a && want && got, "alloc");
+
+    int bad = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        /* Pass 1 rewrites the same host buffer: the cached copy must be refreshed */
+        fill_random(w, (size_t)nr * n / 4, a, (size_t)nc * n, 0x9E3779B9u + (uint32_t)pass);
+        ref->gemm_i2_i8(n, want, (size_t)nr * sizeof(float), w, a, nr, nc);
+
+        neuronos_gemm_i2_i8(n, got, (size_t)nr * sizeof(float), w, a, nr, nc);
+        for (int i = 0; i < nr * nc; i++)
+            bad += got[i] != want[i];
+        neuronos_gemv_i2_i8(n, got, 2 * sizeof(float), w, a, nr, 1);
+        for (int r = 0; r < nr; r++)
+            bad += got[2 * r] != want[r];
+        neuronos_vec_dot_i2_i8(n, got, 0, w, (size_t)n, a, 0, nr);
+        for (int r = 0; r < nr; r++)
+            bad += got[r] != want[r];
+    }
+
+    /* Small products take the CPU path and must agree as well */
+    fill_cmp_data();
+    float small_want[CMP_ROWS], small_got[CMP_ROWS];
+    ref->vec_dot_i2_i8(CMP_N, small_want, sizeof(float), g_cmp_packed, CMP_N, g_cmp_act, 0, CMP_ROWS);
+    neuronos_vec_dot_i2_i8(CMP_N, small_got, 0, g_cmp_packed, CMP_N, g_cmp_act, 0, CMP_ROWS);
+    for (int r = 0; r < CMP_ROWS; r++)
+        bad += small_got[r] != small_want[r];
+
+    free(w);
+    free(a);
+    free(want);
+    free(got);
+    neuronos_hal_shutdown();
+    ASSERT(neuronos_hal_init() == NEURONOS_HAL_OK, "re-init should succeed");
+    ASSERT(bad == 0, "Vulkan gemm / gemv / vec_dot should match scalar");
+    printf("  %s: %dx%d gemm, gemv, vec_dot match scalar\n", vk->name, nr, nc);
+
+    PASS("Vulkan I2_S kernels match scalar");
+    return 0;
+}
+
+/* ──────── Test 14: Streaming I2_S row packing vs scalar ──────── */
+static int test_quantize_rows(void) {
+    const neuronos_backend_t * ref = find_feasible_backend(NEURONOS_BACKEND_SCALAR);
+    ASSERT(ref != NULL, "Scalar backend should be registered");
+
+    /* Large enough to be split across the pool; edge values around the zero threshold */
+    const int n = 8 * 128, nr = 301;
+    const size_t packed = (size_t)nr * n / 4;
+    float * x = malloc((size_t)nr * n * sizeof(float));
+    uint8_t * want = calloc(packed + 32, 1);
+    uint8_t * got = calloc(packed + 32, 1);
+    ASSERT(x && want && got, "alloc");
+    static const float edge[] = {0.0f, -0.0f, 9e-7f, -1e-6f, 1.0000001e-6f, -3.5f};
+    unsigned seed = 777;
+    for (int i = 0; i < nr * n; i++) {
+        seed = seed * 1103515245u + 12345u;
+        x[i] = (i % 7 == 0) ? edge[(seed >> 8) % 6] : (float)((int)((seed >> 8) % 2001) - 1000) * 1e-3f;
+    }
+    ref->quantize_i2(x, want, nr, n, NULL);
+
+    ASSERT(neuronos_hal_set_n_threads(4) == NEURONOS_HAL_OK, "set_n_threads(4) should succeed");
+    float absmax = 0.0f;
+    size_t bytes = 0;
+    for (int r0 = 0; r0 < nr; r0 += 64) { /* uneven chunks, scale carried across */
+        const int rows = nr - r0 < 64 ? nr - r0 : 64;
+        bytes += neuronos_quantize_i2_rows(x + (size_t)r0 * n, got + (size_t)r0 * n / 4, rows, n, 128, &absmax);
+    }
+    memcpy(got + packed, &absmax, sizeof(absmax));
+    ASSERT(neuronos_hal_set_n_threads(1) == NEURONOS_HAL_OK, "pool should shrink back to 1");
+
+    ASSERT(bytes == packed, "rows should report the packed size");
+    ASSERT(memcmp(got, want, packed + sizeof(float)) == 0, "chunked rows + scale should match scalar quantize");
+    ASSERT(neuronos_quantize_i2_rows(x, got, 1, 100, 128, &absmax) == 0, "row not a multiple of qk rejected");
+    free(x);
+    free(want);
+    free(got);
+
+    PASS("Streaming I2_S rows match scalar quantize");
+    return 0;
+}
+
 /* ──────── Test 4: Print info ──────── */
 static int test_print_info(void) {
     printf("\n");
@@ -158,15 +635,76 @@ static int test_print_info(void) {
 }
 
 /* ──────── Main ──────── */
+/* Fresh empty directory from a template ending in XXXXXX, or NULL */
+static char * test_mkdtemp(char * tmpl) {
+#ifdef _WIN32
+    if (_mktemp_s(tmpl, strlen(tmpl) + 1) != 0 || _mkdir(tmpl) != 0)
+        return NULL;
+    return tmpl;
+#else
+    return mkdtemp(tmpl);
+#endif
+}
+
+/* Autotune results go to $HOME/.neuronos: keep them out of the real one */
+#ifdef _WIN32
+    #define TEST_TMP_DIR (getenv("TEMP") ? getenv("TEMP") : ".")
+#else
+    #define TEST_TMP_DIR (getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp")
+#endif
+static char g_home[512];
+static char * g_saved_home[2];
+static const char * const HOME_VARS[2] = {"HOME", "USERPROFILE"};
+
+static int scratch_home_begin(void) {
+    snprintf(g_home, sizeof(g_home), "%s/neuronos_hal_test_XXXXXX", TEST_TMP_DIR);
+    ASSERT(test_mkdtemp(g_home) != NULL, "could not create a scratch HOME");
+    for (int i = 0; i < 2; i++) {
+        g_saved_home[i] = getenv(HOME_VARS[i]) ? strdup(getenv(HOME_VARS[i])) : NULL;
+        test_setenv(HOME_VARS[i], g_home);
+    }
+    return 0;
+}
+
+static int scratch_home_end(void) {
+    for (int i = 0; i < 2; i++) {
+        if (g_saved_home[i])
+            test_setenv(HOME_VARS[i], g_saved_home[i]);
+        else
+            test_unsetenv(HOME_VARS[i]);
+        free(g_saved_home[i]);
+    }
+    char path[600];
+    snprintf(path, sizeof(path), "%s/.neuronos/hal_tune.conf", g_home);
+    remove(path);
+    snprintf(path, sizeof(path), "%s/.neuronos", g_home);
+    test_rmdir(path);
+    ASSERT(test_rmdir(g_home) == 0, "scratch HOME should be left empty");
+    return 0;
+}
+
 int main(void) {
     printf("=== NeuronOS HAL Test Suite ===\n\n");
 
     int failures = 0;
+    if (scratch_home_begin() != 0)
+        return 1;
 
     failures += test_init();
     failures += test_backends();
     failures += test_scalar_vec_dot();
+    failures += test_vnni_vec_dot();
+    failures += test_sve_kernels();
+    failures += test_x86_gemm();
+    failures += test_autotune();
+    failures += test_thread_pool();
+    failures += test_rvv_kernels();
+    failures += test_wasm_kernels();
+    failures += test_lut_kernels();
+    failures += test_vulkan_kernels();
+    failures += test_quantize_rows();
     failures += test_print_info();
+    failures += scratch_home_end();
 
     printf("\n=== Results: %d failures ===\n", failures);
     return failures ? 1 : 0;
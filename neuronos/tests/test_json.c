@@ -17,6 +17,11 @@
  * 13.  nj_skip_value — skip complex values
  * 14.  NULL / malformed input handling
  * 15.  Recall GC — basic function
+ * 16.  nj_canonical — member order and whitespace
+ * 17.  nj_parse — tape navigation
+ * 18.  nj_str_* — string views and unescaping
+ * 19.  nj_parse — malformed input and long strings
+ * 20.  nj_writer — streaming writer round-trip
  *
  * Usage: ./test_json   (no model needed — pure unit tests)
  * ============================================================ */
@@ -453,6 +458,206 @@ static void test_recall_gc(void) {
     TEST_PASS();
 }
 
+/* ============================================================
+ * TEST 16: nj_canonical — member order and whitespace
+ * ============================================================ */
+static void test_canonical(void) {
+    TEST_START("nj_canonical");
+
+    char * a = nj_canonical(" { \"path\" : \"a b.txt\", \"end_line\" : 10 , \"opts\": {\"z\":[1, {\"y\":2,\"x\":1}],\"a\":null} } ");
+    char * b = nj_canonical("{\"opts\":{\"a\":null,\"z\":[1,{\"x\":1,\"y\":2}]},\"end_line\":10,\"path\":\"a b.txt\"}");
+    ASSERT(a != NULL && b != NULL, "canonical returned NULL");
+    ASSERT(strcmp(a, b) == 0, "reordered objects should match");
+    ASSERT(strcmp(a, "{\"end_line\":10,\"opts\":{\"a\":null,\"z\":[1,{\"x\":1,\"y\":2}]},\"path\":\"a b.txt\"}") == 0,
+           "wrong canonical text");
+    free(a);
+    free(b);
+
+    /* Keys are compared as written; a prefix sorts first */
+    a = nj_canonical("{\"ab\":1,\"a\":2}");
+    ASSERT(a && strcmp(a, "{\"a\":2,\"ab\":1}") == 0, "prefix key order wrong");
+    free(a);
+
+    ASSERT(nj_canonical("{\"a\":1,}") == NULL, "trailing comma should fail");
+    ASSERT(nj_canonical("{\"a\":1} x") == NULL, "trailing text should fail");
+    ASSERT(nj_canonical("[1,2") == NULL, "unclosed array should fail");
+    ASSERT(nj_canonical(NULL) == NULL, "NULL should fail");
+
+    TEST_PASS();
+}
+
+/* ============================================================
+ * TEST 17: nj_parse — tape navigation
+ * ============================================================ */
+static void test_doc_navigate(void) {
+    TEST_START("nj_parse navigation");
+
+    const char * json = " {\"model\":\"x\",\"max_tokens\":512,\"stream\":true,\"temperature\":0.25,"
+                        "\"messages\":[{\"role\":\"system\",\"content\":\"be brief\"},"
+                        "{\"role\":\"user\",\"content\":\"hi\",\"meta\":{\"role\":\"nested\"}}],"
+                        "\"empty\":{},\"none\":[]} ";
+    nj_doc_t doc;
+    ASSERT(nj_parse(&doc, json, strlen(json)) == 0, "parse failed");
+    ASSERT(nj_type(&doc, 0) == NJ_OBJECT, "root not an object");
+
+    ASSERT(nj_int(&doc, nj_get(&doc, 0, "max_tokens"), 0) == 512, "max_tokens wrong");
+    ASSERT(nj_bool(&doc, nj_get(&doc, 0, "stream"), 0) == 1, "stream wrong");
+    ASSERT(fabs(nj_num(&doc, nj_get(&doc, 0, "temperature"), 0) - 0.25) < 1e-9, "temperature wrong");
+    ASSERT(nj_int(&doc, nj_get(&doc, 0, "missing"), -7) == -7, "missing key should fall back");
+    ASSERT(nj_int(&doc, nj_get(&doc, 0, "model"), -7) == -7, "string is not a number");
+
+    int msgs = nj_get(&doc, 0, "messages");
+    ASSERT(nj_type(&doc, msgs) == NJ_ARRAY && nj_count(&doc, msgs) == 2, "messages array wrong");
+    const char * roles[] = {"system", "user"};
+    int k = 0;
+    for (int m = nj_first(&doc, msgs); m >= 0; m = nj_next(&doc, msgs, m), k++) {
+        ASSERT(k < 2, "too many messages");
+        ASSERT(nj_str_eq(&doc, nj_get(&doc, m, "role"), roles[k]), "role wrong");
+    }
+    ASSERT(k == 2, "iteration count wrong");
+
+    /* Member keys precede their values; nested keys are not top-level */
+    int first = nj_first(&doc, 0);
+    ASSERT(nj_str_eq(&doc, first - 1, "model"), "first key wrong");
+    ASSERT(nj_get(&doc, 0, "role") < 0, "nested key matched at top level");
+    ASSERT(nj_count(&doc, 0) == 7, "member count wrong");
+    ASSERT(nj_first(&doc, nj_get(&doc, 0, "empty")) < 0, "empty object has children");
+    ASSERT(nj_first(&doc, nj_get(&doc, 0, "none")) < 0, "empty array has children");
+
+    size_t len = 0;
+    const char * raw = nj_raw(&doc, nj_get(&doc, nj_first(&doc, msgs), "content"), &len);
+    ASSERT(raw && len == 10 && strncmp(raw, "\"be brief\"", len) == 0, "raw string wrong");
+    char * obj = nj_raw_dup(&doc, nj_get(&doc, nj_next(&doc, msgs, nj_first(&doc, msgs)), "meta"));
+    ASSERT(obj && strcmp(obj, "{\"role\":\"nested\"}") == 0, "raw object wrong");
+    free(obj);
+
+    /* -1 propagates through every accessor */
+    ASSERT(nj_get(&doc, -1, "x") < 0 && nj_first(&doc, -1) < 0 && !nj_str(&doc, -1, NULL), "-1 not handled");
+
+    nj_doc_free(&doc);
+    TEST_PASS();
+}
+
+/* ============================================================
+ * TEST 18: nj_str_* — string views and unescaping
+ * ============================================================ */
+static void test_doc_strings(void) {
+    TEST_START("nj_str views and unescape");
+
+    const char * json = "{\"plain\":\"abc\",\"esc\":\"a\\\"b\\\\c\\nd\\/e\","
+                        "\"uni\":\"caf\\u00e9 \\u20ac \\ud83d\\ude00\",\"k\\u0065y\":1}";
+    nj_doc_t doc;
+    ASSERT(nj_parse(&doc, json, strlen(json)) == 0, "parse failed");
+
+    int len = 0;
+    const char * v = nj_str(&doc, nj_get(&doc, 0, "plain"), &len);
+    ASSERT(v && len == 3 && v >= json && v < json + strlen(json), "view should point into source");
+
+    char * s = nj_str_dup(&doc, nj_get(&doc, 0, "esc"));
+    ASSERT(s && strcmp(s, "a\"b\\c\nd/e") == 0, "simple escapes wrong");
+    free(s);
+
+    s = nj_str_dup(&doc, nj_get(&doc, 0, "uni"));
+    ASSERT(s && strcmp(s, "caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80") == 0, "\\u decoding wrong");
+    free(s);
+
+    char buf[5];
+    ASSERT(nj_str_copy(&doc, nj_get(&doc, 0, "esc"), buf, sizeof(buf)) == 4, "copy length wrong");
+    ASSERT(strcmp(buf, "a\"b\\") == 0, "truncated copy wrong");
+
+    ASSERT(nj_get(&doc, 0, "key") >= 0, "escaped key not matched");
+    ASSERT(nj_str_dup(&doc, nj_get(&doc, 0, "key")) == NULL, "number is not a string");
+
+    nj_doc_free(&doc);
+    TEST_PASS();
+}
+
+/* ============================================================
+ * TEST 19: nj_parse — malformed input and long strings
+ * ============================================================ */
+static void test_doc_malformed(void) {
+    TEST_START("nj_parse malformed / long strings");
+
+    const char * bad[] = {"", "   ", "{", "[1,2", "{\"a\":1,}", "[1,]", "{\"a\" 1}", "{\"a\":1} x",
+                          "{\"a\":\"unterminated}", "[tru]", "{1:2}", "[1}", "[-]"};
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        nj_doc_t doc;
+        ASSERT(nj_parse(&doc, bad[i], strlen(bad[i])) < 0, bad[i]);
+        nj_doc_free(&doc);
+    }
+
+    /* Length-bounded: text past len is not read */
+    nj_doc_t doc;
+    ASSERT(nj_parse(&doc, "[1,2]garbage", 5) == 0 && nj_count(&doc, 0) == 2, "bounded parse failed");
+    nj_doc_free(&doc);
+
+    /* Quotes and escapes at every offset around the SIMD block sizes */
+    char json[256];
+    for (int n = 0; n < 70; n++) {
+        int pos = 0;
+        pos += snprintf(json + pos, sizeof(json) - (size_t)pos, "{\"s\":\"");
+        for (int i = 0; i < n; i++)
+            json[pos++] = (char)('a' + i % 26);
+        pos += snprintf(json + pos, sizeof(json) - (size_t)pos, "\\\"x\",\"t\":%d}", n);
+        ASSERT(nj_parse(&doc, json, (size_t)pos) == 0, "long string parse failed");
+        int len = 0;
+        ASSERT(nj_str(&doc, nj_get(&doc, 0, "s"), &len) && len == n + 3, "long string length wrong");
+        ASSERT(nj_int(&doc, nj_get(&doc, 0, "t"), -1) == n, "value after long string wrong");
+        nj_doc_free(&doc);
+    }
+
+    TEST_PASS();
+}
+
+/* ============================================================
+ * TEST 20: nj_writer — streaming writer round-trip
+ * ============================================================ */
+static void test_writer(void) {
+    TEST_START("nj_writer round-trip");
+
+    nj_writer_t w = {0};
+    nj_w_obj(&w);
+    nj_w_key(&w, "jsonrpc");
+    nj_w_str(&w, "2.0");
+    nj_w_key(&w, "id");
+    nj_w_int(&w, -42);
+    nj_w_key(&w, "items");
+    nj_w_arr(&w);
+    nj_w_num(&w, 0.1);
+    nj_w_bool(&w, 1);
+    nj_w_null(&w);
+    nj_w_obj(&w);
+    nj_w_obj_end(&w);
+    nj_w_raw(&w, "{\"type\":\"object\"}");
+    nj_w_arr_end(&w);
+    nj_w_key(&w, "text");
+    nj_w_str(&w, "line\n\"q\"\t\x01");
+    nj_w_key(&w, "cut");
+    nj_w_str_n(&w, "abcdef", 3);
+    nj_w_obj_end(&w);
+    char * out = nj_w_finish(&w);
+    ASSERT(out != NULL, "finish failed");
+    ASSERT(strcmp(out, "{\"jsonrpc\":\"2.0\",\"id\":-42,\"items\":[0.1,true,null,{},{\"type\":\"object\"}],"
+                       "\"text\":\"line\\n\\\"q\\\"\\t\\u0001\",\"cut\":\"abc\"}") == 0,
+           "writer output wrong");
+
+    nj_doc_t doc;
+    ASSERT(nj_parse(&doc, out, strlen(out)) == 0, "writer output does not parse");
+    char * text = nj_str_dup(&doc, nj_get(&doc, 0, "text"));
+    ASSERT(text && strcmp(text, "line\n\"q\"\t\x01") == 0, "text did not round-trip");
+    free(text);
+    nj_doc_free(&doc);
+    free(out);
+
+    /* Unbalanced output is refused */
+    nj_w_arr(&w);
+    ASSERT(nj_w_finish(&w) == NULL, "unclosed array accepted");
+    nj_w_obj_end(&w);
+    ASSERT(nj_w_finish(&w) == NULL, "stray close accepted");
+
+    TEST_PASS();
+}
+
 /* ============================================================
  * MAIN
  * ============================================================ */
@@ -477,6 +682,11 @@ int main(void) {
     test_skip_value();
     test_null_safety();
     test_recall_gc();
+    test_canonical();
+    test_doc_navigate();
+    test_doc_strings();
+    test_doc_malformed();
+    test_writer();
 
     fprintf(stderr, "\n");
     fprintf(stderr, "═══════════════════════════════════════════\n");
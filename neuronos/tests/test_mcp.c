@@ -0,0 +1,1623 @@
+/* ============================================================
+ * NeuronOS — MCP Transport Test Suite
+ *
+ * The MCP server runs in a child process on a pipe pair; the test
+ * speaks newline-delimited JSON-RPC to it like a client would. The
+ * MCP client talks to this binary re-executed as a scripted fake
+ * server (--fake-mcp-server), and to a fake Streamable HTTP server
+ * on a loopback port.
+ *
+ * Tests:
+ *  1. initialize handshake and tools/list
+ *  2. Concurrent tools/call: out-of-order replies matched by id
+ *  3. Tools not marked thread_safe never overlap
+ *  4. notifications/cancelled: queued call dropped, running call muted
+ *  5. Client: concurrent calls answered out of order, interleaved
+ *     with notifications and server requests
+ *  6. Client: timed-out call's late reply does not leak into the next
+ *  7. Client: server exit fails in-flight calls at once
+ *  8. Client over HTTP: session headers; Content-Length, chunked,
+ *     event-stream and close-delimited replies
+ *  9. Client over HTTP: concurrent calls on separate connections,
+ *     idle ones reused
+ * 10. Client over HTTP: 500, JSON-RPC error, dropped connection
+ *     retried, timeout, malformed URLs, refused port
+ * 11. Client over HTTPS (self-signed certificate trusted through
+ *     SSL_CERT_FILE): session resumed on reconnect; wrong host name
+ *     and untrusted certificate refused. Without OpenSSL: https://
+ *     refused up front.
+ * 12. Client: discovery cache — warm start offers cached tools at
+ *     once and skips tools/list; a new server version rediscovers
+ * 13. Client: servers start in parallel
+ *
+ * Usage: ./test_mcp   (POSIX; skipped on Windows)
+ * ============================================================ */
+#include "neuronos/neuronos.h"
+#include "neuronos/neuronos_json.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef NEURONOS_HAS_OPENSSL
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+#endif
+#endif
+
+/* ---- Helpers ---- */
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_START(name)                                                                                               \
+    do {                                                                                                               \
+        tests_run++;                                                                                                   \
+        fprintf(stderr, "\n[TEST %d] %s... ", tests_run, name);                                                        \
+    } while (0)
+
+#define TEST_PASS()                                                                                                    \
+    do {                                                                                                               \
+        tests_passed++;                                                                                                \
+        fprintf(stderr, "PASS ✓\n");                                                                                   \
+    } while (0)
+
+#define TEST_FAIL(msg)                                                                                                 \
+    do {                                                                                                               \
+        tests_failed++;                                                                                                \
+        fprintf(stderr, "FAIL ✗ (%s)\n", msg);                                                                         \
+    } while (0)
+
+/* The peer process is stopped by the caller after a failed check */
+#define ASSERT(cond, msg)                                                                                              \
+    do {                                                                                                               \
+        if (!(cond)) {                                                                                                 \
+            TEST_FAIL(msg);                                                                                            \
+            goto done;                                                                                                 \
+        }                                                                                                              \
+    } while (0)
+
+#ifndef _WIN32
+
+#define RECV_TIMEOUT_MS 10000
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+/* ============================================================
+ * Peer process on a pipe pair: its stdin is our `to`, its stdout
+ * our `from`. Replies are read line by line with a timeout.
+ * ============================================================ */
+typedef struct {
+    pid_t pid;
+    int to;
+    int from;
+    char buf[1 << 16];
+    int len;
+} test_peer_t;
+
+static bool peer_start(test_peer_t * p, int (*child_main)(void)) {
+    int in[2], out[2];
+    memset(p, 0, sizeof(*p));
+    p->to = p->from = -1;
+    if (pipe(in) != 0)
+        return false;
+    if (pipe(out) != 0) {
+        close(in[0]);
+        close(in[1]);
+        return false;
+    }
+    fflush(NULL);
+    p->pid = fork();
+    if (p->pid < 0)
+        return false;
+    if (p->pid == 0) {
+        dup2(in[0], STDIN_FILENO);
+        dup2(out[1], STDOUT_FILENO);
+        close(in[0]);
+        close(in[1]);
+        close(out[0]);
+        close(out[1]);
+        _exit(child_main());
+    }
+    close(in[0]);
+    close(out[1]);
+    p->to = in[1];
+    p->from = out[0];
+    return true;
+}
+
+static bool peer_send(test_peer_t * p, const char * line) {
+    size_t n = strlen(line), off = 0;
+    while (off < n) {
+        ssize_t w = write(p->to, line + off, n - off);
+        if (w <= 0)
+            return false;
+        off += (size_t)w;
+    }
+    return write(p->to, "\n", 1) == 1;
+}
+
+/* Next line (malloc'd, no newline), or NULL on EOF / timeout */
+static char * peer_recv(test_peer_t * p, int timeout_ms) {
+    double deadline = now_ms() + timeout_ms;
+    for (;;) {
+        char * nl = memchr(p->buf, '\n', (size_t)p->len);
+        if (nl) {
+            size_t n = (size_t)(nl - p->buf);
+            char * line = malloc(n + 1);
+            if (!line)
+                return NULL;
+            memcpy(line, p->buf, n);
+            line[n] = '\0';
+            memmove(p->buf, nl + 1, (size_t)p->len - n - 1);
+            p->len -= (int)n + 1;
+            return line;
+        }
+        int left = (int)(deadline - now_ms());
+        struct pollfd pfd = {.fd = p->from, .events = POLLIN};
+        if (left <= 0 || p->len >= (int)sizeof(p->buf) || poll(&pfd, 1, left) <= 0)
+            return NULL;
+        ssize_t r = read(p->from, p->buf + p->len, sizeof(p->buf) - (size_t)p->len);
+        if (r <= 0)
+            return NULL;
+        p->len += (int)r;
+    }
+}
+
+/* Close the peer's stdin; returns its exit status (-1 if it had to be killed) */
+static int peer_finish(test_peer_t * p) {
+    if (p->to >= 0)
+        close(p->to);
+    p->to = -1;
+    int status = -1;
+    for (int i = 0; i < 200; i++) {
+        if (waitpid(p->pid, &status, WNOHANG) == p->pid) {
+            if (p->from >= 0)
+                close(p->from);
+            p->from = -1;
+            return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+        }
+        usleep(25000);
+    }
+    kill(p->pid, SIGKILL);
+    waitpid(p->pid, &status, 0);
+    if (p->from >= 0)
+        close(p->from);
+    p->from = -1;
+    return -1;
+}
+
+/* The "id" of a JSON-RPC message, -1 if none */
+static int msg_id(const char * line) {
+    nj_doc_t doc;
+    if (nj_parse(&doc, line, strlen(line)) < 0)
+        return -1;
+    int id = (int)nj_int(&doc, nj_get(&doc, 0, "id"), -1);
+    nj_doc_free(&doc);
+    return id;
+}
+
+/* ============================================================
+ * MCP server under test: a registry of sleepy tools
+ * ============================================================ */
+static int g_serial_active = 0;
+
+static neuronos_tool_result_t tool_sleep(const char * args, void * user_data) {
+    (void)user_data;
+    usleep((useconds_t)nj_find_int(args, "ms", 0) * 1000);
+    neuronos_tool_result_t r = {.success = true};
+    char tag[64] = "";
+    nj_copy_str(args, "tag", tag, sizeof(tag));
+    r.output = strdup(tag);
+    return r;
+}
+
+/* Reports "overlap" if another call was inside at the same time */
+static neuronos_tool_result_t tool_serial(const char * args, void * user_data) {
+    (void)user_data;
+    int inside = __atomic_add_fetch(&g_serial_active, 1, __ATOMIC_SEQ_CST);
+    usleep((useconds_t)nj_find_int(args, "ms", 0) * 1000);
+    inside = inside > 1 || __atomic_load_n(&g_serial_active, __ATOMIC_SEQ_CST) > 1;
+    __atomic_sub_fetch(&g_serial_active, 1, __ATOMIC_SEQ_CST);
+    neuronos_tool_result_t r = {.success = true};
+    r.output = strdup(inside ? "overlap" : "alone");
+    return r;
+}
+
+static int mcp_server_main(void) {
+    neuronos_tool_registry_t * reg = neuronos_tool_registry_create();
+    if (!reg)
+        return 2;
+    const char * schema = "{\"type\":\"object\",\"properties\":{\"ms\":{\"type\":\"integer\"},"
+                          "\"tag\":{\"type\":\"string\"}}}";
+    neuronos_tool_desc_t sleep_desc = {
+        .name = "sleep",
+        .description = "Sleep for ms milliseconds, then return tag",
+        .args_schema_json = schema,
+        .execute = tool_sleep,
+        .thread_safe = true,
+    };
+    neuronos_tool_desc_t serial_desc = {
+        .name = "serial",
+        .description = "Sleep for ms milliseconds; not thread-safe",
+        .args_schema_json = schema,
+        .execute = tool_serial,
+    };
+    neuronos_tool_register(reg, &sleep_desc);
+    neuronos_tool_register(reg, &serial_desc);
+    neuronos_status_t st = neuronos_mcp_serve_stdio(reg);
+    neuronos_tool_registry_free(reg);
+    return st == NEURONOS_OK ? 0 : 1;
+}
+
+static bool server_begin(test_peer_t * p) {
+    if (!peer_start(p, mcp_server_main))
+        return false;
+    char * reply = NULL;
+    bool ok = peer_send(p, "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"initialize\",\"params\":{"
+                           "\"protocolVersion\":\"2025-11-25\",\"capabilities\":{},"
+                           "\"clientInfo\":{\"name\":\"test\",\"version\":\"1\"}}}") &&
+              (reply = peer_recv(p, RECV_TIMEOUT_MS)) != NULL && msg_id(reply) == 1 &&
+              peer_send(p, "{\"jsonrpc\":\"2.0\",\"method\":\"notifications/initialized\"}");
+    free(reply);
+    if (!ok)
+        peer_finish(p);
+    return ok;
+}
+
+static bool send_call(test_peer_t * p, int id, const char * tool, int ms, const char * tag) {
+    char line[512];
+    snprintf(line, sizeof(line),
+             "{\"jsonrpc\":\"2.0\",\"id\":%d,\"method\":\"tools/call\",\"params\":{\"name\":\"%s\","
+             "\"arguments\":{\"ms\":%d,\"tag\":\"%s\"}}}",
+             id, tool, ms, tag);
+    return peer_send(p, line);
+}
+
+static bool send_cancel(test_peer_t * p, int id) {
+    char line[256];
+    snprintf(line, sizeof(line),
+             "{\"jsonrpc\":\"2.0\",\"method\":\"notifications/cancelled\",\"params\":{\"requestId\":%d,"
+             "\"reason\":\"test\"}}",
+             id);
+    return peer_send(p, line);
+}
+
+/* ============================================================
+ * TEST 1: Handshake and tools/list
+ * ============================================================ */
+static void test_server_handshake(void) {
+    TEST_START("MCP server: initialize and tools/list");
+    test_peer_t * p = calloc(1, sizeof(*p));
+    char * reply = NULL;
+    bool started = false;
+    ASSERT(p, "alloc");
+
+    /* Calls before initialize are refused */
+    ASSERT(peer_start(p, mcp_server_main), "cannot start server");
+    started = true;
+    ASSERT(send_call(p, 5, "sleep", 0, "early"), "send failed");
+    reply = peer_recv(p, RECV_TIMEOUT_MS);
+    ASSERT(reply && msg_id(reply) == 5 && strstr(reply, "-32002"), "uninitialized call not refused");
+    free(reply);
+    reply = NULL;
+    peer_finish(p);
+    started = false;
+
+    ASSERT(server_begin(p), "initialize failed");
+    started = true;
+    ASSERT(peer_send(p, "{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"tools/list\"}"), "send failed");
+    reply = peer_recv(p, RECV_TIMEOUT_MS);
+    ASSERT(reply && msg_id(reply) == 2, "no tools/list reply");
+    ASSERT(strstr(reply, "\"name\":\"sleep\"") && strstr(reply, "\"name\":\"serial\""), "tools missing");
+    ASSERT(strstr(reply, "\"inputSchema\":{\"type\":\"object\""), "schema missing");
+
+    /* Stdin EOF is a clean shutdown */
+    ASSERT(peer_finish(p) == 0, "server did not exit cleanly");
+    started = false;
+
+    TEST_PASS();
+done:
+    free(reply);
+    if (started)
+        peer_finish(p);
+    free(p);
+}
+
+/* ============================================================
+ * TEST 2: Concurrent calls answered out of order
+ * ============================================================ */
+static void test_server_concurrent(void) {
+    TEST_START("MCP server: concurrent tools/call, replies matched by id");
+    test_peer_t * p = calloc(1, sizeof(*p));
+    char * reply = NULL;
+    bool started = false;
+    ASSERT(p, "alloc");
+    ASSERT(server_begin(p), "initialize failed");
+    started = true;
+
+    /* A slow call first; the fast ones and a ping must not wait for it */
+    double t0 = now_ms();
+    ASSERT(send_call(p, 10, "sleep", 600, "slow") && send_call(p, 11, "sleep", 30, "fast") &&
+               send_call(p, 12, "sleep", 0, "instant") &&
+               peer_send(p, "{\"jsonrpc\":\"2.0\",\"id\":13,\"method\":\"ping\"}"),
+           "send failed");
+
+    int order[4], n = 0;
+    while (n < 4) {
+        reply = peer_recv(p, RECV_TIMEOUT_MS);
+        ASSERT(reply, "missing reply");
+        int id = msg_id(reply);
+        ASSERT(id >= 10 && id <= 13, "reply with an unknown id");
+        for (int i = 0; i < n; i++)
+            ASSERT(order[i] != id, "duplicate reply");
+        const char * want = id == 10 ? "\"text\":\"slow\"" : id == 11 ? "\"text\":\"fast\""
+                          : id == 12 ? "\"text\":\"instant\"" : "\"result\":{}";
+        ASSERT(strstr(reply, want), "reply carries another request's result");
+        order[n++] = id;
+        free(reply);
+        reply = NULL;
+    }
+    ASSERT(order[3] == 10, "the slow call held up later requests");
+    ASSERT(now_ms() - t0 < 600 + 30 + 500, "calls did not overlap");
+
+    TEST_PASS();
+done:
+    free(reply);
+    if (started)
+        peer_finish(p);
+    free(p);
+}
+
+/* ============================================================
+ * TEST 3: Non-thread-safe tools run one at a time
+ * ============================================================ */
+static void test_server_serial(void) {
+    TEST_START("MCP server: non-thread-safe tool calls never overlap");
+    test_peer_t * p = calloc(1, sizeof(*p));
+    char * reply = NULL;
+    bool started = false;
+    ASSERT(p, "alloc");
+    ASSERT(server_begin(p), "initialize failed");
+    started = true;
+
+    ASSERT(send_call(p, 30, "serial", 100, "") && send_call(p, 31, "serial", 100, "") &&
+               send_call(p, 32, "serial", 100, ""),
+           "send failed");
+    for (int i = 0; i < 3; i++) {
+        reply = peer_recv(p, RECV_TIMEOUT_MS);
+        ASSERT(reply, "missing reply");
+        ASSERT(strstr(reply, "\"text\":\"alone\""), "serial tool ran concurrently");
+        free(reply);
+        reply = NULL;
+    }
+
+    TEST_PASS();
+done:
+    free(reply);
+    if (started)
+        peer_finish(p);
+    free(p);
+}
+
+/* ============================================================
+ * TEST 4: notifications/cancelled
+ * ============================================================ */
+static void test_server_cancel(void) {
+    TEST_START("MCP server: notifications/cancelled honoured");
+    test_peer_t * p = calloc(1, sizeof(*p));
+    char * reply = NULL;
+    bool started = false;
+    ASSERT(p, "alloc");
+    ASSERT(server_begin(p), "initialize failed");
+    started = true;
+
+    /* Four calls occupy the four workers; a fifth waits in the queue */
+    for (int id = 20; id < 24; id++)
+        ASSERT(send_call(p, id, "sleep", 400, "busy"), "send failed");
+    ASSERT(send_call(p, 24, "sleep", 0, "queued"), "send failed");
+    usleep(100000); /* let the workers pick up 20..23 */
+
+    /* 20 is running: its reply is suppressed; 24 is queued: dropped */
+    ASSERT(send_cancel(p, 20) && send_cancel(p, 24), "send failed");
+    ASSERT(send_call(p, 25, "sleep", 0, "after"), "send failed");
+    ASSERT(peer_send(p, "{\"jsonrpc\":\"2.0\",\"id\":26,\"method\":\"ping\"}"), "send failed");
+
+    /* EOF: the server answers what is still running, then exits */
+    close(p->to);
+    p->to = -1;
+    bool seen[32] = {false};
+    while ((reply = peer_recv(p, RECV_TIMEOUT_MS)) != NULL) {
+        int id = msg_id(reply);
+        ASSERT(id >= 20 && id < 32 && !seen[id], "unexpected or duplicate reply");
+        seen[id] = true;
+        free(reply);
+        reply = NULL;
+    }
+    ASSERT(!seen[20], "reply sent for a cancelled running call");
+    ASSERT(!seen[24], "cancelled queued call still ran");
+    ASSERT(seen[21] && seen[22] && seen[23], "uncancelled calls lost");
+    ASSERT(seen[25] && seen[26], "requests after the cancellation lost");
+    ASSERT(peer_finish(p) == 0, "server did not exit cleanly");
+    started = false;
+
+    TEST_PASS();
+done:
+    free(reply);
+    if (started)
+        peer_finish(p);
+    free(p);
+}
+
+/* ============================================================
+ * Fake stdio MCP server for the client tests. Its one tool, "echo",
+ * returns its "tag" argument, but replies are scripted:
+ *   - calls are held until three are in flight, then answered in
+ *     reverse, interleaved with notifications, a server-to-client
+ *     request reusing a client id, reordered keys, and a reply split
+ *     across writes
+ *   - tag "drop": never answered; the reply is sent late, right before
+ *     the next call's
+ *   - tag "solo": answered at once
+ *   - tag "exit": the server exits without answering
+ * With FAKE_STATE=<dir> it reports <dir>/version (default "1") as its
+ * serverInfo.version and logs each method to <dir>/log; FAKE_DELAY_MS
+ * delays its start-up.
+ * ============================================================ */
+static void fake_write(const char * s) {
+    size_t n = strlen(s), off = 0;
+    while (off < n) {
+        ssize_t w = write(STDOUT_FILENO, s + off, n - off);
+        if (w <= 0)
+            _exit(3);
+        off += (size_t)w;
+    }
+}
+
+static void fake_reply(int id, const char * text, bool reordered) {
+    char buf[512];
+    if (reordered)
+        snprintf(buf, sizeof(buf),
+                 "{\"result\":{\"content\":[{\"type\":\"text\",\"text\":\"%s\"}],\"meta\":{\"id\":999,"
+                 "\"method\":\"x\"}},\"id\":%d,\"jsonrpc\":\"2.0\"}\n",
+                 text, id);
+    else
+        snprintf(buf, sizeof(buf),
+                 "{\"jsonrpc\":\"2.0\",\"id\":%d,\"result\":{\"content\":[{\"type\":\"text\",\"text\":\"%s\"}]}}\n",
+                 id, text);
+    fake_write(buf);
+}
+
+static int fake_mcp_server_main(void) {
+    static char line[1 << 16];
+    int held_id[3];
+    char held_tag[3][32];
+    int n_held = 0;
+    int dropped = -1;
+    char buf[512];
+    char version[16] = "1";
+    FILE * log = NULL;
+
+    const char * state = getenv("FAKE_STATE");
+    if (state) {
+        snprintf(buf, sizeof(buf), "%s/version", state);
+        FILE * f = fopen(buf, "r");
+        if (f) {
+            if (fscanf(f, "%15s", version) != 1)
+                snprintf(version, sizeof(version), "1");
+            fclose(f);
+        }
+        snprintf(buf, sizeof(buf), "%s/log", state);
+        log = fopen(buf, "a");
+    }
+    if (getenv("FAKE_DELAY_MS"))
+        usleep((useconds_t)atoi(getenv("FAKE_DELAY_MS")) * 1000);
+
+    while (fgets(line, sizeof(line), stdin)) {
+        char method[64] = "";
+        nj_copy_str(line, "method", method, sizeof(method));
+        int id = nj_find_int(line, "id", -1);
+        if (log) {
+            fprintf(log, "%s\n", method);
+            fflush(log);
+        }
+
+        if (strcmp(method, "initialize") == 0) {
+            snprintf(buf, sizeof(buf),
+                     "{\"jsonrpc\":\"2.0\",\"id\":%d,\"result\":{\"protocolVersion\":\"2025-11-25\","
+                     "\"capabilities\":{\"tools\":{}},\"serverInfo\":{\"name\":\"fake\",\"version\":\"%s\"}}}\n",
+                     id, version);
+            fake_write(buf);
+        } else if (strcmp(method, "tools/list") == 0) {
+            /* A log line first: the response is not the first thing read */
+            fake_write("{\"jsonrpc\":\"2.0\",\"method\":\"notifications/message\",\"params\":{\"level\":\"info\","
+                       "\"data\":\"listing\"}}\n");
+            snprintf(buf, sizeof(buf),
+                     "{\"jsonrpc\":\"2.0\",\"id\":%d,\"result\":{\"tools\":[{\"name\":\"echo\",\"description\":"
+                     "\"Returns tag\",\"inputSchema\":{\"type\":\"object\",\"properties\":{\"tag\":{\"type\":"
+                     "\"string\"}}}}]}}\n",
+                     id);
+            fake_write(buf);
+        } else if (strcmp(method, "tools/call") == 0) {
+            char tag[32] = "";
+            char * params = nj_extract_object(line, "params");
+            char * args = params ? nj_extract_object(params, "arguments") : NULL;
+            if (args)
+                nj_copy_str(args, "tag", tag, sizeof(tag));
+            free(args);
+            free(params);
+
+            if (strcmp(tag, "exit") == 0)
+                _exit(0);
+            if (strcmp(tag, "drop") == 0) {
+                dropped = id;
+                continue;
+            }
+            if (dropped >= 0) {
+                fake_reply(dropped, "late", false);
+                dropped = -1;
+            }
+            if (strcmp(tag, "solo") == 0) {
+                fake_reply(id, tag, false);
+                continue;
+            }
+
+            held_id[n_held] = id;
+            snprintf(held_tag[n_held], sizeof(held_tag[0]), "%s", tag);
+            if (++n_held < 3)
+                continue;
+            n_held = 0;
+
+            fake_write("{\"jsonrpc\":\"2.0\",\"method\":\"notifications/message\",\"params\":{\"level\":\"info\","
+                       "\"data\":\"three calls\"}}\n");
+            snprintf(buf, sizeof(buf), "{\"jsonrpc\":\"2.0\",\"id\":%d,\"method\":\"roots/list\"}\n", held_id[0]);
+            fake_write(buf);
+            fake_reply(held_id[2], held_tag[2], false);
+            snprintf(buf, sizeof(buf),
+                     "{\"jsonrpc\":\"2.0\",\"method\":\"notifications/progress\",\"params\":{\"progressToken\":%d,"
+                     "\"progress\":1}}\n",
+                     held_id[1]);
+            fake_write(buf);
+            fake_reply(held_id[1], held_tag[1], true);
+
+            /* The last reply arrives in two pieces, the second glued to a notification */
+            snprintf(buf, sizeof(buf),
+                     "{\"jsonrpc\":\"2.0\",\"id\":%d,\"result\":{\"content\":[{\"type\":\"text\",\"text\":\"%s\"}]}}\n"
+                     "{\"jsonrpc\":\"2.0\",\"method\":\"notifications/message\",\"params\":{\"data\":\"done\"}}\n",
+                     held_id[0], held_tag[0]);
+            size_t half = strlen(buf) / 3;
+            char c = buf[half];
+            buf[half] = '\0';
+            fake_write(buf);
+            usleep(50000);
+            buf[half] = c;
+            fake_write(buf + half);
+        }
+        /* notifications/initialized and anything else: no reply */
+    }
+    if (log)
+        fclose(log);
+    return 0;
+}
+
+static const char * g_self = NULL; /* this binary, re-executed as the fake server */
+
+static neuronos_mcp_client_t * fake_client_connect(void) {
+    neuronos_mcp_client_t * client = neuronos_mcp_client_create();
+    if (!client)
+        return NULL;
+    neuronos_mcp_client_set_cache_dir(client, NULL);
+    const char * args[] = {"--fake-mcp-server"};
+    neuronos_mcp_server_config_t cfg = {
+        .name = "fake",
+        .transport = NEURONOS_MCP_TRANSPORT_STDIO,
+        .command = g_self,
+        .args = args,
+        .n_args = 1,
+        .timeout_ms = RECV_TIMEOUT_MS,
+    };
+    if (neuronos_mcp_client_add_server(client, &cfg) != 0 || neuronos_mcp_client_connect(client) != 0 ||
+        neuronos_mcp_client_tool_count(client) != 1) {
+        neuronos_mcp_client_free(client);
+        return NULL;
+    }
+    return client;
+}
+
+typedef struct {
+    neuronos_mcp_client_t * client;
+    char args[64];
+    char * result;
+} echo_call_t;
+
+static void * echo_call_main(void * arg) {
+    echo_call_t * c = arg;
+    c->result = neuronos_mcp_client_call_tool(c->client, "echo", c->args);
+    return NULL;
+}
+
+/* ============================================================
+ * TEST 5: Concurrent client calls, replies out of order
+ * ============================================================ */
+static void test_client_out_of_order(void) {
+    TEST_START("MCP client: out-of-order replies and interleaved notifications");
+    neuronos_mcp_client_t * client = fake_client_connect();
+    echo_call_t calls[3] = {{0}};
+    pthread_t threads[3];
+    int started = 0;
+    ASSERT(client, "connect to the fake server failed");
+
+    /* The fake answers only once all three are in flight */
+    for (; started < 3; started++) {
+        calls[started].client = client;
+        snprintf(calls[started].args, sizeof(calls[started].args), "{\"tag\":\"call%d\"}", started);
+        ASSERT(pthread_create(&threads[started], NULL, echo_call_main, &calls[started]) == 0, "thread start");
+    }
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+    started = 0;
+    for (int i = 0; i < 3; i++) {
+        char want[16];
+        snprintf(want, sizeof(want), "call%d", i);
+        ASSERT(calls[i].result, "call got no reply");
+        ASSERT(strcmp(calls[i].result, want) == 0, "call got another call's reply");
+    }
+
+    TEST_PASS();
+done:
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+    for (int i = 0; i < 3; i++)
+        free(calls[i].result);
+    if (client)
+        neuronos_mcp_client_free(client);
+}
+
+/* ============================================================
+ * TEST 6: Late reply to a timed-out call
+ * ============================================================ */
+static void test_client_timeout(void) {
+    TEST_START("MCP client: timed-out call, late reply dropped");
+    neuronos_mcp_client_t * client = fake_client_connect();
+    char * result = NULL;
+    ASSERT(client, "connect to the fake server failed");
+
+    double t0 = now_ms();
+    result = neuronos_mcp_client_call_tool_timeout(client, "echo", "{\"tag\":\"drop\"}", 300);
+    ASSERT(!result, "unanswered call returned a result");
+    ASSERT(now_ms() - t0 < 3000, "timeout not honoured");
+
+    /* Its reply now arrives just ahead of this call's */
+    result = neuronos_mcp_client_call_tool(client, "echo", "{\"tag\":\"solo\"}");
+    ASSERT(result && strcmp(result, "solo") == 0, "late reply taken for the next call");
+
+    TEST_PASS();
+done:
+    free(result);
+    if (client)
+        neuronos_mcp_client_free(client);
+}
+
+/* ============================================================
+ * TEST 7: Server exits with calls in flight
+ * ============================================================ */
+static void test_client_server_exit(void) {
+    TEST_START("MCP client: server exit fails in-flight calls");
+    neuronos_mcp_client_t * client = fake_client_connect();
+    char * result = NULL;
+    ASSERT(client, "connect to the fake server failed");
+
+    double t0 = now_ms();
+    result = neuronos_mcp_client_call_tool(client, "echo", "{\"tag\":\"exit\"}");
+    ASSERT(!result, "call to an exited server returned a result");
+    ASSERT(now_ms() - t0 < RECV_TIMEOUT_MS / 2, "in-flight call waited for its timeout");
+
+    t0 = now_ms();
+    result = neuronos_mcp_client_call_tool(client, "echo", "{\"tag\":\"solo\"}");
+    ASSERT(!result && now_ms() - t0 < 1000, "call after exit did not fail at once");
+
+    TEST_PASS();
+done:
+    free(result);
+    if (client)
+        neuronos_mcp_client_free(client);
+}
+
+/* ============================================================
+ * Fake Streamable HTTP server on a loopback port, one thread per
+ * connection. It serves the same "echo" tool; the tag picks how the
+ * reply is framed or how the server misbehaves:
+ *   - "json" (default): Content-Length body
+ *   - "chunked": chunked JSON in small pieces
+ *   - "sse": chunked event stream; a comment, a notification, a
+ *     server request and another id's reply come first, and the
+ *     reply's data spans two data: lines
+ *   - "close": no length, body ends with the connection
+ *   - "hold": event stream, sent once three calls are waiting
+ *   - "err500": HTTP 500; "rpcerr": JSON-RPC error object
+ *   - "drop": every other such request is dropped unanswered
+ *   - "slow": answered after a second
+ * Every request must carry the configured Authorization header, and
+ * every request after initialize the session and protocol headers.
+ * ============================================================ */
+#define FAKE_SESSION "s-42"
+#define FAKE_AUTH    "Authorization: Bearer t0k3n"
+
+typedef struct {
+    int listen_fd;
+    int port;
+    pthread_t thread;
+    volatile int stop;
+#ifdef NEURONOS_HAS_OPENSSL
+    SSL_CTX * tls; /* set before fake_http_start for https */
+#endif
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int n_conns;       /* connections accepted        */
+    int n_live;        /* connection threads running  */
+    int n_resumed;     /* TLS sessions resumed        */
+    int n_notes;       /* notifications received      */
+    int n_bad_headers; /* requests missing a header   */
+    int n_dropped;     /* "drop" requests seen        */
+    int n_held;        /* "hold" requests waiting     */
+} fake_http_t;
+
+typedef struct {
+    fake_http_t * h;
+    int fd;
+#ifdef NEURONOS_HAS_OPENSSL
+    SSL * ssl;
+#endif
+} http_conn_t;
+
+static void deadline_in(struct timespec * ts, int ms) {
+    clock_gettime(CLOCK_REALTIME, ts);
+    ts->tv_sec += ms / 1000;
+    ts->tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+static int fake_http_count(fake_http_t * h, const int * counter) {
+    pthread_mutex_lock(&h->lock);
+    int n = *counter;
+    pthread_mutex_unlock(&h->lock);
+    return n;
+}
+
+static ssize_t hc_read(http_conn_t * c, char * buf, size_t n) {
+#ifdef NEURONOS_HAS_OPENSSL
+    if (c->ssl) {
+        int r = SSL_read(c->ssl, buf, (int)n);
+        return r > 0 ? r : SSL_get_error(c->ssl, r) == SSL_ERROR_ZERO_RETURN ? 0 : -1;
+    }
+#endif
+    return recv(c->fd, buf, n, 0);
+}
+
+static bool hc_write(http_conn_t * c, const char * s, size_t n) {
+    while (n > 0) {
+        ssize_t w;
+#ifdef NEURONOS_HAS_OPENSSL
+        if (c->ssl)
+            w = SSL_write(c->ssl, s, (int)n);
+        else
+            w = send(c->fd, s, n, 0);
+#else
+        w = send(c->fd, s, n, 0);
+#endif
+        if (w <= 0)
+            return false;
+        s += w;
+        n -= (size_t)w;
+    }
+    return true;
+}
+
+static bool hc_send_json(http_conn_t * c, const char * status, const char * headers, const char * json) {
+    char head[512];
+    int n = snprintf(head, sizeof(head),
+                     "HTTP/1.1 %s\r\nContent-Type: application/json\r\nContent-Length: %zu\r\n%s\r\n", status,
+                     strlen(json), headers);
+    return hc_write(c, head, (size_t)n) && hc_write(c, json, strlen(json));
+}
+
+/* Chunked body written piece by piece, so reads straddle chunk boundaries */
+static bool hc_send_chunked(http_conn_t * c, const char * type, const char * body, size_t piece) {
+    char line[128];
+    int n = snprintf(line, sizeof(line), "HTTP/1.1 200 OK\r\nContent-Type: %s\r\nTransfer-Encoding: chunked\r\n\r\n",
+                     type);
+    if (!hc_write(c, line, (size_t)n))
+        return false;
+    for (size_t off = 0, len = strlen(body); off < len; off += piece) {
+        size_t take = len - off < piece ? len - off : piece;
+        n = snprintf(line, sizeof(line), "%zx\r\n", take);
+        if (!hc_write(c, line, (size_t)n) || !hc_write(c, body + off, take) || !hc_write(c, "\r\n", 2))
+            return false;
+        usleep(1000);
+    }
+    return hc_write(c, "0\r\n\r\n", 5);
+}
+
+static void fake_http_result(char * buf, size_t cap, int id, const char * text) {
+    snprintf(buf, cap, "{\"jsonrpc\":\"2.0\",\"id\":%d,\"result\":{\"content\":[{\"type\":\"text\",\"text\":\"%s\"}]}}",
+             id, text);
+}
+
+static bool fake_http_send_sse(http_conn_t * c, int id, const char * tag) {
+    char body[1024];
+    snprintf(body, sizeof(body),
+             ": stream open\r\n\r\n"
+             "event: message\r\n"
+             "data: {\"jsonrpc\":\"2.0\",\"method\":\"notifications/progress\",\"params\":{\"progressToken\":%d,"
+             "\"progress\":1}}\r\n\r\n"
+             "data:{\"jsonrpc\":\"2.0\",\"id\":%d,\"method\":\"roots/list\"}\n\n"
+             "data: {\"jsonrpc\":\"2.0\",\"id\":%d,\"result\":{}}\r\n\r\n"
+             "id: 2\r\n"
+             "data: {\"jsonrpc\":\"2.0\",\"id\":%d,\r\n"
+             "data: \"result\":{\"content\":[{\"type\":\"text\",\"text\":\"%s\"}]}}\r\n\r\n",
+             id, id, id + 1000, id, tag);
+    return hc_send_chunked(c, "text/event-stream", body, 11);
+}
+
+/* Answer one request. Returns false when the connection should close. */
+static bool fake_http_handle(http_conn_t * c, const char * head, const char * body) {
+    fake_http_t * h = c->h;
+    char method[64] = "", tag[32] = "", json[1024];
+    nj_copy_str(body, "method", method, sizeof(method));
+    int id = nj_find_int(body, "id", -1);
+    char * params = nj_extract_object(body, "params");
+    char * args = params ? nj_extract_object(params, "arguments") : NULL;
+    if (args)
+        nj_copy_str(args, "tag", tag, sizeof(tag));
+    free(args);
+    free(params);
+
+    bool initialize = strcmp(method, "initialize") == 0;
+    pthread_mutex_lock(&h->lock);
+    if (!strstr(head, "\r\n" FAKE_AUTH "\r\n") ||
+        (!initialize && (!strstr(head, "\r\nMcp-Session-Id: " FAKE_SESSION "\r\n") ||
+                         !strstr(head, "\r\nMCP-Protocol-Version: 2025-11-25\r\n"))))
+        h->n_bad_headers++;
+    if (id < 0)
+        h->n_notes++;
+    pthread_mutex_unlock(&h->lock);
+
+    if (initialize) {
+        snprintf(json, sizeof(json),
+                 "{\"jsonrpc\":\"2.0\",\"id\":%d,\"result\":{\"protocolVersion\":\"2025-11-25\",\"capabilities\":"
+                 "{\"tools\":{}},\"serverInfo\":{\"name\":\"fake-http\",\"version\":\"1\"}}}",
+                 id);
+        return hc_send_json(c, "200 OK", "Mcp-Session-Id: " FAKE_SESSION "\r\n", json);
+    }
+    if (id < 0) {
+        const char * accepted = "HTTP/1.1 202 Accepted\r\nContent-Length: 0\r\n\r\n";
+        return hc_write(c, accepted, strlen(accepted));
+    }
+    if (strcmp(method, "tools/list") == 0) {
+        snprintf(json, sizeof(json),
+                 "{\"jsonrpc\":\"2.0\",\"id\":%d,\"result\":{\"tools\":[{\"name\":\"echo\",\"description\":"
+                 "\"Returns tag\",\"inputSchema\":{\"type\":\"object\",\"properties\":{\"tag\":{\"type\":"
+                 "\"string\"}}}}]}}",
+                 id);
+        return hc_send_chunked(c, "application/json", json, 7);
+    }
+
+    if (strcmp(tag, "sse") == 0)
+        return fake_http_send_sse(c, id, tag);
+    if (strcmp(tag, "hold") == 0) {
+        struct timespec deadline;
+        deadline_in(&deadline, RECV_TIMEOUT_MS);
+        pthread_mutex_lock(&h->lock);
+        h->n_held++;
+        pthread_cond_broadcast(&h->cond);
+        while (h->n_held < 3 && pthread_cond_timedwait(&h->cond, &h->lock, &deadline) != ETIMEDOUT) {
+        }
+        pthread_mutex_unlock(&h->lock);
+        return fake_http_send_sse(c, id, tag);
+    }
+    if (strcmp(tag, "chunked") == 0) {
+        fake_http_result(json, sizeof(json), id, tag);
+        return hc_send_chunked(c, "application/json", json, 5);
+    }
+    if (strcmp(tag, "close") == 0) {
+        const char * head_close = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nConnection: close\r\n\r\n";
+        fake_http_result(json, sizeof(json), id, tag);
+        hc_write(c, head_close, strlen(head_close));
+        hc_write(c, json, strlen(json));
+        return false;
+    }
+    if (strcmp(tag, "err500") == 0)
+        return hc_send_json(c, "500 Internal Server Error", "", "{\"error\":\"boom\"}");
+    if (strcmp(tag, "rpcerr") == 0) {
+        snprintf(json, sizeof(json),
+                 "{\"jsonrpc\":\"2.0\",\"id\":%d,\"error\":{\"code\":-32603,\"message\":\"boom\"}}", id);
+        return hc_send_json(c, "200 OK", "", json);
+    }
+    if (strcmp(tag, "drop") == 0) {
+        pthread_mutex_lock(&h->lock);
+        bool first = h->n_dropped++ % 2 == 0;
+        pthread_mutex_unlock(&h->lock);
+        if (first)
+            return false;
+    }
+    if (strcmp(tag, "slow") == 0)
+        usleep(1000 * 1000);
+    fake_http_result(json, sizeof(json), id, tag);
+    return hc_send_json(c, "200 OK", "", json);
+}
+
+static void * fake_http_conn_main(void * arg) {
+    http_conn_t * c = arg;
+    fake_http_t * h = c->h;
+    size_t cap = 1 << 16, len = 0;
+    char * buf = malloc(cap);
+    struct timeval tv = {.tv_sec = RECV_TIMEOUT_MS / 1000};
+    setsockopt(c->fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+#ifdef NEURONOS_HAS_OPENSSL
+    if (h->tls) {
+        c->ssl = SSL_new(h->tls);
+        if (!c->ssl || SSL_set_fd(c->ssl, c->fd) != 1 || SSL_accept(c->ssl) != 1)
+            goto out;
+        if (SSL_session_reused(c->ssl)) {
+            pthread_mutex_lock(&h->lock);
+            h->n_resumed++;
+            pthread_mutex_unlock(&h->lock);
+        }
+    }
+#endif
+
+    while (buf) {
+        /* Head, then Content-Length bytes of body */
+        char * end;
+        buf[len] = '\0';
+        while (!(end = strstr(buf, "\r\n\r\n"))) {
+            ssize_t r = len + 1 < cap ? hc_read(c, buf + len, cap - len - 1) : -1;
+            if (r <= 0)
+                goto out;
+            len += (size_t)r;
+            buf[len] = '\0';
+        }
+        size_t head_len = (size_t)(end + 4 - buf);
+        const char * cl = strstr(buf, "\r\nContent-Length: ");
+        size_t body_len = cl && cl < end ? strtoul(cl + 18, NULL, 10) : 0;
+        if (head_len + body_len >= cap)
+            goto out;
+        while (len < head_len + body_len) {
+            ssize_t r = hc_read(c, buf + len, cap - len - 1);
+            if (r <= 0)
+                goto out;
+            len += (size_t)r;
+        }
+
+        char * head = strndup(buf, head_len);
+        char * body = strndup(buf + head_len, body_len);
+        len -= head_len + body_len;
+        memmove(buf, buf + head_len + body_len, len);
+        bool keep = head && body && fake_http_handle(c, head, body);
+        free(head);
+        free(body);
+        if (!keep)
+            break;
+    }
+
+out:
+#ifdef NEURONOS_HAS_OPENSSL
+    if (c->ssl) {
+        SSL_shutdown(c->ssl);
+        SSL_free(c->ssl);
+    }
+#endif
+    close(c->fd);
+    free(c);
+    free(buf);
+    pthread_mutex_lock(&h->lock);
+    h->n_live--;
+    pthread_cond_broadcast(&h->cond);
+    pthread_mutex_unlock(&h->lock);
+    return NULL;
+}
+
+static void * fake_http_accept_main(void * arg) {
+    fake_http_t * h = arg;
+    while (!h->stop) {
+        struct pollfd pfd = {.fd = h->listen_fd, .events = POLLIN};
+        if (poll(&pfd, 1, 50) <= 0)
+            continue;
+        int fd = accept(h->listen_fd, NULL, NULL);
+        if (fd < 0)
+            continue;
+        http_conn_t * c = calloc(1, sizeof(*c));
+        if (!c) {
+            close(fd);
+            continue;
+        }
+        c->h = h;
+        c->fd = fd;
+        pthread_mutex_lock(&h->lock);
+        h->n_conns++;
+        h->n_live++;
+        pthread_mutex_unlock(&h->lock);
+        pthread_t t;
+        if (pthread_create(&t, NULL, fake_http_conn_main, c) != 0) {
+            close(fd);
+            free(c);
+            pthread_mutex_lock(&h->lock);
+            h->n_live--;
+            pthread_mutex_unlock(&h->lock);
+            continue;
+        }
+        pthread_detach(t);
+    }
+    return NULL;
+}
+
+/* Listen on 127.0.0.1, ephemeral port. h must be zeroed (tls aside). */
+static bool fake_http_start(fake_http_t * h) {
+    pthread_mutex_init(&h->lock, NULL);
+    pthread_cond_init(&h->cond, NULL);
+    h->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (h->listen_fd < 0)
+        return false;
+    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+    socklen_t alen = sizeof(addr);
+    if (bind(h->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(h->listen_fd, 16) < 0 ||
+        getsockname(h->listen_fd, (struct sockaddr *)&addr, &alen) < 0 ||
+        pthread_create(&h->thread, NULL, fake_http_accept_main, h) != 0) {
+        close(h->listen_fd);
+        return false;
+    }
+    h->port = ntohs(addr.sin_port);
+    return true;
+}
+
+/* Stop accepting and wait for connection threads (the client is gone) */
+static void fake_http_stop(fake_http_t * h) {
+    h->stop = 1;
+    pthread_join(h->thread, NULL);
+    close(h->listen_fd);
+    pthread_mutex_lock(&h->lock);
+    while (h->n_live > 0)
+        pthread_cond_wait(&h->cond, &h->lock);
+    pthread_mutex_unlock(&h->lock);
+    pthread_cond_destroy(&h->cond);
+    pthread_mutex_destroy(&h->lock);
+}
+
+static neuronos_mcp_client_t * http_client_connect(const char * url, int timeout_ms) {
+    neuronos_mcp_client_t * client = neuronos_mcp_client_create();
+    if (!client)
+        return NULL;
+    neuronos_mcp_client_set_cache_dir(client, NULL);
+    const char * headers[] = {FAKE_AUTH};
+    neuronos_mcp_server_config_t cfg = {
+        .name = "fake-http",
+        .transport = NEURONOS_MCP_TRANSPORT_HTTP,
+        .url = url,
+        .timeout_ms = timeout_ms,
+        .headers = headers,
+        .n_headers = 1,
+    };
+    if (neuronos_mcp_client_add_server(client, &cfg) != 0 || neuronos_mcp_client_connect(client) != 0 ||
+        neuronos_mcp_client_tool_count(client) != 1) {
+        neuronos_mcp_client_free(client);
+        return NULL;
+    }
+    return client;
+}
+
+static char * echo_call(neuronos_mcp_client_t * client, const char * tag, int timeout_ms) {
+    char args[64];
+    snprintf(args, sizeof(args), "{\"tag\":\"%s\"}", tag);
+    return neuronos_mcp_client_call_tool_timeout(client, "echo", args, timeout_ms);
+}
+
+/* ============================================================
+ * TEST 8: HTTP session headers and response framings
+ * ============================================================ */
+static void test_http_framing(void) {
+    TEST_START("MCP client over HTTP: session headers and response framings");
+    fake_http_t h = {0};
+    neuronos_mcp_client_t * client = NULL;
+    char * result = NULL;
+    char url[64];
+    bool up = fake_http_start(&h);
+    ASSERT(up, "fake HTTP server did not start");
+    snprintf(url, sizeof(url), "http://127.0.0.1:%d/mcp", h.port);
+    client = http_client_connect(url, RECV_TIMEOUT_MS);
+    ASSERT(client, "connect over HTTP failed (chunked tools/list?)");
+
+    const char * tags[] = {"json", "chunked", "sse", "close", "json"};
+    for (int i = 0; i < 5; i++) {
+        free(result);
+        result = echo_call(client, tags[i], 0);
+        ASSERT(result && strcmp(result, tags[i]) == 0, "wrong or missing reply");
+    }
+    ASSERT(fake_http_count(&h, &h.n_notes) == 1, "notifications/initialized not POSTed");
+    ASSERT(fake_http_count(&h, &h.n_bad_headers) == 0, "request without auth, session or protocol header");
+    /* Only the close-delimited reply cost a connection */
+    ASSERT(fake_http_count(&h, &h.n_conns) == 2, "keep-alive connection not reused");
+
+    TEST_PASS();
+done:
+    free(result);
+    if (client)
+        neuronos_mcp_client_free(client);
+    if (up)
+        fake_http_stop(&h);
+}
+
+/* ============================================================
+ * TEST 9: Concurrent HTTP calls, then pooled connections reused
+ * ============================================================ */
+static void test_http_concurrent(void) {
+    TEST_START("MCP client over HTTP: concurrent calls, pooled connections");
+    fake_http_t h = {0};
+    neuronos_mcp_client_t * client = NULL;
+    echo_call_t calls[3] = {{0}};
+    pthread_t threads[3];
+    int started = 0;
+    char * result = NULL;
+    char url[64];
+    bool up = fake_http_start(&h);
+    ASSERT(up, "fake HTTP server did not start");
+    snprintf(url, sizeof(url), "http://127.0.0.1:%d/mcp", h.port);
+    client = http_client_connect(url, RECV_TIMEOUT_MS);
+    ASSERT(client, "connect over HTTP failed");
+
+    /* The server answers only once all three are waiting: one connection each */
+    for (; started < 3; started++) {
+        calls[started].client = client;
+        snprintf(calls[started].args, sizeof(calls[started].args), "{\"tag\":\"hold\"}");
+        ASSERT(pthread_create(&threads[started], NULL, echo_call_main, &calls[started]) == 0, "thread start");
+    }
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+    started = 0;
+    for (int i = 0; i < 3; i++)
+        ASSERT(calls[i].result && strcmp(calls[i].result, "hold") == 0, "concurrent call failed");
+    int conns = fake_http_count(&h, &h.n_conns);
+    ASSERT(conns == 3, "calls did not run on separate connections");
+
+    for (int i = 0; i < 6; i++) {
+        free(result);
+        result = echo_call(client, "json", 0);
+        ASSERT(result && strcmp(result, "json") == 0, "sequential call failed");
+    }
+    ASSERT(fake_http_count(&h, &h.n_conns) == conns, "idle connections not reused");
+
+    TEST_PASS();
+done:
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+    for (int i = 0; i < 3; i++)
+        free(calls[i].result);
+    free(result);
+    if (client)
+        neuronos_mcp_client_free(client);
+    if (up)
+        fake_http_stop(&h);
+}
+
+/* ============================================================
+ * TEST 10: HTTP errors, retries and bad endpoints
+ * ============================================================ */
+static void test_http_errors(void) {
+    TEST_START("MCP client over HTTP: errors, retries and bad endpoints");
+    fake_http_t h = {0};
+    neuronos_mcp_client_t * client = NULL;
+    neuronos_mcp_client_t * other = NULL;
+    char * result = NULL;
+    char url[64];
+    bool up = fake_http_start(&h);
+    ASSERT(up, "fake HTTP server did not start");
+    snprintf(url, sizeof(url), "http://127.0.0.1:%d/mcp", h.port);
+    client = http_client_connect(url, RECV_TIMEOUT_MS);
+    ASSERT(client, "connect over HTTP failed");
+
+    /* A 500's body is drained: the connection stays usable */
+    result = echo_call(client, "err500", 0);
+    ASSERT(!result, "HTTP 500 returned a result");
+    result = echo_call(client, "json", 0);
+    ASSERT(result && strcmp(result, "json") == 0, "call after HTTP 500 failed");
+    ASSERT(fake_http_count(&h, &h.n_conns) == 1, "connection dropped after HTTP 500");
+
+    free(result);
+    result = echo_call(client, "rpcerr", 0);
+    ASSERT(result && strcmp(result, "MCP error: boom") == 0, "JSON-RPC error not reported");
+
+    /* Dropped on a fresh connection (retried with backoff), then on a
+     * pooled one (the server may have closed it: retried for free) */
+    free(result);
+    result = echo_call(client, "close", 0);
+    ASSERT(result && strcmp(result, "close") == 0, "close-delimited reply failed");
+    for (int i = 0; i < 2; i++) {
+        free(result);
+        result = echo_call(client, "drop", 0);
+        ASSERT(result && strcmp(result, "drop") == 0, "dropped request not retried");
+    }
+    ASSERT(fake_http_count(&h, &h.n_dropped) == 4, "dropped request not sent exactly twice");
+
+    free(result);
+    double t0 = now_ms();
+    result = echo_call(client, "slow", 300);
+    ASSERT(!result, "slow reply beat its timeout");
+    ASSERT(now_ms() - t0 < 900, "timeout not honoured");
+    result = echo_call(client, "json", 0);
+    ASSERT(result && strcmp(result, "json") == 0, "call after a timeout failed");
+
+    /* Malformed URLs are refused up front */
+    other = neuronos_mcp_client_create();
+    ASSERT(other, "client create");
+    const char * bad[] = {"ftp://127.0.0.1/mcp", "http://[::1/mcp", "http://127.0.0.1:/mcp", "http://:80/mcp",
+                          "http://127.0.0.1:80x/mcp"};
+    for (int i = 0; i < 5; i++) {
+        neuronos_mcp_server_config_t cfg = {.name = "bad", .transport = NEURONOS_MCP_TRANSPORT_HTTP, .url = bad[i]};
+        ASSERT(neuronos_mcp_client_add_server(other, &cfg) == -1, "malformed URL accepted");
+    }
+    neuronos_mcp_client_free(other);
+    other = NULL;
+
+    /* Nobody listening: connect gives up within the server's timeout */
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+    socklen_t alen = sizeof(addr);
+    ASSERT(fd >= 0 && bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0 &&
+               getsockname(fd, (struct sockaddr *)&addr, &alen) == 0,
+           "reserve a port");
+    close(fd);
+    snprintf(url, sizeof(url), "http://127.0.0.1:%d/mcp", ntohs(addr.sin_port));
+    t0 = now_ms();
+    other = http_client_connect(url, 500);
+    ASSERT(!other, "connected to a closed port");
+    ASSERT(now_ms() - t0 < 3000, "refused connection retried past the timeout");
+
+    TEST_PASS();
+done:
+    free(result);
+    if (other)
+        neuronos_mcp_client_free(other);
+    if (client)
+        neuronos_mcp_client_free(client);
+    if (up)
+        fake_http_stop(&h);
+}
+
+#ifdef NEURONOS_HAS_OPENSSL
+/* Self-signed certificate for `name`, written as PEM to a temp file */
+static bool make_cert(const char * name, EVP_PKEY ** key_out, X509 ** cert_out, char * pem_path, size_t cap) {
+    EVP_PKEY * key = NULL;
+    X509 * cert = NULL;
+    EVP_PKEY_CTX * kctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, NULL);
+    bool ok = kctx && EVP_PKEY_keygen_init(kctx) > 0 &&
+              EVP_PKEY_CTX_set_ec_paramgen_curve_nid(kctx, NID_X9_62_prime256v1) > 0 &&
+              EVP_PKEY_keygen(kctx, &key) > 0 && (cert = X509_new()) != NULL;
+    EVP_PKEY_CTX_free(kctx);
+
+    if (ok) {
+        char san[160];
+        snprintf(san, sizeof(san), "DNS:%s", name);
+        X509_set_version(cert, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(cert), (long)time(NULL));
+        X509_gmtime_adj(X509_getm_notBefore(cert), -3600);
+        X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+        X509_set_pubkey(cert, key);
+        X509_NAME * subject = X509_get_subject_name(cert);
+        X509_NAME_add_entry_by_txt(subject, "CN", MBSTRING_ASC, (const unsigned char *)name, -1, -1, 0);
+        X509_set_issuer_name(cert, subject);
+        X509V3_CTX v3;
+        X509V3_set_ctx_nodb(&v3);
+        X509V3_set_ctx(&v3, cert, cert, NULL, NULL, 0);
+        X509_EXTENSION * ext = X509V3_EXT_conf_nid(NULL, &v3, NID_subject_alt_name, san);
+        ok = ext && X509_add_ext(cert, ext, -1) && X509_sign(cert, key, EVP_sha256()) > 0;
+        X509_EXTENSION_free(ext);
+    }
+
+    snprintf(pem_path, cap, "/tmp/neuronos_test_mcp_XXXXXX");
+    int fd = ok ? mkstemp(pem_path) : -1;
+    FILE * f = fd >= 0 ? fdopen(fd, "w") : NULL;
+    ok = f && PEM_write_X509(f, cert);
+    if (f)
+        fclose(f);
+    else if (fd >= 0)
+        close(fd);
+    if (!ok) {
+        if (fd >= 0)
+            unlink(pem_path);
+        X509_free(cert);
+        EVP_PKEY_free(key);
+        return false;
+    }
+    *key_out = key;
+    *cert_out = cert;
+    return true;
+}
+#endif
+
+/* ============================================================
+ * TEST 11: https — verified handshake, resumed session, refusals
+ * ============================================================ */
+static void test_https(void) {
+#ifdef NEURONOS_HAS_OPENSSL
+    TEST_START("MCP client over HTTPS: verification and session resumption");
+    fake_http_t h = {0};
+    neuronos_mcp_client_t * client = NULL;
+    neuronos_mcp_client_t * other = NULL;
+    char * result = NULL;
+    char url[64];
+    char pem[64] = "", stranger_pem[64] = "";
+    EVP_PKEY * key = NULL, * stranger_key = NULL;
+    X509 * cert = NULL, * stranger = NULL;
+    bool up = false;
+    ASSERT(make_cert("localhost", &key, &cert, pem, sizeof(pem)) &&
+               make_cert("localhost", &stranger_key, &stranger, stranger_pem, sizeof(stranger_pem)),
+           "certificate generation failed");
+
+    h.tls = SSL_CTX_new(TLS_server_method());
+    ASSERT(h.tls && SSL_CTX_use_certificate(h.tls, cert) == 1 && SSL_CTX_use_PrivateKey(h.tls, key) == 1,
+           "server TLS context");
+    up = fake_http_start(&h);
+    ASSERT(up, "fake HTTPS server did not start");
+
+    /* Trusted certificate: works, and a reconnect resumes the session */
+    setenv("SSL_CERT_FILE", pem, 1);
+    snprintf(url, sizeof(url), "https://localhost:%d/mcp", h.port);
+    client = http_client_connect(url, RECV_TIMEOUT_MS);
+    ASSERT(client, "connect over HTTPS failed");
+    const char * tags[] = {"sse", "close", "json"};
+    for (int i = 0; i < 3; i++) {
+        free(result);
+        result = echo_call(client, tags[i], 0);
+        ASSERT(result && strcmp(result, tags[i]) == 0, "wrong or missing reply over TLS");
+    }
+    ASSERT(fake_http_count(&h, &h.n_conns) == 2, "keep-alive TLS connection not reused");
+    ASSERT(fake_http_count(&h, &h.n_resumed) == 1, "TLS session not resumed on reconnect");
+    neuronos_mcp_client_free(client);
+    client = NULL;
+
+    /* Same server under a name its certificate does not carry */
+    snprintf(url, sizeof(url), "https://127.0.0.1:%d/mcp", h.port);
+    other = http_client_connect(url, 2000);
+    ASSERT(!other, "certificate accepted for the wrong host name");
+
+    /* Right name, certificate not trusted */
+    setenv("SSL_CERT_FILE", stranger_pem, 1);
+    snprintf(url, sizeof(url), "https://localhost:%d/mcp", h.port);
+    other = http_client_connect(url, 2000);
+    ASSERT(!other, "untrusted certificate accepted");
+    ASSERT(fake_http_count(&h, &h.n_notes) == 1, "request sent over an unverified connection");
+
+    TEST_PASS();
+done:
+    unsetenv("SSL_CERT_FILE");
+    free(result);
+    if (other)
+        neuronos_mcp_client_free(other);
+    if (client)
+        neuronos_mcp_client_free(client);
+    if (up)
+        fake_http_stop(&h);
+    SSL_CTX_free(h.tls);
+    if (pem[0])
+        unlink(pem);
+    if (stranger_pem[0])
+        unlink(stranger_pem);
+    X509_free(cert);
+    X509_free(stranger);
+    EVP_PKEY_free(key);
+    EVP_PKEY_free(stranger_key);
+#else
+    TEST_START("MCP client: https:// refused without TLS support");
+    neuronos_mcp_client_t * client = neuronos_mcp_client_create();
+    neuronos_mcp_server_config_t cfg = {
+        .name = "tls", .transport = NEURONOS_MCP_TRANSPORT_HTTP, .url = "https://localhost/mcp"};
+    ASSERT(client, "client create");
+    ASSERT(neuronos_mcp_client_add_server(client, &cfg) == -1, "https:// accepted without OpenSSL");
+    TEST_PASS();
+done:
+    if (client)
+        neuronos_mcp_client_free(client);
+#endif
+}
+
+static int count_lines(const char * path, const char * want) {
+    char line[128];
+    int n = 0;
+    FILE * f = fopen(path, "r");
+    if (!f)
+        return 0;
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\n")] = '\0';
+        n += strcmp(line, want) == 0;
+    }
+    fclose(f);
+    return n;
+}
+
+static neuronos_mcp_client_t * cache_client(const char * cache_dir, const char ** env, int n_env) {
+    neuronos_mcp_client_t * client = neuronos_mcp_client_create();
+    if (!client)
+        return NULL;
+    neuronos_mcp_client_set_cache_dir(client, cache_dir);
+    const char * args[] = {"--fake-mcp-server"};
+    neuronos_mcp_server_config_t cfg = {
+        .name = "fake",
+        .transport = NEURONOS_MCP_TRANSPORT_STDIO,
+        .command = g_self,
+        .args = args,
+        .n_args = 1,
+        .env = env,
+        .n_env = n_env,
+        .timeout_ms = RECV_TIMEOUT_MS,
+    };
+    if (neuronos_mcp_client_add_server(client, &cfg) != 0) {
+        neuronos_mcp_client_free(client);
+        return NULL;
+    }
+    return client;
+}
+
+/* ============================================================
+ * TEST 12: Discovery cache
+ * ============================================================ */
+static void test_client_cache(void) {
+    TEST_START("MCP client: discovery cache, warm start and version change");
+    char root[] = "/tmp/neuronos_test_mcp_XXXXXX";
+    char cache[64], state[64], log[64], path[64];
+    neuronos_mcp_client_t * client = NULL;
+    char * result = NULL;
+    bool made = mkdtemp(root) != NULL;
+    ASSERT(made, "could not create a scratch directory");
+    snprintf(cache, sizeof(cache), "%s/cache", root);
+    snprintf(state, sizeof(state), "FAKE_STATE=%s", root);
+    snprintf(log, sizeof(log), "%s/log", root);
+    const char * env[] = {state, "FAKE_DELAY_MS=300"};
+
+    /* Cold start: tools/list, result cached */
+    client = cache_client(cache, env, 2);
+    ASSERT(client && neuronos_mcp_client_connect(client) == 0, "cold connect failed");
+    ASSERT(neuronos_mcp_client_tool_count(client) == 1, "no tools discovered");
+    ASSERT(count_lines(log, "tools/list") == 1, "tools/list not sent on a cold start");
+    neuronos_mcp_client_free(client);
+    client = NULL;
+
+    /* Warm start: cached tools offered while the server starts; a call waits for it */
+    client = cache_client(cache, env, 2);
+    double t0 = now_ms();
+    ASSERT(client && neuronos_mcp_client_connect_async(client) == 1, "async connect failed");
+    ASSERT(neuronos_mcp_client_tool_count(client) == 1, "cached tools not offered");
+    ASSERT(now_ms() - t0 < 250, "async connect waited for the server");
+    result = neuronos_mcp_client_call_tool(client, "echo", "{\"tag\":\"solo\"}");
+    ASSERT(result && strcmp(result, "solo") == 0, "call to a starting server failed");
+    ASSERT(neuronos_mcp_client_wait(client, RECV_TIMEOUT_MS) == 0, "server still starting");
+    ASSERT(count_lines(log, "tools/list") == 1, "warm start sent tools/list");
+    neuronos_mcp_client_free(client);
+    client = NULL;
+
+    /* Same command line, new server version: tools rediscovered */
+    snprintf(path, sizeof(path), "%s/version", root);
+    FILE * f = fopen(path, "w");
+    ASSERT(f, "write version file");
+    fputs("2\n", f);
+    fclose(f);
+    client = cache_client(cache, env, 2);
+    ASSERT(client && neuronos_mcp_client_connect(client) == 0, "connect after a version change failed");
+    ASSERT(count_lines(log, "tools/list") == 2, "version change did not rediscover tools");
+    ASSERT(neuronos_mcp_client_tool_count(client) == 1, "tool listed twice after rediscovery");
+
+    TEST_PASS();
+done:
+    free(result);
+    if (client)
+        neuronos_mcp_client_free(client);
+    if (made) {
+        char cmd[96];
+        snprintf(cmd, sizeof(cmd), "rm -rf \"%s\"", root);
+        if (system(cmd) != 0)
+            fprintf(stderr, "  (could not remove %s)\n", root);
+    }
+}
+
+/* ============================================================
+ * TEST 13: Servers start concurrently
+ * ============================================================ */
+static void test_client_parallel_start(void) {
+    TEST_START("MCP client: servers start in parallel");
+    neuronos_mcp_client_t * client = neuronos_mcp_client_create();
+    const char * env[] = {"FAKE_DELAY_MS=600"};
+    ASSERT(client, "client create");
+    neuronos_mcp_client_set_cache_dir(client, NULL);
+
+    for (int i = 0; i < 3; i++) {
+        char name[16];
+        snprintf(name, sizeof(name), "slow%d", i);
+        const char * args[] = {"--fake-mcp-server", name};
+        neuronos_mcp_server_config_t cfg = {
+            .name = name,
+            .transport = NEURONOS_MCP_TRANSPORT_STDIO,
+            .command = g_self,
+            .args = args,
+            .n_args = 2,
+            .env = env,
+            .n_env = 1,
+            .timeout_ms = RECV_TIMEOUT_MS,
+        };
+        ASSERT(neuronos_mcp_client_add_server(client, &cfg) == 0, "add server");
+    }
+
+    /* One at a time would take at least 1.8 s */
+    double t0 = now_ms();
+    ASSERT(neuronos_mcp_client_connect(client) == 0, "connect failed");
+    ASSERT(now_ms() - t0 < 1500, "servers started one after another");
+    ASSERT(neuronos_mcp_client_tool_count(client) == 3, "a server's tools are missing");
+
+    TEST_PASS();
+done:
+    if (client)
+        neuronos_mcp_client_free(client);
+}
+
+#endif /* !_WIN32 */
+
+int main(int argc, char * argv[]) {
+#ifndef _WIN32
+    if (argc > 1 && strcmp(argv[1], "--fake-mcp-server") == 0)
+        return fake_mcp_server_main();
+    g_self = argv[0];
+#else
+    (void)argc;
+    (void)argv;
+#endif
+
+    fprintf(stderr, "═══════════════════════════════════════════\n");
+    fprintf(stderr, "  NeuronOS MCP Transport Test Suite\n");
+    fprintf(stderr, "═══════════════════════════════════════════\n");
+
+#ifdef _WIN32
+    fprintf(stderr, "  (needs fork and pipes — skipped)\n");
+#else
+    signal(SIGPIPE, SIG_IGN);
+    test_server_handshake();
+    test_server_concurrent();
+    test_server_serial();
+    test_server_cancel();
+    test_client_out_of_order();
+    test_client_timeout();
+    test_client_server_exit();
+    test_http_framing();
+    test_http_concurrent();
+    test_http_errors();
+    test_https();
+    test_client_cache();
+    test_client_parallel_start();
+#endif
+
+    /* Summary */
+    fprintf(stderr, "\n═══════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d/%d passed", tests_passed, tests_run);
+    if (tests_failed > 0) {
+        fprintf(stderr, " (%d FAILED)", tests_failed);
+    }
+    fprintf(stderr, "\n═══════════════════════════════════════════\n");
+
+    return tests_failed > 0 ? 1 : 0;
+}
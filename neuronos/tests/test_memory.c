@@ -14,11 +14,19 @@
  * 10. Recall memory stats
  * 11. Session management
  * 12. Legacy API (store/recall/search)
+ * 13. Statement latency metrics
+ * 14. Recall summaries
+ * 15. Hybrid vector + FTS5 search
+ * 16. Batched writes (begin/commit)
+ * 17. Write-behind queue
+ * 18. Core memory generation
  *
  * Usage: ./test_memory   (no model needed — pure SQLite)
  * ============================================================ */
 #include "neuronos/neuronos.h"
 
+#include <ctype.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -381,6 +389,327 @@ static void test_legacy_api(void) {
 /* ============================================================
  * MAIN
  * ============================================================ */
+/* ============================================================
+ * TEST 13: Statement latency metrics
+ * ============================================================ */
+static void test_memory_metrics(void) {
+    TEST_START("Statement latency metrics");
+
+    neuronos_metrics_reset();
+    neuronos_memory_t * mem = neuronos_memory_open(":memory:");
+    ASSERT(mem != NULL, "memory open failed");
+
+    ASSERT(neuronos_memory_core_set(mem, "scratch", "x") == 0, "core set failed");
+    char * v = neuronos_memory_core_get(mem, "scratch");
+    free(v);
+    neuronos_memory_close(mem);
+
+    ASSERT(neuronos_metrics_get(NEURONOS_METRIC_MEMORY).count >= 2, "statements not recorded");
+    char * prom = neuronos_metrics_prometheus();
+    ASSERT(prom != NULL, "prometheus export failed");
+    bool ok = strstr(prom, "neuronos_memory_op_seconds_count{op=\"select\"}") != NULL &&
+              strstr(prom, "neuronos_memory_op_seconds_count{op=\"insert\"}") != NULL;
+    free(prom);
+    ASSERT(ok, "per-verb series missing");
+
+    TEST_PASS();
+}
+
+/* ============================================================
+ * TEST 14: Recall summaries
+ * ============================================================ */
+static void test_recall_summary(void) {
+    TEST_START("Recall summaries");
+
+    neuronos_memory_t * mem = neuronos_memory_open(":memory:");
+    ASSERT(mem != NULL, "memory open failed");
+
+    neuronos_memory_recall_add(mem, 1, "user", "My name is Ada", 4);
+    int64_t last = neuronos_memory_recall_add(mem, 1, "assistant", "Nice to meet you, Ada", 6);
+    int64_t id = neuronos_memory_recall_add_summary(mem, 1, "User introduced herself as Ada.", 7, last);
+    ASSERT(id > last, "recall_add_summary failed");
+
+    neuronos_recall_entry_t * entries = NULL;
+    int count = 0;
+    ASSERT(neuronos_memory_recall_recent(mem, 1, 1, &entries, &count) == 0 && count == 1, "recall_recent failed");
+    bool ok = entries[0].id == id && entries[0].summary_of == last && strcmp(entries[0].role, "system") == 0;
+    neuronos_memory_recall_free(entries, count);
+    ASSERT(ok, "summary row mismatch");
+
+    neuronos_memory_close(mem);
+    TEST_PASS();
+}
+
+/* ============================================================
+ * TEST 15: Hybrid vector + FTS5 search
+ * ============================================================ */
+
+/* Bag-of-words embedder with one synonym, enough to tell a paraphrase
+ * match (vector) from a keyword match (FTS5) */
+#define FAKE_DIM 32
+static int fake_embed_calls = 0;
+
+static int fake_embed(void * user_data, const char * const * texts, int n, float * out) {
+    (void)user_data;
+    fake_embed_calls++;
+    for (int i = 0; i < n; i++) {
+        float * v = out + (size_t)i * FAKE_DIM;
+        memset(v, 0, FAKE_DIM * sizeof(float));
+        const char * p = texts[i];
+        while (*p) {
+            char word[32];
+            size_t len = 0;
+            while (*p && !isalpha((unsigned char)*p)) p++;
+            while (*p && isalpha((unsigned char)*p)) {
+                if (len < sizeof(word) - 1) word[len++] = (char)tolower((unsigned char)*p);
+                p++;
+            }
+            word[len] = '\0';
+            if (len < 3) continue;
+            if (strcmp(word, "car") == 0) strcpy(word, "automobile");
+            unsigned h = 2166136261u;
+            for (size_t j = 0; word[j]; j++) h = (h ^ (unsigned char)word[j]) * 16777619u;
+            v[h % FAKE_DIM] += 1.0f;
+        }
+        float norm = 0.0f;
+        for (int d = 0; d < FAKE_DIM; d++) norm += v[d] * v[d];
+        if (norm > 0.0f)
+            for (int d = 0; d < FAKE_DIM; d++) v[d] /= sqrtf(norm);
+    }
+    return 0;
+}
+
+static void test_hybrid_search(void) {
+    TEST_START("Hybrid vector + FTS5 search");
+
+    neuronos_memory_t * mem = neuronos_memory_open(":memory:");
+    ASSERT(mem != NULL, "open failed");
+
+    /* Rows written before the embedder is attached are backfilled */
+    neuronos_memory_archival_store(mem, "vehicle", "The user drives a blue automobile", "fact", 0.5f);
+    ASSERT(neuronos_memory_set_embedder(mem, "fake", FAKE_DIM, fake_embed, NULL) == 0, "set_embedder failed");
+    neuronos_memory_archival_store(mem, "pet", "The user has a cat named Miso", "fact", 0.5f);
+    neuronos_memory_archival_store(mem, "city", "The user lives in Lisbon", "fact", 0.5f);
+    neuronos_memory_recall_add(mem, 1, "user", "My car broke down on the highway", 8);
+    ASSERT(neuronos_memory_embed_flush(mem) == 4, "expected 4 rows embedded");
+    ASSERT(neuronos_memory_embed_flush(mem) == 0, "queue should be empty");
+
+    /* FTS5 alone misses this paraphrase ("car" never appears) */
+    neuronos_archival_entry_t * entries = NULL;
+    int count = 0;
+    ASSERT(neuronos_memory_archival_search(mem, "car", 2, &entries, &count) == 0, "archival search failed");
+    bool ok = count >= 1 && strcmp(entries[0].key, "vehicle") == 0;
+    neuronos_memory_archival_free(entries, count);
+    ASSERT(ok, "paraphrase should rank the vehicle fact first");
+
+    /* Keyword matches still come first */
+    ASSERT(neuronos_memory_archival_search(mem, "Lisbon", 1, &entries, &count) == 0 && count == 1,
+           "keyword search failed");
+    ok = strcmp(entries[0].key, "city") == 0;
+    neuronos_memory_archival_free(entries, count);
+    ASSERT(ok, "keyword match should rank first");
+
+    /* Recall rows too; invalid FTS5 syntax falls back to the vectors */
+    neuronos_recall_entry_t * recs = NULL;
+    ASSERT(neuronos_memory_recall_search(mem, "automobile \"", 1, &recs, &count) == 0, "recall search failed");
+    ok = count == 1 && strstr(recs[0].content, "broke down") != NULL;
+    neuronos_memory_recall_free(recs, count);
+    ASSERT(ok, "recall paraphrase not found");
+
+    /* Edits re-embed; a different model rebuilds every vector */
+    neuronos_memory_archival_store(mem, "pet", "The user has a dog named Miso", "fact", 0.5f);
+    ASSERT(neuronos_memory_embed_flush(mem) == 1, "edited row should be re-embedded");
+    ASSERT(neuronos_memory_set_embedder(mem, "fake-v2", FAKE_DIM, fake_embed, NULL) == 0, "re-attach failed");
+    ASSERT(neuronos_memory_embed_flush(mem) == 4, "model change should re-embed all rows");
+
+    ASSERT(neuronos_memory_set_embedder(mem, NULL, 0, NULL, NULL) == 0, "detach failed");
+    ASSERT(neuronos_memory_archival_search(mem, "car", 2, &entries, &count) == 0 && count == 0,
+           "detached search should be FTS5 only");
+    neuronos_memory_archival_free(entries, count);
+
+    neuronos_memory_close(mem);
+    TEST_PASS();
+}
+
+/* ============================================================
+ * TEST 16: Batched writes (begin/commit)
+ * ============================================================ */
+static void test_batched_writes(void) {
+    TEST_START("Batched writes (begin/commit)");
+
+    neuronos_memory_t * mem = neuronos_memory_open(":memory:");
+    ASSERT(mem != NULL, "memory open failed");
+
+    ASSERT(neuronos_memory_commit(mem) == -1, "commit without begin should fail");
+
+    /* Bulk import: 200 facts + 200 recall rows in one transaction */
+    ASSERT(neuronos_memory_begin(mem) == 0, "begin failed");
+    ASSERT(neuronos_memory_begin(mem) == 0, "nested begin failed");
+    for (int i = 0; i < 200; i++) {
+        char key[32], value[64];
+        snprintf(key, sizeof(key), "fact_%d", i);
+        snprintf(value, sizeof(value), "Imported fact number %d", i);
+        ASSERT(neuronos_memory_archival_store(mem, key, value, "import", 0.5f) > 0, "store in batch failed");
+        ASSERT(neuronos_memory_recall_add(mem, 1, "user", value, 5) > 0, "recall_add in batch failed");
+    }
+    ASSERT(neuronos_memory_commit(mem) == 0, "inner commit failed");
+
+    /* Still inside the outer transaction: reads see our own writes */
+    char * val = neuronos_memory_archival_recall(mem, "fact_42");
+    ASSERT(val != NULL && strcmp(val, "Imported fact number 42") == 0, "read inside batch failed");
+    free(val);
+    ASSERT(neuronos_memory_commit(mem) == 0, "outer commit failed");
+    ASSERT(neuronos_memory_commit(mem) == -1, "extra commit should fail");
+
+    int facts = 0, msgs = 0;
+    neuronos_memory_archival_stats(mem, &facts);
+    neuronos_memory_recall_stats(mem, 1, &msgs, NULL);
+    ASSERT(facts == 200, "expected 200 facts after commit");
+    ASSERT(msgs == 200, "expected 200 recall rows after commit");
+
+    neuronos_archival_entry_t * entries = NULL;
+    int count = 0;
+    ASSERT(neuronos_memory_archival_search(mem, "imported", 5, &entries, &count) == 0 && count == 5,
+           "search after batch failed");
+    neuronos_memory_archival_free(entries, count);
+
+    /* Cached statements are re-bound per call: an update after the batch */
+    ASSERT(neuronos_memory_archival_store(mem, "fact_0", "Updated", "import", 0.9f) > 0, "update failed");
+    val = neuronos_memory_archival_recall(mem, "fact_0");
+    ASSERT(val != NULL && strcmp(val, "Updated") == 0, "update not visible");
+    free(val);
+
+    neuronos_memory_close(mem);
+    TEST_PASS();
+}
+
+/* ============================================================
+ * TEST 17: Write-behind queue
+ * ============================================================ */
+#define WB_TEST_DB "neuronos_test_wb.db"
+
+static void wb_test_remove(void) {
+    remove(WB_TEST_DB);
+    remove(WB_TEST_DB "-wal");
+    remove(WB_TEST_DB "-shm");
+}
+
+static void test_write_behind(void) {
+    TEST_START("Write-behind queue");
+
+    neuronos_memory_t * mem = neuronos_memory_open(":memory:");
+    ASSERT(mem != NULL, "memory open failed");
+    ASSERT(neuronos_memory_set_write_behind(mem, 64) == -1, "in-memory DB has no second connection");
+    neuronos_memory_close(mem);
+
+    wb_test_remove();
+    mem = neuronos_memory_open(WB_TEST_DB);
+    ASSERT(mem != NULL, "file memory open failed");
+    int64_t sid = neuronos_memory_session_create(mem);
+
+    /* A tiny queue: 100 writes must wait for the writer, not fail */
+    ASSERT(neuronos_memory_set_write_behind(mem, 8) == 0, "set_write_behind failed");
+    int64_t prev = 0;
+    for (int i = 0; i < 100; i++) {
+        char msg[64];
+        snprintf(msg, sizeof(msg), "Queued message %d", i);
+        int64_t id = neuronos_memory_recall_add(mem, sid, "user", msg, 3);
+        ASSERT(id > prev, "queued add should return its reserved, increasing row id");
+        prev = id;
+    }
+
+    /* Read-your-writes: recall reads wait for the queue */
+    int msgs = 0;
+    neuronos_memory_recall_stats(mem, sid, &msgs, NULL);
+    ASSERT(msgs == 100, "stats should see all queued messages");
+
+    /* A summary queued behind the message it covers links to its row */
+    int64_t sum_id = neuronos_memory_recall_add_summary(mem, sid, "Summary of the queued messages.", 6, prev);
+    ASSERT(sum_id > prev, "queued summary should get a row id");
+    neuronos_recall_entry_t * recent = NULL;
+    int n_recent = 0;
+    ASSERT(neuronos_memory_recall_recent(mem, sid, 101, &recent, &n_recent) == 0 && n_recent == 101,
+           "recall_recent failed");
+    bool linked = false, found_last = false;
+    for (int i = 0; i < n_recent; i++) {
+        if (recent[i].id == sum_id)
+            linked = recent[i].summary_of == prev && strcmp(recent[i].role, "system") == 0;
+        if (recent[i].id == prev)
+            found_last = strcmp(recent[i].content, "Queued message 99") == 0;
+    }
+    neuronos_memory_recall_free(recent, n_recent);
+    ASSERT(linked && found_last, "summary_of should name the summarized row");
+
+    /* Access-count bumps are queued and folded */
+    ASSERT(neuronos_memory_archival_store(mem, "wb_key", "write behind value", "test", 0.5f) > 0, "store failed");
+    for (int i = 0; i < 5; i++) {
+        char * val = neuronos_memory_archival_recall(mem, "wb_key");
+        ASSERT(val != NULL && strcmp(val, "write behind value") == 0, "recall through write-behind failed");
+        free(val);
+    }
+    ASSERT(neuronos_memory_flush(mem) == 0, "flush failed");
+    neuronos_archival_entry_t * entries = NULL;
+    int count = 0;
+    neuronos_memory_archival_search(mem, "behind", 1, &entries, &count);
+    ASSERT(count == 1 && entries[0].access_count == 5, "expected 5 folded access-count bumps");
+    neuronos_memory_archival_free(entries, count);
+
+    ASSERT(neuronos_memory_recall_gc(mem, sid, 10, 0) == 0, "queued gc should return 0");
+    neuronos_memory_recall_stats(mem, sid, &msgs, NULL);
+    ASSERT(msgs == 10, "gc should keep 10 messages");
+
+    /* begin/commit only track nesting while the writer runs */
+    ASSERT(neuronos_memory_begin(mem) == 0, "begin failed");
+    ASSERT(neuronos_memory_set_write_behind(mem, 0) == -1, "cannot switch mode inside begin/commit");
+    ASSERT(neuronos_memory_commit(mem) == 0, "commit failed");
+    ASSERT(neuronos_memory_commit(mem) == -1, "extra commit should fail");
+
+    /* close flushes what is still queued */
+    for (int i = 0; i < 20; i++) {
+        neuronos_memory_recall_add(mem, sid, "assistant", "Flushed on close", 3);
+    }
+    neuronos_memory_close(mem);
+
+    mem = neuronos_memory_open(WB_TEST_DB);
+    ASSERT(mem != NULL, "reopen failed");
+    neuronos_memory_recall_stats(mem, sid, &msgs, NULL);
+    ASSERT(msgs == 30, "queued writes lost on close");
+    /* Ids reserved but never used are not handed out again */
+    ASSERT(neuronos_memory_recall_add(mem, sid, "user", "Direct insert", 2) > sum_id, "reserved id reused");
+    neuronos_memory_close(mem);
+    wb_test_remove();
+    TEST_PASS();
+}
+
+/* ============================================================
+ * TEST 18: Core memory generation
+ * ============================================================ */
+static void test_core_generation(void) {
+    TEST_START("Core memory generation");
+
+    neuronos_memory_t * mem = neuronos_memory_open(":memory:");
+    ASSERT(mem != NULL, "memory open failed");
+
+    uint64_t g0 = neuronos_memory_core_generation(mem);
+    neuronos_memory_core_set(mem, "persona", "I am helpful.");
+    uint64_t g1 = neuronos_memory_core_generation(mem);
+    ASSERT(g1 != g0, "core_set should bump the generation");
+
+    neuronos_memory_core_append(mem, "persona", "I like C.");
+    uint64_t g2 = neuronos_memory_core_generation(mem);
+    ASSERT(g2 != g1, "core_append should bump the generation");
+
+    /* Other tiers leave the cached core dump valid */
+    neuronos_memory_recall_add(mem, 1, "user", "hello", 1);
+    neuronos_memory_archival_store(mem, "k", "v", NULL, 0.5f);
+    char * val = neuronos_memory_core_get(mem, "persona");
+    free(val);
+    ASSERT(neuronos_memory_core_generation(mem) == g2, "non-core writes should not bump the generation");
+
+    neuronos_memory_close(mem);
+    TEST_PASS();
+}
+
 int main(void) {
     fprintf(stderr, "═══════════════════════════════════════════\n");
     fprintf(stderr, " NeuronOS Memory Test Suite\n");
@@ -398,6 +727,12 @@ int main(void) {
     test_recall_stats();
     test_sessions();
     test_legacy_api();
+    test_memory_metrics();
+    test_recall_summary();
+    test_hybrid_search();
+    test_batched_writes();
+    test_write_behind();
+    test_core_generation();
 
     fprintf(stderr, "\n═══════════════════════════════════════════\n");
     fprintf(stderr, " Results: %d/%d passed", tests_passed, tests_run);
@@ -0,0 +1,572 @@
+/* ============================================================
+ * NeuronOS — HTTP Server Loopback Test Suite
+ *
+ * Tests (server on 127.0.0.1, ephemeral port):
+ *  1. Keep-alive: several requests on one connection, then close
+ *  2. Pipelining: requests sent in one write answered in order
+ *  3. Oversized body refused with 413 before it is sent
+ *  4. /health answered while a generation is streaming   (model)
+ *  5. Queue full: 503 with Retry-After                    (model)
+ *  6. Per-client limit: 429 with Retry-After              (model)
+ *
+ * Usage: ./test_server [path-to-gguf-model]
+ * ============================================================ */
+#include "neuronos/neuronos.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+typedef SOCKET test_sock_t;
+#define TEST_BAD_SOCK INVALID_SOCKET
+#define test_close_sock closesocket
+#define test_sleep_ms(ms) Sleep(ms)
+typedef HANDLE test_thread_t;
+#define test_thread_start(t, fn, arg) ((*(t) = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)(fn), (arg), 0, NULL)) != NULL)
+#define test_thread_join(t) (WaitForSingleObject((t), INFINITE), CloseHandle(t))
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+typedef int test_sock_t;
+#define TEST_BAD_SOCK (-1)
+#define test_close_sock close
+#define test_sleep_ms(ms) usleep((useconds_t)(ms) * 1000)
+typedef pthread_t test_thread_t;
+#define test_thread_start(t, fn, arg) (pthread_create((t), NULL, (void * (*)(void *))(fn), (arg)) == 0)
+#define test_thread_join(t) pthread_join((t), NULL)
+#endif
+
+/* ---- Helpers ---- */
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_START(name)                                                                                               \
+    do {                                                                                                               \
+        tests_run++;                                                                                                   \
+        fprintf(stderr, "\n[TEST %d] %s... ", tests_run, name);                                                        \
+    } while (0)
+
+#define TEST_PASS()                                                                                                    \
+    do {                                                                                                               \
+        tests_passed++;                                                                                                \
+        fprintf(stderr, "PASS ✓\n");                                                                                   \
+    } while (0)
+
+#define TEST_FAIL(msg)                                                                                                 \
+    do {                                                                                                               \
+        tests_failed++;                                                                                                \
+        fprintf(stderr, "FAIL ✗ (%s)\n", msg);                                                                         \
+    } while (0)
+
+/* The client sockets are closed by the caller after a failed check */
+#define ASSERT(cond, msg)                                                                                              \
+    do {                                                                                                               \
+        if (!(cond)) {                                                                                                 \
+            TEST_FAIL(msg);                                                                                            \
+            goto done;                                                                                                 \
+        }                                                                                                              \
+    } while (0)
+
+/* ---- Globals ---- */
+static const char * g_model_path = NULL;
+static neuronos_engine_t * g_engine = NULL;
+static neuronos_model_t * g_model = NULL;
+
+/* ============================================================
+ * Server lifecycle: neuronos_server_start() blocks, so it runs
+ * on its own thread and is stopped with neuronos_server_stop().
+ * ============================================================ */
+typedef struct {
+    neuronos_model_t * model;
+    neuronos_server_params_t params;
+    test_thread_t thread;
+    neuronos_status_t status;
+} test_server_t;
+
+static void * server_main(void * arg) {
+    test_server_t * srv = arg;
+    srv->status = neuronos_server_start(srv->model, NULL, srv->params);
+    return NULL;
+}
+
+/* A port the kernel considers free right now */
+static int free_port(void) {
+    test_sock_t fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd == TEST_BAD_SOCK)
+        return 0;
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    int port = 0;
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0 && getsockname(fd, (struct sockaddr *)&addr, &len) == 0)
+        port = ntohs(addr.sin_port);
+    test_close_sock(fd);
+    return port;
+}
+
+static test_sock_t cli_connect(int port) {
+    test_sock_t fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd == TEST_BAD_SOCK)
+        return TEST_BAD_SOCK;
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        test_close_sock(fd);
+        return TEST_BAD_SOCK;
+    }
+    /* A hung server fails the test instead of hanging it */
+#ifdef _WIN32
+    DWORD tv = 20000;
+#else
+    struct timeval tv = {.tv_sec = 20, .tv_usec = 0};
+#endif
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, (const char *)&tv, sizeof(tv));
+    return fd;
+}
+
+static bool server_begin(test_server_t * srv, neuronos_model_t * model, int n_slots, int max_queue,
+                         int max_per_client) {
+    memset(srv, 0, sizeof(*srv));
+    srv->model = model;
+    srv->params.host = "127.0.0.1";
+    srv->params.port = free_port();
+    srv->params.n_slots = n_slots;
+    srv->params.cache_mb = -1;
+    srv->params.max_queue = max_queue;
+    srv->params.max_per_client = max_per_client;
+    if (srv->params.port <= 0 || !test_thread_start(&srv->thread, server_main, srv))
+        return false;
+    for (int i = 0; i < 200; i++) {
+        test_sock_t fd = cli_connect(srv->params.port);
+        if (fd != TEST_BAD_SOCK) {
+            test_close_sock(fd);
+            return true;
+        }
+        test_sleep_ms(25);
+    }
+    neuronos_server_stop();
+    test_thread_join(srv->thread);
+    return false;
+}
+
+static void server_end(test_server_t * srv) {
+    neuronos_server_stop();
+    test_thread_join(srv->thread);
+}
+
+/* ---- Minimal HTTP/1.1 client with a carry-over buffer for pipelining ---- */
+typedef struct {
+    test_sock_t fd;
+    char buf[65536];
+    int len;
+} test_conn_t;
+
+typedef struct {
+    int status;
+    char head[4096];
+    char body[8192];
+    bool chunked;
+} test_resp_t;
+
+static bool cli_send(test_conn_t * c, const char * data) {
+    size_t n = strlen(data), off = 0;
+    while (off < n) {
+        int w = (int)send(c->fd, data + off, (int)(n - off), 0);
+        if (w <= 0)
+            return false;
+        off += (size_t)w;
+    }
+    return true;
+}
+
+/* Read more bytes into the buffer; false on EOF, error or timeout */
+static bool cli_fill(test_conn_t * c) {
+    if (c->len >= (int)sizeof(c->buf) - 1)
+        return false;
+    int r = (int)recv(c->fd, c->buf + c->len, (int)(sizeof(c->buf) - 1 - c->len), 0);
+    if (r <= 0)
+        return false;
+    c->len += r;
+    c->buf[c->len] = '\0';
+    return true;
+}
+
+static void cli_consume(test_conn_t * c, int n) {
+    memmove(c->buf, c->buf + n, (size_t)(c->len - n));
+    c->len -= n;
+    c->buf[c->len] = '\0';
+}
+
+/* Read the status line and headers. Content-Length bodies are read
+ * whole; chunked (streaming) bodies are left in the buffer. */
+static bool cli_read_response(test_conn_t * c, test_resp_t * resp) {
+    memset(resp, 0, sizeof(*resp));
+    char * end;
+    while (!(end = strstr(c->buf, "\r\n\r\n")))
+        if (!cli_fill(c))
+            return false;
+    int head_len = (int)(end - c->buf) + 4;
+    if (head_len >= (int)sizeof(resp->head))
+        return false;
+    memcpy(resp->head, c->buf, (size_t)head_len);
+    resp->head[head_len] = '\0';
+    cli_consume(c, head_len);
+    if (sscanf(resp->head, "HTTP/1.1 %d", &resp->status) != 1)
+        return false;
+    if (strstr(resp->head, "Transfer-Encoding: chunked")) {
+        resp->chunked = true;
+        return true;
+    }
+    const char * cl = strstr(resp->head, "Content-Length:");
+    int body_len = cl ? atoi(cl + 15) : 0;
+    if (body_len >= (int)sizeof(resp->body))
+        return false;
+    while (c->len < body_len)
+        if (!cli_fill(c))
+            return false;
+    memcpy(resp->body, c->buf, (size_t)body_len);
+    resp->body[body_len] = '\0';
+    cli_consume(c, body_len);
+    return true;
+}
+
+/* True once the server has closed its side */
+static bool cli_at_eof(test_conn_t * c) {
+    char b;
+    return recv(c->fd, &b, 1, 0) == 0;
+}
+
+static void cli_close(test_conn_t * c) {
+    if (c->fd != TEST_BAD_SOCK)
+        test_close_sock(c->fd);
+    c->fd = TEST_BAD_SOCK;
+}
+
+static bool cli_open(test_conn_t * c, int port) {
+    c->len = 0;
+    c->buf[0] = '\0';
+    c->fd = cli_connect(port);
+    return c->fd != TEST_BAD_SOCK;
+}
+
+#define GET(path) "GET " path " HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n"
+
+/* A streaming chat request long enough to still be running when the
+ * next request arrives. */
+static void chat_request(char * out, size_t cap, bool stream) {
+    const char * body = stream ? "{\"messages\":[{\"role\":\"user\",\"content\":\"Count from 1 to 500, one number "
+                                 "per line.\"}],\"max_tokens\":256,\"stream\":true}"
+                               : "{\"messages\":[{\"role\":\"user\",\"content\":\"Say hi.\"}],\"max_tokens\":8}";
+    snprintf(out, cap,
+             "POST /v1/chat/completions HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+             "Content-Type: application/json\r\nContent-Length: %zu\r\n\r\n%s",
+             strlen(body), body);
+}
+
+/* Send a streaming chat request and wait for its first SSE event, so
+ * the request is known to occupy a slot. */
+static bool start_stream(test_conn_t * c, int port) {
+    char req[1024];
+    chat_request(req, sizeof(req), true);
+    test_resp_t resp;
+    if (!cli_open(c, port) || !cli_send(c, req) || !cli_read_response(c, &resp) || resp.status != 200)
+        return false;
+    while (!strstr(c->buf, "data:"))
+        if (!cli_fill(c))
+            return false;
+    return true;
+}
+
+/* ============================================================
+ * TEST 1: Keep-alive
+ * ============================================================ */
+static void test_keep_alive(int port) {
+    TEST_START("Keep-alive");
+    test_conn_t * c = calloc(1, sizeof(*c));
+    test_resp_t resp;
+    ASSERT(c && cli_open(c, port), "connect failed");
+
+    for (int i = 0; i < 3; i++) {
+        ASSERT(cli_send(c, GET("/health")), "send failed");
+        ASSERT(cli_read_response(c, &resp), "no response on the reused connection");
+        ASSERT(resp.status == 200, "health status");
+        ASSERT(strstr(resp.head, "Connection: keep-alive"), "connection not kept alive");
+        ASSERT(strstr(resp.body, "\"status\":\"ok\""), "health body");
+    }
+
+    /* Connection: close is honoured after the response */
+    ASSERT(cli_send(c, "GET /v1/models HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: close\r\n\r\n"), "send failed");
+    ASSERT(cli_read_response(c, &resp), "no response");
+    ASSERT(resp.status == 200, "models status");
+    ASSERT(strstr(resp.head, "Connection: close"), "close not echoed");
+    ASSERT(cli_at_eof(c), "connection left open after Connection: close");
+
+    TEST_PASS();
+done:
+    if (c)
+        cli_close(c);
+    free(c);
+}
+
+/* ============================================================
+ * TEST 2: Pipelining
+ * ============================================================ */
+static void test_pipelining(int port) {
+    TEST_START("Pipelining");
+    test_conn_t * c = calloc(1, sizeof(*c));
+    test_resp_t resp;
+    ASSERT(c && cli_open(c, port), "connect failed");
+
+    /* One write, three requests: responses must come back in order */
+    ASSERT(cli_send(c, GET("/health") GET("/v1/models") GET("/no-such-path")), "send failed");
+    ASSERT(cli_read_response(c, &resp) && resp.status == 200, "1st pipelined response");
+    ASSERT(strstr(resp.body, "\"status\":\"ok\""), "1st response is not /health");
+    ASSERT(cli_read_response(c, &resp) && resp.status == 200, "2nd pipelined response");
+    ASSERT(strstr(resp.body, "neuronos-local"), "2nd response is not /v1/models");
+    ASSERT(cli_read_response(c, &resp) && resp.status == 404, "3rd pipelined response");
+
+    /* A request split across writes is reassembled */
+    ASSERT(cli_send(c, "GET /hea"), "send failed");
+    test_sleep_ms(50);
+    ASSERT(cli_send(c, "lth HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n"), "send failed");
+    ASSERT(cli_read_response(c, &resp) && resp.status == 200, "split request");
+
+    TEST_PASS();
+done:
+    if (c)
+        cli_close(c);
+    free(c);
+}
+
+/* ============================================================
+ * TEST 3: 413 for an oversized body, refused from the headers
+ * ============================================================ */
+static void test_too_large(int port) {
+    TEST_START("413 Request too large");
+    test_conn_t * c = calloc(1, sizeof(*c));
+    test_resp_t resp;
+    ASSERT(c && cli_open(c, port), "connect failed");
+
+    ASSERT(cli_send(c, "POST /v1/completions HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                       "Content-Type: application/json\r\nContent-Length: 1073741824\r\n\r\n"),
+           "send failed");
+    ASSERT(cli_read_response(c, &resp), "no response");
+    ASSERT(resp.status == 413, "expected 413");
+    ASSERT(cli_at_eof(c), "connection left open after 413");
+    cli_close(c);
+
+    /* The server is still serving */
+    ASSERT(cli_open(c, port), "reconnect failed");
+    ASSERT(cli_send(c, GET("/health")) && cli_read_response(c, &resp) && resp.status == 200, "health after 413");
+
+    TEST_PASS();
+done:
+    if (c)
+        cli_close(c);
+    free(c);
+}
+
+/* ============================================================
+ * TEST 4: /health while a generation streams
+ * ============================================================ */
+static void test_health_during_stream(int port) {
+    TEST_START("/health during streaming generation");
+    if (!g_model) {
+        fprintf(stderr, "SKIP (no model)\n");
+        tests_passed++;
+        return;
+    }
+    test_conn_t * a = calloc(1, sizeof(*a));
+    test_conn_t * h = calloc(1, sizeof(*h));
+    test_resp_t resp;
+    ASSERT(a && h, "alloc");
+    a->fd = h->fd = TEST_BAD_SOCK;
+    ASSERT(start_stream(a, port), "streaming request did not start");
+    ASSERT(!strstr(a->buf, "[DONE]"), "generation finished before the probe");
+
+    /* The event loop answers without waiting on the inference thread */
+    ASSERT(cli_open(h, port), "connect failed");
+    ASSERT(cli_send(h, GET("/health")), "send failed");
+    ASSERT(cli_read_response(h, &resp) && resp.status == 200, "health during stream");
+
+    /* ...and the stream runs to completion afterwards */
+    while (!strstr(a->buf, "[DONE]")) {
+        if (a->len > (int)sizeof(a->buf) / 2)
+            cli_consume(a, a->len - 16); /* keep a tail that may hold a split marker */
+        ASSERT(cli_fill(a), "stream ended without [DONE]");
+    }
+
+    TEST_PASS();
+done:
+    if (a)
+        cli_close(a);
+    if (h)
+        cli_close(h);
+    free(a);
+    free(h);
+}
+
+/* ============================================================
+ * TEST 5: 503 when the slot and the queue are both taken
+ * ============================================================ */
+static void test_queue_full(void) {
+    TEST_START("503 when the queue is full");
+    if (!g_model) {
+        fprintf(stderr, "SKIP (no model)\n");
+        tests_passed++;
+        return;
+    }
+    test_server_t srv;
+    test_conn_t * c[3] = {calloc(1, sizeof(test_conn_t)), calloc(1, sizeof(test_conn_t)), calloc(1, sizeof(test_conn_t))};
+    test_resp_t resp;
+    char req[1024];
+    bool started = false;
+    for (int i = 0; i < 3; i++)
+        if (c[i])
+            c[i]->fd = TEST_BAD_SOCK;
+    ASSERT(c[0] && c[1] && c[2], "alloc");
+
+    /* One slot, one queued request: the third is shed */
+    ASSERT(server_begin(&srv, g_model, 1, 1, 0), "server did not start");
+    started = true;
+    ASSERT(start_stream(c[0], srv.params.port), "first request did not start");
+    chat_request(req, sizeof(req), false);
+    ASSERT(cli_open(c[1], srv.params.port) && cli_send(c[1], req), "second request");
+    test_sleep_ms(200); /* let the loop queue it */
+    ASSERT(cli_open(c[2], srv.params.port) && cli_send(c[2], req), "third request");
+    ASSERT(cli_read_response(c[2], &resp), "no response to the third request");
+    ASSERT(resp.status == 503, "expected 503");
+    ASSERT(strstr(resp.head, "Retry-After:"), "503 without Retry-After");
+
+    /* The queued request is still served */
+    ASSERT(cli_read_response(c[1], &resp) && resp.status == 200, "queued request not served");
+
+    TEST_PASS();
+done:
+    for (int i = 0; i < 3; i++) {
+        if (c[i])
+            cli_close(c[i]);
+        free(c[i]);
+    }
+    if (started)
+        server_end(&srv);
+}
+
+/* ============================================================
+ * TEST 6: 429 past the per-client limit
+ * ============================================================ */
+static void test_per_client_limit(void) {
+    TEST_START("429 past the per-client limit");
+    if (!g_model) {
+        fprintf(stderr, "SKIP (no model)\n");
+        tests_passed++;
+        return;
+    }
+    test_server_t srv;
+    test_conn_t * a = calloc(1, sizeof(*a));
+    test_conn_t * b = calloc(1, sizeof(*b));
+    test_resp_t resp;
+    char req[1024];
+    bool started = false;
+    if (a)
+        a->fd = TEST_BAD_SOCK;
+    if (b)
+        b->fd = TEST_BAD_SOCK;
+    ASSERT(a && b, "alloc");
+
+    ASSERT(server_begin(&srv, g_model, 2, 0, 1), "server did not start");
+    started = true;
+    ASSERT(start_stream(a, srv.params.port), "first request did not start");
+    chat_request(req, sizeof(req), false);
+    ASSERT(cli_open(b, srv.params.port) && cli_send(b, req), "second request");
+    ASSERT(cli_read_response(b, &resp), "no response to the second request");
+    ASSERT(resp.status == 429, "expected 429");
+    ASSERT(strstr(resp.head, "Retry-After:"), "429 without Retry-After");
+
+    /* Cheap endpoints are not counted against the client */
+    cli_close(b);
+    ASSERT(cli_open(b, srv.params.port) && cli_send(b, GET("/health")), "health request");
+    ASSERT(cli_read_response(b, &resp) && resp.status == 200, "health refused");
+
+    TEST_PASS();
+done:
+    if (a)
+        cli_close(a);
+    if (b)
+        cli_close(b);
+    free(a);
+    free(b);
+    if (started)
+        server_end(&srv);
+}
+
+int main(int argc, char * argv[]) {
+    fprintf(stderr, "═══════════════════════════════════════════\n");
+    fprintf(stderr, "  NeuronOS Server Loopback Test Suite\n");
+    fprintf(stderr, "═══════════════════════════════════════════\n");
+
+#ifdef _WIN32
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+
+    if (argc > 1) {
+        g_model_path = argv[1];
+        fprintf(stderr, "Model: %s\n", g_model_path);
+        neuronos_engine_params_t eparams = {.n_threads = 4};
+        g_engine = neuronos_init(eparams);
+        neuronos_model_params_t mparams = {
+            .model_path = g_model_path,
+            .context_size = 2048,
+            .use_mmap = true,
+        };
+        g_model = g_engine ? neuronos_model_load(g_engine, mparams) : NULL;
+        if (!g_model)
+            fprintf(stderr, "  (model load failed — inference tests skipped)\n");
+    } else {
+        fprintf(stderr, "Usage: %s [model.gguf]\n", argv[0]);
+        fprintf(stderr, "  (running without model — inference tests skipped)\n");
+    }
+
+    test_server_t srv;
+    if (!server_begin(&srv, g_model, 2, 0, 0)) {
+        fprintf(stderr, "Cannot start the server\n");
+        return 1;
+    }
+    test_keep_alive(srv.params.port);
+    test_pipelining(srv.params.port);
+    test_too_large(srv.params.port);
+    test_health_during_stream(srv.params.port);
+    server_end(&srv);
+
+    /* These restart the server with their own admission limits */
+    test_queue_full();
+    test_per_client_limit();
+
+    if (g_model)
+        neuronos_model_free(g_model);
+    if (g_engine)
+        neuronos_shutdown(g_engine);
+
+    /* Summary */
+    fprintf(stderr, "\n═══════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d/%d passed", tests_passed, tests_run);
+    if (tests_failed > 0) {
+        fprintf(stderr, " (%d FAILED)", tests_failed);
+    }
+    fprintf(stderr, "\n═══════════════════════════════════════════\n");
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -8,6 +8,7 @@
 #   ./build_wasm.sh              # Multi-thread + single-thread builds
 #   ./build_wasm.sh --st-only    # Single-thread build only
 #   ./build_wasm.sh --mt-only    # Multi-thread build only
+#   ./build_wasm.sh --no-relaxed # Skip the relaxed-SIMD variants
 #   ./build_wasm.sh --clean      # Clean and rebuild
 #
 # Prerequisites:
@@ -20,6 +21,7 @@
 #   dist/neuronos-worker.worker.js
 #   dist/neuronos-worker-st.js    (single-thread)
 #   dist/neuronos-worker-st.wasm
+#   dist/neuronos-worker[-st]-relaxed.{js,wasm} (relaxed-SIMD kernels)
 #   dist/neuronos-web.js          (JS API)
 #   dist/neuronos-inference-worker.js
 #   dist/playground.html
@@ -33,6 +35,7 @@ BITNET_DIR="$(dirname "$NEURONOS_DIR")"
 DIST_DIR="$WASM_DIR/dist"
 BUILD_MT="$WASM_DIR/build-wasm-mt"
 BUILD_ST="$WASM_DIR/build-wasm-st"
+BUILD_RELAXED="$WASM_DIR/build-wasm-relaxed"
 
 # Colors
 RED='\033[0;31m'
@@ -49,15 +52,17 @@ error()   { echo -e "${RED}[ERROR]${NC} $1"; exit 1; }
 # ── Parse arguments ──
 BUILD_MULTITHREAD=true
 BUILD_SINGLETHREAD=true
+BUILD_RELAXED_SIMD=true
 CLEAN=false
 
 for arg in "$@"; do
   case "$arg" in
     --st-only) BUILD_MULTITHREAD=false ;;
     --mt-only) BUILD_SINGLETHREAD=false ;;
+    --no-relaxed) BUILD_RELAXED_SIMD=false ;;
     --clean)   CLEAN=true ;;
     --help|-h)
-      echo "Usage: $0 [--st-only|--mt-only|--clean|--help]"
+      echo "Usage: $0 [--st-only|--mt-only|--no-relaxed|--clean|--help]"
       exit 0
       ;;
     *) error "Unknown argument: $arg" ;;
@@ -89,7 +94,7 @@ success "Found: $CMAKE_VERSION"
 # ── Clean if requested ──
 if $CLEAN; then
   info "Cleaning previous builds..."
-  rm -rf "$BUILD_MT" "$BUILD_ST" "$DIST_DIR"
+  rm -rf "$BUILD_MT" "$BUILD_ST" "$BUILD_RELAXED"-* "$DIST_DIR"
   success "Clean done"
 fi
 
@@ -161,6 +166,33 @@ if $BUILD_SINGLETHREAD; then
   fi
 fi
 
+# ── Relaxed-SIMD builds ──
+# Same sources with -mrelaxed-simd. The worker loads these when the browser
+# validates relaxed-SIMD and falls back to the plain builds otherwise.
+build_relaxed() {
+  local threads="$1" name="$2"
+  echo ""
+  info "Building NeuronOS WASM (${name}, relaxed-SIMD)"
+  mkdir -p "$BUILD_RELAXED-$threads"
+  pushd "$BUILD_RELAXED-$threads" > /dev/null
+  emcmake cmake "$WASM_DIR" \
+    -DCMAKE_BUILD_TYPE=Release \
+    -DNEURONOS_WASM_THREADS="$threads" \
+    -DNEURONOS_WASM_RELAXED_SIMD=ON
+  emmake make -j$(nproc) 2>&1 | tail -5
+  popd > /dev/null
+  if [[ -f "$DIST_DIR/$name.wasm" ]]; then
+    success "Relaxed-SIMD build: $(du -h "$DIST_DIR/$name.wasm" | cut -f1)"
+  else
+    warn "Relaxed-SIMD build output not found: $name"
+  fi
+}
+
+if $BUILD_RELAXED_SIMD; then
+  if $BUILD_MULTITHREAD; then build_relaxed ON neuronos-worker-relaxed; fi
+  if $BUILD_SINGLETHREAD; then build_relaxed OFF neuronos-worker-st-relaxed; fi
+fi
+
 # ── Copy JS & HTML assets ──
 echo ""
 info "Copying JS and HTML assets..."
@@ -23,7 +23,7 @@ let moduleReady = false;
 
 // WASM function wrappers (set after module initialization)
 let _wasm_init = null;
-let _wasm_load_model = null;
+let _wasm_load_model_path = null;
 let _wasm_generate = null;
 let _wasm_agent_chat = null;
 let _wasm_model_info = null;
@@ -33,13 +33,69 @@ let _wasm_memory_search = null;
 let _wasm_free = null;
 let _wasm_free_string = null;
 
+/**
+ * Detect the WASM SIMD features this engine validates.
+ * Each probe is a one-function module using a single instruction of the
+ * feature (i8x16.popcnt for SIMD128, i8x16.relaxed_swizzle for relaxed-SIMD).
+ */
+function detectWasmFeatures() {
+  const probe = (bytes) => {
+    try {
+      return WebAssembly.validate(new Uint8Array(bytes));
+    } catch {
+      return false;
+    }
+  };
+  return {
+    simd: probe([0,97,115,109,1,0,0,0,1,5,1,96,0,1,123,3,2,1,0,10,10,1,8,0,65,0,253,15,253,98,11]),
+    relaxedSimd: probe([0,97,115,109,1,0,0,0,1,5,1,96,0,1,123,3,2,1,0,10,15,1,13,0,65,1,253,15,65,2,253,15,253,128,2,11]),
+  };
+}
+
+/**
+ * Pick the module build for this engine: the `-relaxed` variant of
+ * wasmPath when relaxed-SIMD validates, else wasmPath itself.
+ * Every build needs SIMD128, so engines without it are rejected up front.
+ */
+function selectWasmBuild(wasmPath, features) {
+  if (!features.simd) {
+    throw new Error('This browser lacks WebAssembly SIMD (Chrome 91+, Firefox 89+, Safari 16.4+)');
+  }
+  const candidates = [];
+  if (features.relaxedSimd) {
+    candidates.push(wasmPath.replace(/\.js$/, '-relaxed.js'));
+  }
+  candidates.push(wasmPath);
+  return candidates;
+}
+
 /**
  * Initialize the WASM module.
  */
 async function initModule(wasmPath) {
-  // Import and instantiate the Emscripten-generated module
-  // The module file exports a factory function called NeuronOSModule
-  importScripts(wasmPath);
+  const features = detectWasmFeatures();
+
+  // Import the Emscripten-generated module: it defines a factory function
+  // called NeuronOSModule. A relaxed build may not be deployed, so fall
+  // back to the next candidate when the import fails.
+  const candidates = selectWasmBuild(wasmPath, features);
+  let lastError = null;
+  for (const candidate of candidates) {
+    try {
+      importScripts(candidate);
+      wasmPath = candidate;
+      lastError = null;
+      break;
+    } catch (err) {
+      lastError = err;
+    }
+  }
+  if (lastError) throw lastError;
+
+  postMessage({
+    type: 'status',
+    text: `WASM kernels: ${wasmPath.endsWith('-relaxed.js') ? 'relaxed-SIMD' : 'SIMD128'}`,
+  });
 
   Module = await NeuronOSModule({
     // Emscripten module configuration
@@ -61,8 +117,8 @@ async function initModule(wasmPath) {
   // Create wrapped C functions matching neuronos_wasm_glue.c signatures
   _wasm_init = Module.cwrap('neuronos_wasm_init', 'number',
     ['number', 'number']);  // (n_threads, n_ctx)
-  _wasm_load_model = Module.cwrap('neuronos_wasm_load_model_from_buffer', 'number',
-    ['number', 'number', 'number']);  // (data_ptr, size, n_ctx)
+  _wasm_load_model_path = Module.cwrap('neuronos_wasm_load_model_from_path', 'number',
+    ['string', 'number']);  // (path, n_ctx)
   _wasm_generate = Module.cwrap('neuronos_wasm_generate', 'number',
     ['string', 'number', 'number']);  // (prompt, n_predict, temp)
   _wasm_agent_chat = Module.cwrap('neuronos_wasm_agent_chat', 'number',
@@ -79,6 +135,34 @@ async function initModule(wasmPath) {
   moduleReady = true;
 }
 
+const MODEL_MOUNT = '/models';
+
+/**
+ * Load a model from Blobs/Files without copying it into the WASM heap.
+ * The parts are mounted read-only with WORKERFS, which serves each read
+ * from the Blob through FileReaderSync: llama.cpp streams tensors from
+ * browser storage (OPFS, HTTP cache, user file) into its own buffers.
+ * files: [{name, blob}], first entry is the model (or split part 1).
+ */
+function loadModelBlobs(files, nCtx) {
+  if (!files || files.length === 0) throw new Error('No model files');
+
+  const FS = Module.FS;
+  try { FS.mkdir(MODEL_MOUNT); } catch { /* exists */ }
+  FS.mount(FS.filesystems.WORKERFS,
+    { blobs: files.map((f) => ({ name: f.name, data: f.blob })) }, MODEL_MOUNT);
+
+  const total = files.reduce((n, f) => n + f.blob.size, 0);
+  postMessage({ type: 'status', text: `Streaming model from storage (${(total / 1024 / 1024).toFixed(0)} MB)...` });
+
+  try {
+    return _wasm_load_model_path(`${MODEL_MOUNT}/${files[0].name}`, nCtx || 2048);
+  } finally {
+    // Tensors now live in llama.cpp buffers; the Blobs are no longer read
+    FS.unmount(MODEL_MOUNT);
+  }
+}
+
 /**
  * Handle commands from the main thread.
  */
@@ -98,21 +182,19 @@ self.onmessage = async function(e) {
         break;
       }
 
+      case 'loadModelBlobs': {
+        const { files, nCtx } = e.data;
+        const ret = loadModelBlobs(files, nCtx);
+        if (ret !== 0) throw new Error(`Model load failed (code ${ret})`);
+        result = 'ok';
+        break;
+      }
+
       case 'loadModel': {
+        // Legacy ArrayBuffer entry point: wrap the bytes in a Blob and
+        // stream them like any other source instead of a heap copy.
         const { buffer, nCtx } = e.data;
-        const bytes = new Uint8Array(buffer);
-
-        // Allocate WASM memory and copy the model buffer
-        const ptr = Module._malloc(bytes.length);
-        if (!ptr) throw new Error('Failed to allocate WASM memory for model');
-
-        Module.HEAPU8.set(bytes, ptr);
-
-        postMessage({ type: 'status', text: `Model buffer in WASM heap (${(bytes.length / 1024 / 1024).toFixed(0)} MB), loading...` });
-
-        const ret = _wasm_load_model(ptr, bytes.length, nCtx || 2048);
-        Module._free(ptr);
-
+        const ret = loadModelBlobs([{ name: 'model.gguf', blob: new Blob([buffer]) }], nCtx);
         if (ret !== 0) throw new Error(`Model load failed (code ${ret})`);
         result = 'ok';
         break;
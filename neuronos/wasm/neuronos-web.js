@@ -9,9 +9,9 @@
  *                    llama.cpp + NeuronOS Agent + SQLite
  *
  * Features:
- *   - Download GGUF model with progress (parallel chunk downloads)
- *   - Cache model in OPFS (Origin Private File System)
- *   - Load model into WASM engine
+ *   - Download GGUF model with progress (split parts in parallel)
+ *   - Cache model in OPFS (Origin Private File System), streamed to disk
+ *   - Load model into WASM engine without buffering it in memory
  *   - Generate text / chat with agent (streaming)
  *   - Persistent memory (SQLite+FTS5 via WASM)
  *   - Auto-detect multi-thread support (SharedArrayBuffer)
@@ -126,6 +126,10 @@ class NeuronOS {
    * Supports split models (automatically detects -00001-of-NNNNN pattern).
    * Uses OPFS caching for subsequent loads.
    *
+   * The model never passes through an ArrayBuffer: downloads stream into
+   * OPFS and the worker reads the disk-backed Files through WORKERFS, so
+   * peak memory is the loaded model itself rather than ~3x its size.
+   *
    * @param {string} url - URL to the GGUF model file
    * @param {object} options - { nCtx, nThreads, forceRedownload }
    */
@@ -135,64 +139,55 @@ class NeuronOS {
     const nCtx = options.nCtx || this._config.nCtx;
     const nThreads = options.nThreads || this._config.nThreads;
 
-    // Check if model is cached in OPFS
-    const cacheKey = this._urlToCacheKey(url);
-    let modelBuffer = null;
-
-    if (this._config.cacheEnabled && !options.forceRedownload) {
-      modelBuffer = await this._loadFromCache(cacheKey);
-      if (modelBuffer) {
-        this._emitStatus('Model loaded from browser cache (OPFS)');
-      }
+    const urls = this._isSplitModel(url) ? this._splitModelUrls(url) : [url];
+    if (urls.length > 1) {
+      this._emitStatus(`Fetching split model (${urls.length} parts)...`);
     }
 
-    // Download if not cached
-    if (!modelBuffer) {
-      const isSplit = this._isSplitModel(url);
-      if (isSplit) {
-        modelBuffer = await this._downloadSplitModel(url);
-      } else {
-        modelBuffer = await this._downloadModel(url);
-      }
-
-      // Cache the downloaded model
-      if (this._config.cacheEnabled && modelBuffer) {
-        await this._saveToCache(cacheKey, modelBuffer);
-        this._emitStatus('Model cached in browser storage (OPFS)');
-      }
-    }
+    // Fetch parts in parallel batches; byte progress is summed over parts
+    const progress = { loaded: 0, total: 0 };
+    const files = [];
+    const batchSize = this._config.maxParallelDownloads;
 
-    if (!modelBuffer) {
-      throw new Error('Failed to download model');
+    for (let i = 0; i < urls.length; i += batchSize) {
+      const batch = urls.slice(i, i + batchSize);
+      const blobs = await Promise.all(
+        batch.map((partUrl) => this._fetchModelBlob(partUrl, progress, options.forceRedownload))
+      );
+      blobs.forEach((blob, idx) => {
+        files.push({ name: this._urlToFileName(batch[idx]), blob });
+      });
     }
 
-    this._emitStatus(`Loading model into engine (${(modelBuffer.byteLength / 1024 / 1024).toFixed(0)} MB)...`);
-
-    // Send model buffer to worker
-    await this._sendCommand('loadModel', {
-      buffer: modelBuffer,
-      nCtx,
-      nThreads,
-    }, [modelBuffer]); // Transfer ownership of the ArrayBuffer
-
-    this._modelLoaded = true;
-    this._emitStatus('Model ready for inference');
+    await this._loadBlobs(files, nCtx, nThreads);
   }
 
   /**
    * Load a GGUF model from a File object (user picks from disk).
+   * Pass every part of a split model as an array of Files.
    */
   async loadModelFromFile(file, options = {}) {
     if (!this._ready) throw new Error('NeuronOS not initialized.');
 
-    this._emitStatus(`Reading file: ${file.name} (${(file.size / 1024 / 1024).toFixed(0)} MB)...`);
-    const buffer = await file.arrayBuffer();
+    // Part 1 of a split model sorts first and names the others
+    const parts = (Array.isArray(file) ? [...file] : [file])
+      .sort((a, b) => a.name.localeCompare(b.name));
+
+    await this._loadBlobs(
+      parts.map((f) => ({ name: f.name || 'model.gguf', blob: f })),
+      options.nCtx || this._config.nCtx,
+      options.nThreads || this._config.nThreads);
+  }
+
+  /**
+   * Hand model Blobs to the worker. Blobs are passed by reference, so
+   * posting them copies no model bytes.
+   */
+  async _loadBlobs(files, nCtx, nThreads) {
+    const size = files.reduce((n, f) => n + f.blob.size, 0);
+    this._emitStatus(`Loading model into engine (${(size / 1024 / 1024).toFixed(0)} MB)...`);
 
-    await this._sendCommand('loadModel', {
-      buffer,
-      nCtx: options.nCtx || this._config.nCtx,
-      nThreads: options.nThreads || this._config.nThreads,
-    }, [buffer]);
+    await this._sendCommand('loadModelBlobs', { files, nCtx, nThreads });
 
     this._modelLoaded = true;
     this._emitStatus('Model ready for inference');
@@ -281,108 +276,95 @@ class NeuronOS {
   }
 
   /* ═══════════════════════════════════════════════════
-   * Model Download (with progress + parallel chunks)
+   * Model Download (streamed to OPFS, with progress)
    * ═══════════════════════════════════════════════════ */
 
-  async _downloadModel(url) {
-    this._emitStatus('Downloading model...');
+  /**
+   * Return a Blob for one model file: the OPFS copy when cached, else a
+   * download streamed straight into OPFS (or into a Blob without OPFS).
+   * progress is shared between parallel parts of a split model.
+   */
+  async _fetchModelBlob(url, progress, forceRedownload) {
+    const key = this._urlToCacheKey(url);
+
+    if (this._config.cacheEnabled && !forceRedownload) {
+      const cached = await this._loadFromCache(key);
+      if (cached) {
+        this._emitStatus('Model loaded from browser cache (OPFS)');
+        return cached;
+      }
+    }
+
+    this._emitStatus(`Downloading ${this._urlToFileName(url)}...`);
 
     const response = await fetch(url);
     if (!response.ok) throw new Error(`Download failed: ${response.status}`);
 
-    const contentLength = parseInt(response.headers.get('Content-Length') || '0', 10);
-    const reader = response.body.getReader();
-    const chunks = [];
-    let received = 0;
-
-    while (true) {
-      const { done, value } = await reader.read();
-      if (done) break;
-      chunks.push(value);
-      received += value.length;
-
-      if (contentLength > 0 && this.onProgress) {
-        this.onProgress({
-          loaded: received,
-          total: contentLength,
-          percent: Math.round((received / contentLength) * 100),
-        });
+    progress.total += parseInt(response.headers.get('Content-Length') || '0', 10);
+    const body = response.body.pipeThrough(this._progressStream(progress));
+
+    if (this._config.cacheEnabled) {
+      const cached = await this._streamToCache(key, body);
+      if (cached) {
+        this._emitStatus('Model cached in browser storage (OPFS)');
+        return cached;
       }
+      // OPFS unavailable: the stream is untouched, fall through
     }
 
-    // Combine chunks into a single ArrayBuffer
-    const buffer = new Uint8Array(received);
-    let offset = 0;
-    for (const chunk of chunks) {
-      buffer.set(chunk, offset);
-      offset += chunk.length;
-    }
+    // Browsers spill large Blobs to disk, so this still avoids a heap copy
+    return new Response(body).blob();
+  }
 
-    return buffer.buffer;
+  /** Pass-through stream that reports byte progress via onProgress */
+  _progressStream(progress) {
+    return new TransformStream({
+      transform: (chunk, controller) => {
+        progress.loaded += chunk.byteLength;
+        if (progress.total > 0 && this.onProgress) {
+          this.onProgress({
+            loaded: progress.loaded,
+            total: progress.total,
+            percent: Math.min(100, Math.round((progress.loaded / progress.total) * 100)),
+          });
+        }
+        controller.enqueue(chunk);
+      },
+    });
   }
 
   /**
-   * Download split model files in parallel.
+   * Expand a split model URL into the URLs of all its parts.
    * Pattern: model-00001-of-00003.gguf, model-00002-of-00003.gguf, etc.
    */
-  async _downloadSplitModel(firstPartUrl) {
+  _splitModelUrls(firstPartUrl) {
     const match = firstPartUrl.match(/(.+)-(\d{5})-of-(\d{5})\.gguf$/);
-    if (!match) return this._downloadModel(firstPartUrl);
+    if (!match) return [firstPartUrl];
 
     const base = match[1];
     const totalParts = parseInt(match[3], 10);
-    this._emitStatus(`Downloading split model (${totalParts} parts)...`);
-
     const urls = [];
     for (let i = 1; i <= totalParts; i++) {
       const padded = String(i).padStart(5, '0');
       const padTotal = String(totalParts).padStart(5, '0');
       urls.push(`${base}-${padded}-of-${padTotal}.gguf`);
     }
-
-    // Download in parallel batches
-    const buffers = [];
-    let totalSize = 0;
-    const batchSize = this._config.maxParallelDownloads;
-
-    for (let i = 0; i < urls.length; i += batchSize) {
-      const batch = urls.slice(i, i + batchSize);
-      const results = await Promise.all(
-        batch.map(async (url, idx) => {
-          const partNum = i + idx + 1;
-          this._emitStatus(`Downloading part ${partNum}/${totalParts}...`);
-          const resp = await fetch(url);
-          if (!resp.ok) throw new Error(`Failed to download part ${partNum}`);
-          return resp.arrayBuffer();
-        })
-      );
-      buffers.push(...results);
-      totalSize += results.reduce((sum, buf) => sum + buf.byteLength, 0);
-
-      if (this.onProgress) {
-        this.onProgress({
-          loaded: buffers.length,
-          total: totalParts,
-          percent: Math.round((buffers.length / totalParts) * 100),
-        });
-      }
-    }
-
-    // Concatenate all parts
-    const combined = new Uint8Array(totalSize);
-    let offset = 0;
-    for (const buf of buffers) {
-      combined.set(new Uint8Array(buf), offset);
-      offset += buf.byteLength;
-    }
-
-    return combined.buffer;
+    return urls;
   }
 
   _isSplitModel(url) {
     return /-\d{5}-of-\d{5}\.gguf$/.test(url);
   }
 
+  /**
+   * File name the worker mounts a download under. Split parts keep their
+   * names, since llama.cpp locates parts 2..N from the name of part 1.
+   */
+  _urlToFileName(url) {
+    const name = url.split(/[?#]/)[0].split('/').pop();
+    return name && name.endsWith('.gguf') ? name : 'model.gguf';
+  }
+
   /* ═══════════════════════════════════════════════════
    * OPFS Caching
    * ═══════════════════════════════════════════════════ */
@@ -393,32 +375,51 @@ class NeuronOS {
     return `neuronos_model_${Math.abs(hash).toString(36)}`;
   }
 
+  _hasOPFS() {
+    return 'storage' in navigator && 'getDirectory' in navigator.storage;
+  }
+
+  /** Returns the cached model as a disk-backed File, or null */
   async _loadFromCache(key) {
     try {
-      if (!('storage' in navigator && 'getDirectory' in navigator.storage)) return null;
+      if (!this._hasOPFS()) return null;
       const root = await navigator.storage.getDirectory();
       const dirHandle = await root.getDirectoryHandle('neuronos-cache', { create: false });
       const fileHandle = await dirHandle.getFileHandle(key, { create: false });
       const file = await fileHandle.getFile();
-      this._emitStatus(`Loading cached model (${(file.size / 1024 / 1024).toFixed(0)} MB)...`);
-      return await file.arrayBuffer();
+      this._emitStatus(`Found cached model (${(file.size / 1024 / 1024).toFixed(0)} MB)`);
+      return file;
     } catch {
       return null; // Not cached
     }
   }
 
-  async _saveToCache(key, buffer) {
+  /**
+   * Pipe a download into OPFS and return the stored File.
+   * A writable only commits on close, so an interrupted download never
+   * leaves a truncated cache entry behind. Returns null, leaving the
+   * stream unread, when OPFS is unavailable.
+   */
+  async _streamToCache(key, stream) {
+    let dirHandle, fileHandle, writable;
     try {
-      if (!('storage' in navigator && 'getDirectory' in navigator.storage)) return;
+      if (!this._hasOPFS()) return null;
       const root = await navigator.storage.getDirectory();
-      const dirHandle = await root.getDirectoryHandle('neuronos-cache', { create: true });
-      const fileHandle = await dirHandle.getFileHandle(key, { create: true });
-      const writable = await fileHandle.createWritable();
-      await writable.write(buffer);
-      await writable.close();
+      dirHandle = await root.getDirectoryHandle('neuronos-cache', { create: true });
+      fileHandle = await dirHandle.getFileHandle(key, { create: true });
+      writable = await fileHandle.createWritable();
+    } catch (e) {
+      console.warn('OPFS cache unavailable:', e);
+      return null;
+    }
+
+    try {
+      await stream.pipeTo(writable);
     } catch (e) {
-      console.warn('OPFS cache save failed:', e);
+      await dirHandle.removeEntry(key).catch(() => {});
+      throw e;
     }
+    return fileHandle.getFile();
   }
 
   /**
@@ -117,49 +117,22 @@ int neuronos_wasm_init(int n_threads, int n_ctx) {
     return 0;
 }
 
-/**
- * Load a GGUF model from an ArrayBuffer.
- * JS writes the model bytes into WASM heap, then we write to VFS.
- *
- * @param data    Pointer to model bytes in WASM heap
- * @param size    Size in bytes
- * @param n_ctx   Context size (0 = auto)
- * Returns 0 on success.
- */
-EMSCRIPTEN_KEEPALIVE
-int neuronos_wasm_load_model_from_buffer(const uint8_t * data, int size, int n_ctx) {
-    if (!g_engine) {
-        js_on_error("Engine not initialized");
-        return -1;
-    }
-
-    /* Free previous resources */
+/* Drop the agent, tools and model of a previous load */
+static void wasm_release_model(void) {
     if (g_agent)  { neuronos_agent_free(g_agent);         g_agent  = NULL; }
     if (g_tools)  { neuronos_tool_registry_free(g_tools); g_tools  = NULL; }
     if (g_model)  { neuronos_model_free(g_model);         g_model  = NULL; }
+}
 
-    js_on_status("Writing model to virtual filesystem...");
-
-    /* Write model bytes to Emscripten VFS */
-    FILE * f = fopen(WASM_MODEL_PATH, "wb");
-    if (!f) {
-        js_on_error("Failed to create VFS file for model");
-        return -2;
-    }
-    size_t written = fwrite(data, 1, (size_t)size, f);
-    fclose(f);
-
-    if ((int)written != size) {
-        js_on_error("Incomplete write to VFS");
-        return -3;
-    }
-
+/* Load the GGUF at path and build the agent around it */
+static int wasm_load_model(const char * path, int n_ctx) {
     js_on_status("Loading model into inference engine...");
 
-    /* Load model using real API */
+    /* Load model using real API. Without mmap, llama.cpp reads each tensor
+     * straight into its final buffer, so the source is only streamed. */
     neuronos_model_params_t mp;
     memset(&mp, 0, sizeof(mp));
-    mp.model_path   = WASM_MODEL_PATH;
+    mp.model_path   = path;
     mp.context_size = n_ctx > 0 ? n_ctx : 1024;  /* Reduced default for WASM memory constraints */
     mp.use_mmap     = false;  /* Emscripten FS doesn't support mmap */
 
@@ -169,10 +142,6 @@ int neuronos_wasm_load_model_from_buffer(const uint8_t * data, int size, int n_c
         return -4;
     }
 
-    /* Free the VFS copy — model data is now in llama.cpp's own buffers.
-     * This reclaims ~500MB of WASM heap that was holding the duplicate. */
-    remove(WASM_MODEL_PATH);
-
     js_on_status("Setting up agent...");
 
     /* Create tool registry — browser-safe tools only (no shell, no fs) */
@@ -210,6 +179,78 @@ int neuronos_wasm_load_model_from_buffer(const uint8_t * data, int size, int n_c
     return 0;
 }
 
+/**
+ * Load a GGUF model from a path in the Emscripten FS.
+ * The worker mounts the model Blob/File (an OPFS cache entry, a
+ * streamed download or a user-picked file) with WORKERFS, so tensors
+ * are read slice by slice from browser storage into their final
+ * buffers: peak memory is ~1x the model instead of ~3x.
+ * For split models pass the first part; the others must sit next to it.
+ *
+ * @param path    e.g. "/models/model.gguf"
+ * @param n_ctx   Context size (0 = auto)
+ * Returns 0 on success.
+ */
+EMSCRIPTEN_KEEPALIVE
+int neuronos_wasm_load_model_from_path(const char * path, int n_ctx) {
+    if (!g_engine) {
+        js_on_error("Engine not initialized");
+        return -1;
+    }
+    if (!path || !*path) {
+        js_on_error("No model path");
+        return -2;
+    }
+
+    wasm_release_model();
+    return wasm_load_model(path, n_ctx);
+}
+
+/**
+ * Load a GGUF model from an ArrayBuffer.
+ * JS writes the model bytes into WASM heap, then we write to VFS.
+ * Holds the model up to three times (JS, heap, VFS): kept for embedders,
+ * the bundled worker uses neuronos_wasm_load_model_from_path().
+ *
+ * @param data    Pointer to model bytes in WASM heap
+ * @param size    Size in bytes
+ * @param n_ctx   Context size (0 = auto)
+ * Returns 0 on success.
+ */
+EMSCRIPTEN_KEEPALIVE
+int neuronos_wasm_load_model_from_buffer(const uint8_t * data, int size, int n_ctx) {
+    if (!g_engine) {
+        js_on_error("Engine not initialized");
+        return -1;
+    }
+
+    /* Free previous resources */
+    wasm_release_model();
+
+    js_on_status("Writing model to virtual filesystem...");
+
+    /* Write model bytes to Emscripten VFS */
+    FILE * f = fopen(WASM_MODEL_PATH, "wb");
+    if (!f) {
+        js_on_error("Failed to create VFS file for model");
+        return -2;
+    }
+    size_t written = fwrite(data, 1, (size_t)size, f);
+    fclose(f);
+
+    if ((int)written != size) {
+        js_on_error("Incomplete write to VFS");
+        return -3;
+    }
+
+    int ret = wasm_load_model(WASM_MODEL_PATH, n_ctx);
+
+    /* Free the VFS copy — model data is now in llama.cpp's own buffers.
+     * This reclaims ~500MB of WASM heap that was holding the duplicate. */
+    remove(WASM_MODEL_PATH);
+    return ret;
+}
+
 /**
  * Generate text from a prompt.
  * Streams tokens via js_on_token callback.
@@ -406,9 +447,7 @@ void neuronos_wasm_free_string(char * ptr) {
  */
 EMSCRIPTEN_KEEPALIVE
 void neuronos_wasm_free(void) {
-    if (g_agent)  { neuronos_agent_free(g_agent);         g_agent  = NULL; }
-    if (g_tools)  { neuronos_tool_registry_free(g_tools); g_tools  = NULL; }
-    if (g_model)  { neuronos_model_free(g_model);         g_model  = NULL; }
+    wasm_release_model();
     if (g_memory) { neuronos_memory_close(g_memory);      g_memory = NULL; }
     if (g_engine) { neuronos_shutdown(g_engine);           g_engine = NULL; }
     js_on_status("NeuronOS shutdown complete");
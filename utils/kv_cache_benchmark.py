@@ -0,0 +1,113 @@
+import os
+import re
+import sys
+import logging
+import argparse
+import platform
+import subprocess
+
+# KV cache precisions accepted by llama.cpp's -ctk/-ctv (matches neuronos_kv_type_t)
+KV_TYPES = ["f16", "q8_0", "q4_0"]
+
+def find_binary(name):
+    build_dir = os.path.join(os.path.dirname(os.path.dirname(os.path.abspath(__file__))), "build")
+    if platform.system() == "Windows":
+        path = os.path.join(build_dir, "bin", "Release", name + ".exe")
+        if not os.path.exists(path):
+            path = os.path.join(build_dir, "bin", name)
+    else:
+        path = os.path.join(build_dir, "bin", name)
+    if not os.path.exists(path):
+        logging.error(f"{name} binary not found, please build first.")
+        sys.exit(1)
+    return path
+
+def run_command(command):
+    """Run a system command and return its combined output."""
+    try:
+        result = subprocess.run(command, check=True, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    except subprocess.CalledProcessError as e:
+        logging.error(f"Error occurred while running command: {e}\n{e.output}")
+        sys.exit(1)
+    return result.stdout
+
+def run_speed(kv_type):
+    """Prompt-processing and decode throughput; quantized V requires flash attention."""
+    command = [
+        find_binary("llama-bench"),
+        '-m', args.model,
+        '-n', str(args.n_token),
+        '-p', str(args.n_prompt),
+        '-ngl', '0',
+        '-t', str(args.threads),
+        '-ctk', kv_type,
+        '-ctv', kv_type,
+        '-fa', '1',
+        '-r', '3',
+        '-o', 'csv'
+    ]
+    output = run_command(command)
+    speeds = {}
+    lines = [l for l in output.splitlines() if l.startswith('"') or l.startswith('build_')]
+    if not lines:
+        return speeds
+    header = [h.strip('"') for h in lines[0].split(',')]
+    for line in lines[1:]:
+        row = dict(zip(header, [v.strip('"') for v in line.split(',')]))
+        if row.get("n_prompt", "0") != "0":
+            speeds["pp"] = float(row["avg_ts"])
+        elif row.get("n_gen", "0") != "0":
+            speeds["tg"] = float(row["avg_ts"])
+    return speeds
+
+def run_quality(kv_type):
+    """Perplexity on a text file at the requested context size."""
+    command = [
+        find_binary("llama-perplexity"),
+        '-m', args.model,
+        '-f', args.text,
+        '-c', str(args.ctx_size),
+        '-t', str(args.threads),
+        '-ngl', '0',
+        '-ctk', kv_type,
+        '-ctv', kv_type,
+        '-fa',
+        '--chunks', str(args.chunks)
+    ]
+    output = run_command(command)
+    match = re.search(r"Final estimate: PPL = ([\d.]+)", output)
+    return float(match.group(1)) if match else None
+
+def run_benchmark():
+    results = []
+    for kv_type in KV_TYPES:
+        logging.info(f"Benchmarking KV cache {kv_type}...")
+        row = {"kv": kv_type}
+        row.update(run_speed(kv_type))
+        if args.text:
+            row["ppl"] = run_quality(kv_type)
+        results.append(row)
+
+    base_ppl = results[0].get("ppl")
+    print(f"\n{'KV':<6} {'pp t/s':>10} {'tg t/s':>10} {'PPL':>10} {'dPPL':>8}")
+    for row in results:
+        ppl = row.get("ppl")
+        delta = f"{(ppl - base_ppl) / base_ppl * 100:+.2f}%" if ppl and base_ppl else "-"
+        print(f"{row['kv']:<6} {row.get('pp', 0):>10.2f} {row.get('tg', 0):>10.2f} "
+              f"{ppl if ppl else '-':>10} {delta:>8}")
+
+def parse_args():
+    parser = argparse.ArgumentParser(description='Compare speed and perplexity across KV cache precisions')
+    parser.add_argument("-m", "--model", type=str, help="Path to model file", required=True)
+    parser.add_argument("-f", "--text", type=str, help="Text file for perplexity (skip quality if omitted)", required=False, default=None)
+    parser.add_argument("-n", "--n-token", type=int, help="Number of generated tokens", required=False, default=128)
+    parser.add_argument("-p", "--n-prompt", type=int, help="Number of prompt tokens", required=False, default=4096)
+    parser.add_argument("-c", "--ctx-size", type=int, help="Context size for perplexity", required=False, default=4096)
+    parser.add_argument("--chunks", type=int, help="Perplexity chunks to evaluate", required=False, default=8)
+    parser.add_argument("-t", "--threads", type=int, help="Number of threads to use", required=False, default=2)
+    return parser.parse_args()
+
+if __name__ == "__main__":
+    logging.basicConfig(level=logging.INFO)
+    args = parse_args()
+    run_benchmark()